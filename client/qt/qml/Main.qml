@@ -52,6 +52,10 @@ ApplicationWindow {
     property real currentFps: backend ? backend.fps : 0
     property int framesProcessed: backend ? backend.framesProcessed : 0
     property int facesDetected: backend ? backend.facesDetected : 0
+    property var latency: backend ? backend.latency : ({})
+    property var endToEndLatency: latency && latency.captureToAck ? latency.captureToAck : null
+    property var device: backend ? backend.device : ({})
+    property var link: backend ? backend.link : ({})
     property string currentCamera: backend ? backend.currentCamera : ""
     property int currentModelType: backend ? backend.currentModelType : 0
     property bool settingsVisible: false
@@ -73,6 +77,7 @@ ApplicationWindow {
             disconnectRequested.connect(backend.disconnectFromDevice)
             scanRequested.connect(backend.scanForDevices)
             calibrateRequested.connect(backend.calibrateDevice)
+            traceDumpRequested.connect(backend.dumpTrace)
         }
 
         // Load settings from storage
@@ -120,6 +125,7 @@ ApplicationWindow {
     signal disconnectRequested()
     signal scanRequested()
     signal calibrateRequested()
+    signal traceDumpRequested()
 
     color: themeBackgroundColor
 
@@ -314,6 +320,32 @@ ApplicationWindow {
                         value: root.facesDetected.toString()
                         statusColor: root.facesDetected > 0 ? successColor : themeTextSecondary
                     }
+
+                    StatusPill {
+                        label: "Latency p50/p95/p99"
+                        value: root.endToEndLatency && root.endToEndLatency.count > 0
+                               ? root.endToEndLatency.p50.toFixed(0) + "/" + root.endToEndLatency.p95.toFixed(0)
+                                 + "/" + root.endToEndLatency.p99.toFixed(0) + " ms"
+                               : "--"
+                        statusColor: root.endToEndLatency && root.endToEndLatency.p95 > 150 ? warningColor
+                                                                                            : themeTextSecondary
+                    }
+
+                    StatusPill {
+                        label: "Pan/Tilt"
+                        value: root.device && root.device.valid
+                               ? root.device.pan.toFixed(1) + "°/" + root.device.tilt.toFixed(1) + "°"
+                               : "--"
+                        statusColor: root.device && root.device.moving ? successColor : themeTextSecondary
+                    }
+
+                    StatusPill {
+                        label: "Link RTT/jitter"
+                        value: root.link && root.link.valid
+                               ? root.link.rttMs.toFixed(0) + "/" + root.link.jitterMs.toFixed(0) + " ms"
+                               : "--"
+                        statusColor: root.link && root.link.lost > 0 ? warningColor : themeTextSecondary
+                    }
                 }
 
                 // Calibrate button (only visible when connected)
@@ -385,6 +417,34 @@ ApplicationWindow {
                     }
                 }
 
+                // Dump trace button (writes recent pipeline spans to the log directory)
+                Button {
+                    text: "Dump trace"
+                    flat: true
+                    font.pixelSize: 13
+                    font.family: "Segoe UI"
+
+                    contentItem: Text {
+                        text: parent.text
+                        color: root.darkMode ? "white" : textPrimary
+                        font: parent.font
+                        verticalAlignment: Text.AlignVCenter
+                    }
+
+                    background: Rectangle {
+                        color: {
+                            if (parent.pressed) return Qt.rgba(root.accentColor.r, root.accentColor.g, root.accentColor.b, 0.3)
+                            if (parent.hovered) return Qt.rgba(root.accentColor.r, root.accentColor.g, root.accentColor.b, 0.1)
+                            return "transparent"
+                        }
+                        radius: 4
+                    }
+
+                    onClicked: {
+                        root.traceDumpRequested()
+                    }
+                }
+
                 Item { Layout.fillWidth: true }
 
                 // Settings button
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/compact_codec.hpp>
+#include <client/comm/export.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace client::comm {
+
+/**
+ * @brief Expands windowed MOVE acknowledgements into per-command acknowledgements.
+ * @details Every WindowAck restates the last kWindowAckSpan MOVEs the device received, so
+ * consecutive acks overlap. The tracker maps their 8-bit sequences back to command IDs and
+ * remembers the newest kHistory IDs it has reported, so each command is acknowledged once.
+ * IDs the device never saw (coalesced or lost MOVEs) are simply never reported.
+ * @note Not thread-safe; use from the thread that owns the transport.
+ */
+class CLIENT_COMM_API AckTracker {
+public:
+  /// Command IDs behind the newest acknowledged one that are remembered; anything older counts as acknowledged.
+  static constexpr uint32_t kHistory = 64;
+
+  /**
+   * @brief Applies a windowed acknowledgement.
+   * @tparam AckedFn Callable as `void(uint32_t command_id)`
+   * @param ack Acknowledgement from the device
+   * @param last_move_id Command ID of the most recent MOVE sent
+   * @param on_acked Called, oldest first, with each command ID not acknowledged before
+   * @return Number of commands newly acknowledged
+   */
+  template <typename AckedFn>
+  size_t Apply(const WindowAck& ack, uint32_t last_move_id, AckedFn&& on_acked);
+
+  /**
+   * @brief Marks a single command as acknowledged.
+   * @param command_id Command ID (non-zero)
+   * @return True if @p command_id had not been acknowledged yet
+   */
+  bool MarkAcked(uint32_t command_id) noexcept;
+
+  /**
+   * @brief Forgets all acknowledgements (e.g. on reconnect).
+   */
+  void Reset() noexcept;
+
+private:
+  uint32_t newest_ = 0;
+  uint64_t seen_ = 0;  ///< Bit i set if command (newest_ - i) was acknowledged.
+};
+
+template <typename AckedFn>
+size_t AckTracker::Apply(const WindowAck& ack, uint32_t last_move_id, AckedFn&& on_acked) {
+  const uint32_t newest = ExpandCompactSequence(ack.status.sequence, last_move_id);
+  size_t count = 0;
+
+  for (uint32_t distance = kWindowAckSpan - 1; distance > 0; --distance) {
+    if ((ack.received & (uint32_t{1} << (distance - 1))) == 0 || distance >= newest) {
+      continue;
+    }
+    // The window is far narrower than the 8-bit sequence space, so distances carry over to full IDs
+    const uint32_t command_id = newest - distance;
+    if (MarkAcked(command_id)) {
+      on_acked(command_id);
+      ++count;
+    }
+  }
+
+  if (newest != 0 && MarkAcked(newest)) {
+    on_acked(newest);
+    ++count;
+  }
+  return count;
+}
+
+}  // namespace client::comm
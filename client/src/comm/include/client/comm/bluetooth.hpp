@@ -6,6 +6,7 @@
 #include <client/comm/protocol.hpp>
 #include <client/core/utils/fast_pimpl.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <expected>
@@ -121,7 +122,14 @@ struct CLIENT_COMM_API BluetoothDevice {
 /**
  * @brief Bluetooth manager for handling device discovery and connections.
  * @details Provides a platform-agnostic interface for Bluetooth operations
- * using Qt Bluetooth when available.
+ * using Qt Bluetooth when available. The device link itself runs over any
+ * ITransport, so Connect() also accepts tcp://, udp:// and serial:// addresses
+ * (see ParseTransportEndpoint()); those work without Bluetooth support.
+ *
+ * The link runs on a dedicated comm thread with its own event loop. SendCommand() and the other
+ * Send*() calls may be made from any thread: they hand the command over through a lock-free
+ * queue and return without waiting, so servo commands are not delayed by a busy GUI thread.
+ * Callbacks run on the thread that created the manager, which must run a Qt event loop.
  * @note Uses unique_ptr for pimpl since the implementation contains QObject-derived
  * types which are not moveable.
  */
@@ -163,6 +171,15 @@ public:
   using DataReceivedCallback = std::function<void(std::span<const uint8_t> data)>;
 #endif
 
+  /**
+   * @brief Callback type for a MOVE acknowledged by a windowed acknowledgement.
+   */
+#if __cpp_lib_move_only_function >= 202110L
+  using AckCallback = std::move_only_function<void(uint32_t command_id)>;
+#else
+  using AckCallback = std::function<void(uint32_t command_id)>;
+#endif
+
   BluetoothManager();
   BluetoothManager(const BluetoothManager&) = delete;
   BluetoothManager(BluetoothManager&&) = delete;
@@ -190,49 +207,83 @@ public:
   void StopScan();
 
   /**
-   * @brief Connects to a Bluetooth device.
-   * @param address Device address to connect to
+   * @brief Connects to a device.
+   * @param address Bluetooth address, or a transport URI such as "tcp://192.168.4.1:3333"
    * @return Expected void on success, or error on failure
    */
   [[nodiscard]] auto Connect(std::string_view address) -> std::expected<void, BluetoothError>;
 
   /**
-   * @brief Disconnects from the current device.
+   * @brief Disconnects from the current device and stops reconnecting to it.
    * @return Expected void on success, or error on failure
    */
   [[nodiscard]] auto Disconnect() -> std::expected<void, BluetoothError>;
 
   /**
-   * @brief Sends data to the connected device.
+   * @brief Enables reconnecting automatically when the link is lost.
+   * @details Attempts are spaced by a jittered exponential backoff (see ReconnectBackoff) and go to
+   * the address the device was last reached at, so a Bluetooth device is reopened on its known
+   * RFCOMM channel. Each attempt is reported through the state callback like a Connect().
+   * @param enabled Whether to reconnect after TransportError::kConnectionLost
+   */
+  void SetAutoReconnect(bool enabled);
+
+  /**
+   * @brief Gets the number of reconnection attempts since the link was last up.
+   * @return Attempt count (0 while connected)
+   */
+  [[nodiscard]] uint32_t ReconnectAttempts() const noexcept;
+
+  /**
+   * @brief Sends raw bytes to the connected device, bypassing framing.
    * @param data Data to send
    * @return Expected number of bytes sent, or error on failure
+   * @note Messages sent through SendCommand() and friends are framed (see framing.hpp).
+   * @warning Waits for the comm thread; meant for diagnostics, not for the control path.
    */
   [[nodiscard]] auto Send(std::span<const uint8_t> data) -> std::expected<size_t, BluetoothError>;
 
   /**
-   * @brief Sends a protocol message to the connected device.
+   * @brief Queues a servo MOVE for the connected device.
    * @param cmd Servo command to send
    * @return Expected void on success, or error on failure
+   * @note Latest wins: a MOVE still waiting for the link to drain is replaced by this one
+   * (see CommandScheduler). Success means the command was handed to the comm thread, not that it was written.
+   * Once the handshake enables compact control, the MOVE is sent as a 6-byte CompactMoveCommand.
+   * If it also enables windowed acks, the device acknowledges it through the AckCallback instead of a response.
    */
   [[nodiscard]] auto SendCommand(const ServoCommand& cmd) -> std::expected<void, BluetoothError>;
 
   /**
-   * @brief Sends a heartbeat message to the connected device.
+   * @brief Sends a heartbeat (ping) message to the connected device.
+   * @param sequence Command ID the device echoes in its reply (see LinkMonitor)
    * @return Expected void on success, or error on failure
+   * @note Control messages are never coalesced and go out ahead of any pending MOVE.
    */
-  [[nodiscard]] auto SendHeartbeat() -> std::expected<void, BluetoothError>;
+  [[nodiscard]] auto SendHeartbeat(uint32_t sequence = 0) -> std::expected<void, BluetoothError>;
 
   /**
    * @brief Sends a calibrate command to the connected device.
+   * @param command_id Command ID echoed in the response; a non-zero ID is retransmitted until the response
+   * arrives (see RetransmitQueue)
    * @return Expected void on success, or error on failure
    */
-  [[nodiscard]] auto SendCalibrate() -> std::expected<void, BluetoothError>;
+  [[nodiscard]] auto SendCalibrate(uint32_t command_id = 0) -> std::expected<void, BluetoothError>;
 
   /**
    * @brief Sends a home command to the connected device.
+   * @param command_id Command ID echoed in the response
+   * @return Expected void on success, or error on failure
+   */
+  [[nodiscard]] auto SendHome(uint32_t command_id = 0) -> std::expected<void, BluetoothError>;
+
+  /**
+   * @brief Asks the connected device for its status.
+   * @param command_id Command ID echoed in the response; a non-zero ID is retransmitted until the response
+   * arrives (see RetransmitQueue)
    * @return Expected void on success, or error on failure
    */
-  [[nodiscard]] auto SendHome() -> std::expected<void, BluetoothError>;
+  [[nodiscard]] auto SendGetStatus(uint32_t command_id) -> std::expected<void, BluetoothError>;
 
   /**
    * @brief Sets the state change callback.
@@ -254,10 +305,23 @@ public:
 
   /**
    * @brief Sets the data received callback.
-   * @param callback Callback to invoke when data is received
+   * @param callback Callback to invoke with the payload of each complete response frame
    */
   void SetDataReceivedCallback(DataReceivedCallback callback) noexcept;
 
+  /**
+   * @brief Sets the windowed acknowledgement callback.
+   * @param callback Callback to invoke once for each MOVE the device acknowledged in a WindowAck
+   * @note Only called while WindowAckActive(); otherwise every MOVE is answered by its own response.
+   */
+  void SetAckCallback(AckCallback callback) noexcept;
+
+  /**
+   * @brief Sets how long to wait for a response before retransmitting a command.
+   * @param timeout Initial retransmission timeout (see LinkStats::RetransmitTimeout())
+   */
+  void SetRetransmitTimeout(std::chrono::milliseconds timeout) noexcept;
+
   /**
    * @brief Processes pending Bluetooth events.
    * @details Qt events are processed via the Qt event loop automatically.
@@ -291,9 +355,46 @@ public:
   /**
    * @brief Gets the currently connected device info.
    * @return Connected device info, or nullopt if not connected
+   * @note Once connected, the address is the one that reconnects fastest (see ITransport::ResolvedAddress()).
    */
   [[nodiscard]] auto ConnectedDevice() const -> std::optional<BluetoothDevice>;
 
+  /**
+   * @brief Gets the number of commands waiting for the comm thread or for the link to drain.
+   * @return Outbound queue depth
+   */
+  [[nodiscard]] size_t QueueDepth() const noexcept;
+
+  /**
+   * @brief Gets the number of MOVE commands dropped because a newer one replaced them.
+   * @return Coalesced command count
+   */
+  [[nodiscard]] uint64_t CoalescedCommands() const noexcept;
+
+  /**
+   * @brief Checks whether the device agreed to protocol v2 compact control in the handshake.
+   * @return True if SendCommand() sends compact fixed-point MOVE frames instead of protobuf
+   */
+  [[nodiscard]] bool CompactControlActive() const noexcept;
+
+  /**
+   * @brief Checks whether the device agreed to acknowledge MOVEs in windows in the handshake.
+   * @return True if MOVEs are acknowledged through the AckCallback rather than individual responses
+   */
+  [[nodiscard]] bool WindowAckActive() const noexcept;
+
+  /**
+   * @brief Gets the number of commands retransmitted because their response was overdue.
+   * @return Retransmission count
+   */
+  [[nodiscard]] uint64_t Retransmissions() const noexcept;
+
+  /**
+   * @brief Sets the socket backlog below which a pending MOVE is written.
+   * @param bytes Low watermark in bytes (see CommandScheduler::kDefaultLowWatermark)
+   */
+  void SetSendLowWatermark(size_t bytes) noexcept;
+
   /**
    * @brief Gets the last error message.
    * @return Last error message, or empty string if no error
@@ -314,10 +415,10 @@ public:
 
 private:
 #ifdef CLIENT_PLATFORM_ANDROID
-  static constexpr size_t kImplSize = 512;
+  static constexpr size_t kImplSize = 1408;
   static constexpr size_t kImplAlign = 16;
 #else
-  static constexpr size_t kImplSize = 416;
+  static constexpr size_t kImplSize = 1280;
   static constexpr size_t kImplAlign = 8;
 #endif
 
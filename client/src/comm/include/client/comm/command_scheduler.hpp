@@ -0,0 +1,126 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/export.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <vector>
+
+namespace client::comm {
+
+/**
+ * @brief Outbound command scheduler with latest-wins MOVE coalescing.
+ * @details Holds encoded frames until the transport can take them. Control frames (STOP, HOME,
+ * CALIBRATE, heartbeats) are kept in FIFO order and always go out first, regardless of backlog.
+ * Only the newest MOVE is kept: submitting a MOVE while another is pending replaces it, and the
+ * MOVE is written only once the transport's write backlog has drained below the low watermark.
+ * This bounds how far the servo can lag behind the tracker when the link is slower than the frame rate.
+ * @note Not thread-safe; use from the thread that owns the transport.
+ */
+class CLIENT_COMM_API CommandScheduler {
+public:
+  /// Default backlog (in bytes) below which a pending MOVE is written: roughly one MOVE frame.
+  static constexpr size_t kDefaultLowWatermark = 32;
+
+  /**
+   * @brief Constructs a scheduler.
+   * @param low_watermark Backlog in bytes below which a pending MOVE may be written
+   */
+  explicit CommandScheduler(size_t low_watermark = kDefaultLowWatermark) : low_watermark_(low_watermark) {}
+
+  /**
+   * @brief Queues an encoded MOVE frame, replacing any MOVE that has not been written yet.
+   * @param frame Encoded frame
+   * @return True if a pending MOVE was replaced
+   */
+  bool SubmitMove(std::span<const uint8_t> frame);
+
+  /**
+   * @brief Queues an encoded control frame.
+   * @param frame Encoded frame
+   */
+  void SubmitControl(std::span<const uint8_t> frame);
+
+  /**
+   * @brief Writes as many pending frames as the backlog allows.
+   * @tparam WriteFn Callable as `bool(std::span<const uint8_t> frame)`, returning false if the write failed
+   * @param bytes_to_write Bytes already buffered by the transport but not yet sent
+   * @param write Function that writes one frame to the transport
+   * @return Number of frames written
+   * @note A frame whose write fails stays queued and stops the drain.
+   */
+  template <typename WriteFn>
+  size_t Drain(size_t bytes_to_write, WriteFn&& write);
+
+  /**
+   * @brief Discards all pending frames (e.g. on disconnect).
+   */
+  void Clear() noexcept;
+
+  /**
+   * @brief Sets the backlog below which a pending MOVE may be written.
+   * @param low_watermark Backlog in bytes
+   */
+  void SetLowWatermark(size_t low_watermark) noexcept { low_watermark_ = low_watermark; }
+
+  /**
+   * @brief Gets the number of frames waiting to be written.
+   * @return Pending control frames plus the pending MOVE, if any
+   */
+  [[nodiscard]] size_t Depth() const noexcept { return control_.size() + (has_move_ ? 1 : 0); }
+
+  /**
+   * @brief Gets the number of MOVE frames dropped because a newer MOVE replaced them.
+   * @return Coalesced MOVE count
+   */
+  [[nodiscard]] uint64_t Coalesced() const noexcept { return coalesced_; }
+
+  /**
+   * @brief Gets the total number of frames written.
+   * @return Written frame count
+   */
+  [[nodiscard]] uint64_t Written() const noexcept { return written_; }
+
+  /**
+   * @brief Gets the backlog below which a pending MOVE may be written.
+   * @return Backlog in bytes
+   */
+  [[nodiscard]] size_t LowWatermark() const noexcept { return low_watermark_; }
+
+private:
+  std::deque<std::vector<uint8_t>> control_;
+  std::vector<uint8_t> move_;
+  bool has_move_ = false;
+  size_t low_watermark_ = kDefaultLowWatermark;
+  uint64_t coalesced_ = 0;
+  uint64_t written_ = 0;
+};
+
+template <typename WriteFn>
+size_t CommandScheduler::Drain(size_t bytes_to_write, WriteFn&& write) {
+  size_t frames = 0;
+  bool ok = true;
+
+  while (ok && !control_.empty()) {
+    ok = write(std::span<const uint8_t>(control_.front()));
+    if (ok) {
+      bytes_to_write += control_.front().size();
+      control_.pop_front();
+      ++frames;
+    }
+  }
+
+  if (ok && has_move_ && bytes_to_write < low_watermark_ && write(std::span<const uint8_t>(move_))) {
+    has_move_ = false;
+    ++frames;
+  }
+
+  written_ += frames;
+  return frames;
+}
+
+}  // namespace client::comm
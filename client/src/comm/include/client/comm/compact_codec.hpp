@@ -0,0 +1,337 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/protocol.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string_view>
+
+namespace client::comm {
+
+/*
+ * Protocol v2 fixed-point control messages carried in FrameType::kCompact frames.
+ *
+ * Once both sides agree on kCompactControlFeature in the handshake, MOVE commands and their
+ * acknowledgements switch from protobuf to these fixed little-endian layouts:
+ *
+ *   CompactMove:   seq u8 | flags u8 | pan i16 | tilt i16 [| pan_velocity i16 | tilt_velocity i16]
+ *   CompactStatus: seq u8 | flags u8 | pan i16 | tilt i16 | target_pan i16 | target_tilt i16
+ *
+ * Angles are centi-degrees and velocities centi-degrees per second, so values saturate at +-327.67.
+ *
+ * If kWindowAckFeature is also agreed, the device stops answering every MOVE and instead sends a
+ * FrameType::kWindowAck frame after every few MOVEs or milliseconds:
+ *
+ *   WindowAck:     CompactStatus | received u32
+ *
+ * The status sequence is the newest MOVE received and bit i of received is set if the MOVE with
+ * sequence (status.sequence - 1 - i) was received too, so every ack restates the last 33 MOVEs and
+ * one lost ack costs nothing. Commands other than MOVE are still answered individually.
+ * The firmware implements the same layout in embedded/components/compact_control.
+ */
+
+/// Protocol version announced in the handshake by peers that speak compact control.
+inline constexpr uint32_t kCompactProtocolVersion = 2;
+
+/// Handshake feature name that enables compact control (fits the firmware's 16-byte feature strings).
+inline constexpr std::string_view kCompactControlFeature = "compact_v2";
+
+/// Size of a CompactMove without velocity.
+inline constexpr size_t kCompactMoveSize = 6;
+
+/// Size of a CompactMove carrying velocity.
+inline constexpr size_t kCompactMoveWithVelocitySize = 10;
+
+/// Size of a CompactStatus.
+inline constexpr size_t kCompactStatusSize = 10;
+
+/// Handshake feature name that replaces per-MOVE acknowledgements with WindowAck frames.
+inline constexpr std::string_view kWindowAckFeature = "ack_window";
+
+/// Size of a WindowAck.
+inline constexpr size_t kWindowAckSize = kCompactStatusSize + 4;
+
+/// MOVEs a WindowAck can acknowledge: the newest plus one per bit of WindowAck::received.
+inline constexpr size_t kWindowAckSpan = 33;
+
+/**
+ * @brief Compact MOVE command.
+ */
+struct CompactMoveCommand {
+  float pan_angle = 0.0F;      ///< Pan angle in degrees.
+  float tilt_angle = 0.0F;     ///< Tilt angle in degrees.
+  float pan_velocity = 0.0F;   ///< Pan velocity in degrees per second (valid if has_velocity).
+  float tilt_velocity = 0.0F;  ///< Tilt velocity in degrees per second (valid if has_velocity).
+  bool has_velocity = false;   ///< Whether the velocity fields are sent.
+  uint8_t sequence = 0;        ///< Low 8 bits of the command ID, echoed in the CompactStatus.
+
+  [[nodiscard]] bool operator==(const CompactMoveCommand&) const noexcept = default;
+};
+
+/**
+ * @brief Compact acknowledgement of a CompactMoveCommand.
+ */
+struct CompactStatus {
+  float pan_position = 0.0F;   ///< Current pan position in degrees.
+  float tilt_position = 0.0F;  ///< Current tilt position in degrees.
+  float target_pan = 0.0F;     ///< Target pan position in degrees.
+  float target_tilt = 0.0F;    ///< Target tilt position in degrees.
+  uint8_t sequence = 0;        ///< Sequence of the command being acknowledged.
+  bool is_moving = false;      ///< Whether the servos are moving toward the target.
+  bool is_calibrated = false;  ///< Whether the device is calibrated.
+  bool rejected = false;       ///< Whether the device refused the command.
+
+  [[nodiscard]] bool operator==(const CompactStatus&) const noexcept = default;
+};
+
+/**
+ * @brief Windowed acknowledgement of the MOVEs received since the last one.
+ */
+struct WindowAck {
+  CompactStatus status;   ///< Device state; status.sequence is the newest MOVE received.
+  uint32_t received = 0;  ///< Bit i set if the MOVE with sequence (status.sequence - 1 - i) was received.
+
+  [[nodiscard]] bool operator==(const WindowAck&) const noexcept = default;
+};
+
+/**
+ * @brief Encoded compact message held in a fixed-size buffer.
+ */
+struct CompactBytes {
+  std::array<uint8_t, kWindowAckSize> data{};  ///< Encoded bytes (first size are valid).
+  size_t size = 0;                             ///< Number of valid bytes.
+
+  /**
+   * @brief Gets the encoded bytes.
+   * @return View of the valid bytes
+   */
+  [[nodiscard]] constexpr std::span<const uint8_t> Bytes() const noexcept { return {data.data(), size}; }
+};
+
+namespace detail {
+
+inline constexpr uint8_t kCompactMoveHasVelocity = 0x01;
+inline constexpr uint8_t kCompactStatusMoving = 0x01;
+inline constexpr uint8_t kCompactStatusCalibrated = 0x02;
+inline constexpr uint8_t kCompactStatusRejected = 0x04;
+
+/**
+ * @brief Converts degrees to saturated, rounded centi-degrees (NaN maps to 0).
+ */
+[[nodiscard]] constexpr int16_t ToCentiDegrees(float degrees) noexcept {
+  const float scaled = degrees * 100.0F;
+  if (!(scaled == scaled)) {
+    return 0;
+  }
+  if (scaled >= 32767.0F) {
+    return INT16_MAX;
+  }
+  if (scaled <= -32768.0F) {
+    return INT16_MIN;
+  }
+  return static_cast<int16_t>(scaled < 0.0F ? scaled - 0.5F : scaled + 0.5F);
+}
+
+[[nodiscard]] constexpr float FromCentiDegrees(int16_t centi_degrees) noexcept {
+  return static_cast<float>(centi_degrees) / 100.0F;
+}
+
+constexpr void PutInt16(int16_t value, std::span<uint8_t> out, size_t pos) noexcept {
+  const auto bits = std::bit_cast<uint16_t>(value);
+  out[pos] = static_cast<uint8_t>(bits);
+  out[pos + 1] = static_cast<uint8_t>(bits >> 8);
+}
+
+[[nodiscard]] constexpr int16_t GetInt16(std::span<const uint8_t> data, size_t pos) noexcept {
+  return std::bit_cast<int16_t>(static_cast<uint16_t>(data[pos] | (data[pos + 1] << 8)));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Encodes a compact MOVE command.
+ * @param cmd Command to encode
+ * @return Encoded bytes (kCompactMoveSize or kCompactMoveWithVelocitySize long)
+ */
+[[nodiscard]] constexpr CompactBytes EncodeCompactMove(const CompactMoveCommand& cmd) noexcept {
+  CompactBytes bytes;
+  bytes.data[0] = cmd.sequence;
+  bytes.data[1] = cmd.has_velocity ? detail::kCompactMoveHasVelocity : 0;
+  detail::PutInt16(detail::ToCentiDegrees(cmd.pan_angle), bytes.data, 2);
+  detail::PutInt16(detail::ToCentiDegrees(cmd.tilt_angle), bytes.data, 4);
+  bytes.size = kCompactMoveSize;
+
+  if (cmd.has_velocity) {
+    detail::PutInt16(detail::ToCentiDegrees(cmd.pan_velocity), bytes.data, 6);
+    detail::PutInt16(detail::ToCentiDegrees(cmd.tilt_velocity), bytes.data, 8);
+    bytes.size = kCompactMoveWithVelocitySize;
+  }
+
+  return bytes;
+}
+
+/**
+ * @brief Decodes a compact MOVE command.
+ * @param data Encoded bytes
+ * @return Decoded command, or ProtocolError::kInvalidMessage if the size does not match the flags
+ */
+[[nodiscard]] constexpr auto DecodeCompactMove(std::span<const uint8_t> data) noexcept
+    -> std::expected<CompactMoveCommand, ProtocolError> {
+  if (data.size() < kCompactMoveSize) {
+    return std::unexpected(ProtocolError::kInvalidMessage);
+  }
+
+  CompactMoveCommand cmd;
+  cmd.sequence = data[0];
+  cmd.has_velocity = (data[1] & detail::kCompactMoveHasVelocity) != 0;
+  if (data.size() != (cmd.has_velocity ? kCompactMoveWithVelocitySize : kCompactMoveSize)) {
+    return std::unexpected(ProtocolError::kInvalidMessage);
+  }
+
+  cmd.pan_angle = detail::FromCentiDegrees(detail::GetInt16(data, 2));
+  cmd.tilt_angle = detail::FromCentiDegrees(detail::GetInt16(data, 4));
+  if (cmd.has_velocity) {
+    cmd.pan_velocity = detail::FromCentiDegrees(detail::GetInt16(data, 6));
+    cmd.tilt_velocity = detail::FromCentiDegrees(detail::GetInt16(data, 8));
+  }
+
+  return cmd;
+}
+
+/**
+ * @brief Encodes a compact status.
+ * @param status Status to encode
+ * @return Encoded bytes (kCompactStatusSize long)
+ */
+[[nodiscard]] constexpr CompactBytes EncodeCompactStatus(const CompactStatus& status) noexcept {
+  CompactBytes bytes;
+  bytes.data[0] = status.sequence;
+  bytes.data[1] = static_cast<uint8_t>((status.is_moving ? detail::kCompactStatusMoving : 0) |
+                                       (status.is_calibrated ? detail::kCompactStatusCalibrated : 0) |
+                                       (status.rejected ? detail::kCompactStatusRejected : 0));
+  detail::PutInt16(detail::ToCentiDegrees(status.pan_position), bytes.data, 2);
+  detail::PutInt16(detail::ToCentiDegrees(status.tilt_position), bytes.data, 4);
+  detail::PutInt16(detail::ToCentiDegrees(status.target_pan), bytes.data, 6);
+  detail::PutInt16(detail::ToCentiDegrees(status.target_tilt), bytes.data, 8);
+  bytes.size = kCompactStatusSize;
+  return bytes;
+}
+
+/**
+ * @brief Decodes a compact status.
+ * @param data Encoded bytes
+ * @return Decoded status, or ProtocolError::kInvalidMessage if @p data is not kCompactStatusSize long
+ */
+[[nodiscard]] constexpr auto DecodeCompactStatus(std::span<const uint8_t> data) noexcept
+    -> std::expected<CompactStatus, ProtocolError> {
+  if (data.size() != kCompactStatusSize) {
+    return std::unexpected(ProtocolError::kInvalidMessage);
+  }
+
+  CompactStatus status;
+  status.sequence = data[0];
+  status.is_moving = (data[1] & detail::kCompactStatusMoving) != 0;
+  status.is_calibrated = (data[1] & detail::kCompactStatusCalibrated) != 0;
+  status.rejected = (data[1] & detail::kCompactStatusRejected) != 0;
+  status.pan_position = detail::FromCentiDegrees(detail::GetInt16(data, 2));
+  status.tilt_position = detail::FromCentiDegrees(detail::GetInt16(data, 4));
+  status.target_pan = detail::FromCentiDegrees(detail::GetInt16(data, 6));
+  status.target_tilt = detail::FromCentiDegrees(detail::GetInt16(data, 8));
+  return status;
+}
+
+/**
+ * @brief Encodes a windowed acknowledgement.
+ * @param ack Acknowledgement to encode
+ * @return Encoded bytes (kWindowAckSize long)
+ */
+[[nodiscard]] constexpr CompactBytes EncodeWindowAck(const WindowAck& ack) noexcept {
+  CompactBytes bytes = EncodeCompactStatus(ack.status);
+  for (size_t i = 0; i < 4; ++i) {
+    bytes.data[kCompactStatusSize + i] = static_cast<uint8_t>(ack.received >> (8 * i));
+  }
+  bytes.size = kWindowAckSize;
+  return bytes;
+}
+
+/**
+ * @brief Decodes a windowed acknowledgement.
+ * @param data Encoded bytes
+ * @return Decoded acknowledgement, or ProtocolError::kInvalidMessage if @p data is not kWindowAckSize long
+ */
+[[nodiscard]] constexpr auto DecodeWindowAck(std::span<const uint8_t> data) noexcept
+    -> std::expected<WindowAck, ProtocolError> {
+  if (data.size() != kWindowAckSize) {
+    return std::unexpected(ProtocolError::kInvalidMessage);
+  }
+
+  const auto status = DecodeCompactStatus(data.first(kCompactStatusSize));
+  if (!status) {
+    return std::unexpected(status.error());
+  }
+
+  WindowAck ack{.status = *status};
+  for (size_t i = 0; i < 4; ++i) {
+    ack.received |= static_cast<uint32_t>(data[kCompactStatusSize + i]) << (8 * i);
+  }
+  return ack;
+}
+
+/**
+ * @brief Recovers a full command ID from the 8-bit sequence echoed in a CompactStatus.
+ * @param sequence Echoed sequence
+ * @param last_command_id Most recent command ID sent
+ * @return The newest command ID not after @p last_command_id whose low 8 bits equal @p sequence
+ */
+[[nodiscard]] constexpr uint32_t ExpandCompactSequence(uint8_t sequence, uint32_t last_command_id) noexcept {
+  uint32_t command_id = (last_command_id & ~uint32_t{0xFF}) | sequence;
+  if (command_id > last_command_id && command_id >= 0x100) {
+    command_id -= 0x100;
+  }
+  return command_id;
+}
+
+/**
+ * @brief Converts a ServoCommand to a compact MOVE.
+ * @details The velocity is sent only if the command may be extrapolated; the device then applies
+ * its own fixed horizon, since the frame has no field for cmd.valid_for_ms.
+ * @param cmd Command to convert
+ * @return Compact command carrying the low 8 bits of cmd.command_id as its sequence
+ */
+[[nodiscard]] constexpr CompactMoveCommand ToCompactMove(const ServoCommand& cmd) noexcept {
+  const bool has_velocity = cmd.valid_for_ms > 0 && (cmd.pan_velocity != 0.0F || cmd.tilt_velocity != 0.0F);
+  return CompactMoveCommand{.pan_angle = cmd.pan_angle,
+                            .tilt_angle = cmd.tilt_angle,
+                            .pan_velocity = has_velocity ? cmd.pan_velocity : 0.0F,
+                            .tilt_velocity = has_velocity ? cmd.tilt_velocity : 0.0F,
+                            .has_velocity = has_velocity,
+                            .sequence = static_cast<uint8_t>(cmd.command_id & 0xFF)};
+}
+
+/**
+ * @brief Converts a compact status to the StatusMessage consumers of protocol v1 expect.
+ * @param status Compact status
+ * @param command_id Full command ID (see ExpandCompactSequence())
+ * @return Status with device status set; rejected commands report error code 6 (STATUS_CODE_NOT_CALIBRATED)
+ */
+[[nodiscard]] constexpr StatusMessage ToStatusMessage(const CompactStatus& status, uint32_t command_id) noexcept {
+  StatusMessage msg;
+  msg.pan_position = status.pan_position;
+  msg.tilt_position = status.tilt_position;
+  msg.target_pan = status.target_pan;
+  msg.target_tilt = status.target_tilt;
+  msg.is_calibrated = status.is_calibrated;
+  msg.is_moving = status.is_moving;
+  msg.has_device_status = true;
+  msg.error_code = status.rejected ? 6 : 0;
+  msg.command_id = command_id;
+  return msg;
+}
+
+}  // namespace client::comm
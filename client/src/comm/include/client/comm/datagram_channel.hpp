@@ -0,0 +1,399 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/export.hpp>
+#include <client/comm/framing.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <span>
+#include <vector>
+
+namespace client::comm {
+
+/**
+ * @brief Delivery class of a control datagram.
+ * @details The device firmware mirrors these values (udp_control component).
+ */
+enum class DatagramKind : uint8_t {
+  kLatest = 0x01,    ///< Unreliable; the receiver drops anything older than the newest it delivered.
+  kReliable = 0x02,  ///< Retransmitted until acknowledged and delivered in order.
+  kAck = 0x03,       ///< Cumulative acknowledgement of kReliable datagrams.
+};
+
+/// Bytes in front of the payload: kind, session, sequence (LE) and sender timestamp (LE).
+inline constexpr size_t kDatagramHeaderSize = 10;
+
+/// Largest datagram: the header plus one encoded frame.
+inline constexpr size_t kMaxDatagramSize = kDatagramHeaderSize + MaxEncodedFrameSize(kMaxFramePayloadSize);
+
+/**
+ * @brief Header of a control datagram.
+ * @details Wire format: `kind | session | sequence u32 LE | timestamp_us u32 LE | payload`. The
+ * payload is one encoded frame (see EncodeFrame()), so a datagram carries exactly what one
+ * Write() would put on a byte stream; kAck datagrams have no payload.
+ */
+struct DatagramHeader {
+  DatagramKind kind = DatagramKind::kLatest;  ///< Delivery class.
+  uint8_t session = 0;                        ///< Sender's session; for kAck, the session being acknowledged.
+  uint32_t sequence = 0;                      ///< Per-kind sequence; for kAck, the next reliable sequence expected.
+  uint32_t timestamp_us = 0;                  ///< Sender clock in microseconds (wraps), for jitter estimation.
+
+  [[nodiscard]] bool operator==(const DatagramHeader&) const noexcept = default;
+};
+
+/**
+ * @brief Writes a datagram header.
+ * @param header Header to encode
+ * @param out Destination (at least kDatagramHeaderSize bytes)
+ */
+constexpr void EncodeDatagramHeader(const DatagramHeader& header, std::span<uint8_t> out) noexcept {
+  out[0] = static_cast<uint8_t>(header.kind);
+  out[1] = header.session;
+  for (size_t i = 0; i < 4; ++i) {
+    out[2 + i] = static_cast<uint8_t>(header.sequence >> (8 * i));
+    out[6 + i] = static_cast<uint8_t>(header.timestamp_us >> (8 * i));
+  }
+}
+
+/**
+ * @brief Reads a datagram header.
+ * @param datagram Received datagram
+ * @return Header, or ProtocolError::kInvalidMessage if the datagram is too short or of unknown kind
+ */
+[[nodiscard]] constexpr auto DecodeDatagramHeader(std::span<const uint8_t> datagram) noexcept
+    -> std::expected<DatagramHeader, ProtocolError> {
+  if (datagram.size() < kDatagramHeaderSize || datagram[0] < static_cast<uint8_t>(DatagramKind::kLatest) ||
+      datagram[0] > static_cast<uint8_t>(DatagramKind::kAck)) {
+    return std::unexpected(ProtocolError::kInvalidMessage);
+  }
+
+  DatagramHeader header{.kind = static_cast<DatagramKind>(datagram[0]), .session = datagram[1]};
+  for (size_t i = 0; i < 4; ++i) {
+    header.sequence |= static_cast<uint32_t>(datagram[2 + i]) << (8 * i);
+    header.timestamp_us |= static_cast<uint32_t>(datagram[6 + i]) << (8 * i);
+  }
+  return header;
+}
+
+/**
+ * @brief Chooses the delivery class for an encoded frame.
+ * @param frame One encoded frame
+ * @return kLatest for compact control (MOVE, compact status, window ack), otherwise kReliable
+ */
+[[nodiscard]] CLIENT_COMM_API DatagramKind ClassifyFrame(std::span<const uint8_t> frame) noexcept;
+
+/**
+ * @brief Receive-side statistics of a DatagramChannel.
+ */
+struct DatagramStats {
+  uint64_t received = 0;           ///< kLatest datagrams delivered.
+  uint64_t lost = 0;               ///< kLatest sequences skipped over (never delivered).
+  uint64_t late = 0;               ///< kLatest datagrams dropped because a newer one was delivered first.
+  uint64_t duplicates = 0;         ///< Datagrams received again (either kind).
+  uint64_t reliable_received = 0;  ///< kReliable datagrams delivered.
+  uint64_t retransmissions = 0;    ///< kReliable datagrams sent again.
+  uint32_t jitter_us = 0;          ///< Interarrival jitter of kLatest datagrams (RFC 3550 estimator).
+
+  /**
+   * @brief Gets the fraction of kLatest datagrams that never arrived in time.
+   * @return Lost over lost plus received, or 0 before anything arrived
+   */
+  [[nodiscard]] double LossRate() const noexcept {
+    const uint64_t expected = received + lost;
+    return expected == 0 ? 0.0 : static_cast<double>(lost) / static_cast<double>(expected);
+  }
+
+  [[nodiscard]] bool operator==(const DatagramStats&) const noexcept = default;
+};
+
+/**
+ * @brief Sequencing for a control link over UDP.
+ * @details Tracking traffic and configuration have opposite needs. A MOVE that arrives late is
+ * worse than one that never arrives, so kLatest datagrams are never retransmitted and the
+ * receiver delivers one only if its sequence is newer than everything delivered before;
+ * reordered and duplicated datagrams are dropped and counted. Configuration must not be lost,
+ * so kReliable datagrams go through a go-back-N window: cumulative kAck datagrams, one
+ * retransmission timer with exponential backoff, in-order delivery.
+ *
+ * Each end picks a session byte when it resets. A datagram from a new session resets the
+ * receive side, so either end can restart (reconnect, reboot) without stale sequence numbers
+ * stalling the other. The first kReliable datagram of a session is sent alone until it is
+ * acknowledged, so the receiver always adopts the stream at its start.
+ *
+ * Sending and receiving take a `SendFn` callable as `void(std::span<const uint8_t> datagram)`
+ * that hands a datagram to the socket; receiving may send acknowledgements and queued datagrams.
+ * @note Not thread-safe; use from the thread that owns the socket.
+ */
+class CLIENT_COMM_API DatagramChannel {
+public:
+  /// kReliable datagrams in flight once the session is established.
+  static constexpr size_t kMaxInFlight = 8;
+
+  /// kReliable datagrams that may wait for the window, including those in flight.
+  static constexpr size_t kMaxQueued = 32;
+
+  /// Retransmission timeout after progress; a LAN round trip is a few milliseconds.
+  static constexpr std::chrono::milliseconds kInitialTimeout{50};
+
+  /// Upper bound for the backed-off timeout.
+  static constexpr std::chrono::milliseconds kMaxTimeout{1000};
+
+  /**
+   * @brief Constructs a channel.
+   * @param session Session byte for datagrams this end sends (see Reset())
+   */
+  explicit DatagramChannel(uint8_t session = 1) noexcept : session_(session) {}
+
+  /**
+   * @brief Sends a kLatest datagram.
+   * @tparam SendFn Callable as `void(std::span<const uint8_t> datagram)`
+   * @param payload One encoded frame
+   * @param now Current time
+   * @param send Hands the datagram to the socket
+   * @return False if @p payload does not fit in a datagram
+   */
+  template <typename SendFn>
+  bool SendLatest(std::span<const uint8_t> payload, std::chrono::steady_clock::time_point now, SendFn&& send);
+
+  /**
+   * @brief Queues a kReliable datagram and sends it once the window allows.
+   * @tparam SendFn Callable as `void(std::span<const uint8_t> datagram)`
+   * @param payload One encoded frame
+   * @param now Current time
+   * @param send Hands the datagram to the socket
+   * @return False if @p payload does not fit in a datagram or kMaxQueued datagrams are queued
+   */
+  template <typename SendFn>
+  bool SendReliable(std::span<const uint8_t> payload, std::chrono::steady_clock::time_point now, SendFn&& send);
+
+  /**
+   * @brief Processes a received datagram.
+   * @tparam DeliverFn Callable as `void(std::span<const uint8_t> payload)`
+   * @tparam SendFn Callable as `void(std::span<const uint8_t> datagram)`
+   * @param datagram Received datagram
+   * @param now Current time
+   * @param deliver Called with the payload if the datagram is delivered
+   * @param send Hands acknowledgements and newly permitted kReliable datagrams to the socket
+   * @return ProtocolError::kInvalidMessage if the header is malformed; dropped datagrams are not errors
+   */
+  template <typename DeliverFn, typename SendFn>
+  auto Receive(std::span<const uint8_t> datagram, std::chrono::steady_clock::time_point now, DeliverFn&& deliver,
+               SendFn&& send) -> std::expected<void, ProtocolError>;
+
+  /**
+   * @brief Retransmits the kReliable window if its acknowledgement is overdue.
+   * @tparam SendFn Callable as `void(std::span<const uint8_t> datagram)`
+   * @param now Current time
+   * @param send Hands the datagrams to the socket
+   * @return Number of datagrams retransmitted
+   */
+  template <typename SendFn>
+  size_t PollRetransmits(std::chrono::steady_clock::time_point now, SendFn&& send);
+
+  /**
+   * @brief Starts a new session: forgets all sequence state and queued datagrams.
+   * @param session Session byte for datagrams this end sends; pick a new one on every reset
+   */
+  void Reset(uint8_t session) noexcept;
+
+  /**
+   * @brief Gets the session byte of datagrams this end sends.
+   * @return Session byte
+   */
+  [[nodiscard]] uint8_t Session() const noexcept { return session_; }
+
+  /**
+   * @brief Gets the number of kReliable datagrams not yet acknowledged (sent or waiting).
+   * @return Queued datagram count
+   */
+  [[nodiscard]] size_t ReliablePending() const noexcept { return queue_.size(); }
+
+  /**
+   * @brief Gets the receive statistics.
+   * @return Statistics since the last Reset()
+   */
+  [[nodiscard]] const DatagramStats& Stats() const noexcept { return stats_; }
+
+private:
+  struct Entry {
+    uint32_t sequence = 0;
+    std::vector<uint8_t> datagram;
+  };
+
+  [[nodiscard]] static uint32_t Microseconds(std::chrono::steady_clock::time_point now) noexcept {
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count());
+  }
+
+  [[nodiscard]] size_t Window() const noexcept { return peer_acked_ ? kMaxInFlight : 1; }
+
+  template <typename SendFn>
+  void Transmit(std::chrono::steady_clock::time_point now, SendFn&& send);
+
+  void UpdateJitter(uint32_t sent_us, uint32_t arrived_us) noexcept;
+  void ResetReceiver(uint8_t peer_session) noexcept;
+  [[nodiscard]] bool Acknowledge(uint32_t next_expected, std::chrono::steady_clock::time_point now) noexcept;
+
+  uint8_t session_;
+  uint32_t next_latest_ = 0;
+  uint32_t next_reliable_ = 0;
+
+  std::deque<Entry> queue_;  ///< kReliable datagrams not yet acknowledged; the first in_flight_ were sent.
+  size_t in_flight_ = 0;
+  bool peer_acked_ = false;
+  std::chrono::milliseconds timeout_ = kInitialTimeout;
+  std::chrono::steady_clock::time_point deadline_{};
+
+  bool peer_known_ = false;
+  uint8_t peer_session_ = 0;
+  bool latest_synced_ = false;
+  uint32_t newest_latest_ = 0;
+  bool reliable_synced_ = false;
+  uint32_t expected_reliable_ = 0;
+
+  bool has_transit_ = false;
+  int32_t last_transit_us_ = 0;
+  uint32_t jitter_q4_ = 0;  ///< Jitter in 1/16 microseconds.
+
+  DatagramStats stats_;
+};
+
+template <typename SendFn>
+bool DatagramChannel::SendLatest(std::span<const uint8_t> payload, std::chrono::steady_clock::time_point now,
+                                 SendFn&& send) {
+  if (payload.size() > kMaxDatagramSize - kDatagramHeaderSize) {
+    return false;
+  }
+
+  std::array<uint8_t, kMaxDatagramSize> datagram;
+  EncodeDatagramHeader({.kind = DatagramKind::kLatest,
+                        .session = session_,
+                        .sequence = next_latest_++,
+                        .timestamp_us = Microseconds(now)},
+                       datagram);
+  std::ranges::copy(payload, datagram.begin() + kDatagramHeaderSize);
+  send(std::span<const uint8_t>(datagram.data(), kDatagramHeaderSize + payload.size()));
+  return true;
+}
+
+template <typename SendFn>
+bool DatagramChannel::SendReliable(std::span<const uint8_t> payload, std::chrono::steady_clock::time_point now,
+                                   SendFn&& send) {
+  if (payload.size() > kMaxDatagramSize - kDatagramHeaderSize || queue_.size() >= kMaxQueued) {
+    return false;
+  }
+
+  Entry entry{.sequence = next_reliable_++, .datagram = std::vector<uint8_t>(kDatagramHeaderSize + payload.size())};
+  EncodeDatagramHeader({.kind = DatagramKind::kReliable,
+                        .session = session_,
+                        .sequence = entry.sequence,
+                        .timestamp_us = Microseconds(now)},
+                       entry.datagram);
+  std::ranges::copy(payload, entry.datagram.begin() + kDatagramHeaderSize);
+  queue_.push_back(std::move(entry));
+
+  Transmit(now, send);
+  return true;
+}
+
+template <typename DeliverFn, typename SendFn>
+auto DatagramChannel::Receive(std::span<const uint8_t> datagram, std::chrono::steady_clock::time_point now,
+                              DeliverFn&& deliver, SendFn&& send) -> std::expected<void, ProtocolError> {
+  const auto header = DecodeDatagramHeader(datagram);
+  if (!header) {
+    return std::unexpected(header.error());
+  }
+
+  if (header->kind == DatagramKind::kAck) {
+    // An acknowledgement addressed to an earlier session of this end is stale
+    if (header->session == session_ && Acknowledge(header->sequence, now)) {
+      Transmit(now, send);
+    }
+    return {};
+  }
+
+  if (!peer_known_ || header->session != peer_session_) {
+    ResetReceiver(header->session);
+  }
+
+  const auto payload = datagram.subspan(kDatagramHeaderSize);
+  if (header->kind == DatagramKind::kLatest) {
+    UpdateJitter(header->timestamp_us, Microseconds(now));
+
+    const auto distance = static_cast<int32_t>(header->sequence - newest_latest_);
+    if (!latest_synced_ || distance > 0) {
+      stats_.lost += latest_synced_ ? static_cast<uint32_t>(distance) - 1 : 0;
+      latest_synced_ = true;
+      newest_latest_ = header->sequence;
+      ++stats_.received;
+      deliver(payload);
+    } else if (distance == 0) {
+      ++stats_.duplicates;
+    } else {
+      ++stats_.late;
+    }
+    return {};
+  }
+
+  // The first datagram of a session travels alone, so it is the start of the stream
+  if (!reliable_synced_) {
+    reliable_synced_ = true;
+    expected_reliable_ = header->sequence;
+  }
+
+  const auto distance = static_cast<int32_t>(header->sequence - expected_reliable_);
+  if (distance == 0) {
+    ++expected_reliable_;
+    ++stats_.reliable_received;
+    deliver(payload);
+  } else if (distance < 0) {
+    ++stats_.duplicates;
+  }
+  // Datagrams past a gap are dropped; go-back-N resends them after the missing one
+
+  std::array<uint8_t, kDatagramHeaderSize> ack;
+  EncodeDatagramHeader({.kind = DatagramKind::kAck,
+                        .session = header->session,
+                        .sequence = expected_reliable_,
+                        .timestamp_us = Microseconds(now)},
+                       ack);
+  send(std::span<const uint8_t>(ack));
+  return {};
+}
+
+template <typename SendFn>
+size_t DatagramChannel::PollRetransmits(std::chrono::steady_clock::time_point now, SendFn&& send) {
+  if (in_flight_ == 0 || now < deadline_) {
+    return 0;
+  }
+
+  for (size_t i = 0; i < in_flight_; ++i) {
+    send(std::span<const uint8_t>(queue_[i].datagram));
+  }
+  stats_.retransmissions += in_flight_;
+  timeout_ = std::min(timeout_ * 2, kMaxTimeout);
+  deadline_ = now + timeout_;
+  return in_flight_;
+}
+
+template <typename SendFn>
+void DatagramChannel::Transmit(std::chrono::steady_clock::time_point now, SendFn&& send) {
+  const size_t window = std::min(Window(), queue_.size());
+  if (in_flight_ == 0 && window != 0) {
+    deadline_ = now + timeout_;
+  }
+
+  for (; in_flight_ < window; ++in_flight_) {
+    send(std::span<const uint8_t>(queue_[in_flight_].datagram));
+  }
+}
+
+}  // namespace client::comm
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/protocol.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace client::comm {
+
+/**
+ * @brief Snapshot of the device state last reported by the firmware.
+ */
+struct DeviceState {
+  float pan = 0.0F;                                   ///< Current pan position in degrees.
+  float tilt = 0.0F;                                  ///< Current tilt position in degrees.
+  float target_pan = 0.0F;                            ///< Target pan position in degrees.
+  float target_tilt = 0.0F;                           ///< Target tilt position in degrees.
+  bool is_moving = false;                             ///< Whether the servos are moving.
+  bool is_calibrated = false;                         ///< Whether the device is calibrated.
+  uint32_t free_heap = 0;                             ///< Free device heap in bytes.
+  uint64_t uptime_ms = 0;                             ///< Device uptime in milliseconds.
+  uint64_t update_count = 0;                          ///< Number of status updates applied (0 = none yet).
+  std::chrono::steady_clock::time_point updated_at;  ///< Local time the last update was received.
+
+  /**
+   * @brief Checks if any status has been received.
+   * @return True if at least one update was applied
+   */
+  [[nodiscard]] bool Valid() const noexcept { return update_count != 0; }
+};
+
+/**
+ * @brief Lock-free mirror of the latest device status.
+ * @details A seqlock: one writer (the thread that receives responses) publishes updates,
+ * and any number of readers take consistent snapshots without blocking the writer.
+ * Readers retry only if they overlap an update, which takes a few nanoseconds.
+ */
+class DeviceShadow {
+public:
+  DeviceShadow() = default;
+  DeviceShadow(const DeviceShadow&) = delete;
+  DeviceShadow(DeviceShadow&&) = delete;
+  ~DeviceShadow() = default;
+
+  DeviceShadow& operator=(const DeviceShadow&) = delete;
+  DeviceShadow& operator=(DeviceShadow&&) = delete;
+
+  /**
+   * @brief Applies a status report.
+   * @param status Decoded status (ignored unless has_device_status is set)
+   * @param received_at Local receive time
+   * @warning Must only be called from one thread at a time.
+   */
+  void Update(const StatusMessage& status, std::chrono::steady_clock::time_point received_at) noexcept {
+    if (!status.has_device_status) {
+      return;
+    }
+
+    const uint64_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    pan_.store(status.pan_position, std::memory_order_relaxed);
+    tilt_.store(status.tilt_position, std::memory_order_relaxed);
+    target_pan_.store(status.target_pan, std::memory_order_relaxed);
+    target_tilt_.store(status.target_tilt, std::memory_order_relaxed);
+    is_moving_.store(status.is_moving, std::memory_order_relaxed);
+    is_calibrated_.store(status.is_calibrated, std::memory_order_relaxed);
+    free_heap_.store(status.free_heap, std::memory_order_relaxed);
+    uptime_ms_.store(status.uptime_ms, std::memory_order_relaxed);
+    update_count_.store(update_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    updated_at_ticks_.store(received_at.time_since_epoch().count(), std::memory_order_relaxed);
+
+    sequence_.store(seq + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief Takes a consistent snapshot of the device state.
+   * @return Latest state (check DeviceState::Valid())
+   */
+  [[nodiscard]] DeviceState Read() const noexcept {
+    DeviceState state;
+    uint64_t before = 0;
+    do {
+      before = sequence_.load(std::memory_order_acquire);
+      state.pan = pan_.load(std::memory_order_relaxed);
+      state.tilt = tilt_.load(std::memory_order_relaxed);
+      state.target_pan = target_pan_.load(std::memory_order_relaxed);
+      state.target_tilt = target_tilt_.load(std::memory_order_relaxed);
+      state.is_moving = is_moving_.load(std::memory_order_relaxed);
+      state.is_calibrated = is_calibrated_.load(std::memory_order_relaxed);
+      state.free_heap = free_heap_.load(std::memory_order_relaxed);
+      state.uptime_ms = uptime_ms_.load(std::memory_order_relaxed);
+      state.update_count = update_count_.load(std::memory_order_relaxed);
+      state.updated_at = std::chrono::steady_clock::time_point(
+          std::chrono::steady_clock::duration(updated_at_ticks_.load(std::memory_order_relaxed)));
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((before & 1) != 0 || before != sequence_.load(std::memory_order_relaxed));
+    return state;
+  }
+
+  /**
+   * @brief Forgets the mirrored state (e.g. on disconnect).
+   * @warning Must be called from the writer thread.
+   */
+  void Reset() noexcept {
+    const uint64_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    update_count_.store(0, std::memory_order_relaxed);
+    sequence_.store(seq + 2, std::memory_order_release);
+  }
+
+private:
+  std::atomic<uint64_t> sequence_{0};
+  std::atomic<float> pan_{0.0F};
+  std::atomic<float> tilt_{0.0F};
+  std::atomic<float> target_pan_{0.0F};
+  std::atomic<float> target_tilt_{0.0F};
+  std::atomic<bool> is_moving_{false};
+  std::atomic<bool> is_calibrated_{false};
+  std::atomic<uint32_t> free_heap_{0};
+  std::atomic<uint64_t> uptime_ms_{0};
+  std::atomic<uint64_t> update_count_{0};
+  std::atomic<std::chrono::steady_clock::rep> updated_at_ticks_{0};
+};
+
+}  // namespace client::comm
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/export.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace client::comm {
+
+/**
+ * @brief Error codes for stream framing.
+ */
+enum class FramingError : uint8_t {
+  kPayloadTooLarge,  ///< Payload exceeds kMaxFramePayloadSize.
+  kBufferTooSmall,   ///< Output buffer is too small for the encoded frame.
+  kFrameTooLong,     ///< Received more bytes than any valid frame can hold before a delimiter.
+  kMalformedCobs,    ///< COBS block runs past the end of the frame.
+  kMalformedHeader,  ///< Length varint or type tag is missing or invalid.
+  kLengthMismatch,   ///< Declared payload length does not match the frame size.
+  kCrcMismatch,      ///< CRC16 check failed.
+};
+
+/**
+ * @brief Converts FramingError to a human-readable string.
+ * @param error The error to convert
+ * @return A string view representing the error
+ */
+[[nodiscard]] constexpr std::string_view FramingErrorToString(FramingError error) noexcept {
+  switch (error) {
+    case FramingError::kPayloadTooLarge:
+      return "Payload too large";
+    case FramingError::kBufferTooSmall:
+      return "Buffer too small";
+    case FramingError::kFrameTooLong:
+      return "Frame too long";
+    case FramingError::kMalformedCobs:
+      return "Malformed COBS encoding";
+    case FramingError::kMalformedHeader:
+      return "Malformed frame header";
+    case FramingError::kLengthMismatch:
+      return "Frame length mismatch";
+    case FramingError::kCrcMismatch:
+      return "CRC mismatch";
+    default:
+      return "Unknown error";
+  }
+}
+
+/**
+ * @brief Type tag carried in every frame.
+ * @note Values are part of the wire format and shared with the firmware.
+ */
+enum class FrameType : uint8_t {
+  kCommand = 0x01,    ///< Client to device: app.Command.
+  kResponse = 0x02,   ///< Device to client: app.Response.
+  kHandshake = 0x03,  ///< Client to device: app.Handshake; device to client: app.HandshakeResponse.
+  kCompact = 0x04,    ///< Protocol v2 fixed-point control (see CompactMoveCommand / CompactStatus).
+  kWindowAck = 0x05,  ///< Device to client: windowed MOVE acknowledgement (see WindowAck).
+};
+
+/// Sync byte that opens and closes every frame; COBS guarantees it never appears inside one.
+inline constexpr uint8_t kFrameDelimiter = 0x00;
+
+/// Largest payload a frame may carry (matches the firmware's SPP packet limit).
+inline constexpr size_t kMaxFramePayloadSize = 512;
+
+/**
+ * @brief Computes the worst-case encoded frame size, including both delimiters.
+ * @param payload_size Payload size in bytes
+ * @return Encoded frame size upper bound
+ */
+[[nodiscard]] constexpr size_t MaxEncodedFrameSize(size_t payload_size) noexcept {
+  const size_t body = 3 + 1 + payload_size + 2;  // varint length, type, payload, CRC16
+  return 1 + body + (body / 254) + 1 + 1;        // sync, COBS overhead, delimiter
+}
+
+/**
+ * @brief Computes CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF).
+ * @param data Bytes to checksum
+ * @return CRC value
+ */
+[[nodiscard]] constexpr uint16_t Crc16(std::span<const uint8_t> data) noexcept {
+  constexpr auto kTable = []() {
+    std::array<uint16_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+      auto crc = static_cast<uint16_t>(i << 8);
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = static_cast<uint16_t>((crc & 0x8000) != 0 ? (crc << 1) ^ 0x1021 : crc << 1);
+      }
+      table[i] = crc;
+    }
+    return table;
+  }();
+
+  uint16_t crc = 0xFFFF;
+  for (const uint8_t byte : data) {
+    crc = static_cast<uint16_t>((crc << 8) ^ kTable[((crc >> 8) ^ byte) & 0xFF]);
+  }
+  return crc;
+}
+
+/**
+ * @brief A decoded frame.
+ * @note The payload view points into the decoder's buffer and is only valid until the next Feed().
+ */
+struct Frame {
+  FrameType type = FrameType::kCommand;  ///< Frame type tag.
+  std::span<const uint8_t> payload;      ///< Frame payload.
+};
+
+/**
+ * @brief Encodes a payload as a frame into a caller-provided buffer.
+ * @details Wire format: `0x00 | COBS(varint length | type | payload | CRC16 LE) | 0x00`.
+ * The CRC covers the length, type and payload.
+ * @param type Frame type tag
+ * @param payload Payload bytes
+ * @param out Output buffer (MaxEncodedFrameSize(payload.size()) bytes always suffice)
+ * @return Number of bytes written, or FramingError on failure
+ */
+[[nodiscard]] CLIENT_COMM_API auto EncodeFrame(FrameType type, std::span<const uint8_t> payload,
+                                               std::span<uint8_t> out) -> std::expected<size_t, FramingError>;
+
+/**
+ * @brief Encodes a payload as a frame.
+ * @param type Frame type tag
+ * @param payload Payload bytes
+ * @return Encoded frame, or FramingError on failure
+ */
+[[nodiscard]] CLIENT_COMM_API auto EncodeFrame(FrameType type, std::span<const uint8_t> payload)
+    -> std::expected<std::vector<uint8_t>, FramingError>;
+
+/**
+ * @brief Decodes one frame in place.
+ * @param encoded COBS bytes between two delimiters (overwritten with the decoded body)
+ * @return Frame whose payload points into @p encoded, or FramingError on failure
+ */
+[[nodiscard]] CLIENT_COMM_API auto DecodeFrame(std::span<uint8_t> encoded) -> std::expected<Frame, FramingError>;
+
+/**
+ * @brief Reassembles frames from an arbitrarily chunked byte stream.
+ * @details Bytes are buffered until a delimiter arrives, so frames split across reads or
+ * several frames in one read are both handled. A corrupt frame is dropped and decoding
+ * resynchronises at the next delimiter.
+ */
+class CLIENT_COMM_API FrameDecoder {
+public:
+  /// Longest run of non-delimiter bytes that can still be a valid frame.
+  static constexpr size_t kMaxEncodedBodySize = MaxEncodedFrameSize(kMaxFramePayloadSize) - 2;
+
+  FrameDecoder() { buffer_.reserve(kMaxEncodedBodySize); }
+  FrameDecoder(const FrameDecoder&) = default;
+  FrameDecoder(FrameDecoder&&) noexcept = default;
+  ~FrameDecoder() = default;
+
+  FrameDecoder& operator=(const FrameDecoder&) = default;
+  FrameDecoder& operator=(FrameDecoder&&) noexcept = default;
+
+  /**
+   * @brief Feeds received bytes and invokes a callback for each complete frame.
+   * @param data Received bytes (any chunking)
+   * @param on_frame Callback invoked as `on_frame(const Frame&)`
+   * @return Number of frames delivered
+   */
+  template <typename OnFrame>
+    requires std::invocable<OnFrame&, const Frame&>
+  size_t Feed(std::span<const uint8_t> data, OnFrame&& on_frame) {
+    size_t delivered = 0;
+    for (const uint8_t byte : data) {
+      if (byte != kFrameDelimiter) {
+        if (buffer_.size() < kMaxEncodedBodySize) {
+          buffer_.push_back(byte);
+        } else {
+          overflowed_ = true;
+        }
+        continue;
+      }
+
+      if (overflowed_) {
+        RecordError(FramingError::kFrameTooLong);
+      } else if (!buffer_.empty()) {
+        const auto frame = DecodeFrame(buffer_);
+        if (frame) {
+          ++frames_decoded_;
+          ++delivered;
+          on_frame(*frame);
+        } else {
+          RecordError(frame.error());
+        }
+      }
+      buffer_.clear();
+      overflowed_ = false;
+    }
+    return delivered;
+  }
+
+  /**
+   * @brief Discards any partially received frame (e.g. after a reconnect).
+   */
+  void Reset() noexcept {
+    buffer_.clear();
+    overflowed_ = false;
+  }
+
+  /**
+   * @brief Gets the number of frames decoded successfully.
+   * @return Frame count
+   */
+  [[nodiscard]] uint64_t FramesDecoded() const noexcept { return frames_decoded_; }
+
+  /**
+   * @brief Gets the number of frames dropped as corrupt.
+   * @return Dropped frame count
+   */
+  [[nodiscard]] uint64_t FramesDropped() const noexcept { return frames_dropped_; }
+
+  /**
+   * @brief Gets the reason the most recent frame was dropped.
+   * @return Last error, meaningful only if FramesDropped() > 0
+   */
+  [[nodiscard]] FramingError LastError() const noexcept { return last_error_; }
+
+private:
+  void RecordError(FramingError error) noexcept {
+    ++frames_dropped_;
+    last_error_ = error;
+  }
+
+  std::vector<uint8_t> buffer_;
+  bool overflowed_ = false;
+  uint64_t frames_decoded_ = 0;
+  uint64_t frames_dropped_ = 0;
+  FramingError last_error_ = FramingError::kMalformedCobs;
+};
+
+}  // namespace client::comm
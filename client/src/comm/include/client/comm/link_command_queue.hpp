@@ -0,0 +1,172 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/export.hpp>
+#include <client/comm/framing.hpp>
+#include <client/comm/link_session.hpp>
+#include <client/comm/protocol.hpp>
+#include <client/comm/transport.hpp>
+#include <client/core/utils/mpsc_queue.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <span>
+
+namespace client::comm {
+
+/**
+ * @brief What a LinkCommand asks the session to do.
+ */
+enum class LinkCommandKind : uint8_t {
+  kMove,      ///< LinkSession::SendMove().
+  kControl,   ///< LinkSession::SendControl().
+  kReliable,  ///< LinkSession::SendReliable().
+};
+
+/**
+ * @brief Command handed from any thread to the thread that owns the LinkSession.
+ * @details Self-contained (the payload is copied in), so the submitting thread may reuse its
+ * buffers right away.
+ */
+struct CLIENT_COMM_API LinkCommand {
+  LinkCommandKind kind = LinkCommandKind::kMove;
+  FrameType frame_type = FrameType::kCommand;  ///< Frame type of a kControl payload.
+  uint32_t command_id = 0;                     ///< Command ID of a kReliable payload.
+  ServoCommand move;                           ///< Servo command of a kMove.
+  std::array<uint8_t, kMaxFramePayloadSize> payload{};
+  size_t size = 0;                                     ///< Bytes used in payload.
+  std::chrono::steady_clock::time_point submitted_at;  ///< Time the command was submitted.
+
+  /**
+   * @brief Gets the serialized message of a kControl or kReliable command.
+   * @return Payload bytes
+   */
+  [[nodiscard]] std::span<const uint8_t> Payload() const noexcept { return {payload.data(), size}; }
+};
+
+/**
+ * @brief Lock-free submission of link commands to the comm thread.
+ * @details Any thread (tracker, GUI) submits; the comm thread drains the commands into its
+ * LinkSession in submission order. Submitting never takes a lock or waits for the comm thread,
+ * so a busy GUI or a long inference frame cannot delay another thread's MOVE. The wake callback
+ * runs only when the queue goes from idle to pending, so the comm thread is notified once per
+ * batch rather than once per command.
+ * @note Submit*() may be called from any thread; Drain() from the comm thread only.
+ */
+class CLIENT_COMM_API LinkCommandQueue {
+public:
+  /// Commands that may wait for the comm thread at once.
+  static constexpr size_t kCapacity = 64;
+
+  /**
+   * @brief Callback type that asks the comm thread to call Drain(); called from submitting threads.
+   */
+#if __cpp_lib_move_only_function >= 202110L
+  using WakeCallback = std::move_only_function<void()>;
+#else
+  using WakeCallback = std::function<void()>;
+#endif
+
+  /**
+   * @brief Constructs a queue.
+   * @param wake Thread-safe callback that schedules Drain() on the comm thread
+   */
+  explicit LinkCommandQueue(WakeCallback wake = nullptr) : wake_(std::move(wake)) {}
+
+  LinkCommandQueue(const LinkCommandQueue&) = delete;
+  LinkCommandQueue(LinkCommandQueue&&) = delete;
+  ~LinkCommandQueue() = default;
+
+  LinkCommandQueue& operator=(const LinkCommandQueue&) = delete;
+  LinkCommandQueue& operator=(LinkCommandQueue&&) = delete;
+
+  /**
+   * @brief Sets the wake callback.
+   * @param wake Thread-safe callback that schedules Drain() on the comm thread
+   * @warning Set before the first submission; not synchronized with submitting threads.
+   */
+  void SetWakeCallback(WakeCallback wake) noexcept { wake_ = std::move(wake); }
+
+  /**
+   * @brief Submits a servo MOVE.
+   * @param cmd Servo command
+   * @return False if the queue is full; the MOVE is dropped (a newer one supersedes it anyway)
+   */
+  bool SubmitMove(const ServoCommand& cmd);
+
+  /**
+   * @brief Submits a control message.
+   * @param payload Serialized message (at most kMaxFramePayloadSize bytes)
+   * @param type Frame type
+   * @return False if the queue is full or the payload too large
+   */
+  bool SubmitControl(std::span<const uint8_t> payload, FrameType type = FrameType::kCommand);
+
+  /**
+   * @brief Submits a control command that is retransmitted until its response arrives.
+   * @param command_id Command ID echoed in the response
+   * @param payload Serialized command (at most kMaxFramePayloadSize bytes)
+   * @return False if the queue is full or the payload too large
+   */
+  bool SubmitReliable(uint32_t command_id, std::span<const uint8_t> payload);
+
+  /**
+   * @brief Hands every pending command to @p execute, oldest first (comm thread only).
+   * @tparam ExecuteFn Callable as `void(const LinkCommand& command)`
+   * @param execute Function that executes one command (see ExecuteLinkCommand())
+   * @return Number of commands executed
+   */
+  template <typename ExecuteFn>
+  size_t Drain(ExecuteFn&& execute);
+
+  /**
+   * @brief Gets the number of commands waiting for the comm thread (any thread).
+   * @return Approximate queue depth
+   */
+  [[nodiscard]] size_t Depth() const noexcept { return queue_.SizeApprox(); }
+
+  /**
+   * @brief Gets the number of commands rejected because the queue was full (any thread).
+   * @return Dropped command count
+   */
+  [[nodiscard]] uint64_t Dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  bool Submit(LinkCommand& command);
+
+  utils::MpscQueue<LinkCommand, kCapacity> queue_;
+  std::atomic<bool> wake_pending_{false};
+  std::atomic<uint64_t> dropped_{0};
+  WakeCallback wake_;
+};
+
+template <typename ExecuteFn>
+size_t LinkCommandQueue::Drain(ExecuteFn&& execute) {
+  // Cleared before popping: whatever is submitted from here on wakes the comm thread again.
+  // The exchange also acquires everything pushed by the producers that set the flag.
+  wake_pending_.exchange(false, std::memory_order_acq_rel);
+
+  size_t executed = 0;
+  while (auto command = queue_.TryPop()) {
+    execute(static_cast<const LinkCommand&>(*command));
+    ++executed;
+  }
+  return executed;
+}
+
+/**
+ * @brief Executes a LinkCommand on a session.
+ * @param session Session on the calling (comm) thread
+ * @param command Command to execute
+ * @return Result of the LinkSession call
+ */
+[[nodiscard]] CLIENT_COMM_API auto ExecuteLinkCommand(LinkSession& session, const LinkCommand& command)
+    -> std::expected<void, TransportError>;
+
+}  // namespace client::comm
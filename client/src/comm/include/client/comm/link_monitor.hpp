@@ -0,0 +1,187 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/export.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace client::comm {
+
+/**
+ * @brief Link latency and clock estimates derived from ping round trips.
+ */
+struct LinkStats {
+  /// Retransmission timeout before any round trip was measured (RFC 6298).
+  static constexpr std::chrono::milliseconds kInitialRetransmitTimeout{1000};
+
+  /// Lower bound for the retransmission timeout; RFC 6298 asks for 1 s, which is far above a BT link's RTT.
+  static constexpr std::chrono::milliseconds kMinRetransmitTimeout{200};
+
+  double rtt_ms = 0.0;           ///< Smoothed round-trip time (RFC 6298 SRTT).
+  double rtt_var_ms = 0.0;       ///< Round-trip time variation (RFC 6298 RTTVAR).
+  double last_rtt_ms = 0.0;      ///< Most recent round-trip time.
+  double min_rtt_ms = 0.0;       ///< Lowest round-trip time seen on this connection.
+  double jitter_ms = 0.0;        ///< Smoothed change between consecutive round trips (RFC 3550 estimator).
+  double clock_offset_ms = 0.0;  ///< Device clock minus host steady clock, in milliseconds.
+  uint64_t sent = 0;             ///< Pings sent.
+  uint64_t samples = 0;          ///< Pongs received.
+  uint64_t lost = 0;             ///< Pings that timed out or were displaced before a pong arrived.
+
+  /**
+   * @brief Checks if any round trip has been measured.
+   * @return True if at least one pong was received
+   */
+  [[nodiscard]] bool Valid() const noexcept { return samples != 0; }
+
+  /**
+   * @brief Estimates the one-way link delay.
+   * @return Half the smoothed round-trip time, in milliseconds
+   */
+  [[nodiscard]] double OneWayDelayMs() const noexcept { return rtt_ms / 2.0; }
+
+  /**
+   * @brief Computes how long to wait for a response before retransmitting.
+   * @return SRTT + 4 * RTTVAR (RFC 6298), at least kMinRetransmitTimeout, or kInitialRetransmitTimeout if not Valid()
+   */
+  [[nodiscard]] std::chrono::milliseconds RetransmitTimeout() const noexcept {
+    if (!Valid()) {
+      return kInitialRetransmitTimeout;
+    }
+    const auto rto = std::chrono::milliseconds(static_cast<int64_t>(std::ceil(rtt_ms + 4.0 * rtt_var_ms)));
+    return std::max(rto, kMinRetransmitTimeout);
+  }
+
+  /**
+   * @brief Maps a device timestamp onto the host steady clock.
+   * @param device_ms Device timestamp in milliseconds since boot
+   * @return Host time at which the device clock read @p device_ms
+   * @note Only meaningful when Valid().
+   */
+  [[nodiscard]] std::chrono::steady_clock::time_point DeviceToHost(uint64_t device_ms) const noexcept {
+    const std::chrono::duration<double, std::milli> host(static_cast<double>(device_ms) - clock_offset_ms);
+    return std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(host));
+  }
+};
+
+/**
+ * @brief Ping scheduler and round-trip estimator for the device link.
+ * @details Decides when to ping, remembers when each ping left, and turns the matching pong
+ * into RTT, jitter and clock offset estimates. The offset is NTP-style: the device timestamps
+ * its reply, which is assumed to happen halfway through the round trip, and of the last
+ * kOffsetWindow samples the one with the lowest RTT (the least queueing) is trusted.
+ * @note Thread-safe.
+ */
+class CLIENT_COMM_API LinkMonitor {
+public:
+  /// Default time between pings.
+  static constexpr std::chrono::milliseconds kDefaultInterval{1000};
+
+  /// Default time after which an unanswered ping counts as lost.
+  static constexpr std::chrono::milliseconds kDefaultTimeout{3000};
+
+  /// Pings that may be awaiting a pong at once; sending more displaces the oldest.
+  static constexpr size_t kMaxOutstanding = 8;
+
+  /// Recent samples considered when picking the clock offset.
+  static constexpr size_t kOffsetWindow = 8;
+
+  /**
+   * @brief Constructs a monitor.
+   * @param interval Time between pings
+   * @param timeout Time after which an unanswered ping counts as lost
+   */
+  explicit LinkMonitor(std::chrono::milliseconds interval = kDefaultInterval,
+                       std::chrono::milliseconds timeout = kDefaultTimeout) noexcept
+      : interval_(interval), timeout_(timeout) {}
+
+  /**
+   * @brief Checks whether the next ping should be sent.
+   * @param now Current time
+   * @return True if no ping was sent yet or the interval has elapsed since the last one
+   */
+  [[nodiscard]] bool PingDue(std::chrono::steady_clock::time_point now) const;
+
+  /**
+   * @brief Records that a ping left.
+   * @param id Command ID carried by the ping
+   * @param sent_at Time the ping was queued
+   */
+  void OnPingSent(uint32_t id, std::chrono::steady_clock::time_point sent_at);
+
+  /**
+   * @brief Applies the device's reply to a ping.
+   * @param id Command ID echoed by the device
+   * @param device_timestamp_ms Device clock when it replied, in milliseconds since boot
+   * @param received_at Time the reply was received
+   * @return True if @p id matched an outstanding ping
+   */
+  bool OnPong(uint32_t id, uint64_t device_timestamp_ms, std::chrono::steady_clock::time_point received_at);
+
+  /**
+   * @brief Drops pings that have waited longer than the timeout.
+   * @tparam ExpiredFn Callable as `void(uint32_t id)`
+   * @param now Current time
+   * @param on_expired Called (outside the lock) with the ID of each expired ping
+   * @return Number of pings expired
+   */
+  template <typename ExpiredFn>
+  size_t Expire(std::chrono::steady_clock::time_point now, ExpiredFn&& on_expired);
+
+  /**
+   * @brief Gets the current estimates.
+   * @return Snapshot of the link statistics
+   */
+  [[nodiscard]] LinkStats Stats() const;
+
+  /**
+   * @brief Forgets all pings and estimates (e.g. on reconnect).
+   */
+  void Reset();
+
+private:
+  struct Outstanding {
+    uint32_t id = 0;
+    std::chrono::steady_clock::time_point sent_at;
+    bool active = false;
+  };
+
+  struct OffsetSample {
+    double rtt_ms = 0.0;
+    double offset_ms = 0.0;
+  };
+
+  [[nodiscard]] size_t CollectExpired(std::chrono::steady_clock::time_point now,
+                                      std::array<uint32_t, kMaxOutstanding>& expired);
+
+  std::chrono::milliseconds interval_;
+  std::chrono::milliseconds timeout_;
+
+  mutable std::mutex mutex_;
+  std::array<Outstanding, kMaxOutstanding> outstanding_{};
+  size_t next_slot_ = 0;
+  std::array<OffsetSample, kOffsetWindow> offsets_{};
+  size_t offset_count_ = 0;
+  size_t next_offset_ = 0;
+  std::chrono::steady_clock::time_point last_ping_;
+  bool pinged_ = false;
+  LinkStats stats_;
+};
+
+template <typename ExpiredFn>
+size_t LinkMonitor::Expire(std::chrono::steady_clock::time_point now, ExpiredFn&& on_expired) {
+  std::array<uint32_t, kMaxOutstanding> expired{};
+  const size_t count = CollectExpired(now, expired);
+  for (size_t i = 0; i < count; ++i) {
+    on_expired(expired[i]);
+  }
+  return count;
+}
+
+}  // namespace client::comm
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/ack_tracker.hpp>
+#include <client/comm/command_scheduler.hpp>
+#include <client/comm/export.hpp>
+#include <client/comm/framing.hpp>
+#include <client/comm/link_monitor.hpp>
+#include <client/comm/protocol.hpp>
+#include <client/comm/retransmit_queue.hpp>
+#include <client/comm/transport.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <span>
+
+namespace client::comm {
+
+/**
+ * @brief Device protocol session over any ITransport.
+ * @details Everything between the application and the byte link that does not depend on the
+ * backend: framing, the outbound CommandScheduler, the protocol v2 handshake, compact MOVE
+ * encoding, windowed acknowledgements and retransmission of non-idempotent commands. The owner
+ * attaches a transport, calls Start() once it is open and Stop() once it closed, and calls
+ * PollRetransmits() periodically.
+ * @note Not thread-safe; use from the thread that owns the transport. The status getters
+ * (CompactControlActive(), WindowAckActive(), Retransmissions()) may be read from any thread.
+ */
+class CLIENT_COMM_API LinkSession {
+public:
+  /**
+   * @brief Callback type for the payload of a response from the device.
+   */
+#if __cpp_lib_move_only_function >= 202110L
+  using DataReceivedCallback = std::move_only_function<void(std::span<const uint8_t> data)>;
+#else
+  using DataReceivedCallback = std::function<void(std::span<const uint8_t> data)>;
+#endif
+
+  /**
+   * @brief Callback type for a MOVE acknowledged by a windowed acknowledgement.
+   */
+#if __cpp_lib_move_only_function >= 202110L
+  using AckCallback = std::move_only_function<void(uint32_t command_id)>;
+#else
+  using AckCallback = std::function<void(uint32_t command_id)>;
+#endif
+
+  /// How often the owner should call PollRetransmits().
+  static constexpr std::chrono::milliseconds kRetransmitPollInterval{50};
+
+  LinkSession() = default;
+  LinkSession(const LinkSession&) = delete;
+  LinkSession(LinkSession&&) = delete;
+  ~LinkSession();
+
+  LinkSession& operator=(const LinkSession&) = delete;
+  LinkSession& operator=(LinkSession&&) = delete;
+
+  /**
+   * @brief Binds the session to a transport and takes over its receive and writable callbacks.
+   * @param transport Transport to use, or nullptr to detach; must outlive the session or be detached first
+   * @note The transport's state callback stays with the owner, which calls Start() and Stop().
+   */
+  void Attach(ITransport* transport);
+
+  /**
+   * @brief Starts a new session on an open transport: resets all state and sends the handshake.
+   */
+  void Start();
+
+  /**
+   * @brief Ends the session: drops pending commands and negotiated features.
+   */
+  void Stop();
+
+  /**
+   * @brief Queues a servo MOVE (latest wins, see CommandScheduler).
+   * @param cmd Servo command to send
+   * @return Expected void on success, or error on failure
+   */
+  [[nodiscard]] auto SendMove(const ServoCommand& cmd) -> std::expected<void, TransportError>;
+
+  /**
+   * @brief Queues a control message; control messages are never coalesced and go out ahead of any MOVE.
+   * @param payload Serialized message
+   * @param type Frame type
+   * @return Expected void on success, or error on failure
+   */
+  [[nodiscard]] auto SendControl(std::span<const uint8_t> payload, FrameType type = FrameType::kCommand)
+      -> std::expected<void, TransportError>;
+
+  /**
+   * @brief Queues a control command that is retransmitted until its response arrives (see RetransmitQueue).
+   * @param command_id Command ID echoed in the response; 0 sends the command once
+   * @param payload Serialized command
+   * @return Expected void on success, or error on failure
+   */
+  [[nodiscard]] auto SendReliable(uint32_t command_id, std::span<const uint8_t> payload)
+      -> std::expected<void, TransportError>;
+
+  /**
+   * @brief Retransmits overdue commands.
+   * @param now Current time
+   * @return Number of frames retransmitted
+   */
+  size_t PollRetransmits(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+  /**
+   * @brief Sets the data received callback.
+   * @param callback Callback to invoke with the payload of each response, as a v1 StatusMessage
+   */
+  void SetDataReceivedCallback(DataReceivedCallback callback) noexcept {
+    data_received_callback_ = std::move(callback);
+  }
+
+  /**
+   * @brief Sets the windowed acknowledgement callback.
+   * @param callback Callback to invoke once for each MOVE the device acknowledged in a WindowAck
+   */
+  void SetAckCallback(AckCallback callback) noexcept { ack_callback_ = std::move(callback); }
+
+  /**
+   * @brief Sets how long to wait for a response before retransmitting a command.
+   * @param timeout Initial retransmission timeout (see LinkStats::RetransmitTimeout())
+   */
+  void SetRetransmitTimeout(std::chrono::milliseconds timeout) noexcept {
+    retransmit_timeout_ms_.store(timeout.count(), std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Sets the transport backlog below which a pending MOVE is written.
+   * @param bytes Low watermark in bytes (see CommandScheduler::kDefaultLowWatermark)
+   */
+  void SetLowWatermark(size_t bytes) noexcept { scheduler_.SetLowWatermark(bytes); }
+
+  /**
+   * @brief Gets the outbound scheduler.
+   * @return Const reference to the scheduler
+   */
+  [[nodiscard]] const CommandScheduler& Scheduler() const noexcept { return scheduler_; }
+
+  /**
+   * @brief Gets the frame decoder.
+   * @return Const reference to the decoder
+   */
+  [[nodiscard]] const FrameDecoder& Decoder() const noexcept { return frame_decoder_; }
+
+  /**
+   * @brief Checks whether the device agreed to protocol v2 compact control in the handshake.
+   * @return True if MOVEs are sent as compact fixed-point frames instead of protobuf
+   */
+  [[nodiscard]] bool CompactControlActive() const noexcept { return compact_enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Checks whether the device agreed to acknowledge MOVEs in windows in the handshake.
+   * @return True if MOVEs are acknowledged through the AckCallback rather than individual responses
+   */
+  [[nodiscard]] bool WindowAckActive() const noexcept { return window_ack_enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Gets the number of commands retransmitted because their response was overdue.
+   * @return Retransmission count
+   */
+  [[nodiscard]] uint64_t Retransmissions() const noexcept { return retransmissions_.load(std::memory_order_relaxed); }
+
+private:
+  [[nodiscard]] auto Queue(std::span<const uint8_t> payload, FrameType type, bool latest_wins, uint32_t command_id)
+      -> std::expected<void, TransportError>;
+  void Pump();
+  void OnReceived(std::span<const uint8_t> data);
+  void OnFrame(const Frame& frame);
+  void SendHandshake();
+  void OnHandshakeResponse(std::span<const uint8_t> payload);
+  void OnCompactStatus(std::span<const uint8_t> payload);
+  void OnWindowAck(std::span<const uint8_t> payload);
+  void OnResponse(std::span<const uint8_t> payload);
+  void Deliver(const StatusMessage& msg);
+
+  ITransport* transport_ = nullptr;
+  FrameDecoder frame_decoder_;
+  CommandScheduler scheduler_;
+  AckTracker ack_tracker_;
+  RetransmitQueue retransmit_queue_;
+  uint32_t last_move_command_id_ = 0;
+
+  std::atomic<bool> compact_enabled_{false};
+  std::atomic<bool> window_ack_enabled_{false};
+  std::atomic<int64_t> retransmit_timeout_ms_{LinkStats::kInitialRetransmitTimeout.count()};
+  std::atomic<uint64_t> retransmissions_{0};
+
+  DataReceivedCallback data_received_callback_;
+  AckCallback ack_callback_;
+};
+
+}  // namespace client::comm
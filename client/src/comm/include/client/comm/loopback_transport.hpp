@@ -0,0 +1,85 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/export.hpp>
+#include <client/comm/transport.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace client::comm {
+
+/**
+ * @brief In-process transport pair for tests, benchmarks and device stand-ins.
+ * @details Bytes written to one end wait in its backlog until Pump() moves them to the other
+ * end, so a test controls exactly when data crosses and how much: pumping a fixed number of
+ * bytes per simulated tick models a link of that rate, including the backlog the
+ * CommandScheduler watermark reacts to. Nothing runs on its own; no event loop is needed.
+ * @note Not thread-safe; drive both ends from one thread.
+ */
+class CLIENT_COMM_API LoopbackTransport final : public ITransport {
+public:
+  /// Pump() limit that moves the whole backlog.
+  static constexpr size_t kUnlimited = std::numeric_limits<size_t>::max();
+
+  /**
+   * @brief Creates two connected ends.
+   * @return Both ends; either may be destroyed first
+   */
+  [[nodiscard]] static auto CreatePair()
+      -> std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>>;
+
+  LoopbackTransport(const LoopbackTransport&) = delete;
+  LoopbackTransport(LoopbackTransport&&) = delete;
+  ~LoopbackTransport() override;
+
+  LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+  LoopbackTransport& operator=(LoopbackTransport&&) = delete;
+
+  [[nodiscard]] TransportKind Kind() const noexcept override { return TransportKind::kLoopback; }
+
+  /**
+   * @brief Opens this end; the state callback reports kOpen before this returns.
+   * @param address Ignored
+   * @return Expected void on success, or TransportError::kAlreadyOpen, or kNotOpen if the peer is gone
+   */
+  [[nodiscard]] auto Open(std::string_view address = {}) -> std::expected<void, TransportError> override;
+
+  /**
+   * @brief Closes this end and discards its backlog; an open peer reports TransportError::kConnectionLost.
+   */
+  void Close() override;
+
+  /**
+   * @brief Appends bytes to the backlog.
+   * @param data Data to write
+   * @return Expected number of bytes accepted, or TransportError::kNotOpen
+   */
+  [[nodiscard]] auto Write(std::span<const uint8_t> data) -> std::expected<size_t, TransportError> override;
+
+  [[nodiscard]] size_t Backlog() const noexcept override { return backlog_.size(); }
+
+  /**
+   * @brief Moves backlog bytes to the peer.
+   * @param max_bytes Most bytes to move
+   * @return Bytes moved; they are dropped if the peer is not open
+   * @note The peer's receive callback gets them as one chunk, then this end's writable callback runs.
+   */
+  size_t Pump(size_t max_bytes = kUnlimited);
+
+private:
+  LoopbackTransport() = default;
+
+  LoopbackTransport* peer_ = nullptr;
+  std::vector<uint8_t> backlog_;
+};
+
+}  // namespace client::comm
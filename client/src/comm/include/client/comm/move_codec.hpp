@@ -0,0 +1,357 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/protocol.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+
+namespace client::comm {
+
+/**
+ * @brief Largest encoding of a MOVE command produced by EncodeMoveCommand().
+ * @details id (1 + 5) + timestamp_ms (1 + 10) + type (2) + move header (2) + target_position (2 + 10)
+ * + target_velocity (2 + 10) + valid_for_ms (1 + 5).
+ */
+inline constexpr size_t kMaxMoveCommandSize = 51;
+
+/**
+ * @brief Encoded MOVE command held in a fixed-size buffer.
+ */
+struct MoveCommandBytes {
+  std::array<uint8_t, kMaxMoveCommandSize> data{};  ///< Encoded bytes (first size are valid).
+  size_t size = 0;                                  ///< Number of valid bytes.
+
+  /**
+   * @brief Gets the encoded bytes.
+   * @return View of the valid bytes
+   */
+  [[nodiscard]] constexpr std::span<const uint8_t> Bytes() const noexcept { return {data.data(), size}; }
+};
+
+namespace detail {
+
+// Protobuf wire types and the tags used by app.Command{type = MOVE}
+inline constexpr uint8_t kWireVarint = 0;
+inline constexpr uint8_t kWireFixed64 = 1;
+inline constexpr uint8_t kWireLengthDelimited = 2;
+inline constexpr uint8_t kWireFixed32 = 5;
+
+inline constexpr uint32_t kCommandIdField = 1;
+inline constexpr uint32_t kCommandTimestampField = 2;
+inline constexpr uint32_t kCommandTypeField = 3;
+inline constexpr uint32_t kCommandMoveField = 10;
+inline constexpr uint32_t kCommandCalibrateField = 11;
+inline constexpr uint32_t kCommandSetConfigField = 12;
+inline constexpr uint32_t kMoveTargetField = 2;
+inline constexpr uint32_t kMoveVelocityField = 4;
+inline constexpr uint32_t kMoveValidForField = 5;
+inline constexpr uint32_t kPositionPanField = 1;
+inline constexpr uint32_t kPositionTiltField = 2;
+
+inline constexpr uint64_t kCommandTypeMove = 1;  ///< app.COMMAND_TYPE_MOVE.
+
+[[nodiscard]] constexpr uint8_t Tag(uint32_t field, uint8_t wire_type) noexcept {
+  return static_cast<uint8_t>((field << 3) | wire_type);
+}
+
+[[nodiscard]] constexpr size_t VarintSize(uint64_t value) noexcept {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+[[nodiscard]] constexpr size_t PutVarint(uint64_t value, std::span<uint8_t> out, size_t pos) noexcept {
+  while (value >= 0x80) {
+    out[pos++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  out[pos++] = static_cast<uint8_t>(value);
+  return pos;
+}
+
+[[nodiscard]] constexpr size_t PutFixed32(uint32_t value, std::span<uint8_t> out, size_t pos) noexcept {
+  for (int i = 0; i < 4; ++i) {
+    out[pos++] = static_cast<uint8_t>(value >> (8 * i));
+  }
+  return pos;
+}
+
+/// Size of the body of an app.ServoPosition whose floats have the given bit patterns.
+[[nodiscard]] constexpr size_t PositionSize(uint32_t pan_bits, uint32_t tilt_bits) noexcept {
+  return (pan_bits != 0 ? 5U : 0U) + (tilt_bits != 0 ? 5U : 0U);
+}
+
+/// Writes an app.ServoPosition sub-message (tag, length and body) under the given field number.
+[[nodiscard]] constexpr size_t PutPosition(uint32_t field, uint32_t pan_bits, uint32_t tilt_bits,
+                                           std::span<uint8_t> out, size_t pos) noexcept {
+  out[pos++] = Tag(field, kWireLengthDelimited);
+  out[pos++] = static_cast<uint8_t>(PositionSize(pan_bits, tilt_bits));
+  if (pan_bits != 0) {
+    out[pos++] = Tag(kPositionPanField, kWireFixed32);
+    pos = PutFixed32(pan_bits, out, pos);
+  }
+  if (tilt_bits != 0) {
+    out[pos++] = Tag(kPositionTiltField, kWireFixed32);
+    pos = PutFixed32(tilt_bits, out, pos);
+  }
+  return pos;
+}
+
+/// Reads a varint at pos; returns false if it is truncated or longer than 10 bytes.
+[[nodiscard]] constexpr bool GetVarint(std::span<const uint8_t> data, size_t& pos, uint64_t& value) noexcept {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (pos >= data.size()) {
+      return false;
+    }
+    const uint8_t byte = data[pos++];
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+[[nodiscard]] constexpr bool GetFixed32(std::span<const uint8_t> data, size_t& pos, uint32_t& value) noexcept {
+  if (data.size() - pos < 4) {
+    return false;
+  }
+  value = 0;
+  for (int i = 0; i < 4; ++i) {
+    value |= static_cast<uint32_t>(data[pos++]) << (8 * i);
+  }
+  return true;
+}
+
+/// Skips a field of an unknown number; returns false if it is malformed.
+[[nodiscard]] constexpr bool SkipField(std::span<const uint8_t> data, size_t& pos, uint8_t wire_type) noexcept {
+  uint64_t value = 0;
+  switch (wire_type) {
+    case kWireVarint:
+      return GetVarint(data, pos, value);
+    case kWireFixed64:
+      if (data.size() - pos < 8) {
+        return false;
+      }
+      pos += 8;
+      return true;
+    case kWireLengthDelimited:
+      if (!GetVarint(data, pos, value) || value > data.size() - pos) {
+        return false;
+      }
+      pos += value;
+      return true;
+    case kWireFixed32:
+      if (data.size() - pos < 4) {
+        return false;
+      }
+      pos += 4;
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Reads the length prefix of a sub-message and returns its bytes.
+[[nodiscard]] constexpr bool GetSubMessage(std::span<const uint8_t> data, size_t& pos,
+                                           std::span<const uint8_t>& message) noexcept {
+  uint64_t length = 0;
+  if (!GetVarint(data, pos, length) || length > data.size() - pos) {
+    return false;
+  }
+  message = data.subspan(pos, length);
+  pos += length;
+  return true;
+}
+
+/// Reads the body of an app.ServoPosition, updating the fields it contains; returns false if it is malformed.
+[[nodiscard]] constexpr bool GetPosition(std::span<const uint8_t> position, float& pan, float& tilt) noexcept {
+  for (size_t pos = 0; pos < position.size();) {
+    uint64_t key = 0;
+    if (!GetVarint(position, pos, key)) {
+      return false;
+    }
+    const auto field = static_cast<uint32_t>(key >> 3);
+    const auto wire_type = static_cast<uint8_t>(key & 0x07);
+    uint32_t bits = 0;
+    if (wire_type == kWireFixed32 && (field == kPositionPanField || field == kPositionTiltField)) {
+      if (!GetFixed32(position, pos, bits)) {
+        return false;
+      }
+      (field == kPositionPanField ? pan : tilt) = std::bit_cast<float>(bits);
+    } else if (!SkipField(position, pos, wire_type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Encodes a servo command as an app.Command MOVE message.
+ * @details Emits exactly the bytes protobuf's generated code produces for
+ * Protocol::SerializeServoCommand(): fields in number order, proto3 defaults omitted (floats
+ * by bit pattern, so -0.0 is kept), the move and target_position sub-messages always present, and
+ * target_velocity present if either velocity is non-zero.
+ * @param cmd The command to encode
+ * @param out Output buffer
+ * @return Number of bytes written, or ProtocolError::kBufferTooSmall
+ */
+[[nodiscard]] constexpr auto EncodeMoveCommand(const ServoCommand& cmd, std::span<uint8_t> out) noexcept
+    -> std::expected<size_t, ProtocolError> {
+  const auto pan_bits = std::bit_cast<uint32_t>(cmd.pan_angle);
+  const auto tilt_bits = std::bit_cast<uint32_t>(cmd.tilt_angle);
+  const auto pan_velocity_bits = std::bit_cast<uint32_t>(cmd.pan_velocity);
+  const auto tilt_velocity_bits = std::bit_cast<uint32_t>(cmd.tilt_velocity);
+  const bool has_velocity = cmd.pan_velocity != 0.0F || cmd.tilt_velocity != 0.0F;
+
+  // use_face_tracking = false is omitted
+  const size_t move_size = 2 + detail::PositionSize(pan_bits, tilt_bits) +
+                           (has_velocity ? 2 + detail::PositionSize(pan_velocity_bits, tilt_velocity_bits) : 0) +
+                           (cmd.valid_for_ms != 0 ? 1 + detail::VarintSize(cmd.valid_for_ms) : 0);
+  const size_t size = (cmd.command_id != 0 ? 1 + detail::VarintSize(cmd.command_id) : 0) +
+                      (cmd.timestamp_ms != 0 ? 1 + detail::VarintSize(cmd.timestamp_ms) : 0) + 4 + move_size;
+  if (out.size() < size) {
+    return std::unexpected(ProtocolError::kBufferTooSmall);
+  }
+
+  size_t pos = 0;
+  if (cmd.command_id != 0) {
+    out[pos++] = detail::Tag(detail::kCommandIdField, detail::kWireVarint);
+    pos = detail::PutVarint(cmd.command_id, out, pos);
+  }
+  if (cmd.timestamp_ms != 0) {
+    out[pos++] = detail::Tag(detail::kCommandTimestampField, detail::kWireVarint);
+    pos = detail::PutVarint(cmd.timestamp_ms, out, pos);
+  }
+  out[pos++] = detail::Tag(detail::kCommandTypeField, detail::kWireVarint);
+  out[pos++] = static_cast<uint8_t>(detail::kCommandTypeMove);
+  out[pos++] = detail::Tag(detail::kCommandMoveField, detail::kWireLengthDelimited);
+  out[pos++] = static_cast<uint8_t>(move_size);  // At most 30, so one varint byte
+  pos = detail::PutPosition(detail::kMoveTargetField, pan_bits, tilt_bits, out, pos);
+  if (has_velocity) {
+    pos = detail::PutPosition(detail::kMoveVelocityField, pan_velocity_bits, tilt_velocity_bits, out, pos);
+  }
+  if (cmd.valid_for_ms != 0) {
+    out[pos++] = detail::Tag(detail::kMoveValidForField, detail::kWireVarint);
+    pos = detail::PutVarint(cmd.valid_for_ms, out, pos);
+  }
+
+  return pos;
+}
+
+/**
+ * @brief Encodes a servo command as an app.Command MOVE message into a fixed buffer.
+ * @param cmd The command to encode
+ * @return Encoded bytes
+ */
+[[nodiscard]] constexpr MoveCommandBytes EncodeMoveCommand(const ServoCommand& cmd) noexcept {
+  MoveCommandBytes bytes;
+  bytes.size = EncodeMoveCommand(cmd, bytes.data).value_or(0);  // Cannot fail: the buffer holds the maximum size
+  return bytes;
+}
+
+/**
+ * @brief Decodes an app.Command MOVE message.
+ * @details Accepts any valid protobuf encoding of the message (fields in any order, unknown
+ * fields skipped), matching Protocol::DeserializeServoCommand().
+ * @param data Serialized message
+ * @return Decoded command, ProtocolError::kDeserializationFailed if the bytes are malformed,
+ * or ProtocolError::kInvalidMessage if the message is not a MOVE command
+ */
+[[nodiscard]] constexpr auto DecodeMoveCommand(std::span<const uint8_t> data) noexcept
+    -> std::expected<ServoCommand, ProtocolError> {
+  ServoCommand cmd;
+  uint64_t type = 0;
+  bool has_move = false;
+
+  size_t pos = 0;
+  while (pos < data.size()) {
+    uint64_t key = 0;
+    if (!detail::GetVarint(data, pos, key)) {
+      return std::unexpected(ProtocolError::kDeserializationFailed);
+    }
+    const auto field = static_cast<uint32_t>(key >> 3);
+    const auto wire_type = static_cast<uint8_t>(key & 0x07);
+    if (field == 0) {
+      return std::unexpected(ProtocolError::kDeserializationFailed);
+    }
+
+    uint64_t value = 0;
+    if (field == detail::kCommandIdField && wire_type == detail::kWireVarint) {
+      if (!detail::GetVarint(data, pos, value)) {
+        return std::unexpected(ProtocolError::kDeserializationFailed);
+      }
+      cmd.command_id = static_cast<uint32_t>(value);
+    } else if (field == detail::kCommandTimestampField && wire_type == detail::kWireVarint) {
+      if (!detail::GetVarint(data, pos, value)) {
+        return std::unexpected(ProtocolError::kDeserializationFailed);
+      }
+      cmd.timestamp_ms = value;
+    } else if (field == detail::kCommandTypeField && wire_type == detail::kWireVarint) {
+      if (!detail::GetVarint(data, pos, type)) {
+        return std::unexpected(ProtocolError::kDeserializationFailed);
+      }
+    } else if (field == detail::kCommandMoveField && wire_type == detail::kWireLengthDelimited) {
+      std::span<const uint8_t> move;
+      if (!detail::GetSubMessage(data, pos, move)) {
+        return std::unexpected(ProtocolError::kDeserializationFailed);
+      }
+      has_move = true;
+
+      for (size_t move_pos = 0; move_pos < move.size();) {
+        uint64_t move_key = 0;
+        if (!detail::GetVarint(move, move_pos, move_key)) {
+          return std::unexpected(ProtocolError::kDeserializationFailed);
+        }
+        const auto move_field = static_cast<uint32_t>(move_key >> 3);
+        const auto move_wire_type = static_cast<uint8_t>(move_key & 0x07);
+        std::span<const uint8_t> position;
+        if ((move_field == detail::kMoveTargetField || move_field == detail::kMoveVelocityField) &&
+            move_wire_type == detail::kWireLengthDelimited) {
+          const bool target = move_field == detail::kMoveTargetField;
+          if (!detail::GetSubMessage(move, move_pos, position) ||
+              !detail::GetPosition(position, target ? cmd.pan_angle : cmd.pan_velocity,
+                                   target ? cmd.tilt_angle : cmd.tilt_velocity)) {
+            return std::unexpected(ProtocolError::kDeserializationFailed);
+          }
+        } else if (move_field == detail::kMoveValidForField && move_wire_type == detail::kWireVarint) {
+          if (!detail::GetVarint(move, move_pos, value)) {
+            return std::unexpected(ProtocolError::kDeserializationFailed);
+          }
+          cmd.valid_for_ms = static_cast<uint32_t>(value);
+        } else if (!detail::SkipField(move, move_pos, move_wire_type)) {
+          return std::unexpected(ProtocolError::kDeserializationFailed);
+        }
+      }
+    } else {
+      if (field == detail::kCommandCalibrateField || field == detail::kCommandSetConfigField) {
+        has_move = false;  // Another member of the payload oneof replaces the move
+      }
+      if (!detail::SkipField(data, pos, wire_type)) {
+        return std::unexpected(ProtocolError::kDeserializationFailed);
+      }
+    }
+  }
+
+  if (type != detail::kCommandTypeMove || !has_move) {
+    return std::unexpected(ProtocolError::kInvalidMessage);
+  }
+
+  cmd.speed = 1.0F;
+  cmd.smooth = true;
+  return cmd;
+}
+
+}  // namespace client::comm
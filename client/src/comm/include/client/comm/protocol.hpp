@@ -5,10 +5,12 @@
 #include <client/comm/export.hpp>
 #include <client/core/utils/fast_pimpl.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <expected>
 #include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -65,13 +67,20 @@ enum class MessageType : uint8_t {
 
 /**
  * @brief Servo command data.
- * @details Contains pan and tilt angles for servo control.
+ * @details Contains pan and tilt angles for servo control. With a velocity and a validity horizon
+ * the device extrapolates the target along the velocity until the next command, so targets can be
+ * sent at a fraction of the frame rate.
  */
 struct CLIENT_COMM_API ServoCommand {
-  float pan_angle = 0.0F;   ///< Pan angle in degrees (-90 to 90).
-  float tilt_angle = 0.0F;  ///< Tilt angle in degrees (-45 to 45).
-  float speed = 1.0F;       ///< Movement speed multiplier (0.0 to 1.0).
-  bool smooth = true;       ///< Use smooth interpolated movement.
+  float pan_angle = 0.0F;      ///< Pan angle in degrees (-90 to 90).
+  float tilt_angle = 0.0F;     ///< Tilt angle in degrees (-45 to 45).
+  float speed = 1.0F;          ///< Movement speed multiplier (0.0 to 1.0).
+  bool smooth = true;          ///< Use smooth interpolated movement.
+  uint32_t command_id = 0;     ///< Command ID echoed back in the device response (0 = untracked).
+  uint64_t timestamp_ms = 0;   ///< Origin time of the command in milliseconds since connection.
+  float pan_velocity = 0.0F;   ///< Pan velocity of the target in degrees per second.
+  float tilt_velocity = 0.0F;  ///< Tilt velocity of the target in degrees per second.
+  uint32_t valid_for_ms = 0;   ///< How long the device may extrapolate the velocity (0 = position only).
 
   [[nodiscard]] bool operator==(const ServoCommand&) const noexcept = default;
 };
@@ -101,16 +110,39 @@ struct CLIENT_COMM_API FaceDataMessage {
   [[nodiscard]] bool operator==(const FaceDataMessage&) const noexcept = default;
 };
 
+/**
+ * @brief Timing of the device's servo update loop since boot.
+ */
+struct CLIENT_COMM_API ServoLoopStats {
+  uint32_t rate_hz = 0;        ///< Nominal update rate (0 = not reported).
+  uint32_t updates = 0;        ///< Updates run.
+  uint32_t jitter_us = 0;      ///< Smoothed deviation of the update period from nominal.
+  uint32_t max_jitter_us = 0;  ///< Largest deviation of an update period from nominal.
+  uint32_t overruns = 0;       ///< Updates that missed a timer tick.
+  uint32_t max_busy_us = 0;    ///< Longest time an update took.
+
+  [[nodiscard]] bool operator==(const ServoLoopStats&) const noexcept = default;
+};
+
 /**
  * @brief Status message from the device.
  */
 struct CLIENT_COMM_API StatusMessage {
-  float pan_position = 0.0F;   ///< Current pan position in degrees.
-  float tilt_position = 0.0F;  ///< Current tilt position in degrees.
-  float battery_level = 1.0F;  ///< Battery level (0.0 to 1.0).
-  bool is_calibrated = false;  ///< Whether the device is calibrated.
-  bool is_tracking = false;    ///< Whether tracking is active.
-  uint32_t error_code = 0;     ///< Error code (0 = no error).
+  float pan_position = 0.0F;       ///< Current pan position in degrees.
+  float tilt_position = 0.0F;      ///< Current tilt position in degrees.
+  float target_pan = 0.0F;         ///< Target pan position in degrees.
+  float target_tilt = 0.0F;        ///< Target tilt position in degrees.
+  float battery_level = 1.0F;      ///< Battery level (0.0 to 1.0).
+  bool is_calibrated = false;      ///< Whether the device is calibrated.
+  bool is_tracking = false;        ///< Whether tracking is active.
+  bool is_moving = false;          ///< Whether the servos are moving toward the target.
+  bool has_device_status = false;  ///< Whether the response carried device status (fields above are valid).
+  uint32_t error_code = 0;         ///< Error code (0 = no error).
+  uint32_t command_id = 0;         ///< ID of the command this status responds to (0 = unsolicited).
+  uint32_t free_heap = 0;          ///< Free device heap in bytes.
+  uint64_t uptime_ms = 0;          ///< Device uptime in milliseconds.
+  uint64_t timestamp_ms = 0;       ///< Device timestamp in milliseconds since boot.
+  ServoLoopStats servo_loop{};     ///< Timing of the servo update loop.
 
   [[nodiscard]] bool operator==(const StatusMessage&) const noexcept = default;
 };
@@ -125,6 +157,40 @@ struct CLIENT_COMM_API HeartbeatMessage {
   [[nodiscard]] bool operator==(const HeartbeatMessage&) const noexcept = default;
 };
 
+/**
+ * @brief Connection handshake sent by the client.
+ */
+struct CLIENT_COMM_API HandshakeMessage {
+  uint32_t protocol_version = 1;      ///< Highest protocol version the client speaks.
+  std::string client_id;              ///< Client identification string.
+  std::vector<std::string> features;  ///< Optional features the client requests.
+
+  [[nodiscard]] bool operator==(const HandshakeMessage&) const noexcept = default;
+};
+
+/**
+ * @brief Handshake reply from the device.
+ */
+struct CLIENT_COMM_API HandshakeResponseMessage {
+  uint32_t protocol_version = 1;                ///< Protocol version the device agreed to.
+  std::string device_id;                        ///< Device identification.
+  std::string firmware_version;                 ///< Firmware version string.
+  std::vector<std::string> supported_features;  ///< Requested features the device enabled.
+  bool accepted = false;                        ///< Whether the device accepted the connection.
+  std::string rejection_reason;                 ///< Reason for rejection, if not accepted.
+
+  /**
+   * @brief Checks whether the device enabled a feature.
+   * @param feature Feature name
+   * @return True if @p feature is listed in supported_features
+   */
+  [[nodiscard]] bool Supports(std::string_view feature) const noexcept {
+    return std::ranges::find(supported_features, feature) != supported_features.end();
+  }
+
+  [[nodiscard]] bool operator==(const HandshakeResponseMessage&) const noexcept = default;
+};
+
 /**
  * @brief Protocol handler for serializing and deserializing messages.
  * @details This class wraps protobuf serialization/deserialization to isolate
@@ -148,6 +214,15 @@ public:
   [[nodiscard]] static auto SerializeServoCommand(const ServoCommand& cmd)
       -> std::expected<std::vector<uint8_t>, ProtocolError>;
 
+  /**
+   * @brief Serializes a ServoCommand into a caller-provided buffer without heap allocation.
+   * @param cmd The command to serialize
+   * @param out Output buffer
+   * @return Number of bytes written, or ProtocolError::kBufferTooSmall if @p out cannot hold the message
+   */
+  [[nodiscard]] static auto SerializeServoCommand(const ServoCommand& cmd, std::span<uint8_t> out)
+      -> std::expected<size_t, ProtocolError>;
+
   /**
    * @brief Deserializes a ServoCommand from bytes.
    * @param data The serialized data
@@ -180,10 +255,20 @@ public:
   [[nodiscard]] static auto SerializeStatus(const StatusMessage& msg)
       -> std::expected<std::vector<uint8_t>, ProtocolError>;
 
+  /**
+   * @brief Serializes a StatusMessage into a caller-provided buffer without heap allocation.
+   * @param msg The message to serialize
+   * @param out Output buffer
+   * @return Number of bytes written, or ProtocolError::kBufferTooSmall if @p out cannot hold the message
+   */
+  [[nodiscard]] static auto SerializeStatus(const StatusMessage& msg, std::span<uint8_t> out)
+      -> std::expected<size_t, ProtocolError>;
+
   /**
    * @brief Deserializes a StatusMessage from bytes.
    * @param data The serialized data
    * @return Deserialized message or error
+   * @note Parses into a stack-backed arena, so decoding does not allocate.
    */
   [[nodiscard]] static auto DeserializeStatus(std::span<const uint8_t> data)
       -> std::expected<StatusMessage, ProtocolError>;
@@ -196,6 +281,15 @@ public:
   [[nodiscard]] static auto SerializeHeartbeat(const HeartbeatMessage& msg)
       -> std::expected<std::vector<uint8_t>, ProtocolError>;
 
+  /**
+   * @brief Serializes a HeartbeatMessage into a caller-provided buffer without heap allocation.
+   * @param msg The message to serialize
+   * @param out Output buffer
+   * @return Number of bytes written, or ProtocolError::kBufferTooSmall if @p out cannot hold the message
+   */
+  [[nodiscard]] static auto SerializeHeartbeat(const HeartbeatMessage& msg, std::span<uint8_t> out)
+      -> std::expected<size_t, ProtocolError>;
+
   /**
    * @brief Deserializes a HeartbeatMessage from bytes.
    * @param data The serialized data
@@ -206,15 +300,86 @@ public:
 
   /**
    * @brief Serializes a calibrate command to bytes.
+   * @param command_id Command ID echoed in the response (0 if no response is awaited)
    * @return Serialized bytes or error
    */
-  [[nodiscard]] static auto SerializeCalibrate() -> std::expected<std::vector<uint8_t>, ProtocolError>;
+  [[nodiscard]] static auto SerializeCalibrate(uint32_t command_id = 0)
+      -> std::expected<std::vector<uint8_t>, ProtocolError>;
+
+  /**
+   * @brief Serializes a calibrate command into a caller-provided buffer without heap allocation.
+   * @param out Output buffer
+   * @param command_id Command ID echoed in the response (0 if no response is awaited)
+   * @return Number of bytes written, or ProtocolError::kBufferTooSmall if @p out cannot hold the message
+   */
+  [[nodiscard]] static auto SerializeCalibrate(std::span<uint8_t> out, uint32_t command_id = 0)
+      -> std::expected<size_t, ProtocolError>;
 
   /**
    * @brief Serializes a home command to bytes.
+   * @param command_id Command ID echoed in the response (0 if no response is awaited)
    * @return Serialized bytes or error
    */
-  [[nodiscard]] static auto SerializeHome() -> std::expected<std::vector<uint8_t>, ProtocolError>;
+  [[nodiscard]] static auto SerializeHome(uint32_t command_id = 0)
+      -> std::expected<std::vector<uint8_t>, ProtocolError>;
+
+  /**
+   * @brief Serializes a home command into a caller-provided buffer without heap allocation.
+   * @param out Output buffer
+   * @param command_id Command ID echoed in the response (0 if no response is awaited)
+   * @return Number of bytes written, or ProtocolError::kBufferTooSmall if @p out cannot hold the message
+   */
+  [[nodiscard]] static auto SerializeHome(std::span<uint8_t> out, uint32_t command_id = 0)
+      -> std::expected<size_t, ProtocolError>;
+
+  /**
+   * @brief Serializes a get-status command to bytes.
+   * @param command_id Command ID echoed in the response (0 if no response is awaited)
+   * @return Serialized bytes or error
+   */
+  [[nodiscard]] static auto SerializeGetStatus(uint32_t command_id = 0)
+      -> std::expected<std::vector<uint8_t>, ProtocolError>;
+
+  /**
+   * @brief Serializes a get-status command into a caller-provided buffer without heap allocation.
+   * @param out Output buffer
+   * @param command_id Command ID echoed in the response (0 if no response is awaited)
+   * @return Number of bytes written, or ProtocolError::kBufferTooSmall if @p out cannot hold the message
+   */
+  [[nodiscard]] static auto SerializeGetStatus(std::span<uint8_t> out, uint32_t command_id = 0)
+      -> std::expected<size_t, ProtocolError>;
+
+  /**
+   * @brief Serializes a HandshakeMessage to bytes.
+   * @param msg The message to serialize
+   * @return Serialized bytes or error
+   */
+  [[nodiscard]] static auto SerializeHandshake(const HandshakeMessage& msg)
+      -> std::expected<std::vector<uint8_t>, ProtocolError>;
+
+  /**
+   * @brief Deserializes a HandshakeMessage from bytes.
+   * @param data The serialized data
+   * @return Deserialized message or error
+   */
+  [[nodiscard]] static auto DeserializeHandshake(std::span<const uint8_t> data)
+      -> std::expected<HandshakeMessage, ProtocolError>;
+
+  /**
+   * @brief Serializes a HandshakeResponseMessage to bytes.
+   * @param msg The message to serialize
+   * @return Serialized bytes or error
+   */
+  [[nodiscard]] static auto SerializeHandshakeResponse(const HandshakeResponseMessage& msg)
+      -> std::expected<std::vector<uint8_t>, ProtocolError>;
+
+  /**
+   * @brief Deserializes a HandshakeResponseMessage from bytes.
+   * @param data The serialized data
+   * @return Deserialized message or error
+   */
+  [[nodiscard]] static auto DeserializeHandshakeResponse(std::span<const uint8_t> data)
+      -> std::expected<HandshakeResponseMessage, ProtocolError>;
 
   /**
    * @brief Detects the message type from serialized data.
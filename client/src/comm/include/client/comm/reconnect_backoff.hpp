@@ -0,0 +1,62 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/export.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace client::comm {
+
+/**
+ * @brief Delays between attempts to reconnect a lost link.
+ * @details The delay doubles from kInitialDelay up to kMaxDelay with every failed attempt. Each
+ * delay is drawn uniformly from its upper half ("equal jitter"), so clients that lost the same
+ * device at once do not retry in lockstep, yet never retry sooner than half the nominal delay.
+ * @note Not thread-safe; use from the thread that owns the transport.
+ */
+class CLIENT_COMM_API ReconnectBackoff {
+public:
+  /// Nominal delay before the first attempt.
+  static constexpr std::chrono::milliseconds kInitialDelay{500};
+
+  /// Upper bound for the nominal delay.
+  static constexpr std::chrono::milliseconds kMaxDelay{30000};
+
+  /**
+   * @brief Constructs a backoff.
+   * @param seed Seed of the jitter generator (fixed in tests, random otherwise)
+   */
+  explicit ReconnectBackoff(uint32_t seed = std::random_device{}()) noexcept : generator_(seed) {}
+
+  /**
+   * @brief Gets the delay before the next attempt and backs off for the one after.
+   * @return Delay in [nominal / 2, nominal]
+   */
+  [[nodiscard]] std::chrono::milliseconds NextDelay() noexcept;
+
+  /**
+   * @brief Starts over from kInitialDelay (e.g. once the link is up again).
+   */
+  void Reset() noexcept { attempts_ = 0; }
+
+  /**
+   * @brief Gets the number of delays handed out since the last Reset().
+   * @return Attempt count
+   */
+  [[nodiscard]] uint32_t Attempts() const noexcept { return attempts_; }
+
+  /**
+   * @brief Gets the nominal (unjittered) delay of the next attempt.
+   * @return Nominal delay
+   */
+  [[nodiscard]] std::chrono::milliseconds NominalDelay() const noexcept;
+
+private:
+  std::minstd_rand generator_;
+  uint32_t attempts_ = 0;
+};
+
+}  // namespace client::comm
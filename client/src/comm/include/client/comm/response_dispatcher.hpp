@@ -0,0 +1,98 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/device_shadow.hpp>
+#include <client/comm/export.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+
+namespace client::comm {
+
+/**
+ * @brief Routes device responses to the handlers waiting for them.
+ * @details Each response payload is parsed once, directly from the receive buffer.
+ * Device status is mirrored into a DeviceShadow. The response then goes to the one-shot
+ * handler registered for its command ID, or to the default handler if none is waiting.
+ */
+class CLIENT_COMM_API ResponseDispatcher {
+public:
+  /**
+   * @brief Callback type for a decoded response.
+   */
+#if __cpp_lib_move_only_function >= 202110L
+  using ResponseHandler = std::move_only_function<void(const StatusMessage& response)>;
+#else
+  using ResponseHandler = std::function<void(const StatusMessage& response)>;
+#endif
+
+  /**
+   * @brief Constructs a dispatcher.
+   * @param shadow Device shadow to update (must outlive the dispatcher)
+   */
+  explicit ResponseDispatcher(DeviceShadow& shadow) noexcept : shadow_(shadow) {}
+  ResponseDispatcher(const ResponseDispatcher&) = delete;
+  ResponseDispatcher(ResponseDispatcher&&) = delete;
+  ~ResponseDispatcher() = default;
+
+  ResponseDispatcher& operator=(const ResponseDispatcher&) = delete;
+  ResponseDispatcher& operator=(ResponseDispatcher&&) = delete;
+
+  /**
+   * @brief Registers a one-shot handler for the response to a command.
+   * @param command_id Command ID (non-zero)
+   * @param handler Handler invoked when the matching response arrives
+   * @note Replaces any handler already registered for @p command_id.
+   */
+  void Expect(uint32_t command_id, ResponseHandler handler);
+
+  /**
+   * @brief Removes the handler registered for a command.
+   * @param command_id Command ID
+   * @return True if a handler was removed
+   */
+  bool Cancel(uint32_t command_id);
+
+  /**
+   * @brief Removes all pending handlers (e.g. on disconnect).
+   */
+  void Clear();
+
+  /**
+   * @brief Sets the handler for responses nobody is waiting for (including unsolicited status).
+   * @param handler Default handler
+   */
+  void SetDefaultHandler(ResponseHandler handler) noexcept { default_handler_ = std::move(handler); }
+
+  /**
+   * @brief Parses and dispatches one response payload.
+   * @param payload Response payload (one de-framed app.Response)
+   * @param received_at Local receive time
+   * @return Expected void on success, or ProtocolError if the payload could not be parsed
+   */
+  [[nodiscard]] auto Dispatch(std::span<const uint8_t> payload,
+                              std::chrono::steady_clock::time_point received_at = std::chrono::steady_clock::now())
+      -> std::expected<void, ProtocolError>;
+
+  /**
+   * @brief Gets the number of handlers waiting for a response.
+   * @return Pending handler count
+   */
+  [[nodiscard]] size_t Pending() const;
+
+private:
+  DeviceShadow& shadow_;
+  mutable std::mutex mutex_;
+  std::unordered_map<uint32_t, ResponseHandler> pending_;
+  ResponseHandler default_handler_;
+};
+
+}  // namespace client::comm
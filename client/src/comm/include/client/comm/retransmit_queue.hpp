@@ -0,0 +1,129 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/export.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace client::comm {
+
+/**
+ * @brief Retransmission of commands that must not be lost (CALIBRATE, SET_CONFIG).
+ * @details Keeps the encoded frame of each tracked command until its response arrives. A frame
+ * whose response is overdue is written again with the same command ID, and its timeout doubles
+ * (RFC 6298 backoff). The device answers a repeated ID without executing it again, so retransmitting
+ * is safe for commands that are not idempotent. MOVEs are never tracked: a lost MOVE is superseded
+ * by the next one anyway.
+ * @note Not thread-safe; use from the thread that owns the transport.
+ */
+class CLIENT_COMM_API RetransmitQueue {
+public:
+  /// Commands that may await a response at once.
+  static constexpr size_t kMaxPending = 4;
+
+  /// Default number of transmissions (including the first) before a command is given up.
+  static constexpr uint32_t kDefaultMaxAttempts = 5;
+
+  /// Upper bound for the backed-off timeout.
+  static constexpr std::chrono::milliseconds kMaxTimeout{8000};
+
+  /**
+   * @brief Constructs a queue.
+   * @param max_attempts Transmissions (including the first) before a command is given up
+   */
+  explicit RetransmitQueue(uint32_t max_attempts = kDefaultMaxAttempts) noexcept : max_attempts_(max_attempts) {}
+
+  /**
+   * @brief Starts tracking a command that was just sent.
+   * @param command_id Command ID (non-zero)
+   * @param frame Encoded frame, written again on retransmission
+   * @param sent_at Time the frame was queued
+   * @param timeout Time to wait for the response before the first retransmission
+   * @return False if @p command_id is 0 or kMaxPending commands are already tracked
+   */
+  bool Track(uint32_t command_id, std::span<const uint8_t> frame, std::chrono::steady_clock::time_point sent_at,
+             std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Stops tracking a command whose response arrived.
+   * @param command_id Command ID from the response
+   * @return True if @p command_id was tracked
+   */
+  bool Acknowledge(uint32_t command_id);
+
+  /**
+   * @brief Retransmits overdue commands and gives up on those out of attempts.
+   * @tparam ResendFn Callable as `void(std::span<const uint8_t> frame)`
+   * @tparam GiveUpFn Callable as `void(uint32_t command_id)`
+   * @param now Current time
+   * @param resend Writes one frame to the transport
+   * @param give_up Called with the ID of each command dropped after its last transmission went unanswered
+   * @return Number of frames retransmitted
+   */
+  template <typename ResendFn, typename GiveUpFn>
+  size_t Poll(std::chrono::steady_clock::time_point now, ResendFn&& resend, GiveUpFn&& give_up);
+
+  /**
+   * @brief Forgets all tracked commands (e.g. on disconnect).
+   */
+  void Clear() noexcept;
+
+  /**
+   * @brief Gets the number of commands awaiting a response.
+   * @return Tracked command count
+   */
+  [[nodiscard]] size_t Pending() const noexcept;
+
+  /**
+   * @brief Gets the number of retransmissions since construction.
+   * @return Retransmitted frame count
+   */
+  [[nodiscard]] uint64_t Retransmissions() const noexcept { return retransmissions_; }
+
+private:
+  struct Entry {
+    uint32_t command_id = 0;
+    uint32_t attempts = 0;
+    std::chrono::steady_clock::time_point deadline;
+    std::chrono::milliseconds timeout{0};
+    std::vector<uint8_t> frame;
+  };
+
+  uint32_t max_attempts_;
+  std::array<Entry, kMaxPending> entries_{};
+  uint64_t retransmissions_ = 0;
+};
+
+template <typename ResendFn, typename GiveUpFn>
+size_t RetransmitQueue::Poll(std::chrono::steady_clock::time_point now, ResendFn&& resend, GiveUpFn&& give_up) {
+  size_t resent = 0;
+  for (auto& entry : entries_) {
+    if (entry.command_id == 0 || now < entry.deadline) {
+      continue;
+    }
+
+    if (entry.attempts >= max_attempts_) {
+      const uint32_t command_id = entry.command_id;
+      entry = Entry{};
+      give_up(command_id);
+      continue;
+    }
+
+    resend(std::span<const uint8_t>(entry.frame));
+    ++entry.attempts;
+    entry.timeout = std::min(entry.timeout * 2, kMaxTimeout);
+    entry.deadline = now + entry.timeout;
+    ++retransmissions_;
+    ++resent;
+  }
+  return resent;
+}
+
+}  // namespace client::comm
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <client/comm/pch.hpp>
+
+#include <client/comm/datagram_channel.hpp>
+#include <client/comm/export.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace client::comm {
+
+/**
+ * @brief Error codes for transport operations.
+ */
+enum class TransportError : uint8_t {
+  kOk = 0,          ///< Operation succeeded.
+  kNotSupported,    ///< Backend not available in this build.
+  kInvalidAddress,  ///< Address could not be parsed for this backend.
+  kOpenFailed,      ///< Failed to open the link.
+  kAlreadyOpen,     ///< Link is already open or opening.
+  kNotOpen,         ///< Link is not open.
+  kWriteFailed,     ///< Failed to write data.
+  kConnectionLost,  ///< Link was closed by the peer or failed while open.
+  kInternalError    ///< Internal error.
+};
+
+/**
+ * @brief Converts TransportError to a human-readable string.
+ * @param error The error to convert
+ * @return A string view representing the error
+ */
+[[nodiscard]] constexpr std::string_view TransportErrorToString(TransportError error) noexcept {
+  switch (error) {
+    case TransportError::kOk:
+      return "OK";
+    case TransportError::kNotSupported:
+      return "Transport not supported";
+    case TransportError::kInvalidAddress:
+      return "Invalid address";
+    case TransportError::kOpenFailed:
+      return "Failed to open link";
+    case TransportError::kAlreadyOpen:
+      return "Link already open";
+    case TransportError::kNotOpen:
+      return "Link not open";
+    case TransportError::kWriteFailed:
+      return "Failed to write data";
+    case TransportError::kConnectionLost:
+      return "Connection lost";
+    case TransportError::kInternalError:
+      return "Internal error";
+    default:
+      return "Unknown error";
+  }
+}
+
+/**
+ * @brief Transport backends.
+ */
+enum class TransportKind : uint8_t {
+  kBluetooth = 0,  ///< Bluetooth Classic SPP (RFCOMM).
+  kTcp,            ///< TCP stream.
+  kUdp,            ///< UDP datagrams, one frame per datagram.
+  kSerial,         ///< USB-serial adapter or pty.
+  kLoopback        ///< In-process pair (see LoopbackTransport).
+};
+
+/**
+ * @brief Converts TransportKind to its address scheme.
+ * @param kind The kind to convert
+ * @return Scheme used in transport URIs (e.g. "tcp")
+ */
+[[nodiscard]] constexpr std::string_view TransportKindToString(TransportKind kind) noexcept {
+  switch (kind) {
+    case TransportKind::kBluetooth:
+      return "bt";
+    case TransportKind::kTcp:
+      return "tcp";
+    case TransportKind::kUdp:
+      return "udp";
+    case TransportKind::kSerial:
+      return "serial";
+    case TransportKind::kLoopback:
+      return "loopback";
+    default:
+      return "unknown";
+  }
+}
+
+/**
+ * @brief Transport link state.
+ */
+enum class TransportState : uint8_t {
+  kClosed = 0,  ///< Not open.
+  kOpening,     ///< Open() was called and the link is being established.
+  kOpen         ///< Link is up and accepts writes.
+};
+
+/**
+ * @brief Backend and address parsed from a transport URI.
+ */
+struct CLIENT_COMM_API TransportEndpoint {
+  TransportKind kind = TransportKind::kBluetooth;  ///< Backend to open.
+  std::string address;                             ///< Backend-specific address passed to ITransport::Open().
+
+  [[nodiscard]] bool operator==(const TransportEndpoint&) const noexcept = default;
+};
+
+/**
+ * @brief Parses a transport URI.
+ * @details Accepted forms:
+ * - `AA:BB:CC:DD:EE:FF` or `bt://AA:BB:CC:DD:EE:FF`: Bluetooth SPP
+ * - `AA:BB:CC:DD:EE:FF#3`: Bluetooth SPP on RFCOMM channel 3, skipping the SDP service lookup
+ * - `tcp://host:port`, `udp://host:port`: network link
+ * - `serial:///dev/ttyUSB0`, `serial://COM3@921600`: serial port, optionally with a baud rate
+ * @param uri Transport URI
+ * @return Parsed endpoint, or TransportError::kInvalidAddress
+ */
+[[nodiscard]] CLIENT_COMM_API auto ParseTransportEndpoint(std::string_view uri)
+    -> std::expected<TransportEndpoint, TransportError>;
+
+/**
+ * @brief Byte counters kept by every transport.
+ */
+struct CLIENT_COMM_API TransportStats {
+  uint64_t bytes_sent = 0;      ///< Bytes accepted by Write().
+  uint64_t bytes_received = 0;  ///< Bytes delivered to the receive callback.
+  uint64_t writes = 0;          ///< Successful Write() calls.
+  uint64_t write_errors = 0;    ///< Failed Write() calls.
+
+  [[nodiscard]] bool operator==(const TransportStats&) const noexcept = default;
+};
+
+/**
+ * @brief Byte link to the device.
+ * @details A transport only moves bytes: framing, outbound scheduling and the device protocol
+ * live in LinkSession, so every backend speaks the same protocol. Backends report received
+ * bytes, backlog drain and state changes through callbacks, and count traffic in Stats().
+ * A stream backend may deliver any chunking of the byte stream; a datagram backend writes each
+ * Write() as one datagram, which LinkSession uses to send one frame per datagram.
+ * @note Not thread-safe; callbacks run on the thread that owns the transport.
+ */
+class CLIENT_COMM_API ITransport {
+public:
+  /**
+   * @brief Callback type for received bytes.
+   */
+#if __cpp_lib_move_only_function >= 202110L
+  using ReceiveCallback = std::move_only_function<void(std::span<const uint8_t> data)>;
+#else
+  using ReceiveCallback = std::function<void(std::span<const uint8_t> data)>;
+#endif
+
+  /**
+   * @brief Callback type for a shrinking write backlog.
+   */
+#if __cpp_lib_move_only_function >= 202110L
+  using WritableCallback = std::move_only_function<void()>;
+#else
+  using WritableCallback = std::function<void()>;
+#endif
+
+  /**
+   * @brief Callback type for state changes.
+   */
+#if __cpp_lib_move_only_function >= 202110L
+  using StateCallback = std::move_only_function<void(TransportState state, TransportError error)>;
+#else
+  using StateCallback = std::function<void(TransportState state, TransportError error)>;
+#endif
+
+  ITransport(const ITransport&) = delete;
+  ITransport(ITransport&&) = delete;
+  virtual ~ITransport() = default;
+
+  ITransport& operator=(const ITransport&) = delete;
+  ITransport& operator=(ITransport&&) = delete;
+
+  /**
+   * @brief Gets the backend kind.
+   * @return Transport kind
+   */
+  [[nodiscard]] virtual TransportKind Kind() const noexcept = 0;
+
+  /**
+   * @brief Starts opening the link.
+   * @param address Backend-specific address (see TransportEndpoint::address)
+   * @return Expected void if opening started, or error on failure
+   * @note Completion is reported through the state callback, possibly before Open() returns.
+   */
+  [[nodiscard]] virtual auto Open(std::string_view address) -> std::expected<void, TransportError> = 0;
+
+  /**
+   * @brief Closes the link; the state callback reports TransportState::kClosed.
+   */
+  virtual void Close() = 0;
+
+  /**
+   * @brief Writes bytes to the link.
+   * @param data Data to write
+   * @return Expected number of bytes accepted, or error on failure
+   */
+  [[nodiscard]] virtual auto Write(std::span<const uint8_t> data) -> std::expected<size_t, TransportError> = 0;
+
+  /**
+   * @brief Gets the bytes accepted by Write() but not yet sent.
+   * @return Write backlog in bytes
+   */
+  [[nodiscard]] virtual size_t Backlog() const noexcept = 0;
+
+  /**
+   * @brief Gets the sequencing statistics of a datagram backend.
+   * @return Statistics of the DatagramChannel, or std::nullopt for byte-stream backends
+   */
+  [[nodiscard]] virtual std::optional<DatagramStats> DatagramStatistics() const { return std::nullopt; }
+
+  /**
+   * @brief Gets an address that reopens this link without the lookups Open() had to make.
+   * @return Address for Open() (a Bluetooth address with its RFCOMM channel), or empty if there is none
+   */
+  [[nodiscard]] virtual std::string ResolvedAddress() const { return {}; }
+
+  /**
+   * @brief Gets the current link state.
+   * @return Transport state
+   */
+  [[nodiscard]] TransportState State() const noexcept { return state_; }
+
+  /**
+   * @brief Gets the traffic counters.
+   * @return Snapshot of the counters
+   */
+  [[nodiscard]] TransportStats Stats() const noexcept { return stats_; }
+
+  /**
+   * @brief Gets the last error message.
+   * @return Last error message, or empty string if no error
+   */
+  [[nodiscard]] std::string_view LastError() const noexcept { return last_error_; }
+
+  /**
+   * @brief Sets the received data callback.
+   * @param callback Callback to invoke with each chunk of received bytes
+   */
+  void SetReceiveCallback(ReceiveCallback callback) noexcept { receive_callback_ = std::move(callback); }
+
+  /**
+   * @brief Sets the writable callback.
+   * @param callback Callback to invoke when the write backlog shrank
+   */
+  void SetWritableCallback(WritableCallback callback) noexcept { writable_callback_ = std::move(callback); }
+
+  /**
+   * @brief Sets the state change callback.
+   * @param callback Callback to invoke on state changes
+   */
+  void SetStateCallback(StateCallback callback) noexcept { state_callback_ = std::move(callback); }
+
+protected:
+  ITransport() = default;
+
+  /**
+   * @brief Changes the state and notifies the state callback if it changed.
+   * @param state New state
+   * @param error Reason for the change (TransportError::kOk for an orderly change)
+   * @param message Error message remembered for LastError(), if not empty
+   */
+  void SetState(TransportState state, TransportError error = TransportError::kOk, std::string_view message = "");
+
+  /**
+   * @brief Counts received bytes and passes them to the receive callback.
+   * @param data Received bytes
+   */
+  void Deliver(std::span<const uint8_t> data);
+
+  /**
+   * @brief Notifies the writable callback.
+   */
+  void NotifyWritable();
+
+  /**
+   * @brief Counts a write.
+   * @param bytes Bytes accepted
+   */
+  void RecordWrite(size_t bytes) noexcept;
+
+  /**
+   * @brief Counts a failed write.
+   * @param message Error message remembered for LastError()
+   */
+  void RecordWriteError(std::string_view message);
+
+private:
+  TransportState state_ = TransportState::kClosed;
+  TransportStats stats_;
+  std::string last_error_;
+
+  ReceiveCallback receive_callback_;
+  WritableCallback writable_callback_;
+  StateCallback state_callback_;
+};
+
+/**
+ * @brief Creates a transport backend.
+ * @param kind Backend to create
+ * @return New transport, or TransportError::kNotSupported if the backend is not available in this build
+ * @note Loopback transports come in pairs; create them with LoopbackTransport::CreatePair().
+ */
+[[nodiscard]] CLIENT_COMM_API auto CreateTransport(TransportKind kind)
+    -> std::expected<std::unique_ptr<ITransport>, TransportError>;
+
+}  // namespace client::comm
@@ -0,0 +1,38 @@
+#include <client/comm/ack_tracker.hpp>
+
+#include <cstdint>
+
+namespace client::comm {
+
+bool AckTracker::MarkAcked(uint32_t command_id) noexcept {
+  if (command_id == 0) {
+    return false;
+  }
+
+  if (command_id > newest_) {
+    const uint32_t shift = command_id - newest_;
+    seen_ = shift >= kHistory ? 0 : seen_ << shift;
+    seen_ |= 1;
+    newest_ = command_id;
+    return true;
+  }
+
+  const uint32_t distance = newest_ - command_id;
+  if (distance >= kHistory) {
+    return false;
+  }
+
+  const uint64_t bit = uint64_t{1} << distance;
+  if ((seen_ & bit) != 0) {
+    return false;
+  }
+  seen_ |= bit;
+  return true;
+}
+
+void AckTracker::Reset() noexcept {
+  newest_ = 0;
+  seen_ = 0;
+}
+
+}  // namespace client::comm
@@ -1,29 +1,39 @@
 #include <client/comm/bluetooth.hpp>
 
+#include <client/comm/link_command_queue.hpp>
+#include <client/comm/link_session.hpp>
+#include <client/comm/reconnect_backoff.hpp>
+#include <client/comm/transport.hpp>
 #include <client/core/logger.hpp>
+#include <client/core/tracing.hpp>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
-#include <bit>
 #include <chrono>
 #include <expected>
+#include <format>
+#include <memory>
 #include <optional>
 #include <shared_mutex>
 #include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <QMetaObject>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+
 #ifdef CLIENT_COMM_HAS_BLUETOOTH
 
 #include <QBluetoothDeviceDiscoveryAgent>
 #include <QBluetoothDeviceInfo>
 #include <QBluetoothLocalDevice>
-#include <QBluetoothServiceDiscoveryAgent>
-#include <QBluetoothSocket>
-#include <QBluetoothUuid>
 #include <QCoreApplication>
-#include <QObject>
-#include <QTimer>
 
 #ifdef CLIENT_PLATFORM_ANDROID
 #include <QBluetoothPermission>
@@ -34,28 +44,113 @@
 
 namespace client::comm {
 
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
-
 namespace {
 
-/// ESP32 SPP UUID for serial communication.
-constexpr const char* kSerialPortServiceUuid = "00001101-0000-1000-8000-00805F9B34FB";
+[[nodiscard]] constexpr BluetoothError ToBluetoothError(TransportError error) noexcept {
+  switch (error) {
+    case TransportError::kOk:
+      return BluetoothError::kOk;
+    case TransportError::kNotSupported:
+      return BluetoothError::kNotSupported;
+    case TransportError::kInvalidAddress:
+      return BluetoothError::kDeviceNotFound;
+    case TransportError::kOpenFailed:
+      return BluetoothError::kConnectionFailed;
+    case TransportError::kAlreadyOpen:
+      return BluetoothError::kAlreadyConnected;
+    case TransportError::kNotOpen:
+      return BluetoothError::kNotConnected;
+    case TransportError::kWriteFailed:
+      return BluetoothError::kSendFailed;
+    case TransportError::kConnectionLost:
+      return BluetoothError::kConnectionLost;
+    default:
+      return BluetoothError::kInternalError;
+  }
+}
+
+template <typename T>
+[[nodiscard]] auto ToBluetoothResult(const std::expected<T, TransportError>& result)
+    -> std::expected<T, BluetoothError> {
+  if (!result) {
+    return std::unexpected(ToBluetoothError(result.error()));
+  }
+  if constexpr (std::is_void_v<T>) {
+    return {};
+  } else {
+    return *result;
+  }
+}
 
 }  // namespace
 
 /**
- * @brief Qt-based Bluetooth implementation.
+ * @brief Qt-based device link: Bluetooth discovery plus a LinkSession over the connected transport.
+ * @details Discovery needs Qt Bluetooth; the link itself runs over any ITransport, so network
+ * and serial devices work in builds without Bluetooth support.
+ *
+ * The manager lives on the thread that creates it (the GUI thread), which runs discovery and
+ * receives every callback. The link (transport, LinkSession, retransmission and reconnection)
+ * lives on a dedicated comm thread with its own event loop, so socket I/O and servo commands
+ * are not held up by rendering or inference. Commands reach the comm thread through a
+ * lock-free LinkCommandQueue; connection changes and responses come back as queued calls.
  */
 class BluetoothManagerQt : public QObject {
-  Q_OBJECT
-
 public:
-  explicit BluetoothManagerQt(QObject* parent = nullptr) : QObject(parent) {}
+  explicit BluetoothManagerQt(QObject* parent = nullptr) : QObject(parent) {
+    command_queue_->SetWakeCallback([this] {
+      QMetaObject::invokeMethod(&link_context_, [this] { DrainCommands(); }, Qt::QueuedConnection);
+    });
+
+    retransmit_timer_.setInterval(LinkSession::kRetransmitPollInterval);
+    connect(&retransmit_timer_, &QTimer::timeout, &link_context_, [this] {
+      session_.PollRetransmits();
+      PublishSessionStats();
+    });
+    reconnect_timer_.setSingleShot(true);
+    connect(&reconnect_timer_, &QTimer::timeout, &link_context_, [this] { Reconnect(); });
+
+    // Responses are copied out of the receive buffer and handed to the owner thread
+    session_.SetDataReceivedCallback([this](std::span<const uint8_t> data) {
+      PostToOwner([this, payload = std::vector<uint8_t>(data.begin(), data.end())] {
+        if (data_received_callback_) {
+          data_received_callback_(payload);
+        }
+      });
+    });
+    session_.SetAckCallback([this](uint32_t command_id) {
+      PostToOwner([this, command_id] {
+        if (ack_callback_) {
+          ack_callback_(command_id);
+        }
+      });
+    });
+
+    comm_thread_.setObjectName(QStringLiteral("comm"));
+    link_context_.moveToThread(&comm_thread_);
+    retransmit_timer_.moveToThread(&comm_thread_);
+    reconnect_timer_.moveToThread(&comm_thread_);
+    comm_thread_.start(QThread::TimeCriticalPriority);
+  }
 
   ~BluetoothManagerQt() override {
-    if (socket_ && socket_->state() == QBluetoothSocket::SocketState::ConnectedState) {
-      socket_->disconnectFromService();
-    }
+    // The link is torn down on its own thread, and closing it must not call back into a half-destroyed
+    // manager; the comm thread's objects are then handed back so they are destroyed where they live
+    QThread* const owner = thread();
+    RunOnCommThread([this, owner] {
+      retransmit_timer_.stop();
+      reconnect_timer_.stop();
+      session_.Attach(nullptr);
+      if (transport_) {
+        transport_->SetStateCallback(nullptr);
+        transport_.reset();
+      }
+      retransmit_timer_.moveToThread(owner);
+      reconnect_timer_.moveToThread(owner);
+      link_context_.moveToThread(owner);
+    });
+    comm_thread_.quit();
+    comm_thread_.wait();
   }
 
   BluetoothManagerQt(const BluetoothManagerQt&) = delete;
@@ -72,8 +167,17 @@ public:
   auto Connect(std::string_view address) -> std::expected<void, BluetoothError>;
   auto Disconnect() -> std::expected<void, BluetoothError>;
 
+  void SetAutoReconnect(bool enabled);
+  [[nodiscard]] uint32_t ReconnectAttempts() const noexcept {
+    return reconnect_attempts_.load(std::memory_order_relaxed);
+  }
+
   auto Send(std::span<const uint8_t> data) -> std::expected<size_t, BluetoothError>;
 
+  /// Hands a command to the comm thread; any thread.
+  template <typename SubmitFn>
+  auto Submit(SubmitFn&& submit) -> std::expected<void, BluetoothError>;
+
   void SetStateCallback(BluetoothManager::StateCallback callback) noexcept { state_callback_ = std::move(callback); }
 
   void SetDeviceDiscoveredCallback(BluetoothManager::DeviceDiscoveredCallback callback) noexcept {
@@ -88,7 +192,13 @@ public:
     data_received_callback_ = std::move(callback);
   }
 
-  [[nodiscard]] bool Available() const noexcept { return local_device_ && local_device_->isValid(); }
+  void SetAckCallback(BluetoothManager::AckCallback callback) noexcept { ack_callback_ = std::move(callback); }
+
+  void SetLowWatermark(size_t bytes) {
+    QMetaObject::invokeMethod(&link_context_, [this, bytes] { session_.SetLowWatermark(bytes); }, Qt::QueuedConnection);
+  }
+
+  [[nodiscard]] bool Available() const noexcept;
 
   [[nodiscard]] bool Enabled() const noexcept;
 
@@ -98,32 +208,74 @@ public:
 
   [[nodiscard]] auto ConnectedDevice() const -> std::optional<BluetoothDevice>;
 
+  [[nodiscard]] size_t QueueDepth() const noexcept {
+    return command_queue_->Depth() + scheduler_depth_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t CoalescedCommands() const noexcept { return coalesced_.load(std::memory_order_relaxed); }
+
   [[nodiscard]] std::string_view LastError() const noexcept { return last_error_; }
 
   [[nodiscard]] Protocol& GetProtocol() noexcept { return protocol_; }
   [[nodiscard]] const Protocol& GetProtocol() const noexcept { return protocol_; }
 
-private slots:
+  [[nodiscard]] LinkSession& Session() noexcept { return session_; }
+  [[nodiscard]] const LinkSession& Session() const noexcept { return session_; }
+
+private:
+#ifdef CLIENT_COMM_HAS_BLUETOOTH
   void OnDeviceDiscovered(const QBluetoothDeviceInfo& info);
   void OnScanFinished();
   void OnScanError(QBluetoothDeviceDiscoveryAgent::Error error);
-  void OnSocketConnected();
-  void OnSocketDisconnected();
-  void OnSocketError(QBluetoothSocket::SocketError error);
-  void OnSocketReadyRead();
-
-private:
+#endif
+  // Comm thread
+  auto Open(const TransportEndpoint& endpoint, std::string_view address, std::string& error)
+      -> std::expected<void, BluetoothError>;
+  void OnTransportState(TransportState state, TransportError error);
+  void ScheduleReconnect();
+  void Reconnect();
+  void DrainCommands();
+  void PublishSessionStats() noexcept;
+
+  // Any thread
   void SetState(BluetoothState state, std::string_view error_message = "");
 
+  /// Runs @p fn on the comm thread and waits for it.
+  template <typename Fn>
+  void RunOnCommThread(Fn&& fn);
+
+  /// Runs @p fn on the owner thread: right away if called there, queued otherwise.
+  template <typename Fn>
+  void PostToOwner(Fn&& fn);
+
   Protocol protocol_;
-  std::unique_ptr<QBluetoothLocalDevice> local_device_;
-  std::unique_ptr<QBluetoothDeviceDiscoveryAgent> discovery_agent_;
-  std::unique_ptr<QBluetoothSocket> socket_;
 
-  mutable std::shared_mutex mutex_;
-  std::vector<BluetoothDevice> discovered_devices_;
-  std::optional<BluetoothDevice> connected_device_;
+  // Comm thread: the link and everything driving it
+  QThread comm_thread_;
+  QObject link_context_;  ///< Lives on the comm thread; the context of every call made there.
+  std::unique_ptr<ITransport> transport_;
+  LinkSession session_;  // Declared after transport_: detaches from it on destruction
+  QTimer retransmit_timer_;
+  ReconnectBackoff reconnect_backoff_;
+  QTimer reconnect_timer_;
+  std::string reconnect_address_;  ///< Address of the link to restore; empty after Disconnect().
+  bool auto_reconnect_ = false;
+
+  // Any thread
+  std::unique_ptr<LinkCommandQueue> command_queue_ = std::make_unique<LinkCommandQueue>();  // Too big to embed
   std::atomic<BluetoothState> state_{BluetoothState::kDisconnected};
+  std::atomic<uint32_t> reconnect_attempts_{0};
+  std::atomic<size_t> scheduler_depth_{0};
+  std::atomic<uint64_t> coalesced_{0};
+  mutable std::shared_mutex mutex_;
+  std::optional<BluetoothDevice> connected_device_;  // Guarded by mutex_
+
+  // Owner thread
+#ifdef CLIENT_COMM_HAS_BLUETOOTH
+  std::unique_ptr<QBluetoothLocalDevice> local_device_;
+  std::unique_ptr<QBluetoothDeviceDiscoveryAgent> discovery_agent_;
+#endif
+  std::vector<BluetoothDevice> discovered_devices_;  // Guarded by mutex_
   std::string last_error_;
   bool initialized_ = false;
 
@@ -131,9 +283,40 @@ private:
   BluetoothManager::DeviceDiscoveredCallback device_discovered_callback_;
   BluetoothManager::ScanCompleteCallback scan_complete_callback_;
   BluetoothManager::DataReceivedCallback data_received_callback_;
+  BluetoothManager::AckCallback ack_callback_;
 };
 
+template <typename SubmitFn>
+auto BluetoothManagerQt::Submit(SubmitFn&& submit) -> std::expected<void, BluetoothError> {
+  if (state_.load(std::memory_order_relaxed) != BluetoothState::kConnected) {
+    return std::unexpected(BluetoothError::kNotConnected);
+  }
+  if (!submit(*command_queue_)) {
+    return std::unexpected(BluetoothError::kSendFailed);
+  }
+  return {};
+}
+
+template <typename Fn>
+void BluetoothManagerQt::RunOnCommThread(Fn&& fn) {
+  if (QThread::currentThread() == &comm_thread_) {
+    fn();
+    return;
+  }
+  QMetaObject::invokeMethod(&link_context_, std::forward<Fn>(fn), Qt::BlockingQueuedConnection);
+}
+
+template <typename Fn>
+void BluetoothManagerQt::PostToOwner(Fn&& fn) {
+  if (QThread::currentThread() == thread()) {
+    fn();
+    return;
+  }
+  QMetaObject::invokeMethod(this, std::forward<Fn>(fn), Qt::QueuedConnection);
+}
+
 auto BluetoothManagerQt::Initialize() -> std::expected<void, BluetoothError> {
+#ifdef CLIENT_COMM_HAS_BLUETOOTH
   if (initialized_) {
     return {};
   }
@@ -179,16 +362,21 @@ auto BluetoothManagerQt::Initialize() -> std::expected<void, BluetoothError> {
   discovery_agent_->setLowEnergyDiscoveryTimeout(5000);
 
   connect(discovery_agent_.get(), &QBluetoothDeviceDiscoveryAgent::deviceDiscovered, this,
-          &BluetoothManagerQt::OnDeviceDiscovered);
-  connect(discovery_agent_.get(), &QBluetoothDeviceDiscoveryAgent::finished, this, &BluetoothManagerQt::OnScanFinished);
+          [this](const QBluetoothDeviceInfo& info) { OnDeviceDiscovered(info); });
+  connect(discovery_agent_.get(), &QBluetoothDeviceDiscoveryAgent::finished, this, [this] { OnScanFinished(); });
   connect(discovery_agent_.get(), &QBluetoothDeviceDiscoveryAgent::errorOccurred, this,
-          &BluetoothManagerQt::OnScanError);
+          [this](QBluetoothDeviceDiscoveryAgent::Error error) { OnScanError(error); });
 
   initialized_ = true;
   return {};
+#else
+  last_error_ = "Bluetooth not supported on this platform";
+  return std::unexpected(BluetoothError::kNotSupported);
+#endif
 }
 
-auto BluetoothManagerQt::StartScan(uint32_t timeout_ms) -> std::expected<void, BluetoothError> {
+auto BluetoothManagerQt::StartScan([[maybe_unused]] uint32_t timeout_ms) -> std::expected<void, BluetoothError> {
+#ifdef CLIENT_COMM_HAS_BLUETOOTH
   if (!Available()) {
     CLIENT_WARN("Bluetooth not available on this system");
     return std::unexpected(BluetoothError::kNotSupported);
@@ -230,99 +418,261 @@ auto BluetoothManagerQt::StartScan(uint32_t timeout_ms) -> std::expected<void, B
   CLIENT_INFO("Starting Bluetooth scan for classic devices (timeout: {} ms)", timeout_ms);
   discovery_agent_->start(QBluetoothDeviceDiscoveryAgent::ClassicMethod);
   return {};
+#else
+  return std::unexpected(BluetoothError::kNotSupported);
+#endif
 }
 
 void BluetoothManagerQt::StopScan() {
+#ifdef CLIENT_COMM_HAS_BLUETOOTH
   if (discovery_agent_ && discovery_agent_->isActive()) {
     discovery_agent_->stop();
   }
+#endif
   if (state_.load(std::memory_order_relaxed) == BluetoothState::kScanning) {
     SetState(BluetoothState::kDisconnected);
   }
 }
 
 auto BluetoothManagerQt::Connect(std::string_view address) -> std::expected<void, BluetoothError> {
-  if (!Available()) {
-    return std::unexpected(BluetoothError::kNotSupported);
-  }
-
   if (state_.load(std::memory_order_relaxed) == BluetoothState::kConnected) {
     return std::unexpected(BluetoothError::kAlreadyConnected);
   }
 
-  StopScan();
-
-  const auto addr_str = QString::fromUtf8(address.data(), static_cast<qsizetype>(address.size()));
-  const QBluetoothAddress bt_address(addr_str);
-
-  if (bt_address.isNull()) {
-    last_error_ = "Invalid Bluetooth address";
-    CLIENT_ERROR("Invalid Bluetooth address: {}", addr_str.toStdString());
+  const auto endpoint = ParseTransportEndpoint(address);
+  if (!endpoint) {
+    last_error_ = "Invalid device address";
+    CLIENT_ERROR("Invalid device address: {}", address);
     return std::unexpected(BluetoothError::kDeviceNotFound);
   }
 
-  CLIENT_INFO("Attempting to connect to Bluetooth device: {} using SPP service UUID: {}", addr_str.toStdString(),
-              kSerialPortServiceUuid);
-
-  socket_ = std::make_unique<QBluetoothSocket>(QBluetoothServiceInfo::RfcommProtocol, this);
+  if (endpoint->kind == TransportKind::kBluetooth) {
+    if (!Available()) {
+      return std::unexpected(BluetoothError::kNotSupported);
+    }
+    StopScan();
+  }
 
-  connect(socket_.get(), &QBluetoothSocket::connected, this, &BluetoothManagerQt::OnSocketConnected);
-  connect(socket_.get(), &QBluetoothSocket::disconnected, this, &BluetoothManagerQt::OnSocketDisconnected);
-  connect(socket_.get(), &QBluetoothSocket::errorOccurred, this, &BluetoothManagerQt::OnSocketError);
-  connect(socket_.get(), &QBluetoothSocket::readyRead, this, &BluetoothManagerQt::OnSocketReadyRead);
+  // A connection the user asked for replaces any reconnection in progress
+  std::expected<void, BluetoothError> result;
+  std::string error;
+  RunOnCommThread([&] {
+    reconnect_timer_.stop();
+    reconnect_backoff_.Reset();
+    reconnect_attempts_.store(0, std::memory_order_relaxed);
+    reconnect_address_ = std::string(address);
+    result = Open(*endpoint, address, error);
+  });
+  if (!error.empty()) {
+    last_error_ = std::move(error);
+  }
+  return result;
+}
 
-  SetState(BluetoothState::kConnecting);
+auto BluetoothManagerQt::Open(const TransportEndpoint& endpoint, std::string_view address, std::string& error)
+    -> std::expected<void, BluetoothError> {
+  auto transport = CreateTransport(endpoint.kind);
+  if (!transport) {
+    error = std::format("{} links are not supported in this build", TransportKindToString(endpoint.kind));
+    CLIENT_ERROR("{}", error);
+    return std::unexpected(ToBluetoothError(transport.error()));
+  }
 
-  // Connect to SPP service
-  const QBluetoothUuid service_uuid(QString::fromLatin1(kSerialPortServiceUuid));
-  socket_->connectToService(bt_address, service_uuid);
+  // Replacing a transport that is still connecting must not report its teardown
+  session_.Attach(nullptr);
+  if (transport_) {
+    transport_->SetStateCallback(nullptr);
+  }
+  transport_ = std::move(*transport);
+  transport_->SetStateCallback([this](TransportState state, TransportError error) { OnTransportState(state, error); });
+  session_.Attach(transport_.get());
 
-  // Store device info
   {
     std::scoped_lock lock(mutex_);
     connected_device_ = BluetoothDevice{
         .name = "ESP32 Device", .address = std::string(address), .rssi = 0, .is_paired = false, .is_connected = false};
   }
 
-  return {};
-}
+  SetState(BluetoothState::kConnecting);
 
-auto BluetoothManagerQt::Disconnect() -> std::expected<void, BluetoothError> {
-  if (state_.load(std::memory_order_relaxed) == BluetoothState::kDisconnected) {
-    return {};
+  // Some backends (serial) open synchronously and report kOpen from inside Open()
+  if (const auto opened = transport_->Open(endpoint.address); !opened) {
+    {
+      std::scoped_lock lock(mutex_);
+      connected_device_.reset();
+    }
+    const std::string_view reason =
+        transport_->LastError().empty() ? TransportErrorToString(opened.error()) : transport_->LastError();
+    CLIENT_ERROR("Failed to open {} link to {}: {}", TransportKindToString(endpoint.kind), endpoint.address, reason);
+    error = std::string(reason);
+    SetState(BluetoothState::kError, reason);
+    return std::unexpected(ToBluetoothError(opened.error()));
   }
 
-  if (socket_) {
-    socket_->disconnectFromService();
-  }
+  return {};
+}
 
+auto BluetoothManagerQt::Disconnect() -> std::expected<void, BluetoothError> {
+  RunOnCommThread([this] {
+    reconnect_timer_.stop();
+    reconnect_address_.clear();
+    if (state_.load(std::memory_order_relaxed) != BluetoothState::kDisconnected && transport_) {
+      transport_->Close();
+    }
+  });
   return {};
 }
 
 auto BluetoothManagerQt::Send(std::span<const uint8_t> data) -> std::expected<size_t, BluetoothError> {
+  CLIENT_SPAN("BluetoothManager::Send");
+
   if (state_.load(std::memory_order_relaxed) != BluetoothState::kConnected) {
     return std::unexpected(BluetoothError::kNotConnected);
   }
 
-  if (!socket_ || socket_->state() != QBluetoothSocket::SocketState::ConnectedState) {
-    return std::unexpected(BluetoothError::kNotConnected);
+  // Raw writes bypass the command queue, so they wait for the comm thread
+  std::expected<size_t, TransportError> result = std::unexpected(TransportError::kNotOpen);
+  std::string error;
+  RunOnCommThread([&] {
+    if (transport_) {
+      result = transport_->Write(data);
+      if (!result) {
+        error = std::string(transport_->LastError());
+      }
+    }
+  });
+  if (!error.empty()) {
+    last_error_ = std::move(error);
   }
+  return ToBluetoothResult(result);
+}
 
-  const auto bytes_written = socket_->write(std::bit_cast<const char*>(data.data()), static_cast<qint64>(data.size()));
+void BluetoothManagerQt::DrainCommands() {
+  command_queue_->Drain([this](const LinkCommand& command) {
+    const auto result = ExecuteLinkCommand(session_, command);
+    // A MOVE that finds the link gone is superseded by the next one anyway
+    if (!result && command.kind != LinkCommandKind::kMove) {
+      CLIENT_WARN("Dropped queued command {}: {}", command.command_id, TransportErrorToString(result.error()));
+    }
+  });
+  PublishSessionStats();
+}
 
-  if (bytes_written < 0) {
-    last_error_ = socket_->errorString().toStdString();
-    return std::unexpected(BluetoothError::kSendFailed);
+void BluetoothManagerQt::PublishSessionStats() noexcept {
+  scheduler_depth_.store(session_.Scheduler().Depth(), std::memory_order_relaxed);
+  coalesced_.store(session_.Scheduler().Coalesced(), std::memory_order_relaxed);
+}
+
+void BluetoothManagerQt::OnTransportState(TransportState state, TransportError error) {
+  switch (state) {
+    case TransportState::kOpening:
+      break;
+
+    case TransportState::kOpen: {
+      // Reconnecting by the resolved address skips lookups such as the Bluetooth SDP query
+      if (auto resolved = transport_->ResolvedAddress(); !resolved.empty()) {
+        reconnect_address_ = std::move(resolved);
+      }
+      reconnect_backoff_.Reset();
+      reconnect_attempts_.store(0, std::memory_order_relaxed);
+      {
+        std::scoped_lock lock(mutex_);
+        if (connected_device_) {
+          connected_device_->address = reconnect_address_;
+          connected_device_->is_connected = true;
+          CLIENT_INFO("Successfully connected to device: {} ({})", connected_device_->name,
+                      connected_device_->address);
+        }
+      }
+      // The session starts first, so commands queued from the state callback follow the handshake
+      session_.Start();
+      retransmit_timer_.start();
+      SetState(BluetoothState::kConnected);
+      break;
+    }
+
+    case TransportState::kClosed: {
+      {
+        std::scoped_lock lock(mutex_);
+        connected_device_.reset();
+      }
+      retransmit_timer_.stop();
+      session_.Stop();
+      PublishSessionStats();
+
+      if (error == TransportError::kOk) {
+        SetState(BluetoothState::kDisconnected);
+      } else {
+        const std::string message(transport_ && !transport_->LastError().empty() ? transport_->LastError()
+                                                                                   : TransportErrorToString(error));
+        SetState(BluetoothState::kError, message);
+      }
+
+      // A lost link is restored, and so is one whose restoration failed; a first connect that fails is not retried
+      if (error == TransportError::kConnectionLost ||
+          (error == TransportError::kOpenFailed && reconnect_backoff_.Attempts() != 0)) {
+        ScheduleReconnect();
+      }
+      break;
+    }
+  }
+}
+
+void BluetoothManagerQt::SetAutoReconnect(bool enabled) {
+  QMetaObject::invokeMethod(
+      &link_context_,
+      [this, enabled] {
+        auto_reconnect_ = enabled;
+        if (!enabled) {
+          reconnect_timer_.stop();
+        }
+      },
+      Qt::QueuedConnection);
+}
+
+void BluetoothManagerQt::ScheduleReconnect() {
+  if (!auto_reconnect_ || reconnect_address_.empty()) {
+    return;
   }
 
-  return static_cast<size_t>(bytes_written);
+  const auto delay = reconnect_backoff_.NextDelay();
+  reconnect_attempts_.store(reconnect_backoff_.Attempts(), std::memory_order_relaxed);
+  CLIENT_INFO("Reconnecting to {} in {} ms (attempt {})", reconnect_address_, delay.count(),
+              reconnect_backoff_.Attempts());
+  reconnect_timer_.start(delay);
+}
+
+void BluetoothManagerQt::Reconnect() {
+  if (reconnect_address_.empty() || state_.load(std::memory_order_relaxed) == BluetoothState::kConnected) {
+    return;
+  }
+
+  // Open() copies the address into the connected device, which may be reconnect_address_ itself
+  const std::string address = reconnect_address_;
+  const auto endpoint = ParseTransportEndpoint(address);
+  std::string error;
+  if (!endpoint || !Open(*endpoint, address, error)) {
+    ScheduleReconnect();
+  }
+}
+
+bool BluetoothManagerQt::Available() const noexcept {
+#ifdef CLIENT_COMM_HAS_BLUETOOTH
+  return local_device_ && local_device_->isValid();
+#else
+  return false;
+#endif
 }
 
 bool BluetoothManagerQt::Enabled() const noexcept {
+#ifdef CLIENT_COMM_HAS_BLUETOOTH
   if (!local_device_ || !local_device_->isValid()) {
     return false;
   }
   return local_device_->hostMode() != QBluetoothLocalDevice::HostPoweredOff;
+#else
+  return false;
+#endif
 }
 
 auto BluetoothManagerQt::DiscoveredDevices() const -> std::vector<BluetoothDevice> {
@@ -335,6 +685,8 @@ auto BluetoothManagerQt::ConnectedDevice() const -> std::optional<BluetoothDevic
   return connected_device_;
 }
 
+#ifdef CLIENT_COMM_HAS_BLUETOOTH
+
 void BluetoothManagerQt::OnDeviceDiscovered(const QBluetoothDeviceInfo& info) {
   BluetoothDevice device{
       .name = info.name().toStdString(),
@@ -402,108 +754,27 @@ void BluetoothManagerQt::OnScanError(QBluetoothDeviceDiscoveryAgent::Error error
   SetState(BluetoothState::kError, error_msg);
 }
 
-void BluetoothManagerQt::OnSocketConnected() {
-  {
-    std::scoped_lock lock(mutex_);
-    if (connected_device_) {
-      connected_device_->is_connected = true;
-      CLIENT_INFO("Successfully connected to Bluetooth device: {} ({})", connected_device_->name,
-                  connected_device_->address);
-    }
-  }
-  SetState(BluetoothState::kConnected);
-}
-
-void BluetoothManagerQt::OnSocketDisconnected() {
-  {
-    std::scoped_lock lock(mutex_);
-    connected_device_.reset();
-  }
-
-  SetState(BluetoothState::kDisconnected);
-}
-
-void BluetoothManagerQt::OnSocketError(QBluetoothSocket::SocketError error) {
-  std::string error_msg;
-  switch (error) {
-    case QBluetoothSocket::SocketError::UnknownSocketError:
-      error_msg = "Unknown socket error";
-      break;
-    case QBluetoothSocket::SocketError::NoSocketError:
-      return;  // No error
-    case QBluetoothSocket::SocketError::HostNotFoundError:
-      error_msg = "Device not found";
-      break;
-    case QBluetoothSocket::SocketError::ServiceNotFoundError:
-      error_msg = "Service not found on device";
-      break;
-    case QBluetoothSocket::SocketError::NetworkError:
-      error_msg = "Network error";
-      break;
-    case QBluetoothSocket::SocketError::UnsupportedProtocolError:
-      error_msg = "Unsupported protocol";
-      break;
-    case QBluetoothSocket::SocketError::OperationError:
-      error_msg = "Operation error";
-      break;
-    case QBluetoothSocket::SocketError::RemoteHostClosedError:
-      error_msg = "Connection closed by remote device";
-      break;
-    default:
-      error_msg = socket_ ? socket_->errorString().toStdString() : "Unknown error";
-      break;
-  }
-
-  CLIENT_ERROR("Bluetooth socket error: {}", error_msg);
-  if (socket_) {
-    CLIENT_ERROR("Socket state: {}, Error code: {}", static_cast<int>(socket_->state()), static_cast<int>(error));
-  }
-
-  last_error_ = error_msg;
-
-  {
-    std::scoped_lock lock(mutex_);
-    connected_device_.reset();
-  }
-
-  SetState(BluetoothState::kError, error_msg);
-}
-
-void BluetoothManagerQt::OnSocketReadyRead() {
-  if (!socket_ || !data_received_callback_) {
-    return;
-  }
-
-  const auto data = socket_->readAll();
-  if (!data.isEmpty()) {
-    const auto* data_ptr = std::bit_cast<const uint8_t*>(data.constData());
-    data_received_callback_(std::span<const uint8_t>(data_ptr, static_cast<size_t>(data.size())));
-  }
-}
+#endif  // CLIENT_COMM_HAS_BLUETOOTH
 
 void BluetoothManagerQt::SetState(BluetoothState state, std::string_view error_message) {
   const auto old_state = state_.exchange(state, std::memory_order_relaxed);
-  if (!error_message.empty()) {
-    last_error_ = std::string(error_message);
+  if (old_state == state && error_message.empty()) {
+    return;
   }
 
-  if (old_state != state && state_callback_) {
-    state_callback_(state, error_message);
-  }
+  // State() changes right away; the error and the callback are the owner thread's
+  PostToOwner([this, state, changed = old_state != state, message = std::string(error_message)] {
+    if (!message.empty()) {
+      last_error_ = message;
+    }
+    if (changed && state_callback_) {
+      state_callback_(state, message);
+    }
+  });
 }
 
-#include "bluetooth.moc"
-
-#endif  // CLIENT_COMM_HAS_BLUETOOTH
-
 struct BluetoothManager::Impl {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   BluetoothManagerQt qt_impl;
-#else
-  Protocol protocol;
-  std::atomic<BluetoothState> state{BluetoothState::kDisconnected};
-  std::string last_error = "Bluetooth not supported on this platform";
-#endif
 
   Impl() = default;
   ~Impl() = default;
@@ -519,214 +790,174 @@ BluetoothManager::BluetoothManager() = default;
 BluetoothManager::~BluetoothManager() = default;
 
 auto BluetoothManager::Initialize() -> std::expected<void, BluetoothError> {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   return impl_->qt_impl.Initialize();
-#else
-  return std::unexpected(BluetoothError::kNotSupported);
-#endif
 }
 
 bool BluetoothManager::Available() const noexcept {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   return impl_->qt_impl.Available();
-#else
-  return false;
-#endif
 }
 
 bool BluetoothManager::Enabled() const noexcept {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   return impl_->qt_impl.Enabled();
-#else
-  return false;
-#endif
 }
 
-auto BluetoothManager::StartScan([[maybe_unused]] uint32_t timeout_ms) -> std::expected<void, BluetoothError> {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
+auto BluetoothManager::StartScan(uint32_t timeout_ms) -> std::expected<void, BluetoothError> {
   return impl_->qt_impl.StartScan(timeout_ms);
-#else
-  return std::unexpected(BluetoothError::kNotSupported);
-#endif
 }
 
 void BluetoothManager::StopScan() {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   impl_->qt_impl.StopScan();
-#endif
 }
 
 auto BluetoothManager::DiscoveredDevices() const -> std::vector<BluetoothDevice> {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   return impl_->qt_impl.DiscoveredDevices();
-#else
-  return {};
-#endif
 }
 
-auto BluetoothManager::Connect([[maybe_unused]] std::string_view address) -> std::expected<void, BluetoothError> {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
+auto BluetoothManager::Connect(std::string_view address) -> std::expected<void, BluetoothError> {
   return impl_->qt_impl.Connect(address);
-#else
-  return std::unexpected(BluetoothError::kNotSupported);
-#endif
 }
 
 auto BluetoothManager::Disconnect() -> std::expected<void, BluetoothError> {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   return impl_->qt_impl.Disconnect();
-#else
-  return std::unexpected(BluetoothError::kNotSupported);
-#endif
 }
 
-auto BluetoothManager::Send([[maybe_unused]] std::span<const uint8_t> data) -> std::expected<size_t, BluetoothError> {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
-  return impl_->qt_impl.Send(data);
-#else
-  return std::unexpected(BluetoothError::kNotSupported);
-#endif
+void BluetoothManager::SetAutoReconnect(bool enabled) {
+  impl_->qt_impl.SetAutoReconnect(enabled);
 }
 
-auto BluetoothManager::SendCommand([[maybe_unused]] const ServoCommand& cmd) -> std::expected<void, BluetoothError> {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
-  auto serialized = impl_->qt_impl.GetProtocol().SerializeServoCommand(cmd);
-  if (!serialized) {
-    return std::unexpected(BluetoothError::kSendFailed);
-  }
+uint32_t BluetoothManager::ReconnectAttempts() const noexcept {
+  return impl_->qt_impl.ReconnectAttempts();
+}
 
-  const auto result = impl_->qt_impl.Send(*serialized);
-  if (!result) {
-    return std::unexpected(result.error());
-  }
+auto BluetoothManager::Send(std::span<const uint8_t> data) -> std::expected<size_t, BluetoothError> {
+  return impl_->qt_impl.Send(data);
+}
 
-  return {};
-#else
-  return std::unexpected(BluetoothError::kNotSupported);
-#endif
+auto BluetoothManager::SendCommand(const ServoCommand& cmd) -> std::expected<void, BluetoothError> {
+  return impl_->qt_impl.Submit([&cmd](LinkCommandQueue& queue) { return queue.SubmitMove(cmd); });
 }
 
-auto BluetoothManager::SendHeartbeat() -> std::expected<void, BluetoothError> {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
+auto BluetoothManager::SendHeartbeat(uint32_t sequence) -> std::expected<void, BluetoothError> {
   HeartbeatMessage msg{.timestamp_ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
                                                                  std::chrono::steady_clock::now().time_since_epoch())
                                                                  .count()),
-                       .sequence = 0};
+                       .sequence = sequence};
 
-  auto serialized = impl_->qt_impl.GetProtocol().SerializeHeartbeat(msg);
-  if (!serialized) {
+  std::array<uint8_t, kMaxFramePayloadSize> payload;
+  const auto size = impl_->qt_impl.GetProtocol().SerializeHeartbeat(msg, payload);
+  if (!size) {
     return std::unexpected(BluetoothError::kSendFailed);
   }
 
-  const auto result = impl_->qt_impl.Send(*serialized);
-  if (!result) {
-    return std::unexpected(result.error());
-  }
-
-  return {};
-#else
-  return std::unexpected(BluetoothError::kNotSupported);
-#endif
+  return impl_->qt_impl.Submit([&payload, &size](LinkCommandQueue& queue) {
+    return queue.SubmitControl(std::span<const uint8_t>(payload.data(), *size));
+  });
 }
 
-auto BluetoothManager::SendCalibrate() -> std::expected<void, BluetoothError> {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
-  auto serialized = impl_->qt_impl.GetProtocol().SerializeCalibrate();
-  if (!serialized) {
+auto BluetoothManager::SendCalibrate(uint32_t command_id) -> std::expected<void, BluetoothError> {
+  std::array<uint8_t, kMaxFramePayloadSize> payload;
+  const auto size = impl_->qt_impl.GetProtocol().SerializeCalibrate(payload, command_id);
+  if (!size) {
     return std::unexpected(BluetoothError::kSendFailed);
   }
 
-  const auto result = impl_->qt_impl.Send(*serialized);
-  if (!result) {
-    return std::unexpected(result.error());
-  }
-
-  return {};
-#else
-  return std::unexpected(BluetoothError::kNotSupported);
-#endif
+  // Calibrating is not idempotent, so it is retransmitted until answered and the device drops repeats
+  return impl_->qt_impl.Submit([&payload, &size, command_id](LinkCommandQueue& queue) {
+    return queue.SubmitReliable(command_id, std::span<const uint8_t>(payload.data(), *size));
+  });
 }
 
-auto BluetoothManager::SendHome() -> std::expected<void, BluetoothError> {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
-  auto serialized = impl_->qt_impl.GetProtocol().SerializeHome();
-  if (!serialized) {
+auto BluetoothManager::SendHome(uint32_t command_id) -> std::expected<void, BluetoothError> {
+  std::array<uint8_t, kMaxFramePayloadSize> payload;
+  const auto size = impl_->qt_impl.GetProtocol().SerializeHome(payload, command_id);
+  if (!size) {
     return std::unexpected(BluetoothError::kSendFailed);
   }
 
-  const auto result = impl_->qt_impl.Send(*serialized);
-  if (!result) {
-    return std::unexpected(result.error());
+  return impl_->qt_impl.Submit([&payload, &size](LinkCommandQueue& queue) {
+    return queue.SubmitControl(std::span<const uint8_t>(payload.data(), *size));
+  });
+}
+
+auto BluetoothManager::SendGetStatus(uint32_t command_id) -> std::expected<void, BluetoothError> {
+  std::array<uint8_t, kMaxFramePayloadSize> payload;
+  const auto size = impl_->qt_impl.GetProtocol().SerializeGetStatus(payload, command_id);
+  if (!size) {
+    return std::unexpected(BluetoothError::kSendFailed);
   }
 
-  return {};
-#else
-  return std::unexpected(BluetoothError::kNotSupported);
-#endif
+  // The answer decides whether the session must calibrate, so it is retransmitted until it arrives
+  return impl_->qt_impl.Submit([&payload, &size, command_id](LinkCommandQueue& queue) {
+    return queue.SubmitReliable(command_id, std::span<const uint8_t>(payload.data(), *size));
+  });
 }
 
-void BluetoothManager::SetStateCallback([[maybe_unused]] StateCallback callback) noexcept {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
+void BluetoothManager::SetStateCallback(StateCallback callback) noexcept {
   impl_->qt_impl.SetStateCallback(std::move(callback));
-#endif
 }
 
-void BluetoothManager::SetDeviceDiscoveredCallback([[maybe_unused]] DeviceDiscoveredCallback callback) noexcept {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
+void BluetoothManager::SetDeviceDiscoveredCallback(DeviceDiscoveredCallback callback) noexcept {
   impl_->qt_impl.SetDeviceDiscoveredCallback(std::move(callback));
-#endif
 }
 
-void BluetoothManager::SetScanCompleteCallback([[maybe_unused]] ScanCompleteCallback callback) noexcept {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
+void BluetoothManager::SetScanCompleteCallback(ScanCompleteCallback callback) noexcept {
   impl_->qt_impl.SetScanCompleteCallback(std::move(callback));
-#endif
 }
 
-void BluetoothManager::SetDataReceivedCallback([[maybe_unused]] DataReceivedCallback callback) noexcept {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
+void BluetoothManager::SetDataReceivedCallback(DataReceivedCallback callback) noexcept {
   impl_->qt_impl.SetDataReceivedCallback(std::move(callback));
-#endif
+}
+
+void BluetoothManager::SetAckCallback(AckCallback callback) noexcept {
+  impl_->qt_impl.SetAckCallback(std::move(callback));
+}
+
+void BluetoothManager::SetRetransmitTimeout(std::chrono::milliseconds timeout) noexcept {
+  impl_->qt_impl.Session().SetRetransmitTimeout(timeout);
 }
 
 BluetoothState BluetoothManager::State() const noexcept {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   return impl_->qt_impl.State();
-#else
-  return impl_->state.load(std::memory_order_relaxed);
-#endif
 }
 
 auto BluetoothManager::ConnectedDevice() const -> std::optional<BluetoothDevice> {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   return impl_->qt_impl.ConnectedDevice();
-#else
-  return std::nullopt;
-#endif
+}
+
+size_t BluetoothManager::QueueDepth() const noexcept {
+  return impl_->qt_impl.QueueDepth();
+}
+
+uint64_t BluetoothManager::CoalescedCommands() const noexcept {
+  return impl_->qt_impl.CoalescedCommands();
+}
+
+bool BluetoothManager::CompactControlActive() const noexcept {
+  return impl_->qt_impl.Session().CompactControlActive();
+}
+
+bool BluetoothManager::WindowAckActive() const noexcept {
+  return impl_->qt_impl.Session().WindowAckActive();
+}
+
+uint64_t BluetoothManager::Retransmissions() const noexcept {
+  return impl_->qt_impl.Session().Retransmissions();
+}
+
+void BluetoothManager::SetSendLowWatermark(size_t bytes) noexcept {
+  impl_->qt_impl.SetLowWatermark(bytes);
 }
 
 std::string_view BluetoothManager::LastError() const noexcept {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   return impl_->qt_impl.LastError();
-#else
-  return impl_->last_error;
-#endif
 }
 
 Protocol& BluetoothManager::GetProtocol() noexcept {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   return impl_->qt_impl.GetProtocol();
-#else
-  return impl_->protocol;
-#endif
 }
 
 const Protocol& BluetoothManager::GetProtocol() const noexcept {
-#ifdef CLIENT_COMM_HAS_BLUETOOTH
   return impl_->qt_impl.GetProtocol();
-#else
-  return impl_->protocol;
-#endif
 }
 
 }  // namespace client::comm
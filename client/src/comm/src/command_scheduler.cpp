@@ -0,0 +1,30 @@
+#include <client/comm/command_scheduler.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace client::comm {
+
+bool CommandScheduler::SubmitMove(std::span<const uint8_t> frame) {
+  const bool replaced = has_move_;
+  if (replaced) {
+    ++coalesced_;
+  }
+
+  // Reuses the buffer's capacity, so steady-state coalescing does not allocate
+  move_.assign(frame.begin(), frame.end());
+  has_move_ = true;
+  return replaced;
+}
+
+void CommandScheduler::SubmitControl(std::span<const uint8_t> frame) {
+  control_.emplace_back(frame.begin(), frame.end());
+}
+
+void CommandScheduler::Clear() noexcept {
+  control_.clear();
+  has_move_ = false;
+}
+
+}  // namespace client::comm
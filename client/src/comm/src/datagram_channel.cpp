@@ -0,0 +1,100 @@
+#include <client/comm/datagram_channel.hpp>
+
+#include <client/comm/framing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace client::comm {
+
+DatagramKind ClassifyFrame(std::span<const uint8_t> frame) noexcept {
+  // Decoded on a copy: the caller still sends the encoded bytes
+  std::array<uint8_t, MaxEncodedFrameSize(kMaxFramePayloadSize)> copy;
+  if (frame.size() < 2 || frame.size() > copy.size() || frame.front() != kFrameDelimiter ||
+      frame.back() != kFrameDelimiter) {
+    return DatagramKind::kReliable;
+  }
+
+  const size_t body_size = frame.size() - 2;
+  std::copy_n(frame.begin() + 1, body_size, copy.begin());
+  const auto decoded = DecodeFrame(std::span<uint8_t>(copy.data(), body_size));
+  if (!decoded) {
+    return DatagramKind::kReliable;
+  }
+
+  switch (decoded->type) {
+    case FrameType::kCompact:
+    case FrameType::kWindowAck:
+      return DatagramKind::kLatest;
+    default:
+      return DatagramKind::kReliable;
+  }
+}
+
+void DatagramChannel::Reset(uint8_t session) noexcept {
+  session_ = session;
+  next_latest_ = 0;
+  next_reliable_ = 0;
+  queue_.clear();
+  in_flight_ = 0;
+  peer_acked_ = false;
+  timeout_ = kInitialTimeout;
+  deadline_ = {};
+  stats_ = {};
+  ResetReceiver(0);
+  peer_known_ = false;
+}
+
+void DatagramChannel::ResetReceiver(uint8_t peer_session) noexcept {
+  peer_known_ = true;
+  peer_session_ = peer_session;
+  latest_synced_ = false;
+  newest_latest_ = 0;
+  reliable_synced_ = false;
+  expected_reliable_ = 0;
+  has_transit_ = false;
+  last_transit_us_ = 0;
+  jitter_q4_ = 0;
+  stats_.jitter_us = 0;
+}
+
+bool DatagramChannel::Acknowledge(uint32_t next_expected, std::chrono::steady_clock::time_point now) noexcept {
+  // An acknowledgement beyond what was sent cannot belong to this session
+  if (static_cast<int32_t>(next_expected - next_reliable_) > 0) {
+    return false;
+  }
+
+  size_t acknowledged = 0;
+  while (in_flight_ != 0 && static_cast<int32_t>(next_expected - queue_.front().sequence) > 0) {
+    queue_.pop_front();
+    --in_flight_;
+    ++acknowledged;
+  }
+  if (acknowledged == 0) {
+    return false;
+  }
+
+  peer_acked_ = true;
+  timeout_ = kInitialTimeout;
+  deadline_ = now + timeout_;
+  return true;
+}
+
+void DatagramChannel::UpdateJitter(uint32_t sent_us, uint32_t arrived_us) noexcept {
+  // RFC 3550 A.8: the clocks need not agree, only the change in transit time matters
+  const auto transit = static_cast<int32_t>(arrived_us - sent_us);
+  if (has_transit_) {
+    const int32_t delta = transit - last_transit_us_;
+    const auto magnitude = static_cast<uint32_t>(delta < 0 ? -static_cast<int64_t>(delta) : delta);
+    jitter_q4_ = jitter_q4_ + magnitude - ((jitter_q4_ + 8) >> 4);
+    stats_.jitter_us = jitter_q4_ >> 4;
+  }
+  has_transit_ = true;
+  last_transit_us_ = transit;
+}
+
+}  // namespace client::comm
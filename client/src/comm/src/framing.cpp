@@ -0,0 +1,164 @@
+#include <client/comm/framing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <vector>
+
+namespace client::comm {
+
+namespace {
+
+/// Varint length prefix is at most 3 bytes (21 bits), far above kMaxFramePayloadSize.
+constexpr size_t kMaxVarintSize = 3;
+constexpr size_t kCrcSize = 2;
+
+[[nodiscard]] constexpr bool IsKnownFrameType(uint8_t tag) noexcept {
+  return tag >= static_cast<uint8_t>(FrameType::kCommand) && tag <= static_cast<uint8_t>(FrameType::kWindowAck);
+}
+
+/**
+ * @brief COBS-encodes @p input into @p out.
+ * @return Number of bytes written (out must hold input.size() + input.size() / 254 + 1)
+ */
+size_t CobsEncode(std::span<const uint8_t> input, std::span<uint8_t> out) noexcept {
+  size_t code_index = 0;
+  size_t write_index = 1;
+  uint8_t code = 1;
+
+  for (const uint8_t byte : input) {
+    if (byte != 0) {
+      out[write_index++] = byte;
+      ++code;
+    }
+    if (byte == 0 || code == 0xFF) {
+      out[code_index] = code;
+      code_index = write_index++;
+      code = 1;
+    }
+  }
+
+  out[code_index] = code;
+  return write_index;
+}
+
+/**
+ * @brief COBS-decodes @p data in place.
+ * @return Decoded size, or kMalformedCobs if a block runs past the end
+ */
+auto CobsDecodeInPlace(std::span<uint8_t> data) noexcept -> std::expected<size_t, FramingError> {
+  size_t read_index = 0;
+  size_t write_index = 0;
+
+  while (read_index < data.size()) {
+    const uint8_t code = data[read_index++];
+    if (code == 0 || read_index + code - 1 > data.size()) {
+      return std::unexpected(FramingError::kMalformedCobs);
+    }
+
+    for (uint8_t i = 1; i < code; ++i) {
+      data[write_index++] = data[read_index++];
+    }
+    if (code != 0xFF && read_index < data.size()) {
+      data[write_index++] = 0;
+    }
+  }
+
+  return write_index;
+}
+
+}  // namespace
+
+auto EncodeFrame(FrameType type, std::span<const uint8_t> payload, std::span<uint8_t> out)
+    -> std::expected<size_t, FramingError> {
+  if (payload.size() > kMaxFramePayloadSize) {
+    return std::unexpected(FramingError::kPayloadTooLarge);
+  }
+  if (out.size() < MaxEncodedFrameSize(payload.size())) {
+    return std::unexpected(FramingError::kBufferTooSmall);
+  }
+
+  // Unencoded body: varint length | type | payload | CRC16 (little-endian)
+  std::array<uint8_t, kMaxVarintSize + 1 + kMaxFramePayloadSize + kCrcSize> body{};
+  size_t body_size = 0;
+
+  auto length = static_cast<uint32_t>(payload.size());
+  do {
+    auto byte = static_cast<uint8_t>(length & 0x7F);
+    length >>= 7;
+    if (length != 0) {
+      byte |= 0x80;
+    }
+    body[body_size++] = byte;
+  } while (length != 0);
+
+  body[body_size++] = static_cast<uint8_t>(type);
+  std::ranges::copy(payload, body.begin() + static_cast<std::ptrdiff_t>(body_size));
+  body_size += payload.size();
+
+  const uint16_t crc = Crc16(std::span<const uint8_t>(body.data(), body_size));
+  body[body_size++] = static_cast<uint8_t>(crc & 0xFF);
+  body[body_size++] = static_cast<uint8_t>(crc >> 8);
+
+  out[0] = kFrameDelimiter;
+  const size_t encoded = CobsEncode(std::span<const uint8_t>(body.data(), body_size), out.subspan(1));
+  out[1 + encoded] = kFrameDelimiter;
+  return encoded + 2;
+}
+
+auto EncodeFrame(FrameType type, std::span<const uint8_t> payload)
+    -> std::expected<std::vector<uint8_t>, FramingError> {
+  std::vector<uint8_t> out(MaxEncodedFrameSize(payload.size()));
+  const auto written = EncodeFrame(type, payload, out);
+  if (!written) {
+    return std::unexpected(written.error());
+  }
+  out.resize(*written);
+  return out;
+}
+
+auto DecodeFrame(std::span<uint8_t> encoded) -> std::expected<Frame, FramingError> {
+  const auto decoded_size = CobsDecodeInPlace(encoded);
+  if (!decoded_size) {
+    return std::unexpected(decoded_size.error());
+  }
+  const auto body = encoded.first(*decoded_size);
+
+  uint32_t length = 0;
+  size_t index = 0;
+  for (int shift = 0;; shift += 7) {
+    if (index >= body.size() || index >= kMaxVarintSize) {
+      return std::unexpected(FramingError::kMalformedHeader);
+    }
+    const uint8_t byte = body[index++];
+    length |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      break;
+    }
+  }
+
+  if (length > kMaxFramePayloadSize) {
+    return std::unexpected(FramingError::kPayloadTooLarge);
+  }
+  if (index >= body.size() || !IsKnownFrameType(body[index])) {
+    return std::unexpected(FramingError::kMalformedHeader);
+  }
+  const auto type = static_cast<FrameType>(body[index++]);
+
+  if (body.size() != index + length + kCrcSize) {
+    return std::unexpected(FramingError::kLengthMismatch);
+  }
+
+  const size_t crc_offset = index + length;
+  const auto expected_crc = static_cast<uint16_t>(body[crc_offset] | (body[crc_offset + 1] << 8));
+  if (Crc16(body.first(crc_offset)) != expected_crc) {
+    return std::unexpected(FramingError::kCrcMismatch);
+  }
+
+  return Frame{.type = type, .payload = body.subspan(index, length)};
+}
+
+}  // namespace client::comm
@@ -0,0 +1,71 @@
+#include <client/comm/link_command_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <span>
+
+namespace client::comm {
+
+bool LinkCommandQueue::SubmitMove(const ServoCommand& cmd) {
+  LinkCommand command;
+  command.kind = LinkCommandKind::kMove;
+  command.move = cmd;
+  return Submit(command);
+}
+
+bool LinkCommandQueue::SubmitControl(std::span<const uint8_t> payload, FrameType type) {
+  if (payload.size() > kMaxFramePayloadSize) {
+    return false;
+  }
+
+  LinkCommand command;
+  command.kind = LinkCommandKind::kControl;
+  command.frame_type = type;
+  command.size = payload.size();
+  std::ranges::copy(payload, command.payload.begin());
+  return Submit(command);
+}
+
+bool LinkCommandQueue::SubmitReliable(uint32_t command_id, std::span<const uint8_t> payload) {
+  if (payload.size() > kMaxFramePayloadSize) {
+    return false;
+  }
+
+  LinkCommand command;
+  command.kind = LinkCommandKind::kReliable;
+  command.command_id = command_id;
+  command.size = payload.size();
+  std::ranges::copy(payload, command.payload.begin());
+  return Submit(command);
+}
+
+bool LinkCommandQueue::Submit(LinkCommand& command) {
+  command.submitted_at = std::chrono::steady_clock::now();
+  if (!queue_.TryPush(command)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Only the submission that finds the comm thread idle wakes it
+  if (!wake_pending_.exchange(true, std::memory_order_acq_rel) && wake_) {
+    wake_();
+  }
+  return true;
+}
+
+auto ExecuteLinkCommand(LinkSession& session, const LinkCommand& command) -> std::expected<void, TransportError> {
+  switch (command.kind) {
+    case LinkCommandKind::kMove:
+      return session.SendMove(command.move);
+    case LinkCommandKind::kControl:
+      return session.SendControl(command.Payload(), command.frame_type);
+    case LinkCommandKind::kReliable:
+      return session.SendReliable(command.command_id, command.Payload());
+  }
+  return std::unexpected(TransportError::kWriteFailed);
+}
+
+}  // namespace client::comm
@@ -0,0 +1,110 @@
+#include <client/comm/link_monitor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace client::comm {
+
+namespace {
+
+// RFC 6298 gains for SRTT and RTTVAR, and the RFC 3550 jitter gain
+constexpr double kRttGain = 1.0 / 8.0;
+constexpr double kRttVarGain = 1.0 / 4.0;
+constexpr double kJitterGain = 1.0 / 16.0;
+
+[[nodiscard]] double ToMilliseconds(std::chrono::steady_clock::duration duration) noexcept {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+}  // namespace
+
+bool LinkMonitor::PingDue(std::chrono::steady_clock::time_point now) const {
+  std::scoped_lock lock(mutex_);
+  return !pinged_ || now - last_ping_ >= interval_;
+}
+
+void LinkMonitor::OnPingSent(uint32_t id, std::chrono::steady_clock::time_point sent_at) {
+  std::scoped_lock lock(mutex_);
+  auto& slot = outstanding_[next_slot_];
+  if (slot.active) {
+    ++stats_.lost;
+  }
+  slot = Outstanding{.id = id, .sent_at = sent_at, .active = true};
+  next_slot_ = (next_slot_ + 1) % outstanding_.size();
+
+  last_ping_ = sent_at;
+  pinged_ = true;
+  ++stats_.sent;
+}
+
+bool LinkMonitor::OnPong(uint32_t id, uint64_t device_timestamp_ms, std::chrono::steady_clock::time_point received_at) {
+  std::scoped_lock lock(mutex_);
+  const auto it = std::ranges::find_if(outstanding_, [id](const Outstanding& o) { return o.active && o.id == id; });
+  if (it == outstanding_.end()) {
+    return false;
+  }
+  it->active = false;
+
+  const double rtt = std::max(ToMilliseconds(received_at - it->sent_at), 0.0);
+  if (stats_.samples == 0) {
+    stats_.rtt_ms = rtt;
+    stats_.rtt_var_ms = rtt / 2.0;
+    stats_.min_rtt_ms = rtt;
+  } else {
+    stats_.rtt_var_ms += kRttVarGain * (std::abs(stats_.rtt_ms - rtt) - stats_.rtt_var_ms);
+    stats_.rtt_ms += kRttGain * (rtt - stats_.rtt_ms);
+    stats_.jitter_ms += kJitterGain * (std::abs(rtt - stats_.last_rtt_ms) - stats_.jitter_ms);
+    stats_.min_rtt_ms = std::min(stats_.min_rtt_ms, rtt);
+  }
+  stats_.last_rtt_ms = rtt;
+  ++stats_.samples;
+
+  // The device stamped its reply somewhere inside the round trip; assume the midpoint
+  const double host_midpoint_ms = ToMilliseconds(it->sent_at.time_since_epoch()) + rtt / 2.0;
+  offsets_[next_offset_] = OffsetSample{.rtt_ms = rtt,
+                                        .offset_ms = static_cast<double>(device_timestamp_ms) - host_midpoint_ms};
+  next_offset_ = (next_offset_ + 1) % offsets_.size();
+  offset_count_ = std::min(offset_count_ + 1, offsets_.size());
+
+  const auto best = std::ranges::min_element(offsets_.begin(), offsets_.begin() + static_cast<ptrdiff_t>(offset_count_),
+                                             {}, &OffsetSample::rtt_ms);
+  stats_.clock_offset_ms = best->offset_ms;
+  return true;
+}
+
+size_t LinkMonitor::CollectExpired(std::chrono::steady_clock::time_point now,
+                                   std::array<uint32_t, kMaxOutstanding>& expired) {
+  std::scoped_lock lock(mutex_);
+  size_t count = 0;
+  for (auto& slot : outstanding_) {
+    if (slot.active && now - slot.sent_at >= timeout_) {
+      slot.active = false;
+      expired[count++] = slot.id;
+      ++stats_.lost;
+    }
+  }
+  return count;
+}
+
+LinkStats LinkMonitor::Stats() const {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+void LinkMonitor::Reset() {
+  std::scoped_lock lock(mutex_);
+  outstanding_ = {};
+  next_slot_ = 0;
+  offsets_ = {};
+  offset_count_ = 0;
+  next_offset_ = 0;
+  pinged_ = false;
+  stats_ = {};
+}
+
+}  // namespace client::comm
@@ -0,0 +1,253 @@
+#include <client/comm/link_session.hpp>
+
+#include <client/comm/compact_codec.hpp>
+#include <client/comm/move_codec.hpp>
+#include <client/core/logger.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+
+namespace client::comm {
+
+namespace {
+
+/// Client identification sent in the handshake.
+constexpr const char* kHandshakeClientId = "client";
+
+}  // namespace
+
+LinkSession::~LinkSession() {
+  Attach(nullptr);
+}
+
+void LinkSession::Attach(ITransport* transport) {
+  if (transport_ != nullptr) {
+    transport_->SetReceiveCallback(nullptr);
+    transport_->SetWritableCallback(nullptr);
+  }
+
+  transport_ = transport;
+  if (transport_ != nullptr) {
+    transport_->SetReceiveCallback([this](std::span<const uint8_t> data) { OnReceived(data); });
+    // The backlog shrank, so a coalesced MOVE may now fit under the watermark
+    transport_->SetWritableCallback([this] { Pump(); });
+  }
+}
+
+void LinkSession::Start() {
+  Stop();
+  SendHandshake();
+}
+
+void LinkSession::Stop() {
+  frame_decoder_.Reset();
+  scheduler_.Clear();
+  ack_tracker_.Reset();
+  retransmit_queue_.Clear();
+  compact_enabled_.store(false, std::memory_order_relaxed);
+  window_ack_enabled_.store(false, std::memory_order_relaxed);
+  last_move_command_id_ = 0;
+}
+
+auto LinkSession::SendMove(const ServoCommand& cmd) -> std::expected<void, TransportError> {
+  last_move_command_id_ = cmd.command_id;
+  if (CompactControlActive()) {
+    const auto payload = EncodeCompactMove(ToCompactMove(cmd));
+    return Queue(payload.Bytes(), FrameType::kCompact, true, 0);
+  }
+
+  // Sent at frame rate, so it skips libprotobuf (the encoding is byte-identical)
+  const auto payload = EncodeMoveCommand(cmd);
+  return Queue(payload.Bytes(), FrameType::kCommand, true, 0);
+}
+
+auto LinkSession::SendControl(std::span<const uint8_t> payload, FrameType type) -> std::expected<void, TransportError> {
+  return Queue(payload, type, false, 0);
+}
+
+auto LinkSession::SendReliable(uint32_t command_id, std::span<const uint8_t> payload)
+    -> std::expected<void, TransportError> {
+  return Queue(payload, FrameType::kCommand, false, command_id);
+}
+
+size_t LinkSession::PollRetransmits(std::chrono::steady_clock::time_point now) {
+  const size_t resent = retransmit_queue_.Poll(
+      now,
+      [this](std::span<const uint8_t> frame) {
+        retransmissions_.fetch_add(1, std::memory_order_relaxed);
+        scheduler_.SubmitControl(frame);
+      },
+      [](uint32_t command_id) { CLIENT_WARN("Giving up on command {}: no response from device", command_id); });
+  if (resent != 0) {
+    Pump();
+  }
+  return resent;
+}
+
+auto LinkSession::Queue(std::span<const uint8_t> payload, FrameType type, bool latest_wins, uint32_t command_id)
+    -> std::expected<void, TransportError> {
+  if (transport_ == nullptr || transport_->State() != TransportState::kOpen) {
+    return std::unexpected(TransportError::kNotOpen);
+  }
+
+  std::array<uint8_t, MaxEncodedFrameSize(kMaxFramePayloadSize)> frame;
+  const auto encoded = EncodeFrame(type, payload, frame);
+  if (!encoded) {
+    CLIENT_ERROR("Failed to frame {} byte message: {}", payload.size(), FramingErrorToString(encoded.error()));
+    return std::unexpected(TransportError::kWriteFailed);
+  }
+
+  const std::span<const uint8_t> encoded_frame(frame.data(), *encoded);
+  if (latest_wins) {
+    scheduler_.SubmitMove(encoded_frame);
+  } else {
+    scheduler_.SubmitControl(encoded_frame);
+  }
+
+  const std::chrono::milliseconds timeout(retransmit_timeout_ms_.load(std::memory_order_relaxed));
+  if (command_id != 0 &&
+      !retransmit_queue_.Track(command_id, encoded_frame, std::chrono::steady_clock::now(), timeout)) {
+    CLIENT_WARN("Command {} will not be retransmitted: too many commands awaiting a response", command_id);
+  }
+
+  Pump();
+  return {};
+}
+
+void LinkSession::Pump() {
+  if (transport_ == nullptr || transport_->State() != TransportState::kOpen) {
+    return;
+  }
+
+  scheduler_.Drain(transport_->Backlog(),
+                   [this](std::span<const uint8_t> frame) { return transport_->Write(frame).has_value(); });
+}
+
+void LinkSession::OnReceived(std::span<const uint8_t> data) {
+  const uint64_t dropped_before = frame_decoder_.FramesDropped();
+  frame_decoder_.Feed(data, [this](const Frame& frame) { OnFrame(frame); });
+
+  if (frame_decoder_.FramesDropped() != dropped_before) {
+    CLIENT_WARN("Dropped {} corrupt frame(s) from device: {}", frame_decoder_.FramesDropped() - dropped_before,
+                FramingErrorToString(frame_decoder_.LastError()));
+  }
+}
+
+void LinkSession::OnFrame(const Frame& frame) {
+  switch (frame.type) {
+    case FrameType::kResponse:
+      OnResponse(frame.payload);
+      break;
+    case FrameType::kHandshake:
+      OnHandshakeResponse(frame.payload);
+      break;
+    case FrameType::kCompact:
+      OnCompactStatus(frame.payload);
+      break;
+    case FrameType::kWindowAck:
+      OnWindowAck(frame.payload);
+      break;
+    default:
+      CLIENT_WARN("Ignoring unexpected frame type {} from device", static_cast<int>(frame.type));
+      break;
+  }
+}
+
+void LinkSession::SendHandshake() {
+  HandshakeMessage handshake{.protocol_version = kCompactProtocolVersion,
+                             .client_id = kHandshakeClientId,
+                             .features = {std::string(kCompactControlFeature), std::string(kWindowAckFeature)}};
+  const auto payload = Protocol::SerializeHandshake(handshake);
+  if (!payload) {
+    CLIENT_WARN("Failed to serialize handshake: {}", ProtocolErrorToString(payload.error()));
+    return;
+  }
+
+  // Firmware without protocol v2 drops the unknown frame type, so the link stays on protobuf commands
+  if (const auto result = SendControl(*payload, FrameType::kHandshake); !result) {
+    CLIENT_WARN("Failed to send handshake: {}", TransportErrorToString(result.error()));
+  }
+}
+
+void LinkSession::OnHandshakeResponse(std::span<const uint8_t> payload) {
+  const auto response = Protocol::DeserializeHandshakeResponse(payload);
+  if (!response) {
+    CLIENT_WARN("Invalid handshake response from device: {}", ProtocolErrorToString(response.error()));
+    return;
+  }
+
+  if (!response->accepted) {
+    CLIENT_WARN("Device rejected handshake: {}", response->rejection_reason);
+    return;
+  }
+
+  const bool compact = response->protocol_version >= kCompactProtocolVersion &&
+                       response->Supports(kCompactControlFeature);
+  const bool window_ack = compact && response->Supports(kWindowAckFeature);
+  compact_enabled_.store(compact, std::memory_order_relaxed);
+  window_ack_enabled_.store(window_ack, std::memory_order_relaxed);
+  CLIENT_INFO("Handshake with {} (firmware {}): protocol v{}, compact control {}, windowed acks {}",
+              response->device_id, response->firmware_version, response->protocol_version,
+              compact ? "enabled" : "disabled", window_ack ? "enabled" : "disabled");
+}
+
+void LinkSession::OnCompactStatus(std::span<const uint8_t> payload) {
+  const auto status = DecodeCompactStatus(payload);
+  if (!status) {
+    CLIENT_WARN("Invalid compact status from device: {}", ProtocolErrorToString(status.error()));
+    return;
+  }
+
+  // Consumers speak StatusMessage, so re-encode as a v1 response rather than adding a second data path
+  Deliver(ToStatusMessage(*status, ExpandCompactSequence(status->sequence, last_move_command_id_)));
+}
+
+void LinkSession::OnWindowAck(std::span<const uint8_t> payload) {
+  const auto ack = DecodeWindowAck(payload);
+  if (!ack) {
+    CLIENT_WARN("Invalid window ack from device: {}", ProtocolErrorToString(ack.error()));
+    return;
+  }
+
+  ack_tracker_.Apply(*ack, last_move_command_id_, [this](uint32_t command_id) {
+    if (ack_callback_) {
+      ack_callback_(command_id);
+    }
+  });
+
+  // The status describes the device rather than one command, so it goes out unsolicited (command ID 0)
+  Deliver(ToStatusMessage(ack->status, 0));
+}
+
+void LinkSession::OnResponse(std::span<const uint8_t> payload) {
+  // Only parse here while a retransmitted command is waiting; consumers parse the payload anyway
+  if (retransmit_queue_.Pending() != 0) {
+    if (const auto response = Protocol::DeserializeStatus(payload); response) {
+      retransmit_queue_.Acknowledge(response->command_id);
+    }
+  }
+
+  if (data_received_callback_) {
+    data_received_callback_(payload);
+  }
+}
+
+void LinkSession::Deliver(const StatusMessage& msg) {
+  std::array<uint8_t, kMaxFramePayloadSize> response;
+  const auto size = Protocol::SerializeStatus(msg, response);
+  if (!size) {
+    CLIENT_WARN("Failed to convert compact status: {}", ProtocolErrorToString(size.error()));
+    return;
+  }
+
+  if (data_received_callback_) {
+    data_received_callback_(std::span<const uint8_t>(response.data(), *size));
+  }
+}
+
+}  // namespace client::comm
@@ -0,0 +1,84 @@
+#include <client/comm/loopback_transport.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace client::comm {
+
+auto LoopbackTransport::CreatePair()
+    -> std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>> {
+  std::unique_ptr<LoopbackTransport> first(new LoopbackTransport());
+  std::unique_ptr<LoopbackTransport> second(new LoopbackTransport());
+  first->peer_ = second.get();
+  second->peer_ = first.get();
+  return {std::move(first), std::move(second)};
+}
+
+LoopbackTransport::~LoopbackTransport() {
+  if (peer_ != nullptr) {
+    peer_->peer_ = nullptr;
+  }
+}
+
+auto LoopbackTransport::Open([[maybe_unused]] std::string_view address) -> std::expected<void, TransportError> {
+  if (State() != TransportState::kClosed) {
+    return std::unexpected(TransportError::kAlreadyOpen);
+  }
+  if (peer_ == nullptr) {
+    return std::unexpected(TransportError::kNotOpen);
+  }
+
+  SetState(TransportState::kOpen);
+  return {};
+}
+
+void LoopbackTransport::Close() {
+  if (State() == TransportState::kClosed) {
+    return;
+  }
+
+  backlog_.clear();
+  SetState(TransportState::kClosed);
+  if (peer_ != nullptr && peer_->State() != TransportState::kClosed) {
+    peer_->backlog_.clear();
+    peer_->SetState(TransportState::kClosed, TransportError::kConnectionLost, "Peer closed the loopback link");
+  }
+}
+
+auto LoopbackTransport::Write(std::span<const uint8_t> data) -> std::expected<size_t, TransportError> {
+  if (State() != TransportState::kOpen) {
+    RecordWriteError("Loopback link not open");
+    return std::unexpected(TransportError::kNotOpen);
+  }
+
+  backlog_.insert(backlog_.end(), data.begin(), data.end());
+  RecordWrite(data.size());
+  return data.size();
+}
+
+size_t LoopbackTransport::Pump(size_t max_bytes) {
+  const size_t count = std::min(max_bytes, backlog_.size());
+  if (count == 0) {
+    return 0;
+  }
+
+  // Copied out first: the peer may answer, and this end write again, from inside its receive callback
+  const std::vector<uint8_t> chunk(backlog_.begin(), backlog_.begin() + static_cast<std::ptrdiff_t>(count));
+  backlog_.erase(backlog_.begin(), backlog_.begin() + static_cast<std::ptrdiff_t>(count));
+
+  if (peer_ != nullptr && peer_->State() == TransportState::kOpen) {
+    peer_->Deliver(chunk);
+  }
+
+  NotifyWritable();
+  return count;
+}
+
+}  // namespace client::comm
@@ -2,35 +2,167 @@
 
 #include "messages.pb.h"
 
+#include <google/protobuf/arena.h>
 #include <google/protobuf/message.h>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <expected>
 #include <span>
+#include <string>
 #include <vector>
 
 namespace client::comm {
 
-auto Protocol::SerializeServoCommand(const ServoCommand& cmd) -> std::expected<std::vector<uint8_t>, ProtocolError> {
-  try {
-    app::Command proto_cmd;
-    proto_cmd.set_type(app::COMMAND_TYPE_MOVE);
+namespace {
 
-    auto* move = proto_cmd.mutable_move();
-    auto* target = move->mutable_target_position();
-    target->set_pan(cmd.pan_angle);
-    target->set_tilt(cmd.tilt_angle);
-    move->set_use_face_tracking(false);
+/// Size of the stack block backing each MessageArena; far above any message this protocol sends.
+constexpr size_t kArenaBlockSize = 1024;
 
-    const size_t size = proto_cmd.ByteSizeLong();
-    std::vector<uint8_t> buffer(size);
+/**
+ * @brief Protobuf arena whose first block lives on the stack.
+ * @details Messages created here (including oneof payloads, which a cleared heap message would
+ * free and reallocate) never touch the heap unless they outgrow the block.
+ */
+class MessageArena {
+public:
+  MessageArena() : arena_(Options(block_)) {}
 
-    if (!proto_cmd.SerializeToArray(buffer.data(), static_cast<int>(size))) {
-      return std::unexpected(ProtocolError::kSerializationFailed);
-    }
+  template <typename Message>
+  [[nodiscard]] Message* Create() {
+    // CreateMessage (not Create) so that sub-messages are also placed on the arena with protobuf 3.21
+    return google::protobuf::Arena::CreateMessage<Message>(&arena_);
+  }
+
+private:
+  [[nodiscard]] static google::protobuf::ArenaOptions Options(std::array<char, kArenaBlockSize>& block) noexcept {
+    google::protobuf::ArenaOptions options;
+    options.initial_block = block.data();
+    options.initial_block_size = block.size();
+    return options;
+  }
+
+  alignas(std::max_align_t) std::array<char, kArenaBlockSize> block_;
+  google::protobuf::Arena arena_;
+};
+
+[[nodiscard]] auto WriteTo(const google::protobuf::MessageLite& message, std::span<uint8_t> out)
+    -> std::expected<size_t, ProtocolError> {
+  const size_t size = message.ByteSizeLong();
+  if (size > out.size()) {
+    return std::unexpected(ProtocolError::kBufferTooSmall);
+  }
+
+  message.SerializeWithCachedSizesToArray(out.data());
+  return size;
+}
+
+[[nodiscard]] std::vector<uint8_t> ToVector(const google::protobuf::MessageLite& message) {
+  std::vector<uint8_t> buffer(message.ByteSizeLong());
+  message.SerializeWithCachedSizesToArray(buffer.data());
+  return buffer;
+}
+
+[[nodiscard]] bool Parse(google::protobuf::MessageLite& message, std::span<const uint8_t> data) {
+  return message.ParseFromArray(data.data(), static_cast<int>(data.size()));
+}
 
-    return buffer;
+void FillServoCommand(const ServoCommand& cmd, app::Command& proto_cmd) {
+  proto_cmd.set_id(cmd.command_id);
+  proto_cmd.set_timestamp_ms(cmd.timestamp_ms);
+  proto_cmd.set_type(app::COMMAND_TYPE_MOVE);
+
+  auto* move = proto_cmd.mutable_move();
+  auto* target = move->mutable_target_position();
+  target->set_pan(cmd.pan_angle);
+  target->set_tilt(cmd.tilt_angle);
+  move->set_use_face_tracking(false);
+  if (cmd.pan_velocity != 0.0F || cmd.tilt_velocity != 0.0F) {
+    auto* velocity = move->mutable_target_velocity();
+    velocity->set_pan(cmd.pan_velocity);
+    velocity->set_tilt(cmd.tilt_velocity);
+  }
+  move->set_valid_for_ms(cmd.valid_for_ms);
+}
+
+void FillStatus(const StatusMessage& msg, app::Response& proto_resp) {
+  proto_resp.set_command_id(msg.command_id);
+  proto_resp.set_timestamp_ms(msg.timestamp_ms);
+  if (msg.error_code == 0) {
+    proto_resp.set_status(app::STATUS_CODE_OK);
+  } else if (app::StatusCode_IsValid(static_cast<int>(msg.error_code))) {
+    proto_resp.set_status(static_cast<app::StatusCode>(msg.error_code));
+  } else {
+    proto_resp.set_status(app::STATUS_CODE_ERROR);
+  }
+
+  auto* status = proto_resp.mutable_device_status();
+  auto* current = status->mutable_current_position();
+  current->set_pan(msg.pan_position);
+  current->set_tilt(msg.tilt_position);
+  auto* target = status->mutable_target_position();
+  target->set_pan(msg.target_pan);
+  target->set_tilt(msg.target_tilt);
+  status->set_is_calibrated(msg.is_calibrated);
+  status->set_is_moving(msg.is_moving || msg.is_tracking);
+  status->set_uptime_ms(msg.uptime_ms);
+  status->set_free_heap(msg.free_heap);
+  if (msg.servo_loop.rate_hz != 0) {
+    auto* loop = status->mutable_servo_loop();
+    loop->set_rate_hz(msg.servo_loop.rate_hz);
+    loop->set_updates(msg.servo_loop.updates);
+    loop->set_jitter_us(msg.servo_loop.jitter_us);
+    loop->set_max_jitter_us(msg.servo_loop.max_jitter_us);
+    loop->set_overruns(msg.servo_loop.overruns);
+    loop->set_max_busy_us(msg.servo_loop.max_busy_us);
+  }
+}
+
+void FillHeartbeat(const HeartbeatMessage& msg, app::Command& proto_cmd) {
+  proto_cmd.set_id(msg.sequence);
+  proto_cmd.set_timestamp_ms(msg.timestamp_ms);
+  proto_cmd.set_type(app::COMMAND_TYPE_PING);
+}
+
+void FillCalibrate(app::Command& proto_cmd, uint32_t command_id) {
+  proto_cmd.set_id(command_id);
+  proto_cmd.set_type(app::COMMAND_TYPE_CALIBRATE);
+
+  auto* calibrate = proto_cmd.mutable_calibrate();
+  calibrate->set_mode(app::CalibrateCommand_Mode_MODE_FULL);
+}
+
+void FillHome(app::Command& proto_cmd, uint32_t command_id) {
+  proto_cmd.set_id(command_id);
+  proto_cmd.set_type(app::COMMAND_TYPE_HOME);
+}
+
+void FillGetStatus(app::Command& proto_cmd, uint32_t command_id) {
+  proto_cmd.set_id(command_id);
+  proto_cmd.set_type(app::COMMAND_TYPE_GET_STATUS);
+}
+
+}  // namespace
+
+auto Protocol::SerializeServoCommand(const ServoCommand& cmd) -> std::expected<std::vector<uint8_t>, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    FillServoCommand(cmd, *proto_cmd);
+    return ToVector(*proto_cmd);
+  } catch (...) {
+    return std::unexpected(ProtocolError::kSerializationFailed);
+  }
+}
+
+auto Protocol::SerializeServoCommand(const ServoCommand& cmd, std::span<uint8_t> out)
+    -> std::expected<size_t, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    FillServoCommand(cmd, *proto_cmd);
+    return WriteTo(*proto_cmd, out);
   } catch (...) {
     return std::unexpected(ProtocolError::kSerializationFailed);
   }
@@ -38,16 +170,17 @@ auto Protocol::SerializeServoCommand(const ServoCommand& cmd) -> std::expected<s
 
 auto Protocol::DeserializeServoCommand(std::span<const uint8_t> data) -> std::expected<ServoCommand, ProtocolError> {
   try {
-    app::Command proto_cmd;
-    if (!proto_cmd.ParseFromArray(data.data(), static_cast<int>(data.size()))) {
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    if (!Parse(*proto_cmd, data)) {
       return std::unexpected(ProtocolError::kDeserializationFailed);
     }
 
-    if (proto_cmd.type() != app::COMMAND_TYPE_MOVE || !proto_cmd.has_move()) {
+    if (proto_cmd->type() != app::COMMAND_TYPE_MOVE || !proto_cmd->has_move()) {
       return std::unexpected(ProtocolError::kInvalidMessage);
     }
 
-    const auto& move = proto_cmd.move();
+    const auto& move = proto_cmd->move();
     const auto& target = move.target_position();
 
     ServoCommand cmd;
@@ -55,6 +188,11 @@ auto Protocol::DeserializeServoCommand(std::span<const uint8_t> data) -> std::ex
     cmd.tilt_angle = target.tilt();
     cmd.speed = 1.0F;
     cmd.smooth = true;
+    cmd.command_id = proto_cmd->id();
+    cmd.timestamp_ms = proto_cmd->timestamp_ms();
+    cmd.pan_velocity = move.target_velocity().pan();
+    cmd.tilt_velocity = move.target_velocity().tilt();
+    cmd.valid_for_ms = move.valid_for_ms();
 
     return cmd;
   } catch (...) {
@@ -66,13 +204,14 @@ auto Protocol::SerializeFaceData(const FaceDataMessage& msg) -> std::expected<st
   try {
     // We'll use a Command with move type for face data
     // In a real implementation, you might want to add a dedicated message type
-    app::Command proto_cmd;
-    proto_cmd.set_id(msg.frame_id);
-    proto_cmd.set_timestamp_ms(msg.timestamp_ms);
-    proto_cmd.set_type(app::COMMAND_TYPE_MOVE);
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    proto_cmd->set_id(msg.frame_id);
+    proto_cmd->set_timestamp_ms(msg.timestamp_ms);
+    proto_cmd->set_type(app::COMMAND_TYPE_MOVE);
 
     if (!msg.faces.empty()) {
-      auto* move = proto_cmd.mutable_move();
+      auto* move = proto_cmd->mutable_move();
       move->set_use_face_tracking(true);
 
       // Use the first face as the target
@@ -87,14 +226,7 @@ auto Protocol::SerializeFaceData(const FaceDataMessage& msg) -> std::expected<st
       target->set_tilt(tilt);
     }
 
-    const size_t size = proto_cmd.ByteSizeLong();
-    std::vector<uint8_t> buffer(size);
-
-    if (!proto_cmd.SerializeToArray(buffer.data(), static_cast<int>(size))) {
-      return std::unexpected(ProtocolError::kSerializationFailed);
-    }
-
-    return buffer;
+    return ToVector(*proto_cmd);
   } catch (...) {
     return std::unexpected(ProtocolError::kSerializationFailed);
   }
@@ -102,17 +234,18 @@ auto Protocol::SerializeFaceData(const FaceDataMessage& msg) -> std::expected<st
 
 auto Protocol::DeserializeFaceData(std::span<const uint8_t> data) -> std::expected<FaceDataMessage, ProtocolError> {
   try {
-    app::Command proto_cmd;
-    if (!proto_cmd.ParseFromArray(data.data(), static_cast<int>(data.size()))) {
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    if (!Parse(*proto_cmd, data)) {
       return std::unexpected(ProtocolError::kDeserializationFailed);
     }
 
     FaceDataMessage msg;
-    msg.frame_id = proto_cmd.id();
-    msg.timestamp_ms = proto_cmd.timestamp_ms();
+    msg.frame_id = proto_cmd->id();
+    msg.timestamp_ms = proto_cmd->timestamp_ms();
 
-    if (proto_cmd.has_move() && proto_cmd.move().use_face_tracking()) {
-      const auto& target = proto_cmd.move().target_position();
+    if (proto_cmd->has_move() && proto_cmd->move().use_face_tracking()) {
+      const auto& target = proto_cmd->move().target_position();
 
       FacePosition face;
       // Convert pan/tilt back to normalized position
@@ -134,24 +267,22 @@ auto Protocol::DeserializeFaceData(std::span<const uint8_t> data) -> std::expect
 
 auto Protocol::SerializeStatus(const StatusMessage& msg) -> std::expected<std::vector<uint8_t>, ProtocolError> {
   try {
-    app::Response proto_resp;
-    proto_resp.set_status(msg.error_code == 0 ? app::STATUS_CODE_OK : app::STATUS_CODE_ERROR);
-
-    auto* status = proto_resp.mutable_device_status();
-    auto* current = status->mutable_current_position();
-    current->set_pan(msg.pan_position);
-    current->set_tilt(msg.tilt_position);
-    status->set_is_calibrated(msg.is_calibrated);
-    status->set_is_moving(msg.is_tracking);
-
-    const size_t size = proto_resp.ByteSizeLong();
-    std::vector<uint8_t> buffer(size);
-
-    if (!proto_resp.SerializeToArray(buffer.data(), static_cast<int>(size))) {
-      return std::unexpected(ProtocolError::kSerializationFailed);
-    }
+    MessageArena arena;
+    auto* proto_resp = arena.Create<app::Response>();
+    FillStatus(msg, *proto_resp);
+    return ToVector(*proto_resp);
+  } catch (...) {
+    return std::unexpected(ProtocolError::kSerializationFailed);
+  }
+}
 
-    return buffer;
+auto Protocol::SerializeStatus(const StatusMessage& msg, std::span<uint8_t> out)
+    -> std::expected<size_t, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_resp = arena.Create<app::Response>();
+    FillStatus(msg, *proto_resp);
+    return WriteTo(*proto_resp, out);
   } catch (...) {
     return std::unexpected(ProtocolError::kSerializationFailed);
   }
@@ -159,25 +290,44 @@ auto Protocol::SerializeStatus(const StatusMessage& msg) -> std::expected<std::v
 
 auto Protocol::DeserializeStatus(std::span<const uint8_t> data) -> std::expected<StatusMessage, ProtocolError> {
   try {
-    app::Response proto_resp;
-    if (!proto_resp.ParseFromArray(data.data(), static_cast<int>(data.size()))) {
+    MessageArena arena;
+    auto* proto_resp = arena.Create<app::Response>();
+    if (!Parse(*proto_resp, data)) {
       return std::unexpected(ProtocolError::kDeserializationFailed);
     }
 
     StatusMessage msg;
 
-    if (proto_resp.has_device_status()) {
-      const auto& status = proto_resp.device_status();
+    if (proto_resp->has_device_status()) {
+      const auto& status = proto_resp->device_status();
       const auto& current = status.current_position();
+      const auto& target = status.target_position();
 
       msg.pan_position = current.pan();
       msg.tilt_position = current.tilt();
+      msg.target_pan = target.pan();
+      msg.target_tilt = target.tilt();
       msg.is_calibrated = status.is_calibrated();
       msg.is_tracking = status.is_moving();
+      msg.is_moving = status.is_moving();
+      msg.has_device_status = true;
+      msg.free_heap = status.free_heap();
+      msg.uptime_ms = status.uptime_ms();
+      if (status.has_servo_loop()) {
+        const auto& loop = status.servo_loop();
+        msg.servo_loop = {.rate_hz = loop.rate_hz(),
+                          .updates = loop.updates(),
+                          .jitter_us = loop.jitter_us(),
+                          .max_jitter_us = loop.max_jitter_us(),
+                          .overruns = loop.overruns(),
+                          .max_busy_us = loop.max_busy_us()};
+      }
     }
 
-    msg.error_code = proto_resp.status() == app::STATUS_CODE_OK ? 0 : static_cast<uint32_t>(proto_resp.status());
+    msg.error_code = proto_resp->status() == app::STATUS_CODE_OK ? 0 : static_cast<uint32_t>(proto_resp->status());
     msg.battery_level = 1.0F;  // Not in proto, default to full
+    msg.command_id = proto_resp->command_id();
+    msg.timestamp_ms = proto_resp->timestamp_ms();
 
     return msg;
   } catch (...) {
@@ -187,19 +337,22 @@ auto Protocol::DeserializeStatus(std::span<const uint8_t> data) -> std::expected
 
 auto Protocol::SerializeHeartbeat(const HeartbeatMessage& msg) -> std::expected<std::vector<uint8_t>, ProtocolError> {
   try {
-    app::Command proto_cmd;
-    proto_cmd.set_id(msg.sequence);
-    proto_cmd.set_timestamp_ms(msg.timestamp_ms);
-    proto_cmd.set_type(app::COMMAND_TYPE_PING);
-
-    const size_t size = proto_cmd.ByteSizeLong();
-    std::vector<uint8_t> buffer(size);
-
-    if (!proto_cmd.SerializeToArray(buffer.data(), static_cast<int>(size))) {
-      return std::unexpected(ProtocolError::kSerializationFailed);
-    }
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    FillHeartbeat(msg, *proto_cmd);
+    return ToVector(*proto_cmd);
+  } catch (...) {
+    return std::unexpected(ProtocolError::kSerializationFailed);
+  }
+}
 
-    return buffer;
+auto Protocol::SerializeHeartbeat(const HeartbeatMessage& msg, std::span<uint8_t> out)
+    -> std::expected<size_t, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    FillHeartbeat(msg, *proto_cmd);
+    return WriteTo(*proto_cmd, out);
   } catch (...) {
     return std::unexpected(ProtocolError::kSerializationFailed);
   }
@@ -207,18 +360,19 @@ auto Protocol::SerializeHeartbeat(const HeartbeatMessage& msg) -> std::expected<
 
 auto Protocol::DeserializeHeartbeat(std::span<const uint8_t> data) -> std::expected<HeartbeatMessage, ProtocolError> {
   try {
-    app::Command proto_cmd;
-    if (!proto_cmd.ParseFromArray(data.data(), static_cast<int>(data.size()))) {
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    if (!Parse(*proto_cmd, data)) {
       return std::unexpected(ProtocolError::kDeserializationFailed);
     }
 
-    if (proto_cmd.type() != app::COMMAND_TYPE_PING) {
+    if (proto_cmd->type() != app::COMMAND_TYPE_PING) {
       return std::unexpected(ProtocolError::kInvalidMessage);
     }
 
     HeartbeatMessage msg;
-    msg.sequence = proto_cmd.id();
-    msg.timestamp_ms = proto_cmd.timestamp_ms();
+    msg.sequence = proto_cmd->id();
+    msg.timestamp_ms = proto_cmd->timestamp_ms();
 
     return msg;
   } catch (...) {
@@ -226,53 +380,159 @@ auto Protocol::DeserializeHeartbeat(std::span<const uint8_t> data) -> std::expec
   }
 }
 
-auto Protocol::SerializeCalibrate() -> std::expected<std::vector<uint8_t>, ProtocolError> {
+auto Protocol::SerializeCalibrate(uint32_t command_id) -> std::expected<std::vector<uint8_t>, ProtocolError> {
   try {
-    app::Command proto_cmd;
-    proto_cmd.set_type(app::COMMAND_TYPE_CALIBRATE);
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    FillCalibrate(*proto_cmd, command_id);
+    return ToVector(*proto_cmd);
+  } catch (...) {
+    return std::unexpected(ProtocolError::kSerializationFailed);
+  }
+}
 
-    auto* calibrate = proto_cmd.mutable_calibrate();
-    calibrate->set_mode(app::CalibrateCommand_Mode_MODE_FULL);
+auto Protocol::SerializeCalibrate(std::span<uint8_t> out, uint32_t command_id)
+    -> std::expected<size_t, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    FillCalibrate(*proto_cmd, command_id);
+    return WriteTo(*proto_cmd, out);
+  } catch (...) {
+    return std::unexpected(ProtocolError::kSerializationFailed);
+  }
+}
 
-    const size_t size = proto_cmd.ByteSizeLong();
-    std::vector<uint8_t> buffer(size);
+auto Protocol::SerializeHome(uint32_t command_id) -> std::expected<std::vector<uint8_t>, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    FillHome(*proto_cmd, command_id);
+    return ToVector(*proto_cmd);
+  } catch (...) {
+    return std::unexpected(ProtocolError::kSerializationFailed);
+  }
+}
 
-    if (!proto_cmd.SerializeToArray(buffer.data(), static_cast<int>(size))) {
-      return std::unexpected(ProtocolError::kSerializationFailed);
-    }
+auto Protocol::SerializeHome(std::span<uint8_t> out, uint32_t command_id)
+    -> std::expected<size_t, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    FillHome(*proto_cmd, command_id);
+    return WriteTo(*proto_cmd, out);
+  } catch (...) {
+    return std::unexpected(ProtocolError::kSerializationFailed);
+  }
+}
 
-    return buffer;
+auto Protocol::SerializeGetStatus(uint32_t command_id) -> std::expected<std::vector<uint8_t>, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    FillGetStatus(*proto_cmd, command_id);
+    return ToVector(*proto_cmd);
   } catch (...) {
     return std::unexpected(ProtocolError::kSerializationFailed);
   }
 }
 
-auto Protocol::SerializeHome() -> std::expected<std::vector<uint8_t>, ProtocolError> {
+auto Protocol::SerializeGetStatus(std::span<uint8_t> out, uint32_t command_id)
+    -> std::expected<size_t, ProtocolError> {
   try {
-    app::Command proto_cmd;
-    proto_cmd.set_type(app::COMMAND_TYPE_HOME);
+    MessageArena arena;
+    auto* proto_cmd = arena.Create<app::Command>();
+    FillGetStatus(*proto_cmd, command_id);
+    return WriteTo(*proto_cmd, out);
+  } catch (...) {
+    return std::unexpected(ProtocolError::kSerializationFailed);
+  }
+}
 
-    const size_t size = proto_cmd.ByteSizeLong();
-    std::vector<uint8_t> buffer(size);
+auto Protocol::SerializeHandshake(const HandshakeMessage& msg) -> std::expected<std::vector<uint8_t>, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_msg = arena.Create<app::Handshake>();
+    proto_msg->set_protocol_version(msg.protocol_version);
+    proto_msg->set_client_id(msg.client_id);
+    for (const auto& feature : msg.features) {
+      proto_msg->add_features(feature);
+    }
+    return ToVector(*proto_msg);
+  } catch (...) {
+    return std::unexpected(ProtocolError::kSerializationFailed);
+  }
+}
 
-    if (!proto_cmd.SerializeToArray(buffer.data(), static_cast<int>(size))) {
-      return std::unexpected(ProtocolError::kSerializationFailed);
+auto Protocol::DeserializeHandshake(std::span<const uint8_t> data) -> std::expected<HandshakeMessage, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_msg = arena.Create<app::Handshake>();
+    if (!Parse(*proto_msg, data)) {
+      return std::unexpected(ProtocolError::kDeserializationFailed);
     }
 
-    return buffer;
+    HandshakeMessage msg;
+    msg.protocol_version = proto_msg->protocol_version();
+    msg.client_id = proto_msg->client_id();
+    msg.features.assign(proto_msg->features().begin(), proto_msg->features().end());
+    return msg;
+  } catch (...) {
+    return std::unexpected(ProtocolError::kDeserializationFailed);
+  }
+}
+
+auto Protocol::SerializeHandshakeResponse(const HandshakeResponseMessage& msg)
+    -> std::expected<std::vector<uint8_t>, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_msg = arena.Create<app::HandshakeResponse>();
+    proto_msg->set_protocol_version(msg.protocol_version);
+    proto_msg->set_device_id(msg.device_id);
+    proto_msg->set_firmware_version(msg.firmware_version);
+    for (const auto& feature : msg.supported_features) {
+      proto_msg->add_supported_features(feature);
+    }
+    proto_msg->set_accepted(msg.accepted);
+    proto_msg->set_rejection_reason(msg.rejection_reason);
+    return ToVector(*proto_msg);
   } catch (...) {
     return std::unexpected(ProtocolError::kSerializationFailed);
   }
 }
 
+auto Protocol::DeserializeHandshakeResponse(std::span<const uint8_t> data)
+    -> std::expected<HandshakeResponseMessage, ProtocolError> {
+  try {
+    MessageArena arena;
+    auto* proto_msg = arena.Create<app::HandshakeResponse>();
+    if (!Parse(*proto_msg, data)) {
+      return std::unexpected(ProtocolError::kDeserializationFailed);
+    }
+
+    HandshakeResponseMessage msg;
+    msg.protocol_version = proto_msg->protocol_version();
+    msg.device_id = proto_msg->device_id();
+    msg.firmware_version = proto_msg->firmware_version();
+    msg.supported_features.assign(proto_msg->supported_features().begin(), proto_msg->supported_features().end());
+    msg.accepted = proto_msg->accepted();
+    msg.rejection_reason = proto_msg->rejection_reason();
+    return msg;
+  } catch (...) {
+    return std::unexpected(ProtocolError::kDeserializationFailed);
+  }
+}
+
 auto Protocol::DetectMessageType(std::span<const uint8_t> data) -> MessageType {
+  MessageArena arena;
+
   // Try to parse as Command first
   {
-    app::Command proto_cmd;
-    if (proto_cmd.ParseFromArray(data.data(), static_cast<int>(data.size()))) {
-      switch (proto_cmd.type()) {
+    auto* proto_cmd = arena.Create<app::Command>();
+    if (Parse(*proto_cmd, data)) {
+      switch (proto_cmd->type()) {
         case app::COMMAND_TYPE_MOVE:
-          if (proto_cmd.has_move() && proto_cmd.move().use_face_tracking()) {
+          if (proto_cmd->has_move() && proto_cmd->move().use_face_tracking()) {
             return MessageType::kFaceData;
           }
           return MessageType::kServoCommand;
@@ -290,9 +550,9 @@ auto Protocol::DetectMessageType(std::span<const uint8_t> data) -> MessageType {
 
   // Try to parse as Response
   {
-    app::Response proto_resp;
-    if (proto_resp.ParseFromArray(data.data(), static_cast<int>(data.size()))) {
-      if (proto_resp.has_device_status()) {
+    auto* proto_resp = arena.Create<app::Response>();
+    if (Parse(*proto_resp, data)) {
+      if (proto_resp->has_device_status()) {
         return MessageType::kStatus;
       }
     }
@@ -0,0 +1,24 @@
+#include <client/comm/reconnect_backoff.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace client::comm {
+
+std::chrono::milliseconds ReconnectBackoff::NominalDelay() const noexcept {
+  // Doubling past 2^16 would overflow long before it matters; kMaxDelay caps it much sooner
+  const uint32_t doublings = std::min(attempts_, 16U);
+  return std::min(kInitialDelay * (int64_t{1} << doublings), kMaxDelay);
+}
+
+std::chrono::milliseconds ReconnectBackoff::NextDelay() noexcept {
+  const auto nominal = NominalDelay().count();
+  ++attempts_;
+
+  std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(nominal / 2, nominal);
+  return std::chrono::milliseconds(jitter(generator_));
+}
+
+}  // namespace client::comm
@@ -0,0 +1,61 @@
+#include <client/comm/response_dispatcher.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <mutex>
+#include <span>
+#include <utility>
+
+namespace client::comm {
+
+void ResponseDispatcher::Expect(uint32_t command_id, ResponseHandler handler) {
+  std::scoped_lock lock(mutex_);
+  pending_.insert_or_assign(command_id, std::move(handler));
+}
+
+bool ResponseDispatcher::Cancel(uint32_t command_id) {
+  std::scoped_lock lock(mutex_);
+  return pending_.erase(command_id) != 0;
+}
+
+void ResponseDispatcher::Clear() {
+  std::scoped_lock lock(mutex_);
+  pending_.clear();
+}
+
+auto ResponseDispatcher::Dispatch(std::span<const uint8_t> payload, std::chrono::steady_clock::time_point received_at)
+    -> std::expected<void, ProtocolError> {
+  auto response = Protocol::DeserializeStatus(payload);
+  if (!response) {
+    return std::unexpected(response.error());
+  }
+
+  shadow_.Update(*response, received_at);
+
+  ResponseHandler handler;
+  if (response->command_id != 0) {
+    std::scoped_lock lock(mutex_);
+    if (const auto it = pending_.find(response->command_id); it != pending_.end()) {
+      handler = std::move(it->second);
+      pending_.erase(it);
+    }
+  }
+
+  // Handlers run outside the lock so they may call Expect() or Cancel()
+  if (handler) {
+    handler(*response);
+  } else if (default_handler_) {
+    default_handler_(*response);
+  }
+
+  return {};
+}
+
+size_t ResponseDispatcher::Pending() const {
+  std::scoped_lock lock(mutex_);
+  return pending_.size();
+}
+
+}  // namespace client::comm
@@ -0,0 +1,57 @@
+#include <client/comm/retransmit_queue.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace client::comm {
+
+bool RetransmitQueue::Track(uint32_t command_id, std::span<const uint8_t> frame,
+                            std::chrono::steady_clock::time_point sent_at, std::chrono::milliseconds timeout) {
+  if (command_id == 0) {
+    return false;
+  }
+
+  auto it = std::ranges::find(entries_, command_id, &Entry::command_id);
+  if (it == entries_.end()) {
+    it = std::ranges::find(entries_, uint32_t{0}, &Entry::command_id);
+  }
+  if (it == entries_.end()) {
+    return false;
+  }
+
+  it->command_id = command_id;
+  it->attempts = 1;
+  it->timeout = std::min(timeout, kMaxTimeout);
+  it->deadline = sent_at + it->timeout;
+  it->frame.assign(frame.begin(), frame.end());
+  return true;
+}
+
+bool RetransmitQueue::Acknowledge(uint32_t command_id) {
+  if (command_id == 0) {
+    return false;
+  }
+
+  const auto it = std::ranges::find(entries_, command_id, &Entry::command_id);
+  if (it == entries_.end()) {
+    return false;
+  }
+
+  *it = Entry{};
+  return true;
+}
+
+void RetransmitQueue::Clear() noexcept {
+  for (auto& entry : entries_) {
+    entry = Entry{};
+  }
+}
+
+size_t RetransmitQueue::Pending() const noexcept {
+  return static_cast<size_t>(std::ranges::count_if(entries_, [](const Entry& e) { return e.command_id != 0; }));
+}
+
+}  // namespace client::comm
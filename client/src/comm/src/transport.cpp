@@ -0,0 +1,665 @@
+#include <client/comm/transport.hpp>
+
+#include <client/core/logger.hpp>
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#if defined(CLIENT_COMM_HAS_NETWORK) || defined(CLIENT_COMM_HAS_SERIALPORT) || defined(CLIENT_COMM_HAS_BLUETOOTH)
+#include <QByteArray>
+#include <QIODevice>
+#include <QObject>
+#include <QString>
+#endif
+
+#ifdef CLIENT_COMM_HAS_NETWORK
+#include <QAbstractSocket>
+#include <QNetworkDatagram>
+#include <QRandomGenerator>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUdpSocket>
+#endif
+
+#ifdef CLIENT_COMM_HAS_SERIALPORT
+#include <QSerialPort>
+#endif
+
+#ifdef CLIENT_COMM_HAS_BLUETOOTH
+#include <QBluetoothAddress>
+#include <QBluetoothServiceInfo>
+#include <QBluetoothSocket>
+#include <QBluetoothUuid>
+#endif
+
+namespace client::comm {
+
+namespace {
+
+/// Separates the scheme from the address in a transport URI.
+constexpr std::string_view kSchemeSeparator = "://";
+
+/// Baud rate used when a serial address does not name one.
+[[maybe_unused]] constexpr int32_t kDefaultBaudRate = 115200;
+
+struct HostPort {
+  std::string_view host;
+  uint16_t port = 0;
+};
+
+template <typename T>
+[[nodiscard]] std::optional<T> ParseNumber(std::string_view text) noexcept {
+  T value{};
+  const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (ec != std::errc{} || end != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+/// Splits "host:port" or "[v6-host]:port".
+[[nodiscard]] std::optional<HostPort> SplitHostPort(std::string_view address) noexcept {
+  const size_t colon = address.rfind(':');
+  if (colon == std::string_view::npos || colon == 0) {
+    return std::nullopt;
+  }
+
+  std::string_view host = address.substr(0, colon);
+  if (host.size() >= 2 && host.front() == '[' && host.back() == ']') {
+    host = host.substr(1, host.size() - 2);
+  }
+
+  const auto port = ParseNumber<uint16_t>(address.substr(colon + 1));
+  if (host.empty() || !port || *port == 0) {
+    return std::nullopt;
+  }
+  return HostPort{.host = host, .port = *port};
+}
+
+struct SerialAddress {
+  std::string_view port;
+  int32_t baud_rate = 0;
+};
+
+/// Splits "port[@baud]".
+[[nodiscard]] std::optional<SerialAddress> SplitSerialAddress(std::string_view address) noexcept {
+  const size_t at = address.rfind('@');
+  if (at == std::string_view::npos) {
+    return address.empty() ? std::nullopt : std::optional(SerialAddress{.port = address, .baud_rate = 0});
+  }
+
+  const auto baud_rate = ParseNumber<int32_t>(address.substr(at + 1));
+  if (at == 0 || !baud_rate || *baud_rate <= 0) {
+    return std::nullopt;
+  }
+  return SerialAddress{.port = address.substr(0, at), .baud_rate = *baud_rate};
+}
+
+/// Highest RFCOMM server channel.
+constexpr uint16_t kMaxRfcommChannel = 30;
+
+struct BluetoothAddress {
+  std::string_view device;
+  uint16_t channel = 0;  ///< RFCOMM channel, or 0 to look the SPP service up over SDP.
+};
+
+/// Splits "device[#channel]".
+[[nodiscard]] std::optional<BluetoothAddress> SplitBluetoothAddress(std::string_view address) noexcept {
+  const size_t hash = address.rfind('#');
+  if (hash == std::string_view::npos) {
+    return address.empty() ? std::nullopt : std::optional(BluetoothAddress{.device = address, .channel = 0});
+  }
+
+  const auto channel = ParseNumber<uint16_t>(address.substr(hash + 1));
+  if (hash == 0 || !channel || *channel == 0 || *channel > kMaxRfcommChannel) {
+    return std::nullopt;
+  }
+  return BluetoothAddress{.device = address.substr(0, hash), .channel = *channel};
+}
+
+#if defined(CLIENT_COMM_HAS_NETWORK) || defined(CLIENT_COMM_HAS_SERIALPORT) || defined(CLIENT_COMM_HAS_BLUETOOTH)
+
+[[nodiscard]] QString ToQString(std::string_view text) {
+  return QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+}
+
+[[nodiscard]] std::span<const uint8_t> AsBytes(const QByteArray& data) noexcept {
+  return {std::bit_cast<const uint8_t*>(data.constData()), static_cast<size_t>(data.size())};
+}
+
+/**
+ * @brief Shared plumbing for backends built on a Qt I/O device.
+ * @details Owns the device, forwards readyRead and bytesWritten, and implements Write() and
+ * Backlog() on top of the device's own write buffer.
+ */
+class QtDeviceTransport : public ITransport {
+public:
+  QtDeviceTransport(const QtDeviceTransport&) = delete;
+  QtDeviceTransport(QtDeviceTransport&&) = delete;
+  ~QtDeviceTransport() override {
+    // The device may emit signals while it is torn down, after the derived transport is gone
+    if (device_) {
+      QObject::disconnect(device_.get(), nullptr, nullptr, nullptr);
+    }
+  }
+
+  QtDeviceTransport& operator=(const QtDeviceTransport&) = delete;
+  QtDeviceTransport& operator=(QtDeviceTransport&&) = delete;
+
+  auto Write(std::span<const uint8_t> data) -> std::expected<size_t, TransportError> override {
+    if (State() != TransportState::kOpen || !device_) {
+      return std::unexpected(TransportError::kNotOpen);
+    }
+
+    const auto written = device_->write(std::bit_cast<const char*>(data.data()), static_cast<qint64>(data.size()));
+    if (written < 0) {
+      RecordWriteError(device_->errorString().toStdString());
+      return std::unexpected(TransportError::kWriteFailed);
+    }
+
+    RecordWrite(static_cast<size_t>(written));
+    return static_cast<size_t>(written);
+  }
+
+  [[nodiscard]] size_t Backlog() const noexcept override {
+    return device_ ? static_cast<size_t>(device_->bytesToWrite()) : 0;
+  }
+
+protected:
+  QtDeviceTransport() = default;
+
+  /**
+   * @brief Takes ownership of a device and forwards its data and drain signals.
+   * @param device Device to adopt, replacing any previous one
+   */
+  void Adopt(std::unique_ptr<QIODevice> device) {
+    if (device_) {
+      QObject::disconnect(device_.get(), nullptr, nullptr, nullptr);
+    }
+    device_ = std::move(device);
+    QObject::connect(device_.get(), &QIODevice::readyRead, device_.get(), [this] { OnReadyRead(); });
+    QObject::connect(device_.get(), &QIODevice::bytesWritten, device_.get(),
+                     [this]([[maybe_unused]] qint64 bytes) { NotifyWritable(); });
+  }
+
+  /**
+   * @brief Reads everything available and delivers it.
+   */
+  virtual void OnReadyRead() {
+    const QByteArray data = device_->readAll();
+    if (!data.isEmpty()) {
+      Deliver(AsBytes(data));
+    }
+  }
+
+  std::unique_ptr<QIODevice> device_;
+};
+
+#endif
+
+#ifdef CLIENT_COMM_HAS_NETWORK
+
+/**
+ * @brief TCP and UDP backends.
+ * @details TCP disables Nagle's algorithm, since every frame is latency-sensitive and the
+ * CommandScheduler already avoids small-write storms. UDP uses a connected socket, so datagrams
+ * from anyone else are dropped by the OS, and sends each Write() (one frame) as one datagram
+ * through a DatagramChannel: compact control frames latest-wins, everything else reliably.
+ */
+class SocketTransport final : public QtDeviceTransport {
+public:
+  /// How often overdue reliable datagrams are looked for; well below DatagramChannel::kInitialTimeout.
+  static constexpr std::chrono::milliseconds kRetransmitPollInterval{10};
+
+  explicit SocketTransport(TransportKind kind) : kind_(kind) {
+    retransmit_timer_.setInterval(kRetransmitPollInterval);
+    QObject::connect(&retransmit_timer_, &QTimer::timeout, &retransmit_timer_, [this] {
+      channel_.PollRetransmits(std::chrono::steady_clock::now(), std::bind_front(&SocketTransport::SendDatagram, this));
+    });
+  }
+
+  [[nodiscard]] TransportKind Kind() const noexcept override { return kind_; }
+
+  auto Open(std::string_view address) -> std::expected<void, TransportError> override {
+    if (State() != TransportState::kClosed) {
+      return std::unexpected(TransportError::kAlreadyOpen);
+    }
+
+    const auto host_port = SplitHostPort(address);
+    if (!host_port) {
+      return std::unexpected(TransportError::kInvalidAddress);
+    }
+
+    std::unique_ptr<QAbstractSocket> socket;
+    if (kind_ == TransportKind::kTcp) {
+      socket = std::make_unique<QTcpSocket>();
+    } else {
+      socket = std::make_unique<QUdpSocket>();
+    }
+    socket_ = socket.get();
+
+    QObject::connect(socket_, &QAbstractSocket::connected, socket_, [this] {
+      if (kind_ == TransportKind::kTcp) {
+        socket_->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+      } else {
+        // A fresh session byte tells the device to drop sequence state from an earlier connection
+        channel_.Reset(static_cast<uint8_t>(QRandomGenerator::global()->bounded(1, 256)));
+        retransmit_timer_.start();
+      }
+      SetState(TransportState::kOpen);
+    });
+    QObject::connect(socket_, &QAbstractSocket::disconnected, socket_, [this] {
+      retransmit_timer_.stop();
+      SetState(TransportState::kClosed);
+    });
+    QObject::connect(socket_, &QAbstractSocket::errorOccurred, socket_,
+                     [this](QAbstractSocket::SocketError error) { OnError(error); });
+    Adopt(std::move(socket));
+
+    SetState(TransportState::kOpening);
+    socket_->connectToHost(ToQString(host_port->host), host_port->port);
+    return {};
+  }
+
+  void Close() override {
+    if (!socket_) {
+      return;
+    }
+
+    retransmit_timer_.stop();
+    socket_->disconnectFromHost();
+    // A socket that never connected goes straight to unconnected without emitting disconnected
+    if (socket_->state() == QAbstractSocket::UnconnectedState) {
+      SetState(TransportState::kClosed);
+    }
+  }
+
+  auto Write(std::span<const uint8_t> data) -> std::expected<size_t, TransportError> override {
+    if (kind_ != TransportKind::kUdp) {
+      return QtDeviceTransport::Write(data);
+    }
+    if (State() != TransportState::kOpen || !socket_) {
+      return std::unexpected(TransportError::kNotOpen);
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto send = std::bind_front(&SocketTransport::SendDatagram, this);
+    const bool accepted = ClassifyFrame(data) == DatagramKind::kLatest ? channel_.SendLatest(data, now, send)
+                                                                       : channel_.SendReliable(data, now, send);
+    if (!accepted) {
+      RecordWriteError("Too many reliable datagrams awaiting acknowledgement");
+      return std::unexpected(TransportError::kWriteFailed);
+    }
+
+    RecordWrite(data.size());
+    return data.size();
+  }
+
+  [[nodiscard]] std::optional<DatagramStats> DatagramStatistics() const override {
+    if (kind_ != TransportKind::kUdp) {
+      return std::nullopt;
+    }
+    return channel_.Stats();
+  }
+
+protected:
+  void OnReadyRead() override {
+    if (kind_ != TransportKind::kUdp) {
+      QtDeviceTransport::OnReadyRead();
+      return;
+    }
+
+    auto* udp = static_cast<QUdpSocket*>(socket_);
+    const auto deliver = [this](std::span<const uint8_t> frame) { Deliver(frame); };
+    const auto send = std::bind_front(&SocketTransport::SendDatagram, this);
+    while (udp->hasPendingDatagrams()) {
+      const QByteArray data = udp->receiveDatagram().data();
+      const auto result = channel_.Receive(AsBytes(data), std::chrono::steady_clock::now(), deliver, send);
+      if (!result) {
+        CLIENT_WARN("Dropping malformed {} byte datagram from device", data.size());
+      }
+    }
+  }
+
+private:
+  /// Hands a datagram to the connected socket; a lost datagram is the channel's to recover.
+  void SendDatagram(std::span<const uint8_t> datagram) {
+    if (socket_->write(std::bit_cast<const char*>(datagram.data()), static_cast<qint64>(datagram.size())) < 0) {
+      RecordWriteError(socket_->errorString().toStdString());
+    }
+  }
+
+  void OnError(QAbstractSocket::SocketError error) {
+    const std::string message = socket_->errorString().toStdString();
+    if (State() == TransportState::kOpening) {
+      SetState(TransportState::kClosed, TransportError::kOpenFailed, message);
+      return;
+    }
+
+    // A lost datagram or an ICMP "port unreachable" does not end a UDP link; retransmission covers it
+    if (kind_ == TransportKind::kUdp) {
+      CLIENT_WARN("UDP link error: {}", message);
+      return;
+    }
+
+    if (error == QAbstractSocket::RemoteHostClosedError || State() == TransportState::kOpen) {
+      SetState(TransportState::kClosed, TransportError::kConnectionLost, message);
+    }
+  }
+
+  TransportKind kind_;
+  QAbstractSocket* socket_ = nullptr;
+  DatagramChannel channel_;
+  QTimer retransmit_timer_;
+};
+
+#endif  // CLIENT_COMM_HAS_NETWORK
+
+#ifdef CLIENT_COMM_HAS_SERIALPORT
+
+/**
+ * @brief USB-serial and pty backend (8N1, no flow control).
+ */
+class SerialTransport final : public QtDeviceTransport {
+public:
+  [[nodiscard]] TransportKind Kind() const noexcept override { return TransportKind::kSerial; }
+
+  auto Open(std::string_view address) -> std::expected<void, TransportError> override {
+    if (State() != TransportState::kClosed) {
+      return std::unexpected(TransportError::kAlreadyOpen);
+    }
+
+    const auto serial_address = SplitSerialAddress(address);
+    if (!serial_address) {
+      return std::unexpected(TransportError::kInvalidAddress);
+    }
+
+    auto port = std::make_unique<QSerialPort>();
+    port->setPortName(ToQString(serial_address->port));
+    port->setBaudRate(serial_address->baud_rate != 0 ? serial_address->baud_rate : kDefaultBaudRate);
+    port->setDataBits(QSerialPort::Data8);
+    port->setParity(QSerialPort::NoParity);
+    port->setStopBits(QSerialPort::OneStop);
+    port->setFlowControl(QSerialPort::NoFlowControl);
+    port_ = port.get();
+
+    if (!port_->open(QIODevice::ReadWrite)) {
+      // Opening is synchronous, so the failure is returned rather than reported as a state change
+      SetState(TransportState::kClosed, TransportError::kOpenFailed, port_->errorString().toStdString());
+      port_ = nullptr;
+      return std::unexpected(TransportError::kOpenFailed);
+    }
+
+    QObject::connect(port_, &QSerialPort::errorOccurred, port_,
+                     [this](QSerialPort::SerialPortError error) { OnError(error); });
+    Adopt(std::move(port));
+    SetState(TransportState::kOpen);
+    return {};
+  }
+
+  void Close() override {
+    if (port_ && port_->isOpen()) {
+      port_->close();
+    }
+    SetState(TransportState::kClosed);
+  }
+
+private:
+  void OnError(QSerialPort::SerialPortError error) {
+    if (error == QSerialPort::NoError) {
+      return;
+    }
+
+    // ResourceError is how an unplugged adapter shows up
+    if (error == QSerialPort::ResourceError) {
+      const std::string message = port_->errorString().toStdString();
+      port_->close();
+      SetState(TransportState::kClosed, TransportError::kConnectionLost, message);
+      return;
+    }
+
+    CLIENT_WARN("Serial link error: {}", port_->errorString().toStdString());
+  }
+
+  QSerialPort* port_ = nullptr;
+};
+
+#endif  // CLIENT_COMM_HAS_SERIALPORT
+
+#ifdef CLIENT_COMM_HAS_BLUETOOTH
+
+/// ESP32 SPP UUID for serial communication.
+constexpr const char* kSerialPortServiceUuid = "00001101-0000-1000-8000-00805F9B34FB";
+
+/**
+ * @brief Bluetooth Classic SPP backend over an RFCOMM socket.
+ */
+class BluetoothTransport final : public QtDeviceTransport {
+public:
+  BluetoothTransport() = default;
+  BluetoothTransport(const BluetoothTransport&) = delete;
+  BluetoothTransport(BluetoothTransport&&) = delete;
+  ~BluetoothTransport() override {
+    if (socket_ && socket_->state() == QBluetoothSocket::SocketState::ConnectedState) {
+      socket_->disconnectFromService();
+    }
+  }
+
+  BluetoothTransport& operator=(const BluetoothTransport&) = delete;
+  BluetoothTransport& operator=(BluetoothTransport&&) = delete;
+
+  [[nodiscard]] TransportKind Kind() const noexcept override { return TransportKind::kBluetooth; }
+
+  auto Open(std::string_view address) -> std::expected<void, TransportError> override {
+    if (State() != TransportState::kClosed) {
+      return std::unexpected(TransportError::kAlreadyOpen);
+    }
+
+    const auto bluetooth_address = SplitBluetoothAddress(address);
+    if (!bluetooth_address) {
+      return std::unexpected(TransportError::kInvalidAddress);
+    }
+    const QBluetoothAddress bt_address(ToQString(bluetooth_address->device));
+    if (bt_address.isNull()) {
+      return std::unexpected(TransportError::kInvalidAddress);
+    }
+
+    if (bluetooth_address->channel != 0) {
+      CLIENT_INFO("Attempting to connect to Bluetooth device: {} on RFCOMM channel {}", bluetooth_address->device,
+                  bluetooth_address->channel);
+    } else {
+      CLIENT_INFO("Attempting to connect to Bluetooth device: {} using SPP service UUID: {}", address,
+                  kSerialPortServiceUuid);
+    }
+
+    auto socket = std::make_unique<QBluetoothSocket>(QBluetoothServiceInfo::RfcommProtocol);
+    socket_ = socket.get();
+    QObject::connect(socket_, &QBluetoothSocket::connected, socket_, [this] { SetState(TransportState::kOpen); });
+    QObject::connect(socket_, &QBluetoothSocket::disconnected, socket_, [this] { SetState(TransportState::kClosed); });
+    QObject::connect(socket_, &QBluetoothSocket::errorOccurred, socket_,
+                     [this](QBluetoothSocket::SocketError error) { OnError(error); });
+    Adopt(std::move(socket));
+
+    SetState(TransportState::kOpening);
+    if (bluetooth_address->channel != 0) {
+      // A known channel skips the SDP service lookup, which costs a second or more per connect
+      socket_->connectToService(bt_address, bluetooth_address->channel);
+    } else {
+      socket_->connectToService(bt_address, QBluetoothUuid(QString::fromLatin1(kSerialPortServiceUuid)));
+    }
+    return {};
+  }
+
+  void Close() override {
+    if (!socket_) {
+      return;
+    }
+
+    socket_->disconnectFromService();
+    if (socket_->state() == QBluetoothSocket::SocketState::UnconnectedState) {
+      SetState(TransportState::kClosed);
+    }
+  }
+
+  [[nodiscard]] std::string ResolvedAddress() const override {
+    if (!socket_ || State() != TransportState::kOpen || socket_->peerPort() == 0) {
+      return {};
+    }
+    return std::format("{}#{}", socket_->peerAddress().toString().toStdString(), socket_->peerPort());
+  }
+
+private:
+  void OnError(QBluetoothSocket::SocketError error) {
+    std::string message;
+    switch (error) {
+      case QBluetoothSocket::SocketError::NoSocketError:
+        return;
+      case QBluetoothSocket::SocketError::UnknownSocketError:
+        message = "Unknown socket error";
+        break;
+      case QBluetoothSocket::SocketError::HostNotFoundError:
+        message = "Device not found";
+        break;
+      case QBluetoothSocket::SocketError::ServiceNotFoundError:
+        message = "Service not found on device";
+        break;
+      case QBluetoothSocket::SocketError::NetworkError:
+        message = "Network error";
+        break;
+      case QBluetoothSocket::SocketError::UnsupportedProtocolError:
+        message = "Unsupported protocol";
+        break;
+      case QBluetoothSocket::SocketError::OperationError:
+        message = "Operation error";
+        break;
+      case QBluetoothSocket::SocketError::RemoteHostClosedError:
+        message = "Connection closed by remote device";
+        break;
+      default:
+        message = socket_->errorString().toStdString();
+        break;
+    }
+
+    CLIENT_ERROR("Bluetooth socket error: {} (socket state: {}, error code: {})", message,
+                 static_cast<int>(socket_->state()), static_cast<int>(error));
+    SetState(TransportState::kClosed,
+             State() == TransportState::kOpening ? TransportError::kOpenFailed : TransportError::kConnectionLost,
+             message);
+  }
+
+  QBluetoothSocket* socket_ = nullptr;
+};
+
+#endif  // CLIENT_COMM_HAS_BLUETOOTH
+
+}  // namespace
+
+void ITransport::SetState(TransportState state, TransportError error, std::string_view message) {
+  if (!message.empty()) {
+    last_error_ = std::string(message);
+  }
+
+  if (state_ == state) {
+    return;
+  }
+
+  state_ = state;
+  if (state_callback_) {
+    state_callback_(state, error);
+  }
+}
+
+void ITransport::Deliver(std::span<const uint8_t> data) {
+  stats_.bytes_received += data.size();
+  if (receive_callback_) {
+    receive_callback_(data);
+  }
+}
+
+void ITransport::NotifyWritable() {
+  if (writable_callback_) {
+    writable_callback_();
+  }
+}
+
+void ITransport::RecordWrite(size_t bytes) noexcept {
+  stats_.bytes_sent += bytes;
+  ++stats_.writes;
+}
+
+void ITransport::RecordWriteError(std::string_view message) {
+  ++stats_.write_errors;
+  last_error_ = std::string(message);
+}
+
+auto ParseTransportEndpoint(std::string_view uri) -> std::expected<TransportEndpoint, TransportError> {
+  const size_t separator = uri.find(kSchemeSeparator);
+  if (separator == std::string_view::npos) {
+    // A bare address is a Bluetooth MAC address (or UUID on Apple platforms), as before transports existed
+    if (!SplitBluetoothAddress(uri)) {
+      return std::unexpected(TransportError::kInvalidAddress);
+    }
+    return TransportEndpoint{.kind = TransportKind::kBluetooth, .address = std::string(uri)};
+  }
+
+  const std::string_view scheme = uri.substr(0, separator);
+  const std::string_view address = uri.substr(separator + kSchemeSeparator.size());
+
+  constexpr std::array kAddressableKinds = {TransportKind::kBluetooth, TransportKind::kTcp, TransportKind::kUdp,
+                                            TransportKind::kSerial};
+  for (const auto kind : kAddressableKinds) {
+    if (scheme != TransportKindToString(kind)) {
+      continue;
+    }
+
+    bool valid = !address.empty();
+    if (kind == TransportKind::kBluetooth) {
+      valid = SplitBluetoothAddress(address).has_value();
+    } else if (kind == TransportKind::kTcp || kind == TransportKind::kUdp) {
+      valid = SplitHostPort(address).has_value();
+    } else if (kind == TransportKind::kSerial) {
+      valid = SplitSerialAddress(address).has_value();
+    }
+    if (!valid) {
+      return std::unexpected(TransportError::kInvalidAddress);
+    }
+    return TransportEndpoint{.kind = kind, .address = std::string(address)};
+  }
+
+  return std::unexpected(TransportError::kInvalidAddress);
+}
+
+auto CreateTransport(TransportKind kind) -> std::expected<std::unique_ptr<ITransport>, TransportError> {
+  switch (kind) {
+#ifdef CLIENT_COMM_HAS_BLUETOOTH
+    case TransportKind::kBluetooth:
+      return std::make_unique<BluetoothTransport>();
+#endif
+#ifdef CLIENT_COMM_HAS_NETWORK
+    case TransportKind::kTcp:
+    case TransportKind::kUdp:
+      return std::make_unique<SocketTransport>(kind);
+#endif
+#ifdef CLIENT_COMM_HAS_SERIALPORT
+    case TransportKind::kSerial:
+      return std::make_unique<SerialTransport>();
+#endif
+    default:
+      return std::unexpected(TransportError::kNotSupported);
+  }
+}
+
+}  // namespace client::comm
@@ -0,0 +1,349 @@
+#pragma once
+
+#include <client/core/pch.hpp>
+
+#include <client/core/utils/latency_histogram.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace client::metrics {
+
+/**
+ * @brief Error codes for metrics registration.
+ */
+enum class MetricsError : uint8_t {
+  kInvalidName,    ///< Name is not a valid Prometheus metric name.
+  kDuplicateName,  ///< A metric with the same name is already registered.
+};
+
+/**
+ * @brief Converts MetricsError to a human-readable string.
+ * @param error The error to convert
+ * @return A string view representing the error
+ */
+[[nodiscard]] constexpr std::string_view MetricsErrorToString(MetricsError error) noexcept {
+  switch (error) {
+    case MetricsError::kInvalidName:
+      return "Invalid metric name";
+    case MetricsError::kDuplicateName:
+      return "Duplicate metric name";
+    default:
+      return "Unknown error";
+  }
+}
+
+/// Number of per-thread shards used by Counter and Histogram.
+inline constexpr size_t kShardCount = 8;
+
+/**
+ * @brief Gets the shard assigned to the calling thread.
+ * @details Threads are assigned shards round-robin on first use, so up to kShardCount
+ * writers never touch the same cache line.
+ * @return Shard index in range [0, kShardCount)
+ */
+[[nodiscard]] size_t ThreadShard() noexcept;
+
+/**
+ * @brief Monotonically increasing counter sharded per thread.
+ * @details Increment is a single relaxed atomic add on the calling thread's shard.
+ * Value() sums all shards and may miss increments that happen concurrently.
+ */
+class Counter {
+public:
+  Counter() noexcept = default;
+  Counter(const Counter&) = delete;
+  Counter(Counter&&) = delete;
+  ~Counter() noexcept = default;
+
+  Counter& operator=(const Counter&) = delete;
+  Counter& operator=(Counter&&) = delete;
+
+  /**
+   * @brief Adds to the counter.
+   * @param delta Amount to add
+   */
+  void Increment(uint64_t delta = 1) noexcept {
+    shards_[ThreadShard()].value.fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the current value.
+   * @return Sum of all shards
+   */
+  [[nodiscard]] uint64_t Value() const noexcept {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+      total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  /**
+   * @brief Resets the counter to zero.
+   */
+  void Reset() noexcept {
+    for (auto& shard : shards_) {
+      shard.value.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> value{0};
+  };
+
+  std::array<Shard, kShardCount> shards_{};
+};
+
+/**
+ * @brief Value that can go up and down.
+ */
+class Gauge {
+public:
+  Gauge() noexcept = default;
+  Gauge(const Gauge&) = delete;
+  Gauge(Gauge&&) = delete;
+  ~Gauge() noexcept = default;
+
+  Gauge& operator=(const Gauge&) = delete;
+  Gauge& operator=(Gauge&&) = delete;
+
+  /**
+   * @brief Sets the gauge.
+   * @param value New value
+   */
+  void Set(double value) noexcept { bits_.store(std::bit_cast<uint64_t>(value), std::memory_order_relaxed); }
+
+  /**
+   * @brief Adds to the gauge.
+   * @param delta Amount to add (may be negative)
+   */
+  void Add(double delta) noexcept {
+    uint64_t current = bits_.load(std::memory_order_relaxed);
+    while (!bits_.compare_exchange_weak(current, std::bit_cast<uint64_t>(std::bit_cast<double>(current) + delta),
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  /**
+   * @brief Gets the current value.
+   * @return Gauge value
+   */
+  [[nodiscard]] double Value() const noexcept { return std::bit_cast<double>(bits_.load(std::memory_order_relaxed)); }
+
+private:
+  std::atomic<uint64_t> bits_{0};  ///< Bit pattern of a double (0 is +0.0).
+};
+
+/**
+ * @brief Latency histogram sharded per thread.
+ * @details Each shard is a utils::LatencyHistogram; shards are merged on read.
+ * Values are recorded in microseconds.
+ */
+class Histogram {
+public:
+  Histogram() noexcept = default;
+  Histogram(const Histogram&) = delete;
+  Histogram(Histogram&&) = delete;
+  ~Histogram() noexcept = default;
+
+  Histogram& operator=(const Histogram&) = delete;
+  Histogram& operator=(Histogram&&) = delete;
+
+  /**
+   * @brief Records a value in microseconds.
+   * @param value_us Value to record
+   */
+  void Record(uint64_t value_us) noexcept { shards_[ThreadShard()].Record(value_us); }
+
+  /**
+   * @brief Records a duration.
+   * @param duration Duration to record (negative durations are recorded as zero)
+   */
+  template <typename Rep, typename Period>
+  void Record(std::chrono::duration<Rep, Period> duration) noexcept {
+    shards_[ThreadShard()].Record(duration);
+  }
+
+  /**
+   * @brief Merges all shards into a histogram.
+   * @param out Histogram to merge into
+   */
+  void MergeInto(utils::LatencyHistogram& out) const noexcept {
+    for (const auto& shard : shards_) {
+      out.Merge(shard);
+    }
+  }
+
+  /**
+   * @brief Gets the number of recorded values.
+   * @return Sample count across all shards
+   */
+  [[nodiscard]] uint64_t Count() const noexcept {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+      total += shard.Count();
+    }
+    return total;
+  }
+
+  /**
+   * @brief Clears all shards.
+   */
+  void Reset() noexcept {
+    for (auto& shard : shards_) {
+      shard.Reset();
+    }
+  }
+
+private:
+  std::array<utils::LatencyHistogram, kShardCount> shards_;
+};
+
+/**
+ * @brief Index of named metrics rendered in Prometheus text exposition format.
+ * @details The registry does not own metrics; components keep their Counter/Gauge/Histogram
+ * members and register references to them. Registered metrics must outlive the registry
+ * or be unregistered first.
+ *
+ * Histograms are exposed as Prometheus summaries (p50/p90/p95/p99, sum and count) in seconds.
+ *
+ * Registration and exposition take a mutex; updating a registered metric never does.
+ */
+class Registry {
+public:
+  Registry() = default;
+  Registry(const Registry&) = delete;
+  Registry(Registry&&) = delete;
+  ~Registry() = default;
+
+  Registry& operator=(const Registry&) = delete;
+  Registry& operator=(Registry&&) = delete;
+
+  /**
+   * @brief Registers a counter.
+   * @param name Metric name (conventionally ending in `_total`)
+   * @param help Help text
+   * @param counter Counter to expose
+   * @return Expected void on success, or MetricsError on failure
+   */
+  [[nodiscard]] auto Register(std::string_view name, std::string_view help, const Counter& counter)
+      -> std::expected<void, MetricsError> {
+    return Add(name, help, &counter);
+  }
+
+  /**
+   * @brief Registers a gauge.
+   * @param name Metric name
+   * @param help Help text
+   * @param gauge Gauge to expose
+   * @return Expected void on success, or MetricsError on failure
+   */
+  [[nodiscard]] auto Register(std::string_view name, std::string_view help, const Gauge& gauge)
+      -> std::expected<void, MetricsError> {
+    return Add(name, help, &gauge);
+  }
+
+  /**
+   * @brief Registers a sharded histogram of microsecond values.
+   * @param name Metric name (conventionally ending in `_seconds`)
+   * @param help Help text
+   * @param histogram Histogram to expose
+   * @return Expected void on success, or MetricsError on failure
+   */
+  [[nodiscard]] auto Register(std::string_view name, std::string_view help, const Histogram& histogram)
+      -> std::expected<void, MetricsError> {
+    return Add(name, help, &histogram);
+  }
+
+  /**
+   * @brief Registers an unsharded histogram of microsecond values.
+   * @param name Metric name (conventionally ending in `_seconds`)
+   * @param help Help text
+   * @param histogram Histogram to expose
+   * @return Expected void on success, or MetricsError on failure
+   */
+  [[nodiscard]] auto Register(std::string_view name, std::string_view help, const utils::LatencyHistogram& histogram)
+      -> std::expected<void, MetricsError> {
+    return Add(name, help, &histogram);
+  }
+
+  /**
+   * @brief Removes a metric.
+   * @param name Metric name
+   * @return True if a metric was removed
+   */
+  bool Unregister(std::string_view name) noexcept;
+
+  /**
+   * @brief Removes all metrics.
+   */
+  void Clear() noexcept;
+
+  /**
+   * @brief Gets the number of registered metrics.
+   * @return Metric count
+   */
+  [[nodiscard]] size_t Size() const noexcept;
+
+  /**
+   * @brief Renders all metrics in Prometheus text exposition format (version 0.0.4).
+   * @return Exposition text
+   */
+  [[nodiscard]] std::string Expose() const;
+
+  /**
+   * @brief Checks whether a name is a valid Prometheus metric name.
+   * @param name Name to check
+   * @return True if name matches `[a-zA-Z_:][a-zA-Z0-9_:]*`
+   */
+  [[nodiscard]] static constexpr bool ValidName(std::string_view name) noexcept;
+
+private:
+  using MetricRef = std::variant<const Counter*, const Gauge*, const Histogram*, const utils::LatencyHistogram*>;
+
+  struct Entry {
+    std::string name;
+    std::string help;
+    MetricRef metric;
+  };
+
+  [[nodiscard]] auto Add(std::string_view name, std::string_view help, MetricRef metric)
+      -> std::expected<void, MetricsError>;
+
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+};
+
+constexpr bool Registry::ValidName(std::string_view name) noexcept {
+  if (name.empty()) {
+    return false;
+  }
+
+  const auto is_name_start = [](char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':';
+  };
+  if (!is_name_start(name.front())) {
+    return false;
+  }
+
+  for (const char c : name.substr(1)) {
+    if (!is_name_start(c) && !(c >= '0' && c <= '9')) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace client::metrics
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <client/core/pch.hpp>
+
+#include <client/core/core.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace client::tracing {
+
+/// True when CLIENT_SPAN records spans; false when spans are compiled out.
+#if defined(CLIENT_ENABLE_TRACING)
+inline constexpr bool kTracingEnabled = true;
+#else
+inline constexpr bool kTracingEnabled = false;
+#endif
+
+/**
+ * @brief Error codes for trace export.
+ */
+enum class TraceError : uint8_t {
+  kCannotOpenFile,  ///< Output file could not be opened.
+  kWriteFailed,     ///< Writing the output file failed.
+};
+
+/**
+ * @brief Converts TraceError to a human-readable string.
+ * @param error The error to convert
+ * @return A string view representing the error
+ */
+[[nodiscard]] constexpr std::string_view TraceErrorToString(TraceError error) noexcept {
+  switch (error) {
+    case TraceError::kCannotOpenFile:
+      return "Cannot open trace file";
+    case TraceError::kWriteFailed:
+      return "Failed to write trace file";
+    default:
+      return "Unknown error";
+  }
+}
+
+/**
+ * @brief A completed span.
+ */
+struct TraceEvent {
+  const char* name = nullptr;  ///< Span name (string with static storage duration).
+  int64_t start_ns = 0;        ///< Start time in steady_clock nanoseconds.
+  int64_t duration_ns = 0;     ///< Duration in nanoseconds.
+  uint32_t thread_id = 0;      ///< Tracer-assigned thread ID.
+};
+
+/**
+ * @brief Process-wide span recorder with per-thread ring buffers.
+ * @details Each thread that records a span gets its own fixed-size ring buffer, so recording
+ * never locks or allocates after the first span on a thread. The oldest spans are overwritten
+ * once a buffer is full. Export copies all buffers and may run concurrently with recording;
+ * spans overwritten during the copy are skipped.
+ */
+class Tracer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr size_t kEventsPerThread = 4096;
+
+  Tracer(const Tracer&) = delete;
+  Tracer(Tracer&&) = delete;
+  ~Tracer() = default;
+
+  Tracer& operator=(const Tracer&) = delete;
+  Tracer& operator=(Tracer&&) = delete;
+
+  /**
+   * @brief Records a completed span on the calling thread.
+   * @param name Span name (must have static storage duration)
+   * @param start Span start time
+   * @param end Span end time
+   */
+  void Record(const char* name, Clock::time_point start, Clock::time_point end) noexcept;
+
+  /**
+   * @brief Names the calling thread in exported traces.
+   * @param name Thread name
+   */
+  void SetThreadName(std::string_view name);
+
+  /**
+   * @brief Collects spans that ended within a time window.
+   * @param window How far back from now to collect
+   * @return Spans sorted by start time
+   */
+  [[nodiscard]] std::vector<TraceEvent> Collect(std::chrono::nanoseconds window) const;
+
+  /**
+   * @brief Exports spans as Chrome trace-event JSON (viewable in Perfetto or chrome://tracing).
+   * @param window How far back from now to export
+   * @return JSON document
+   */
+  [[nodiscard]] std::string ExportChromeJson(std::chrono::nanoseconds window) const;
+
+  /**
+   * @brief Writes spans as Chrome trace-event JSON to a file.
+   * @param path Output file path
+   * @param window How far back from now to export
+   * @return Number of spans written, or TraceError on failure
+   */
+  [[nodiscard]] auto WriteChromeJson(const std::filesystem::path& path, std::chrono::nanoseconds window) const
+      -> std::expected<size_t, TraceError>;
+
+  /**
+   * @brief Discards all recorded spans.
+   * @warning Must not race with Record() on other threads.
+   */
+  void Clear() noexcept;
+
+  /**
+   * @brief Gets the singleton instance.
+   * @return Reference to the Tracer instance
+   */
+  [[nodiscard]] static Tracer& GetInstance() noexcept {
+    static Tracer instance;
+    return instance;
+  }
+
+private:
+  struct Slot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<int64_t> start_ns{0};
+    std::atomic<int64_t> duration_ns{0};
+  };
+
+  struct ThreadBuffer {
+    uint32_t thread_id = 0;
+    std::string thread_name;  ///< Protected by Tracer::mutex_.
+    std::atomic<uint64_t> head{0};
+    std::array<Slot, kEventsPerThread> slots;
+  };
+
+  Tracer() = default;
+
+  [[nodiscard]] ThreadBuffer& LocalBuffer();
+  [[nodiscard]] std::string ToChromeJson(const std::vector<TraceEvent>& events) const;
+
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+/**
+ * @brief RAII span that records its lifetime to the Tracer.
+ * @note Use CLIENT_SPAN() instead so that spans compile out when tracing is disabled.
+ */
+class ScopedSpan {
+public:
+  /**
+   * @brief Starts a span.
+   * @param name Span name (must have static storage duration)
+   */
+  explicit ScopedSpan(const char* name) noexcept : name_(name), start_(Tracer::Clock::now()) {}
+  ScopedSpan(const ScopedSpan&) = delete;
+  ScopedSpan(ScopedSpan&&) = delete;
+  ~ScopedSpan() noexcept { Tracer::GetInstance().Record(name_, start_, Tracer::Clock::now()); }
+
+  ScopedSpan& operator=(const ScopedSpan&) = delete;
+  ScopedSpan& operator=(ScopedSpan&&) = delete;
+
+private:
+  const char* name_;
+  Tracer::Clock::time_point start_;
+};
+
+}  // namespace client::tracing
+
+// ============================================================================
+// Tracing Macros
+// ============================================================================
+
+#if defined(CLIENT_ENABLE_TRACING)
+#define CLIENT_SPAN(name) const ::client::tracing::ScopedSpan CLIENT_ANONYMOUS_VAR(client_span_)(name)
+#define CLIENT_SET_THREAD_NAME(name) ::client::tracing::Tracer::GetInstance().SetThreadName(name)
+#else
+#define CLIENT_SPAN(name) [[maybe_unused]] static constexpr auto CLIENT_ANONYMOUS_VAR(unused_span) = 0
+#define CLIENT_SET_THREAD_NAME(name) \
+  [[maybe_unused]] static constexpr auto CLIENT_ANONYMOUS_VAR(unused_thread_name) = 0
+#endif
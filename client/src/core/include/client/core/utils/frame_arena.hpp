@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace client::utils {
+
+/**
+ * @brief Memory resource that counts calls forwarded to an upstream resource.
+ * @details Used as the upstream of FrameArena so that every heap allocation made
+ * when the arena runs out of its preallocated buffer is visible to callers.
+ */
+class CountingResource final : public std::pmr::memory_resource {
+public:
+  /**
+   * @brief Constructs a counting resource.
+   * @param upstream Resource to forward allocations to
+   */
+  explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+      : upstream_(upstream) {}
+
+  CountingResource(const CountingResource&) = delete;
+  CountingResource(CountingResource&&) = delete;
+  ~CountingResource() override = default;
+
+  CountingResource& operator=(const CountingResource&) = delete;
+  CountingResource& operator=(CountingResource&&) = delete;
+
+  /**
+   * @brief Gets the number of allocations forwarded upstream.
+   * @return Allocation count
+   */
+  [[nodiscard]] uint64_t Allocations() const noexcept { return allocations_; }
+
+  /**
+   * @brief Gets the number of deallocations forwarded upstream.
+   * @return Deallocation count
+   */
+  [[nodiscard]] uint64_t Deallocations() const noexcept { return deallocations_; }
+
+  /**
+   * @brief Gets the total number of bytes requested from upstream.
+   * @return Byte count
+   */
+  [[nodiscard]] size_t BytesAllocated() const noexcept { return bytes_allocated_; }
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations_;
+    bytes_allocated_ += bytes;
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+    ++deallocations_;
+    upstream_->deallocate(ptr, bytes, alignment);
+  }
+
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  std::pmr::memory_resource* upstream_ = nullptr;
+  uint64_t allocations_ = 0;
+  uint64_t deallocations_ = 0;
+  size_t bytes_allocated_ = 0;
+};
+
+/**
+ * @brief Statistics reported by FrameArena.
+ */
+struct FrameArenaStats {
+  uint64_t frames = 0;                ///< Number of completed frames (calls to Reset).
+  uint64_t allocations = 0;           ///< Total allocations served by the arena.
+  uint64_t upstream_allocations = 0;  ///< Allocations that had to fall back to the heap.
+  uint64_t growths = 0;               ///< Number of times the preallocated buffer was enlarged.
+  size_t bytes_last_frame = 0;        ///< Bytes requested during the last completed frame.
+  size_t peak_frame_bytes = 0;        ///< Largest number of bytes requested in a single frame.
+  size_t capacity = 0;                ///< Size of the preallocated buffer in bytes.
+};
+
+/**
+ * @brief Per-frame monotonic arena for short-lived allocations.
+ * @details Wraps std::pmr::monotonic_buffer_resource over a preallocated buffer.
+ * Allocations are bump-pointer and deallocation is a no-op; all memory is reclaimed at once by Reset(),
+ * which is expected to be called at the end of every frame.
+ *
+ * If a frame exceeds the preallocated buffer, the overflow is served from the heap and counted as an
+ * upstream allocation. The next Reset() then grows the buffer to cover the observed peak, so after
+ * warm-up the arena itself makes no heap allocations. Whatever outlives the frame must be copied out
+ * of it into storage of its own.
+ *
+ * @note Not thread-safe. Intended to be owned by a single processing stage.
+ */
+class FrameArena final : public std::pmr::memory_resource {
+public:
+  static constexpr size_t kDefaultCapacity = 16 * 1024;
+
+  /**
+   * @brief Constructs an arena with the given initial capacity.
+   * @param initial_capacity Size of the preallocated buffer in bytes
+   */
+  explicit FrameArena(size_t initial_capacity = kDefaultCapacity) { Allocate(initial_capacity); }
+
+  FrameArena(const FrameArena&) = delete;
+  FrameArena(FrameArena&&) = delete;
+  ~FrameArena() override = default;
+
+  FrameArena& operator=(const FrameArena&) = delete;
+  FrameArena& operator=(FrameArena&&) = delete;
+
+  /**
+   * @brief Releases all memory allocated during the current frame.
+   * @details Grows the preallocated buffer if the frame spilled to the heap.
+   * @warning Invalidates every object allocated from the arena.
+   */
+  void Reset();
+
+  /**
+   * @brief Gets the memory resource to allocate from.
+   * @return Pointer to this arena
+   */
+  [[nodiscard]] std::pmr::memory_resource* Resource() noexcept { return this; }
+
+  /**
+   * @brief Gets the number of bytes requested during the current frame.
+   * @return Byte count
+   */
+  [[nodiscard]] size_t BytesInFrame() const noexcept { return bytes_in_frame_; }
+
+  /**
+   * @brief Gets the arena statistics.
+   * @return Statistics snapshot
+   */
+  [[nodiscard]] FrameArenaStats Stats() const noexcept {
+    FrameArenaStats stats = stats_;
+    stats.upstream_allocations = upstream_.Allocations();
+    stats.capacity = capacity_;
+    return stats;
+  }
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    ++stats_.allocations;
+    bytes_in_frame_ += bytes + alignment - 1;
+    return monotonic_->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* /*ptr*/, size_t /*bytes*/, size_t /*alignment*/) override {}
+
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  void Allocate(size_t capacity);
+
+  CountingResource upstream_;
+  std::unique_ptr<std::byte[]> buffer_;
+  std::optional<std::pmr::monotonic_buffer_resource> monotonic_;
+  FrameArenaStats stats_;
+  size_t capacity_ = 0;
+  size_t bytes_in_frame_ = 0;
+  uint64_t upstream_at_frame_start_ = 0;
+};
+
+inline void FrameArena::Reset() {
+  const bool spilled = upstream_.Allocations() != upstream_at_frame_start_;
+
+  ++stats_.frames;
+  stats_.bytes_last_frame = bytes_in_frame_;
+  stats_.peak_frame_bytes = std::max(stats_.peak_frame_bytes, bytes_in_frame_);
+  bytes_in_frame_ = 0;
+
+  if (spilled) {
+    ++stats_.growths;
+    Allocate(std::bit_ceil(stats_.peak_frame_bytes));
+  } else {
+    monotonic_->release();
+  }
+
+  upstream_at_frame_start_ = upstream_.Allocations();
+}
+
+inline void FrameArena::Allocate(size_t capacity) {
+  // Destroy the resource first so its overflow chunks are returned before the buffer is replaced
+  monotonic_.reset();
+  capacity_ = std::max<size_t>(capacity, alignof(std::max_align_t));
+  buffer_ = std::make_unique_for_overwrite<std::byte[]>(capacity_);
+  monotonic_.emplace(buffer_.get(), capacity_, &upstream_);
+}
+
+}  // namespace client::utils
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace client::utils {
+
+/**
+ * @brief Fixed-size log-linear histogram for latency values.
+ * @details Uses an HDR-style layout: each power-of-two range is split into
+ * kSubBucketCount linear sub-buckets, giving a relative error of about 3% over the whole
+ * range while using a fixed amount of memory and no allocations.
+ *
+ * Values are unitless 64-bit integers; callers usually record microseconds.
+ * Values above kMaxTrackableValue are clamped into the last bucket.
+ *
+ * Recording is lock-free (relaxed atomics), so a histogram can be written from one thread
+ * and read from another. Percentiles computed while recording is in progress are approximate.
+ */
+class LatencyHistogram {
+public:
+  static constexpr size_t kSubBucketBits = 5;
+  static constexpr size_t kSubBucketCount = size_t{1} << kSubBucketBits;
+  static constexpr size_t kMaxShift = 26;
+  static constexpr uint64_t kMaxTrackableValue = (uint64_t{kSubBucketCount * 2} << kMaxShift) - 1;
+  static constexpr size_t kBucketCount = kSubBucketCount + (kMaxShift + 1) * kSubBucketCount;
+
+  LatencyHistogram() noexcept = default;
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram(LatencyHistogram&&) = delete;
+  ~LatencyHistogram() noexcept = default;
+
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(LatencyHistogram&&) = delete;
+
+  /**
+   * @brief Records a single value.
+   * @param value Value to record
+   */
+  void Record(uint64_t value) noexcept;
+
+  /**
+   * @brief Records a duration in microseconds.
+   * @param duration Duration to record (negative durations are recorded as zero)
+   */
+  template <typename Rep, typename Period>
+  void Record(std::chrono::duration<Rep, Period> duration) noexcept {
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    Record(us > 0 ? static_cast<uint64_t>(us) : 0);
+  }
+
+  /**
+   * @brief Adds all samples from another histogram.
+   * @param other Histogram to merge from
+   */
+  void Merge(const LatencyHistogram& other) noexcept;
+
+  /**
+   * @brief Clears all recorded values.
+   */
+  void Reset() noexcept;
+
+  /**
+   * @brief Gets the value at the given percentile.
+   * @param percentile Percentile in range [0, 100]
+   * @return Upper bound of the bucket containing the percentile, clamped to Max(), or 0 if empty
+   */
+  [[nodiscard]] uint64_t Percentile(double percentile) const noexcept;
+
+  /**
+   * @brief Gets the number of recorded values.
+   * @return Sample count
+   */
+  [[nodiscard]] uint64_t Count() const noexcept { return count_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Gets the sum of recorded values.
+   * @return Sum of samples
+   */
+  [[nodiscard]] uint64_t Sum() const noexcept { return sum_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Gets the smallest recorded value.
+   * @return Minimum, or 0 if empty
+   */
+  [[nodiscard]] uint64_t Min() const noexcept {
+    const uint64_t min = min_.load(std::memory_order_relaxed);
+    return min == std::numeric_limits<uint64_t>::max() ? 0 : min;
+  }
+
+  /**
+   * @brief Gets the largest recorded value.
+   * @return Maximum, or 0 if empty
+   */
+  [[nodiscard]] uint64_t Max() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Gets the mean of recorded values.
+   * @return Mean, or 0 if empty
+   */
+  [[nodiscard]] double Mean() const noexcept {
+    const uint64_t count = Count();
+    return count == 0 ? 0.0 : static_cast<double>(Sum()) / static_cast<double>(count);
+  }
+
+  /**
+   * @brief Gets the number of samples in a bucket.
+   * @param index Bucket index (must be less than kBucketCount)
+   * @return Sample count in bucket
+   */
+  [[nodiscard]] uint64_t BucketCount(size_t index) const noexcept {
+    return buckets_[index].load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Maps a value to its bucket index.
+   * @param value Value to map
+   * @return Bucket index
+   */
+  [[nodiscard]] static constexpr size_t BucketIndex(uint64_t value) noexcept;
+
+  /**
+   * @brief Gets the largest value that maps to a bucket.
+   * @param index Bucket index
+   * @return Inclusive upper bound of the bucket
+   */
+  [[nodiscard]] static constexpr uint64_t BucketUpperBound(size_t index) noexcept;
+
+private:
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> min_{std::numeric_limits<uint64_t>::max()};
+  std::atomic<uint64_t> max_{0};
+};
+
+constexpr size_t LatencyHistogram::BucketIndex(uint64_t value) noexcept {
+  value = std::min(value, kMaxTrackableValue);
+  if (value < kSubBucketCount * 2) {
+    return value;
+  }
+  // Keep kSubBucketBits + 1 significant bits; the top one selects the power-of-two range
+  const auto shift = std::bit_width(value) - (kSubBucketBits + 1);
+  return kSubBucketCount + shift * kSubBucketCount + (value >> shift) - kSubBucketCount;
+}
+
+constexpr uint64_t LatencyHistogram::BucketUpperBound(size_t index) noexcept {
+  if (index < kSubBucketCount * 2) {
+    return index;
+  }
+  const size_t shift = (index - kSubBucketCount) / kSubBucketCount;
+  const uint64_t mantissa = (index - kSubBucketCount) % kSubBucketCount + kSubBucketCount;
+  return ((mantissa + 1) << shift) - 1;
+}
+
+inline void LatencyHistogram::Record(uint64_t value) noexcept {
+  buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  uint64_t current_min = min_.load(std::memory_order_relaxed);
+  while (value < current_min && !min_.compare_exchange_weak(current_min, value, std::memory_order_relaxed)) {
+  }
+
+  uint64_t current_max = max_.load(std::memory_order_relaxed);
+  while (value > current_max && !max_.compare_exchange_weak(current_max, value, std::memory_order_relaxed)) {
+  }
+}
+
+inline void LatencyHistogram::Merge(const LatencyHistogram& other) noexcept {
+  if (other.Count() == 0) {
+    return;
+  }
+
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    const uint64_t bucket = other.BucketCount(i);
+    if (bucket != 0) {
+      buckets_[i].fetch_add(bucket, std::memory_order_relaxed);
+    }
+  }
+  count_.fetch_add(other.Count(), std::memory_order_relaxed);
+  sum_.fetch_add(other.Sum(), std::memory_order_relaxed);
+
+  const uint64_t other_min = other.min_.load(std::memory_order_relaxed);
+  uint64_t current_min = min_.load(std::memory_order_relaxed);
+  while (other_min < current_min && !min_.compare_exchange_weak(current_min, other_min, std::memory_order_relaxed)) {
+  }
+
+  const uint64_t other_max = other.Max();
+  uint64_t current_max = max_.load(std::memory_order_relaxed);
+  while (other_max > current_max && !max_.compare_exchange_weak(current_max, other_max, std::memory_order_relaxed)) {
+  }
+}
+
+inline void LatencyHistogram::Reset() noexcept {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+inline uint64_t LatencyHistogram::Percentile(double percentile) const noexcept {
+  const uint64_t count = Count();
+  if (count == 0) {
+    return 0;
+  }
+
+  const double clamped = std::clamp(percentile, 0.0, 100.0);
+  const auto target =
+      std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count))));
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    seen += BucketCount(i);
+    if (seen >= target) {
+      return std::min(BucketUpperBound(i), Max());
+    }
+  }
+  return Max();
+}
+
+}  // namespace client::utils
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace client::utils {
+
+/**
+ * @brief Bounded lock-free multi-producer, single-consumer queue.
+ * @details A fixed ring of Capacity cells, each carrying a sequence number that says whether it
+ * is free for the producer of a given position or full for the consumer (D. Vyukov's bounded
+ * queue). Producers claim positions with a compare-and-swap on the tail; the consumer owns the
+ * head. Nothing is allocated after construction and no thread ever blocks: a producer facing a
+ * full queue gets false back and decides itself what to drop.
+ * @tparam T Element type (nothrow move-constructible)
+ * @tparam Capacity Number of cells (a power of two)
+ * @note Any number of threads may call TryPush(); only one thread at a time may call TryPop().
+ */
+template <typename T, size_t Capacity>
+class MpscQueue {
+  static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+  static_assert(std::is_nothrow_move_constructible_v<T>, "Elements are moved in and out of the ring");
+
+public:
+  MpscQueue() noexcept {
+    for (size_t i = 0; i < Capacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue(MpscQueue&&) = delete;
+  ~MpscQueue() {
+    while (TryPop().has_value()) {
+    }
+  }
+
+  MpscQueue& operator=(const MpscQueue&) = delete;
+  MpscQueue& operator=(MpscQueue&&) = delete;
+
+  /**
+   * @brief Appends an element (any thread).
+   * @param value Element to append
+   * @return False if the queue is full; @p value is left untouched then
+   */
+  template <typename U>
+  bool TryPush(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>) {
+    size_t position = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells_[position & kMask];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto lag = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (lag == 0) {
+        if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          new (cell.storage) T(std::forward<U>(value));
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;
+      } else {
+        position = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Removes the oldest element (consumer thread only).
+   * @return The element, or nullopt if the queue is empty
+   */
+  [[nodiscard]] std::optional<T> TryPop() noexcept {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[head & kMask];
+    if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+      return std::nullopt;
+    }
+
+    T* element = std::launder(reinterpret_cast<T*>(cell.storage));
+    std::optional<T> value(std::move(*element));
+    element->~T();
+    cell.sequence.store(head + Capacity, std::memory_order_release);
+    head_.store(head + 1, std::memory_order_relaxed);
+    return value;
+  }
+
+  /**
+   * @brief Gets the number of elements, as seen at some point during the call (any thread).
+   * @return Approximate element count
+   */
+  [[nodiscard]] size_t SizeApprox() const noexcept {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t head = head_.load(std::memory_order_relaxed);
+    return tail > head ? std::min(tail - head, Capacity) : 0;
+  }
+
+  /**
+   * @brief Gets the most elements the queue holds.
+   * @return Capacity
+   */
+  [[nodiscard]] static constexpr size_t MaxSize() noexcept { return Capacity; }
+
+private:
+  static constexpr size_t kMask = Capacity - 1;
+
+  // Producers and the consumer write different lines, so they do not invalidate each other's cache
+  static constexpr size_t kCacheLine = 64;
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  std::array<Cell, Capacity> cells_;
+  alignas(kCacheLine) std::atomic<size_t> tail_{0};
+  alignas(kCacheLine) std::atomic<size_t> head_{0};  ///< Written by the consumer only.
+};
+
+}  // namespace client::utils
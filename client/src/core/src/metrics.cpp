@@ -0,0 +1,149 @@
+#include <client/core/metrics.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+namespace client::metrics {
+
+namespace {
+
+constexpr std::array kSummaryQuantiles = {0.5, 0.9, 0.95, 0.99};
+constexpr double kUsPerSecond = 1'000'000.0;
+
+void AppendEscapedHelp(std::string& out, std::string_view help) {
+  for (const char c : help) {
+    if (c == '\\') {
+      out += "\\\\";
+    } else if (c == '\n') {
+      out += "\\n";
+    } else {
+      out += c;
+    }
+  }
+}
+
+void AppendValue(std::string& out, double value) {
+  if (std::isnan(value)) {
+    out += "NaN";
+  } else if (std::isinf(value)) {
+    out += value > 0 ? "+Inf" : "-Inf";
+  } else {
+    std::format_to(std::back_inserter(out), "{}", value);
+  }
+}
+
+void AppendHeader(std::string& out, std::string_view name, std::string_view help, std::string_view type) {
+  out += "# HELP ";
+  out += name;
+  out += ' ';
+  AppendEscapedHelp(out, help);
+  out += "\n# TYPE ";
+  out += name;
+  out += ' ';
+  out += type;
+  out += '\n';
+}
+
+void AppendSummary(std::string& out, std::string_view name, const utils::LatencyHistogram& histogram) {
+  for (const double quantile : kSummaryQuantiles) {
+    std::format_to(std::back_inserter(out), "{}{{quantile=\"{}\"}} ", name, quantile);
+    AppendValue(out, static_cast<double>(histogram.Percentile(quantile * 100.0)) / kUsPerSecond);
+    out += '\n';
+  }
+  std::format_to(std::back_inserter(out), "{}_sum ", name);
+  AppendValue(out, static_cast<double>(histogram.Sum()) / kUsPerSecond);
+  std::format_to(std::back_inserter(out), "\n{}_count {}\n", name, histogram.Count());
+}
+
+}  // namespace
+
+size_t ThreadShard() noexcept {
+  static std::atomic<size_t> next_shard{0};
+  thread_local const size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+  return shard;
+}
+
+auto Registry::Add(std::string_view name, std::string_view help, MetricRef metric)
+    -> std::expected<void, MetricsError> {
+  if (!ValidName(name)) {
+    return std::unexpected(MetricsError::kInvalidName);
+  }
+
+  std::scoped_lock lock(mutex_);
+  const bool exists = std::ranges::any_of(entries_, [name](const Entry& entry) { return entry.name == name; });
+  if (exists) {
+    return std::unexpected(MetricsError::kDuplicateName);
+  }
+
+  entries_.push_back({.name = std::string(name), .help = std::string(help), .metric = metric});
+  return {};
+}
+
+bool Registry::Unregister(std::string_view name) noexcept {
+  std::scoped_lock lock(mutex_);
+  return std::erase_if(entries_, [name](const Entry& entry) { return entry.name == name; }) != 0;
+}
+
+void Registry::Clear() noexcept {
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+}
+
+size_t Registry::Size() const noexcept {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+std::string Registry::Expose() const {
+  std::string out;
+  std::unique_ptr<utils::LatencyHistogram> merged;
+
+  std::scoped_lock lock(mutex_);
+  out.reserve(entries_.size() * 128);
+
+  for (const auto& entry : entries_) {
+    std::visit(
+        [&](const auto* metric) {
+          using Metric = std::remove_cvref_t<decltype(*metric)>;
+          if constexpr (std::is_same_v<Metric, Counter>) {
+            AppendHeader(out, entry.name, entry.help, "counter");
+            std::format_to(std::back_inserter(out), "{} {}\n", entry.name, metric->Value());
+          } else if constexpr (std::is_same_v<Metric, Gauge>) {
+            AppendHeader(out, entry.name, entry.help, "gauge");
+            out += entry.name;
+            out += ' ';
+            AppendValue(out, metric->Value());
+            out += '\n';
+          } else if constexpr (std::is_same_v<Metric, Histogram>) {
+            if (merged) {
+              merged->Reset();
+            } else {
+              merged = std::make_unique<utils::LatencyHistogram>();
+            }
+            metric->MergeInto(*merged);
+            AppendHeader(out, entry.name, entry.help, "summary");
+            AppendSummary(out, entry.name, *merged);
+          } else {
+            AppendHeader(out, entry.name, entry.help, "summary");
+            AppendSummary(out, entry.name, *metric);
+          }
+        },
+        entry.metric);
+  }
+
+  return out;
+}
+
+}  // namespace client::metrics
@@ -0,0 +1,206 @@
+#include <client/core/tracing.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace client::tracing {
+
+namespace {
+
+/// Chrome trace-event files only need a stable process ID.
+constexpr int kTraceProcessId = 1;
+
+[[nodiscard]] int64_t ToNanoseconds(Tracer::Clock::time_point time) noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+void AppendJsonString(std::string& out, std::string_view value) {
+  out += '"';
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned int>(c));
+        } else {
+          out += c;
+        }
+        break;
+    }
+  }
+  out += '"';
+}
+
+}  // namespace
+
+void Tracer::Record(const char* name, Clock::time_point start, Clock::time_point end) noexcept {
+  ThreadBuffer* buffer = nullptr;
+  try {
+    buffer = &LocalBuffer();
+  } catch (...) {
+    return;  // First span on this thread could not allocate a buffer
+  }
+
+  const uint64_t index = buffer->head.load(std::memory_order_relaxed);
+  auto& slot = buffer->slots[index % kEventsPerThread];
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.start_ns.store(ToNanoseconds(start), std::memory_order_relaxed);
+  slot.duration_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+                         std::memory_order_relaxed);
+  buffer->head.store(index + 1, std::memory_order_release);
+}
+
+void Tracer::SetThreadName(std::string_view name) {
+  ThreadBuffer& buffer = LocalBuffer();
+  std::scoped_lock lock(mutex_);
+  buffer.thread_name = name;
+}
+
+std::vector<TraceEvent> Tracer::Collect(std::chrono::nanoseconds window) const {
+  const int64_t cutoff_ns = ToNanoseconds(Clock::now()) - window.count();
+
+  std::vector<TraceEvent> events;
+  std::vector<TraceEvent> copied;
+  copied.reserve(kEventsPerThread);
+
+  std::scoped_lock lock(mutex_);
+  for (const auto& buffer : buffers_) {
+    const uint64_t head = buffer->head.load(std::memory_order_acquire);
+    const uint64_t first = head > kEventsPerThread ? head - kEventsPerThread : 0;
+
+    copied.clear();
+    for (uint64_t index = first; index < head; ++index) {
+      const auto& slot = buffer->slots[index % kEventsPerThread];
+      copied.push_back({
+          .name = slot.name.load(std::memory_order_relaxed),
+          .start_ns = slot.start_ns.load(std::memory_order_relaxed),
+          .duration_ns = slot.duration_ns.load(std::memory_order_relaxed),
+          .thread_id = buffer->thread_id,
+      });
+    }
+
+    // Drop slots the writer reused, or may be writing, while they were copied
+    const uint64_t current_head = buffer->head.load(std::memory_order_acquire);
+    const uint64_t first_intact = current_head + 1 > kEventsPerThread ? current_head + 1 - kEventsPerThread : 0;
+
+    for (uint64_t index = std::max(first, first_intact); index < head; ++index) {
+      const auto& event = copied[index - first];
+      if (event.name != nullptr && event.start_ns + event.duration_ns >= cutoff_ns) {
+        events.push_back(event);
+      }
+    }
+  }
+
+  std::ranges::sort(events, {}, &TraceEvent::start_ns);
+  return events;
+}
+
+std::string Tracer::ExportChromeJson(std::chrono::nanoseconds window) const {
+  return ToChromeJson(Collect(window));
+}
+
+auto Tracer::WriteChromeJson(const std::filesystem::path& path, std::chrono::nanoseconds window) const
+    -> std::expected<size_t, TraceError> {
+  const auto events = Collect(window);
+  const std::string json = ToChromeJson(events);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return std::unexpected(TraceError::kCannotOpenFile);
+  }
+
+  file.write(json.data(), static_cast<std::streamsize>(json.size()));
+  if (!file) {
+    return std::unexpected(TraceError::kWriteFailed);
+  }
+
+  return events.size();
+}
+
+void Tracer::Clear() noexcept {
+  std::scoped_lock lock(mutex_);
+  for (const auto& buffer : buffers_) {
+    for (auto& slot : buffer->slots) {
+      slot.name.store(nullptr, std::memory_order_relaxed);
+    }
+    buffer->head.store(0, std::memory_order_release);
+  }
+}
+
+std::string Tracer::ToChromeJson(const std::vector<TraceEvent>& events) const {
+  std::string out;
+  out.reserve(64 + events.size() * 112);
+  out += "{\"traceEvents\":[";
+
+  bool first = true;
+  const auto separator = [&]() {
+    if (!first) {
+      out += ',';
+    }
+    first = false;
+    out += '\n';
+  };
+
+  {
+    std::scoped_lock lock(mutex_);
+    for (const auto& buffer : buffers_) {
+      separator();
+      std::format_to(std::back_inserter(out), R"({{"name":"thread_name","ph":"M","pid":{},"tid":{},"args":{{"name":)",
+                     kTraceProcessId, buffer->thread_id);
+      AppendJsonString(out, buffer->thread_name);
+      out += "}}";
+    }
+  }
+
+  for (const auto& event : events) {
+    separator();
+    out += R"({"name":)";
+    AppendJsonString(out, event.name);
+    std::format_to(std::back_inserter(out), R"(,"cat":"client","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":{},"tid":{}}})",
+                   static_cast<double>(event.start_ns) / 1000.0, static_cast<double>(event.duration_ns) / 1000.0,
+                   kTraceProcessId, event.thread_id);
+  }
+
+  out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return out;
+}
+
+Tracer::ThreadBuffer& Tracer::LocalBuffer() {
+  thread_local std::shared_ptr<ThreadBuffer> local;
+  if (local) [[likely]] {
+    return *local;
+  }
+
+  auto buffer = std::make_shared<ThreadBuffer>();
+  {
+    std::scoped_lock lock(mutex_);
+    buffer->thread_id = static_cast<uint32_t>(buffers_.size() + 1);
+    buffer->thread_name = std::format("thread-{}", buffer->thread_id);
+    buffers_.push_back(buffer);
+  }
+  local = std::move(buffer);
+  return *local;
+}
+
+}  // namespace client::tracing
@@ -4,15 +4,26 @@
 
 #include <client/app/app_return_code.hpp>
 #include <client/app/camera.hpp>
+#include <client/app/camera_model.hpp>
+#include <client/app/command_gate.hpp>
 #include <client/app/face_tracker.hpp>
+#include <client/app/gimbal_controller.hpp>
+#include <client/app/latency_tracker.hpp>
+#include <client/app/metrics_server.hpp>
 #include <client/app/model_config.hpp>
 #include <client/comm/bluetooth.hpp>
+#include <client/comm/device_shadow.hpp>
+#include <client/comm/link_monitor.hpp>
+#include <client/comm/response_dispatcher.hpp>
 #include <client/core/logger.hpp>
+#include <client/core/metrics.hpp>
+#include <client/core/tracing.hpp>
 
 #include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <expected>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -46,10 +57,16 @@ class BluetoothManager;
 struct AppConfig {
   CameraConfig camera;                           ///< Camera configuration.
   FaceTrackerConfig face_tracker;                ///< Face tracker configuration.
+  GimbalControllerConfig gimbal_controller;      ///< Pan/tilt controller tuning.
+  CommandGateConfig command_gate;                ///< Suppression of targets that barely moved.
   ModelType model_type = ModelType::kYuNetONNX;  ///< Selected model type.
   bool headless = false;                         ///< Run without GUI.
   bool verbose = false;                          ///< Enable verbose logging.
   uint32_t max_frames = 0;                       ///< Maximum frames to process (0 = unlimited).
+  MetricsServerConfig metrics_endpoint;          ///< Prometheus endpoint (disabled by default).
+  std::string trace_file;                        ///< Write a Chrome trace here on exit (empty = disabled).
+  uint32_t trace_seconds = 10;                   ///< How many seconds of spans to write.
+  bool calibrate_fov = false;                    ///< Sweep the gimbal once connected to calibrate the camera.
 
   /**
    * @brief Gets the default application configuration.
@@ -205,7 +222,38 @@ public:
    * @brief Gets the total number of frames processed.
    * @return Frame count
    */
-  [[nodiscard]] uint64_t FramesProcessed() const noexcept { return frames_processed_.load(std::memory_order_relaxed); }
+  [[nodiscard]] uint64_t FramesProcessed() const noexcept { return frames_processed_.Value(); }
+
+  /**
+   * @brief Gets the motion-to-servo latency tracker.
+   * @return Reference to the latency tracker
+   */
+  [[nodiscard]] const LatencyTracker& Latency() const noexcept { return latency_tracker_; }
+
+  /**
+   * @brief Gets the device state last reported by the firmware.
+   * @return Consistent snapshot of the device shadow (safe to call from any thread)
+   */
+  [[nodiscard]] comm::DeviceState Device() const noexcept { return device_shadow_.Read(); }
+
+  /**
+   * @brief Gets the measured link latency and device clock offset.
+   * @return Round-trip, jitter and clock offset estimates from the ping channel (safe to call from any thread)
+   */
+  [[nodiscard]] comm::LinkStats Link() const { return link_monitor_.Stats(); }
+
+  /**
+   * @brief Gets the metrics registry.
+   * @return Reference to the registry served by the metrics endpoint
+   */
+  [[nodiscard]] const metrics::Registry& Metrics() const noexcept { return metrics_; }
+
+  /**
+   * @brief Writes the last config.trace_seconds of pipeline spans as Chrome trace-event JSON.
+   * @param path Output file path
+   * @return Number of spans written, or TraceError on failure
+   */
+  [[nodiscard]] auto DumpTrace(const std::filesystem::path& path) const -> std::expected<size_t, tracing::TraceError>;
 
   /**
    * @brief Gets the current model type.
@@ -256,6 +304,11 @@ private:
    */
   [[nodiscard]] auto Initialize() -> std::expected<void, AppReturnCode>;
 
+  /**
+   * @brief Registers component metrics with the registry.
+   */
+  void RegisterMetrics();
+
   /**
    * @brief Processes a single frame from the camera.
    * @param frame The frame to process
@@ -274,24 +327,111 @@ private:
    */
   void UpdateGui();
 
+  /**
+   * @brief Publishes latency percentiles to the GUI and, periodically, to the log.
+   */
+  void ReportLatency();
+
+  /**
+   * @brief Sends the next ping when due and expires pings the device never answered.
+   */
+  void PollLink();
+
+  /**
+   * @brief Connects to a device and starts the camera.
+   * @param address Device address or transport URI (see comm::BluetoothManager::Connect())
+   */
+  void ConnectToDevice(std::string_view address);
+
+  /**
+   * @brief Remembers the connected device and calibrates it unless it reports being calibrated.
+   * @note The device is calibrated anyway if its status reply does not arrive within a few seconds.
+   */
+  void ResumeSession();
+
+  /**
+   * @brief Sends the calibrate command to the connected device.
+   */
+  void StartCalibration();
+
+  /**
+   * @brief Applies the intrinsics saved for the current camera, or the configured field of view.
+   */
+  void LoadCameraIntrinsics();
+
+  /**
+   * @brief Advances the field-of-view calibration sweep; applies and saves the result once it ends.
+   * @param feature Center of the highest-priority face, or nullopt if none was found
+   * @param frame Frame the detection ran on
+   * @param capture_time When the frame arrived
+   * @return Pose to command
+   */
+  [[nodiscard]] GimbalPose CalibrateFov(std::optional<Point2D> feature, const Frame& frame,
+                                        std::chrono::steady_clock::time_point capture_time);
+
+  /**
+   * @brief Allocates the next servo command ID (never 0).
+   * @return Command ID
+   */
+  [[nodiscard]] uint32_t NextCommandId() noexcept;
+
   AppConfig config_;
 
+  // Declared first so that the server and every registered metric are destroyed before it
+  metrics::Registry metrics_;
+  MetricsServer metrics_server_{metrics_};
+
   std::unique_ptr<QCoreApplication> qt_app_;
   std::unique_ptr<GuiWindow> gui_window_;
   Camera camera_;
   comm::BluetoothManager bluetooth_;
+  comm::DeviceShadow device_shadow_;
+  comm::ResponseDispatcher response_dispatcher_{device_shadow_};
+  comm::LinkMonitor link_monitor_;
 
   FaceTracker face_tracker_;
+  FaceDetectionResult detection_;  ///< Reused by ProcessFrame() (Qt thread), so its face list stops reallocating.
   FaceDetectionCallback detection_callback_;
 
   mutable std::mutex detection_mutex_;
   std::optional<FaceDetectionResult> last_detection_;
 
-  std::atomic<uint64_t> frames_processed_{0};
+  metrics::Counter frames_processed_;
+  metrics::Counter detection_failures_;
+  metrics::Counter commands_sent_;
+  metrics::Counter command_send_failures_;
+  metrics::Counter commands_suppressed_;
+  metrics::Counter commands_coalesced_;
+  metrics::Counter commands_retransmitted_;
+  metrics::Gauge send_queue_depth_;
+  metrics::Gauge link_rtt_;
+  metrics::Gauge link_jitter_;
+  metrics::Gauge link_clock_offset_;
+  metrics::Counter link_pings_lost_;
+  metrics::Gauge faces_detected_;
+  metrics::Histogram detect_duration_;
+
   std::atomic<bool> running_{false};
   std::atomic<bool> stop_requested_{false};
   bool use_gui_ = false;
 
+  // Pan/tilt control (accessed from the Qt thread only)
+  GimbalController gimbal_controller_;
+  CommandGate command_gate_;
+  bool fov_calibration_pending_ = false;         ///< Calibration requested and not yet finished.
+  std::optional<FovCalibrator> fov_calibrator_;  ///< Sweep in progress.
+
+  // Device status query after (re)connecting (accessed from the Qt thread only)
+  uint32_t status_query_id_ = 0;                                 ///< Command ID awaiting its reply, or 0.
+  std::chrono::steady_clock::time_point status_query_deadline_;  ///< When to calibrate without the reply.
+
+  // Latency instrumentation (accessed from the Qt thread only)
+  LatencyTracker latency_tracker_;
+  uint32_t next_command_id_ = 1;
+  std::chrono::steady_clock::time_point connection_epoch_;
+  std::chrono::steady_clock::time_point last_latency_report_;
+  std::chrono::steady_clock::time_point last_latency_log_;
+
   // GUI state (protected by gui_mutex_)
   mutable std::mutex gui_mutex_;
   std::chrono::steady_clock::time_point last_fps_update_;
@@ -3,6 +3,7 @@
 #include <client/pch.hpp>
 
 #include <client/app/frame.hpp>
+#include <client/core/metrics.hpp>
 
 #include <QCamera>
 #include <QCameraDevice>
@@ -254,13 +255,20 @@ public:
    * @brief Gets the total number of frames captured.
    * @return Frame count.
    */
-  [[nodiscard]] uint64_t FramesCaptured() const noexcept { return frames_captured_.load(std::memory_order_relaxed); }
+  [[nodiscard]] uint64_t FramesCaptured() const noexcept { return frames_captured_.Value(); }
 
   /**
    * @brief Gets the number of frames dropped due to throttling.
    * @return Dropped frame count.
    */
-  [[nodiscard]] uint64_t FramesDropped() const noexcept { return frames_dropped_.load(std::memory_order_relaxed); }
+  [[nodiscard]] uint64_t FramesDropped() const noexcept { return frames_dropped_.Value(); }
+
+  /**
+   * @brief Registers the camera's counters with a metrics registry.
+   * @param registry Registry to register with (must not outlive the camera)
+   * @return Expected void on success, or MetricsError on failure.
+   */
+  [[nodiscard]] auto RegisterMetrics(metrics::Registry& registry) const -> std::expected<void, metrics::MetricsError>;
 
   /**
    * @brief Gets the current camera device information.
@@ -331,8 +339,9 @@ private:
   std::chrono::steady_clock::time_point last_frame_time_{};
   std::chrono::microseconds frame_interval_{33333};  ///< Default: ~30 FPS
 
-  std::atomic<uint64_t> frames_captured_{0};
-  std::atomic<uint64_t> frames_dropped_{0};
+  metrics::Counter frames_captured_;
+  metrics::Counter frames_dropped_;
+  std::atomic<uint64_t> frame_sequence_{0};  ///< Sequence ID of the next arriving frame.
   std::atomic<int> capture_width_{0};
   std::atomic<int> capture_height_{0};
 
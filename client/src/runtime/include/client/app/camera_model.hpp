@@ -0,0 +1,247 @@
+#pragma once
+
+#include <client/pch.hpp>
+
+#include <client/app/face_data.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace client {
+
+/**
+ * @brief Pan/tilt direction in degrees.
+ * @details Positive pan turns right and positive tilt turns down, matching the image axes the
+ * servo commands are derived from.
+ */
+struct GimbalPose {
+  float pan = 0.0F;   ///< Pan angle in degrees.
+  float tilt = 0.0F;  ///< Tilt angle in degrees.
+
+  [[nodiscard]] constexpr bool operator==(const GimbalPose&) const noexcept = default;
+};
+
+/**
+ * @brief Pinhole intrinsics of a camera at one resolution, with optional radial distortion.
+ * @details Distortion follows the Brown model: a normalized point at radius r is imaged at
+ * (1 + k1 r^2 + k2 r^4) times its undistorted position.
+ */
+struct CameraIntrinsics {
+  int width = 0;    ///< Image width the intrinsics refer to.
+  int height = 0;   ///< Image height the intrinsics refer to.
+  float fx = 0.0F;  ///< Horizontal focal length in pixels.
+  float fy = 0.0F;  ///< Vertical focal length in pixels.
+  float cx = 0.0F;  ///< Principal point x in pixels.
+  float cy = 0.0F;  ///< Principal point y in pixels.
+  float k1 = 0.0F;  ///< Second-order radial distortion.
+  float k2 = 0.0F;  ///< Fourth-order radial distortion.
+
+  /**
+   * @brief Creates distortion-free intrinsics from a horizontal field of view.
+   * @param width Image width in pixels
+   * @param height Image height in pixels
+   * @param horizontal_fov_deg Horizontal field of view in degrees
+   * @return Intrinsics with square pixels and the principal point at the image center
+   */
+  [[nodiscard]] static CameraIntrinsics FromFov(int width, int height, float horizontal_fov_deg) noexcept;
+
+  /**
+   * @brief Rescales the intrinsics to another resolution of the same sensor crop.
+   * @param new_width Image width in pixels
+   * @param new_height Image height in pixels
+   * @return Scaled intrinsics (distortion is resolution independent)
+   */
+  [[nodiscard]] CameraIntrinsics ScaledTo(int new_width, int new_height) const noexcept;
+
+  /**
+   * @brief Gets the horizontal field of view of the undistorted image.
+   * @return Field of view in degrees
+   */
+  [[nodiscard]] float HorizontalFovDeg() const noexcept;
+
+  /**
+   * @brief Gets the vertical field of view of the undistorted image.
+   * @return Field of view in degrees
+   */
+  [[nodiscard]] float VerticalFovDeg() const noexcept;
+
+  /**
+   * @brief Checks whether the intrinsics describe a usable camera.
+   * @return True if the size and focal lengths are positive
+   */
+  [[nodiscard]] constexpr bool Valid() const noexcept { return width > 0 && height > 0 && fx > 0.0F && fy > 0.0F; }
+
+  [[nodiscard]] constexpr bool operator==(const CameraIntrinsics&) const noexcept = default;
+};
+
+/**
+ * @brief Maps image positions to angles from the camera axis and back.
+ * @details Angles are exact (atan of the undistorted normalized coordinate) but read from per-column
+ * and per-row tables built once for the resolution, so a lookup costs two interpolations instead of
+ * two atan calls. Pan depends only on the column and tilt only on the row, as for a gimbal that
+ * pans and tilts the camera about its optical center.
+ */
+class CameraModel {
+public:
+  /**
+   * @brief Builds the model and its lookup tables.
+   * @param intrinsics Camera intrinsics; must be Valid()
+   */
+  explicit CameraModel(const CameraIntrinsics& intrinsics);
+
+  /**
+   * @brief Converts an image position to its direction relative to the camera axis.
+   * @param pixel Position in pixels (may lie outside the image)
+   * @return Angular offset in degrees
+   */
+  [[nodiscard]] GimbalPose Angles(Point2D pixel) const noexcept;
+
+  /**
+   * @brief Converts a direction relative to the camera axis to its image position.
+   * @param offset Angular offset in degrees (each axis within +-90)
+   * @return Position in pixels, distorted as the camera images it
+   */
+  [[nodiscard]] Point2D Project(GimbalPose offset) const noexcept;
+
+  /**
+   * @brief Removes lens distortion from an image position.
+   * @param pixel Position in pixels
+   * @return Where an ideal pinhole camera with the same focal lengths would image the point
+   */
+  [[nodiscard]] Point2D Undistort(Point2D pixel) const noexcept;
+
+  /**
+   * @brief Gets the intrinsics the model was built from.
+   * @return Intrinsics
+   */
+  [[nodiscard]] const CameraIntrinsics& Intrinsics() const noexcept { return intrinsics_; }
+
+private:
+  [[nodiscard]] static float Lookup(const std::vector<float>& table, float position, float center,
+                                    float focal_length) noexcept;
+
+  CameraIntrinsics intrinsics_;
+  std::vector<float> pan_table_;   ///< Pan angle of each undistorted column 0..width.
+  std::vector<float> tilt_table_;  ///< Tilt angle of each undistorted row 0..height.
+};
+
+/**
+ * @brief Error codes for field-of-view calibration.
+ */
+enum class FovCalibrationError : uint8_t {
+  kTooFewObservations,  ///< Fewer than three poses observed on an axis.
+  kNoDisplacement,      ///< The feature did not move as the gimbal swept.
+  kImplausible          ///< The estimated field of view is outside the configured range.
+};
+
+/**
+ * @brief Converts FovCalibrationError to a human-readable string.
+ * @param error The error to convert.
+ * @return A string view representing the error.
+ */
+[[nodiscard]] constexpr std::string_view FovCalibrationErrorToString(FovCalibrationError error) noexcept {
+  switch (error) {
+    case FovCalibrationError::kTooFewObservations:
+      return "Too few observations";
+    case FovCalibrationError::kNoDisplacement:
+      return "Feature did not move during the sweep";
+    case FovCalibrationError::kImplausible:
+      return "Estimated field of view is implausible";
+  }
+  return "Unknown error";
+}
+
+/**
+ * @brief Configuration of a field-of-view calibration sweep.
+ */
+struct FovCalibrationConfig {
+  float sweep_deg = 10.0F;                ///< Furthest the sweep turns from the center on each axis.
+  int steps = 3;                          ///< Poses on each side of the center per axis.
+  std::chrono::milliseconds settle{400};  ///< Wait after commanding a pose before observing.
+  float min_fov_deg = 20.0F;              ///< Smallest plausible horizontal field of view.
+  float max_fov_deg = 150.0F;             ///< Largest plausible horizontal field of view.
+};
+
+/**
+ * @brief Estimates a camera's focal lengths by sweeping the gimbal past a fixed feature.
+ * @details The gimbal visits poses around a center on each axis; at each, once settled, the image
+ * position of a stationary feature (e.g. the face of someone holding still) is recorded. A feature
+ * at direction a appears at c + f * tan(a - pose), so per axis the focal length f and the feature
+ * direction a are fitted by least squares, with the principal point c and the distortion taken from
+ * the initial intrinsics. Drive the sweep with Next() from the detection loop, or feed observations
+ * directly with AddObservation().
+ * @note Not thread-safe.
+ */
+class FovCalibrator {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Plans a sweep.
+   * @param initial Current intrinsics; supply the resolution, principal point and distortion
+   * @param center Pose the sweep is centered on
+   * @param config Sweep configuration
+   */
+  FovCalibrator(const CameraIntrinsics& initial, GimbalPose center, const FovCalibrationConfig& config = {});
+
+  /**
+   * @brief Advances the sweep with the latest detection.
+   * @param feature Feature position in the frame, or nullopt if it was not found
+   * @param time When the frame arrived
+   * @return Pose to command, or nullopt once the sweep is done
+   */
+  [[nodiscard]] std::optional<GimbalPose> Next(std::optional<Point2D> feature, Clock::time_point time);
+
+  /**
+   * @brief Records the feature position seen with the gimbal settled at a pose.
+   * @param pose Gimbal pose
+   * @param feature Feature position in pixels
+   */
+  void AddObservation(GimbalPose pose, Point2D feature);
+
+  /**
+   * @brief Fits the focal lengths to the observations.
+   * @return Calibrated intrinsics, or FovCalibrationError
+   */
+  [[nodiscard]] auto Solve() const -> std::expected<CameraIntrinsics, FovCalibrationError>;
+
+  /**
+   * @brief Checks whether every planned pose has been observed.
+   * @return True when the sweep is complete
+   */
+  [[nodiscard]] bool Done() const noexcept { return next_pose_ >= plan_.size(); }
+
+  /**
+   * @brief Gets the planned poses.
+   * @return Poses in visiting order
+   */
+  [[nodiscard]] const std::vector<GimbalPose>& Plan() const noexcept { return plan_; }
+
+  /**
+   * @brief Gets the number of recorded observations.
+   * @return Observation count
+   */
+  [[nodiscard]] size_t Observations() const noexcept { return observations_.size(); }
+
+private:
+  /// Feature seen with the gimbal at a pose.
+  struct Observation {
+    GimbalPose pose;
+    Point2D feature;  ///< Undistorted position in pixels.
+  };
+
+  FovCalibrationConfig config_;
+  CameraIntrinsics initial_;
+  CameraModel model_;
+  std::vector<GimbalPose> plan_;
+  std::vector<Observation> observations_;
+  size_t next_pose_ = 0;
+  std::optional<Clock::time_point> commanded_at_;  ///< When plan_[next_pose_] was first commanded.
+};
+
+}  // namespace client
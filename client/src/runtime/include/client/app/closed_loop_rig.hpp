@@ -0,0 +1,163 @@
+#pragma once
+
+#include <client/pch.hpp>
+
+#include <client/app/command_gate.hpp>
+#include <client/app/face_data.hpp>
+#include <client/app/frame.hpp>
+#include <client/app/gimbal_controller.hpp>
+#include <client/app/synthetic_camera.hpp>
+#include <client/app/virtual_gimbal.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace client {
+
+/**
+ * @brief Configuration of a closed-loop simulation run.
+ * @details Latencies model the real pipeline: the camera delivers a frame capture_latency after
+ * exposure, detection finishes inference_latency after the frame arrives (frames arriving while
+ * the detector is busy are dropped, as with a throttled camera), and bytes cross the link
+ * link_latency after they are written, at most link_bytes_per_second.
+ */
+struct ClosedLoopRigConfig {
+  SyntheticCameraConfig camera;  ///< Synthetic camera.
+  TrajectoryConfig trajectory;   ///< Face motion.
+  VirtualGimbalConfig gimbal;    ///< Gimbal dynamics.
+
+  int fps = 30;                                         ///< Camera frame rate.
+  std::chrono::microseconds duration{3'000'000};        ///< Simulated run time.
+  std::chrono::microseconds tick{1'000};                ///< Simulation step.
+  std::chrono::microseconds capture_latency{10'000};    ///< Exposure to frame arrival.
+  std::chrono::microseconds inference_latency{15'000};  ///< Frame arrival to detection result.
+  std::chrono::microseconds link_latency{15'000};       ///< One-way link latency, both directions.
+  uint32_t link_bytes_per_second = 0;                   ///< Link throughput, both directions (0 = unlimited).
+  float detection_noise_px = 0.0F;                      ///< Standard deviation of ground-truth box jitter.
+  uint32_t seed = 1;                                    ///< Noise seed, for reproducible runs.
+  float settle_tolerance_deg = 2.0F;                    ///< Error within which the loop counts as settled.
+  bool record_trace = false;                            ///< Keep one ClosedLoopSample per tick.
+};
+
+/**
+ * @brief Tracking state at one simulation tick.
+ */
+struct ClosedLoopSample {
+  std::chrono::microseconds time{0};  ///< Simulated time.
+  GimbalPose face;                    ///< Face direction.
+  GimbalPose pose;                    ///< Gimbal pose.
+  GimbalPose commanded;               ///< Angles last applied by the device.
+};
+
+/**
+ * @brief Outcome of a closed-loop simulation run.
+ */
+struct ClosedLoopMetrics {
+  double rms_error_deg = 0.0;           ///< RMS angle between face and gimbal direction.
+  double max_error_deg = 0.0;           ///< Largest angle between face and gimbal direction.
+  double final_error_deg = 0.0;         ///< Angle between face and gimbal direction at the end.
+  double overshoot_deg = 0.0;           ///< Furthest either axis went past the face (for kStep).
+  uint64_t frames_captured = 0;         ///< Frames rendered.
+  uint64_t frames_dropped = 0;          ///< Frames that arrived while the detector was busy.
+  uint64_t detections = 0;              ///< Detection results handed to the controller.
+  uint64_t commands_sent = 0;           ///< MOVEs the controller issued.
+  uint64_t commands_applied = 0;        ///< MOVEs the device applied (fewer if coalesced).
+  uint64_t responses = 0;               ///< Device responses matched to a MOVE.
+  double mean_response_ms = 0.0;        ///< Mean MOVE-to-response time.
+  std::vector<ClosedLoopSample> trace;  ///< Per-tick samples (if ClosedLoopRigConfig::record_trace).
+
+  /// When the error last entered the settle tolerance, or nullopt if it ended outside.
+  std::optional<std::chrono::microseconds> settle_time;
+};
+
+/**
+ * @brief Closed-loop tracking simulation: synthetic camera, detector, controller, link and virtual gimbal.
+ * @details Each run steps a simulated clock in fixed ticks. The camera renders the face from the
+ * gimbal's current pose; the detector (ground truth by default) and the controller run on the
+ * delayed frame; the controller's target goes out as a MOVE through a comm::LinkSession over a
+ * loopback link with the configured latency and throughput to a VirtualGimbalDevice, which drives
+ * the gimbal. Nothing depends on the wall clock, so the same configuration always gives the same
+ * metrics, which makes controllers comparable on any CI machine.
+ */
+class ClosedLoopRig {
+public:
+  /**
+   * @brief Detector run on each frame; returns the faces found.
+   */
+  using Detector = std::function<FaceDetectionResult(const Frame& frame)>;
+
+  /**
+   * @brief Controller run on each detection; returns the gimbal angles to command, or nullopt to send nothing.
+   * @details Detection and frame timestamps are on the simulated clock (see SimulatedTime()).
+   */
+  using Controller = std::function<std::optional<GimbalPose>(const FaceDetectionResult& result, const Frame& frame)>;
+
+  /**
+   * @brief Constructs a rig.
+   * @param config Run configuration
+   */
+  explicit ClosedLoopRig(const ClosedLoopRigConfig& config = {});
+
+  /**
+   * @brief Replaces the ground-truth detector, e.g. with a FaceTracker on the rendered frames.
+   * @param detector Detector to use, or nullptr for ground truth
+   */
+  void SetDetector(Detector detector) { detector_ = std::move(detector); }
+
+  /**
+   * @brief Sets a callback for every frame as it arrives, before detection.
+   * @param callback Callback with the same signature as Camera::SetFrameCallback()
+   */
+  void SetFrameCallback(SyntheticCamera::FrameCallback callback) { frame_callback_ = std::move(callback); }
+
+  /**
+   * @brief Runs the simulation from rest.
+   * @param controller Controller under test
+   * @return Run metrics
+   */
+  [[nodiscard]] ClosedLoopMetrics Run(const Controller& controller);
+
+  /**
+   * @brief Converts simulated time to the steady_clock time points in frames and detections.
+   * @param time Simulated time
+   * @return Time point (never the zero time point, which marks unknown times)
+   */
+  [[nodiscard]] static std::chrono::steady_clock::time_point SimulatedTime(std::chrono::microseconds time) noexcept;
+
+  /**
+   * @brief Gets the run configuration.
+   * @return Configuration
+   */
+  [[nodiscard]] const ClosedLoopRigConfig& Config() const noexcept { return config_; }
+
+private:
+  ClosedLoopRigConfig config_;
+  SyntheticCamera camera_;
+  Detector detector_;
+  SyntheticCamera::FrameCallback frame_callback_;
+};
+
+/**
+ * @brief Controller reproducing the open-loop mapping App::HandleDetection used before GimbalController.
+ * @details Commands offset_x * 90 degrees pan and offset_y * 45 degrees tilt for the highest-priority
+ * face, ignoring where the gimbal points; the baseline other controllers are benchmarked against.
+ * @return Controller for ClosedLoopRig::Run()
+ */
+[[nodiscard]] ClosedLoopRig::Controller OpenLoopController();
+
+/**
+ * @brief Controller running a GimbalController on the highest-priority face, as the app does.
+ * @details The GimbalController keeps its state across calls, so use a new controller for each run.
+ * @param config Controller configuration; horizontal_fov_deg should match the rig's camera
+ * @param gate Command suppression, or nullopt to send every target
+ * @return Controller for ClosedLoopRig::Run()
+ */
+[[nodiscard]] ClosedLoopRig::Controller TrackingController(const GimbalControllerConfig& config = {},
+                                                           const std::optional<CommandGateConfig>& gate = std::nullopt);
+
+}  // namespace client
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <client/pch.hpp>
+
+#include <client/app/camera_model.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace client {
+
+/**
+ * @brief Configuration of a CommandGate.
+ */
+struct CommandGateConfig {
+  float min_change_deg = 0.3F;                       ///< Smallest change on either axis worth a MOVE (0 = any).
+  std::chrono::milliseconds keyframe_interval{1000};  ///< Resend the target at least this often (0 = never).
+  std::chrono::milliseconds velocity_horizon{0};      ///< How long the device extrapolates a MOVE (0 = position only).
+};
+
+/**
+ * @brief Decides which gimbal targets are worth sending.
+ * @details A target that moved less than min_change_deg on both axes from the last one sent is
+ * suppressed, since the device would spend airtime and a status reply on a move its dead zone
+ * ignores anyway. Every keyframe_interval the current target is sent regardless, so a suppressed
+ * drift or a command the device lost is corrected.
+ *
+ * With a velocity_horizon, MOVEs carry the target velocity and the device extrapolates the last
+ * one for up to that long. The gate then compares a target with where the device has taken the
+ * last one by now, so a target moving as predicted costs no airtime however far it travels, and
+ * one that stops or turns diverges from the prediction and gets through within a frame or two.
+ * @note Not thread-safe.
+ */
+class CommandGate {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Constructs a gate that passes the first target.
+   * @param config Gate configuration
+   */
+  explicit CommandGate(const CommandGateConfig& config = {}) noexcept : config_(config) {}
+
+  /**
+   * @brief Decides whether to send a target, and if so records it as sent.
+   * @param target Target about to be sent
+   * @param now Current time
+   * @return True to send the target
+   */
+  [[nodiscard]] bool ShouldSend(GimbalPose target, Clock::time_point now) noexcept {
+    return ShouldSend(target, {}, now);
+  }
+
+  /**
+   * @brief Decides whether to send a moving target, and if so records it as sent.
+   * @param target Target about to be sent
+   * @param velocity Target velocity in degrees per second (ignored without a velocity_horizon)
+   * @param now Current time
+   * @return True to send the target
+   */
+  [[nodiscard]] bool ShouldSend(GimbalPose target, GimbalPose velocity, Clock::time_point now) noexcept;
+
+  /**
+   * @brief Forgets the last target sent, e.g. on a new connection; the next target passes.
+   */
+  void Reset() noexcept { last_sent_.reset(); }
+
+  /**
+   * @brief Gets the last target sent.
+   * @return Target, or nullopt if none since construction or Reset()
+   */
+  [[nodiscard]] std::optional<GimbalPose> LastSent() const noexcept { return last_sent_; }
+
+  /**
+   * @brief Gets the number of targets suppressed.
+   * @return Suppressed target count
+   */
+  [[nodiscard]] uint64_t Suppressed() const noexcept { return suppressed_; }
+
+  /**
+   * @brief Gets the gate configuration.
+   * @return Configuration
+   */
+  [[nodiscard]] const CommandGateConfig& Config() const noexcept { return config_; }
+
+private:
+  CommandGateConfig config_;
+  std::optional<GimbalPose> last_sent_;
+  GimbalPose last_velocity_;
+  Clock::time_point last_sent_time_;
+  uint64_t suppressed_ = 0;
+};
+
+}  // namespace client
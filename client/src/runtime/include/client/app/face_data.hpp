@@ -3,6 +3,7 @@
 #include <client/pch.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -117,6 +118,23 @@ constexpr float BoundingBox::IoU(const BoundingBox& other) const noexcept {
   return union_area > 0.0F ? inter_area / union_area : 0.0F;
 }
 
+/**
+ * @brief Normalized offset of a point from the frame center.
+ * @param point Point in pixels.
+ * @param frame_width Frame width in pixels.
+ * @param frame_height Frame height in pixels.
+ * @return Offset in [-1, 1] across the frame (0 at the center, positive right and down),
+ * or (0, 0) for an empty frame.
+ */
+[[nodiscard]] constexpr Point2D NormalizedOffset(Point2D point, int frame_width, int frame_height) noexcept {
+  if (frame_width <= 0 || frame_height <= 0) {
+    return {};
+  }
+  const float center_x = static_cast<float>(frame_width) / 2.0F;
+  const float center_y = static_cast<float>(frame_height) / 2.0F;
+  return {.x = (point.x - center_x) / center_x, .y = (point.y - center_y) / center_y};
+}
+
 /**
  * @brief Data structure containing face detection results.
  */
@@ -182,6 +200,10 @@ struct FaceDetectionResult {
   uint64_t frame_id = 0;            ///< Frame identifier for tracking.
   float processing_time_ms = 0.0F;  ///< Time taken to process the frame.
 
+  uint64_t frame_sequence = 0;                         ///< Camera sequence ID of the source frame.
+  std::chrono::steady_clock::time_point capture_time;  ///< Arrival time of the source frame.
+  std::chrono::steady_clock::time_point detect_time;   ///< Time detection finished.
+
   /**
    * @brief Checks if any faces were detected.
    * @return True if at least one face was detected.
@@ -6,6 +6,7 @@
 #include <client/app/frame.hpp>
 #include <client/app/model_config.hpp>
 #include <client/core/logger.hpp>
+#include <client/core/utils/frame_arena.hpp>
 
 #include <opencv2/dnn.hpp>
 #include <opencv2/objdetect.hpp>
@@ -13,6 +14,8 @@
 #include <cstdint>
 #include <expected>
 #include <filesystem>
+#include <memory>
+#include <memory_resource>
 #include <string_view>
 #include <vector>
 
@@ -133,6 +136,16 @@ public:
    */
   [[nodiscard]] auto Detect(const Frame& frame) -> std::expected<FaceDetectionResult, FaceTrackerError>;
 
+  /**
+   * @brief Processes a frame and detects faces into an existing result.
+   * @details Reuses the capacity of @p result's face list, so a result kept across frames stops
+   * allocating once it has held the most faces seen in a frame.
+   * @param frame The input frame to process.
+   * @param result Result to overwrite; left with no faces on error.
+   * @return Expected void on success, or FaceTrackerError.
+   */
+  [[nodiscard]] auto Detect(const Frame& frame, FaceDetectionResult& result) -> std::expected<void, FaceTrackerError>;
+
   /**
    * @brief Updates the confidence threshold.
    * @param threshold New threshold value (0.0 - 1.0).
@@ -175,6 +188,16 @@ public:
    */
   [[nodiscard]] uint64_t FramesProcessed() const noexcept { return frames_processed_; }
 
+  /**
+   * @brief Gets statistics of the per-frame arena used for detection temporaries.
+   * @details `upstream_allocations` stays constant once the arena has warmed up. OpenCV still allocates
+   * inside inference, and the returned faces are copied out of the arena (see Detect()).
+   * @return Arena statistics, or default-constructed stats if not initialized.
+   */
+  [[nodiscard]] utils::FrameArenaStats ArenaStats() const noexcept {
+    return arena_ ? arena_->Stats() : utils::FrameArenaStats{};
+  }
+
 private:
   /**
    * @brief Creates a blob from the input frame for the network.
@@ -188,26 +211,33 @@ private:
    * @param faces The FaceDetectorYN output matrix.
    * @param frame_width Original frame width.
    * @param frame_height Original frame height.
-   * @return Vector of detected faces.
+   * @return Vector of detected faces, allocated from the per-frame arena.
    */
   [[nodiscard]] auto ParseYuNetDetections(const cv::Mat& faces, int frame_width, int frame_height) const
-      -> std::vector<FaceData>;
+      -> std::pmr::vector<FaceData>;
 
   /**
    * @brief Parses the network output to extract face detections.
    * @param output The network output matrix.
    * @param frame_width Original frame width.
    * @param frame_height Original frame height.
-   * @return Vector of detected faces.
+   * @return Vector of detected faces, allocated from the per-frame arena.
    */
   [[nodiscard]] auto ParseDetections(const cv::Mat& output, int frame_width, int frame_height) const
-      -> std::vector<FaceData>;
+      -> std::pmr::vector<FaceData>;
 
   cv::dnn::Net net_;                            ///< The neural network (for SSD models).
   cv::Ptr<cv::FaceDetectorYN> yunet_detector_;  ///< YuNet face detector (for YuNet models).
   FaceTrackerConfig config_;                    ///< Current configuration.
   bool use_yunet_ = false;                      ///< Whether to use YuNet API instead of raw DNN.
 
+  std::unique_ptr<utils::FrameArena> arena_;  ///< Per-frame arena for detection temporaries.
+  cv::Mat yunet_output_;                      ///< Reused YuNet output buffer.
+  mutable cv::Mat detections_scratch_;        ///< Reused buffer for reshaped SSD output.
+  mutable std::vector<cv::Rect> nms_boxes_;   ///< Reused NMS input boxes.
+  mutable std::vector<float> nms_scores_;     ///< Reused NMS input scores.
+  mutable std::vector<int> nms_indices_;      ///< Reused NMS output indices.
+
   uint64_t frames_processed_ = 0;       ///< Counter for processed frames.
   mutable uint32_t next_track_id_ = 1;  ///< Next tracking ID to assign.
   bool initialized_ = false;            ///< Initialization status.
@@ -223,6 +253,7 @@ inline FaceTracker::FaceTracker(const FaceTrackerConfig& config) {
 inline FaceTracker::FaceTracker(FaceTracker&& other) noexcept
     : net_(std::move(other.net_)),
       config_(std::move(other.config_)),
+      arena_(std::move(other.arena_)),
       frames_processed_(other.frames_processed_),
       next_track_id_(other.next_track_id_),
       initialized_(other.initialized_) {
@@ -235,6 +266,7 @@ inline FaceTracker& FaceTracker::operator=(FaceTracker&& other) noexcept {
   if (this != &other) {
     net_ = std::move(other.net_);
     config_ = std::move(other.config_);
+    arena_ = std::move(other.arena_);
     frames_processed_ = other.frames_processed_;
     next_track_id_ = other.next_track_id_;
     initialized_ = other.initialized_;
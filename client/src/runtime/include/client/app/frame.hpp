@@ -2,6 +2,7 @@
 
 #include <client/pch.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <span>
@@ -11,6 +12,17 @@
 
 namespace client {
 
+/**
+ * @brief Capture timing metadata attached to a frame.
+ */
+struct FrameTiming {
+  int64_t presentation_time_us = -1;                   ///< QVideoFrame start time in microseconds (-1 if unknown).
+  std::chrono::steady_clock::time_point arrival_time;  ///< Monotonic time the frame reached the application.
+  uint64_t sequence = 0;                               ///< Camera frame sequence ID (gaps indicate drops).
+
+  [[nodiscard]] bool operator==(const FrameTiming&) const noexcept = default;
+};
+
 /**
  * @brief Wrapper around cv::Mat representing a video frame.
  * @details Provides a type-safe interface for video frame data with ownership semantics.
@@ -37,8 +49,8 @@ public:
    */
   Frame(int width, int height, int type) : mat_(height, width, type) {}
 
-  Frame(const Frame& other) : mat_(other.mat_.clone()) {}
-  Frame(Frame&& other) noexcept : mat_(std::move(other.mat_)) {}
+  Frame(const Frame& other) : mat_(other.mat_.clone()), timing_(other.timing_) {}
+  Frame(Frame&& other) noexcept : mat_(std::move(other.mat_)), timing_(other.timing_) {}
   ~Frame() noexcept = default;
 
   Frame& operator=(const Frame& other);
@@ -137,13 +149,27 @@ public:
    */
   [[nodiscard]] const cv::Mat& Mat() const noexcept { return mat_; }
 
+  /**
+   * @brief Sets the capture timing metadata.
+   * @param timing Timing to attach to this frame.
+   */
+  void SetTiming(const FrameTiming& timing) noexcept { timing_ = timing; }
+
+  /**
+   * @brief Gets the capture timing metadata.
+   * @return Timing attached to this frame.
+   */
+  [[nodiscard]] const FrameTiming& Timing() const noexcept { return timing_; }
+
 private:
-  cv::Mat mat_;  ///< Internal OpenCV matrix.
+  cv::Mat mat_;         ///< Internal OpenCV matrix.
+  FrameTiming timing_;  ///< Capture timing metadata.
 };
 
 inline Frame& Frame::operator=(const Frame& other) {
   if (this != &other) {
     mat_ = other.mat_.clone();
+    timing_ = other.timing_;
   }
   return *this;
 }
@@ -151,6 +177,7 @@ inline Frame& Frame::operator=(const Frame& other) {
 inline Frame& Frame::operator=(Frame&& other) noexcept {
   if (this != &other) {
     mat_ = std::move(other.mat_);
+    timing_ = other.timing_;
   }
   return *this;
 }
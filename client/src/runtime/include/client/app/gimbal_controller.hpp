@@ -0,0 +1,201 @@
+#pragma once
+
+#include <client/pch.hpp>
+
+#include <client/app/camera_model.hpp>
+#include <client/app/face_data.hpp>
+#include <client/app/one_euro_filter.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+namespace client {
+
+/**
+ * @brief PID and feed-forward gains of one gimbal axis.
+ * @details The controller output is an absolute angle, so the plant integrates: kp = 1 moves the
+ * target all the way onto the face in one update and smaller values approach it geometrically.
+ */
+struct AxisGains {
+  float kp = 0.7F;                  ///< Fraction of the remaining error corrected per update.
+  float ki = 0.0F;                  ///< Integral gain (1/s), for a bias the proportional term cannot remove.
+  float kd = 0.0F;                  ///< Derivative gain (s) on the remaining error.
+  float kff = 1.0F;                 ///< Share of the face velocity fed forward (1 = no lag on a steady track).
+  float integral_limit_deg = 5.0F;  ///< Largest correction the integral term may contribute.
+};
+
+/**
+ * @brief Configuration of a GimbalController.
+ * @details The defaults are tuned with ClosedLoopRig against its default pipeline: 30 fps, frames
+ * arriving 10 ms after exposure and the servos starting about 50 ms after a frame arrives. The
+ * actuation delay spans both: a frame only shows targets issued at least that long before it arrived.
+ */
+struct GimbalControllerConfig {
+  AxisGains pan;                                  ///< Pan axis gains.
+  AxisGains tilt;                                 ///< Tilt axis gains.
+  float horizontal_fov_deg = 60.0F;               ///< Camera horizontal field of view (square pixels assumed).
+  std::optional<CameraIntrinsics> intrinsics;     ///< Calibrated intrinsics; override horizontal_fov_deg if set.
+  float deadband_deg = 0.5F;                      ///< Errors smaller than this do not move the target.
+  float max_slew_deg_per_s = 360.0F;              ///< Fastest the target may move on either axis.
+  float velocity_smoothing = 0.5F;                ///< Weight of the newest sample in the face velocity (0, 1].
+  float max_face_speed_deg_per_s = 120.0F;        ///< Faster apparent motion is a jump, which restarts the velocity.
+  float gimbal_slew_deg_per_s = 300.0F;           ///< How fast the gimbal follows a target (0 = instantly).
+  std::chrono::milliseconds lead_time{60};        ///< How far ahead of the measured face feed-forward aims.
+  std::chrono::milliseconds actuation_delay{60};  ///< How long after its frame arrived a target shows in frames.
+  std::chrono::milliseconds nominal_period{33};   ///< Update period assumed for the first detection.
+  std::chrono::milliseconds stale_after{500};     ///< Gap after which velocity and integral restart.
+  float pan_min = -90.0F;                         ///< Lowest pan target in degrees.
+  float pan_max = 90.0F;                          ///< Highest pan target in degrees.
+  float tilt_min = -45.0F;                        ///< Lowest tilt target in degrees.
+  float tilt_max = 45.0F;                         ///< Highest tilt target in degrees.
+
+  /// Adaptive smoothing of the face direction against detection jitter, or nullopt to use it raw.
+  std::optional<OneEuroConfig> smoothing = OneEuroConfig{};
+};
+
+/**
+ * @brief Closed-loop pan/tilt controller: turns face detections into absolute gimbal targets.
+ * @details The camera rides on the gimbal, so a detection only measures the face relative to where
+ * the camera pointed when the frame was exposed. The controller reconstructs the face's absolute
+ * direction from an estimate of that pose (its own targets, each reaching the gimbal actuation_delay
+ * after the frame it came from and followed at gimbal_slew_deg_per_s) and smooths it with a
+ * OneEuroFilter so detection jitter is not chased. Per axis it then moves the target towards the
+ * face with a PID on the remaining error, plus feed-forward of the face's smoothed angular velocity
+ * so a moving face is tracked without lag. Corrections below the deadband are ignored, the target
+ * moves at most max_slew_deg_per_s, and it stays within the servo range with the integral frozen
+ * while clamped.
+ *
+ * With actuation_delay and gimbal_slew_deg_per_s at zero the latest target is taken as the camera
+ * direction, which reduces the controller to integrating the measured offset.
+ * @note Not thread-safe; call from the thread that handles detections.
+ */
+class GimbalController {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Constructs a controller targeting (0, 0).
+   * @param config Controller configuration
+   */
+  explicit GimbalController(const GimbalControllerConfig& config = {})
+      : config_(config),
+        pan_filter_(config.smoothing.value_or(OneEuroConfig{})),
+        tilt_filter_(config.smoothing.value_or(OneEuroConfig{})) {}
+
+  /**
+   * @brief Updates the target from a detected face.
+   * @param face_center Face center in pixels
+   * @param frame_width Frame width in pixels
+   * @param frame_height Frame height in pixels
+   * @param capture_time When the frame arrived (not before the previous update)
+   * @return New gimbal target
+   */
+  [[nodiscard]] GimbalPose Update(Point2D face_center, int frame_width, int frame_height,
+                                  Clock::time_point capture_time) {
+    return Update(AngularOffset(face_center, frame_width, frame_height), capture_time);
+  }
+
+  /**
+   * @brief Updates the target from a measured angular offset.
+   * @param offset Face direction relative to the camera axis in degrees
+   * @param capture_time When the frame arrived (not before the previous update)
+   * @return New gimbal target
+   */
+  [[nodiscard]] GimbalPose Update(GimbalPose offset, Clock::time_point capture_time) noexcept;
+
+  /**
+   * @brief Converts a pixel position to its angle from the camera axis.
+   * @details Uses the configured intrinsics scaled to the frame, or the horizontal field of view
+   * with the principal point at the center; the lookup tables are rebuilt when the frame size changes.
+   * @param point Position in pixels
+   * @param frame_width Frame width in pixels
+   * @param frame_height Frame height in pixels
+   * @return Angular offset in degrees, or (0, 0) for an empty frame
+   */
+  [[nodiscard]] GimbalPose AngularOffset(Point2D point, int frame_width, int frame_height) const;
+
+  /**
+   * @brief Gets the intrinsics AngularOffset() uses for frames of a given size.
+   * @param frame_width Frame width in pixels (positive)
+   * @param frame_height Frame height in pixels (positive)
+   * @return Intrinsics at that resolution
+   */
+  [[nodiscard]] const CameraIntrinsics& IntrinsicsFor(int frame_width, int frame_height) const {
+    return ModelFor(frame_width, frame_height).Intrinsics();
+  }
+
+  /**
+   * @brief Replaces the camera intrinsics, e.g. with the result of a FovCalibrator.
+   * @param intrinsics Intrinsics at any resolution, or nullopt to use horizontal_fov_deg
+   */
+  void SetIntrinsics(const std::optional<CameraIntrinsics>& intrinsics);
+
+  /**
+   * @brief Restarts control from a known target, e.g. after the gimbal was moved manually.
+   * @param target Angles the gimbal is at
+   */
+  void Reset(GimbalPose target = {}) noexcept;
+
+  /**
+   * @brief Gets the current target.
+   * @return Last target returned by Update(), or the Reset() target
+   */
+  [[nodiscard]] GimbalPose Target() const noexcept { return target_; }
+
+  /**
+   * @brief Gets the estimated angular velocity of the face.
+   * @return Smoothed velocity in degrees per second
+   */
+  [[nodiscard]] GimbalPose Velocity() const noexcept { return {.pan = pan_.velocity, .tilt = tilt_.velocity}; }
+
+  /**
+   * @brief Gets the controller configuration.
+   * @return Configuration
+   */
+  [[nodiscard]] const GimbalControllerConfig& Config() const noexcept { return config_; }
+
+private:
+  /// Per-axis controller state.
+  struct AxisState {
+    float integral = 0.0F;        ///< Integral of the remaining error (deg * s).
+    float previous_error = 0.0F;  ///< Remaining error at the previous update.
+    float previous_face = 0.0F;   ///< Face direction at the previous update.
+    float velocity = 0.0F;        ///< Smoothed face velocity (deg/s).
+  };
+
+  /// Target issued by one update.
+  struct Issued {
+    Clock::time_point time;  ///< Frame arrival time of the update.
+    GimbalPose target;       ///< Target returned.
+  };
+
+  static constexpr size_t kMaxPending = 32;
+
+  [[nodiscard]] const CameraModel& ModelFor(int frame_width, int frame_height) const;
+  [[nodiscard]] float UpdateAxis(const AxisGains& gains, AxisState& state, float face, float target, float min,
+                                 float max, float dt, bool restart) const noexcept;
+  [[nodiscard]] GimbalPose CameraPoseAt(Clock::time_point capture_time) noexcept;
+  void Follow(GimbalPose target, Clock::time_point until) noexcept;
+
+  GimbalControllerConfig config_;
+  mutable std::optional<CameraModel> camera_model_;  ///< Model at the last frame size seen.
+  GimbalPose target_;
+  AxisState pan_;
+  AxisState tilt_;
+  OneEuroFilter pan_filter_;   ///< Smooths the pan face direction (if config_.smoothing).
+  OneEuroFilter tilt_filter_;  ///< Smooths the tilt face direction (if config_.smoothing).
+  Clock::time_point last_update_;
+  bool updated_ = false;  ///< Whether Update() ran since the last Reset().
+
+  // Estimated gimbal pose: targets not yet in effect wait in a ring, in issue order
+  GimbalPose camera_;              ///< Estimated pose at camera_time_.
+  GimbalPose applied_;             ///< Target the gimbal is following at camera_time_.
+  Clock::time_point camera_time_;  ///< Issue-time equivalent of the estimate (shifted by actuation_delay).
+  std::array<Issued, kMaxPending> pending_{};
+  size_t pending_first_ = 0;
+  size_t pending_count_ = 0;
+};
+
+}  // namespace client
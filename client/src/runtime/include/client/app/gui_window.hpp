@@ -4,6 +4,9 @@
 
 #include <client/app/face_data.hpp>
 #include <client/app/frame.hpp>
+#include <client/app/latency_tracker.hpp>
+#include <client/comm/device_shadow.hpp>
+#include <client/comm/link_monitor.hpp>
 #include <client/core/logger.hpp>
 
 #include <QImage>
@@ -131,6 +134,9 @@ class GuiBackend final : public QObject {
   Q_PROPERTY(int connectionState READ ConnectionStateValue NOTIFY connectionStateChanged)
   Q_PROPERTY(QString connectionErrorMessage READ ConnectionErrorMessage NOTIFY connectionStateChanged)
   Q_PROPERTY(QVariantList availableDevices READ AvailableDevices NOTIFY availableDevicesChanged)
+  Q_PROPERTY(QVariantMap latency READ Latency NOTIFY latencyChanged)
+  Q_PROPERTY(QVariantMap device READ Device NOTIFY deviceChanged)
+  Q_PROPERTY(QVariantMap link READ Link NOTIFY linkChanged)
 
 public:
   /**
@@ -196,6 +202,15 @@ public:
   using CalibrateCallback = std::function<void()>;
 #endif
 
+  /**
+   * @brief Callback type for trace dump requests.
+   */
+#if defined(__cpp_lib_move_only_function)
+  using TraceDumpCallback = std::move_only_function<void()>;
+#else
+  using TraceDumpCallback = std::function<void()>;
+#endif
+
   explicit GuiBackend(QObject* parent = nullptr) : QObject(parent) { CLIENT_INFO("GuiBackend created"); }
   GuiBackend(const GuiBackend&) = delete;
   GuiBackend(GuiBackend&&) = delete;
@@ -218,6 +233,24 @@ public:
    */
   void UpdateFaces(const FaceDetectionResult& result);
 
+  /**
+   * @brief Updates the latency percentiles displayed in QML.
+   * @param snapshot Latency snapshot
+   */
+  void UpdateLatency(const LatencySnapshot& snapshot);
+
+  /**
+   * @brief Updates the device state displayed in QML.
+   * @param state Device state snapshot
+   */
+  void UpdateDeviceState(const comm::DeviceState& state);
+
+  /**
+   * @brief Updates the link statistics displayed in QML.
+   * @param stats Link statistics snapshot
+   */
+  void UpdateLink(const comm::LinkStats& stats);
+
   /**
    * @brief Updates the camera list in the UI.
    * @param cameras List of available cameras.
@@ -290,6 +323,12 @@ public:
    */
   void SetCalibrateCallback(CalibrateCallback callback) noexcept { calibrate_callback_ = std::move(callback); }
 
+  /**
+   * @brief Sets the trace dump callback.
+   * @param callback Callback to invoke when user requests a trace dump
+   */
+  void SetTraceDumpCallback(TraceDumpCallback callback) noexcept { trace_dump_callback_ = std::move(callback); }
+
   // Property getters
   [[nodiscard]] qreal Fps() const noexcept { return fps_.load(std::memory_order_relaxed); }
 
@@ -327,6 +366,21 @@ public:
     return available_devices_;
   }
 
+  [[nodiscard]] QVariantMap Latency() const noexcept {
+    std::shared_lock lock(data_mutex_);
+    return latency_;
+  }
+
+  [[nodiscard]] QVariantMap Device() const noexcept {
+    std::shared_lock lock(data_mutex_);
+    return device_;
+  }
+
+  [[nodiscard]] QVariantMap Link() const noexcept {
+    std::shared_lock lock(data_mutex_);
+    return link_;
+  }
+
   /**
    * @brief Gets the camera list as QVariantList for QML.
    * @return List of camera info objects
@@ -373,6 +427,11 @@ public slots:
    */
   void calibrateDevice();
 
+  /**
+   * @brief Called from QML when user wants to dump recent trace spans.
+   */
+  void dumpTrace();
+
 signals:
   void statsChanged();
   void facesChanged();
@@ -381,6 +440,9 @@ signals:
   void cameraListChanged();
   void connectionStateChanged();
   void availableDevicesChanged();
+  void latencyChanged();
+  void deviceChanged();
+  void linkChanged();
   void quitRequested();
 
 private:
@@ -396,6 +458,9 @@ private:
   QVariantList camera_list_;
   QVariantList available_devices_;
   QString connection_error_message_;
+  QVariantMap latency_;
+  QVariantMap device_;
+  QVariantMap link_;
 
   CameraSwitchCallback camera_switch_callback_;
   ModelSwitchCallback model_switch_callback_;
@@ -404,6 +469,7 @@ private:
   DisconnectCallback disconnect_callback_;
   ScanCallback scan_callback_;
   CalibrateCallback calibrate_callback_;
+  TraceDumpCallback trace_dump_callback_;
 };
 
 /**
@@ -478,6 +544,15 @@ public:
   using CalibrateCallback = std::function<void()>;
 #endif
 
+  /**
+   * @brief Callback type for trace dump requests.
+   */
+#if defined(__cpp_lib_move_only_function)
+  using TraceDumpCallback = std::move_only_function<void()>;
+#else
+  using TraceDumpCallback = std::function<void()>;
+#endif
+
   /**
    * @brief Constructs the GUI window.
    * @param parent Optional parent object.
@@ -530,6 +605,24 @@ public:
    */
   void UpdateStats(float fps, uint64_t frames_processed, size_t faces_detected);
 
+  /**
+   * @brief Updates the latency display.
+   * @param snapshot Latency snapshot
+   */
+  void UpdateLatency(const LatencySnapshot& snapshot);
+
+  /**
+   * @brief Updates the device state display.
+   * @param state Device state snapshot
+   */
+  void UpdateDeviceState(const comm::DeviceState& state);
+
+  /**
+   * @brief Updates the link statistics display.
+   * @param stats Link statistics snapshot
+   */
+  void UpdateLink(const comm::LinkStats& stats);
+
   /**
    * @brief Updates the list of available Bluetooth devices.
    * @param devices List of discovered devices
@@ -591,6 +684,12 @@ public:
    */
   void SetCalibrateCallback(CalibrateCallback callback) noexcept;
 
+  /**
+   * @brief Sets the trace dump callback.
+   * @param callback Callback to invoke when user requests a trace dump
+   */
+  void SetTraceDumpCallback(TraceDumpCallback callback) noexcept;
+
   /**
    * @brief Checks if the window is visible.
    * @return True if visible
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <client/pch.hpp>
+
+#include <client/core/utils/latency_histogram.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace client {
+
+/**
+ * @brief Stages of the motion-to-servo pipeline measured by LatencyTracker.
+ */
+enum class LatencyStage : uint8_t {
+  kCaptureToDetect = 0,  ///< Frame arrival to detection finished.
+  kDetectToSend,         ///< Detection finished to servo command written.
+  kSendToAck,            ///< Servo command written to device response received.
+  kCaptureToAck,         ///< Frame arrival to device response received (end-to-end).
+};
+
+inline constexpr size_t kLatencyStageCount = 4;
+
+/**
+ * @brief Converts LatencyStage to a human-readable string.
+ * @param stage The stage to convert
+ * @return A string view representing the stage
+ */
+[[nodiscard]] constexpr std::string_view LatencyStageToString(LatencyStage stage) noexcept {
+  switch (stage) {
+    case LatencyStage::kCaptureToDetect:
+      return "capture->detect";
+    case LatencyStage::kDetectToSend:
+      return "detect->send";
+    case LatencyStage::kSendToAck:
+      return "send->ack";
+    case LatencyStage::kCaptureToAck:
+      return "capture->ack";
+    default:
+      return "unknown";
+  }
+}
+
+/**
+ * @brief Percentile summary of a single latency stage.
+ */
+struct LatencyPercentiles {
+  double p50_ms = 0.0;  ///< Median latency in milliseconds.
+  double p95_ms = 0.0;  ///< 95th percentile latency in milliseconds.
+  double p99_ms = 0.0;  ///< 99th percentile latency in milliseconds.
+  uint64_t count = 0;   ///< Number of samples.
+};
+
+/**
+ * @brief Snapshot of all latency stages.
+ */
+struct LatencySnapshot {
+  std::array<LatencyPercentiles, kLatencyStageCount> stages{};  ///< Per-stage percentiles.
+  uint64_t unmatched_acks = 0;                                  ///< Responses with no matching in-flight command.
+  uint64_t evicted = 0;                                         ///< In-flight commands overwritten before an ack.
+
+  /**
+   * @brief Gets the percentiles of a stage.
+   * @param stage Stage to look up
+   * @return Percentiles for the stage
+   */
+  [[nodiscard]] constexpr const LatencyPercentiles& Stage(LatencyStage stage) const noexcept {
+    return stages[static_cast<size_t>(stage)];
+  }
+};
+
+/**
+ * @brief Tracks capture->detect->send->ack latency of servo commands.
+ * @details Commands are matched to device responses by command ID. In-flight commands are kept in a
+ * fixed ring indexed by ID, so tracking never allocates; a command whose slot is reused before its
+ * ack arrives is counted as evicted.
+ * @note Record* methods must be called from a single thread. Snapshot() may be called from any thread.
+ */
+class LatencyTracker {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr size_t kMaxInFlight = 64;
+
+  LatencyTracker() noexcept = default;
+  LatencyTracker(const LatencyTracker&) = delete;
+  LatencyTracker(LatencyTracker&&) = delete;
+  ~LatencyTracker() noexcept = default;
+
+  LatencyTracker& operator=(const LatencyTracker&) = delete;
+  LatencyTracker& operator=(LatencyTracker&&) = delete;
+
+  /**
+   * @brief Records that a frame finished detection.
+   * @param capture_time Frame arrival time
+   * @param detect_time Detection completion time
+   */
+  void RecordDetection(Clock::time_point capture_time, Clock::time_point detect_time) noexcept;
+
+  /**
+   * @brief Records that a servo command was sent for a detected frame.
+   * @param command_id ID carried by the command (0 is ignored)
+   * @param capture_time Arrival time of the frame the command was derived from
+   * @param detect_time Detection completion time
+   * @param send_time Time the command was handed to the transport
+   */
+  void RecordSent(uint32_t command_id, Clock::time_point capture_time, Clock::time_point detect_time,
+                  Clock::time_point send_time) noexcept;
+
+  /**
+   * @brief Records a device response.
+   * @param command_id ID echoed by the device
+   * @param ack_time Time the response was received
+   * @return True if the response matched an in-flight command
+   */
+  bool RecordAck(uint32_t command_id, Clock::time_point ack_time) noexcept;
+
+  /**
+   * @brief Clears all histograms and in-flight commands.
+   */
+  void Reset() noexcept;
+
+  /**
+   * @brief Gets the current percentiles of all stages.
+   * @return Latency snapshot
+   */
+  [[nodiscard]] LatencySnapshot Snapshot() const noexcept;
+
+  /**
+   * @brief Gets the histogram of a stage.
+   * @param stage Stage to look up
+   * @return Histogram in microseconds
+   */
+  [[nodiscard]] const utils::LatencyHistogram& Histogram(LatencyStage stage) const noexcept {
+    return histograms_[static_cast<size_t>(stage)];
+  }
+
+private:
+  struct InFlight {
+    uint32_t command_id = 0;
+    Clock::time_point capture_time;
+    Clock::time_point send_time;
+  };
+
+  [[nodiscard]] utils::LatencyHistogram& HistogramFor(LatencyStage stage) noexcept {
+    return histograms_[static_cast<size_t>(stage)];
+  }
+
+  std::array<InFlight, kMaxInFlight> in_flight_{};
+  std::array<utils::LatencyHistogram, kLatencyStageCount> histograms_;
+  std::atomic<uint64_t> unmatched_acks_{0};
+  std::atomic<uint64_t> evicted_{0};
+};
+
+}  // namespace client
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <client/pch.hpp>
+
+#include <client/core/metrics.hpp>
+
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <string_view>
+
+class QLocalServer;
+class QTcpServer;
+
+namespace client {
+
+/**
+ * @brief Error codes for the metrics endpoint.
+ */
+enum class MetricsServerError : uint8_t {
+  kNotConfigured,   ///< Neither a port nor a socket path was given.
+  kAlreadyRunning,  ///< Server is already listening.
+  kListenFailed,    ///< Could not bind the TCP port or Unix socket.
+};
+
+/**
+ * @brief Converts MetricsServerError to a human-readable string.
+ * @param error The error to convert
+ * @return A string view representing the error
+ */
+[[nodiscard]] constexpr std::string_view MetricsServerErrorToString(MetricsServerError error) noexcept {
+  switch (error) {
+    case MetricsServerError::kNotConfigured:
+      return "Metrics endpoint not configured";
+    case MetricsServerError::kAlreadyRunning:
+      return "Metrics endpoint already running";
+    case MetricsServerError::kListenFailed:
+      return "Failed to listen for metrics scrapes";
+    default:
+      return "Unknown error";
+  }
+}
+
+/**
+ * @brief Metrics endpoint configuration.
+ */
+struct MetricsServerConfig {
+  uint16_t port = 0;        ///< TCP port on localhost (0 = disabled).
+  std::string socket_path;  ///< Unix domain socket path (empty = disabled).
+
+  /**
+   * @brief Checks if any endpoint is configured.
+   * @return True if a port or socket path is set
+   */
+  [[nodiscard]] bool Enabled() const noexcept { return port != 0 || !socket_path.empty(); }
+};
+
+/**
+ * @brief Serves a metrics registry in Prometheus text format over HTTP.
+ * @details Listens on localhost TCP and/or a Unix domain socket and answers
+ * `GET /metrics` with Registry::Expose(). Each connection serves a single request
+ * (HTTP/1.0, `Connection: close`).
+ * @note Runs on the Qt event loop of the thread that calls Start().
+ */
+class MetricsServer {
+public:
+  /**
+   * @brief Constructs a metrics server.
+   * @param registry Registry to expose (must outlive the server)
+   */
+  explicit MetricsServer(const metrics::Registry& registry) noexcept;
+  MetricsServer(const MetricsServer&) = delete;
+  MetricsServer(MetricsServer&&) = delete;
+  ~MetricsServer();
+
+  MetricsServer& operator=(const MetricsServer&) = delete;
+  MetricsServer& operator=(MetricsServer&&) = delete;
+
+  /**
+   * @brief Starts listening.
+   * @param config Endpoint configuration
+   * @return Expected void on success, or MetricsServerError on failure
+   */
+  [[nodiscard]] auto Start(const MetricsServerConfig& config) -> std::expected<void, MetricsServerError>;
+
+  /**
+   * @brief Stops listening and closes the Unix socket.
+   */
+  void Stop() noexcept;
+
+  /**
+   * @brief Checks if the server is listening.
+   * @return True if listening on any endpoint
+   */
+  [[nodiscard]] bool Running() const noexcept { return tcp_server_ != nullptr || local_server_ != nullptr; }
+
+  /**
+   * @brief Gets the bound TCP port.
+   * @return Port, or 0 if not listening on TCP
+   */
+  [[nodiscard]] uint16_t Port() const noexcept;
+
+  /**
+   * @brief Builds the HTTP response for a request line.
+   * @param request_line First line of the HTTP request (e.g. `GET /metrics HTTP/1.1`)
+   * @param registry Registry to expose
+   * @return Complete HTTP/1.0 response including headers
+   */
+  [[nodiscard]] static std::string BuildResponse(std::string_view request_line, const metrics::Registry& registry);
+
+private:
+  const metrics::Registry& registry_;
+  std::unique_ptr<QTcpServer> tcp_server_;
+  std::unique_ptr<QLocalServer> local_server_;
+};
+
+}  // namespace client
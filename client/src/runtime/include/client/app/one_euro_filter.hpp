@@ -0,0 +1,72 @@
+#pragma once
+
+#include <client/pch.hpp>
+
+namespace client {
+
+/**
+ * @brief Configuration of a OneEuroFilter.
+ * @details Tuning: lower min_cutoff_hz until a still signal stops jittering, then raise beta until
+ * fast motion stops lagging. The defaults suit face directions in degrees at camera frame rates.
+ */
+struct OneEuroConfig {
+  float min_cutoff_hz = 1.0F;         ///< Cutoff while the signal is still.
+  float beta = 1.0F;                  ///< Cutoff increase per unit/s of signal speed.
+  float derivative_cutoff_hz = 1.0F;  ///< Cutoff of the speed estimate that drives the adaptation.
+};
+
+/**
+ * @brief One-Euro filter: a first-order low-pass whose cutoff rises with the signal's speed.
+ * @details Slow movement is smoothed hard, removing jitter, while fast movement passes with little
+ * lag (Casiez et al., CHI 2012). Samples may arrive at irregular intervals.
+ * @note Not thread-safe.
+ */
+class OneEuroFilter {
+public:
+  /**
+   * @brief Constructs a filter with no history.
+   * @param config Filter configuration
+   */
+  explicit OneEuroFilter(const OneEuroConfig& config = {}) noexcept : config_(config) {}
+
+  /**
+   * @brief Filters the next sample.
+   * @param value Raw sample
+   * @param dt Seconds since the previous sample (positive); ignored for the first sample
+   * @return Filtered value (the sample itself for the first one)
+   */
+  [[nodiscard]] float Filter(float value, float dt) noexcept;
+
+  /**
+   * @brief Forgets the history; the next sample passes through unfiltered.
+   */
+  void Reset() noexcept { initialized_ = false; }
+
+  /**
+   * @brief Gets the last filtered value.
+   * @return Filtered value, or 0 before the first sample
+   */
+  [[nodiscard]] float Value() const noexcept { return initialized_ ? value_ : 0.0F; }
+
+  /**
+   * @brief Gets the speed estimate that drives the cutoff.
+   * @details Measured from the last filtered value, as in the original filter, so it runs ahead of
+   * the true speed by the filter's lag.
+   * @return Smoothed speed in units per second, or 0 before the second sample
+   */
+  [[nodiscard]] float Derivative() const noexcept { return initialized_ ? derivative_ : 0.0F; }
+
+  /**
+   * @brief Gets the filter configuration.
+   * @return Configuration
+   */
+  [[nodiscard]] const OneEuroConfig& Config() const noexcept { return config_; }
+
+private:
+  OneEuroConfig config_;
+  bool initialized_ = false;
+  float value_ = 0.0F;
+  float derivative_ = 0.0F;
+};
+
+}  // namespace client
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <client/pch.hpp>
+
+#include <client/app/face_data.hpp>
+#include <client/app/frame.hpp>
+#include <client/app/gimbal_controller.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace client {
+
+/**
+ * @brief Scripted motion of the synthetic face.
+ */
+enum class TrajectoryKind : uint8_t {
+  kStatic,      ///< Stays at the start direction.
+  kStep,        ///< Jumps by the amplitude at the step time.
+  kRamp,        ///< Moves at a constant angular velocity.
+  kSine,        ///< Oscillates by the amplitude around the start direction.
+  kFigureEight  ///< Lissajous figure eight: tilt at twice the pan frequency.
+};
+
+/**
+ * @brief Converts TrajectoryKind to a human-readable string.
+ * @param kind The trajectory kind to convert.
+ * @return A string view representing the trajectory kind.
+ */
+[[nodiscard]] constexpr std::string_view TrajectoryKindToString(TrajectoryKind kind) noexcept {
+  switch (kind) {
+    case TrajectoryKind::kStatic:
+      return "static";
+    case TrajectoryKind::kStep:
+      return "step";
+    case TrajectoryKind::kRamp:
+      return "ramp";
+    case TrajectoryKind::kSine:
+      return "sine";
+    case TrajectoryKind::kFigureEight:
+      return "figure-eight";
+  }
+  return "unknown";
+}
+
+/**
+ * @brief Configuration of a scripted face trajectory.
+ * @details Directions are gimbal angles: a face at (pan, tilt) is centered in the image when the
+ * gimbal points at (pan, tilt).
+ */
+struct TrajectoryConfig {
+  TrajectoryKind kind = TrajectoryKind::kStep;       ///< Motion pattern.
+  GimbalPose start;                                  ///< Direction at time zero.
+  GimbalPose amplitude{.pan = 15.0F, .tilt = 8.0F};  ///< Step size, or peak offset of kSine and kFigureEight.
+  GimbalPose velocity{.pan = 10.0F, .tilt = 0.0F};   ///< Angular velocity of kRamp in degrees per second.
+  std::chrono::microseconds step_time{500'000};      ///< Time of the kStep jump.
+  std::chrono::microseconds period{4'000'000};       ///< Period of kSine and of the kFigureEight pan axis.
+};
+
+/**
+ * @brief Face direction over time along a scripted trajectory.
+ */
+class FaceTrajectory {
+public:
+  /**
+   * @brief Constructs a trajectory.
+   * @param config Trajectory configuration.
+   */
+  explicit FaceTrajectory(const TrajectoryConfig& config = {}) noexcept : config_(config) {}
+
+  /**
+   * @brief Gets the face direction.
+   * @param time Simulated time since the start of the run.
+   * @return Direction in gimbal angles.
+   */
+  [[nodiscard]] GimbalPose At(std::chrono::microseconds time) const noexcept;
+
+  /**
+   * @brief Gets the trajectory configuration.
+   * @return Configuration.
+   */
+  [[nodiscard]] const TrajectoryConfig& Config() const noexcept { return config_; }
+
+private:
+  TrajectoryConfig config_;
+};
+
+/**
+ * @brief Configuration of the synthetic camera.
+ */
+struct SyntheticCameraConfig {
+  int width = 640;                   ///< Frame width in pixels.
+  int height = 480;                  ///< Frame height in pixels.
+  float horizontal_fov_deg = 60.0F;  ///< Horizontal field of view in degrees (square pixels).
+  float face_width_deg = 12.0F;      ///< Angular width of the face.
+  float face_aspect = 1.25F;         ///< Face height over width.
+};
+
+/**
+ * @brief Pinhole camera riding on a virtual gimbal that renders a face sprite.
+ * @details Projects the face direction relative to the gimbal pose through an ideal pinhole
+ * (principal point at the frame center) and draws the face as a filled ellipse with eyes on a
+ * plain background. Project() gives the matching ground-truth bounding box, so a controller can be
+ * exercised without a detector, or a real FaceTracker can be run on the rendered frames.
+ * Frames are delivered through the same callback signature as Camera::SetFrameCallback().
+ */
+class SyntheticCamera {
+public:
+  /**
+   * @brief Callback type for receiving rendered frames (same signature as Camera::FrameCallback).
+   */
+#if __cpp_lib_move_only_function >= 202110L
+  using FrameCallback = std::move_only_function<void(const Frame&)>;
+#else
+  using FrameCallback = std::function<void(const Frame&)>;
+#endif
+
+  /**
+   * @brief Constructs a camera.
+   * @param config Camera configuration.
+   */
+  explicit SyntheticCamera(const SyntheticCameraConfig& config = {}) noexcept;
+
+  /**
+   * @brief Gets the ground-truth bounding box of the face.
+   * @param face Face direction in gimbal angles.
+   * @param pose Gimbal pose the camera looks along.
+   * @return Bounding box in pixels, or nullopt if no part of the face is in view.
+   */
+  [[nodiscard]] auto Project(GimbalPose face, GimbalPose pose) const noexcept -> std::optional<BoundingBox>;
+
+  /**
+   * @brief Renders a frame.
+   * @param face Face direction in gimbal angles.
+   * @param pose Gimbal pose the camera looks along.
+   * @param timing Capture timing attached to the frame.
+   * @return Rendered BGR frame.
+   */
+  [[nodiscard]] Frame Render(GimbalPose face, GimbalPose pose, const FrameTiming& timing) const;
+
+  /**
+   * @brief Renders a frame and delivers it to the frame callback.
+   * @param face Face direction in gimbal angles.
+   * @param pose Gimbal pose the camera looks along.
+   * @param timing Capture timing attached to the frame.
+   */
+  void Capture(GimbalPose face, GimbalPose pose, const FrameTiming& timing);
+
+  /**
+   * @brief Sets the callback for captured frames.
+   * @param callback Callback to invoke with each frame from Capture().
+   */
+  void SetFrameCallback(FrameCallback callback) noexcept { frame_callback_ = std::move(callback); }
+
+  /**
+   * @brief Gets the focal length.
+   * @return Focal length in pixels.
+   */
+  [[nodiscard]] float FocalLength() const noexcept { return focal_length_; }
+
+  /**
+   * @brief Gets the camera configuration.
+   * @return Configuration.
+   */
+  [[nodiscard]] const SyntheticCameraConfig& Config() const noexcept { return config_; }
+
+private:
+  SyntheticCameraConfig config_;
+  float focal_length_ = 0.0F;  ///< Pixels per unit of tan(angle).
+  FrameCallback frame_callback_;
+};
+
+}  // namespace client
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <client/pch.hpp>
+
+#include <client/app/gimbal_controller.hpp>
+#include <client/comm/framing.hpp>
+#include <client/comm/transport.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace client {
+
+/**
+ * @brief Characteristics of a simulated pan/tilt gimbal.
+ * @details The defaults match the firmware's servo range and the host firmware simulator's servo model.
+ */
+struct VirtualGimbalConfig {
+  float slew_deg_per_s = 300.0F;                 ///< Fastest either axis turns.
+  std::chrono::microseconds pwm_period{20'000};  ///< PWM period; a new command takes effect at the next period.
+  float pan_min = -90.0F;                        ///< Lowest pan angle in degrees.
+  float pan_max = 90.0F;                         ///< Highest pan angle in degrees.
+  float tilt_min = -45.0F;                       ///< Lowest tilt angle in degrees.
+  float tilt_max = 45.0F;                        ///< Highest tilt angle in degrees.
+};
+
+/**
+ * @brief Simulated pan/tilt gimbal: follows commanded angles at a limited slew rate.
+ * @details A command reaches the servos at the start of the next PWM period, as on the device;
+ * from there each axis turns towards its target at VirtualGimbalConfig::slew_deg_per_s. Poses
+ * are computed analytically from the command history on a simulated clock, so nothing has to
+ * step the model and runs are reproducible.
+ * @note Not thread-safe.
+ */
+class VirtualGimbal {
+public:
+  using Duration = std::chrono::microseconds;
+
+  /**
+   * @brief Constructs a gimbal resting at (0, 0).
+   * @param config Gimbal characteristics
+   */
+  explicit VirtualGimbal(const VirtualGimbalConfig& config = {}) noexcept : config_(config) {}
+
+  /**
+   * @brief Commands new angles, clamped to the configured range.
+   * @param target Commanded angles
+   * @param now Simulated time of the command (not before the previous one)
+   */
+  void Command(GimbalPose target, Duration now) noexcept;
+
+  /**
+   * @brief Gets where the gimbal points.
+   * @param now Simulated time (not before the last Command())
+   * @return Current angles
+   */
+  [[nodiscard]] GimbalPose Pose(Duration now) const noexcept;
+
+  /**
+   * @brief Gets the most recently commanded angles.
+   * @return Commanded angles after clamping
+   */
+  [[nodiscard]] GimbalPose Commanded() const noexcept { return current_.target; }
+
+  /**
+   * @brief Checks whether the gimbal has yet to reach the commanded angles.
+   * @param now Simulated time
+   * @return True while either axis is moving or a command is waiting for the next period
+   */
+  [[nodiscard]] bool Moving(Duration now) const noexcept { return Pose(now) != current_.target; }
+
+  /**
+   * @brief Places the gimbal at rest.
+   * @param pose Resting angles
+   */
+  void Reset(GimbalPose pose = {}) noexcept;
+
+  /**
+   * @brief Gets the gimbal characteristics.
+   * @return Configuration
+   */
+  [[nodiscard]] const VirtualGimbalConfig& Config() const noexcept { return config_; }
+
+private:
+  /// Motion from a known pose towards a target, starting at a PWM period boundary.
+  struct Segment {
+    Duration start{0};
+    GimbalPose from;
+    GimbalPose target;
+
+    [[nodiscard]] GimbalPose At(Duration now, float slew_deg_per_s) const noexcept;
+  };
+
+  [[nodiscard]] GimbalPose Clamp(GimbalPose pose) const noexcept;
+
+  VirtualGimbalConfig config_;
+  Segment previous_;  ///< Motion until current_ takes effect.
+  Segment current_;   ///< Motion from the latest command on.
+};
+
+/**
+ * @brief Device end of a link that drives a VirtualGimbal.
+ * @details Speaks enough of the firmware protocol for LinkSession: accepts the protocol v2
+ * handshake with compact control (without windowed acks), applies compact and protobuf MOVEs to
+ * the gimbal and answers each with its status. Commands take effect at the simulated time last
+ * passed to SetTime().
+ * @note Not thread-safe; drive it from the thread that pumps the transport.
+ */
+class VirtualGimbalDevice {
+public:
+  /**
+   * @brief Attaches to the device end of a transport.
+   * @param transport Device end; must outlive this object
+   * @param gimbal Gimbal to drive; must outlive this object
+   */
+  VirtualGimbalDevice(comm::ITransport& transport, VirtualGimbal& gimbal);
+
+  VirtualGimbalDevice(const VirtualGimbalDevice&) = delete;
+  VirtualGimbalDevice(VirtualGimbalDevice&&) = delete;
+  ~VirtualGimbalDevice();
+
+  VirtualGimbalDevice& operator=(const VirtualGimbalDevice&) = delete;
+  VirtualGimbalDevice& operator=(VirtualGimbalDevice&&) = delete;
+
+  /**
+   * @brief Sets the simulated time applied to incoming commands.
+   * @param now Simulated time
+   */
+  void SetTime(VirtualGimbal::Duration now) noexcept { now_ = now; }
+
+  /**
+   * @brief Gets the number of MOVE commands applied.
+   * @return MOVE count
+   */
+  [[nodiscard]] size_t Moves() const noexcept { return moves_; }
+
+private:
+  void OnFrame(const comm::Frame& frame);
+  void OnHandshake();
+  void OnCompactMove(std::span<const uint8_t> payload);
+  void OnCommand(std::span<const uint8_t> payload);
+  void Send(comm::FrameType type, std::span<const uint8_t> payload);
+
+  comm::ITransport& transport_;
+  VirtualGimbal& gimbal_;
+  comm::FrameDecoder decoder_;
+  VirtualGimbal::Duration now_{0};
+  size_t moves_ = 0;
+};
+
+}  // namespace client
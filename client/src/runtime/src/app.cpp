@@ -4,18 +4,22 @@
 #include <client/app/model_config.hpp>
 #include <client/core/assert.hpp>
 #include <client/core/logger.hpp>
+#include <client/core/tracing.hpp>
 
 #include <QApplication>
 #include <QCommandLineOption>
 #include <QCommandLineParser>
 #include <QCoreApplication>
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QGuiApplication>
 #include <QQuickStyle>
+#include <QSettings>
 #include <QStandardPaths>
 #include <QTimer>
+#include <QUrl>
 
 #ifdef Q_OS_ANDROID
 #include <QCoreApplication>
@@ -23,11 +27,14 @@
 #include <QPermissions>
 #endif
 
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <expected>
+#include <filesystem>
+#include <format>
 #include <mutex>
 #include <string>
 #include <string_view>
@@ -50,6 +57,64 @@ namespace client {
 
 namespace {
 
+constexpr auto kLatencyReportInterval = std::chrono::seconds(1);
+constexpr auto kLatencyLogInterval = std::chrono::seconds(10);
+
+/// Time to wait for the status reply after (re)connecting before calibrating without it.
+constexpr auto kStatusReplyTimeout = std::chrono::seconds(3);
+
+/// Settings key of the address the device was last connected at (same store as SettingsManager).
+constexpr auto kLastDeviceKey = "device/lastAddress";
+
+[[nodiscard]] QSettings DeviceSettings() {
+  return QSettings(QStringLiteral("FaceTracker"), QStringLiteral("FaceTrackerClient"));
+}
+
+/// Settings group of a camera's calibration; the ID is percent-encoded since it may contain slashes.
+[[nodiscard]] QString CameraSettingsGroup(std::string_view camera_id) {
+  const QString id = camera_id.empty() ? QStringLiteral("default")
+                                       : QString::fromUtf8(camera_id.data(), static_cast<qsizetype>(camera_id.size()));
+  return QStringLiteral("camera/") + QString::fromLatin1(QUrl::toPercentEncoding(id));
+}
+
+[[nodiscard]] std::optional<CameraIntrinsics> LoadIntrinsics(std::string_view camera_id) {
+  auto settings = DeviceSettings();
+  settings.beginGroup(CameraSettingsGroup(camera_id));
+  const CameraIntrinsics intrinsics{.width = settings.value(QStringLiteral("width")).toInt(),
+                                    .height = settings.value(QStringLiteral("height")).toInt(),
+                                    .fx = settings.value(QStringLiteral("fx")).toFloat(),
+                                    .fy = settings.value(QStringLiteral("fy")).toFloat(),
+                                    .cx = settings.value(QStringLiteral("cx")).toFloat(),
+                                    .cy = settings.value(QStringLiteral("cy")).toFloat(),
+                                    .k1 = settings.value(QStringLiteral("k1")).toFloat(),
+                                    .k2 = settings.value(QStringLiteral("k2")).toFloat()};
+  if (!intrinsics.Valid()) {
+    return std::nullopt;
+  }
+  return intrinsics;
+}
+
+void SaveIntrinsics(std::string_view camera_id, const CameraIntrinsics& intrinsics) {
+  auto settings = DeviceSettings();
+  settings.beginGroup(CameraSettingsGroup(camera_id));
+  settings.setValue(QStringLiteral("width"), intrinsics.width);
+  settings.setValue(QStringLiteral("height"), intrinsics.height);
+  settings.setValue(QStringLiteral("fx"), intrinsics.fx);
+  settings.setValue(QStringLiteral("fy"), intrinsics.fy);
+  settings.setValue(QStringLiteral("cx"), intrinsics.cx);
+  settings.setValue(QStringLiteral("cy"), intrinsics.cy);
+  settings.setValue(QStringLiteral("k1"), intrinsics.k1);
+  settings.setValue(QStringLiteral("k2"), intrinsics.k2);
+}
+
+/// Prometheus metric names of the latency stages, indexed by LatencyStage.
+constexpr std::array<std::string_view, kLatencyStageCount> kLatencyMetricNames = {
+    "client_latency_capture_to_detect_seconds",
+    "client_latency_detect_to_send_seconds",
+    "client_latency_send_to_ack_seconds",
+    "client_latency_capture_to_ack_seconds",
+};
+
 enum class ModelResolveError : uint8_t {
   kAppDataDirNotAvailable,
   kCannotCreateModelsDir,
@@ -341,6 +406,64 @@ AppConfig ParseArguments(int argc, char** argv) {
                                QStringLiteral("30"));
   parser.addOption(fpsOption);
 
+  QCommandLineOption fovOption(QStringLiteral("fov"), QStringLiteral("Camera horizontal field of view in degrees"),
+                               QStringLiteral("degrees"), QStringLiteral("60"));
+  parser.addOption(fovOption);
+
+  QCommandLineOption trackingGainOption(QStringLiteral("tracking-gain"),
+                                        QStringLiteral("Share of the tracking error corrected per frame (0.0-1.0]"),
+                                        QStringLiteral("value"), QStringLiteral("0.7"));
+  parser.addOption(trackingGainOption);
+
+  QCommandLineOption deadbandOption(QStringLiteral("deadband"),
+                                    QStringLiteral("Tracking errors ignored below this many degrees"),
+                                    QStringLiteral("degrees"), QStringLiteral("0.5"));
+  parser.addOption(deadbandOption);
+
+  QCommandLineOption commandThresholdOption(QStringLiteral("command-threshold"),
+                                            QStringLiteral("Smallest target change in degrees worth a servo command"),
+                                            QStringLiteral("degrees"), QStringLiteral("0.3"));
+  parser.addOption(commandThresholdOption);
+
+  QCommandLineOption keyframeIntervalOption(QStringLiteral("keyframe-interval"),
+                                            QStringLiteral("Resend the target at least this often (0 = never)"),
+                                            QStringLiteral("ms"), QStringLiteral("1000"));
+  parser.addOption(keyframeIntervalOption);
+
+  QCommandLineOption moveHorizonOption(
+      QStringLiteral("move-horizon"),
+      QStringLiteral("Let the device extrapolate each target along the face velocity this long (0 = position only)"),
+      QStringLiteral("ms"), QStringLiteral("0"));
+  parser.addOption(moveHorizonOption);
+
+  QCommandLineOption noSmoothingOption(QStringLiteral("no-smoothing"),
+                                       QStringLiteral("Track raw detections without adaptive smoothing"));
+  parser.addOption(noSmoothingOption);
+
+  QCommandLineOption calibrateFovOption(QStringLiteral("calibrate-fov"),
+                                        QStringLiteral("Sweep the gimbal past a still face to calibrate the camera"));
+  parser.addOption(calibrateFovOption);
+
+  QCommandLineOption metricsPortOption(QStringLiteral("metrics-port"),
+                                       QStringLiteral("Serve Prometheus metrics on 127.0.0.1:<port> (0 = disabled)"),
+                                       QStringLiteral("port"), QStringLiteral("0"));
+  parser.addOption(metricsPortOption);
+
+  QCommandLineOption metricsSocketOption(QStringLiteral("metrics-socket"),
+                                         QStringLiteral("Serve Prometheus metrics on a Unix domain socket"),
+                                         QStringLiteral("path"));
+  parser.addOption(metricsSocketOption);
+
+  QCommandLineOption traceFileOption(QStringLiteral("trace-file"),
+                                     QStringLiteral("Write recent pipeline spans as Chrome trace JSON on exit"),
+                                     QStringLiteral("path"));
+  parser.addOption(traceFileOption);
+
+  QCommandLineOption traceSecondsOption(QStringLiteral("trace-seconds"),
+                                        QStringLiteral("Seconds of spans to keep in trace dumps"),
+                                        QStringLiteral("seconds"), QStringLiteral("10"));
+  parser.addOption(traceSecondsOption);
+
   // Parse arguments
   parser.process(temp_app);
 
@@ -419,6 +542,70 @@ AppConfig ParseArguments(int argc, char** argv) {
     config.camera.preferred_fps = 30;
   }
 
+  auto& controller = config.gimbal_controller;
+  controller.horizontal_fov_deg = parser.value(fovOption).toFloat(&ok);
+  if (!ok || controller.horizontal_fov_deg <= 0.0F || controller.horizontal_fov_deg >= 180.0F) {
+    CLIENT_WARN("Invalid fov value, using default (60)");
+    controller.horizontal_fov_deg = 60.0F;
+  }
+
+  const float tracking_gain = parser.value(trackingGainOption).toFloat(&ok);
+  if (!ok || tracking_gain <= 0.0F || tracking_gain > 1.0F) {
+    CLIENT_WARN("Invalid tracking-gain value, using default (0.7)");
+  } else {
+    controller.pan.kp = tracking_gain;
+    controller.tilt.kp = tracking_gain;
+  }
+
+  controller.deadband_deg = parser.value(deadbandOption).toFloat(&ok);
+  if (!ok || controller.deadband_deg < 0.0F) {
+    CLIENT_WARN("Invalid deadband value, using default (0.5)");
+    controller.deadband_deg = 0.5F;
+  }
+  if (parser.isSet(noSmoothingOption)) {
+    controller.smoothing.reset();
+  }
+  config.calibrate_fov = parser.isSet(calibrateFovOption);
+
+  config.command_gate.min_change_deg = parser.value(commandThresholdOption).toFloat(&ok);
+  if (!ok || config.command_gate.min_change_deg < 0.0F) {
+    CLIENT_WARN("Invalid command-threshold value, using default (0.3)");
+    config.command_gate.min_change_deg = 0.3F;
+  }
+
+  const int keyframe_ms = parser.value(keyframeIntervalOption).toInt(&ok);
+  if (!ok || keyframe_ms < 0) {
+    CLIENT_WARN("Invalid keyframe-interval value, using default (1000)");
+  } else {
+    config.command_gate.keyframe_interval = std::chrono::milliseconds(keyframe_ms);
+  }
+
+  const int horizon_ms = parser.value(moveHorizonOption).toInt(&ok);
+  if (!ok || horizon_ms < 0) {
+    CLIENT_WARN("Invalid move-horizon value, using default (0)");
+  } else {
+    config.command_gate.velocity_horizon = std::chrono::milliseconds(horizon_ms);
+  }
+
+  const auto port = parser.value(metricsPortOption).toUInt(&ok);
+  if (!ok || port > UINT16_MAX) {
+    CLIENT_WARN("Invalid metrics-port value, metrics endpoint disabled");
+  } else {
+    config.metrics_endpoint.port = static_cast<uint16_t>(port);
+  }
+  config.metrics_endpoint.socket_path = parser.value(metricsSocketOption).toStdString();
+
+  config.trace_file = parser.value(traceFileOption).toStdString();
+  config.trace_seconds = parser.value(traceSecondsOption).toUInt(&ok);
+  if (!ok || config.trace_seconds == 0) {
+    CLIENT_WARN("Invalid trace-seconds value, using default (10)");
+    config.trace_seconds = 10;
+  }
+  if (!config.trace_file.empty() && !tracing::kTracingEnabled) {
+    CLIENT_WARN("--trace-file ignored: built without CLIENT_ENABLE_TRACING");
+    config.trace_file.clear();
+  }
+
   CLIENT_ASSERT(config.camera.preferred_width > 0, "Camera width must be positive");
   CLIENT_ASSERT(config.camera.preferred_height > 0, "Camera height must be positive");
   CLIENT_ASSERT(config.camera.preferred_fps > 0, "Camera FPS must be positive");
@@ -429,6 +616,9 @@ AppConfig ParseArguments(int argc, char** argv) {
 App::App(int argc, char** argv, AppConfig config, bool use_gui)
     : config_(std::move(config)),
       use_gui_(use_gui || !config_.headless),
+      gimbal_controller_(config_.gimbal_controller),
+      command_gate_(config_.command_gate),
+      fov_calibration_pending_(config_.calibrate_fov),
       last_fps_update_(std::chrono::steady_clock::now()) {
   // WORKAROUND for Qt 6.10.1 bug: QCoreApplication::arguments() crashes when
   // accessing argv pointers. Create persistent copies of argc/argv to ensure
@@ -469,6 +659,8 @@ App::~App() {
     RequestStop();
   }
 
+  metrics_server_.Stop();
+
   if (camera_.Initialized()) {
     camera_.Stop();
   }
@@ -488,8 +680,16 @@ AppReturnCode App::Run() {
   }
 
   running_.store(true, std::memory_order_release);
+  CLIENT_SET_THREAD_NAME("main");
   CLIENT_INFO("{} started", Name());
 
+  if (config_.metrics_endpoint.Enabled()) {
+    const auto metrics_result = metrics_server_.Start(config_.metrics_endpoint);
+    if (!metrics_result) {
+      CLIENT_WARN("Metrics endpoint disabled: {}", MetricsServerErrorToString(metrics_result.error()));
+    }
+  }
+
   // Create GUI if enabled
   if (use_gui_) {
     gui_window_ = std::make_unique<GuiWindow>();
@@ -596,76 +796,113 @@ AppReturnCode App::Run() {
       CLIENT_WARN("Bluetooth initialization failed: {}", comm::BluetoothErrorToString(bt_init.error()));
     } else {
       CLIENT_INFO("Bluetooth initialized successfully");
+    }
 
-      // Set up Bluetooth state callback
-      bluetooth_.SetStateCallback([this](comm::BluetoothState state, std::string_view error_message) {
-        if (config_.verbose) {
-          CLIENT_INFO("Bluetooth state changed: {} {}", comm::BluetoothStateToString(state),
-                      error_message.empty() ? "" : std::string("- ") + std::string(error_message));
-        }
+    // Set up link state callback; registered even without Bluetooth, since network and serial links use it too
+    bluetooth_.SetStateCallback([this](comm::BluetoothState state, std::string_view error_message) {
+      if (config_.verbose) {
+        CLIENT_INFO("Bluetooth state changed: {} {}", comm::BluetoothStateToString(state),
+                    error_message.empty() ? "" : std::string("- ") + std::string(error_message));
+      }
 
-        // Update GUI connection state
-        if (gui_window_) {
-          ConnectionState gui_state = ConnectionState::kDisconnected;
-          switch (state) {
-            case comm::BluetoothState::kDisconnected:
-              gui_state = ConnectionState::kDisconnected;
-              break;
-            case comm::BluetoothState::kScanning:
-              gui_state = ConnectionState::kDisconnected;
-              break;
-            case comm::BluetoothState::kConnecting:
-              gui_state = ConnectionState::kConnecting;
-              break;
-            case comm::BluetoothState::kConnected:
-              gui_state = ConnectionState::kConnected;
-              break;
-            case comm::BluetoothState::kError:
-              gui_state = ConnectionState::kError;
-              break;
-          }
-          gui_window_->SetConnectionState(gui_state, std::string(error_message));
-        }
-      });
+      if (state == comm::BluetoothState::kConnected) {
+        // Command timestamps are relative to the connection and IDs only match within it
+        connection_epoch_ = std::chrono::steady_clock::now();
+        latency_tracker_.Reset();
+        // Targets sent on the previous connection may never have reached the gimbal
+        gimbal_controller_.Reset(gimbal_controller_.Target());
+        command_gate_.Reset();
+        fov_calibrator_.reset();
+      }
+      if (state == comm::BluetoothState::kConnected || state == comm::BluetoothState::kDisconnected) {
+        // RTT and clock offset are per connection; the device clock restarts when it reboots
+        link_monitor_.Reset();
+        bluetooth_.SetRetransmitTimeout(comm::LinkStats::kInitialRetransmitTimeout);
+        // Pending responses and mirrored state belong to the previous connection
+        response_dispatcher_.Clear();
+        device_shadow_.Reset();
+      }
+      if (state == comm::BluetoothState::kConnected) {
+        ResumeSession();
+      }
 
-      // Set up device discovered callback
-      bluetooth_.SetDeviceDiscoveredCallback([this](const comm::BluetoothDevice& device) {
-        if (config_.verbose) {
-          CLIENT_INFO("Bluetooth device discovered: {} ({}), RSSI: {} dBm, paired: {}, connected: {}", device.name,
-                      device.address, device.rssi, device.is_paired, device.is_connected);
+      // Update GUI connection state
+      if (gui_window_) {
+        ConnectionState gui_state = ConnectionState::kDisconnected;
+        switch (state) {
+          case comm::BluetoothState::kDisconnected:
+            gui_state = ConnectionState::kDisconnected;
+            break;
+          case comm::BluetoothState::kScanning:
+            gui_state = ConnectionState::kDisconnected;
+            break;
+          case comm::BluetoothState::kConnecting:
+            gui_state = ConnectionState::kConnecting;
+            break;
+          case comm::BluetoothState::kConnected:
+            gui_state = ConnectionState::kConnected;
+            break;
+          case comm::BluetoothState::kError:
+            gui_state = ConnectionState::kError;
+            break;
         }
-      });
+        gui_window_->SetConnectionState(gui_state, std::string(error_message));
+      }
+    });
 
-      // Set up scan complete callback
-      bluetooth_.SetScanCompleteCallback([this](std::span<const comm::BluetoothDevice> devices) {
-        CLIENT_INFO("Bluetooth scan complete: {} device(s) found", devices.size());
+    // Set up device discovered callback
+    bluetooth_.SetDeviceDiscoveredCallback([this](const comm::BluetoothDevice& device) {
+      if (config_.verbose) {
+        CLIENT_INFO("Bluetooth device discovered: {} ({}), RSSI: {} dBm, paired: {}, connected: {}", device.name,
+                    device.address, device.rssi, device.is_paired, device.is_connected);
+      }
+    });
 
-        if (config_.verbose) {
-          for (const auto& device : devices) {
-            CLIENT_INFO("  - {} ({}) - RSSI: {} dBm, paired: {}, connected: {}", device.name, device.address,
-                        device.rssi, device.is_paired, device.is_connected);
-          }
-        }
+    // Set up scan complete callback
+    bluetooth_.SetScanCompleteCallback([this](std::span<const comm::BluetoothDevice> devices) {
+      CLIENT_INFO("Bluetooth scan complete: {} device(s) found", devices.size());
 
-        // Update GUI with discovered devices
-        if (gui_window_) {
-          std::vector<BluetoothDeviceInfo> gui_devices;
-          gui_devices.reserve(devices.size());
-          for (const auto& device : devices) {
-            gui_devices.push_back({.name = device.name, .address = device.address});
-          }
-          gui_window_->UpdateAvailableDevices(gui_devices);
+      if (config_.verbose) {
+        for (const auto& device : devices) {
+          CLIENT_INFO("  - {} ({}) - RSSI: {} dBm, paired: {}, connected: {}", device.name, device.address,
+                      device.rssi, device.is_paired, device.is_connected);
         }
-      });
+      }
 
-      // Set up data received callback
-      bluetooth_.SetDataReceivedCallback([this](std::span<const uint8_t> data) {
-        if (config_.verbose) {
-          CLIENT_INFO("Received {} bytes from Bluetooth device", data.size());
+      // Update GUI with discovered devices
+      if (gui_window_) {
+        std::vector<BluetoothDeviceInfo> gui_devices;
+        gui_devices.reserve(devices.size());
+        for (const auto& device : devices) {
+          gui_devices.push_back({.name = device.name, .address = device.address});
         }
-        // TODO: Handle received data (e.g., status updates from ESP32)
-      });
-    }
+        gui_window_->UpdateAvailableDevices(gui_devices);
+      }
+    });
+
+    // Responses nobody is waiting for still acknowledge the command that caused them
+    response_dispatcher_.SetDefaultHandler([this](const comm::StatusMessage& response) {
+      if (response.command_id != 0) {
+        latency_tracker_.RecordAck(response.command_id, std::chrono::steady_clock::now());
+      }
+    });
+
+    // Windowed acks stand in for the per-MOVE responses the device no longer sends
+    bluetooth_.SetAckCallback([this](uint32_t command_id) {
+      latency_tracker_.RecordAck(command_id, std::chrono::steady_clock::now());
+    });
+
+    // Set up data received callback
+    bluetooth_.SetDataReceivedCallback([this](std::span<const uint8_t> data) {
+      if (config_.verbose) {
+        CLIENT_INFO("Received {} bytes from Bluetooth device", data.size());
+      }
+
+      const auto result = response_dispatcher_.Dispatch(data);
+      if (!result) {
+        CLIENT_WARN("Failed to parse device response: {}", comm::ProtocolErrorToString(result.error()));
+      }
+    });
 
     // Set up GUI Bluetooth callbacks
     gui_window_->SetScanCallback([this]() {
@@ -683,42 +920,7 @@ AppReturnCode App::Run() {
       }
     });
 
-    gui_window_->SetConnectCallback([this](std::string_view address) {
-      CLIENT_INFO("Attempting to connect to Bluetooth device: {}", address);
-      const auto result = bluetooth_.Connect(address);
-      if (!result) {
-        CLIENT_ERROR("Failed to connect to Bluetooth device: {}", comm::BluetoothErrorToString(result.error()));
-        if (gui_window_) {
-          gui_window_->SetConnectionState(ConnectionState::kError,
-                                          std::string(comm::BluetoothErrorToString(result.error())));
-        }
-      } else {
-        if (config_.verbose) {
-          CLIENT_INFO("Connection initiated to {}", address);
-        }
-
-        // Start camera once Bluetooth is connected
-        if (!camera_.Active()) {
-          CLIENT_INFO("Starting camera after Bluetooth connection...");
-          const auto start_result = camera_.Start();
-          if (!start_result) {
-            CLIENT_ERROR("Failed to start camera: {}", CameraErrorToString(start_result.error()));
-          } else {
-            CLIENT_INFO("Camera started successfully");
-          }
-        }
-
-        // Start calibration automatically after connection
-        CLIENT_INFO("Starting automatic calibration...");
-        const auto calibrate_result = bluetooth_.SendCalibrate();
-        if (!calibrate_result) {
-          CLIENT_ERROR("Failed to send calibration command: {}",
-                       comm::BluetoothErrorToString(calibrate_result.error()));
-        } else {
-          CLIENT_INFO("Calibration command sent");
-        }
-      }
-    });
+    gui_window_->SetConnectCallback([this](std::string_view address) { ConnectToDevice(address); });
 
     gui_window_->SetDisconnectCallback([this]() {
       CLIENT_INFO("Disconnecting from Bluetooth device...");
@@ -737,9 +939,24 @@ AppReturnCode App::Run() {
       }
     });
 
+    gui_window_->SetTraceDumpCallback([this]() {
+      const auto timestamp = QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd_HHmmss")).toStdString();
+      const auto path = std::filesystem::path(Logger::GetInstance().GetDefaultConfig().log_directory) /
+                        std::format("trace_{}.json", timestamp);
+
+      QDir().mkpath(QString::fromStdString(path.parent_path().string()));
+
+      const auto result = DumpTrace(path);
+      if (!result) {
+        CLIENT_ERROR("Failed to write trace: {}", tracing::TraceErrorToString(result.error()));
+      } else {
+        CLIENT_INFO("Wrote {} span(s) to {}", *result, path.string());
+      }
+    });
+
     gui_window_->SetCalibrateCallback([this]() {
       CLIENT_INFO("Manual calibration requested");
-      const auto result = bluetooth_.SendCalibrate();
+      const auto result = bluetooth_.SendCalibrate(NextCommandId());
       if (!result) {
         CLIENT_ERROR("Failed to send calibration command: {}", comm::BluetoothErrorToString(result.error()));
       } else {
@@ -760,6 +977,14 @@ AppReturnCode App::Run() {
 
     gui_window_->show();
     CLIENT_INFO("GUI window displayed");
+
+    // A lost link comes back by itself; the device used last is reconnected without a discovery scan
+    bluetooth_.SetAutoReconnect(true);
+    const auto last_device = DeviceSettings().value(kLastDeviceKey).toString().toStdString();
+    if (!last_device.empty()) {
+      CLIENT_INFO("Reconnecting to last device {}", last_device);
+      ConnectToDevice(last_device);
+    }
   }
 
   // Set up frame processing callback
@@ -825,13 +1050,15 @@ AppReturnCode App::Run() {
     }
 
     // Check frame limit
-    const uint64_t frames = frames_processed_.load(std::memory_order_relaxed);
+    const uint64_t frames = frames_processed_.Value();
     if (config_.max_frames > 0 && frames >= config_.max_frames) {
       CLIENT_INFO("Reached frame limit ({}), stopping", config_.max_frames);
       qt_app_->quit();
       return;
     }
 
+    PollLink();
+
     // Process Qt events (this will trigger frame callbacks)
     qt_app_->processEvents();
   });
@@ -842,13 +1069,27 @@ AppReturnCode App::Run() {
   int result = qt_app_->exec();
 
   running_.store(false, std::memory_order_release);
+  metrics_server_.Stop();
   camera_.Stop();
 
-  CLIENT_INFO("{} finished, processed {} frames", Name(), frames_processed_.load(std::memory_order_relaxed));
+  CLIENT_INFO("{} finished, processed {} frames", Name(), frames_processed_.Value());
+
+  if (!config_.trace_file.empty()) {
+    const auto trace_result = DumpTrace(config_.trace_file);
+    if (!trace_result) {
+      CLIENT_ERROR("Failed to write trace: {}", tracing::TraceErrorToString(trace_result.error()));
+    } else {
+      CLIENT_INFO("Wrote {} span(s) to {}", *trace_result, config_.trace_file);
+    }
+  }
 
   return result == 0 ? AppReturnCode::kSuccess : AppReturnCode::kUnknownError;
 }
 
+auto App::DumpTrace(const std::filesystem::path& path) const -> std::expected<size_t, tracing::TraceError> {
+  return tracing::Tracer::GetInstance().WriteChromeJson(path, std::chrono::seconds(config_.trace_seconds));
+}
+
 auto App::SwitchModel(ModelType model_type) -> std::expected<void, AppReturnCode> {
   if (!running_.load(std::memory_order_acquire)) {
     CLIENT_ERROR("Cannot switch model: application not running");
@@ -899,6 +1140,8 @@ auto App::SwitchCamera(std::string_view device_id) -> std::expected<void, AppRet
 
   // Update configuration
   config_.camera.device_id = std::string(device_id);
+  fov_calibrator_.reset();
+  LoadCameraIntrinsics();
 
   CLIENT_INFO("Successfully switched camera");
   return {};
@@ -917,6 +1160,7 @@ auto App::Initialize() -> std::expected<void, AppReturnCode> {
   }
 
   CLIENT_ASSERT(camera_.Initialized(), "Camera should be initialized after successful Initialize()");
+  LoadCameraIntrinsics();
 
   // Initialize face tracker
   const auto tracker_result = face_tracker_.Initialize(config_.face_tracker);
@@ -927,10 +1171,53 @@ auto App::Initialize() -> std::expected<void, AppReturnCode> {
 
   CLIENT_ASSERT(face_tracker_.Initialized(), "Face tracker should be initialized after successful Initialize()");
 
+  RegisterMetrics();
+
   CLIENT_INFO("App initialized successfully");
   return {};
 }
 
+void App::RegisterMetrics() {
+  metrics_.Clear();
+
+  const auto camera_result = camera_.RegisterMetrics(metrics_);
+  if (!camera_result) {
+    CLIENT_WARN("Failed to register camera metrics: {}", metrics::MetricsErrorToString(camera_result.error()));
+  }
+
+  const auto register_metric = [this](std::string_view name, std::string_view help, const auto& metric) {
+    const auto result = metrics_.Register(name, help, metric);
+    if (!result) {
+      CLIENT_WARN("Failed to register metric '{}': {}", name, metrics::MetricsErrorToString(result.error()));
+    }
+  };
+
+  register_metric("client_frames_processed_total", "Frames run through face detection", frames_processed_);
+  register_metric("client_detection_failures_total", "Frames where face detection failed", detection_failures_);
+  register_metric("client_faces_detected", "Faces detected in the last processed frame", faces_detected_);
+  register_metric("client_detect_duration_seconds", "Face detection inference time", detect_duration_);
+  register_metric("client_servo_commands_sent_total", "Servo commands queued for the device", commands_sent_);
+  register_metric("client_servo_command_failures_total", "Servo commands that failed to send",
+                  command_send_failures_);
+  register_metric("client_servo_commands_suppressed_total", "Servo targets not sent because they barely moved",
+                  commands_suppressed_);
+  register_metric("client_servo_commands_coalesced_total", "Servo commands replaced by a newer one before sending",
+                  commands_coalesced_);
+  register_metric("client_servo_commands_retransmitted_total",
+                  "Control commands sent again because their response was overdue", commands_retransmitted_);
+  register_metric("client_servo_queue_depth", "Commands waiting for the Bluetooth link to drain", send_queue_depth_);
+  register_metric("client_link_rtt_seconds", "Smoothed ping round-trip time to the device", link_rtt_);
+  register_metric("client_link_jitter_seconds", "Ping round-trip jitter", link_jitter_);
+  register_metric("client_link_clock_offset_seconds", "Device clock minus host steady clock", link_clock_offset_);
+  register_metric("client_link_pings_lost_total", "Pings the device did not answer in time", link_pings_lost_);
+
+  for (size_t i = 0; i < kLatencyStageCount; ++i) {
+    const auto stage = static_cast<LatencyStage>(i);
+    register_metric(kLatencyMetricNames[i], std::format("Servo command latency, {}", LatencyStageToString(stage)),
+                    latency_tracker_.Histogram(stage));
+  }
+}
+
 void App::ProcessFrame(const Frame& frame) {
   CLIENT_ASSERT(running_.load(std::memory_order_acquire), "ProcessFrame called while not running");
   CLIENT_ASSERT(face_tracker_.Initialized(), "Face tracker must be initialized");
@@ -939,23 +1226,30 @@ void App::ProcessFrame(const Frame& frame) {
     return;
   }
 
-  // Run face detection
-  auto result = face_tracker_.Detect(frame);
-  if (!result) {
+  // Run face detection into the reused result
+  const auto detected = face_tracker_.Detect(frame, detection_);
+  if (!detected) {
+    detection_failures_.Increment();
     if (config_.verbose) {
-      CLIENT_WARN("Face detection failed: {}", FaceTrackerErrorToString(result.error()));
+      CLIENT_WARN("Face detection failed: {}", FaceTrackerErrorToString(detected.error()));
     }
     return;
   }
 
-  frames_processed_.fetch_add(1, std::memory_order_relaxed);
+  frames_processed_.Increment();
+  faces_detected_.Set(static_cast<double>(detection_.FaceCount()));
+  detect_duration_.Record(std::chrono::duration<double, std::milli>(detection_.processing_time_ms));
 
-  HandleDetection(*result, frame);
+  HandleDetection(detection_, frame);
 }
 
 void App::HandleDetection(const FaceDetectionResult& result, const Frame& frame) {
+  CLIENT_SPAN("App::HandleDetection");
+
   CLIENT_ASSERT(running_.load(std::memory_order_acquire), "HandleDetection called while not running");
 
+  latency_tracker_.RecordDetection(result.capture_time, result.detect_time);
+
   {
     std::scoped_lock lock(detection_mutex_);
     last_detection_ = result;
@@ -979,44 +1273,113 @@ void App::HandleDetection(const FaceDetectionResult& result, const Frame& frame)
     }
   }
 
-  // Send servo commands if connected and faces detected
-  if (bluetooth_.State() == comm::BluetoothState::kConnected && result.HasFaces()) {
+  // Send servo commands if connected and faces detected (or calibrating, which also needs frames without one)
+  if (bluetooth_.State() == comm::BluetoothState::kConnected && (result.HasFaces() || fov_calibration_pending_)) {
     // Get the primary face (highest priority)
     const auto primary_face_opt = result.HighestPriorityFace();
-    if (!primary_face_opt) {
+    if (!primary_face_opt && !fov_calibration_pending_) {
       return;
     }
 
-    const auto& primary_face = *primary_face_opt;
-
-    // Calculate pan and tilt angles based on face position
-    // Face position is in pixels, normalize to [-1, 1] range where center is 0
-    const float frame_center_x = static_cast<float>(frame.Width()) / 2.0F;
-    const float frame_center_y = static_cast<float>(frame.Height()) / 2.0F;
+    // Closed-loop control: the camera rides on the gimbal, so the face position is relative to it.
+    // A requested calibration sweep takes over the gimbal until it ends.
+    const GimbalPose target =
+        fov_calibration_pending_
+            ? CalibrateFov(primary_face_opt ? std::optional(primary_face_opt->Center()) : std::nullopt, frame,
+                           result.capture_time)
+            : gimbal_controller_.Update(primary_face_opt->Center(), frame.Width(), frame.Height(),
+                                        result.capture_time);
+
+    // With a horizon the device extrapolates the target along the face velocity, so fewer MOVEs are
+    // needed; a calibration sweep is a series of fixed poses
+    const auto horizon = config_.command_gate.velocity_horizon;
+    const GimbalPose velocity =
+        horizon.count() > 0 && !fov_calibration_pending_ ? gimbal_controller_.Velocity() : GimbalPose{};
+
+    if (!command_gate_.ShouldSend(target, velocity, result.capture_time)) {
+      // Too small a move for the device's dead zone to act on: skip the airtime and status reply
+      commands_suppressed_.Increment();
+    } else {
+      const auto origin_ms =
+          std::chrono::duration_cast<std::chrono::milliseconds>(result.capture_time - connection_epoch_).count();
+
+      comm::ServoCommand cmd{.pan_angle = target.pan,
+                             .tilt_angle = target.tilt,
+                             .speed = 1.0F,
+                             .smooth = true,
+                             .command_id = NextCommandId(),
+                             .timestamp_ms = origin_ms > 0 ? static_cast<uint64_t>(origin_ms) : 0,
+                             .pan_velocity = velocity.pan,
+                             .tilt_velocity = velocity.tilt,
+                             .valid_for_ms = static_cast<uint32_t>(horizon.count())};
+
+      const auto send_result = bluetooth_.SendCommand(cmd);
+      if (send_result) {
+        commands_sent_.Increment();
+        latency_tracker_.RecordSent(cmd.command_id, result.capture_time, result.detect_time,
+                                    std::chrono::steady_clock::now());
+      } else {
+        command_send_failures_.Increment();
+        command_gate_.Reset();  // Never reached the device: let the next target through
+        if (config_.verbose) {
+          CLIENT_ERROR("Failed to send servo command: {}", comm::BluetoothErrorToString(send_result.error()));
+        }
+      }
+    }
 
-    const float face_center_x = primary_face.bounding_box.x + primary_face.bounding_box.width / 2.0F;
-    const float face_center_y = primary_face.bounding_box.y + primary_face.bounding_box.height / 2.0F;
+    send_queue_depth_.Set(static_cast<double>(bluetooth_.QueueDepth()));
+    commands_coalesced_.Increment(bluetooth_.CoalescedCommands() - commands_coalesced_.Value());
+  }
 
-    // Normalized offset from center [-1, 1]
-    const float offset_x = (face_center_x - frame_center_x) / frame_center_x;
-    const float offset_y = (face_center_y - frame_center_y) / frame_center_y;
+  ReportLatency();
 
-    // Convert to servo angles (pan: -90 to 90, tilt: -45 to 45)
-    const float pan_angle = offset_x * 90.0F;
-    const float tilt_angle = offset_y * 45.0F;
+  // Call user callback if set
+  if (detection_callback_) {
+    detection_callback_(result);
+  }
+}
 
-    comm::ServoCommand cmd{.pan_angle = pan_angle, .tilt_angle = tilt_angle, .speed = 1.0F, .smooth = true};
+GimbalPose App::CalibrateFov(std::optional<Point2D> feature, const Frame& frame,
+                             std::chrono::steady_clock::time_point capture_time) {
+  if (!fov_calibrator_) {
+    CLIENT_INFO("Calibrating the field of view: hold still in front of the camera");
+    fov_calibrator_.emplace(gimbal_controller_.IntrinsicsFor(frame.Width(), frame.Height()),
+                            gimbal_controller_.Target());
+  }
+  if (const auto pose = fov_calibrator_->Next(feature, capture_time)) {
+    return *pose;
+  }
 
-    const auto send_result = bluetooth_.SendCommand(cmd);
-    if (!send_result && config_.verbose) {
-      CLIENT_ERROR("Failed to send servo command: {}", comm::BluetoothErrorToString(send_result.error()));
-    }
+  const GimbalPose center = fov_calibrator_->Plan().front();
+  const auto intrinsics = fov_calibrator_->Solve();
+  fov_calibrator_.reset();
+  fov_calibration_pending_ = false;
+  if (intrinsics) {
+    const auto device = camera_.CurrentDevice();
+    const std::string camera_id = device ? device->id : config_.camera.device_id;
+    CLIENT_INFO("Calibrated camera {}: {:.1f} x {:.1f} degrees (fx={:.1f}, fy={:.1f})",
+                camera_id.empty() ? "default" : camera_id, intrinsics->HorizontalFovDeg(),
+                intrinsics->VerticalFovDeg(), intrinsics->fx, intrinsics->fy);
+    SaveIntrinsics(camera_id, *intrinsics);
+    gimbal_controller_.SetIntrinsics(*intrinsics);
+  } else {
+    CLIENT_WARN("Field-of-view calibration failed: {}", FovCalibrationErrorToString(intrinsics.error()));
   }
 
-  // Call user callback if set
-  if (detection_callback_) {
-    detection_callback_(result);
+  // Return to where the sweep started and resume tracking from there
+  gimbal_controller_.Reset(center);
+  return center;
+}
+
+void App::LoadCameraIntrinsics() {
+  const auto device = camera_.CurrentDevice();
+  const std::string camera_id = device ? device->id : config_.camera.device_id;
+  const auto intrinsics = LoadIntrinsics(camera_id);
+  if (intrinsics) {
+    CLIENT_INFO("Using calibrated field of view for camera {}: {:.1f} degrees",
+                camera_id.empty() ? "default" : camera_id, intrinsics->HorizontalFovDeg());
   }
+  gimbal_controller_.SetIntrinsics(intrinsics ? intrinsics : config_.gimbal_controller.intrinsics);
 }
 
 void App::UpdateGui() {
@@ -1055,8 +1418,175 @@ void App::UpdateGui() {
 
   // Update statistics
   const size_t face_count = detection_copy ? detection_copy->faces.size() : 0;
-  const uint64_t frames = frames_processed_.load(std::memory_order_relaxed);
+  const uint64_t frames = frames_processed_.Value();
   gui_window_->UpdateStats(current_fps_, frames, face_count);
 }
 
+void App::ReportLatency() {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - last_latency_report_ < kLatencyReportInterval) {
+    return;
+  }
+  last_latency_report_ = now;
+
+  const auto snapshot = latency_tracker_.Snapshot();
+
+  const auto link = link_monitor_.Stats();
+
+  if (gui_window_) {
+    gui_window_->UpdateLatency(snapshot);
+    gui_window_->UpdateDeviceState(device_shadow_.Read());
+    gui_window_->UpdateLink(link);
+  }
+
+  if ((use_gui_ && !config_.verbose) || now - last_latency_log_ < kLatencyLogInterval) {
+    return;
+  }
+  last_latency_log_ = now;
+
+  for (size_t i = 0; i < kLatencyStageCount; ++i) {
+    const auto stage = static_cast<LatencyStage>(i);
+    const auto& percentiles = snapshot.Stage(stage);
+    if (percentiles.count == 0) {
+      continue;
+    }
+    CLIENT_INFO("Latency {}: p50={:.1f}ms p95={:.1f}ms p99={:.1f}ms (n={})", LatencyStageToString(stage),
+                percentiles.p50_ms, percentiles.p95_ms, percentiles.p99_ms, percentiles.count);
+  }
+
+  if (snapshot.unmatched_acks != 0 || snapshot.evicted != 0) {
+    CLIENT_INFO("Latency: {} unmatched acks, {} commands evicted before ack", snapshot.unmatched_acks,
+                snapshot.evicted);
+  }
+
+  if (link.Valid()) {
+    CLIENT_INFO("Link: rtt={:.1f}ms (min {:.1f}ms) jitter={:.1f}ms offset={:.1f}ms, {}/{} pings lost", link.rtt_ms,
+                link.min_rtt_ms, link.jitter_ms, link.clock_offset_ms, link.lost, link.sent);
+  }
+}
+
+void App::PollLink() {
+  if (bluetooth_.State() != comm::BluetoothState::kConnected) {
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  link_monitor_.Expire(now, [this](uint32_t id) {
+    response_dispatcher_.Cancel(id);
+    link_pings_lost_.Increment();
+  });
+  commands_retransmitted_.Increment(bluetooth_.Retransmissions() - commands_retransmitted_.Value());
+
+  // An unanswered status query must not leave the session uncalibrated
+  if (status_query_id_ != 0 && now >= status_query_deadline_) {
+    if (response_dispatcher_.Cancel(status_query_id_)) {
+      CLIENT_WARN("No status reply from device, calibrating");
+      StartCalibration();
+    }
+    status_query_id_ = 0;
+  }
+
+  if (!link_monitor_.PingDue(now)) {
+    return;
+  }
+
+  // Pings share the command ID space so their pongs cannot be mistaken for servo acks
+  const uint32_t id = NextCommandId();
+  response_dispatcher_.Expect(id, [this](const comm::StatusMessage& response) {
+    if (!link_monitor_.OnPong(response.command_id, response.timestamp_ms, std::chrono::steady_clock::now())) {
+      return;
+    }
+
+    const auto link = link_monitor_.Stats();
+    link_rtt_.Set(link.rtt_ms / 1000.0);
+    link_jitter_.Set(link.jitter_ms / 1000.0);
+    link_clock_offset_.Set(link.clock_offset_ms / 1000.0);
+    bluetooth_.SetRetransmitTimeout(link.RetransmitTimeout());
+  });
+
+  const auto result = bluetooth_.SendHeartbeat(id);
+  if (!result) {
+    response_dispatcher_.Cancel(id);
+    if (config_.verbose) {
+      CLIENT_WARN("Failed to send ping: {}", comm::BluetoothErrorToString(result.error()));
+    }
+  }
+  // A failed send still counts toward the interval so a broken link is not pinged every tick
+  link_monitor_.OnPingSent(id, now);
+}
+
+void App::ConnectToDevice(std::string_view address) {
+  CLIENT_INFO("Attempting to connect to device: {}", address);
+  const auto result = bluetooth_.Connect(address);
+  if (!result) {
+    CLIENT_ERROR("Failed to connect to device: {}", comm::BluetoothErrorToString(result.error()));
+    if (gui_window_) {
+      gui_window_->SetConnectionState(ConnectionState::kError,
+                                      std::string(comm::BluetoothErrorToString(result.error())));
+    }
+    return;
+  }
+
+  if (config_.verbose) {
+    CLIENT_INFO("Connection initiated to {}", address);
+  }
+
+  // Start the camera while the link comes up, so tracking begins as soon as it is connected
+  if (!camera_.Active()) {
+    CLIENT_INFO("Starting camera while connecting...");
+    const auto start_result = camera_.Start();
+    if (!start_result) {
+      CLIENT_ERROR("Failed to start camera: {}", CameraErrorToString(start_result.error()));
+    } else {
+      CLIENT_INFO("Camera started successfully");
+    }
+  }
+}
+
+void App::ResumeSession() {
+  if (const auto device = bluetooth_.ConnectedDevice()) {
+    auto settings = DeviceSettings();
+    settings.setValue(kLastDeviceKey, QString::fromStdString(device->address));
+  }
+
+  // A device that kept its calibration across the reconnect (or a client restart) is not calibrated again
+  const uint32_t id = NextCommandId();
+  response_dispatcher_.Expect(id, [this](const comm::StatusMessage& response) {
+    if (response.has_device_status && response.is_calibrated) {
+      CLIENT_INFO("Device is already calibrated, resuming session");
+      return;
+    }
+    StartCalibration();
+  });
+
+  const auto result = bluetooth_.SendGetStatus(id);
+  if (!result) {
+    response_dispatcher_.Cancel(id);
+    CLIENT_ERROR("Failed to query device status: {}", comm::BluetoothErrorToString(result.error()));
+    StartCalibration();
+    return;
+  }
+  // PollLink() calibrates anyway if the reply does not arrive in time
+  status_query_id_ = id;
+  status_query_deadline_ = std::chrono::steady_clock::now() + kStatusReplyTimeout;
+}
+
+void App::StartCalibration() {
+  CLIENT_INFO("Starting automatic calibration...");
+  const auto result = bluetooth_.SendCalibrate(NextCommandId());
+  if (!result) {
+    CLIENT_ERROR("Failed to send calibration command: {}", comm::BluetoothErrorToString(result.error()));
+  } else {
+    CLIENT_INFO("Calibration command sent");
+  }
+}
+
+uint32_t App::NextCommandId() noexcept {
+  const uint32_t id = next_command_id_++;
+  if (next_command_id_ == 0) {
+    next_command_id_ = 1;
+  }
+  return id;
+}
+
 }  // namespace client
@@ -2,6 +2,7 @@
 
 #include <client/core/assert.hpp>
 #include <client/core/logger.hpp>
+#include <client/core/tracing.hpp>
 
 #include <QCamera>
 #include <QImage>
@@ -133,7 +134,7 @@ auto Camera::Initialize(const CameraConfig& config) -> std::expected<void, Camer
       std::scoped_lock lock(throttle_mutex_);
       last_frame_time_ = std::chrono::steady_clock::time_point{};
     }
-    frames_dropped_.store(0, std::memory_order_relaxed);
+    frames_dropped_.Reset();
 
     initialized_.store(true, std::memory_order_release);
     CLIENT_INFO("Camera initialized: {} (throttling: {})", device->description().toStdString(),
@@ -179,8 +180,7 @@ void Camera::Stop() {
   }
 
   active_.store(false, std::memory_order_release);
-  CLIENT_INFO("Camera stopped (captured: {}, dropped: {})", frames_captured_.load(std::memory_order_relaxed),
-              frames_dropped_.load(std::memory_order_relaxed));
+  CLIENT_INFO("Camera stopped (captured: {}, dropped: {})", FramesCaptured(), FramesDropped());
 }
 
 auto Camera::SwitchCamera(std::string_view device_id) -> std::expected<void, CameraError> {
@@ -407,15 +407,23 @@ bool Camera::ShouldProcessFrame() noexcept {
   }
 
   // Frame dropped due to throttling
-  frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+  frames_dropped_.Increment();
   return false;
 }
 
 void Camera::OnVideoFrameChanged(const QVideoFrame& frame) {
+  CLIENT_SPAN("Camera::OnVideoFrameChanged");
+
   if (!frame.isValid()) [[unlikely]] {
     return;
   }
 
+  // Stamp before throttling so sequence gaps reflect dropped frames
+  FrameTiming timing;
+  timing.arrival_time = std::chrono::steady_clock::now();
+  timing.presentation_time_us = frame.startTime();
+  timing.sequence = frame_sequence_.fetch_add(1, std::memory_order_relaxed);
+
   // Check if we should process this frame (throttling)
   if (!ShouldProcessFrame()) {
     return;
@@ -426,8 +434,10 @@ void Camera::OnVideoFrameChanged(const QVideoFrame& frame) {
     return;
   }
 
+  converted.SetTiming(timing);
+
   last_frame_ = std::move(converted);
-  frames_captured_.fetch_add(1, std::memory_order_relaxed);
+  frames_captured_.Increment();
 
   // Emit signal
   emit FrameReady(last_frame_);
@@ -457,6 +467,8 @@ void Camera::OnCameraError(QCamera::Error error) {
 }
 
 Frame Camera::ConvertFrame(const QVideoFrame& qframe) {
+  CLIENT_SPAN("Camera::ConvertFrame");
+
   QVideoFrame frame_copy = qframe;
 
   if (!frame_copy.map(QVideoFrame::ReadOnly)) {
@@ -517,6 +529,14 @@ auto Camera::CurrentDevice() const noexcept -> std::optional<CameraDeviceInfo> {
   return info;
 }
 
+auto Camera::RegisterMetrics(metrics::Registry& registry) const -> std::expected<void, metrics::MetricsError> {
+  return registry.Register("client_camera_frames_captured_total", "Frames delivered by the camera", frames_captured_)
+      .and_then([&]() {
+        return registry.Register("client_camera_frames_dropped_total", "Frames dropped by FPS throttling",
+                                 frames_dropped_);
+      });
+}
+
 size_t Camera::AvailableDeviceCount() noexcept {
   return static_cast<size_t>(QMediaDevices::videoInputs().size());
 }
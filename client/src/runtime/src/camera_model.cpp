@@ -0,0 +1,292 @@
+#include <client/app/camera_model.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+
+namespace client {
+
+namespace {
+
+constexpr float kDegToRad = std::numbers::pi_v<float> / 180.0F;
+constexpr float kRadToDeg = 180.0F / std::numbers::pi_v<float>;
+
+/// Fixed-point iterations inverting the distortion; converges well within a pixel for |k1| < 0.5.
+constexpr int kUndistortIterations = 8;
+
+/// Half-width of the grid searched for the feature direction, and the grid spacing (degrees).
+constexpr double kSearchRangeDeg = 20.0;
+constexpr double kSearchStepDeg = 0.5;
+
+/// Smallest pose spread and feature displacement a sweep must produce on each axis.
+constexpr float kMinPoseSpanDeg = 0.5F;
+constexpr float kMinDisplacementPx = 2.0F;
+
+[[nodiscard]] float DistortionFactor(const CameraIntrinsics& intrinsics, float x, float y) noexcept {
+  const float r2 = x * x + y * y;
+  return 1.0F + r2 * (intrinsics.k1 + r2 * intrinsics.k2);
+}
+
+[[nodiscard]] float FovDeg(float extent, float center, float focal_length) noexcept {
+  return (std::atan(center / focal_length) + std::atan((extent - center) / focal_length)) * kRadToDeg;
+}
+
+/// Observations of one axis: pose angle and feature displacement from the principal point.
+struct AxisSamples {
+  std::vector<double> pose_deg;
+  std::vector<double> displacement_px;
+};
+
+/// Least-squares focal length for a feature at direction_deg, and the residual it leaves.
+struct AxisFit {
+  double focal_length = 0.0;
+  double residual = 0.0;
+};
+
+[[nodiscard]] AxisFit FitFocalLength(const AxisSamples& samples, double direction_deg) noexcept {
+  double tt = 0.0;
+  double td = 0.0;
+  double dd = 0.0;
+  for (size_t i = 0; i < samples.pose_deg.size(); ++i) {
+    const double t = std::tan((direction_deg - samples.pose_deg[i]) * std::numbers::pi / 180.0);
+    const double d = samples.displacement_px[i];
+    tt += t * t;
+    td += t * d;
+    dd += d * d;
+  }
+  if (tt <= 0.0) {
+    return {.focal_length = 0.0, .residual = dd};
+  }
+  return {.focal_length = td / tt, .residual = dd - td * td / tt};
+}
+
+/**
+ * Fits d = f * tan(a - pose) over the feature direction a and focal length f. The residual is
+ * minimized over a on a grid around the direction the initial focal length implies, then refined
+ * by golden-section search in the best grid cell.
+ */
+[[nodiscard]] double SolveFocalLength(const AxisSamples& samples, double initial_focal_length) noexcept {
+  double guess = 0.0;
+  double lowest_pose = samples.pose_deg.front();
+  double highest_pose = samples.pose_deg.front();
+  for (size_t i = 0; i < samples.pose_deg.size(); ++i) {
+    const double offset = std::atan(samples.displacement_px[i] / initial_focal_length) * 180.0 / std::numbers::pi;
+    guess += samples.pose_deg[i] + offset;
+    lowest_pose = std::min(lowest_pose, samples.pose_deg[i]);
+    highest_pose = std::max(highest_pose, samples.pose_deg[i]);
+  }
+  guess /= static_cast<double>(samples.pose_deg.size());
+
+  // Directions 80 degrees or more from any pose put the feature out of any plausible view
+  const double low = std::max(guess - kSearchRangeDeg, highest_pose - 80.0);
+  const double high = std::min(guess + kSearchRangeDeg, lowest_pose + 80.0);
+  double best = guess;
+  double best_residual = FitFocalLength(samples, guess).residual;
+  for (double direction = low; direction <= high; direction += kSearchStepDeg) {
+    const double residual = FitFocalLength(samples, direction).residual;
+    if (residual < best_residual) {
+      best = direction;
+      best_residual = residual;
+    }
+  }
+
+  constexpr double kInverseGolden = 0.6180339887498949;
+  double a = best - kSearchStepDeg;
+  double b = best + kSearchStepDeg;
+  double c = b - kInverseGolden * (b - a);
+  double d = a + kInverseGolden * (b - a);
+  for (int i = 0; i < 40; ++i) {
+    if (FitFocalLength(samples, c).residual < FitFocalLength(samples, d).residual) {
+      b = d;
+    } else {
+      a = c;
+    }
+    c = b - kInverseGolden * (b - a);
+    d = a + kInverseGolden * (b - a);
+  }
+  return FitFocalLength(samples, (a + b) / 2.0).focal_length;
+}
+
+}  // namespace
+
+CameraIntrinsics CameraIntrinsics::FromFov(int width, int height, float horizontal_fov_deg) noexcept {
+  const float focal_length = (static_cast<float>(width) / 2.0F) / std::tan(horizontal_fov_deg / 2.0F * kDegToRad);
+  return {.width = width,
+          .height = height,
+          .fx = focal_length,
+          .fy = focal_length,
+          .cx = static_cast<float>(width) / 2.0F,
+          .cy = static_cast<float>(height) / 2.0F};
+}
+
+CameraIntrinsics CameraIntrinsics::ScaledTo(int new_width, int new_height) const noexcept {
+  if (width <= 0 || height <= 0) {
+    return *this;
+  }
+  const float sx = static_cast<float>(new_width) / static_cast<float>(width);
+  const float sy = static_cast<float>(new_height) / static_cast<float>(height);
+  CameraIntrinsics scaled = *this;
+  scaled.width = new_width;
+  scaled.height = new_height;
+  scaled.fx = fx * sx;
+  scaled.fy = fy * sy;
+  scaled.cx = cx * sx;
+  scaled.cy = cy * sy;
+  return scaled;
+}
+
+float CameraIntrinsics::HorizontalFovDeg() const noexcept {
+  return FovDeg(static_cast<float>(width), cx, fx);
+}
+
+float CameraIntrinsics::VerticalFovDeg() const noexcept {
+  return FovDeg(static_cast<float>(height), cy, fy);
+}
+
+CameraModel::CameraModel(const CameraIntrinsics& intrinsics) : intrinsics_(intrinsics) {
+  if (!intrinsics_.Valid()) {
+    return;
+  }
+  pan_table_.resize(static_cast<size_t>(intrinsics_.width) + 1);
+  for (size_t i = 0; i < pan_table_.size(); ++i) {
+    pan_table_[i] = std::atan((static_cast<float>(i) - intrinsics_.cx) / intrinsics_.fx) * kRadToDeg;
+  }
+  tilt_table_.resize(static_cast<size_t>(intrinsics_.height) + 1);
+  for (size_t i = 0; i < tilt_table_.size(); ++i) {
+    tilt_table_[i] = std::atan((static_cast<float>(i) - intrinsics_.cy) / intrinsics_.fy) * kRadToDeg;
+  }
+}
+
+GimbalPose CameraModel::Angles(Point2D pixel) const noexcept {
+  if (!intrinsics_.Valid()) {
+    return {};
+  }
+  const Point2D undistorted = Undistort(pixel);
+  return {.pan = Lookup(pan_table_, undistorted.x, intrinsics_.cx, intrinsics_.fx),
+          .tilt = Lookup(tilt_table_, undistorted.y, intrinsics_.cy, intrinsics_.fy)};
+}
+
+Point2D CameraModel::Project(GimbalPose offset) const noexcept {
+  const float x = std::tan(offset.pan * kDegToRad);
+  const float y = std::tan(offset.tilt * kDegToRad);
+  const float factor = DistortionFactor(intrinsics_, x, y);
+  return {.x = intrinsics_.cx + intrinsics_.fx * x * factor, .y = intrinsics_.cy + intrinsics_.fy * y * factor};
+}
+
+Point2D CameraModel::Undistort(Point2D pixel) const noexcept {
+  if ((intrinsics_.k1 == 0.0F && intrinsics_.k2 == 0.0F) || !intrinsics_.Valid()) {
+    return pixel;
+  }
+  const float xd = (pixel.x - intrinsics_.cx) / intrinsics_.fx;
+  const float yd = (pixel.y - intrinsics_.cy) / intrinsics_.fy;
+  float x = xd;
+  float y = yd;
+  for (int i = 0; i < kUndistortIterations; ++i) {
+    const float factor = DistortionFactor(intrinsics_, x, y);
+    x = xd / factor;
+    y = yd / factor;
+  }
+  return {.x = intrinsics_.cx + intrinsics_.fx * x, .y = intrinsics_.cy + intrinsics_.fy * y};
+}
+
+float CameraModel::Lookup(const std::vector<float>& table, float position, float center,
+                          float focal_length) noexcept {
+  // The table covers the image; points beyond it (boxes clipped by the edge, undistorted corners) are rare
+  if (!(position >= 0.0F) || position >= static_cast<float>(table.size() - 1)) {
+    return std::atan((position - center) / focal_length) * kRadToDeg;
+  }
+  const auto index = static_cast<size_t>(position);
+  const float fraction = position - static_cast<float>(index);
+  return table[index] + fraction * (table[index + 1] - table[index]);
+}
+
+FovCalibrator::FovCalibrator(const CameraIntrinsics& initial, GimbalPose center, const FovCalibrationConfig& config)
+    : config_(config), initial_(initial), model_(initial) {
+  // Center first, then sweep pan and tilt from one end to the other
+  plan_.push_back(center);
+  const int steps = std::max(config_.steps, 1);
+  for (int k = -steps; k <= steps; ++k) {
+    if (k != 0) {
+      plan_.push_back({.pan = center.pan + config_.sweep_deg * static_cast<float>(k) / static_cast<float>(steps),
+                       .tilt = center.tilt});
+    }
+  }
+  for (int k = -steps; k <= steps; ++k) {
+    if (k != 0) {
+      plan_.push_back({.pan = center.pan,
+                       .tilt = center.tilt + config_.sweep_deg * static_cast<float>(k) / static_cast<float>(steps)});
+    }
+  }
+}
+
+std::optional<GimbalPose> FovCalibrator::Next(std::optional<Point2D> feature, Clock::time_point time) {
+  if (Done()) {
+    return std::nullopt;
+  }
+  if (!commanded_at_) {
+    commanded_at_ = time;
+  } else if (feature && time - *commanded_at_ >= config_.settle) {
+    AddObservation(plan_[next_pose_], *feature);
+    ++next_pose_;
+    commanded_at_ = time;
+    if (Done()) {
+      return std::nullopt;
+    }
+  }
+  return plan_[next_pose_];
+}
+
+void FovCalibrator::AddObservation(GimbalPose pose, Point2D feature) {
+  observations_.push_back({.pose = pose, .feature = model_.Undistort(feature)});
+}
+
+auto FovCalibrator::Solve() const -> std::expected<CameraIntrinsics, FovCalibrationError> {
+  if (observations_.size() < 3) {
+    return std::unexpected(FovCalibrationError::kTooFewObservations);
+  }
+
+  AxisSamples pan;
+  AxisSamples tilt;
+  const Observation& first = observations_.front();
+  GimbalPose pose_span;
+  Point2D feature_span;
+  for (const Observation& observation : observations_) {
+    pan.pose_deg.push_back(observation.pose.pan);
+    pan.displacement_px.push_back(observation.feature.x - initial_.cx);
+    tilt.pose_deg.push_back(observation.pose.tilt);
+    tilt.displacement_px.push_back(observation.feature.y - initial_.cy);
+
+    pose_span.pan = std::max(pose_span.pan, std::abs(observation.pose.pan - first.pose.pan));
+    pose_span.tilt = std::max(pose_span.tilt, std::abs(observation.pose.tilt - first.pose.tilt));
+    feature_span.x = std::max(feature_span.x, std::abs(observation.feature.x - first.feature.x));
+    feature_span.y = std::max(feature_span.y, std::abs(observation.feature.y - first.feature.y));
+  }
+
+  if (pose_span.pan < kMinPoseSpanDeg || pose_span.tilt < kMinPoseSpanDeg) {
+    return std::unexpected(FovCalibrationError::kTooFewObservations);
+  }
+  if (feature_span.x < kMinDisplacementPx || feature_span.y < kMinDisplacementPx) {
+    return std::unexpected(FovCalibrationError::kNoDisplacement);
+  }
+
+  CameraIntrinsics calibrated = initial_;
+  calibrated.fx = static_cast<float>(SolveFocalLength(pan, initial_.fx));
+  calibrated.fy = static_cast<float>(SolveFocalLength(tilt, initial_.fy));
+  if (!calibrated.Valid()) {
+    return std::unexpected(FovCalibrationError::kImplausible);
+  }
+
+  // Judge both focal lengths by the horizontal field of view they would give
+  const float width = static_cast<float>(calibrated.width);
+  const float horizontal_fov = FovDeg(width, calibrated.cx, calibrated.fx);
+  const float vertical_equivalent = FovDeg(width, calibrated.cx, calibrated.fy);
+  for (const float fov : {horizontal_fov, vertical_equivalent}) {
+    if (fov < config_.min_fov_deg || fov > config_.max_fov_deg) {
+      return std::unexpected(FovCalibrationError::kImplausible);
+    }
+  }
+  return calibrated;
+}
+
+}  // namespace client
@@ -0,0 +1,317 @@
+#include <client/app/closed_loop_rig.hpp>
+
+#include <client/comm/link_session.hpp>
+#include <client/comm/loopback_transport.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <utility>
+
+namespace client {
+
+namespace {
+
+using Duration = std::chrono::microseconds;
+
+/**
+ * @brief One direction of the simulated link.
+ * @details Bytes written to the sending end cross once the latency has passed since they were
+ * written, in order and at most bytes_per_second; the rest wait in the end's backlog, where the
+ * LinkSession's scheduler sees them as it would a congested Bluetooth buffer.
+ */
+class DelayedDirection {
+public:
+  DelayedDirection(comm::LoopbackTransport& from, Duration latency, uint32_t bytes_per_second, Duration tick) noexcept
+      : from_(from),
+        latency_(latency),
+        bytes_per_tick_(static_cast<double>(bytes_per_second) * std::chrono::duration<double>(tick).count()) {}
+
+  /// Timestamps the bytes written since the last call.
+  void Record(Duration now) {
+    const uint64_t written = from_.Stats().bytes_sent;
+    if (written > recorded_) {
+      marks_.push_back({.due = now + latency_, .bytes = written});
+      recorded_ = written;
+    }
+  }
+
+  /// Moves the bytes that are due to the peer.
+  void Deliver(Duration now) {
+    while (!marks_.empty() && marks_.front().due <= now) {
+      due_ = marks_.front().bytes;
+      marks_.pop_front();
+    }
+
+    const uint64_t available = due_ - delivered_;
+    size_t budget = comm::LoopbackTransport::kUnlimited;
+    if (bytes_per_tick_ > 0.0) {
+      // An idle link cannot bank more than one tick of throughput
+      credit_ = std::min(credit_ + bytes_per_tick_, std::max(bytes_per_tick_, 1.0));
+      budget = static_cast<size_t>(credit_);
+    }
+
+    const auto count = static_cast<size_t>(std::min<uint64_t>(available, budget));
+    if (count == 0) {
+      return;
+    }
+    const size_t moved = from_.Pump(count);
+    delivered_ += moved;
+    credit_ = std::max(credit_ - static_cast<double>(moved), 0.0);
+  }
+
+private:
+  struct Mark {
+    Duration due{0};
+    uint64_t bytes = 0;  ///< Bytes written in total when the mark was taken.
+  };
+
+  comm::LoopbackTransport& from_;
+  Duration latency_;
+  double bytes_per_tick_ = 0.0;  ///< Throughput per tick (0 = unlimited).
+  double credit_ = 0.0;
+  std::deque<Mark> marks_;
+  uint64_t recorded_ = 0;
+  uint64_t due_ = 0;
+  uint64_t delivered_ = 0;
+};
+
+/// Frame between exposure and arrival.
+struct CapturedFrame {
+  Duration arrival{0};
+  Frame frame;
+  std::optional<BoundingBox> truth;
+};
+
+/// Detection between frame arrival and result.
+struct PendingDetection {
+  Duration done{0};
+  Frame frame;
+  FaceDetectionResult result;
+};
+
+[[nodiscard]] double AngleBetween(GimbalPose lhs, GimbalPose rhs) noexcept {
+  const double pan = static_cast<double>(lhs.pan) - static_cast<double>(rhs.pan);
+  const double tilt = static_cast<double>(lhs.tilt) - static_cast<double>(rhs.tilt);
+  return std::hypot(pan, tilt);
+}
+
+[[nodiscard]] double Milliseconds(Duration duration) noexcept {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+}  // namespace
+
+ClosedLoopRig::ClosedLoopRig(const ClosedLoopRigConfig& config) : config_(config), camera_(config.camera) {}
+
+std::chrono::steady_clock::time_point ClosedLoopRig::SimulatedTime(Duration time) noexcept {
+  // Offset from the clock's epoch: a zero time point means "unknown" to LatencyTracker
+  return std::chrono::steady_clock::time_point(std::chrono::seconds(1)) + time;
+}
+
+ClosedLoopMetrics ClosedLoopRig::Run(const Controller& controller) {
+  ClosedLoopMetrics metrics;
+  const FaceTrajectory trajectory(config_.trajectory);
+  const Duration tick = std::max(config_.tick, Duration(1));
+  const Duration frame_period(1'000'000 / std::max(config_.fps, 1));
+
+  std::mt19937 rng(config_.seed);
+  std::normal_distribution<float> noise;
+
+  auto [host, device_end] = comm::LoopbackTransport::CreatePair();
+  VirtualGimbal gimbal(config_.gimbal);
+  VirtualGimbalDevice device(*device_end, gimbal);
+  DelayedDirection to_device(*host, config_.link_latency, config_.link_bytes_per_second, tick);
+  DelayedDirection to_host(*device_end, config_.link_latency, config_.link_bytes_per_second, tick);
+
+  Duration now{0};
+  std::map<uint32_t, Duration> awaiting_response;
+  double response_ms_total = 0.0;
+
+  comm::LinkSession session;
+  session.Attach(host.get());
+  session.SetDataReceivedCallback([&](std::span<const uint8_t> payload) {
+    const auto status = comm::Protocol::DeserializeStatus(payload);
+    if (!status) {
+      return;
+    }
+    const auto sent = awaiting_response.find(status->command_id);
+    if (sent == awaiting_response.end()) {
+      return;
+    }
+    ++metrics.responses;
+    response_ms_total += Milliseconds(now - sent->second);
+    // Older MOVEs were coalesced or superseded; they will not be answered
+    awaiting_response.erase(awaiting_response.begin(), std::next(sent));
+  });
+
+  if (!device_end->Open() || !host->Open()) {
+    return metrics;
+  }
+  session.Start();
+
+  std::deque<CapturedFrame> in_transit;
+  std::optional<PendingDetection> detection;
+  Duration next_capture{0};
+  uint64_t sequence = 0;
+  uint32_t next_command_id = 0;
+
+  double squared_error_total = 0.0;
+  uint64_t samples = 0;
+  std::optional<Duration> last_unsettled;
+  float pan_direction = 0.0F;
+  float tilt_direction = 0.0F;
+
+  for (now = Duration(0); now <= config_.duration; now += tick) {
+    device.SetTime(now);
+    to_device.Deliver(now);
+    to_host.Deliver(now);
+
+    const GimbalPose face = trajectory.At(now);
+    const GimbalPose pose = gimbal.Pose(now);
+
+    if (now >= next_capture) {
+      const FrameTiming timing{.presentation_time_us = now.count(),
+                               .arrival_time = SimulatedTime(now + config_.capture_latency),
+                               .sequence = ++sequence};
+      in_transit.push_back({.arrival = now + config_.capture_latency,
+                            .frame = camera_.Render(face, pose, timing),
+                            .truth = camera_.Project(face, pose)});
+      ++metrics.frames_captured;
+      next_capture += frame_period;
+    }
+
+    if (detection && detection->done <= now) {
+      ++metrics.detections;
+      if (const auto target = controller(detection->result, detection->frame)) {
+        const comm::ServoCommand cmd{.pan_angle = target->pan,
+                                     .tilt_angle = target->tilt,
+                                     .speed = 1.0F,
+                                     .smooth = true,
+                                     .command_id = ++next_command_id,
+                                     .timestamp_ms = static_cast<uint64_t>(Milliseconds(now))};
+        if (session.SendMove(cmd)) {
+          ++metrics.commands_sent;
+          awaiting_response[cmd.command_id] = now;
+        }
+      }
+      detection.reset();
+    }
+
+    while (!in_transit.empty() && in_transit.front().arrival <= now) {
+      CapturedFrame captured = std::move(in_transit.front());
+      in_transit.pop_front();
+      if (frame_callback_) {
+        frame_callback_(captured.frame);
+      }
+
+      if (detection) {
+        ++metrics.frames_dropped;
+        continue;
+      }
+
+      FaceDetectionResult result;
+      if (detector_) {
+        result = detector_(captured.frame);
+      } else if (captured.truth) {
+        FaceData truth;
+        truth.bounding_box = *captured.truth;
+        if (config_.detection_noise_px > 0.0F) {
+          truth.bounding_box.x += noise(rng) * config_.detection_noise_px;
+          truth.bounding_box.y += noise(rng) * config_.detection_noise_px;
+        }
+        truth.confidence = 1.0F;
+        truth.relative_distance = truth.CalculateRelativeDistance(captured.frame.Width(), captured.frame.Height());
+        truth.track_id = 1;
+        result.faces.push_back(truth);
+      }
+      result.frame_id = captured.frame.Timing().sequence;
+      result.frame_sequence = captured.frame.Timing().sequence;
+      result.processing_time_ms = static_cast<float>(Milliseconds(config_.inference_latency));
+      result.capture_time = SimulatedTime(captured.arrival);
+      result.detect_time = SimulatedTime(captured.arrival + config_.inference_latency);
+      detection = PendingDetection{.done = captured.arrival + config_.inference_latency,
+                                   .frame = std::move(captured.frame),
+                                   .result = std::move(result)};
+    }
+
+    to_device.Record(now);
+    to_host.Record(now);
+
+    const double error = AngleBetween(face, pose);
+    squared_error_total += error * error;
+    ++samples;
+    metrics.max_error_deg = std::max(metrics.max_error_deg, error);
+    metrics.final_error_deg = error;
+    if (error > static_cast<double>(config_.settle_tolerance_deg)) {
+      last_unsettled = now;
+    }
+
+    // The direction each axis first had to move in; going past the face after that is overshoot
+    const float pan_error = face.pan - pose.pan;
+    const float tilt_error = face.tilt - pose.tilt;
+    if (pan_direction == 0.0F && std::abs(pan_error) > config_.settle_tolerance_deg) {
+      pan_direction = std::copysign(1.0F, pan_error);
+    }
+    if (tilt_direction == 0.0F && std::abs(tilt_error) > config_.settle_tolerance_deg) {
+      tilt_direction = std::copysign(1.0F, tilt_error);
+    }
+    metrics.overshoot_deg = std::max({metrics.overshoot_deg, static_cast<double>(-pan_direction * pan_error),
+                                      static_cast<double>(-tilt_direction * tilt_error)});
+
+    if (config_.record_trace) {
+      metrics.trace.push_back({.time = now, .face = face, .pose = pose, .commanded = gimbal.Commanded()});
+    }
+  }
+
+  metrics.rms_error_deg = samples > 0 ? std::sqrt(squared_error_total / static_cast<double>(samples)) : 0.0;
+  metrics.commands_applied = device.Moves();
+  metrics.mean_response_ms = metrics.responses > 0 ? response_ms_total / static_cast<double>(metrics.responses) : 0.0;
+  if (metrics.final_error_deg <= static_cast<double>(config_.settle_tolerance_deg)) {
+    metrics.settle_time = last_unsettled ? *last_unsettled + tick : Duration(0);
+  }
+  return metrics;
+}
+
+ClosedLoopRig::Controller OpenLoopController() {
+  return [](const FaceDetectionResult& result, const Frame& frame) -> std::optional<GimbalPose> {
+    const auto face = result.HighestPriorityFace();
+    if (!face) {
+      return std::nullopt;
+    }
+
+    // The offset from the frame center scaled to the servo range, as the app once commanded
+    const Point2D offset = NormalizedOffset(face->Center(), frame.Width(), frame.Height());
+    return GimbalPose{.pan = offset.x * 90.0F, .tilt = offset.y * 45.0F};
+  };
+}
+
+ClosedLoopRig::Controller TrackingController(const GimbalControllerConfig& config,
+                                             const std::optional<CommandGateConfig>& gate) {
+  // std::function must be copyable, so the copies share one controller and gate
+  return [controller = std::make_shared<GimbalController>(config),
+          command_gate = gate ? std::make_shared<CommandGate>(*gate) : nullptr](
+             const FaceDetectionResult& result, const Frame& frame) -> std::optional<GimbalPose> {
+    const auto face = result.HighestPriorityFace();
+    if (!face) {
+      return std::nullopt;
+    }
+    const GimbalPose target = controller->Update(face->Center(), frame.Width(), frame.Height(), result.capture_time);
+    if (command_gate && !command_gate->ShouldSend(target, result.capture_time)) {
+      return std::nullopt;
+    }
+    return target;
+  };
+}
+
+}  // namespace client
@@ -0,0 +1,35 @@
+#include <client/app/command_gate.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace client {
+
+bool CommandGate::ShouldSend(GimbalPose target, GimbalPose velocity, Clock::time_point now) noexcept {
+  const float horizon = std::chrono::duration<float>(config_.velocity_horizon).count();
+  if (!(horizon > 0.0F)) {
+    velocity = {};
+  }
+
+  // Where the device has extrapolated the last target to by now
+  GimbalPose expected;
+  if (last_sent_) {
+    const float age = std::min(std::chrono::duration<float>(now - last_sent_time_).count(), horizon);
+    expected = {.pan = last_sent_->pan + last_velocity_.pan * std::max(age, 0.0F),
+                .tilt = last_sent_->tilt + last_velocity_.tilt * std::max(age, 0.0F)};
+  }
+  const bool changed = !last_sent_ || std::abs(target.pan - expected.pan) >= config_.min_change_deg ||
+                       std::abs(target.tilt - expected.tilt) >= config_.min_change_deg;
+  const bool keyframe = config_.keyframe_interval > Clock::duration::zero() &&
+                        now - last_sent_time_ >= config_.keyframe_interval;
+  if (!changed && !keyframe) {
+    ++suppressed_;
+    return false;
+  }
+  last_sent_ = target;
+  last_velocity_ = velocity;
+  last_sent_time_ = now;
+  return true;
+}
+
+}  // namespace client
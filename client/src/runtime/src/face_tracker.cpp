@@ -2,11 +2,14 @@
 
 #include <client/core/assert.hpp>
 #include <client/core/logger.hpp>
+#include <client/core/tracing.hpp>
 
 #include <chrono>
 #include <cstddef>
 #include <expected>
 #include <filesystem>
+#include <memory>
+#include <memory_resource>
 #include <utility>
 
 #include <opencv2/dnn.hpp>
@@ -15,9 +18,34 @@
 
 namespace client {
 
+namespace {
+
+/**
+ * @brief Releases the per-frame arena when a detection pass ends, including on error paths.
+ */
+class ArenaFrameScope {
+public:
+  explicit ArenaFrameScope(utils::FrameArena& arena) noexcept : arena_(arena) {}
+  ArenaFrameScope(const ArenaFrameScope&) = delete;
+  ArenaFrameScope(ArenaFrameScope&&) = delete;
+  ~ArenaFrameScope() { arena_.Reset(); }
+
+  ArenaFrameScope& operator=(const ArenaFrameScope&) = delete;
+  ArenaFrameScope& operator=(ArenaFrameScope&&) = delete;
+
+private:
+  utils::FrameArena& arena_;
+};
+
+}  // namespace
+
 auto FaceTracker::Initialize(const FaceTrackerConfig& config) -> std::expected<void, FaceTrackerError> {
   config_ = config;
 
+  if (!arena_) {
+    arena_ = std::make_unique<utils::FrameArena>();
+  }
+
   // Check if model file exists
   if (!std::filesystem::exists(config_.model_path)) {
     CLIENT_ERROR("Model file not found: {}", config_.model_path.string());
@@ -119,6 +147,19 @@ auto FaceTracker::Initialize(const FaceTrackerConfig& config) -> std::expected<v
 }
 
 auto FaceTracker::Detect(const Frame& frame) -> std::expected<FaceDetectionResult, FaceTrackerError> {
+  FaceDetectionResult result;
+  const auto detected = Detect(frame, result);
+  if (!detected) {
+    return std::unexpected(detected.error());
+  }
+  return result;
+}
+
+auto FaceTracker::Detect(const Frame& frame, FaceDetectionResult& result) -> std::expected<void, FaceTrackerError> {
+  CLIENT_SPAN("FaceTracker::Detect");
+
+  result.faces.clear();  // Keeps the capacity
+
   if (!initialized_) {
     return std::unexpected(FaceTrackerError::kNotInitialized);
   }
@@ -138,21 +179,23 @@ auto FaceTracker::Detect(const Frame& frame) -> std::expected<FaceDetectionResul
     return std::unexpected(FaceTrackerError::kNotInitialized);
   }
 
-  FaceDetectionResult result;
   result.frame_id = frames_processed_;
 
   auto start_time = std::chrono::high_resolution_clock::now();
 
+  // Temporaries below live in the per-frame arena; the scope must outlive them
+  const ArenaFrameScope arena_scope(*arena_);
+
   try {
+    std::pmr::vector<FaceData> faces(arena_->Resource());
+
     if (use_yunet_) {
       // Use YuNet detector
       yunet_detector_->setInputSize(cv::Size(frame.Width(), frame.Height()));
+      yunet_detector_->detect(frame.Mat(), yunet_output_);
 
-      cv::Mat faces;
-      yunet_detector_->detect(frame.Mat(), faces);
-
-      if (!faces.empty()) {
-        result.faces = ParseYuNetDetections(faces, frame.Width(), frame.Height());
+      if (!yunet_output_.empty()) {
+        faces = ParseYuNetDetections(yunet_output_, frame.Width(), frame.Height());
       }
     } else {
       // Use regular DNN
@@ -171,9 +214,12 @@ auto FaceTracker::Detect(const Frame& frame) -> std::expected<FaceDetectionResul
         return std::unexpected(FaceTrackerError::kProcessingFailed);
       }
 
-      result.faces = ParseDetections(output, frame.Width(), frame.Height());
+      faces = ParseDetections(output, frame.Width(), frame.Height());
     }
 
+    // Only the final result leaves the arena, into storage the caller keeps across frames
+    result.faces.assign(faces.begin(), faces.end());
+
     // Calculate relative distance for all detected faces
     for (auto& face : result.faces) {
       face.relative_distance = face.CalculateRelativeDistance(frame.Width(), frame.Height());
@@ -185,11 +231,16 @@ auto FaceTracker::Detect(const Frame& frame) -> std::expected<FaceDetectionResul
     auto end_time = std::chrono::high_resolution_clock::now();
     result.processing_time_ms = std::chrono::duration<float, std::milli>(end_time - start_time).count();
 
+    result.frame_sequence = frame.Timing().sequence;
+    result.capture_time = frame.Timing().arrival_time;
+    result.detect_time = std::chrono::steady_clock::now();
+
     ++frames_processed_;
 
-    return result;
+    return {};
   } catch (const cv::Exception& e) {
     CLIENT_ERROR("OpenCV exception during face detection: {}", e.what());
+    result.faces.clear();
     return std::unexpected(FaceTrackerError::kProcessingFailed);
   }
 }
@@ -217,18 +268,20 @@ cv::Mat FaceTracker::CreateBlob(const Frame& frame) const {
 }
 
 auto FaceTracker::ParseYuNetDetections(const cv::Mat& faces, int frame_width, int frame_height) const
-    -> std::vector<FaceData> {
+    -> std::pmr::vector<FaceData> {
   // FaceDetectorYN returns detections in format:
   // [x, y, w, h, x_re, y_re, x_le, y_le, x_nt, y_nt, x_rcm, y_rcm, x_lcm, y_lcm, score]
   // Shape: [N, 15] where N is number of detections
   // Coordinates are already in pixel coordinates relative to input image size
 
-  std::vector<FaceData> face_list;
+  std::pmr::vector<FaceData> face_list(arena_->Resource());
 
   if (faces.empty() || faces.rows == 0) {
     return face_list;
   }
 
+  face_list.reserve(static_cast<size_t>(faces.rows));
+
   // Log output shape for debugging (only once)
   static bool shape_logged = false;
   if (!shape_logged) {
@@ -288,12 +341,12 @@ auto FaceTracker::ParseYuNetDetections(const cv::Mat& faces, int frame_width, in
 }
 
 auto FaceTracker::ParseDetections(const cv::Mat& output, int frame_width, int frame_height) const
-    -> std::vector<FaceData> {
+    -> std::pmr::vector<FaceData> {
   // SSD-style detectors output: [1, 1, N, 7]
   // [batch_id, class_id, confidence, x1, y1, x2, y2]
   // Coordinates are normalized (0-1)
 
-  std::vector<FaceData> faces;
+  std::pmr::vector<FaceData> faces(arena_->Resource());
 
   if (output.empty()) {
     CLIENT_WARN("Empty output from network");
@@ -329,7 +382,8 @@ auto FaceTracker::ParseDetections(const cv::Mat& output, int frame_width, int fr
 
     if (detections.cols != values_per_detection) {
       // Reshape didn't work as expected, try manual extraction
-      detections = cv::Mat(num_detections, values_per_detection, CV_32F);
+      detections_scratch_.create(num_detections, values_per_detection, CV_32F);
+      detections = detections_scratch_;
 
       for (int i = 0; i < num_detections; ++i) {
         for (int j = 0; j < values_per_detection; ++j) {
@@ -347,7 +401,8 @@ auto FaceTracker::ParseDetections(const cv::Mat& output, int frame_width, int fr
     const int num_detections = output.size[1];
     const int values_per_detection = output.size[2];
 
-    detections = cv::Mat(num_detections, values_per_detection, CV_32F);
+    detections_scratch_.create(num_detections, values_per_detection, CV_32F);
+    detections = detections_scratch_;
 
     for (int i = 0; i < num_detections; ++i) {
       for (int j = 0; j < values_per_detection; ++j) {
@@ -373,6 +428,8 @@ auto FaceTracker::ParseDetections(const cv::Mat& output, int frame_width, int fr
     return faces;
   }
 
+  faces.reserve(static_cast<size_t>(detections.rows));
+
   // Parse SSD detections
   for (int i = 0; i < detections.rows; ++i) {
     const float confidence = detections.at<float>(i, 2);
@@ -426,23 +483,22 @@ auto FaceTracker::ParseDetections(const cv::Mat& output, int frame_width, int fr
 
   // Apply Non-Maximum Suppression if we have multiple detections
   if (faces.size() > 1 && config_.nms_threshold > 0.0F) {
-    std::vector<cv::Rect> boxes;
-    std::vector<float> scores;
-    boxes.reserve(faces.size());
-    scores.reserve(faces.size());
+    // cv::dnn::NMSBoxes only accepts std::allocator vectors, so these are reused members instead of arena storage
+    nms_boxes_.clear();
+    nms_scores_.clear();
+    nms_indices_.clear();
 
     for (const auto& face : faces) {
-      boxes.emplace_back(static_cast<int>(face.bounding_box.x), static_cast<int>(face.bounding_box.y),
-                         static_cast<int>(face.bounding_box.width), static_cast<int>(face.bounding_box.height));
-      scores.push_back(face.confidence);
+      nms_boxes_.emplace_back(static_cast<int>(face.bounding_box.x), static_cast<int>(face.bounding_box.y),
+                              static_cast<int>(face.bounding_box.width), static_cast<int>(face.bounding_box.height));
+      nms_scores_.push_back(face.confidence);
     }
 
-    std::vector<int> indices;
-    cv::dnn::NMSBoxes(boxes, scores, config_.confidence_threshold, config_.nms_threshold, indices);
+    cv::dnn::NMSBoxes(nms_boxes_, nms_scores_, config_.confidence_threshold, config_.nms_threshold, nms_indices_);
 
-    std::vector<FaceData> nms_faces;
-    nms_faces.reserve(indices.size());
-    for (int idx : indices) {
+    std::pmr::vector<FaceData> nms_faces(arena_->Resource());
+    nms_faces.reserve(nms_indices_.size());
+    for (int idx : nms_indices_) {
       nms_faces.push_back(faces[static_cast<size_t>(idx)]);
     }
     faces = std::move(nms_faces);
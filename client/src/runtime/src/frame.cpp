@@ -7,18 +7,21 @@ namespace client {
 Frame Frame::Clone() const {
   Frame result;
   result.mat_ = mat_.clone();
+  result.timing_ = timing_;
   return result;
 }
 
 Frame Frame::ConvertColor(int code) const {
   Frame result;
   cv::cvtColor(mat_, result.mat_, code);
+  result.timing_ = timing_;
   return result;
 }
 
 Frame Frame::Resize(int width, int height) const {
   Frame result;
   cv::resize(mat_, result.mat_, cv::Size(width, height));
+  result.timing_ = timing_;
   return result;
 }
 
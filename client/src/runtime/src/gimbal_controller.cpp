@@ -0,0 +1,155 @@
+#include <client/app/gimbal_controller.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+namespace client {
+
+namespace {
+
+[[nodiscard]] float Seconds(std::chrono::steady_clock::duration duration) noexcept {
+  return std::chrono::duration<float>(duration).count();
+}
+
+}  // namespace
+
+GimbalPose GimbalController::Update(GimbalPose offset, Clock::time_point capture_time) noexcept {
+  const auto since_last = capture_time - last_update_;
+  const bool restart = !updated_ || since_last > config_.stale_after;
+  const float dt = restart || since_last <= Clock::duration::zero() ? Seconds(config_.nominal_period)
+                                                                     : Seconds(since_last);
+
+  const GimbalPose camera = CameraPoseAt(capture_time);
+  GimbalPose face{.pan = camera.pan + offset.pan, .tilt = camera.tilt + offset.tilt};
+  if (config_.smoothing) {
+    // Smooth the absolute direction: the offset alone also moves whenever the gimbal does
+    if (restart) {
+      pan_filter_.Reset();
+      tilt_filter_.Reset();
+    }
+    face = {.pan = pan_filter_.Filter(face.pan, dt), .tilt = tilt_filter_.Filter(face.tilt, dt)};
+  }
+  target_.pan = UpdateAxis(config_.pan, pan_, face.pan, target_.pan, config_.pan_min, config_.pan_max, dt, restart);
+  target_.tilt =
+      UpdateAxis(config_.tilt, tilt_, face.tilt, target_.tilt, config_.tilt_min, config_.tilt_max, dt, restart);
+
+  if (pending_count_ == kMaxPending) {
+    // Far more updates than the actuation delay should allow: put the oldest into effect early
+    const Issued& oldest = pending_[pending_first_];
+    Follow(applied_, oldest.time);
+    applied_ = oldest.target;
+    pending_first_ = (pending_first_ + 1) % kMaxPending;
+    --pending_count_;
+  }
+  pending_[(pending_first_ + pending_count_) % kMaxPending] = {.time = capture_time, .target = target_};
+  ++pending_count_;
+
+  last_update_ = capture_time;
+  updated_ = true;
+  return target_;
+}
+
+float GimbalController::UpdateAxis(const AxisGains& gains, AxisState& state, float face, float target, float min,
+                                   float max, float dt, bool restart) const noexcept {
+  if (restart) {
+    state = {};
+  } else {
+    const float sample = (face - state.previous_face) / dt;
+    if (std::abs(sample) > config_.max_face_speed_deg_per_s) {
+      state.velocity = 0.0F;  // A jump (another face or a re-detection) says nothing about motion
+    } else {
+      state.velocity += config_.velocity_smoothing * (sample - state.velocity);
+    }
+  }
+  state.previous_face = face;
+
+  // Aim where the face will be once this target reaches the gimbal, correcting from where the
+  // feed-forward alone would move the target; a steady track then leaves no error to correct
+  const float feed_forward = gains.kff * state.velocity;
+  const float predicted = target + feed_forward * dt;
+  float error = face + feed_forward * Seconds(config_.lead_time) - predicted;
+  if (std::abs(error) < config_.deadband_deg) {
+    error = 0.0F;
+  }
+  const float derivative = restart ? 0.0F : (error - state.previous_error) / dt;
+  state.previous_error = error;
+
+  const float integral = state.integral + error * dt;
+  const float integral_term =
+      gains.ki != 0.0F ? std::clamp(gains.ki * integral, -gains.integral_limit_deg, gains.integral_limit_deg) : 0.0F;
+
+  const float step = feed_forward * dt + gains.kp * error + integral_term + gains.kd * derivative;
+  const float max_step = config_.max_slew_deg_per_s * dt;
+  const float next = std::clamp(target + std::clamp(step, -max_step, max_step), min, max);
+
+  // Anti-windup: the integral only accumulates while neither the slew limit nor the servo range holds the output
+  if (next == target + step && gains.ki != 0.0F) {
+    state.integral = std::clamp(integral, -gains.integral_limit_deg / gains.ki, gains.integral_limit_deg / gains.ki);
+  }
+  return next;
+}
+
+GimbalPose GimbalController::CameraPoseAt(Clock::time_point capture_time) noexcept {
+  // Targets issued at least actuation_delay before this frame had reached the gimbal when it was exposed
+  const auto cutoff = capture_time - config_.actuation_delay;
+  while (pending_count_ > 0 && pending_[pending_first_].time <= cutoff) {
+    const Issued& issued = pending_[pending_first_];
+    Follow(applied_, issued.time);
+    applied_ = issued.target;
+    pending_first_ = (pending_first_ + 1) % kMaxPending;
+    --pending_count_;
+  }
+  Follow(applied_, cutoff);
+  return camera_;
+}
+
+void GimbalController::Follow(GimbalPose target, Clock::time_point until) noexcept {
+  if (config_.gimbal_slew_deg_per_s <= 0.0F) {
+    camera_ = target;
+  } else if (until > camera_time_) {
+    const float max_step = config_.gimbal_slew_deg_per_s * Seconds(until - camera_time_);
+    camera_.pan += std::clamp(target.pan - camera_.pan, -max_step, max_step);
+    camera_.tilt += std::clamp(target.tilt - camera_.tilt, -max_step, max_step);
+  }
+  camera_time_ = std::max(camera_time_, until);
+}
+
+GimbalPose GimbalController::AngularOffset(Point2D point, int frame_width, int frame_height) const {
+  if (frame_width <= 0 || frame_height <= 0) {
+    return {};
+  }
+  return ModelFor(frame_width, frame_height).Angles(point);
+}
+
+const CameraModel& GimbalController::ModelFor(int frame_width, int frame_height) const {
+  if (!camera_model_ || camera_model_->Intrinsics().width != frame_width ||
+      camera_model_->Intrinsics().height != frame_height) {
+    camera_model_.emplace(config_.intrinsics ? config_.intrinsics->ScaledTo(frame_width, frame_height)
+                                             : CameraIntrinsics::FromFov(frame_width, frame_height,
+                                                                         config_.horizontal_fov_deg));
+  }
+  return *camera_model_;
+}
+
+void GimbalController::SetIntrinsics(const std::optional<CameraIntrinsics>& intrinsics) {
+  config_.intrinsics = intrinsics;
+  camera_model_.reset();
+}
+
+void GimbalController::Reset(GimbalPose target) noexcept {
+  target_ = target;
+  pan_ = {};
+  tilt_ = {};
+  pan_filter_.Reset();
+  tilt_filter_.Reset();
+  updated_ = false;
+  camera_ = target;
+  applied_ = target;
+  camera_time_ = {};
+  pending_first_ = 0;
+  pending_count_ = 0;
+}
+
+}  // namespace client
@@ -6,6 +6,7 @@
 
 #include <client/core/assert.hpp>
 #include <client/core/logger.hpp>
+#include <client/core/tracing.hpp>
 
 #include <QFile>
 #include <QQmlApplicationEngine>
@@ -28,7 +29,17 @@
 
 namespace client {
 
-namespace {}  // namespace
+namespace {
+
+/// QML-facing keys of the latency map, indexed by LatencyStage.
+constexpr std::array<const char*, kLatencyStageCount> kLatencyStageKeys = {
+    "captureToDetect",
+    "detectToSend",
+    "sendToAck",
+    "captureToAck",
+};
+
+}  // namespace
 
 void GuiBackend::UpdateStats(float fps, uint64_t frames_processed, size_t faces_detected) {
   bool changed = false;
@@ -55,6 +66,64 @@ void GuiBackend::UpdateStats(float fps, uint64_t frames_processed, size_t faces_
   }
 }
 
+void GuiBackend::UpdateLatency(const LatencySnapshot& snapshot) {
+  QVariantMap latency;
+  for (size_t i = 0; i < kLatencyStageCount; ++i) {
+    const auto stage = static_cast<LatencyStage>(i);
+    const auto& percentiles = snapshot.Stage(stage);
+
+    QVariantMap stage_data;
+    stage_data["p50"] = percentiles.p50_ms;
+    stage_data["p95"] = percentiles.p95_ms;
+    stage_data["p99"] = percentiles.p99_ms;
+    stage_data["count"] = static_cast<quint64>(percentiles.count);
+    latency[QString::fromLatin1(kLatencyStageKeys[i])] = stage_data;
+  }
+  latency["unmatchedAcks"] = static_cast<quint64>(snapshot.unmatched_acks);
+
+  {
+    std::unique_lock lock(data_mutex_);
+    latency_ = std::move(latency);
+  }
+  emit latencyChanged();
+}
+
+void GuiBackend::UpdateDeviceState(const comm::DeviceState& state) {
+  QVariantMap device;
+  device["valid"] = state.Valid();
+  device["pan"] = static_cast<qreal>(state.pan);
+  device["tilt"] = static_cast<qreal>(state.tilt);
+  device["targetPan"] = static_cast<qreal>(state.target_pan);
+  device["targetTilt"] = static_cast<qreal>(state.target_tilt);
+  device["moving"] = state.is_moving;
+  device["calibrated"] = state.is_calibrated;
+  device["freeHeap"] = static_cast<quint64>(state.free_heap);
+  device["uptimeMs"] = static_cast<quint64>(state.uptime_ms);
+
+  {
+    std::unique_lock lock(data_mutex_);
+    device_ = std::move(device);
+  }
+  emit deviceChanged();
+}
+
+void GuiBackend::UpdateLink(const comm::LinkStats& stats) {
+  QVariantMap link;
+  link["valid"] = stats.Valid();
+  link["rttMs"] = stats.rtt_ms;
+  link["minRttMs"] = stats.min_rtt_ms;
+  link["jitterMs"] = stats.jitter_ms;
+  link["clockOffsetMs"] = stats.clock_offset_ms;
+  link["sent"] = static_cast<quint64>(stats.sent);
+  link["lost"] = static_cast<quint64>(stats.lost);
+
+  {
+    std::unique_lock lock(data_mutex_);
+    link_ = std::move(link);
+  }
+  emit linkChanged();
+}
+
 void GuiBackend::UpdateFaces(const FaceDetectionResult& result) {
   QVariantList face_list;
   face_list.reserve(static_cast<qsizetype>(result.faces.size()));
@@ -222,6 +291,14 @@ void GuiBackend::calibrateDevice() {
   }
 }
 
+void GuiBackend::dumpTrace() {
+  CLIENT_INFO("Trace dump requested from QML");
+
+  if (trace_dump_callback_) {
+    trace_dump_callback_();
+  }
+}
+
 GuiWindow::GuiWindow(QObject* parent) : QObject(parent) {
   CLIENT_INFO("QML GUI window created");
 }
@@ -411,6 +488,8 @@ QImage GuiWindow::FrameToQImage(const Frame& frame) {
 }
 
 void GuiWindow::UpdateFrame(const Frame& frame, const std::optional<FaceDetectionResult>& result) {
+  CLIENT_SPAN("GuiWindow::UpdateFrame");
+
   if (frame.Empty()) {
     return;
   }
@@ -467,6 +546,24 @@ void GuiWindow::UpdateStats(float fps, uint64_t frames_processed, size_t faces_d
   }
 }
 
+void GuiWindow::UpdateLatency(const LatencySnapshot& snapshot) {
+  if (backend_) {
+    backend_->UpdateLatency(snapshot);
+  }
+}
+
+void GuiWindow::UpdateDeviceState(const comm::DeviceState& state) {
+  if (backend_) {
+    backend_->UpdateDeviceState(state);
+  }
+}
+
+void GuiWindow::UpdateLink(const comm::LinkStats& stats) {
+  if (backend_) {
+    backend_->UpdateLink(stats);
+  }
+}
+
 void GuiWindow::SetCurrentModel(ModelType model_type) {
   if (backend_) {
     backend_->SetCurrentModel(model_type);
@@ -546,4 +643,10 @@ void GuiWindow::SetCalibrateCallback(CalibrateCallback callback) noexcept {
   }
 }
 
+void GuiWindow::SetTraceDumpCallback(TraceDumpCallback callback) noexcept {
+  if (backend_) {
+    backend_->SetTraceDumpCallback(std::move(callback));
+  }
+}
+
 }  // namespace client
@@ -0,0 +1,79 @@
+#include <client/app/latency_tracker.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace client {
+
+namespace {
+
+[[nodiscard]] LatencyPercentiles Summarize(const utils::LatencyHistogram& histogram) noexcept {
+  constexpr double kUsPerMs = 1000.0;
+  return {
+      .p50_ms = static_cast<double>(histogram.Percentile(50.0)) / kUsPerMs,
+      .p95_ms = static_cast<double>(histogram.Percentile(95.0)) / kUsPerMs,
+      .p99_ms = static_cast<double>(histogram.Percentile(99.0)) / kUsPerMs,
+      .count = histogram.Count(),
+  };
+}
+
+}  // namespace
+
+void LatencyTracker::RecordDetection(Clock::time_point capture_time, Clock::time_point detect_time) noexcept {
+  if (capture_time.time_since_epoch().count() == 0) {
+    return;
+  }
+  HistogramFor(LatencyStage::kCaptureToDetect).Record(detect_time - capture_time);
+}
+
+void LatencyTracker::RecordSent(uint32_t command_id, Clock::time_point capture_time, Clock::time_point detect_time,
+                                Clock::time_point send_time) noexcept {
+  if (command_id == 0) {
+    return;
+  }
+
+  HistogramFor(LatencyStage::kDetectToSend).Record(send_time - detect_time);
+
+  auto& slot = in_flight_[command_id % kMaxInFlight];
+  if (slot.command_id != 0) {
+    evicted_.fetch_add(1, std::memory_order_relaxed);
+  }
+  slot = {.command_id = command_id, .capture_time = capture_time, .send_time = send_time};
+}
+
+bool LatencyTracker::RecordAck(uint32_t command_id, Clock::time_point ack_time) noexcept {
+  auto& slot = in_flight_[command_id % kMaxInFlight];
+  if (command_id == 0 || slot.command_id != command_id) {
+    unmatched_acks_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  HistogramFor(LatencyStage::kSendToAck).Record(ack_time - slot.send_time);
+  if (slot.capture_time.time_since_epoch().count() != 0) {
+    HistogramFor(LatencyStage::kCaptureToAck).Record(ack_time - slot.capture_time);
+  }
+
+  slot = {};
+  return true;
+}
+
+void LatencyTracker::Reset() noexcept {
+  in_flight_.fill({});
+  for (auto& histogram : histograms_) {
+    histogram.Reset();
+  }
+  unmatched_acks_.store(0, std::memory_order_relaxed);
+  evicted_.store(0, std::memory_order_relaxed);
+}
+
+LatencySnapshot LatencyTracker::Snapshot() const noexcept {
+  LatencySnapshot snapshot;
+  for (size_t i = 0; i < kLatencyStageCount; ++i) {
+    snapshot.stages[i] = Summarize(histograms_[i]);
+  }
+  snapshot.unmatched_acks = unmatched_acks_.load(std::memory_order_relaxed);
+  snapshot.evicted = evicted_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+}  // namespace client
@@ -0,0 +1,162 @@
+#include <client/app/metrics_server.hpp>
+
+#include <client/core/logger.hpp>
+
+#include <QByteArray>
+#include <QHostAddress>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QObject>
+#include <QString>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace client {
+
+namespace {
+
+constexpr qint64 kMaxRequestLineLength = 4096;
+constexpr std::string_view kMetricsContentType = "text/plain; version=0.0.4; charset=utf-8";
+constexpr std::string_view kTextContentType = "text/plain; charset=utf-8";
+
+[[nodiscard]] std::string MakeResponse(int status, std::string_view reason, std::string_view content_type,
+                                       std::string_view body) {
+  return std::format("HTTP/1.0 {} {}\r\nContent-Type: {}\r\nContent-Length: {}\r\nConnection: close\r\n\r\n{}",
+                     status, reason, content_type, body.size(), body);
+}
+
+/**
+ * @brief Answers a single request on a freshly accepted socket, then closes it.
+ * @tparam Socket QTcpSocket or QLocalSocket
+ */
+template <typename Socket>
+void ServeConnection(Socket* socket, const metrics::Registry& registry) {
+  QObject::connect(socket, &Socket::disconnected, socket, &QObject::deleteLater);
+  QObject::connect(socket, &Socket::readyRead, socket, [socket, &registry]() {
+    std::string response;
+    if (socket->canReadLine()) {
+      const QByteArray line = socket->readLine(kMaxRequestLineLength).trimmed();
+      response = MetricsServer::BuildResponse(std::string_view(line.constData(), static_cast<size_t>(line.size())),
+                                              registry);
+    } else if (socket->bytesAvailable() > kMaxRequestLineLength) {
+      response = MetricsServer::BuildResponse({}, registry);
+    } else {
+      return;
+    }
+
+    // Remaining request headers are ignored; one request per connection
+    QObject::disconnect(socket, &Socket::readyRead, nullptr, nullptr);
+    socket->write(response.data(), static_cast<qint64>(response.size()));
+    if constexpr (std::is_same_v<Socket, QLocalSocket>) {
+      socket->disconnectFromServer();
+    } else {
+      socket->disconnectFromHost();
+    }
+  });
+}
+
+}  // namespace
+
+MetricsServer::MetricsServer(const metrics::Registry& registry) noexcept : registry_(registry) {}
+
+MetricsServer::~MetricsServer() {
+  Stop();
+}
+
+auto MetricsServer::Start(const MetricsServerConfig& config) -> std::expected<void, MetricsServerError> {
+  if (!config.Enabled()) {
+    return std::unexpected(MetricsServerError::kNotConfigured);
+  }
+  if (Running()) {
+    return std::unexpected(MetricsServerError::kAlreadyRunning);
+  }
+
+  if (config.port != 0) {
+    auto server = std::make_unique<QTcpServer>();
+    if (!server->listen(QHostAddress::LocalHost, config.port)) {
+      CLIENT_ERROR("Metrics endpoint failed to listen on 127.0.0.1:{}: {}", config.port,
+                   server->errorString().toStdString());
+      return std::unexpected(MetricsServerError::kListenFailed);
+    }
+
+    QTcpServer* raw = server.get();
+    QObject::connect(raw, &QTcpServer::newConnection, raw, [this, raw]() {
+      while (QTcpSocket* socket = raw->nextPendingConnection()) {
+        ServeConnection(socket, registry_);
+      }
+    });
+    tcp_server_ = std::move(server);
+    CLIENT_INFO("Metrics endpoint listening on http://127.0.0.1:{}/metrics", Port());
+  }
+
+  if (!config.socket_path.empty()) {
+    const QString path = QString::fromStdString(config.socket_path);
+    QLocalServer::removeServer(path);  // Remove a stale socket left by a crashed run
+
+    auto server = std::make_unique<QLocalServer>();
+    if (!server->listen(path)) {
+      CLIENT_ERROR("Metrics endpoint failed to listen on {}: {}", config.socket_path,
+                   server->errorString().toStdString());
+      Stop();
+      return std::unexpected(MetricsServerError::kListenFailed);
+    }
+
+    QLocalServer* raw = server.get();
+    QObject::connect(raw, &QLocalServer::newConnection, raw, [this, raw]() {
+      while (QLocalSocket* socket = raw->nextPendingConnection()) {
+        ServeConnection(socket, registry_);
+      }
+    });
+    local_server_ = std::move(server);
+    CLIENT_INFO("Metrics endpoint listening on unix:{}", config.socket_path);
+  }
+
+  return {};
+}
+
+void MetricsServer::Stop() noexcept {
+  if (tcp_server_) {
+    tcp_server_->close();
+    tcp_server_.reset();
+  }
+  if (local_server_) {
+    local_server_->close();
+    local_server_.reset();
+  }
+}
+
+uint16_t MetricsServer::Port() const noexcept {
+  return tcp_server_ ? tcp_server_->serverPort() : 0;
+}
+
+std::string MetricsServer::BuildResponse(std::string_view request_line, const metrics::Registry& registry) {
+  const size_t method_end = request_line.find(' ');
+  if (request_line.empty() || method_end == std::string_view::npos) {
+    return MakeResponse(400, "Bad Request", kTextContentType, "Bad Request\n");
+  }
+
+  const std::string_view method = request_line.substr(0, method_end);
+  std::string_view target = request_line.substr(method_end + 1);
+  target = target.substr(0, target.find(' '));
+  target = target.substr(0, target.find('?'));
+
+  if (method != "GET") {
+    return MakeResponse(405, "Method Not Allowed", kTextContentType, "Method Not Allowed\n");
+  }
+  if (target != "/metrics" && target != "/") {
+    return MakeResponse(404, "Not Found", kTextContentType, "Not Found\n");
+  }
+
+  return MakeResponse(200, "OK", kMetricsContentType, registry.Expose());
+}
+
+}  // namespace client
@@ -0,0 +1,34 @@
+#include <client/app/one_euro_filter.hpp>
+
+#include <cmath>
+#include <numbers>
+
+namespace client {
+
+namespace {
+
+/// Smoothing factor of an exponential low-pass with the given cutoff, sampled dt seconds apart.
+[[nodiscard]] float Alpha(float cutoff_hz, float dt) noexcept {
+  const float tau = 1.0F / (2.0F * std::numbers::pi_v<float> * cutoff_hz);
+  return 1.0F / (1.0F + tau / dt);
+}
+
+}  // namespace
+
+float OneEuroFilter::Filter(float value, float dt) noexcept {
+  if (!initialized_ || !(dt > 0.0F)) {
+    if (!initialized_) {
+      value_ = value;
+      derivative_ = 0.0F;
+      initialized_ = true;
+    }
+    return value_;
+  }
+
+  derivative_ += Alpha(config_.derivative_cutoff_hz, dt) * ((value - value_) / dt - derivative_);
+  const float cutoff = config_.min_cutoff_hz + config_.beta * std::abs(derivative_);
+  value_ += Alpha(cutoff, dt) * (value - value_);
+  return value_;
+}
+
+}  // namespace client
@@ -0,0 +1,134 @@
+#include <client/app/synthetic_camera.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <optional>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace client {
+
+namespace {
+
+constexpr float kDegToRad = std::numbers::pi_v<float> / 180.0F;
+
+/// Angles at or beyond this are behind the image plane.
+constexpr float kMaxViewAngleDeg = 89.0F;
+
+const cv::Scalar kBackgroundColor(96, 96, 96);
+const cv::Scalar kFaceColor(140, 170, 220);
+const cv::Scalar kEyeColor(40, 40, 40);
+
+/// Unclipped image extent of the face.
+struct FaceExtent {
+  float left = 0.0F;
+  float right = 0.0F;
+  float top = 0.0F;
+  float bottom = 0.0F;
+};
+
+[[nodiscard]] std::optional<FaceExtent> ProjectFace(const SyntheticCameraConfig& config, float focal_length,
+                                                    GimbalPose face, GimbalPose pose) noexcept {
+  const float half_width = config.face_width_deg / 2.0F;
+  const float half_height = half_width * config.face_aspect;
+  const float dx = face.pan - pose.pan;
+  const float dy = face.tilt - pose.tilt;
+  if (std::abs(dx) + half_width >= kMaxViewAngleDeg || std::abs(dy) + half_height >= kMaxViewAngleDeg) {
+    return std::nullopt;
+  }
+
+  // Positive pan is to the right and positive tilt is down, as in image coordinates
+  const float cx = static_cast<float>(config.width) / 2.0F;
+  const float cy = static_cast<float>(config.height) / 2.0F;
+  return FaceExtent{.left = cx + focal_length * std::tan((dx - half_width) * kDegToRad),
+                    .right = cx + focal_length * std::tan((dx + half_width) * kDegToRad),
+                    .top = cy + focal_length * std::tan((dy - half_height) * kDegToRad),
+                    .bottom = cy + focal_length * std::tan((dy + half_height) * kDegToRad)};
+}
+
+}  // namespace
+
+GimbalPose FaceTrajectory::At(std::chrono::microseconds time) const noexcept {
+  const float seconds = std::chrono::duration<float>(time).count();
+  const float period = std::max(std::chrono::duration<float>(config_.period).count(), 1e-3F);
+  const float phase = 2.0F * std::numbers::pi_v<float> * seconds / period;
+
+  switch (config_.kind) {
+    case TrajectoryKind::kStatic:
+      return config_.start;
+    case TrajectoryKind::kStep:
+      if (time < config_.step_time) {
+        return config_.start;
+      }
+      return {.pan = config_.start.pan + config_.amplitude.pan, .tilt = config_.start.tilt + config_.amplitude.tilt};
+    case TrajectoryKind::kRamp:
+      return {.pan = config_.start.pan + config_.velocity.pan * seconds,
+              .tilt = config_.start.tilt + config_.velocity.tilt * seconds};
+    case TrajectoryKind::kSine:
+      return {.pan = config_.start.pan + config_.amplitude.pan * std::sin(phase),
+              .tilt = config_.start.tilt + config_.amplitude.tilt * std::sin(phase)};
+    case TrajectoryKind::kFigureEight:
+      return {.pan = config_.start.pan + config_.amplitude.pan * std::sin(phase),
+              .tilt = config_.start.tilt + config_.amplitude.tilt * std::sin(2.0F * phase)};
+  }
+  return config_.start;
+}
+
+SyntheticCamera::SyntheticCamera(const SyntheticCameraConfig& config) noexcept : config_(config) {
+  focal_length_ = (static_cast<float>(config_.width) / 2.0F) / std::tan(config_.horizontal_fov_deg / 2.0F * kDegToRad);
+}
+
+auto SyntheticCamera::Project(GimbalPose face, GimbalPose pose) const noexcept -> std::optional<BoundingBox> {
+  const auto extent = ProjectFace(config_, focal_length_, face, pose);
+  if (!extent) {
+    return std::nullopt;
+  }
+
+  // A detector only reports the visible part of a face cut off by the frame edge
+  const float x1 = std::max(extent->left, 0.0F);
+  const float y1 = std::max(extent->top, 0.0F);
+  const float x2 = std::min(extent->right, static_cast<float>(config_.width));
+  const float y2 = std::min(extent->bottom, static_cast<float>(config_.height));
+  if (x2 <= x1 || y2 <= y1) {
+    return std::nullopt;
+  }
+  return BoundingBox{.x = x1, .y = y1, .width = x2 - x1, .height = y2 - y1};
+}
+
+Frame SyntheticCamera::Render(GimbalPose face, GimbalPose pose, const FrameTiming& timing) const {
+  Frame frame(config_.width, config_.height, CV_8UC3);
+  cv::Mat& mat = frame.Mat();
+  mat.setTo(kBackgroundColor);
+
+  // Drawn unclipped, so a face at the edge is cut off exactly where Project() clips its box
+  if (const auto extent = ProjectFace(config_, focal_length_, face, pose)) {
+    const float center_x = (extent->left + extent->right) / 2.0F;
+    const float center_y = (extent->top + extent->bottom) / 2.0F;
+    const float axis_x = (extent->right - extent->left) / 2.0F;
+    const float axis_y = (extent->bottom - extent->top) / 2.0F;
+    cv::ellipse(mat, cv::Point(cvRound(center_x), cvRound(center_y)), cv::Size(cvRound(axis_x), cvRound(axis_y)),
+                0.0, 0.0, 360.0, kFaceColor, cv::FILLED, cv::LINE_AA);
+
+    const int eye_radius = std::max(1, cvRound(axis_x * 0.15F));
+    const int eye_y = cvRound(center_y - axis_y * 0.2F);
+    cv::circle(mat, cv::Point(cvRound(center_x - axis_x * 0.4F), eye_y), eye_radius, kEyeColor, cv::FILLED,
+               cv::LINE_AA);
+    cv::circle(mat, cv::Point(cvRound(center_x + axis_x * 0.4F), eye_y), eye_radius, kEyeColor, cv::FILLED,
+               cv::LINE_AA);
+  }
+
+  frame.SetTiming(timing);
+  return frame;
+}
+
+void SyntheticCamera::Capture(GimbalPose face, GimbalPose pose, const FrameTiming& timing) {
+  if (!frame_callback_) {
+    return;
+  }
+  frame_callback_(Render(face, pose, timing));
+}
+
+}  // namespace client
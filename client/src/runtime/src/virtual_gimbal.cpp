@@ -0,0 +1,179 @@
+#include <client/app/virtual_gimbal.hpp>
+
+#include <client/comm/compact_codec.hpp>
+#include <client/comm/move_codec.hpp>
+#include <client/comm/protocol.hpp>
+#include <client/core/logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace client {
+
+namespace {
+
+/// Device identification sent in the handshake response.
+constexpr const char* kDeviceId = "virtual-gimbal";
+
+[[nodiscard]] float Approach(float from, float target, float travel) noexcept {
+  const float remaining = target - from;
+  if (std::abs(remaining) <= travel) {
+    return target;
+  }
+  return from + std::copysign(travel, remaining);
+}
+
+}  // namespace
+
+GimbalPose VirtualGimbal::Segment::At(Duration now, float slew_deg_per_s) const noexcept {
+  if (now <= start) {
+    return from;
+  }
+
+  const float travel = slew_deg_per_s * std::chrono::duration<float>(now - start).count();
+  return {.pan = Approach(from.pan, target.pan, travel), .tilt = Approach(from.tilt, target.tilt, travel)};
+}
+
+void VirtualGimbal::Command(GimbalPose target, Duration now) noexcept {
+  const GimbalPose clamped = Clamp(target);
+
+  // A command issued before the period boundary only replaces the pending one
+  if (now < current_.start) {
+    current_.target = clamped;
+    return;
+  }
+
+  const Duration period = std::max(config_.pwm_period, Duration(1));
+  const Duration boundary = (now / period + 1) * period;
+  previous_ = current_;
+  current_.start = boundary;
+  current_.from = previous_.At(boundary, config_.slew_deg_per_s);
+  current_.target = clamped;
+}
+
+GimbalPose VirtualGimbal::Pose(Duration now) const noexcept {
+  if (now < current_.start) {
+    return previous_.At(now, config_.slew_deg_per_s);
+  }
+  return current_.At(now, config_.slew_deg_per_s);
+}
+
+void VirtualGimbal::Reset(GimbalPose pose) noexcept {
+  const GimbalPose clamped = Clamp(pose);
+  current_ = {.start = Duration(0), .from = clamped, .target = clamped};
+  previous_ = current_;
+}
+
+GimbalPose VirtualGimbal::Clamp(GimbalPose pose) const noexcept {
+  return {.pan = std::clamp(pose.pan, config_.pan_min, config_.pan_max),
+          .tilt = std::clamp(pose.tilt, config_.tilt_min, config_.tilt_max)};
+}
+
+VirtualGimbalDevice::VirtualGimbalDevice(comm::ITransport& transport, VirtualGimbal& gimbal)
+    : transport_(transport), gimbal_(gimbal) {
+  transport_.SetReceiveCallback([this](std::span<const uint8_t> data) {
+    decoder_.Feed(data, [this](const comm::Frame& frame) { OnFrame(frame); });
+  });
+}
+
+VirtualGimbalDevice::~VirtualGimbalDevice() {
+  transport_.SetReceiveCallback(nullptr);
+}
+
+void VirtualGimbalDevice::OnFrame(const comm::Frame& frame) {
+  switch (frame.type) {
+    case comm::FrameType::kHandshake:
+      OnHandshake();
+      break;
+    case comm::FrameType::kCompact:
+      OnCompactMove(frame.payload);
+      break;
+    case comm::FrameType::kCommand:
+      OnCommand(frame.payload);
+      break;
+    default:
+      break;
+  }
+}
+
+void VirtualGimbalDevice::OnHandshake() {
+  const comm::HandshakeResponseMessage response{.protocol_version = comm::kCompactProtocolVersion,
+                                                .device_id = kDeviceId,
+                                                .firmware_version = "sim",
+                                                .supported_features = {std::string(comm::kCompactControlFeature)},
+                                                .accepted = true,
+                                                .rejection_reason = {}};
+  const auto payload = comm::Protocol::SerializeHandshakeResponse(response);
+  if (!payload) {
+    CLIENT_WARN("Virtual gimbal failed to serialize handshake response: {}",
+                comm::ProtocolErrorToString(payload.error()));
+    return;
+  }
+  Send(comm::FrameType::kHandshake, *payload);
+}
+
+void VirtualGimbalDevice::OnCompactMove(std::span<const uint8_t> payload) {
+  const auto move = comm::DecodeCompactMove(payload);
+  if (!move) {
+    return;
+  }
+
+  gimbal_.Command({.pan = move->pan_angle, .tilt = move->tilt_angle}, now_);
+  ++moves_;
+
+  const GimbalPose pose = gimbal_.Pose(now_);
+  const GimbalPose target = gimbal_.Commanded();
+  const auto status = comm::EncodeCompactStatus({.pan_position = pose.pan,
+                                                 .tilt_position = pose.tilt,
+                                                 .target_pan = target.pan,
+                                                 .target_tilt = target.tilt,
+                                                 .sequence = move->sequence,
+                                                 .is_moving = pose != target,
+                                                 .is_calibrated = true,
+                                                 .rejected = false});
+  Send(comm::FrameType::kCompact, status.Bytes());
+}
+
+void VirtualGimbalDevice::OnCommand(std::span<const uint8_t> payload) {
+  // Only MOVE is modelled; other commands are dropped as unknown
+  const auto move = comm::DecodeMoveCommand(payload);
+  if (!move) {
+    return;
+  }
+
+  gimbal_.Command({.pan = move->pan_angle, .tilt = move->tilt_angle}, now_);
+  ++moves_;
+
+  const GimbalPose pose = gimbal_.Pose(now_);
+  const GimbalPose target = gimbal_.Commanded();
+  comm::StatusMessage msg;
+  msg.pan_position = pose.pan;
+  msg.tilt_position = pose.tilt;
+  msg.target_pan = target.pan;
+  msg.target_tilt = target.tilt;
+  msg.is_calibrated = true;
+  msg.is_moving = pose != target;
+  msg.has_device_status = true;
+  msg.command_id = move->command_id;
+  msg.timestamp_ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now_).count());
+  const auto status = comm::Protocol::SerializeStatus(msg);
+  if (status) {
+    Send(comm::FrameType::kResponse, *status);
+  }
+}
+
+void VirtualGimbalDevice::Send(comm::FrameType type, std::span<const uint8_t> payload) {
+  const auto frame = comm::EncodeFrame(type, payload);
+  if (!frame) {
+    return;
+  }
+  if (const auto written = transport_.Write(*frame); !written) {
+    CLIENT_WARN("Virtual gimbal failed to write response: {}", comm::TransportErrorToString(written.error()));
+  }
+}
+
+}  // namespace client
@@ -0,0 +1,258 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/bluetooth.hpp>
+#include <client/comm/framing.hpp>
+#include <client/comm/move_codec.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+#ifdef CLIENT_COMM_HAS_NETWORK
+
+#include <QAbstractSocket>
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QHostAddress>
+#include <QMetaObject>
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+
+namespace {
+
+using client::comm::BluetoothState;
+using client::comm::FrameType;
+using Clock = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+/// Tracker MOVE rate: one every kMovePeriod.
+constexpr milliseconds kMovePeriod{5};
+constexpr uint32_t kMoves = 200;
+
+/// Length of each simulated long GUI frame (QML rendering plus inference) that blocks the GUI thread.
+constexpr milliseconds kGuiStall{50};
+
+/**
+ * @brief Device end of a TCP link, served from its own thread so it keeps time while the GUI thread is busy.
+ * @details Records when each MOVE arrives and answers each heartbeat with a status response. The
+ * handshake is left unanswered, so the link stays on protobuf MOVEs.
+ */
+class DeviceStandIn {
+public:
+  DeviceStandIn() {
+    context_.moveToThread(&thread_);
+    thread_.start(QThread::TimeCriticalPriority);
+    QMetaObject::invokeMethod(&context_, [this] { Listen(); }, Qt::BlockingQueuedConnection);
+  }
+
+  DeviceStandIn(const DeviceStandIn&) = delete;
+  DeviceStandIn& operator=(const DeviceStandIn&) = delete;
+
+  ~DeviceStandIn() { Stop(); }
+
+  /// Closes the server on its own thread and joins it.
+  void Stop() {
+    if (!thread_.isRunning()) {
+      return;
+    }
+    QMetaObject::invokeMethod(&context_, [this] { server_.reset(); }, Qt::BlockingQueuedConnection);
+    thread_.quit();
+    thread_.wait();
+  }
+
+  [[nodiscard]] uint16_t Port() const noexcept { return port_; }
+
+  /// Arrival time of each MOVE, indexed by command ID; valid once stopped.
+  [[nodiscard]] const std::array<Clock::time_point, kMoves + 1>& Arrivals() const noexcept { return arrivals_; }
+
+  /// Heartbeats received; valid once stopped.
+  [[nodiscard]] size_t Heartbeats() const noexcept { return heartbeats_; }
+
+private:
+  void Listen() {
+    server_ = std::make_unique<QTcpServer>();
+    QObject::connect(server_.get(), &QTcpServer::newConnection, server_.get(), [this] {
+      socket_ = server_->nextPendingConnection();  // Owned by the server
+      socket_->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+      QObject::connect(socket_, &QTcpSocket::readyRead, socket_, [this] { OnReadyRead(); });
+    });
+    if (server_->listen(QHostAddress::LocalHost)) {
+      port_ = server_->serverPort();
+    }
+  }
+
+  void OnReadyRead() {
+    const auto now = Clock::now();
+    const QByteArray data = socket_->readAll();
+    const std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(data.constData()),
+                                         static_cast<size_t>(data.size()));
+    decoder_.Feed(bytes, [this, now](const client::comm::Frame& frame) {
+      if (frame.type != FrameType::kCommand) {
+        return;
+      }
+      if (const auto move = client::comm::DecodeMoveCommand(frame.payload); move) {
+        if (move->command_id != 0 && move->command_id <= kMoves) {
+          arrivals_[move->command_id] = now;
+        }
+        return;
+      }
+      if (const auto heartbeat = client::comm::Protocol::DeserializeHeartbeat(frame.payload); heartbeat) {
+        ++heartbeats_;
+        Reply(heartbeat->sequence);
+      }
+    });
+  }
+
+  void Reply(uint32_t command_id) {
+    // Runs on the device thread, where a failed REQUIRE could not unwind the test
+    const auto status = client::comm::Protocol::SerializeStatus({.command_id = command_id});
+    CHECK(status.has_value());
+    if (!status) {
+      return;
+    }
+    const auto frame = client::comm::EncodeFrame(FrameType::kResponse, *status);
+    CHECK(frame.has_value());
+    if (!frame) {
+      return;
+    }
+    socket_->write(reinterpret_cast<const char*>(frame->data()), static_cast<qint64>(frame->size()));
+  }
+
+  QThread thread_;
+  QObject context_;  ///< Lives on thread_; the context of every call made there.
+  std::unique_ptr<QTcpServer> server_;
+  QTcpSocket* socket_ = nullptr;
+  client::comm::FrameDecoder decoder_;
+  uint16_t port_ = 0;
+  std::array<Clock::time_point, kMoves + 1> arrivals_{};
+  size_t heartbeats_ = 0;
+};
+
+void BusyFor(milliseconds duration) {
+  const auto until = Clock::now() + duration;
+  volatile uint64_t sink = 0;
+  while (Clock::now() < until) {
+    sink = sink + 1;
+  }
+}
+
+/// Runs the GUI thread's event loop until @p done returns true or @p timeout passes.
+template <typename Predicate>
+bool ProcessEventsUntil(Predicate&& done, milliseconds timeout) {
+  const auto deadline = Clock::now() + timeout;
+  while (!done()) {
+    if (Clock::now() >= deadline) {
+      return false;
+    }
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST_SUITE("client::comm comm thread") {
+  TEST_CASE("Comm thread: MOVE latency stays flat while the GUI thread is saturated") {
+    int argc = 1;
+    std::array<char, 24> name = {"client_comm_integration"};
+    std::array<char*, 2> argv = {name.data(), nullptr};
+    QCoreApplication app(argc, argv.data());
+
+    DeviceStandIn device;
+    REQUIRE_NE(device.Port(), 0);
+
+    // The test thread is the GUI thread: it owns the manager and receives every callback
+    const auto gui_thread = std::this_thread::get_id();
+    client::comm::BluetoothManager manager;
+    size_t responses = 0;
+    bool off_gui_thread = false;
+    manager.SetDataReceivedCallback([&](std::span<const uint8_t> /*data*/) {
+      ++responses;
+      off_gui_thread = off_gui_thread || std::this_thread::get_id() != gui_thread;
+    });
+
+    REQUIRE(manager.Connect(std::format("tcp://127.0.0.1:{}", device.Port())).has_value());
+    REQUIRE(ProcessEventsUntil([&] { return manager.State() == BluetoothState::kConnected; }, milliseconds(5000)));
+
+    std::array<Clock::time_point, kMoves + 1> submitted{};
+    std::atomic<bool> tracking{true};
+
+    // Tracker thread submits at a fixed rate, as the detection pipeline does
+    std::thread tracker([&manager, &submitted, &tracking] {
+      auto next = Clock::now();
+      for (uint32_t id = 1; id <= kMoves; ++id) {
+        std::this_thread::sleep_until(next);
+        submitted[id] = Clock::now();
+        CHECK(manager.SendCommand({.pan_angle = static_cast<float>(id % 90), .command_id = id}).has_value());
+        next += kMovePeriod;
+      }
+      tracking.store(false, std::memory_order_release);
+    });
+
+    // GUI thread: back-to-back long frames, each followed by a heartbeat from the GUI's own timer and
+    // one pass of its event loop, which is when the device's responses reach the callbacks
+    uint32_t heartbeats = 0;
+    while (tracking.load(std::memory_order_acquire)) {
+      BusyFor(kGuiStall);
+      CHECK(manager.SendHeartbeat(++heartbeats).has_value());
+      QCoreApplication::processEvents();
+    }
+    tracker.join();
+
+    CHECK(ProcessEventsUntil([&] { return responses == heartbeats; }, milliseconds(2000)));
+    CHECK_EQ(manager.QueueDepth(), 0U);
+    REQUIRE(manager.Disconnect().has_value());
+    CHECK(ProcessEventsUntil([&] { return manager.State() == BluetoothState::kDisconnected; }, milliseconds(2000)));
+    device.Stop();
+
+    CHECK_EQ(device.Heartbeats(), heartbeats);
+    CHECK_EQ(responses, heartbeats);
+    CHECK_FALSE(off_gui_thread);
+
+    std::vector<double> latencies_ms;
+    std::vector<double> intervals_ms;
+    Clock::time_point previous{};
+    for (uint32_t id = 1; id <= kMoves; ++id) {
+      const auto arrival = device.Arrivals()[id];
+      if (arrival == Clock::time_point{}) {
+        continue;  // Coalesced: a newer MOVE replaced it before it was written
+      }
+      latencies_ms.push_back(std::chrono::duration<double, std::milli>(arrival - submitted[id]).count());
+      if (previous != Clock::time_point{}) {
+        intervals_ms.push_back(std::chrono::duration<double, std::milli>(arrival - previous).count());
+      }
+      previous = arrival;
+    }
+
+    REQUIRE_GE(latencies_ms.size(), kMoves * 9 / 10);
+    std::ranges::sort(latencies_ms);
+    std::ranges::sort(intervals_ms);
+    const double p50 = latencies_ms[latencies_ms.size() / 2];
+    const double p99 = latencies_ms[latencies_ms.size() * 99 / 100];
+    const double max_latency = latencies_ms.back();
+    const double max_interval = intervals_ms.back();
+    MESSAGE("MOVE submit-to-device latency p50 " << p50 << " ms, p99 " << p99 << " ms, max " << max_latency
+                                                << " ms; longest gap between MOVEs " << max_interval
+                                                << " ms; GUI frames " << heartbeats << " x " << kGuiStall.count()
+                                                << " ms");
+
+    // Were the link driven by the GUI thread, MOVEs would wait out whole GUI frames
+    CHECK_LT(p99, 10.0);
+    CHECK_LT(max_latency, static_cast<double>(kGuiStall.count()) / 2.0);
+    CHECK_LT(max_interval, static_cast<double>(kGuiStall.count()) / 2.0);
+  }
+}
+
+#endif  // CLIENT_COMM_HAS_NETWORK
@@ -0,0 +1,192 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/datagram_channel.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+using client::comm::DatagramChannel;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+/// Impairments of the simulated WiFi link, applied independently to each datagram.
+struct LinkProfile {
+  uint32_t loss_percent = 0;
+  uint32_t duplicate_percent = 0;
+  microseconds base_delay{0};
+  microseconds max_jitter{0};  ///< Uniform extra delay; reorders datagrams sent closer together than this.
+};
+
+/// One direction of the simulated link.
+class LossyPipe {
+public:
+  LossyPipe(const LinkProfile& profile, uint32_t seed) : profile_(profile), random_(seed) {}
+
+  void Send(std::span<const uint8_t> datagram, std::chrono::steady_clock::time_point now) {
+    if (Percent() < profile_.loss_percent) {
+      return;
+    }
+    const size_t copies = Percent() < profile_.duplicate_percent ? 2 : 1;
+    for (size_t i = 0; i < copies; ++i) {
+      const auto jitter =
+          microseconds(std::uniform_int_distribution<microseconds::rep>(0, profile_.max_jitter.count())(random_));
+      in_transit_.push_back({now + profile_.base_delay + jitter, {datagram.begin(), datagram.end()}});
+    }
+  }
+
+  /// Hands every datagram due by @p now to @p receive, earliest first.
+  template <typename ReceiveFn>
+  void Deliver(std::chrono::steady_clock::time_point now, ReceiveFn&& receive) {
+    std::ranges::stable_sort(in_transit_, {}, &InTransit::due);
+    const auto due = std::ranges::find_if(in_transit_, [now](const InTransit& entry) { return entry.due > now; });
+    std::vector<InTransit> arrived(std::make_move_iterator(in_transit_.begin()), std::make_move_iterator(due));
+    in_transit_.erase(in_transit_.begin(), due);
+    for (const auto& entry : arrived) {
+      receive(std::span<const uint8_t>(entry.datagram));
+    }
+  }
+
+private:
+  struct InTransit {
+    std::chrono::steady_clock::time_point due;
+    std::vector<uint8_t> datagram;
+  };
+
+  uint32_t Percent() { return static_cast<uint32_t>(random_() % 100); }
+
+  LinkProfile profile_;
+  std::minstd_rand random_;
+  std::vector<InTransit> in_transit_;
+};
+
+/// Payload carrying a 32-bit counter, so the receiver can check ordering.
+std::vector<uint8_t> Counter(uint32_t value) {
+  return {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value >> 16),
+          static_cast<uint8_t>(value >> 24)};
+}
+
+uint32_t CounterOf(std::span<const uint8_t> payload) {
+  return static_cast<uint32_t>(payload[0]) | (static_cast<uint32_t>(payload[1]) << 8) |
+         (static_cast<uint32_t>(payload[2]) << 16) | (static_cast<uint32_t>(payload[3]) << 24);
+}
+
+/// Client and device channels joined by a LossyPipe each way, advanced in 1 ms ticks.
+struct SimulatedWifi {
+  DatagramChannel host{0x11};
+  DatagramChannel device{0x22};
+  LossyPipe up;
+  LossyPipe down;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::time_point(std::chrono::hours(1));
+
+  std::vector<uint32_t> moves;    ///< kLatest payloads the device delivered.
+  std::vector<uint32_t> configs;  ///< kReliable payloads the device delivered.
+
+  explicit SimulatedWifi(const LinkProfile& profile) : up(profile, 1), down(profile, 2) {}
+
+  [[nodiscard]] std::chrono::steady_clock::time_point At(uint32_t tick) const { return start + milliseconds(tick); }
+
+  auto HostSend(uint32_t tick) {
+    return [this, tick](std::span<const uint8_t> datagram) { up.Send(datagram, At(tick)); };
+  }
+
+  auto DeviceSend(uint32_t tick) {
+    return [this, tick](std::span<const uint8_t> datagram) { down.Send(datagram, At(tick)); };
+  }
+
+  void Tick(uint32_t tick) {
+    const auto now = At(tick);
+    up.Deliver(now, [&](std::span<const uint8_t> datagram) {
+      const auto result = device.Receive(
+          datagram, now,
+          [&](std::span<const uint8_t> payload) {
+            const auto header = client::comm::DecodeDatagramHeader(datagram);
+            (header->kind == client::comm::DatagramKind::kLatest ? moves : configs).push_back(CounterOf(payload));
+          },
+          DeviceSend(tick));
+      CHECK(result.has_value());
+    });
+    down.Deliver(now, [&](std::span<const uint8_t> datagram) {
+      CHECK(host.Receive(datagram, now, [](std::span<const uint8_t>) {}, HostSend(tick)).has_value());
+    });
+    host.PollRetransmits(now, HostSend(tick));
+  }
+};
+
+}  // namespace
+
+TEST_SUITE("client::comm datagram load") {
+  TEST_CASE("DatagramChannel over a lossy link: 200 Hz MOVEs stay fresh, configuration arrives exactly once") {
+    const LinkProfile profile{
+        .loss_percent = 10, .duplicate_percent = 3, .base_delay = milliseconds(2), .max_jitter = milliseconds(8)};
+    SimulatedWifi wifi(profile);
+
+    // Ten seconds of tracking at 200 Hz, with a configuration change every 100 ms
+    uint32_t next_move = 0;
+    uint32_t next_config = 0;
+    for (uint32_t tick = 0; tick < 10'000; ++tick) {
+      if (tick % 5 == 0) {
+        REQUIRE(wifi.host.SendLatest(Counter(next_move++), wifi.At(tick), wifi.HostSend(tick)));
+      }
+      if (tick % 100 == 0) {
+        REQUIRE(wifi.host.SendReliable(Counter(next_config++), wifi.At(tick), wifi.HostSend(tick)));
+      }
+      wifi.Tick(tick);
+    }
+    for (uint32_t tick = 10'000; tick < 15'000 && wifi.host.ReliablePending() != 0; ++tick) {
+      wifi.Tick(tick);
+    }
+
+    const auto& stats = wifi.device.Stats();
+    MESSAGE("MOVEs sent: " << next_move << ", delivered: " << stats.received << ", lost: " << stats.lost
+                           << ", late: " << stats.late << ", duplicates: " << stats.duplicates
+                           << ", jitter: " << stats.jitter_us
+                           << " us, retransmissions: " << wifi.host.Stats().retransmissions);
+
+    // Latest-wins: strictly increasing, never a stale target after a newer one
+    CHECK(std::ranges::adjacent_find(wifi.moves, std::ranges::greater_equal{}) == wifi.moves.end());
+    CHECK_EQ(stats.received, wifi.moves.size());
+    CHECK_GT(stats.late, 0U);
+    CHECK_GT(stats.LossRate(), 0.05);
+    CHECK_LT(stats.LossRate(), 0.4);
+    // The link adds 0-8 ms uniformly; the estimator converges to about a third of that
+    CHECK_GT(stats.jitter_us, 1000U);
+    CHECK_LT(stats.jitter_us, 5000U);
+
+    // Reliable: every configuration exactly once and in order
+    std::vector<uint32_t> expected(next_config);
+    std::ranges::generate(expected, [n = 0U]() mutable { return n++; });
+    CHECK((wifi.configs == expected));
+    CHECK_EQ(wifi.host.ReliablePending(), 0U);
+    CHECK_GT(wifi.host.Stats().retransmissions, 0U);
+  }
+
+  TEST_CASE("DatagramChannel over a clean link: Nothing is lost, late or retransmitted") {
+    SimulatedWifi wifi(LinkProfile{.base_delay = milliseconds(1)});
+
+    uint32_t next_move = 0;
+    for (uint32_t tick = 0; tick < 1000; ++tick) {
+      REQUIRE(wifi.host.SendLatest(Counter(next_move++), wifi.At(tick), wifi.HostSend(tick)));
+      if (tick % 50 == 0) {
+        REQUIRE(wifi.host.SendReliable(Counter(tick / 50), wifi.At(tick), wifi.HostSend(tick)));
+      }
+      wifi.Tick(tick);
+    }
+    for (uint32_t tick = 1000; tick < 1010; ++tick) {
+      wifi.Tick(tick);
+    }
+
+    const auto& stats = wifi.device.Stats();
+    CHECK_EQ(stats.received, next_move);
+    CHECK_EQ(stats.lost + stats.late + stats.duplicates, 0U);
+    CHECK_EQ(stats.jitter_us, 0U);
+    CHECK_EQ(wifi.configs.size(), 20U);
+    CHECK_EQ(wifi.host.Stats().retransmissions, 0U);
+  }
+}
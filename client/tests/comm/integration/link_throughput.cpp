@@ -0,0 +1,140 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/compact_codec.hpp>
+#include <client/comm/framing.hpp>
+#include <client/comm/move_codec.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+namespace {
+
+/// SPP link rate being simulated, in bits per second.
+constexpr double kLinkBitsPerSecond = 115200.0;
+
+/// UART-style framing: 8 data bits plus start and stop bits per byte.
+constexpr double kBitsPerByte = 10.0;
+
+/// Simulated session length; long enough for command IDs and timestamps to reach realistic varint sizes.
+constexpr double kSimulatedSeconds = 10.0;
+
+[[nodiscard]] size_t FramedSize(client::comm::FrameType type, std::span<const uint8_t> payload) {
+  std::array<uint8_t, client::comm::MaxEncodedFrameSize(client::comm::kMaxFramePayloadSize)> frame{};
+  return client::comm::EncodeFrame(type, payload, frame).value_or(0);
+}
+
+/**
+ * @brief Runs command/acknowledgement round trips over a simulated half-duplex link.
+ * @param round_trip_bytes Returns the framed bytes of command @p n plus its acknowledgement
+ * @return Commands acknowledged per second
+ */
+[[nodiscard]] double CommandsPerSecond(const std::function<size_t(uint32_t n, uint64_t now_ms)>& round_trip_bytes) {
+  const double byte_seconds = kBitsPerByte / kLinkBitsPerSecond;
+  double elapsed = 0.0;
+  uint32_t commands = 0;
+
+  while (true) {
+    const auto now_ms = static_cast<uint64_t>(elapsed * 1000.0);
+    const double cost = static_cast<double>(round_trip_bytes(commands + 1, now_ms)) * byte_seconds;
+    if (elapsed + cost > kSimulatedSeconds) {
+      break;
+    }
+    elapsed += cost;
+    ++commands;
+  }
+
+  return commands / kSimulatedSeconds;
+}
+
+}  // namespace
+
+TEST_SUITE("client::comm link throughput") {
+  TEST_CASE("Compact control: Commands per second on a 115 kbit/s SPP link") {
+    // Device uptime and timestamps an hour into a session, as the firmware reports them
+    constexpr uint64_t kDeviceUptimeMs = 3'600'000;
+
+    const double v1 = CommandsPerSecond([](uint32_t n, uint64_t now_ms) {
+      const client::comm::ServoCommand cmd{
+          .pan_angle = 31.7F, .tilt_angle = -12.4F, .command_id = n, .timestamp_ms = kDeviceUptimeMs + now_ms};
+      const auto command = client::comm::EncodeMoveCommand(cmd);
+
+      const client::comm::StatusMessage status{.pan_position = 30.9F,
+                                               .tilt_position = -12.1F,
+                                               .target_pan = 31.7F,
+                                               .target_tilt = -12.4F,
+                                               .is_calibrated = true,
+                                               .is_moving = true,
+                                               .has_device_status = true,
+                                               .command_id = n,
+                                               .free_heap = 180'000,
+                                               .uptime_ms = kDeviceUptimeMs + now_ms,
+                                               .timestamp_ms = kDeviceUptimeMs + now_ms};
+      std::array<uint8_t, client::comm::kMaxFramePayloadSize> response{};
+      const size_t response_size = client::comm::Protocol::SerializeStatus(status, response).value_or(0);
+
+      return FramedSize(client::comm::FrameType::kCommand, command.Bytes()) +
+             FramedSize(client::comm::FrameType::kResponse, std::span<const uint8_t>(response.data(), response_size));
+    });
+
+    const double v2 = CommandsPerSecond([](uint32_t n, uint64_t) {
+      const auto sequence = static_cast<uint8_t>(n);
+      const auto command = client::comm::EncodeCompactMove(
+          {.pan_angle = 31.7F, .tilt_angle = -12.4F, .sequence = sequence});
+      const auto status = client::comm::EncodeCompactStatus({.pan_position = 30.9F,
+                                                             .tilt_position = -12.1F,
+                                                             .target_pan = 31.7F,
+                                                             .target_tilt = -12.4F,
+                                                             .sequence = sequence,
+                                                             .is_moving = true,
+                                                             .is_calibrated = true});
+
+      return FramedSize(client::comm::FrameType::kCompact, command.Bytes()) +
+             FramedSize(client::comm::FrameType::kCompact, status.Bytes());
+    });
+
+    MESSAGE("115200 bit/s link: v1 protobuf " << v1 << " cmd/s, v2 compact " << v2 << " cmd/s (" << v2 / v1
+                                             << "x)");
+    CHECK_GT(v1, 0.0);
+    CHECK_GT(v2, 2.0 * v1);
+  }
+
+  TEST_CASE("Windowed acks: Commands per second without a response per MOVE") {
+    const auto compact_move = [](uint32_t n) {
+      return client::comm::EncodeCompactMove(
+          {.pan_angle = 31.7F, .tilt_angle = -12.4F, .sequence = static_cast<uint8_t>(n)});
+    };
+    const client::comm::CompactStatus device{.pan_position = 30.9F,
+                                             .tilt_position = -12.1F,
+                                             .target_pan = 31.7F,
+                                             .target_tilt = -12.4F,
+                                             .is_moving = true,
+                                             .is_calibrated = true};
+
+    const double per_move = CommandsPerSecond([&](uint32_t n, uint64_t) {
+      auto status = device;
+      status.sequence = static_cast<uint8_t>(n);
+      return FramedSize(client::comm::FrameType::kCompact, compact_move(n).Bytes()) +
+             FramedSize(client::comm::FrameType::kCompact, client::comm::EncodeCompactStatus(status).Bytes());
+    });
+
+    // The firmware acknowledges every kFlushCount (8) MOVEs with one WindowAck
+    constexpr uint32_t kMovesPerAck = 8;
+    const double windowed = CommandsPerSecond([&](uint32_t n, uint64_t) {
+      size_t bytes = FramedSize(client::comm::FrameType::kCompact, compact_move(n).Bytes());
+      if (n % kMovesPerAck == 0) {
+        client::comm::WindowAck ack{.status = device, .received = 0x7F};
+        ack.status.sequence = static_cast<uint8_t>(n);
+        bytes += FramedSize(client::comm::FrameType::kWindowAck, client::comm::EncodeWindowAck(ack).Bytes());
+      }
+      return bytes;
+    });
+
+    MESSAGE("115200 bit/s link: v2 per-MOVE status " << per_move << " cmd/s, windowed acks " << windowed
+                                                     << " cmd/s (" << windowed / per_move << "x)");
+    CHECK_GT(windowed, 1.5 * per_move);
+  }
+}
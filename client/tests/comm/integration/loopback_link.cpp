@@ -0,0 +1,254 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/compact_codec.hpp>
+#include <client/comm/framing.hpp>
+#include <client/comm/link_session.hpp>
+#include <client/comm/loopback_transport.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+using client::comm::FrameType;
+using client::comm::LinkSession;
+using client::comm::LoopbackTransport;
+
+/// SPP link rate being simulated, in bits per second.
+constexpr double kLinkBitsPerSecond = 115200.0;
+
+/// UART-style framing: 8 data bits plus start and stop bits per byte.
+constexpr double kBitsPerByte = 10.0;
+
+/// Bytes the link carries in each direction per simulated millisecond.
+constexpr double kBytesPerTick = kLinkBitsPerSecond / kBitsPerByte / 1000.0;
+
+/// MOVEs the device answers with one windowed acknowledgement.
+constexpr size_t kMovesPerAck = 4;
+
+constexpr uint32_t kCalibrateId = 0x4000'0001;
+
+/**
+ * @brief Firmware stand-in on the far end of the loopback link.
+ * @details Accepts protocol v2 with windowed acks, acknowledges every kMovesPerAck compact MOVEs
+ * and answers CALIBRATE, dropping the first copy as a lossy link would.
+ */
+class DeviceStandIn {
+public:
+  explicit DeviceStandIn(LoopbackTransport& transport) : transport_(transport) {
+    transport_.SetReceiveCallback([this](std::span<const uint8_t> data) {
+      decoder_.Feed(data, [this](const client::comm::Frame& frame) { OnFrame(frame); });
+    });
+  }
+
+  /// Acknowledges the MOVEs received since the last acknowledgement.
+  void FlushAck() {
+    if (unacked_ == 0) {
+      return;
+    }
+    const auto ack = client::comm::EncodeWindowAck(
+        {.status = {.sequence = newest_, .is_calibrated = calibrated_}, .received = received_});
+    Send(FrameType::kWindowAck, ack.Bytes());
+    received_ = 0;
+    unacked_ = 0;
+  }
+
+  [[nodiscard]] size_t Moves() const noexcept { return moves_; }
+  [[nodiscard]] size_t Calibrates() const noexcept { return calibrates_; }
+  [[nodiscard]] float LastPan() const noexcept { return last_pan_; }
+
+private:
+  void OnFrame(const client::comm::Frame& frame) {
+    switch (frame.type) {
+      case FrameType::kHandshake:
+        OnHandshake();
+        break;
+      case FrameType::kCompact:
+        OnMove(frame.payload);
+        break;
+      case FrameType::kCommand:
+        OnCommand(frame.payload);
+        break;
+      default:
+        break;
+    }
+  }
+
+  void OnHandshake() {
+    const client::comm::HandshakeResponseMessage response{
+        .protocol_version = client::comm::kCompactProtocolVersion,
+        .device_id = "loopback",
+        .firmware_version = "1.0.0",
+        .supported_features = {std::string(client::comm::kCompactControlFeature),
+                               std::string(client::comm::kWindowAckFeature)},
+        .accepted = true,
+        .rejection_reason = {}};
+    const auto payload = client::comm::Protocol::SerializeHandshakeResponse(response);
+    REQUIRE(payload.has_value());
+    Send(FrameType::kHandshake, *payload);
+  }
+
+  void OnMove(std::span<const uint8_t> payload) {
+    const auto move = client::comm::DecodeCompactMove(payload);
+    REQUIRE(move.has_value());
+    ++moves_;
+    last_pan_ = move->pan_angle;
+
+    if (unacked_ != 0) {
+      const auto distance = static_cast<uint8_t>(move->sequence - newest_);
+      received_ = distance < 32 ? (received_ << distance) | (uint32_t{1} << (distance - 1)) : 0;
+    }
+    newest_ = move->sequence;
+    if (++unacked_ == kMovesPerAck) {
+      FlushAck();
+    }
+  }
+
+  void OnCommand(std::span<const uint8_t> payload) {
+    const auto calibrate = client::comm::Protocol::SerializeCalibrate(kCalibrateId);
+    REQUIRE(calibrate.has_value());
+    if (!std::ranges::equal(payload, *calibrate)) {
+      return;
+    }
+
+    if (++calibrates_ == 1) {
+      return;
+    }
+    calibrated_ = true;
+    const auto status =
+        client::comm::Protocol::SerializeStatus({.is_calibrated = true, .command_id = kCalibrateId});
+    REQUIRE(status.has_value());
+    Send(FrameType::kResponse, *status);
+  }
+
+  void Send(FrameType type, std::span<const uint8_t> payload) {
+    const auto frame = client::comm::EncodeFrame(type, payload);
+    REQUIRE(frame.has_value());
+    REQUIRE(transport_.Write(*frame).has_value());
+  }
+
+  LoopbackTransport& transport_;
+  client::comm::FrameDecoder decoder_;
+  uint8_t newest_ = 0;
+  uint32_t received_ = 0;
+  size_t unacked_ = 0;
+  size_t moves_ = 0;
+  size_t calibrates_ = 0;
+  bool calibrated_ = false;
+  float last_pan_ = 0.0F;
+};
+
+/// LinkSession and device stand-in joined by a loopback link pumped at kLinkBitsPerSecond.
+struct SimulatedLink {
+  std::unique_ptr<LoopbackTransport> host;
+  std::unique_ptr<LoopbackTransport> device;
+  LinkSession session;
+  std::unique_ptr<DeviceStandIn> firmware;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  double credit_up = 0.0;
+  double credit_down = 0.0;
+  size_t peak_backlog = 0;
+
+  SimulatedLink() {
+    auto [host_end, device_end] = LoopbackTransport::CreatePair();
+    host = std::move(host_end);
+    device = std::move(device_end);
+    firmware = std::make_unique<DeviceStandIn>(*device);
+    session.Attach(host.get());
+    REQUIRE(device->Open().has_value());
+    REQUIRE(host->Open().has_value());
+    session.Start();
+  }
+
+  /// Advances one millisecond: moves a millisecond's worth of bytes each way and polls retransmits.
+  void Tick(uint32_t tick) {
+    peak_backlog = std::max(peak_backlog, host->Backlog());
+    credit_up += kBytesPerTick;
+    credit_down += kBytesPerTick;
+    credit_up -= static_cast<double>(host->Pump(static_cast<size_t>(credit_up)));
+    credit_down -= static_cast<double>(device->Pump(static_cast<size_t>(credit_down)));
+    session.PollRetransmits(start + std::chrono::milliseconds(tick));
+  }
+};
+
+}  // namespace
+
+TEST_SUITE("client::comm loopback link") {
+  TEST_CASE("LinkSession over loopback: Negotiates, acknowledges and retransmits at 115 kbit/s") {
+    SimulatedLink link;
+    link.session.SetRetransmitTimeout(std::chrono::milliseconds(100));
+
+    std::vector<uint32_t> acked;
+    bool calibrated = false;
+    link.session.SetAckCallback([&acked](uint32_t command_id) { acked.push_back(command_id); });
+    link.session.SetDataReceivedCallback([&calibrated](std::span<const uint8_t> data) {
+      const auto status = client::comm::Protocol::DeserializeStatus(data);
+      calibrated = calibrated || (status && status->command_id == kCalibrateId && status->is_calibrated);
+    });
+
+    // 100 Hz tracking for two seconds, with a calibration early on
+    uint32_t next_id = 1;
+    for (uint32_t tick = 0; tick < 2000; ++tick) {
+      if (tick == 20) {
+        const auto calibrate = client::comm::Protocol::SerializeCalibrate(kCalibrateId);
+        REQUIRE(calibrate.has_value());
+        REQUIRE(link.session.SendReliable(kCalibrateId, *calibrate).has_value());
+      }
+      if (tick % 10 == 0) {
+        REQUIRE(link.session.SendMove({.pan_angle = static_cast<float>(tick % 90), .command_id = next_id++})
+                    .has_value());
+      }
+      link.Tick(tick);
+    }
+    link.firmware->FlushAck();
+    for (uint32_t tick = 2000; tick < 2050; ++tick) {
+      link.Tick(tick);
+    }
+
+    CHECK(link.session.CompactControlActive());
+    CHECK(link.session.WindowAckActive());
+    CHECK(calibrated);
+    CHECK_EQ(link.firmware->Calibrates(), 2U);
+    CHECK_EQ(link.session.Retransmissions(), 1U);
+
+    // The first MOVEs go out as protobuf until the handshake response arrives
+    const size_t sent = next_id - 1;
+    CHECK_EQ(link.session.Scheduler().Coalesced(), 0U);
+    CHECK_GE(link.firmware->Moves(), sent - 2);
+    CHECK_EQ(acked.size(), link.firmware->Moves());
+    CHECK(std::ranges::is_sorted(acked));
+    CHECK_EQ(acked.back(), sent);
+  }
+
+  TEST_CASE("LinkSession over loopback: Latest-wins MOVEs keep the backlog bounded when oversubscribed") {
+    SimulatedLink link;
+
+    // A MOVE every millisecond needs about twice what the link carries
+    uint32_t next_id = 1;
+    float pan = 0.0F;
+    for (uint32_t tick = 0; tick < 1000; ++tick) {
+      pan = static_cast<float>(tick % 180) - 90.0F;
+      REQUIRE(link.session.SendMove({.pan_angle = pan, .command_id = next_id++}).has_value());
+      link.Tick(tick);
+    }
+    for (uint32_t tick = 1000; tick < 1050; ++tick) {
+      link.Tick(tick);
+    }
+
+    MESSAGE("MOVEs sent: " << next_id - 1 << ", delivered: " << link.firmware->Moves()
+                           << ", coalesced: " << link.session.Scheduler().Coalesced()
+                           << ", peak backlog: " << link.peak_backlog << " bytes");
+    CHECK_GT(link.session.Scheduler().Coalesced(), 0U);
+    CHECK_LT(link.firmware->Moves(), next_id - 1);
+    CHECK_LE(link.peak_backlog, client::comm::CommandScheduler::kDefaultLowWatermark + 64);
+    // Nothing stale is left behind: the device ends on the newest target
+    CHECK_EQ(link.firmware->LastPan(), doctest::Approx(pan).epsilon(0.001));
+  }
+}
@@ -0,0 +1,91 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/move_codec.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace {
+
+constexpr int kIterations = 200000;
+
+/// Runs fn kIterations times and returns the mean time per call in nanoseconds.
+template <typename Fn>
+[[nodiscard]] double NanosecondsPerOp(Fn&& fn) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    fn(i);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / kIterations;
+}
+
+}  // namespace
+
+TEST_SUITE("client::comm::Protocol benchmark") {
+  TEST_CASE("Protocol: Servo command serialization cost") {
+    client::comm::ServoCommand cmd{.pan_angle = 30.0F, .tilt_angle = -12.0F, .command_id = 1, .timestamp_ms = 5};
+    std::array<uint8_t, 128> buffer{};
+    size_t sink = 0;
+
+    const double vector_ns = NanosecondsPerOp([&](int i) {
+      cmd.command_id = static_cast<uint32_t>(i);
+      sink += client::comm::Protocol::SerializeServoCommand(cmd)->size();
+    });
+    const double span_ns = NanosecondsPerOp([&](int i) {
+      cmd.command_id = static_cast<uint32_t>(i);
+      sink += client::comm::Protocol::SerializeServoCommand(cmd, buffer).value_or(0);
+    });
+
+    MESSAGE("SerializeServoCommand: vector " << vector_ns << " ns/op, span " << span_ns << " ns/op");
+    CHECK_GT(sink, 0);
+  }
+
+  TEST_CASE("MoveCodec: Hand-rolled MOVE encoding cost") {
+    client::comm::ServoCommand cmd{.pan_angle = 30.0F, .tilt_angle = -12.0F, .command_id = 1, .timestamp_ms = 5};
+    std::array<uint8_t, client::comm::kMaxMoveCommandSize> buffer{};
+    size_t sink = 0;
+
+    const double protobuf_ns = NanosecondsPerOp([&](int i) {
+      cmd.command_id = static_cast<uint32_t>(i);
+      sink += client::comm::Protocol::SerializeServoCommand(cmd, buffer).value_or(0);
+    });
+    const double codec_ns = NanosecondsPerOp([&](int i) {
+      cmd.command_id = static_cast<uint32_t>(i);
+      sink += client::comm::EncodeMoveCommand(cmd, buffer).value_or(0);
+    });
+    const double decode_ns = NanosecondsPerOp([&]([[maybe_unused]] int i) {
+      sink += client::comm::DecodeMoveCommand(buffer)->command_id;
+    });
+
+    MESSAGE("MOVE encode: protobuf " << protobuf_ns << " ns/op, EncodeMoveCommand " << codec_ns
+                                     << " ns/op; DecodeMoveCommand " << decode_ns << " ns/op");
+    CHECK_GT(sink, 0);
+  }
+
+  TEST_CASE("Protocol: Status deserialization cost") {
+    const client::comm::StatusMessage status{.pan_position = 10.0F,
+                                             .tilt_position = 5.0F,
+                                             .is_moving = true,
+                                             .has_device_status = true,
+                                             .command_id = 42,
+                                             .free_heap = 120000,
+                                             .uptime_ms = 3600000};
+    std::array<uint8_t, 128> buffer{};
+    const auto size = client::comm::Protocol::SerializeStatus(status, buffer);
+    REQUIRE(size.has_value());
+    const std::span<const uint8_t> payload(buffer.data(), *size);
+    uint64_t sink = 0;
+
+    const double parse_ns = NanosecondsPerOp([&]([[maybe_unused]] int i) {
+      sink += client::comm::Protocol::DeserializeStatus(payload)->command_id;
+    });
+
+    MESSAGE("DeserializeStatus: " << parse_ns << " ns/op");
+    CHECK_EQ(sink, uint64_t{42} * kIterations);
+  }
+}
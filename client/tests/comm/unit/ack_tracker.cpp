@@ -0,0 +1,67 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/ack_tracker.hpp>
+#include <client/comm/compact_codec.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+[[nodiscard]] client::comm::WindowAck Ack(uint8_t newest, uint32_t received) {
+  return client::comm::WindowAck{.status = {.sequence = newest}, .received = received};
+}
+
+}  // namespace
+
+TEST_SUITE("client::comm::AckTracker") {
+  TEST_CASE("AckTracker: Expands a window into command IDs, oldest first") {
+    client::comm::AckTracker tracker;
+    std::vector<uint32_t> acked;
+
+    // Newest is 0x105 (sequence 0x05); bits 0 and 2 are 0x104 and 0x102
+    const auto count = tracker.Apply(Ack(0x05, 0b101), 0x106, [&](uint32_t id) { acked.push_back(id); });
+
+    CHECK_EQ(count, 3U);
+    const std::vector<uint32_t> expected = {0x102, 0x104, 0x105};
+    CHECK_EQ(acked, expected);
+  }
+
+  TEST_CASE("AckTracker: Reports each command once across overlapping windows") {
+    client::comm::AckTracker tracker;
+    std::vector<uint32_t> acked;
+    const auto record = [&](uint32_t id) { acked.push_back(id); };
+
+    CHECK_EQ(tracker.Apply(Ack(10, 0b11), 10, record), 3U);
+    // The next window restates 8..10 and adds 11 and 12
+    CHECK_EQ(tracker.Apply(Ack(12, 0b1111), 12, record), 2U);
+    // A repeated ack is a no-op
+    CHECK_EQ(tracker.Apply(Ack(12, 0b1111), 12, record), 0U);
+
+    const std::vector<uint32_t> expected = {8, 9, 10, 11, 12};
+    CHECK_EQ(acked, expected);
+  }
+
+  TEST_CASE("AckTracker: Skips IDs below 1 at the start of a session") {
+    client::comm::AckTracker tracker;
+    std::vector<uint32_t> acked;
+
+    CHECK_EQ(tracker.Apply(Ack(2, 0xFFFFFFFF), 2, [&](uint32_t id) { acked.push_back(id); }), 2U);
+    const std::vector<uint32_t> expected = {1, 2};
+    CHECK_EQ(acked, expected);
+  }
+
+  TEST_CASE("AckTracker: Forgets IDs older than the history and after Reset") {
+    client::comm::AckTracker tracker;
+    CHECK(tracker.MarkAcked(100));
+    CHECK_FALSE(tracker.MarkAcked(100));
+    CHECK(tracker.MarkAcked(99));
+    CHECK_FALSE(tracker.MarkAcked(0));
+
+    CHECK(tracker.MarkAcked(100 + client::comm::AckTracker::kHistory));
+    CHECK_FALSE(tracker.MarkAcked(100));
+
+    tracker.Reset();
+    CHECK(tracker.MarkAcked(100));
+  }
+}
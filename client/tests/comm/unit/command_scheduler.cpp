@@ -0,0 +1,127 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/command_scheduler.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace {
+
+/// Records written frames and simulates a transport backlog.
+struct FakeLink {
+  std::vector<std::vector<uint8_t>> written;
+  bool fail = false;
+
+  [[nodiscard]] bool operator()(std::span<const uint8_t> frame) {
+    if (fail) {
+      return false;
+    }
+    written.emplace_back(frame.begin(), frame.end());
+    return true;
+  }
+};
+
+const std::vector<uint8_t> kMoveA = {0x00, 0x0A, 0x00};
+const std::vector<uint8_t> kMoveB = {0x00, 0x0B, 0x00};
+const std::vector<uint8_t> kMoveC = {0x00, 0x0C, 0x00};
+const std::vector<uint8_t> kHome = {0x00, 0x48, 0x00};
+const std::vector<uint8_t> kCalibrate = {0x00, 0x43, 0x00};
+
+}  // namespace
+
+TEST_SUITE("client::comm::CommandScheduler") {
+  TEST_CASE("CommandScheduler: Writes a MOVE immediately when the link is idle") {
+    client::comm::CommandScheduler scheduler;
+    FakeLink link;
+
+    CHECK_FALSE(scheduler.SubmitMove(kMoveA));
+    CHECK_EQ(scheduler.Drain(0, link), 1);
+    REQUIRE_EQ(link.written.size(), 1);
+    CHECK_EQ(link.written[0], kMoveA);
+    CHECK_EQ(scheduler.Depth(), 0);
+    CHECK_EQ(scheduler.Written(), 1);
+  }
+
+  TEST_CASE("CommandScheduler: Keeps only the newest MOVE while the link is backed up") {
+    client::comm::CommandScheduler scheduler(16);
+    FakeLink link;
+
+    scheduler.SubmitMove(kMoveA);
+    CHECK_EQ(scheduler.Drain(64, link), 0);
+    CHECK(scheduler.SubmitMove(kMoveB));
+    CHECK_EQ(scheduler.Drain(32, link), 0);
+    CHECK(scheduler.SubmitMove(kMoveC));
+
+    CHECK_EQ(scheduler.Depth(), 1);
+    CHECK_EQ(scheduler.Coalesced(), 2);
+    CHECK(link.written.empty());
+
+    // Backlog drained below the watermark
+    CHECK_EQ(scheduler.Drain(15, link), 1);
+    REQUIRE_EQ(link.written.size(), 1);
+    CHECK_EQ(link.written[0], kMoveC);
+  }
+
+  TEST_CASE("CommandScheduler: Control frames bypass the watermark and precede the MOVE") {
+    client::comm::CommandScheduler scheduler(16);
+    FakeLink link;
+
+    scheduler.SubmitMove(kMoveA);
+    scheduler.SubmitControl(kHome);
+    scheduler.SubmitControl(kCalibrate);
+    CHECK_EQ(scheduler.Depth(), 3);
+
+    CHECK_EQ(scheduler.Drain(1000, link), 2);
+    REQUIRE_EQ(link.written.size(), 2);
+    CHECK_EQ(link.written[0], kHome);
+    CHECK_EQ(link.written[1], kCalibrate);
+    CHECK_EQ(scheduler.Depth(), 1);
+    CHECK_EQ(scheduler.Coalesced(), 0);
+  }
+
+  TEST_CASE("CommandScheduler: Control frames count toward the backlog") {
+    client::comm::CommandScheduler scheduler(4);
+    FakeLink link;
+
+    scheduler.SubmitControl(kHome);
+    scheduler.SubmitMove(kMoveA);
+
+    // The HOME frame itself fills the link past the watermark, so the MOVE waits
+    CHECK_EQ(scheduler.Drain(2, link), 1);
+    CHECK_EQ(scheduler.Depth(), 1);
+    CHECK_EQ(scheduler.Drain(0, link), 1);
+    CHECK_EQ(link.written.back(), kMoveA);
+  }
+
+  TEST_CASE("CommandScheduler: Failed writes keep frames queued") {
+    client::comm::CommandScheduler scheduler;
+    FakeLink link;
+    link.fail = true;
+
+    scheduler.SubmitControl(kHome);
+    scheduler.SubmitMove(kMoveA);
+    CHECK_EQ(scheduler.Drain(0, link), 0);
+    CHECK_EQ(scheduler.Depth(), 2);
+
+    link.fail = false;
+    CHECK_EQ(scheduler.Drain(0, link), 2);
+    CHECK_EQ(scheduler.Depth(), 0);
+  }
+
+  TEST_CASE("CommandScheduler: Clear discards pending frames but keeps counters") {
+    client::comm::CommandScheduler scheduler(0);
+    FakeLink link;
+
+    scheduler.SubmitMove(kMoveA);
+    scheduler.SubmitMove(kMoveB);
+    scheduler.SubmitControl(kHome);
+    scheduler.Clear();
+
+    CHECK_EQ(scheduler.Depth(), 0);
+    CHECK_EQ(scheduler.Coalesced(), 1);
+    CHECK_EQ(scheduler.Drain(0, link), 0);
+    CHECK(link.written.empty());
+  }
+}
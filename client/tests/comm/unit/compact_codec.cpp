@@ -0,0 +1,144 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/compact_codec.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace {
+
+// Encodable at compile time
+constexpr auto kCompileTimeMove =
+    client::comm::EncodeCompactMove(client::comm::CompactMoveCommand{.pan_angle = 1.5F, .sequence = 3});
+static_assert(kCompileTimeMove.size == client::comm::kCompactMoveSize);
+static_assert(client::comm::DecodeCompactMove(kCompileTimeMove.Bytes())->pan_angle == 1.5F);
+
+// Golden vectors shared with embedded/tests/unit/compact_control_test.cpp
+constexpr std::array<uint8_t, 6> kGoldenMove = {0x2A, 0x00, 0xD2, 0x04, 0x0C, 0xFE};
+constexpr std::array<uint8_t, 10> kGoldenStatus = {0x07, 0x03, 0x64, 0x00, 0x9C, 0xFF, 0x28, 0x23, 0x6C, 0xEE};
+constexpr std::array<uint8_t, 14> kGoldenWindowAck = {0x07, 0x03, 0x64, 0x00, 0x9C, 0xFF, 0x28,
+                                                      0x23, 0x6C, 0xEE, 0x05, 0x00, 0x00, 0x80};
+
+}  // namespace
+
+TEST_SUITE("client::comm::CompactCodec") {
+  TEST_CASE("EncodeCompactMove: Matches the firmware golden vector") {
+    const auto bytes =
+        client::comm::EncodeCompactMove({.pan_angle = 12.34F, .tilt_angle = -5.0F, .sequence = 0x2A});
+
+    const auto encoded = bytes.Bytes();
+    CHECK(std::ranges::equal(encoded, kGoldenMove));
+
+    const auto decoded = client::comm::DecodeCompactMove(kGoldenMove);
+    REQUIRE(decoded.has_value());
+    CHECK_EQ(decoded->sequence, 0x2A);
+    CHECK_EQ(decoded->pan_angle, doctest::Approx(12.34F));
+    CHECK_EQ(decoded->tilt_angle, doctest::Approx(-5.0F));
+    CHECK_FALSE(decoded->has_velocity);
+  }
+
+  TEST_CASE("EncodeCompactMove: Round-trips velocity") {
+    const client::comm::CompactMoveCommand cmd{
+        .pan_angle = -30.25F, .tilt_angle = 10.5F, .pan_velocity = 120.0F, .tilt_velocity = -45.5F,
+        .has_velocity = true, .sequence = 255};
+
+    const auto bytes = client::comm::EncodeCompactMove(cmd);
+    CHECK_EQ(bytes.size, client::comm::kCompactMoveWithVelocitySize);
+
+    const auto decoded = client::comm::DecodeCompactMove(bytes.Bytes());
+    REQUIRE(decoded.has_value());
+    CHECK_EQ(*decoded, cmd);
+  }
+
+  TEST_CASE("EncodeCompactMove: Rounds to centi-degrees and saturates") {
+    const auto decode = [](float angle) {
+      return client::comm::DecodeCompactMove(client::comm::EncodeCompactMove({.pan_angle = angle}).Bytes())->pan_angle;
+    };
+
+    CHECK_EQ(decode(0.004F), 0.0F);
+    CHECK_EQ(decode(0.006F), doctest::Approx(0.01F));
+    CHECK_EQ(decode(-0.006F), doctest::Approx(-0.01F));
+    CHECK_EQ(decode(1000.0F), doctest::Approx(327.67F));
+    CHECK_EQ(decode(-1000.0F), doctest::Approx(-327.68F));
+    CHECK_EQ(decode(std::numeric_limits<float>::infinity()), doctest::Approx(327.67F));
+    CHECK_EQ(decode(std::numeric_limits<float>::quiet_NaN()), 0.0F);
+  }
+
+  TEST_CASE("DecodeCompactMove: Rejects sizes that disagree with the flags") {
+    std::array<uint8_t, 10> data{0x01, 0x01, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    CHECK_FALSE(client::comm::DecodeCompactMove(std::span<const uint8_t>(data).first(5)).has_value());
+    CHECK_FALSE(client::comm::DecodeCompactMove(std::span<const uint8_t>(data).first(6)).has_value());
+    CHECK(client::comm::DecodeCompactMove(data).has_value());
+
+    data[1] = 0x00;
+    CHECK_EQ(client::comm::DecodeCompactMove(data).error(), client::comm::ProtocolError::kInvalidMessage);
+  }
+
+  TEST_CASE("EncodeCompactStatus: Matches the firmware golden vector") {
+    const client::comm::CompactStatus status{.pan_position = 1.0F,
+                                             .tilt_position = -1.0F,
+                                             .target_pan = 90.0F,
+                                             .target_tilt = -45.0F,
+                                             .sequence = 7,
+                                             .is_moving = true,
+                                             .is_calibrated = true};
+
+    const auto bytes = client::comm::EncodeCompactStatus(status);
+    CHECK(std::ranges::equal(bytes.Bytes(), kGoldenStatus));
+
+    const auto decoded = client::comm::DecodeCompactStatus(kGoldenStatus);
+    REQUIRE(decoded.has_value());
+    CHECK_EQ(*decoded, status);
+    CHECK_FALSE(client::comm::DecodeCompactStatus(std::span<const uint8_t>(kGoldenStatus).first(9)).has_value());
+  }
+
+  TEST_CASE("EncodeWindowAck: Matches the firmware golden vector") {
+    const client::comm::WindowAck ack{.status = {.pan_position = 1.0F,
+                                                 .tilt_position = -1.0F,
+                                                 .target_pan = 90.0F,
+                                                 .target_tilt = -45.0F,
+                                                 .sequence = 7,
+                                                 .is_moving = true,
+                                                 .is_calibrated = true},
+                                      .received = 0x80000005};
+
+    const auto bytes = client::comm::EncodeWindowAck(ack);
+    CHECK(std::ranges::equal(bytes.Bytes(), kGoldenWindowAck));
+
+    const auto decoded = client::comm::DecodeWindowAck(kGoldenWindowAck);
+    REQUIRE(decoded.has_value());
+    CHECK_EQ(*decoded, ack);
+    CHECK_FALSE(client::comm::DecodeWindowAck(kGoldenStatus).has_value());
+  }
+
+  TEST_CASE("ExpandCompactSequence: Recovers the full command ID") {
+    CHECK_EQ(client::comm::ExpandCompactSequence(5, 5), 5U);
+    CHECK_EQ(client::comm::ExpandCompactSequence(0x02, 0x1203), 0x1202U);
+    CHECK_EQ(client::comm::ExpandCompactSequence(0xFF, 0x1201), 0x11FFU);
+    CHECK_EQ(client::comm::ExpandCompactSequence(0x00, 0x1300), 0x1300U);
+    CHECK_EQ(client::comm::ExpandCompactSequence(0x10, 0x05), 0x10U);
+  }
+
+  TEST_CASE("ToStatusMessage: Survives a v1 status round trip") {
+    const client::comm::CompactStatus status{.pan_position = 12.5F, .target_pan = 20.0F, .rejected = true};
+
+    const auto msg = client::comm::ToStatusMessage(status, 0x1234);
+    CHECK(msg.has_device_status);
+    CHECK_EQ(msg.command_id, 0x1234U);
+    CHECK_EQ(msg.error_code, 6U);
+
+    const auto bytes = client::comm::Protocol::SerializeStatus(msg);
+    REQUIRE(bytes.has_value());
+    const auto parsed = client::comm::Protocol::DeserializeStatus(*bytes);
+    REQUIRE(parsed.has_value());
+    CHECK_EQ(parsed->command_id, 0x1234U);
+    CHECK_EQ(parsed->error_code, 6U);
+    CHECK_EQ(parsed->pan_position, 12.5F);
+    CHECK_EQ(parsed->target_pan, 20.0F);
+  }
+}
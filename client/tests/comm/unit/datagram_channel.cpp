@@ -0,0 +1,219 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/datagram_channel.hpp>
+#include <client/comm/framing.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace {
+
+using client::comm::DatagramChannel;
+using client::comm::DatagramKind;
+using std::chrono::milliseconds;
+
+const auto kStart = std::chrono::steady_clock::time_point(std::chrono::hours(1));
+
+using Datagram = std::vector<uint8_t>;
+
+/// Collects what a channel hands to the socket and delivers to the application.
+struct Endpoint {
+  DatagramChannel channel;
+  std::vector<Datagram> sent;
+  std::vector<Datagram> delivered;
+
+  explicit Endpoint(uint8_t session) : channel(session) {}
+
+  auto Sender() {
+    return [this](std::span<const uint8_t> datagram) { sent.emplace_back(datagram.begin(), datagram.end()); };
+  }
+
+  void Receive(const Datagram& datagram, std::chrono::steady_clock::time_point now) {
+    const auto deliver = [this](std::span<const uint8_t> payload) {
+      delivered.emplace_back(payload.begin(), payload.end());
+    };
+    CHECK(channel.Receive(datagram, now, deliver, Sender()).has_value());
+  }
+
+  /// Hands everything sent so far to @p peer and forgets it.
+  void DeliverTo(Endpoint& peer, std::chrono::steady_clock::time_point now) {
+    auto in_transit = std::move(sent);
+    sent.clear();
+    for (const auto& datagram : in_transit) {
+      peer.Receive(datagram, now);
+    }
+  }
+};
+
+DatagramKind KindOf(const Datagram& datagram) {
+  const auto header = client::comm::DecodeDatagramHeader(datagram);
+  CHECK(header.has_value());
+  return header ? header->kind : DatagramKind{};
+}
+
+}  // namespace
+
+TEST_SUITE("client::comm::DatagramChannel") {
+  TEST_CASE("DatagramHeader: Round-trips and rejects malformed datagrams") {
+    constexpr client::comm::DatagramHeader kHeader{
+        .kind = DatagramKind::kReliable, .session = 0xA5, .sequence = 0x01020304, .timestamp_us = 0xFFFFFFFE};
+    std::array<uint8_t, client::comm::kDatagramHeaderSize> bytes{};
+    client::comm::EncodeDatagramHeader(kHeader, bytes);
+    // Golden vector shared with embedded/tests/unit/datagram_channel_test.cpp
+    constexpr std::array<uint8_t, client::comm::kDatagramHeaderSize> kGolden = {0x02, 0xA5, 0x04, 0x03, 0x02,
+                                                                              0x01, 0xFE, 0xFF, 0xFF, 0xFF};
+    CHECK((bytes == kGolden));
+    CHECK_EQ(client::comm::DecodeDatagramHeader(bytes), kHeader);
+
+    CHECK_FALSE(client::comm::DecodeDatagramHeader(std::span<const uint8_t>(bytes).first(9)).has_value());
+    bytes[0] = 0x04;
+    CHECK_FALSE(client::comm::DecodeDatagramHeader(bytes).has_value());
+    bytes[0] = 0x00;
+    CHECK_FALSE(client::comm::DecodeDatagramHeader(bytes).has_value());
+  }
+
+  TEST_CASE("ClassifyFrame: Compact control is latest-wins, everything else reliable") {
+    const std::vector<uint8_t> payload = {0x01, 0x02, 0x03};
+    const auto compact = client::comm::EncodeFrame(client::comm::FrameType::kCompact, payload);
+    const auto window_ack = client::comm::EncodeFrame(client::comm::FrameType::kWindowAck, payload);
+    const auto command = client::comm::EncodeFrame(client::comm::FrameType::kCommand, payload);
+    const auto handshake = client::comm::EncodeFrame(client::comm::FrameType::kHandshake, payload);
+    REQUIRE(compact.has_value());
+    REQUIRE(window_ack.has_value());
+    REQUIRE(command.has_value());
+    REQUIRE(handshake.has_value());
+
+    CHECK_EQ(client::comm::ClassifyFrame(*compact), DatagramKind::kLatest);
+    CHECK_EQ(client::comm::ClassifyFrame(*window_ack), DatagramKind::kLatest);
+    CHECK_EQ(client::comm::ClassifyFrame(*command), DatagramKind::kReliable);
+    CHECK_EQ(client::comm::ClassifyFrame(*handshake), DatagramKind::kReliable);
+    // Anything that does not decode errs on the side of delivery
+    CHECK_EQ(client::comm::ClassifyFrame(std::vector<uint8_t>{0x00, 0x05, 0x00}), DatagramKind::kReliable);
+  }
+
+  TEST_CASE("DatagramChannel: Latest-wins drops late and duplicate datagrams") {
+    Endpoint sender(1);
+    Endpoint receiver(2);
+    for (uint8_t i = 0; i < 4; ++i) {
+      CHECK(sender.channel.SendLatest(std::vector<uint8_t>{i}, kStart, sender.Sender()));
+    }
+    REQUIRE_EQ(sender.sent.size(), 4U);
+    CHECK_EQ(KindOf(sender.sent[0]), DatagramKind::kLatest);
+
+    // Arrival order 0, 2, 1, 2, 3: the late 1 and the second 2 are dropped
+    for (const size_t index : {0U, 2U, 1U, 2U, 3U}) {
+      receiver.Receive(sender.sent[index], kStart);
+    }
+    CHECK((receiver.delivered == std::vector<Datagram>{{0}, {2}, {3}}));
+    CHECK(receiver.sent.empty());
+
+    const auto& stats = receiver.channel.Stats();
+    CHECK_EQ(stats.received, 3U);
+    CHECK_EQ(stats.lost, 1U);
+    CHECK_EQ(stats.late, 1U);
+    CHECK_EQ(stats.duplicates, 1U);
+    CHECK_EQ(stats.LossRate(), doctest::Approx(0.25));
+  }
+
+  TEST_CASE("DatagramChannel: Reliable datagrams are delivered once, in order, despite loss") {
+    Endpoint sender(1);
+    Endpoint receiver(2);
+
+    // The first datagram travels alone until the peer acknowledges it
+    for (uint8_t i = 0; i < 3; ++i) {
+      CHECK(sender.channel.SendReliable(std::vector<uint8_t>{i}, kStart, sender.Sender()));
+    }
+    CHECK_EQ(sender.sent.size(), 1U);
+    CHECK_EQ(sender.channel.ReliablePending(), 3U);
+    sender.DeliverTo(receiver, kStart);
+    REQUIRE_EQ(receiver.sent.size(), 1U);
+    CHECK_EQ(KindOf(receiver.sent[0]), DatagramKind::kAck);
+
+    // The acknowledgement opens the window for the rest
+    receiver.DeliverTo(sender, kStart);
+    CHECK_EQ(sender.sent.size(), 2U);
+    CHECK_EQ(sender.channel.ReliablePending(), 2U);
+
+    // Lose the first of them: the second is dropped past the gap
+    receiver.Receive(sender.sent[1], kStart);
+    sender.sent.clear();
+    CHECK_EQ(receiver.delivered.size(), 1U);
+
+    // Nothing is resent before the timeout, then the whole window goes out again
+    CHECK_EQ(sender.channel.PollRetransmits(kStart + milliseconds(49), sender.Sender()), 0U);
+    CHECK_EQ(sender.channel.PollRetransmits(kStart + DatagramChannel::kInitialTimeout, sender.Sender()), 2U);
+    receiver.sent.clear();
+    sender.DeliverTo(receiver, kStart + milliseconds(50));
+    receiver.DeliverTo(sender, kStart + milliseconds(50));
+
+    CHECK((receiver.delivered == std::vector<Datagram>{{0}, {1}, {2}}));
+    CHECK_EQ(sender.channel.ReliablePending(), 0U);
+    CHECK_EQ(sender.channel.Stats().retransmissions, 2U);
+    CHECK_EQ(receiver.channel.Stats().reliable_received, 3U);
+  }
+
+  TEST_CASE("DatagramChannel: Backs off while the peer does not answer") {
+    Endpoint sender(1);
+    CHECK(sender.channel.SendReliable(std::vector<uint8_t>{1}, kStart, sender.Sender()));
+
+    CHECK_EQ(sender.channel.PollRetransmits(kStart + milliseconds(50), sender.Sender()), 1U);
+    CHECK_EQ(sender.channel.PollRetransmits(kStart + milliseconds(149), sender.Sender()), 0U);
+    CHECK_EQ(sender.channel.PollRetransmits(kStart + milliseconds(150), sender.Sender()), 1U);
+
+    auto now = kStart + milliseconds(150);
+    for (int i = 0; i < 10; ++i) {
+      now += DatagramChannel::kMaxTimeout;
+      CHECK_EQ(sender.channel.PollRetransmits(now, sender.Sender()), 1U);
+    }
+  }
+
+  TEST_CASE("DatagramChannel: Bounds the reliable queue") {
+    Endpoint sender(1);
+    for (size_t i = 0; i < DatagramChannel::kMaxQueued; ++i) {
+      CHECK(sender.channel.SendReliable(std::vector<uint8_t>{1}, kStart, sender.Sender()));
+    }
+    CHECK_FALSE(sender.channel.SendReliable(std::vector<uint8_t>{1}, kStart, sender.Sender()));
+    CHECK_FALSE(
+        sender.channel.SendLatest(std::vector<uint8_t>(client::comm::kMaxDatagramSize), kStart, sender.Sender()));
+  }
+
+  TEST_CASE("DatagramChannel: A restarted peer starts a fresh stream") {
+    Endpoint sender(1);
+    Endpoint receiver(2);
+    for (uint8_t i = 0; i < 3; ++i) {
+      CHECK(sender.channel.SendLatest(std::vector<uint8_t>{i}, kStart, sender.Sender()));
+      CHECK(sender.channel.SendReliable(std::vector<uint8_t>{i}, kStart, sender.Sender()));
+      sender.DeliverTo(receiver, kStart);
+      receiver.DeliverTo(sender, kStart);
+    }
+    CHECK_EQ(receiver.delivered.size(), 6U);
+
+    // Sequence numbers start over; without the session byte these would look stale
+    sender.channel.Reset(7);
+    CHECK(sender.channel.SendLatest(std::vector<uint8_t>{9}, kStart, sender.Sender()));
+    CHECK(sender.channel.SendReliable(std::vector<uint8_t>{9}, kStart, sender.Sender()));
+    sender.DeliverTo(receiver, kStart);
+    CHECK_EQ(receiver.delivered.size(), 8U);
+    CHECK_EQ(receiver.channel.Stats().late, 0U);
+
+    // An acknowledgement for the old session does not release the new stream
+    std::array<uint8_t, client::comm::kDatagramHeaderSize> stale{};
+    client::comm::EncodeDatagramHeader({.kind = DatagramKind::kAck, .session = 1, .sequence = 1}, stale);
+    sender.Receive(Datagram(stale.begin(), stale.end()), kStart);
+    CHECK_EQ(sender.channel.ReliablePending(), 1U);
+
+    receiver.DeliverTo(sender, kStart);
+    CHECK_EQ(sender.channel.ReliablePending(), 0U);
+  }
+
+  TEST_CASE("DatagramChannel: Rejects malformed datagrams") {
+    Endpoint receiver(2);
+    const auto result = receiver.channel.Receive(
+        std::vector<uint8_t>{0x01, 0x02}, kStart, [](std::span<const uint8_t>) {}, receiver.Sender());
+    CHECK_FALSE(result.has_value());
+    CHECK(receiver.sent.empty());
+  }
+}
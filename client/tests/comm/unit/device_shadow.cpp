@@ -0,0 +1,88 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/device_shadow.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+TEST_SUITE("client::comm::DeviceShadow") {
+  TEST_CASE("DeviceShadow: Starts without state") {
+    const client::comm::DeviceShadow shadow;
+    CHECK_FALSE(shadow.Read().Valid());
+  }
+
+  TEST_CASE("DeviceShadow: Mirrors the latest status") {
+    client::comm::DeviceShadow shadow;
+    const auto now = std::chrono::steady_clock::now();
+    shadow.Update({.pan_position = 12.0F,
+                   .tilt_position = -3.0F,
+                   .target_pan = 20.0F,
+                   .target_tilt = -5.0F,
+                   .is_calibrated = true,
+                   .is_moving = true,
+                   .has_device_status = true,
+                   .free_heap = 4096,
+                   .uptime_ms = 60000},
+                  now);
+
+    const auto state = shadow.Read();
+    REQUIRE(state.Valid());
+    CHECK_EQ(state.pan, doctest::Approx(12.0));
+    CHECK_EQ(state.tilt, doctest::Approx(-3.0));
+    CHECK_EQ(state.target_pan, doctest::Approx(20.0));
+    CHECK_EQ(state.target_tilt, doctest::Approx(-5.0));
+    CHECK(state.is_moving);
+    CHECK(state.is_calibrated);
+    CHECK_EQ(state.free_heap, 4096U);
+    CHECK_EQ(state.uptime_ms, 60000U);
+    CHECK_EQ(state.update_count, 1U);
+    CHECK(state.updated_at == now);
+  }
+
+  TEST_CASE("DeviceShadow: Ignores responses without device status") {
+    client::comm::DeviceShadow shadow;
+    shadow.Update({.pan_position = 45.0F, .command_id = 7}, std::chrono::steady_clock::now());
+    CHECK_FALSE(shadow.Read().Valid());
+  }
+
+  TEST_CASE("DeviceShadow: Reset forgets the state") {
+    client::comm::DeviceShadow shadow;
+    shadow.Update({.has_device_status = true}, std::chrono::steady_clock::now());
+    REQUIRE(shadow.Read().Valid());
+
+    shadow.Reset();
+    CHECK_FALSE(shadow.Read().Valid());
+  }
+
+  TEST_CASE("DeviceShadow: Readers never observe a torn update") {
+    client::comm::DeviceShadow shadow;
+    std::atomic<bool> done{false};
+
+    // Every update keeps pan == -tilt == uptime, so a mixed snapshot breaks the invariant
+    std::thread writer([&]() {
+      for (uint32_t i = 1; i <= 200000; ++i) {
+        const auto value = static_cast<float>(i);
+        shadow.Update({.pan_position = value, .tilt_position = -value, .has_device_status = true, .uptime_ms = i},
+                      std::chrono::steady_clock::now());
+      }
+      done.store(true, std::memory_order_release);
+    });
+
+    uint64_t torn = 0;
+    uint64_t reads = 0;
+    while (!done.load(std::memory_order_acquire)) {
+      const auto state = shadow.Read();
+      ++reads;
+      if (state.Valid() && (state.pan != -state.tilt || static_cast<uint64_t>(state.pan) != state.uptime_ms)) {
+        ++torn;
+      }
+    }
+    writer.join();
+
+    CHECK_EQ(torn, 0U);
+    CHECK_GT(reads, 0U);
+    CHECK_EQ(shadow.Read().update_count, 200000U);
+  }
+}
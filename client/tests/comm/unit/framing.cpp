@@ -0,0 +1,198 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/framing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+struct ReceivedFrame {
+  client::comm::FrameType type;
+  std::vector<uint8_t> payload;
+};
+
+[[nodiscard]] std::vector<uint8_t> MakePayload(std::mt19937& rng, size_t size) {
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<uint8_t> payload(size);
+  for (auto& b : payload) {
+    // Bias toward zeros so COBS blocks are exercised
+    b = byte(rng) < 64 ? 0 : static_cast<uint8_t>(byte(rng));
+  }
+  return payload;
+}
+
+[[nodiscard]] std::vector<ReceivedFrame> FeedAll(client::comm::FrameDecoder& decoder, std::span<const uint8_t> data) {
+  std::vector<ReceivedFrame> frames;
+  decoder.Feed(data, [&frames](const client::comm::Frame& frame) {
+    frames.push_back({frame.type, std::vector<uint8_t>(frame.payload.begin(), frame.payload.end())});
+  });
+  return frames;
+}
+
+}  // namespace
+
+TEST_SUITE("client::comm::Framing") {
+  TEST_CASE("FramingError: FramingErrorToString returns correct strings") {
+    CHECK_EQ(client::comm::FramingErrorToString(client::comm::FramingError::kPayloadTooLarge), "Payload too large");
+    CHECK_EQ(client::comm::FramingErrorToString(client::comm::FramingError::kCrcMismatch), "CRC mismatch");
+    CHECK_EQ(client::comm::FramingErrorToString(static_cast<client::comm::FramingError>(255)), "Unknown error");
+  }
+
+  TEST_CASE("Crc16: Matches CRC-16/CCITT-FALSE check value") {
+    constexpr std::string_view kCheck = "123456789";
+    const std::span<const uint8_t> data(reinterpret_cast<const uint8_t*>(kCheck.data()), kCheck.size());
+    CHECK_EQ(client::comm::Crc16(data), 0x29B1);
+  }
+
+  TEST_CASE("EncodeFrame: Produces the shared wire format") {
+    // Same vector is checked by the firmware's spp_framing tests
+    constexpr std::array<uint8_t, 6> kPayload = {0x08, 0x2A, 0x10, 0x00, 0x18, 0x01};
+    constexpr std::array<uint8_t, 13> kExpected = {0x00, 0x06, 0x06, 0x01, 0x08, 0x2A, 0x10,
+                                                   0x05, 0x18, 0x01, 0x90, 0xCB, 0x00};
+
+    const auto encoded = client::comm::EncodeFrame(client::comm::FrameType::kCommand, kPayload);
+    REQUIRE(encoded.has_value());
+    CHECK(std::ranges::equal(*encoded, kExpected));
+  }
+
+  TEST_CASE("EncodeFrame: Never emits a delimiter inside the frame") {
+    std::vector<uint8_t> payload(client::comm::kMaxFramePayloadSize, 0);
+    const auto encoded = client::comm::EncodeFrame(client::comm::FrameType::kResponse, payload);
+    REQUIRE(encoded.has_value());
+    CHECK_LE(encoded->size(), client::comm::MaxEncodedFrameSize(payload.size()));
+    CHECK_EQ(encoded->front(), client::comm::kFrameDelimiter);
+    CHECK_EQ(encoded->back(), client::comm::kFrameDelimiter);
+    CHECK(std::ranges::none_of(encoded->begin() + 1, encoded->end() - 1, [](uint8_t b) { return b == 0; }));
+  }
+
+  TEST_CASE("EncodeFrame: Rejects oversized payloads and small buffers") {
+    std::vector<uint8_t> payload(client::comm::kMaxFramePayloadSize + 1);
+    const auto too_large = client::comm::EncodeFrame(client::comm::FrameType::kCommand, payload);
+    REQUIRE_FALSE(too_large.has_value());
+    CHECK_EQ(too_large.error(), client::comm::FramingError::kPayloadTooLarge);
+
+    std::array<uint8_t, 4> small{};
+    const auto too_small =
+        client::comm::EncodeFrame(client::comm::FrameType::kCommand, std::span(payload).first(8), small);
+    REQUIRE_FALSE(too_small.has_value());
+    CHECK_EQ(too_small.error(), client::comm::FramingError::kBufferTooSmall);
+  }
+
+  TEST_CASE("FrameDecoder: Round-trips empty and maximum-size payloads") {
+    client::comm::FrameDecoder decoder;
+    for (const size_t size : {size_t{0}, size_t{1}, size_t{253}, size_t{254}, client::comm::kMaxFramePayloadSize}) {
+      std::vector<uint8_t> payload(size, 0xAB);
+      const auto encoded = client::comm::EncodeFrame(client::comm::FrameType::kResponse, payload);
+      REQUIRE(encoded.has_value());
+
+      const auto frames = FeedAll(decoder, *encoded);
+      REQUIRE_EQ(frames.size(), 1);
+      CHECK_EQ(frames[0].type, client::comm::FrameType::kResponse);
+      CHECK_EQ(frames[0].payload, payload);
+    }
+    CHECK_EQ(decoder.FramesDropped(), 0);
+  }
+
+  TEST_CASE("FrameDecoder: Reassembles randomly fragmented and concatenated streams") {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<size_t> payload_size(0, client::comm::kMaxFramePayloadSize);
+    std::uniform_int_distribution<size_t> chunk_size(1, 700);
+
+    for (int round = 0; round < 20; ++round) {
+      std::vector<std::vector<uint8_t>> payloads;
+      std::vector<uint8_t> stream;
+      for (int i = 0; i < 25; ++i) {
+        payloads.push_back(MakePayload(rng, payload_size(rng)));
+        const auto encoded = client::comm::EncodeFrame(client::comm::FrameType::kCommand, payloads.back());
+        REQUIRE(encoded.has_value());
+        stream.insert(stream.end(), encoded->begin(), encoded->end());
+      }
+
+      client::comm::FrameDecoder decoder;
+      std::vector<ReceivedFrame> received;
+      for (size_t offset = 0; offset < stream.size();) {
+        const size_t n = std::min(chunk_size(rng), stream.size() - offset);
+        const auto frames = FeedAll(decoder, std::span(stream).subspan(offset, n));
+        received.insert(received.end(), frames.begin(), frames.end());
+        offset += n;
+      }
+
+      REQUIRE_EQ(received.size(), payloads.size());
+      for (size_t i = 0; i < payloads.size(); ++i) {
+        CHECK_EQ(received[i].payload, payloads[i]);
+      }
+      CHECK_EQ(decoder.FramesDecoded(), payloads.size());
+      CHECK_EQ(decoder.FramesDropped(), 0);
+    }
+  }
+
+  TEST_CASE("FrameDecoder: Resynchronises after corruption and garbage") {
+    const std::vector<uint8_t> first = {1, 2, 3};
+    const std::vector<uint8_t> second = {4, 0, 5};
+    auto corrupted = *client::comm::EncodeFrame(client::comm::FrameType::kCommand, first);
+    corrupted[3] ^= 0x40;
+
+    std::vector<uint8_t> stream = {0x13, 0x37, 0x42};  // Tail of a frame from before we connected
+    stream.insert(stream.end(), corrupted.begin(), corrupted.end());
+    const auto good = *client::comm::EncodeFrame(client::comm::FrameType::kCommand, second);
+    stream.insert(stream.end(), good.begin(), good.end());
+
+    client::comm::FrameDecoder decoder;
+    const auto frames = FeedAll(decoder, stream);
+    REQUIRE_EQ(frames.size(), 1);
+    CHECK_EQ(frames[0].payload, second);
+    CHECK_EQ(decoder.FramesDropped(), 2);
+  }
+
+  TEST_CASE("FrameDecoder: Detects CRC and length errors") {
+    const std::vector<uint8_t> payload = {9, 8, 7, 6};
+
+    SUBCASE("CRC mismatch") {
+      auto encoded = *client::comm::EncodeFrame(client::comm::FrameType::kCommand, payload);
+      encoded[encoded.size() - 3] ^= 0x01;  // Flip a CRC bit
+
+      client::comm::FrameDecoder decoder;
+      CHECK(FeedAll(decoder, encoded).empty());
+      CHECK_EQ(decoder.LastError(), client::comm::FramingError::kCrcMismatch);
+    }
+
+    SUBCASE("Truncated frame") {
+      auto encoded = *client::comm::EncodeFrame(client::comm::FrameType::kCommand, payload);
+      encoded.erase(encoded.end() - 4, encoded.end() - 1);
+
+      client::comm::FrameDecoder decoder;
+      CHECK(FeedAll(decoder, encoded).empty());
+      CHECK_EQ(decoder.FramesDropped(), 1);
+    }
+  }
+
+  TEST_CASE("FrameDecoder: Drops runs longer than any valid frame") {
+    std::vector<uint8_t> stream(client::comm::FrameDecoder::kMaxEncodedBodySize + 10, 0x11);
+    stream.push_back(client::comm::kFrameDelimiter);
+    const auto good = *client::comm::EncodeFrame(client::comm::FrameType::kResponse, std::vector<uint8_t>{1, 2});
+    stream.insert(stream.end(), good.begin(), good.end());
+
+    client::comm::FrameDecoder decoder;
+    const auto frames = FeedAll(decoder, stream);
+    REQUIRE_EQ(frames.size(), 1);
+    CHECK_EQ(decoder.FramesDropped(), 1);
+    CHECK_EQ(decoder.LastError(), client::comm::FramingError::kFrameTooLong);
+  }
+
+  TEST_CASE("FrameDecoder: Reset discards a partial frame") {
+    const auto encoded = *client::comm::EncodeFrame(client::comm::FrameType::kCommand, std::vector<uint8_t>{1, 2, 3});
+
+    client::comm::FrameDecoder decoder;
+    CHECK(FeedAll(decoder, std::span(encoded).first(4)).empty());
+    decoder.Reset();
+    CHECK(FeedAll(decoder, std::span(encoded).subspan(4)).empty());
+    CHECK_EQ(decoder.FramesDecoded(), 0);
+  }
+}
@@ -0,0 +1,102 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/framing.hpp>
+#include <client/comm/link_command_queue.hpp>
+#include <client/comm/link_session.hpp>
+#include <client/comm/loopback_transport.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace {
+
+using client::comm::FrameType;
+using client::comm::LinkCommand;
+using client::comm::LinkCommandKind;
+using client::comm::LinkCommandQueue;
+
+}  // namespace
+
+TEST_SUITE("client::comm::LinkCommandQueue") {
+  TEST_CASE("LinkCommandQueue: Wakes the comm thread once per batch") {
+    size_t wakes = 0;
+    LinkCommandQueue queue([&wakes] { ++wakes; });
+
+    CHECK(queue.SubmitMove({.pan_angle = 1.0F, .command_id = 1}));
+    CHECK(queue.SubmitMove({.pan_angle = 2.0F, .command_id = 2}));
+    CHECK_EQ(wakes, 1U);
+    CHECK_EQ(queue.Depth(), 2U);
+
+    std::vector<uint32_t> executed;
+    CHECK_EQ(queue.Drain([&executed](const LinkCommand& command) { executed.push_back(command.move.command_id); }),
+             2U);
+    CHECK((executed == std::vector<uint32_t>{1, 2}));
+    CHECK_EQ(queue.Depth(), 0U);
+
+    // Drained, so the next submission wakes it again
+    CHECK(queue.SubmitMove({.command_id = 3}));
+    CHECK_EQ(wakes, 2U);
+  }
+
+  TEST_CASE("LinkCommandQueue: Copies payloads and keeps submission order across kinds") {
+    LinkCommandQueue queue;
+    std::array<uint8_t, 3> payload = {0x0A, 0x0B, 0x0C};
+    CHECK(queue.SubmitControl(payload, FrameType::kHandshake));
+    CHECK(queue.SubmitReliable(42, payload));
+    payload.fill(0);
+
+    std::vector<LinkCommandKind> kinds;
+    queue.Drain([&kinds](const LinkCommand& command) {
+      kinds.push_back(command.kind);
+      CHECK((std::vector<uint8_t>(command.Payload().begin(), command.Payload().end()) ==
+             std::vector<uint8_t>{0x0A, 0x0B, 0x0C}));
+      if (command.kind == LinkCommandKind::kControl) {
+        CHECK_EQ(command.frame_type, FrameType::kHandshake);
+      } else {
+        CHECK_EQ(command.command_id, 42U);
+      }
+    });
+    CHECK((kinds == std::vector<LinkCommandKind>{LinkCommandKind::kControl, LinkCommandKind::kReliable}));
+  }
+
+  TEST_CASE("LinkCommandQueue: Rejects oversized payloads and submissions to a full queue") {
+    LinkCommandQueue queue;
+    const std::vector<uint8_t> oversized(client::comm::kMaxFramePayloadSize + 1);
+    CHECK_FALSE(queue.SubmitControl(oversized));
+    CHECK_FALSE(queue.SubmitReliable(1, oversized));
+
+    for (size_t i = 0; i < LinkCommandQueue::kCapacity; ++i) {
+      CHECK(queue.SubmitMove({}));
+    }
+    CHECK_FALSE(queue.SubmitMove({}));
+    CHECK_EQ(queue.Dropped(), 1U);
+  }
+
+  TEST_CASE("ExecuteLinkCommand: Drives the session") {
+    auto [host, device] = client::comm::LoopbackTransport::CreatePair();
+    client::comm::LinkSession session;
+    session.Attach(host.get());
+
+    LinkCommandQueue queue;
+    REQUIRE(queue.SubmitMove({.pan_angle = 10.0F, .command_id = 1}));
+    queue.Drain([&session](const LinkCommand& command) {
+      CHECK_EQ(client::comm::ExecuteLinkCommand(session, command).error(), client::comm::TransportError::kNotOpen);
+    });
+
+    REQUIRE(device->Open().has_value());
+    REQUIRE(host->Open().has_value());
+    REQUIRE(queue.SubmitMove({.pan_angle = 10.0F, .command_id = 2}));
+    const auto calibrate = client::comm::Protocol::SerializeCalibrate(7);
+    REQUIRE(calibrate.has_value());
+    REQUIRE(queue.SubmitReliable(7, *calibrate));
+    queue.Drain([&session](const LinkCommand& command) {
+      CHECK(client::comm::ExecuteLinkCommand(session, command).has_value());
+    });
+    CHECK_GT(host->Backlog(), 0U);
+  }
+}
@@ -0,0 +1,149 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/link_monitor.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using std::chrono::milliseconds;
+
+const auto kStart = std::chrono::steady_clock::time_point(std::chrono::hours(1));
+
+/// Device clock reading at host time @p at, for a device clock running @p offset ahead of the host.
+[[nodiscard]] uint64_t DeviceMs(std::chrono::steady_clock::time_point at, milliseconds offset) {
+  return static_cast<uint64_t>(std::chrono::duration_cast<milliseconds>(at.time_since_epoch() + offset).count());
+}
+
+}  // namespace
+
+TEST_SUITE("client::comm::LinkMonitor") {
+  TEST_CASE("LinkMonitor: Pings on the configured interval") {
+    client::comm::LinkMonitor monitor(milliseconds(500));
+
+    CHECK(monitor.PingDue(kStart));
+    monitor.OnPingSent(1, kStart);
+    CHECK_FALSE(monitor.PingDue(kStart + milliseconds(499)));
+    CHECK(monitor.PingDue(kStart + milliseconds(500)));
+  }
+
+  TEST_CASE("LinkMonitor: Measures RTT and recovers the clock offset") {
+    client::comm::LinkMonitor monitor;
+    const auto offset = milliseconds(-3'500'000);
+
+    monitor.OnPingSent(7, kStart);
+    // Symmetric 20 ms each way; the device replies at the midpoint
+    CHECK(monitor.OnPong(7, DeviceMs(kStart + milliseconds(20), offset), kStart + milliseconds(40)));
+
+    const auto stats = monitor.Stats();
+    CHECK(stats.Valid());
+    CHECK_EQ(stats.samples, 1U);
+    CHECK_EQ(stats.rtt_ms, doctest::Approx(40.0));
+    CHECK_EQ(stats.rtt_var_ms, doctest::Approx(20.0));
+    CHECK_EQ(stats.OneWayDelayMs(), doctest::Approx(20.0));
+    CHECK_EQ(stats.clock_offset_ms, doctest::Approx(-3'500'000.0));
+
+    const auto device_event = DeviceMs(kStart + milliseconds(1234), offset);
+    const std::chrono::duration<double, std::milli> mapped = stats.DeviceToHost(device_event) - kStart;
+    CHECK_EQ(mapped.count(), doctest::Approx(1234.0));
+  }
+
+  TEST_CASE("LinkMonitor: Smooths RTT and tracks jitter") {
+    client::comm::LinkMonitor monitor;
+    const std::vector<int> rtts = {40, 60, 40, 60, 40, 60, 40, 60};
+
+    auto now = kStart;
+    for (size_t i = 0; i < rtts.size(); ++i) {
+      const auto id = static_cast<uint32_t>(i + 1);
+      monitor.OnPingSent(id, now);
+      CHECK(monitor.OnPong(id, 0, now + milliseconds(rtts[i])));
+      now += std::chrono::seconds(1);
+    }
+
+    const auto stats = monitor.Stats();
+    CHECK_EQ(stats.samples, rtts.size());
+    CHECK_EQ(stats.min_rtt_ms, doctest::Approx(40.0));
+    CHECK_EQ(stats.last_rtt_ms, doctest::Approx(60.0));
+    CHECK_GT(stats.rtt_ms, 40.0);
+    CHECK_LT(stats.rtt_ms, 60.0);
+    CHECK_GT(stats.jitter_ms, 5.0);
+    CHECK_LE(stats.jitter_ms, 20.0);
+  }
+
+  TEST_CASE("LinkMonitor: Trusts the offset from the lowest-RTT sample") {
+    client::comm::LinkMonitor monitor;
+    const auto offset = milliseconds(250);
+
+    // Fast, symmetric round trip
+    monitor.OnPingSent(1, kStart);
+    CHECK(monitor.OnPong(1, DeviceMs(kStart + milliseconds(10), offset), kStart + milliseconds(20)));
+
+    // Slow round trip where all the delay was queueing on the way back
+    const auto second = kStart + std::chrono::seconds(1);
+    monitor.OnPingSent(2, second);
+    CHECK(monitor.OnPong(2, DeviceMs(second + milliseconds(10), offset), second + milliseconds(210)));
+
+    CHECK_EQ(monitor.Stats().clock_offset_ms, doctest::Approx(250.0));
+  }
+
+  TEST_CASE("LinkMonitor: Ignores unknown pongs and counts timeouts as lost") {
+    client::comm::LinkMonitor monitor(milliseconds(1000), milliseconds(3000));
+
+    monitor.OnPingSent(1, kStart);
+    monitor.OnPingSent(2, kStart + milliseconds(2000));
+    CHECK_FALSE(monitor.OnPong(99, 0, kStart + milliseconds(10)));
+
+    std::vector<uint32_t> expired;
+    CHECK_EQ(monitor.Expire(kStart + milliseconds(3000), [&](uint32_t id) { expired.push_back(id); }), 1U);
+    CHECK_EQ(expired, std::vector<uint32_t>{1});
+    CHECK_FALSE(monitor.OnPong(1, 0, kStart + milliseconds(3100)));
+    CHECK(monitor.OnPong(2, 0, kStart + milliseconds(3100)));
+
+    const auto stats = monitor.Stats();
+    CHECK_EQ(stats.sent, 2U);
+    CHECK_EQ(stats.samples, 1U);
+    CHECK_EQ(stats.lost, 1U);
+  }
+
+  TEST_CASE("LinkMonitor: Displacing an outstanding ping counts it as lost") {
+    client::comm::LinkMonitor monitor;
+    for (uint32_t id = 1; id <= client::comm::LinkMonitor::kMaxOutstanding + 2; ++id) {
+      monitor.OnPingSent(id, kStart);
+    }
+
+    CHECK_EQ(monitor.Stats().lost, 2U);
+    CHECK_FALSE(monitor.OnPong(1, 0, kStart));
+    CHECK(monitor.OnPong(3, 0, kStart));
+  }
+
+  TEST_CASE("LinkStats: Derives the retransmission timeout from RTT and its variation") {
+    client::comm::LinkStats stats;
+    CHECK_EQ(stats.RetransmitTimeout(), client::comm::LinkStats::kInitialRetransmitTimeout);
+
+    stats.samples = 1;
+    stats.rtt_ms = 100.0;
+    stats.rtt_var_ms = 25.0;
+    CHECK_EQ(stats.RetransmitTimeout(), milliseconds(200));
+
+    stats.rtt_ms = 150.0;
+    stats.rtt_var_ms = 40.5;
+    CHECK_EQ(stats.RetransmitTimeout(), milliseconds(312));
+
+    stats.rtt_ms = 20.0;
+    stats.rtt_var_ms = 5.0;
+    CHECK_EQ(stats.RetransmitTimeout(), client::comm::LinkStats::kMinRetransmitTimeout);
+  }
+
+  TEST_CASE("LinkMonitor: Reset forgets pings and estimates") {
+    client::comm::LinkMonitor monitor;
+    monitor.OnPingSent(1, kStart);
+    CHECK(monitor.OnPong(1, 0, kStart + milliseconds(5)));
+
+    monitor.Reset();
+    CHECK_FALSE(monitor.Stats().Valid());
+    CHECK(monitor.PingDue(kStart));
+    CHECK_FALSE(monitor.OnPong(1, 0, kStart + milliseconds(5)));
+  }
+}
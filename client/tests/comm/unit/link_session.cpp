@@ -0,0 +1,190 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/compact_codec.hpp>
+#include <client/comm/framing.hpp>
+#include <client/comm/link_session.hpp>
+#include <client/comm/loopback_transport.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace {
+
+using client::comm::FrameType;
+using client::comm::LinkSession;
+using client::comm::LoopbackTransport;
+using client::comm::TransportError;
+
+struct ReceivedFrame {
+  FrameType type = FrameType::kCommand;
+  std::vector<uint8_t> payload;
+};
+
+/// Session over a loopback link whose far end records frames and can answer.
+struct Fixture {
+  std::unique_ptr<LoopbackTransport> host;
+  std::unique_ptr<LoopbackTransport> device;
+  LinkSession session;
+  client::comm::FrameDecoder decoder;
+  std::vector<ReceivedFrame> frames;
+
+  Fixture() {
+    auto [host_end, device_end] = LoopbackTransport::CreatePair();
+    host = std::move(host_end);
+    device = std::move(device_end);
+    device->SetReceiveCallback([this](std::span<const uint8_t> data) {
+      decoder.Feed(data, [this](const client::comm::Frame& frame) {
+        frames.push_back({.type = frame.type, .payload = {frame.payload.begin(), frame.payload.end()}});
+      });
+    });
+    session.Attach(host.get());
+    REQUIRE(host->Open().has_value());
+    REQUIRE(device->Open().has_value());
+  }
+
+  /// Delivers everything the session wrote, including MOVEs released as the backlog drains.
+  void Flush() {
+    while (host->Pump() != 0) {
+    }
+  }
+
+  void Reply(FrameType type, std::span<const uint8_t> payload) {
+    const auto frame = client::comm::EncodeFrame(type, payload);
+    REQUIRE(frame.has_value());
+    REQUIRE(device->Write(*frame).has_value());
+    device->Pump();
+  }
+
+  void AcceptCompact() {
+    const client::comm::HandshakeResponseMessage response{
+        .protocol_version = client::comm::kCompactProtocolVersion,
+        .device_id = "test",
+        .firmware_version = "1.0.0",
+        .supported_features = {std::string(client::comm::kCompactControlFeature),
+                               std::string(client::comm::kWindowAckFeature)},
+        .accepted = true,
+        .rejection_reason = {}};
+    const auto payload = client::comm::Protocol::SerializeHandshakeResponse(response);
+    REQUIRE(payload.has_value());
+    Reply(FrameType::kHandshake, *payload);
+  }
+};
+
+}  // namespace
+
+TEST_SUITE("client::comm::LinkSession") {
+  TEST_CASE("LinkSession: Start sends the handshake") {
+    Fixture fixture;
+    fixture.session.Start();
+    fixture.Flush();
+
+    REQUIRE_EQ(fixture.frames.size(), 1U);
+    CHECK_EQ(fixture.frames[0].type, FrameType::kHandshake);
+    const auto handshake = client::comm::Protocol::DeserializeHandshake(fixture.frames[0].payload);
+    REQUIRE(handshake.has_value());
+    CHECK_EQ(handshake->protocol_version, client::comm::kCompactProtocolVersion);
+  }
+
+  TEST_CASE("LinkSession: Sends fail while the transport is closed") {
+    LinkSession session;
+    CHECK_EQ(session.SendMove({}).error(), TransportError::kNotOpen);
+
+    auto [host, device] = LoopbackTransport::CreatePair();
+    session.Attach(host.get());
+    const std::array<uint8_t, 2> payload = {0x08, 0x01};
+    CHECK_EQ(session.SendControl(payload).error(), TransportError::kNotOpen);
+    session.Attach(nullptr);
+  }
+
+  TEST_CASE("LinkSession: MOVEs switch to compact frames once the device agrees") {
+    Fixture fixture;
+    fixture.session.Start();
+    const client::comm::ServoCommand cmd{.pan_angle = 10.0F, .tilt_angle = -5.0F, .command_id = 1};
+
+    REQUIRE(fixture.session.SendMove(cmd).has_value());
+    fixture.Flush();
+    REQUIRE_EQ(fixture.frames.size(), 2U);
+    CHECK_EQ(fixture.frames[1].type, FrameType::kCommand);
+
+    fixture.AcceptCompact();
+    CHECK(fixture.session.CompactControlActive());
+    CHECK(fixture.session.WindowAckActive());
+
+    REQUIRE(fixture.session.SendMove(cmd).has_value());
+    fixture.Flush();
+    REQUIRE_EQ(fixture.frames.size(), 3U);
+    CHECK_EQ(fixture.frames[2].type, FrameType::kCompact);
+    const auto move = client::comm::DecodeCompactMove(fixture.frames[2].payload);
+    REQUIRE(move.has_value());
+    CHECK_EQ(move->sequence, 1U);
+
+    fixture.session.Stop();
+    CHECK_FALSE(fixture.session.CompactControlActive());
+  }
+
+  TEST_CASE("LinkSession: Window acks reach the ack and data callbacks") {
+    Fixture fixture;
+    std::vector<uint32_t> acked;
+    size_t responses = 0;
+    fixture.session.SetAckCallback([&acked](uint32_t command_id) { acked.push_back(command_id); });
+    fixture.session.SetDataReceivedCallback([&responses](std::span<const uint8_t>) { ++responses; });
+    fixture.session.Start();
+    fixture.AcceptCompact();
+
+    for (uint32_t id = 1; id <= 3; ++id) {
+      REQUIRE(fixture.session.SendMove({.command_id = id}).has_value());
+      fixture.Flush();
+    }
+
+    const auto ack = client::comm::EncodeWindowAck({.status = {.sequence = 3}, .received = 0b11});
+    fixture.Reply(FrameType::kWindowAck, ack.Bytes());
+    CHECK((acked == std::vector<uint32_t>{1, 2, 3}));
+    CHECK_EQ(responses, 1U);
+  }
+
+  TEST_CASE("LinkSession: Reliable commands are resent until answered") {
+    Fixture fixture;
+    fixture.session.SetRetransmitTimeout(std::chrono::milliseconds(100));
+    const auto calibrate = client::comm::Protocol::SerializeCalibrate(42);
+    REQUIRE(calibrate.has_value());
+
+    const auto sent = std::chrono::steady_clock::now();
+    REQUIRE(fixture.session.SendReliable(42, *calibrate).has_value());
+    fixture.Flush();
+    REQUIRE_EQ(fixture.frames.size(), 1U);
+
+    CHECK_EQ(fixture.session.PollRetransmits(sent + std::chrono::seconds(1)), 1U);
+    fixture.Flush();
+    REQUIRE_EQ(fixture.frames.size(), 2U);
+    CHECK_EQ(fixture.frames[1].payload, fixture.frames[0].payload);
+    CHECK_EQ(fixture.session.Retransmissions(), 1U);
+
+    const auto status = client::comm::Protocol::SerializeStatus({.is_calibrated = true, .command_id = 42});
+    REQUIRE(status.has_value());
+    fixture.Reply(FrameType::kResponse, *status);
+    CHECK_EQ(fixture.session.PollRetransmits(sent + std::chrono::seconds(60)), 0U);
+  }
+
+  TEST_CASE("LinkSession: MOVEs coalesce while the transport backlog is high") {
+    Fixture fixture;
+    fixture.session.SetLowWatermark(1);
+    REQUIRE(fixture.session.SendMove({.command_id = 1}).has_value());
+    for (uint32_t id = 2; id <= 10; ++id) {
+      REQUIRE(fixture.session.SendMove({.command_id = id}).has_value());
+    }
+    CHECK_EQ(fixture.session.Scheduler().Depth(), 1U);
+
+    // Draining the backlog lets the newest MOVE out; the ones in between were replaced
+    fixture.host->Pump();
+    fixture.host->Pump();
+    REQUIRE_EQ(fixture.frames.size(), 2U);
+    const auto last = client::comm::Protocol::DeserializeServoCommand(fixture.frames[1].payload);
+    REQUIRE(last.has_value());
+    CHECK_EQ(last->command_id, 10U);
+  }
+}
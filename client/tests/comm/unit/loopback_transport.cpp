@@ -0,0 +1,129 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/loopback_transport.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace {
+
+using client::comm::LoopbackTransport;
+using client::comm::TransportError;
+using client::comm::TransportState;
+
+const std::vector<uint8_t> kData = {0x01, 0x02, 0x03, 0x04, 0x05};
+
+struct Received {
+  std::vector<uint8_t> bytes;
+  size_t chunks = 0;
+
+  void Attach(LoopbackTransport& transport) {
+    transport.SetReceiveCallback([this](std::span<const uint8_t> data) {
+      bytes.insert(bytes.end(), data.begin(), data.end());
+      ++chunks;
+    });
+  }
+};
+
+}  // namespace
+
+TEST_SUITE("client::comm::LoopbackTransport") {
+  TEST_CASE("LoopbackTransport: Open reports the state change synchronously") {
+    auto [a, b] = LoopbackTransport::CreatePair();
+    std::vector<TransportState> states;
+    a->SetStateCallback([&states](TransportState state, TransportError) { states.push_back(state); });
+
+    REQUIRE(a->Open().has_value());
+    CHECK_EQ(a->State(), TransportState::kOpen);
+    CHECK_EQ(states, std::vector<TransportState>{TransportState::kOpen});
+    CHECK_EQ(a->Open().error(), TransportError::kAlreadyOpen);
+  }
+
+  TEST_CASE("LoopbackTransport: Bytes wait in the backlog until pumped") {
+    auto [a, b] = LoopbackTransport::CreatePair();
+    Received received;
+    received.Attach(*b);
+    REQUIRE(a->Open().has_value());
+    REQUIRE(b->Open().has_value());
+
+    REQUIRE_EQ(a->Write(kData).value_or(0), kData.size());
+    CHECK_EQ(a->Backlog(), kData.size());
+    CHECK(received.bytes.empty());
+
+    CHECK_EQ(a->Pump(2), 2U);
+    CHECK_EQ(a->Backlog(), 3U);
+    CHECK_EQ(a->Pump(), 3U);
+    CHECK_EQ(a->Pump(), 0U);
+    CHECK_EQ(received.bytes, kData);
+    CHECK_EQ(received.chunks, 2U);
+    CHECK_EQ(a->Stats().bytes_sent, kData.size());
+    CHECK_EQ(a->Stats().writes, 1U);
+    CHECK_EQ(b->Stats().bytes_received, kData.size());
+  }
+
+  TEST_CASE("LoopbackTransport: Pumping notifies the writer") {
+    auto [a, b] = LoopbackTransport::CreatePair();
+    size_t writable = 0;
+    a->SetWritableCallback([&writable] { ++writable; });
+    REQUIRE(a->Open().has_value());
+    REQUIRE(b->Open().has_value());
+
+    REQUIRE(a->Write(kData).has_value());
+    a->Pump();
+    CHECK_EQ(writable, 1U);
+  }
+
+  TEST_CASE("LoopbackTransport: The receiver may answer from its receive callback") {
+    auto [a, b] = LoopbackTransport::CreatePair();
+    Received echoed;
+    echoed.Attach(*a);
+    LoopbackTransport& device = *b;
+    b->SetReceiveCallback([&device](std::span<const uint8_t> data) { (void)device.Write(data); });
+    REQUIRE(a->Open().has_value());
+    REQUIRE(b->Open().has_value());
+
+    REQUIRE(a->Write(kData).has_value());
+    a->Pump();
+    b->Pump();
+    CHECK_EQ(echoed.bytes, kData);
+  }
+
+  TEST_CASE("LoopbackTransport: Writing to a closed end fails") {
+    auto [a, b] = LoopbackTransport::CreatePair();
+    CHECK_EQ(a->Write(kData).error(), TransportError::kNotOpen);
+    CHECK_EQ(a->Stats().write_errors, 1U);
+    CHECK_FALSE(a->LastError().empty());
+  }
+
+  TEST_CASE("LoopbackTransport: Closing one end drops the link on the other") {
+    auto [a, b] = LoopbackTransport::CreatePair();
+    TransportError peer_error = TransportError::kOk;
+    b->SetStateCallback([&peer_error](TransportState state, TransportError error) {
+      if (state == TransportState::kClosed) {
+        peer_error = error;
+      }
+    });
+    REQUIRE(a->Open().has_value());
+    REQUIRE(b->Open().has_value());
+    REQUIRE(b->Write(kData).has_value());
+
+    a->Close();
+    CHECK_EQ(a->State(), TransportState::kClosed);
+    CHECK_EQ(a->LastError(), "");
+    CHECK_EQ(b->State(), TransportState::kClosed);
+    CHECK_EQ(peer_error, TransportError::kConnectionLost);
+    CHECK_EQ(b->Backlog(), 0U);
+  }
+
+  TEST_CASE("LoopbackTransport: An end outlives its peer") {
+    auto [a, b] = LoopbackTransport::CreatePair();
+    REQUIRE(a->Open().has_value());
+    REQUIRE(a->Write(kData).has_value());
+    b.reset();
+
+    CHECK_EQ(a->Pump(), kData.size());
+    a->Close();
+    CHECK_EQ(a->Open().error(), TransportError::kNotOpen);
+  }
+}
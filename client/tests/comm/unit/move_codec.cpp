@@ -0,0 +1,147 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/move_codec.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Encodable at compile time
+constexpr auto kCompileTimeMove = client::comm::EncodeMoveCommand(
+    client::comm::ServoCommand{.pan_angle = 1.0F, .tilt_angle = 0.0F, .command_id = 1, .timestamp_ms = 0});
+static_assert(kCompileTimeMove.size == 13);
+static_assert(client::comm::DecodeMoveCommand(kCompileTimeMove.Bytes())->pan_angle == 1.0F);
+
+[[nodiscard]] float RandomAngle(std::mt19937& rng) {
+  // Mix ordinary angles with the bit patterns proto3 treats specially
+  std::uniform_int_distribution<int> pick(0, 9);
+  std::uniform_real_distribution<float> angle(-90.0F, 90.0F);
+  switch (pick(rng)) {
+    case 0:
+      return 0.0F;
+    case 1:
+      return -0.0F;
+    case 2:
+      return std::numeric_limits<float>::denorm_min();
+    case 3:
+      return std::numeric_limits<float>::infinity();
+    default:
+      return angle(rng);
+  }
+}
+
+[[nodiscard]] uint64_t RandomVarint(std::mt19937_64& rng) {
+  // Uniform over bit widths so every varint length is covered
+  std::uniform_int_distribution<int> bits(0, 64);
+  const int width = bits(rng);
+  return width == 0 ? 0 : rng() >> (64 - width);
+}
+
+}  // namespace
+
+TEST_SUITE("client::comm::MoveCodec") {
+  TEST_CASE("EncodeMoveCommand: Byte-identical to the generated protobuf code") {
+    std::mt19937 rng(42);
+    std::mt19937_64 rng64(42);
+
+    for (int i = 0; i < 5000; ++i) {
+      // Every other command carries a velocity and horizon
+      const bool tracking = i % 2 == 0;
+      const client::comm::ServoCommand cmd{.pan_angle = RandomAngle(rng),
+                                           .tilt_angle = RandomAngle(rng),
+                                           .command_id = static_cast<uint32_t>(RandomVarint(rng64)),
+                                           .timestamp_ms = RandomVarint(rng64),
+                                           .pan_velocity = tracking ? RandomAngle(rng) : 0.0F,
+                                           .tilt_velocity = tracking ? RandomAngle(rng) : 0.0F,
+                                           .valid_for_ms = tracking ? static_cast<uint32_t>(RandomVarint(rng64)) : 0};
+
+      const auto expected = client::comm::Protocol::SerializeServoCommand(cmd);
+      REQUIRE(expected.has_value());
+      const auto encoded = client::comm::EncodeMoveCommand(cmd);
+      REQUIRE(std::ranges::equal(encoded.Bytes(), *expected));
+      CHECK_LE(encoded.size, client::comm::kMaxMoveCommandSize);
+    }
+  }
+
+  TEST_CASE("DecodeMoveCommand: Round-trips and agrees with the generated protobuf code") {
+    std::mt19937 rng(7);
+    std::mt19937_64 rng64(7);
+
+    for (int i = 0; i < 5000; ++i) {
+      // Every other command carries a velocity and horizon
+      const bool tracking = i % 2 == 0;
+      const client::comm::ServoCommand cmd{.pan_angle = RandomAngle(rng),
+                                           .tilt_angle = RandomAngle(rng),
+                                           .command_id = static_cast<uint32_t>(RandomVarint(rng64)),
+                                           .timestamp_ms = RandomVarint(rng64),
+                                           .pan_velocity = tracking ? RandomAngle(rng) : 0.0F,
+                                           .tilt_velocity = tracking ? RandomAngle(rng) : 0.0F,
+                                           .valid_for_ms = tracking ? static_cast<uint32_t>(RandomVarint(rng64)) : 0};
+      const auto encoded = client::comm::EncodeMoveCommand(cmd);
+
+      const auto decoded = client::comm::DecodeMoveCommand(encoded.Bytes());
+      const auto reference = client::comm::Protocol::DeserializeServoCommand(encoded.Bytes());
+      REQUIRE(decoded.has_value());
+      REQUIRE(reference.has_value());
+      CHECK_EQ(std::bit_cast<uint32_t>(decoded->pan_angle), std::bit_cast<uint32_t>(cmd.pan_angle));
+      CHECK_EQ(std::bit_cast<uint32_t>(decoded->tilt_angle), std::bit_cast<uint32_t>(cmd.tilt_angle));
+      CHECK_EQ(decoded->command_id, cmd.command_id);
+      CHECK_EQ(decoded->timestamp_ms, cmd.timestamp_ms);
+      CHECK_EQ(decoded->command_id, reference->command_id);
+      CHECK_EQ(decoded->timestamp_ms, reference->timestamp_ms);
+      CHECK_EQ(decoded->pan_velocity, cmd.pan_velocity);  // -0.0 alone is not worth sending
+      CHECK_EQ(decoded->tilt_velocity, cmd.tilt_velocity);
+      CHECK_EQ(decoded->valid_for_ms, cmd.valid_for_ms);
+      CHECK_EQ(std::bit_cast<uint32_t>(decoded->pan_velocity), std::bit_cast<uint32_t>(reference->pan_velocity));
+      CHECK_EQ(std::bit_cast<uint32_t>(decoded->tilt_velocity), std::bit_cast<uint32_t>(reference->tilt_velocity));
+      CHECK_EQ(decoded->valid_for_ms, reference->valid_for_ms);
+    }
+  }
+
+  TEST_CASE("DecodeMoveCommand: Accepts reordered and unknown fields") {
+    // tilt before pan, type before id, an unknown varint (field 5) and fixed64 (field 6)
+    const std::vector<uint8_t> bytes = {0x18, 0x01, 0x08, 0x2A, 0x28, 0x96, 0x01, 0x31, 1, 2, 3, 4,
+                                        5,    6,    7,    8,    0x52, 0x0C, 0x12, 0x0A, 0x15, 0x00, 0x00, 0x20,
+                                        0x41, 0x0D, 0x00, 0x00, 0x80, 0x3F};
+
+    const auto decoded = client::comm::DecodeMoveCommand(bytes);
+    REQUIRE(decoded.has_value());
+    CHECK_EQ(decoded->command_id, 42);
+    CHECK_EQ(decoded->pan_angle, 1.0F);
+    CHECK_EQ(decoded->tilt_angle, 10.0F);
+
+    const auto reference = client::comm::Protocol::DeserializeServoCommand(bytes);
+    REQUIRE(reference.has_value());
+    CHECK_EQ(reference->pan_angle, 1.0F);
+    CHECK_EQ(reference->tilt_angle, 10.0F);
+  }
+
+  TEST_CASE("DecodeMoveCommand: Rejects malformed and non-MOVE messages") {
+    const auto home = client::comm::Protocol::SerializeHome();
+    REQUIRE(home.has_value());
+    const auto not_move = client::comm::DecodeMoveCommand(*home);
+    REQUIRE_FALSE(not_move.has_value());
+    CHECK_EQ(not_move.error(), client::comm::ProtocolError::kInvalidMessage);
+
+    const auto encoded = client::comm::EncodeMoveCommand(client::comm::ServoCommand{.pan_angle = 5.0F});
+    for (size_t length = 1; length < encoded.size; ++length) {
+      const auto truncated = client::comm::DecodeMoveCommand(encoded.Bytes().first(length));
+      CHECK_FALSE(truncated.has_value());
+    }
+  }
+
+  TEST_CASE("EncodeMoveCommand: Rejects small buffers") {
+    std::array<uint8_t, 8> small{};
+    const auto result = client::comm::EncodeMoveCommand(client::comm::ServoCommand{.pan_angle = 5.0F}, small);
+    REQUIRE_FALSE(result.has_value());
+    CHECK_EQ(result.error(), client::comm::ProtocolError::kBufferTooSmall);
+  }
+}
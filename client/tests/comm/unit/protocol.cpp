@@ -2,7 +2,10 @@
 
 #include <client/comm/protocol.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 TEST_SUITE("client::comm::Protocol") {
@@ -170,6 +173,42 @@ TEST_SUITE("client::comm::Protocol") {
     CHECK(deserialized->smooth);
   }
 
+  TEST_CASE("Protocol: ServoCommand preserves command ID and timestamp") {
+    client::comm::ServoCommand cmd{
+        .pan_angle = 10.0F, .tilt_angle = 5.0F, .command_id = 1234, .timestamp_ms = 987654321ULL};
+
+    auto serialized = client::comm::Protocol::SerializeServoCommand(cmd);
+    REQUIRE(serialized.has_value());
+
+    auto deserialized = client::comm::Protocol::DeserializeServoCommand(*serialized);
+    REQUIRE(deserialized.has_value());
+    CHECK_EQ(deserialized->command_id, 1234U);
+    CHECK_EQ(deserialized->timestamp_ms, 987654321ULL);
+  }
+
+  TEST_CASE("Protocol: ServoCommand preserves velocity and horizon") {
+    const client::comm::ServoCommand cmd{
+        .pan_angle = 10.0F, .tilt_angle = 5.0F, .pan_velocity = 35.5F, .tilt_velocity = -12.0F, .valid_for_ms = 250};
+
+    auto serialized = client::comm::Protocol::SerializeServoCommand(cmd);
+    REQUIRE(serialized.has_value());
+
+    auto deserialized = client::comm::Protocol::DeserializeServoCommand(*serialized);
+    REQUIRE(deserialized.has_value());
+    CHECK_EQ(deserialized->pan_velocity, 35.5F);
+    CHECK_EQ(deserialized->tilt_velocity, -12.0F);
+    CHECK_EQ(deserialized->valid_for_ms, 250U);
+
+    // Position-only commands keep their encoding, so older firmware reads them unchanged
+    const client::comm::ServoCommand position_only{.pan_angle = 10.0F, .tilt_angle = 5.0F};
+    auto position_bytes = client::comm::Protocol::SerializeServoCommand(position_only);
+    REQUIRE(position_bytes.has_value());
+    CHECK_LT(position_bytes->size(), serialized->size());
+    auto position_decoded = client::comm::Protocol::DeserializeServoCommand(*position_bytes);
+    REQUIRE(position_decoded.has_value());
+    CHECK_EQ(position_decoded->valid_for_ms, 0U);
+  }
+
   TEST_CASE("Protocol: FaceDataMessage round-trip") {
     client::comm::Protocol protocol;
     client::comm::FaceDataMessage msg;
@@ -239,6 +278,47 @@ TEST_SUITE("client::comm::Protocol") {
     CHECK_EQ(deserialized->error_code, msg.error_code);
   }
 
+  TEST_CASE("Protocol: StatusMessage preserves command ID") {
+    client::comm::StatusMessage msg{.is_calibrated = true, .command_id = 77, .timestamp_ms = 4242};
+
+    auto serialized = client::comm::Protocol::SerializeStatus(msg);
+    REQUIRE(serialized.has_value());
+
+    auto deserialized = client::comm::Protocol::DeserializeStatus(*serialized);
+    REQUIRE(deserialized.has_value());
+    CHECK_EQ(deserialized->command_id, 77U);
+    CHECK_EQ(deserialized->timestamp_ms, 4242U);
+  }
+
+  TEST_CASE("Protocol: StatusMessage carries full device status") {
+    client::comm::StatusMessage msg{.pan_position = 10.0F,
+                                    .tilt_position = 5.0F,
+                                    .target_pan = 30.0F,
+                                    .target_tilt = -12.5F,
+                                    .is_moving = true,
+                                    .free_heap = 123456,
+                                    .uptime_ms = 9876543210ULL,
+                                    .servo_loop = {.rate_hz = 200,
+                                                   .updates = 4000,
+                                                   .jitter_us = 35,
+                                                   .max_jitter_us = 410,
+                                                   .overruns = 2,
+                                                   .max_busy_us = 90}};
+
+    auto serialized = client::comm::Protocol::SerializeStatus(msg);
+    REQUIRE(serialized.has_value());
+
+    auto deserialized = client::comm::Protocol::DeserializeStatus(*serialized);
+    REQUIRE(deserialized.has_value());
+    CHECK(deserialized->has_device_status);
+    CHECK_EQ(deserialized->target_pan, doctest::Approx(30.0));
+    CHECK_EQ(deserialized->target_tilt, doctest::Approx(-12.5));
+    CHECK(deserialized->is_moving);
+    CHECK_EQ(deserialized->free_heap, 123456U);
+    CHECK_EQ(deserialized->uptime_ms, 9876543210ULL);
+    CHECK_EQ(deserialized->servo_loop, msg.servo_loop);
+  }
+
   TEST_CASE("Protocol: HeartbeatMessage round-trip") {
     client::comm::Protocol protocol;
     client::comm::HeartbeatMessage msg{.timestamp_ms = 555666777, .sequence = 42};
@@ -285,6 +365,82 @@ TEST_SUITE("client::comm::Protocol") {
     CHECK_EQ(deserialized->frame_id, 0U);
   }
 
+  TEST_CASE("Protocol: Span overloads match the vector overloads") {
+    const client::comm::ServoCommand cmd{
+        .pan_angle = 12.5F, .tilt_angle = -7.0F, .command_id = 42, .timestamp_ms = 9000};
+    const client::comm::HeartbeatMessage heartbeat{.timestamp_ms = 1234, .sequence = 7};
+    std::array<uint8_t, 128> buffer{};
+
+    const auto expected_cmd = client::comm::Protocol::SerializeServoCommand(cmd);
+    const auto written_cmd = client::comm::Protocol::SerializeServoCommand(cmd, buffer);
+    REQUIRE(expected_cmd.has_value());
+    REQUIRE(written_cmd.has_value());
+    CHECK(std::ranges::equal(std::span(buffer).first(*written_cmd), *expected_cmd));
+
+    const auto expected_heartbeat = client::comm::Protocol::SerializeHeartbeat(heartbeat);
+    const auto written_heartbeat = client::comm::Protocol::SerializeHeartbeat(heartbeat, buffer);
+    REQUIRE(expected_heartbeat.has_value());
+    REQUIRE(written_heartbeat.has_value());
+    CHECK(std::ranges::equal(std::span(buffer).first(*written_heartbeat), *expected_heartbeat));
+
+    const auto expected_home = client::comm::Protocol::SerializeHome();
+    const auto written_home = client::comm::Protocol::SerializeHome(buffer);
+    REQUIRE(expected_home.has_value());
+    REQUIRE(written_home.has_value());
+    CHECK(std::ranges::equal(std::span(buffer).first(*written_home), *expected_home));
+
+    const auto expected_get_status = client::comm::Protocol::SerializeGetStatus(9);
+    const auto written_get_status = client::comm::Protocol::SerializeGetStatus(buffer, 9);
+    REQUIRE(expected_get_status.has_value());
+    REQUIRE(written_get_status.has_value());
+    CHECK(std::ranges::equal(std::span(buffer).first(*written_get_status), *expected_get_status));
+
+    const auto written_calibrate = client::comm::Protocol::SerializeCalibrate(buffer);
+    REQUIRE(written_calibrate.has_value());
+    CHECK_EQ(client::comm::Protocol::DetectMessageType(std::span(buffer).first(*written_calibrate)),
+             client::comm::MessageType::kCalibration);
+  }
+
+  TEST_CASE("Protocol: Span overloads reject buffers that are too small") {
+    const client::comm::ServoCommand cmd{.pan_angle = 45.0F, .tilt_angle = 10.0F, .command_id = 1};
+    std::array<uint8_t, 4> small{};
+
+    const auto result = client::comm::Protocol::SerializeServoCommand(cmd, small);
+    REQUIRE_FALSE(result.has_value());
+    CHECK_EQ(result.error(), client::comm::ProtocolError::kBufferTooSmall);
+
+    const client::comm::StatusMessage status{.pan_position = 1.0F, .has_device_status = true};
+    const auto status_result = client::comm::Protocol::SerializeStatus(status, small);
+    REQUIRE_FALSE(status_result.has_value());
+    CHECK_EQ(status_result.error(), client::comm::ProtocolError::kBufferTooSmall);
+  }
+
+  TEST_CASE("Protocol: Handshake round-trip") {
+    const client::comm::HandshakeMessage handshake{
+        .protocol_version = 2, .client_id = "client", .features = {"compact_v2", "other"}};
+
+    const auto bytes = client::comm::Protocol::SerializeHandshake(handshake);
+    REQUIRE(bytes.has_value());
+    const auto parsed = client::comm::Protocol::DeserializeHandshake(*bytes);
+    REQUIRE(parsed.has_value());
+    CHECK_EQ(*parsed, handshake);
+
+    const client::comm::HandshakeResponseMessage response{.protocol_version = 2,
+                                                          .device_id = "esp32",
+                                                          .firmware_version = "1.0.0",
+                                                          .supported_features = {"compact_v2"},
+                                                          .accepted = true,
+                                                          .rejection_reason = {}};
+
+    const auto response_bytes = client::comm::Protocol::SerializeHandshakeResponse(response);
+    REQUIRE(response_bytes.has_value());
+    const auto parsed_response = client::comm::Protocol::DeserializeHandshakeResponse(*response_bytes);
+    REQUIRE(parsed_response.has_value());
+    CHECK_EQ(*parsed_response, response);
+    CHECK(parsed_response->Supports("compact_v2"));
+    CHECK_FALSE(parsed_response->Supports("other"));
+  }
+
   TEST_CASE("MessageType: Enum values are distinct") {
     CHECK_NE(client::comm::MessageType::kUnknown, client::comm::MessageType::kServoCommand);
     CHECK_NE(client::comm::MessageType::kServoCommand, client::comm::MessageType::kFaceData);
@@ -0,0 +1,64 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/protocol.hpp>
+
+#include "allocation_counter.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+TEST_SUITE("client::comm::Protocol allocations") {
+  TEST_CASE("Protocol: Span serialization does not allocate") {
+    const client::comm::ServoCommand cmd{.pan_angle = 30.0F, .tilt_angle = -12.0F, .command_id = 77, .timestamp_ms = 5};
+    const client::comm::HeartbeatMessage heartbeat{.timestamp_ms = 99, .sequence = 3};
+    std::array<uint8_t, 128> buffer{};
+
+    // Warm up protobuf's lazily initialized defaults
+    static_cast<void>(client::comm::Protocol::SerializeServoCommand(cmd, buffer));
+
+    size_t written = 0;
+    const size_t allocations = client::test::CountAllocations([&]() {
+      for (int i = 0; i < 100; ++i) {
+        written += client::comm::Protocol::SerializeServoCommand(cmd, buffer).value_or(0);
+        written += client::comm::Protocol::SerializeHeartbeat(heartbeat, buffer).value_or(0);
+        written += client::comm::Protocol::SerializeHome(buffer).value_or(0);
+        written += client::comm::Protocol::SerializeCalibrate(buffer).value_or(0);
+      }
+    });
+
+    CHECK_GT(written, 0);
+    CHECK_EQ(allocations, 0);
+  }
+
+  TEST_CASE("Protocol: Status round trip does not allocate") {
+    const client::comm::StatusMessage status{.pan_position = 10.0F,
+                                             .tilt_position = 5.0F,
+                                             .target_pan = 12.0F,
+                                             .target_tilt = 6.0F,
+                                             .is_calibrated = true,
+                                             .is_moving = true,
+                                             .has_device_status = true,
+                                             .command_id = 42,
+                                             .free_heap = 120000,
+                                             .uptime_ms = 3600000};
+    std::array<uint8_t, 128> buffer{};
+    const auto size = client::comm::Protocol::SerializeStatus(status, buffer);
+    REQUIRE(size.has_value());
+    const std::span<const uint8_t> payload(buffer.data(), *size);
+
+    static_cast<void>(client::comm::Protocol::DeserializeStatus(payload));
+
+    uint32_t command_ids = 0;
+    const size_t allocations = client::test::CountAllocations([&]() {
+      for (int i = 0; i < 100; ++i) {
+        const auto decoded = client::comm::Protocol::DeserializeStatus(payload);
+        command_ids += decoded ? decoded->command_id : 0;
+      }
+    });
+
+    CHECK_EQ(command_ids, 4200);
+    CHECK_EQ(allocations, 0);
+  }
+}
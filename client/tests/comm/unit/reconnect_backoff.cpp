@@ -0,0 +1,56 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/reconnect_backoff.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <set>
+
+namespace {
+
+using client::comm::ReconnectBackoff;
+using std::chrono::milliseconds;
+
+}  // namespace
+
+TEST_SUITE("client::comm::ReconnectBackoff") {
+  TEST_CASE("ReconnectBackoff: Doubles up to the cap, jittered within the upper half") {
+    ReconnectBackoff backoff(1);
+    milliseconds nominal = ReconnectBackoff::kInitialDelay;
+    for (int attempt = 0; attempt < 12; ++attempt) {
+      CHECK_EQ(backoff.NominalDelay(), nominal);
+      const auto delay = backoff.NextDelay();
+      CHECK_GE(delay, nominal / 2);
+      CHECK_LE(delay, nominal);
+      nominal = std::min(nominal * 2, ReconnectBackoff::kMaxDelay);
+    }
+    CHECK_EQ(backoff.Attempts(), 12U);
+    CHECK_EQ(backoff.NominalDelay(), ReconnectBackoff::kMaxDelay);
+
+    backoff.Reset();
+    CHECK_EQ(backoff.Attempts(), 0U);
+    CHECK_LE(backoff.NextDelay(), ReconnectBackoff::kInitialDelay);
+  }
+
+  TEST_CASE("ReconnectBackoff: Clients seeded differently spread their attempts") {
+    std::set<milliseconds::rep> delays;
+    for (uint32_t seed = 1; seed <= 16; ++seed) {
+      ReconnectBackoff backoff(seed);
+      for (int attempt = 0; attempt < 5; ++attempt) {
+        (void)backoff.NextDelay();
+      }
+      delays.insert(backoff.NextDelay().count());
+    }
+    CHECK_GT(delays.size(), 8U);
+  }
+
+  TEST_CASE("ReconnectBackoff: Survives a long outage without overflowing") {
+    ReconnectBackoff backoff(7);
+    for (int attempt = 0; attempt < 1000; ++attempt) {
+      const auto delay = backoff.NextDelay();
+      CHECK_GE(delay, ReconnectBackoff::kInitialDelay / 2);
+      CHECK_LE(delay, ReconnectBackoff::kMaxDelay);
+    }
+  }
+}
@@ -0,0 +1,98 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/device_shadow.hpp>
+#include <client/comm/protocol.hpp>
+#include <client/comm/response_dispatcher.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+[[nodiscard]] std::vector<uint8_t> MakeResponse(const client::comm::StatusMessage& msg) {
+  return client::comm::Protocol::SerializeStatus(msg).value();
+}
+
+}  // namespace
+
+TEST_SUITE("client::comm::ResponseDispatcher") {
+  TEST_CASE("ResponseDispatcher: Routes a response to the handler waiting for its command ID") {
+    client::comm::DeviceShadow shadow;
+    client::comm::ResponseDispatcher dispatcher(shadow);
+
+    uint32_t expected_calls = 0;
+    uint32_t default_calls = 0;
+    dispatcher.Expect(5, [&](const client::comm::StatusMessage& response) {
+      CHECK_EQ(response.command_id, 5U);
+      ++expected_calls;
+    });
+    dispatcher.SetDefaultHandler([&](const client::comm::StatusMessage&) { ++default_calls; });
+    CHECK_EQ(dispatcher.Pending(), 1);
+
+    REQUIRE(dispatcher.Dispatch(MakeResponse({.command_id = 5})).has_value());
+    CHECK_EQ(expected_calls, 1);
+    CHECK_EQ(default_calls, 0);
+    CHECK_EQ(dispatcher.Pending(), 0);
+
+    // Handlers are one-shot: a duplicate response goes to the default handler
+    REQUIRE(dispatcher.Dispatch(MakeResponse({.command_id = 5})).has_value());
+    CHECK_EQ(expected_calls, 1);
+    CHECK_EQ(default_calls, 1);
+  }
+
+  TEST_CASE("ResponseDispatcher: Sends unsolicited and unmatched responses to the default handler") {
+    client::comm::DeviceShadow shadow;
+    client::comm::ResponseDispatcher dispatcher(shadow);
+
+    std::vector<uint32_t> seen;
+    dispatcher.SetDefaultHandler(
+        [&](const client::comm::StatusMessage& response) { seen.push_back(response.command_id); });
+
+    REQUIRE(dispatcher.Dispatch(MakeResponse({.command_id = 0})).has_value());
+    REQUIRE(dispatcher.Dispatch(MakeResponse({.command_id = 99})).has_value());
+    const std::vector<uint32_t> expected = {0, 99};
+    CHECK_EQ(seen, expected);
+  }
+
+  TEST_CASE("ResponseDispatcher: Updates the device shadow from status responses") {
+    client::comm::DeviceShadow shadow;
+    client::comm::ResponseDispatcher dispatcher(shadow);
+
+    const auto payload = MakeResponse({.pan_position = 15.0F, .target_pan = 30.0F, .free_heap = 2048});
+    REQUIRE(dispatcher.Dispatch(payload).has_value());
+
+    const auto state = shadow.Read();
+    REQUIRE(state.Valid());
+    CHECK_EQ(state.pan, doctest::Approx(15.0));
+    CHECK_EQ(state.target_pan, doctest::Approx(30.0));
+    CHECK_EQ(state.free_heap, 2048U);
+  }
+
+  TEST_CASE("ResponseDispatcher: Cancel and Clear drop pending handlers") {
+    client::comm::DeviceShadow shadow;
+    client::comm::ResponseDispatcher dispatcher(shadow);
+
+    bool called = false;
+    dispatcher.Expect(1, [&](const client::comm::StatusMessage&) { called = true; });
+    dispatcher.Expect(2, [&](const client::comm::StatusMessage&) { called = true; });
+    CHECK(dispatcher.Cancel(1));
+    CHECK_FALSE(dispatcher.Cancel(1));
+    dispatcher.Clear();
+    CHECK_EQ(dispatcher.Pending(), 0);
+
+    REQUIRE(dispatcher.Dispatch(MakeResponse({.command_id = 2})).has_value());
+    CHECK_FALSE(called);
+  }
+
+  TEST_CASE("ResponseDispatcher: Rejects malformed payloads") {
+    client::comm::DeviceShadow shadow;
+    client::comm::ResponseDispatcher dispatcher(shadow);
+
+    constexpr std::array<uint8_t, 3> kGarbage = {0xFF, 0xFF, 0xFF};
+    const auto result = dispatcher.Dispatch(kGarbage);
+    REQUIRE_FALSE(result.has_value());
+    CHECK_EQ(result.error(), client::comm::ProtocolError::kDeserializationFailed);
+    CHECK_FALSE(shadow.Read().Valid());
+  }
+}
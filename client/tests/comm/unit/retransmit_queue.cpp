@@ -0,0 +1,83 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/retransmit_queue.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace {
+
+using std::chrono::milliseconds;
+
+const auto kStart = std::chrono::steady_clock::time_point(std::chrono::hours(1));
+const std::vector<uint8_t> kFrame = {0x00, 0x03, 0x01, 0x2A, 0x00};
+
+struct Recorder {
+  std::vector<std::vector<uint8_t>> resent;
+  std::vector<uint32_t> given_up;
+
+  size_t Poll(client::comm::RetransmitQueue& queue, std::chrono::steady_clock::time_point now) {
+    return queue.Poll(
+        now, [this](std::span<const uint8_t> frame) { resent.emplace_back(frame.begin(), frame.end()); },
+        [this](uint32_t id) { given_up.push_back(id); });
+  }
+};
+
+}  // namespace
+
+TEST_SUITE("client::comm::RetransmitQueue") {
+  TEST_CASE("RetransmitQueue: Resends an unanswered command with backoff") {
+    client::comm::RetransmitQueue queue;
+    Recorder recorder;
+    REQUIRE(queue.Track(7, kFrame, kStart, milliseconds(200)));
+
+    CHECK_EQ(recorder.Poll(queue, kStart + milliseconds(199)), 0U);
+    CHECK_EQ(recorder.Poll(queue, kStart + milliseconds(200)), 1U);
+    CHECK_EQ(recorder.resent.front(), kFrame);
+
+    // The timeout doubled, so the next retransmission is 400 ms later
+    CHECK_EQ(recorder.Poll(queue, kStart + milliseconds(599)), 0U);
+    CHECK_EQ(recorder.Poll(queue, kStart + milliseconds(600)), 1U);
+    CHECK_EQ(queue.Retransmissions(), 2U);
+  }
+
+  TEST_CASE("RetransmitQueue: Stops once the response arrives") {
+    client::comm::RetransmitQueue queue;
+    Recorder recorder;
+    REQUIRE(queue.Track(7, kFrame, kStart, milliseconds(200)));
+
+    CHECK(queue.Acknowledge(7));
+    CHECK_FALSE(queue.Acknowledge(7));
+    CHECK_FALSE(queue.Acknowledge(0));
+    CHECK_EQ(queue.Pending(), 0U);
+    CHECK_EQ(recorder.Poll(queue, kStart + std::chrono::seconds(10)), 0U);
+  }
+
+  TEST_CASE("RetransmitQueue: Gives up after the last attempt") {
+    client::comm::RetransmitQueue queue(2);
+    Recorder recorder;
+    REQUIRE(queue.Track(9, kFrame, kStart, milliseconds(100)));
+
+    CHECK_EQ(recorder.Poll(queue, kStart + milliseconds(100)), 1U);
+    CHECK_EQ(recorder.Poll(queue, kStart + milliseconds(300)), 0U);
+    CHECK_EQ(recorder.given_up, std::vector<uint32_t>{9});
+    CHECK_EQ(queue.Pending(), 0U);
+  }
+
+  TEST_CASE("RetransmitQueue: Bounds the number of tracked commands") {
+    client::comm::RetransmitQueue queue;
+    CHECK_FALSE(queue.Track(0, kFrame, kStart, milliseconds(100)));
+
+    for (uint32_t id = 1; id <= client::comm::RetransmitQueue::kMaxPending; ++id) {
+      CHECK(queue.Track(id, kFrame, kStart, milliseconds(100)));
+    }
+    CHECK_FALSE(queue.Track(100, kFrame, kStart, milliseconds(100)));
+    // Re-tracking an ID already held reuses its slot
+    CHECK(queue.Track(1, kFrame, kStart, milliseconds(100)));
+
+    queue.Clear();
+    CHECK_EQ(queue.Pending(), 0U);
+  }
+}
@@ -0,0 +1,102 @@
+#include <doctest/doctest.h>
+
+#include <client/comm/transport.hpp>
+
+#include <string>
+
+namespace {
+
+using client::comm::ParseTransportEndpoint;
+using client::comm::TransportError;
+using client::comm::TransportKind;
+
+}  // namespace
+
+TEST_SUITE("client::comm::Transport") {
+  TEST_CASE("TransportError: TransportErrorToString returns correct strings") {
+    CHECK_EQ(client::comm::TransportErrorToString(TransportError::kOk), "OK");
+    CHECK_EQ(client::comm::TransportErrorToString(TransportError::kNotSupported), "Transport not supported");
+    CHECK_EQ(client::comm::TransportErrorToString(TransportError::kInvalidAddress), "Invalid address");
+    CHECK_EQ(client::comm::TransportErrorToString(TransportError::kOpenFailed), "Failed to open link");
+    CHECK_EQ(client::comm::TransportErrorToString(TransportError::kAlreadyOpen), "Link already open");
+    CHECK_EQ(client::comm::TransportErrorToString(TransportError::kNotOpen), "Link not open");
+    CHECK_EQ(client::comm::TransportErrorToString(TransportError::kWriteFailed), "Failed to write data");
+    CHECK_EQ(client::comm::TransportErrorToString(TransportError::kConnectionLost), "Connection lost");
+    CHECK_EQ(client::comm::TransportErrorToString(TransportError::kInternalError), "Internal error");
+  }
+
+  TEST_CASE("TransportKind: Names are the URI schemes") {
+    CHECK_EQ(client::comm::TransportKindToString(TransportKind::kBluetooth), "bt");
+    CHECK_EQ(client::comm::TransportKindToString(TransportKind::kTcp), "tcp");
+    CHECK_EQ(client::comm::TransportKindToString(TransportKind::kUdp), "udp");
+    CHECK_EQ(client::comm::TransportKindToString(TransportKind::kSerial), "serial");
+    CHECK_EQ(client::comm::TransportKindToString(TransportKind::kLoopback), "loopback");
+  }
+
+  TEST_CASE("ParseTransportEndpoint: A bare address is Bluetooth") {
+    const auto endpoint = ParseTransportEndpoint("AA:BB:CC:DD:EE:FF");
+    REQUIRE(endpoint.has_value());
+    CHECK_EQ(endpoint->kind, TransportKind::kBluetooth);
+    CHECK_EQ(endpoint->address, "AA:BB:CC:DD:EE:FF");
+
+    const auto explicit_endpoint = ParseTransportEndpoint("bt://AA:BB:CC:DD:EE:FF");
+    REQUIRE(explicit_endpoint.has_value());
+    CHECK(*explicit_endpoint == *endpoint);
+  }
+
+  TEST_CASE("ParseTransportEndpoint: A Bluetooth address may name its RFCOMM channel") {
+    const auto endpoint = ParseTransportEndpoint("AA:BB:CC:DD:EE:FF#3");
+    REQUIRE(endpoint.has_value());
+    CHECK_EQ(endpoint->kind, TransportKind::kBluetooth);
+    CHECK_EQ(endpoint->address, "AA:BB:CC:DD:EE:FF#3");
+    CHECK(ParseTransportEndpoint("bt://AA:BB:CC:DD:EE:FF#30").has_value());
+
+    CHECK_EQ(ParseTransportEndpoint("AA:BB:CC:DD:EE:FF#0").error(), TransportError::kInvalidAddress);
+    CHECK_EQ(ParseTransportEndpoint("AA:BB:CC:DD:EE:FF#31").error(), TransportError::kInvalidAddress);
+    CHECK_EQ(ParseTransportEndpoint("AA:BB:CC:DD:EE:FF#").error(), TransportError::kInvalidAddress);
+    CHECK_EQ(ParseTransportEndpoint("bt://#3").error(), TransportError::kInvalidAddress);
+  }
+
+  TEST_CASE("ParseTransportEndpoint: Network endpoints need a host and port") {
+    const auto tcp = ParseTransportEndpoint("tcp://192.168.4.1:3333");
+    REQUIRE(tcp.has_value());
+    CHECK_EQ(tcp->kind, TransportKind::kTcp);
+    CHECK_EQ(tcp->address, "192.168.4.1:3333");
+
+    const auto udp = ParseTransportEndpoint("udp://[fe80::1]:3333");
+    REQUIRE(udp.has_value());
+    CHECK_EQ(udp->kind, TransportKind::kUdp);
+    CHECK_EQ(udp->address, "[fe80::1]:3333");
+
+    CHECK_EQ(ParseTransportEndpoint("tcp://192.168.4.1").error(), TransportError::kInvalidAddress);
+    CHECK_EQ(ParseTransportEndpoint("tcp://:3333").error(), TransportError::kInvalidAddress);
+    CHECK_EQ(ParseTransportEndpoint("tcp://host:0").error(), TransportError::kInvalidAddress);
+    CHECK_EQ(ParseTransportEndpoint("tcp://host:65536").error(), TransportError::kInvalidAddress);
+    CHECK_EQ(ParseTransportEndpoint("udp://host:port").error(), TransportError::kInvalidAddress);
+  }
+
+  TEST_CASE("ParseTransportEndpoint: Serial endpoints take an optional baud rate") {
+    const auto serial = ParseTransportEndpoint("serial:///dev/ttyUSB0@921600");
+    REQUIRE(serial.has_value());
+    CHECK_EQ(serial->kind, TransportKind::kSerial);
+    CHECK_EQ(serial->address, "/dev/ttyUSB0@921600");
+
+    CHECK(ParseTransportEndpoint("serial://COM3").has_value());
+    CHECK_EQ(ParseTransportEndpoint("serial://COM3@").error(), TransportError::kInvalidAddress);
+    CHECK_EQ(ParseTransportEndpoint("serial://@115200").error(), TransportError::kInvalidAddress);
+  }
+
+  TEST_CASE("ParseTransportEndpoint: Rejects unknown schemes and empty addresses") {
+    CHECK_EQ(ParseTransportEndpoint("").error(), TransportError::kInvalidAddress);
+    CHECK_EQ(ParseTransportEndpoint("bt://").error(), TransportError::kInvalidAddress);
+    CHECK_EQ(ParseTransportEndpoint("http://host:80").error(), TransportError::kInvalidAddress);
+    // Loopback ends are created in pairs, never from an address
+    CHECK_EQ(ParseTransportEndpoint("loopback://x").error(), TransportError::kInvalidAddress);
+  }
+
+  TEST_CASE("CreateTransport: Loopback is not created by kind") {
+    const auto transport = client::comm::CreateTransport(TransportKind::kLoopback);
+    REQUIRE_FALSE(transport.has_value());
+    CHECK_EQ(transport.error(), TransportError::kNotSupported);
+  }
+}
@@ -0,0 +1,30 @@
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<size_t> g_allocations{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, [[maybe_unused]] std::size_t size) noexcept { std::free(ptr); }
+
+namespace client::test {
+
+size_t AllocationCount() noexcept { return g_allocations.load(std::memory_order_relaxed); }
+
+}  // namespace client::test
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+
+namespace client::test {
+
+/**
+ * @brief Number of global allocations made so far by the test binary.
+ * @details Counted by the replacement global operator new in allocation_counter.cpp, which any test target
+ * that checks for allocations links. The replacement applies to the whole binary but only changes behaviour
+ * by counting.
+ */
+[[nodiscard]] size_t AllocationCount() noexcept;
+
+/// Runs fn and returns the number of global allocations it performed.
+template <typename Fn>
+[[nodiscard]] size_t CountAllocations(Fn&& fn) {
+  const size_t before = AllocationCount();
+  fn();
+  return AllocationCount() - before;
+}
+
+}  // namespace client::test
@@ -0,0 +1,127 @@
+#include <doctest/doctest.h>
+
+#include <client/core/metrics.hpp>
+#include <client/core/utils/latency_histogram.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_SUITE("client::metrics") {
+  TEST_CASE("MetricsErrorToString: returns error names") {
+    CHECK_EQ(client::metrics::MetricsErrorToString(client::metrics::MetricsError::kInvalidName),
+             "Invalid metric name");
+    CHECK_EQ(client::metrics::MetricsErrorToString(client::metrics::MetricsError::kDuplicateName),
+             "Duplicate metric name");
+  }
+
+  TEST_CASE("Counter: increments from many threads are summed") {
+    client::metrics::Counter counter;
+    constexpr size_t kThreads = 12;
+    constexpr uint64_t kIncrements = 10000;
+
+    std::vector<std::thread> threads;
+    threads.reserve(kThreads);
+    for (size_t i = 0; i < kThreads; ++i) {
+      threads.emplace_back([&counter]() {
+        for (uint64_t j = 0; j < kIncrements; ++j) {
+          counter.Increment();
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    CHECK_EQ(counter.Value(), kThreads * kIncrements);
+
+    counter.Reset();
+    CHECK_EQ(counter.Value(), 0U);
+  }
+
+  TEST_CASE("Gauge: set and add") {
+    client::metrics::Gauge gauge;
+    CHECK_EQ(gauge.Value(), doctest::Approx(0.0));
+
+    gauge.Set(29.5);
+    gauge.Add(-4.5);
+    CHECK_EQ(gauge.Value(), doctest::Approx(25.0));
+  }
+
+  TEST_CASE("Histogram: shards merge into one distribution") {
+    client::metrics::Histogram histogram;
+
+    std::thread worker([&histogram]() { histogram.Record(std::chrono::milliseconds(2)); });
+    worker.join();
+    histogram.Record(1000);
+
+    CHECK_EQ(histogram.Count(), 2U);
+
+    client::utils::LatencyHistogram merged;
+    histogram.MergeInto(merged);
+    CHECK_EQ(merged.Min(), 1000U);
+    CHECK_EQ(merged.Max(), 2000U);
+  }
+
+  TEST_CASE("Registry: validates names") {
+    using Registry = client::metrics::Registry;
+    CHECK(Registry::ValidName("client_frames_total"));
+    CHECK(Registry::ValidName("_private:metric1"));
+    CHECK_FALSE(Registry::ValidName(""));
+    CHECK_FALSE(Registry::ValidName("1frames"));
+    CHECK_FALSE(Registry::ValidName("frames-total"));
+
+    Registry registry;
+    client::metrics::Counter counter;
+    const auto result = registry.Register("bad name", "help", counter);
+    REQUIRE_FALSE(result.has_value());
+    CHECK_EQ(result.error(), client::metrics::MetricsError::kInvalidName);
+    CHECK_EQ(registry.Size(), 0U);
+  }
+
+  TEST_CASE("Registry: rejects duplicates and unregisters") {
+    client::metrics::Registry registry;
+    client::metrics::Counter first;
+    client::metrics::Gauge second;
+
+    CHECK(registry.Register("client_metric", "first", first).has_value());
+    const auto duplicate = registry.Register("client_metric", "second", second);
+    REQUIRE_FALSE(duplicate.has_value());
+    CHECK_EQ(duplicate.error(), client::metrics::MetricsError::kDuplicateName);
+
+    CHECK(registry.Unregister("client_metric"));
+    CHECK_FALSE(registry.Unregister("client_metric"));
+    CHECK(registry.Register("client_metric", "second", second).has_value());
+    CHECK_EQ(registry.Size(), 1U);
+  }
+
+  TEST_CASE("Registry: exposes Prometheus text format") {
+    client::metrics::Registry registry;
+    client::metrics::Counter frames;
+    client::metrics::Gauge fps;
+    client::metrics::Histogram detect;
+
+    frames.Increment(42);
+    fps.Set(29.5);
+    detect.Record(std::chrono::milliseconds(10));
+
+    REQUIRE(registry.Register("client_frames_total", "Frames processed", frames).has_value());
+    REQUIRE(registry.Register("client_fps", "Frames per second\nsmoothed", fps).has_value());
+    REQUIRE(registry.Register("client_detect_seconds", "Detection time", detect).has_value());
+
+    const std::string text = registry.Expose();
+    CHECK_NE(text.find("# HELP client_frames_total Frames processed\n# TYPE client_frames_total counter\n"
+                       "client_frames_total 42\n"),
+             std::string::npos);
+    CHECK_NE(text.find("# HELP client_fps Frames per second\\nsmoothed\n"), std::string::npos);
+    CHECK_NE(text.find("client_fps 29.5\n"), std::string::npos);
+    CHECK_NE(text.find("# TYPE client_detect_seconds summary\n"), std::string::npos);
+    CHECK_NE(text.find("client_detect_seconds{quantile=\"0.5\"} 0.01\n"), std::string::npos);
+    CHECK_NE(text.find("client_detect_seconds_sum 0.01\n"), std::string::npos);
+    CHECK_NE(text.find("client_detect_seconds_count 1\n"), std::string::npos);
+  }
+
+}  // TEST_SUITE
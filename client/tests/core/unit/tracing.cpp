@@ -0,0 +1,115 @@
+#include <doctest/doctest.h>
+
+#include <client/core/tracing.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+using client::tracing::Tracer;
+using std::chrono::microseconds;
+using std::chrono::seconds;
+
+}  // namespace
+
+TEST_SUITE("client::tracing") {
+  TEST_CASE("TraceErrorToString: returns error names") {
+    CHECK_EQ(client::tracing::TraceErrorToString(client::tracing::TraceError::kCannotOpenFile),
+             "Cannot open trace file");
+    CHECK_EQ(client::tracing::TraceErrorToString(client::tracing::TraceError::kWriteFailed),
+             "Failed to write trace file");
+  }
+
+  TEST_CASE("Tracer: records spans within the window") {
+    auto& tracer = Tracer::GetInstance();
+    tracer.Clear();
+
+    const auto now = Tracer::Clock::now();
+    tracer.Record("old", now - seconds(30), now - seconds(30) + microseconds(10));
+    tracer.Record("recent", now - microseconds(100), now);
+
+    const auto events = tracer.Collect(seconds(5));
+    REQUIRE_EQ(events.size(), 1U);
+    CHECK_EQ(std::string_view(events[0].name), "recent");
+    CHECK_EQ(events[0].duration_ns, 100'000);
+
+    CHECK_EQ(tracer.Collect(seconds(60)).size(), 2U);
+  }
+
+  TEST_CASE("Tracer: ring buffer keeps the newest spans") {
+    auto& tracer = Tracer::GetInstance();
+    tracer.Clear();
+
+    const auto start = Tracer::Clock::now();
+    for (size_t i = 0; i < Tracer::kEventsPerThread + 10; ++i) {
+      const auto time = start + microseconds(i);
+      tracer.Record(i < 10 ? "overwritten" : "kept", time, time);
+    }
+
+    const auto events = tracer.Collect(seconds(60));
+    CHECK_LE(events.size(), Tracer::kEventsPerThread);
+    CHECK_GE(events.size(), Tracer::kEventsPerThread - 1);
+    for (const auto& event : events) {
+      CHECK_EQ(std::string_view(event.name), "kept");
+    }
+  }
+
+  TEST_CASE("Tracer: threads get separate IDs") {
+    auto& tracer = Tracer::GetInstance();
+    tracer.Clear();
+
+    const auto record = [&tracer]() {
+      const auto now = Tracer::Clock::now();
+      tracer.Record("worker", now, now);
+    };
+    std::thread first(record);
+    std::thread second(record);
+    first.join();
+    second.join();
+
+    std::set<uint32_t> thread_ids;
+    for (const auto& event : tracer.Collect(seconds(5))) {
+      thread_ids.insert(event.thread_id);
+    }
+    CHECK_EQ(thread_ids.size(), 2U);
+  }
+
+  TEST_CASE("Tracer: exports Chrome trace-event JSON") {
+    auto& tracer = Tracer::GetInstance();
+    tracer.Clear();
+    tracer.SetThreadName("unit \"test\"");
+
+    const auto now = Tracer::Clock::now();
+    tracer.Record("FaceTracker::Detect", now - microseconds(1500), now);
+
+    const std::string json = tracer.ExportChromeJson(seconds(5));
+    CHECK(json.starts_with("{\"traceEvents\":["));
+    CHECK_NE(json.find(R"("name":"FaceTracker::Detect","cat":"client","ph":"X")"), std::string::npos);
+    CHECK_NE(json.find(R"("dur":1500.000)"), std::string::npos);
+    CHECK_NE(json.find(R"("args":{"name":"unit \"test\""})"), std::string::npos);
+    CHECK_NE(json.find(R"("displayTimeUnit":"ms")"), std::string::npos);
+  }
+
+  TEST_CASE("CLIENT_SPAN: records only when tracing is compiled in") {
+    auto& tracer = Tracer::GetInstance();
+    tracer.Clear();
+
+    {
+      CLIENT_SPAN("scoped");
+    }
+
+    const auto events = tracer.Collect(seconds(5));
+    if constexpr (client::tracing::kTracingEnabled) {
+      REQUIRE_EQ(events.size(), 1U);
+      CHECK_EQ(std::string_view(events[0].name), "scoped");
+    } else {
+      CHECK(events.empty());
+    }
+  }
+
+}  // TEST_SUITE
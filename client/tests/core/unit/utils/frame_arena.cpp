@@ -0,0 +1,102 @@
+#include <doctest/doctest.h>
+
+#include <client/core/utils/frame_arena.hpp>
+
+#include "allocation_counter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+TEST_SUITE("utils::FrameArena") {
+  TEST_CASE("FrameArena: allocations within capacity never reach upstream") {
+    client::utils::FrameArena arena(4096);
+
+    {
+      std::pmr::vector<int> values(arena.Resource());
+      values.reserve(64);
+      for (int i = 0; i < 64; ++i) {
+        values.push_back(i);
+      }
+      CHECK_EQ(values.back(), 63);
+    }
+
+    CHECK_GT(arena.BytesInFrame(), 0U);
+    arena.Reset();
+
+    const auto stats = arena.Stats();
+    CHECK_EQ(stats.frames, 1U);
+    CHECK_EQ(stats.upstream_allocations, 0U);
+    CHECK_EQ(stats.growths, 0U);
+    CHECK_EQ(arena.BytesInFrame(), 0U);
+  }
+
+  TEST_CASE("FrameArena: grows after spilling and reaches zero upstream allocations") {
+    client::utils::FrameArena arena(64);
+
+    const auto run_frame = [&arena] {
+      std::pmr::vector<float> scores(arena.Resource());
+      std::pmr::vector<int> indices(arena.Resource());
+      for (int i = 0; i < 200; ++i) {
+        scores.push_back(static_cast<float>(i));
+        indices.push_back(i);
+      }
+      arena.Reset();
+    };
+
+    run_frame();
+    const auto warmup = arena.Stats();
+    CHECK_GT(warmup.upstream_allocations, 0U);
+    CHECK_EQ(warmup.growths, 1U);
+    CHECK_GE(warmup.capacity, warmup.peak_frame_bytes);
+
+    for (int frame = 0; frame < 10; ++frame) {
+      run_frame();
+    }
+
+    const auto steady = arena.Stats();
+    CHECK_EQ(steady.frames, 11U);
+    CHECK_EQ(steady.upstream_allocations, warmup.upstream_allocations);
+    CHECK_EQ(steady.growths, warmup.growths);
+    CHECK_EQ(steady.bytes_last_frame, warmup.bytes_last_frame);
+  }
+
+  TEST_CASE("FrameArena: a warmed-up frame makes no global allocations") {
+    client::utils::FrameArena arena(64);
+    std::vector<int> kept;  // Outlives the frame, like FaceDetectionResult::faces
+
+    const auto run_frame = [&arena, &kept](int count) {
+      std::pmr::vector<int> scratch(arena.Resource());
+      for (int i = 0; i < count; ++i) {
+        scratch.push_back(i);
+      }
+      kept.assign(scratch.begin(), scratch.end());
+      arena.Reset();
+    };
+
+    run_frame(200);
+
+    const size_t allocations = client::test::CountAllocations([&run_frame]() {
+      for (int frame = 0; frame < 10; ++frame) {
+        run_frame(50 + frame * 15);
+      }
+    });
+
+    CHECK_EQ(allocations, 0U);
+    CHECK_EQ(kept.size(), 185U);
+    CHECK_EQ(arena.Stats().growths, 1U);
+  }
+
+  TEST_CASE("CountingResource: forwards and counts") {
+    client::utils::CountingResource counting;
+    void* ptr = counting.allocate(128, alignof(std::max_align_t));
+    CHECK_NE(ptr, nullptr);
+    counting.deallocate(ptr, 128, alignof(std::max_align_t));
+
+    CHECK_EQ(counting.Allocations(), 1U);
+    CHECK_EQ(counting.Deallocations(), 1U);
+    CHECK_EQ(counting.BytesAllocated(), 128U);
+  }
+
+}  // TEST_SUITE
@@ -0,0 +1,79 @@
+#include <doctest/doctest.h>
+
+#include <client/core/utils/latency_histogram.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+TEST_SUITE("utils::LatencyHistogram") {
+  TEST_CASE("LatencyHistogram: empty histogram") {
+    client::utils::LatencyHistogram histogram;
+    CHECK_EQ(histogram.Count(), 0U);
+    CHECK_EQ(histogram.Percentile(50.0), 0U);
+    CHECK_EQ(histogram.Min(), 0U);
+    CHECK_EQ(histogram.Max(), 0U);
+    CHECK_EQ(histogram.Mean(), doctest::Approx(0.0));
+  }
+
+  TEST_CASE("LatencyHistogram: bucket mapping is monotonic and covers values") {
+    using Histogram = client::utils::LatencyHistogram;
+
+    size_t previous = 0;
+    for (uint64_t value = 0; value < 100000; value += 7) {
+      const size_t index = Histogram::BucketIndex(value);
+      CHECK_GE(index, previous);
+      CHECK_GE(Histogram::BucketUpperBound(index), value);
+      previous = index;
+    }
+
+    CHECK_EQ(Histogram::BucketIndex(Histogram::kMaxTrackableValue), Histogram::kBucketCount - 1);
+    CHECK_EQ(Histogram::BucketIndex(UINT64_MAX), Histogram::kBucketCount - 1);
+  }
+
+  TEST_CASE("LatencyHistogram: percentiles within relative error") {
+    client::utils::LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 10000; ++value) {
+      histogram.Record(value);
+    }
+
+    CHECK_EQ(histogram.Count(), 10000U);
+    CHECK_EQ(histogram.Min(), 1U);
+    CHECK_EQ(histogram.Max(), 10000U);
+    CHECK_EQ(histogram.Mean(), doctest::Approx(5000.5));
+
+    CHECK_EQ(static_cast<double>(histogram.Percentile(50.0)), doctest::Approx(5000.0).epsilon(0.04));
+    CHECK_EQ(static_cast<double>(histogram.Percentile(95.0)), doctest::Approx(9500.0).epsilon(0.04));
+    CHECK_EQ(static_cast<double>(histogram.Percentile(99.0)), doctest::Approx(9900.0).epsilon(0.04));
+    CHECK_EQ(histogram.Percentile(100.0), 10000U);
+  }
+
+  TEST_CASE("LatencyHistogram: records durations as microseconds") {
+    client::utils::LatencyHistogram histogram;
+    histogram.Record(std::chrono::milliseconds(3));
+    histogram.Record(std::chrono::microseconds(-5));
+
+    CHECK_EQ(histogram.Count(), 2U);
+    CHECK_EQ(histogram.Max(), 3000U);
+    CHECK_EQ(histogram.Min(), 0U);
+  }
+
+  TEST_CASE("LatencyHistogram: merge and reset") {
+    client::utils::LatencyHistogram first;
+    client::utils::LatencyHistogram second;
+    first.Record(10);
+    second.Record(20);
+    second.Record(30);
+
+    first.Merge(second);
+    CHECK_EQ(first.Count(), 3U);
+    CHECK_EQ(first.Sum(), 60U);
+    CHECK_EQ(first.Min(), 10U);
+    CHECK_EQ(first.Max(), 30U);
+
+    first.Reset();
+    CHECK_EQ(first.Count(), 0U);
+    CHECK_EQ(first.Percentile(99.0), 0U);
+  }
+
+}  // TEST_SUITE
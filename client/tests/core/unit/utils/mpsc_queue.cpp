@@ -0,0 +1,91 @@
+#include <doctest/doctest.h>
+
+#include <client/core/utils/mpsc_queue.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_SUITE("utils::MpscQueue") {
+  TEST_CASE("MpscQueue: FIFO order and bounded capacity") {
+    client::utils::MpscQueue<uint32_t, 4> queue;
+    CHECK_FALSE(queue.TryPop().has_value());
+
+    for (uint32_t i = 0; i < 4; ++i) {
+      CHECK(queue.TryPush(i));
+    }
+    CHECK_FALSE(queue.TryPush(4U));
+    CHECK_EQ(queue.SizeApprox(), 4U);
+
+    // Wrapping around the ring keeps the order
+    for (uint32_t i = 0; i < 10; ++i) {
+      const auto value = queue.TryPop();
+      REQUIRE(value.has_value());
+      CHECK_EQ(*value, i);
+      CHECK(queue.TryPush(i + 4));
+    }
+    CHECK_EQ(queue.SizeApprox(), 4U);
+  }
+
+  TEST_CASE("MpscQueue: Destroys elements left in the queue") {
+    const auto tracked = std::make_shared<int>(0);
+    {
+      client::utils::MpscQueue<std::shared_ptr<int>, 8> queue;
+      CHECK(queue.TryPush(tracked));
+      CHECK(queue.TryPush(tracked));
+      CHECK_EQ(tracked.use_count(), 3);
+      CHECK(queue.TryPop().has_value());
+      CHECK_EQ(tracked.use_count(), 2);
+    }
+    CHECK_EQ(tracked.use_count(), 1);
+  }
+
+  TEST_CASE("MpscQueue: Concurrent producers lose nothing and keep their own order") {
+    constexpr size_t kProducers = 4;
+    constexpr uint32_t kPerProducer = 20000;
+    client::utils::MpscQueue<uint32_t, 64> queue;
+
+    std::atomic<bool> start{false};
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0; producer < kProducers; ++producer) {
+      producers.emplace_back([&queue, &start, producer] {
+        while (!start.load(std::memory_order_acquire)) {
+        }
+        for (uint32_t i = 0; i < kPerProducer; ++i) {
+          while (!queue.TryPush((producer << 24) | i)) {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+
+    std::array<uint32_t, kProducers> next{};
+    size_t received = 0;
+    bool ordered = true;
+    start.store(true, std::memory_order_release);
+    while (received < kProducers * kPerProducer) {
+      const auto value = queue.TryPop();
+      if (!value) {
+        std::this_thread::yield();
+        continue;
+      }
+      const uint32_t producer = *value >> 24;
+      ordered = ordered && (*value & 0xFFFFFF) == next[producer];
+      ++next[producer];
+      ++received;
+    }
+    for (auto& thread : producers) {
+      thread.join();
+    }
+
+    CHECK(ordered);
+    CHECK_FALSE(queue.TryPop().has_value());
+    for (const uint32_t count : next) {
+      CHECK_EQ(count, kPerProducer);
+    }
+  }
+}
@@ -0,0 +1,231 @@
+#include <doctest/doctest.h>
+
+#include <client/app/camera_model.hpp>
+#include <client/app/closed_loop_rig.hpp>
+#include <client/app/face_data.hpp>
+#include <client/app/frame.hpp>
+#include <client/app/gimbal_controller.hpp>
+#include <client/app/synthetic_camera.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace {
+
+using client::ClosedLoopMetrics;
+using client::ClosedLoopRig;
+using client::ClosedLoopRigConfig;
+using client::FaceDetectionResult;
+using client::GimbalPose;
+using client::TrajectoryKind;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+[[nodiscard]] ClosedLoopRigConfig StepConfig() {
+  ClosedLoopRigConfig config;
+  config.trajectory.kind = TrajectoryKind::kStep;
+  config.trajectory.amplitude = {.pan = 15.0F, .tilt = 8.0F};
+  config.trajectory.step_time = milliseconds(500);
+  config.duration = milliseconds(2000);
+  return config;
+}
+
+/// Controller that knows where the face was when the frame was exposed: only the pipeline delays it.
+[[nodiscard]] ClosedLoopRig::Controller OracleController(const ClosedLoopRigConfig& config) {
+  const client::FaceTrajectory trajectory(config.trajectory);
+  return [trajectory](const FaceDetectionResult& /*result*/, const client::Frame& frame) -> std::optional<GimbalPose> {
+    return trajectory.At(microseconds(frame.Timing().presentation_time_us));
+  };
+}
+
+}  // namespace
+
+TEST_SUITE("client::ClosedLoopRig") {
+  TEST_CASE("Closed loop: Oracle settles on a step after the pipeline latency") {
+    const auto config = StepConfig();
+    ClosedLoopRig rig(config);
+    const ClosedLoopMetrics metrics = rig.Run(OracleController(config));
+
+    // Capture, inference and the link delay the response; the gimbal then slews 17 degrees at 300 deg/s
+    const auto pipeline = config.capture_latency + config.inference_latency + config.link_latency;
+    REQUIRE(metrics.settle_time.has_value());
+    CHECK_GE(*metrics.settle_time, config.trajectory.step_time + pipeline);
+    CHECK_LE(*metrics.settle_time, config.trajectory.step_time + pipeline + milliseconds(150));
+    CHECK_LT(metrics.final_error_deg, 0.01);
+    CHECK_LT(metrics.overshoot_deg, 0.01);
+    CHECK_EQ(metrics.max_error_deg, doctest::Approx(17.0).epsilon(0.01));
+
+    CHECK_EQ(metrics.frames_captured, 61U);
+    CHECK_EQ(metrics.frames_dropped, 0U);
+    CHECK_EQ(metrics.commands_sent, metrics.detections);
+    CHECK_GT(metrics.responses, 0U);
+    CHECK_GE(metrics.mean_response_ms, 2.0 * 15.0);
+  }
+
+  TEST_CASE("Closed loop: Same configuration gives the same metrics") {
+    auto config = StepConfig();
+    config.detection_noise_px = 3.0F;
+    config.record_trace = true;
+
+    ClosedLoopRig first(config);
+    ClosedLoopRig second(config);
+    const auto a = first.Run(client::OpenLoopController());
+    const auto b = second.Run(client::OpenLoopController());
+
+    CHECK_EQ(a.rms_error_deg, b.rms_error_deg);
+    CHECK_EQ(a.overshoot_deg, b.overshoot_deg);
+    CHECK_EQ(a.commands_applied, b.commands_applied);
+    REQUIRE_EQ(a.trace.size(), b.trace.size());
+    CHECK_EQ(a.trace.back().pose, b.trace.back().pose);
+  }
+
+  TEST_CASE("Closed loop: Open-loop mapping tracks worse than the oracle") {
+    const auto config = StepConfig();
+    ClosedLoopRig rig(config);
+    const auto oracle = rig.Run(OracleController(config));
+    const auto open_loop = rig.Run(client::OpenLoopController());
+
+    // offset * 90 degrees ignores that the camera already turned, so the gimbal overshoots the face
+    CHECK_GT(open_loop.rms_error_deg, oracle.rms_error_deg);
+    CHECK_GT(open_loop.overshoot_deg, 1.0);
+  }
+
+  TEST_CASE("Closed loop: Tracking controller settles on a step without overshoot") {
+    const auto config = StepConfig();
+    ClosedLoopRig rig(config);
+    const auto tracking = rig.Run(client::TrackingController());
+    const auto open_loop = rig.Run(client::OpenLoopController());
+
+    REQUIRE(tracking.settle_time.has_value());
+    CHECK_LE(*tracking.settle_time, config.trajectory.step_time + milliseconds(150));
+    CHECK_LT(tracking.overshoot_deg, 0.5);
+    CHECK_LT(tracking.final_error_deg, 1.0);
+    CHECK_LT(tracking.rms_error_deg, open_loop.rms_error_deg / 3.0);
+  }
+
+  TEST_CASE("Closed loop: Feed-forward keeps up with a moving face") {
+    auto config = StepConfig();
+    config.trajectory.kind = TrajectoryKind::kSine;
+    config.trajectory.amplitude = {.pan = 20.0F, .tilt = 10.0F};
+    config.detection_noise_px = 2.0F;
+
+    client::GimbalControllerConfig feedback_only;
+    feedback_only.pan.kff = 0.0F;
+    feedback_only.tilt.kff = 0.0F;
+    const auto with_feed_forward = ClosedLoopRig(config).Run(client::TrackingController());
+    const auto without = ClosedLoopRig(config).Run(client::TrackingController(feedback_only));
+
+    CHECK_LT(with_feed_forward.rms_error_deg, 1.0);
+    CHECK_LT(with_feed_forward.rms_error_deg, without.rms_error_deg * 0.6);
+  }
+
+  TEST_CASE("Closed loop: Smoothing and suppression cut commands for a still face") {
+    auto config = StepConfig();
+    config.trajectory.kind = TrajectoryKind::kStatic;
+    config.trajectory.start = {.pan = 5.0F, .tilt = -3.0F};
+    config.duration = milliseconds(4000);
+    config.detection_noise_px = 3.0F;
+
+    client::GimbalControllerConfig raw;
+    raw.smoothing.reset();
+    const auto before = ClosedLoopRig(config).Run(client::TrackingController(raw));
+    const auto after = ClosedLoopRig(config).Run(client::TrackingController({}, client::CommandGateConfig{}));
+
+    // Jitter alone makes the raw controller send a MOVE for every frame
+    CHECK_EQ(before.commands_sent, before.detections);
+    CHECK_LT(after.commands_sent * 3, before.commands_sent);
+    CHECK_LT(after.rms_error_deg, before.rms_error_deg);
+    CHECK_LT(after.final_error_deg, 1.0);
+  }
+
+  TEST_CASE("Closed loop: Smoothing adds little lag to a moving face") {
+    auto config = StepConfig();
+    config.trajectory.kind = TrajectoryKind::kSine;
+    config.trajectory.amplitude = {.pan = 20.0F, .tilt = 10.0F};
+    config.duration = milliseconds(4000);
+    config.detection_noise_px = 3.0F;
+
+    client::GimbalControllerConfig raw;
+    raw.smoothing.reset();
+    const auto before = ClosedLoopRig(config).Run(client::TrackingController(raw));
+    const auto after = ClosedLoopRig(config).Run(client::TrackingController({}, client::CommandGateConfig{}));
+
+    CHECK_LT(after.rms_error_deg, before.rms_error_deg * 1.15);
+    CHECK_LE(after.commands_sent, before.commands_sent);
+  }
+
+  TEST_CASE("Closed loop: Gimbal sweep calibrates the field of view") {
+    auto config = StepConfig();
+    config.trajectory.kind = TrajectoryKind::kStatic;
+    config.trajectory.start = {.pan = 4.0F, .tilt = -3.0F};
+    config.duration = milliseconds(7000);
+    config.detection_noise_px = 0.5F;
+
+    // The app believes the camera is 45 degrees wide; the rig's camera is 60
+    const auto believed = client::CameraIntrinsics::FromFov(config.camera.width, config.camera.height, 45.0F);
+    auto calibrator = std::make_shared<client::FovCalibrator>(believed, GimbalPose{});
+    ClosedLoopRig rig(config);
+    (void)rig.Run([calibrator](const FaceDetectionResult& result, const client::Frame&) -> std::optional<GimbalPose> {
+      const auto face = result.HighestPriorityFace();
+      return calibrator->Next(face ? std::optional(face->Center()) : std::nullopt, result.capture_time);
+    });
+    REQUIRE(calibrator->Done());
+    const auto calibrated = calibrator->Solve();
+    REQUIRE(calibrated.has_value());
+    CHECK_EQ(calibrated->HorizontalFovDeg(), doctest::Approx(60.0F).epsilon(0.02));
+
+    // The wrong field of view overestimates every offset and overshoots; the calibrated one does not
+    auto step = StepConfig();
+    client::GimbalControllerConfig wrong;
+    wrong.horizontal_fov_deg = 45.0F;
+    client::GimbalControllerConfig right;
+    right.intrinsics = *calibrated;
+    const auto with_wrong = ClosedLoopRig(step).Run(client::TrackingController(wrong));
+    const auto with_calibrated = ClosedLoopRig(step).Run(client::TrackingController(right));
+    CHECK_LT(with_calibrated.overshoot_deg, 0.5);
+    CHECK_LT(with_calibrated.overshoot_deg, with_wrong.overshoot_deg);
+    CHECK_LT(with_calibrated.rms_error_deg, with_wrong.rms_error_deg);
+  }
+
+  TEST_CASE("Closed loop: Link latency increases tracking error") {
+    auto config = StepConfig();
+    config.trajectory.kind = TrajectoryKind::kSine;
+    config.trajectory.amplitude = {.pan = 20.0F, .tilt = 10.0F};
+
+    config.link_latency = milliseconds(5);
+    const auto fast = ClosedLoopRig(config).Run(OracleController(config));
+    config.link_latency = milliseconds(80);
+    const auto slow = ClosedLoopRig(config).Run(OracleController(config));
+
+    CHECK_GT(slow.rms_error_deg, fast.rms_error_deg);
+    CHECK_GT(slow.mean_response_ms, fast.mean_response_ms);
+  }
+
+  TEST_CASE("Closed loop: Slow link coalesces MOVEs") {
+    auto config = StepConfig();
+    config.link_bytes_per_second = 100;
+    const auto metrics = ClosedLoopRig(config).Run(OracleController(config));
+
+    CHECK_GT(metrics.commands_applied, 0U);
+    CHECK_LT(metrics.commands_applied, metrics.commands_sent);
+  }
+
+  TEST_CASE("Closed loop: Frames and detector are pluggable") {
+    const auto config = StepConfig();
+    ClosedLoopRig rig(config);
+    uint64_t frames = 0;
+    rig.SetFrameCallback([&frames, width = config.camera.width](const client::Frame& frame) {
+      CHECK_EQ(frame.Width(), width);
+      ++frames;
+    });
+    rig.SetDetector([](const client::Frame&) { return FaceDetectionResult{}; });
+
+    const auto metrics = rig.Run(client::OpenLoopController());
+    CHECK_GT(frames, 0U);
+    CHECK_GT(metrics.detections, 0U);
+    CHECK_EQ(metrics.commands_sent, 0U);
+    CHECK_FALSE(metrics.settle_time.has_value());
+  }
+}
@@ -0,0 +1,151 @@
+#include <doctest/doctest.h>
+
+#include <client/app/camera_model.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <optional>
+
+namespace {
+
+using client::CameraIntrinsics;
+using client::CameraModel;
+using client::FovCalibrationError;
+using client::FovCalibrator;
+using client::GimbalPose;
+using client::Point2D;
+using std::chrono::milliseconds;
+
+constexpr float kRadToDeg = 180.0F / std::numbers::pi_v<float>;
+
+const FovCalibrator::Clock::time_point kStart = FovCalibrator::Clock::time_point(std::chrono::seconds(10));
+
+/// Where a camera with the given intrinsics, on a gimbal at pose, sees a feature at direction.
+[[nodiscard]] Point2D Observe(const CameraIntrinsics& intrinsics, GimbalPose direction, GimbalPose pose) {
+  return CameraModel(intrinsics).Project({.pan = direction.pan - pose.pan, .tilt = direction.tilt - pose.tilt});
+}
+
+}  // namespace
+
+TEST_SUITE("client::CameraModel") {
+  TEST_CASE("CameraIntrinsics: Derives focal lengths from the field of view") {
+    const CameraIntrinsics intrinsics = CameraIntrinsics::FromFov(640, 480, 90.0F);
+    CHECK_EQ(intrinsics.fx, doctest::Approx(320.0F));
+    CHECK_EQ(intrinsics.fy, doctest::Approx(320.0F));
+    CHECK_EQ(intrinsics.cx, doctest::Approx(320.0F));
+    CHECK_EQ(intrinsics.cy, doctest::Approx(240.0F));
+    CHECK_EQ(intrinsics.HorizontalFovDeg(), doctest::Approx(90.0F));
+    CHECK_EQ(intrinsics.VerticalFovDeg(), doctest::Approx(2.0F * std::atan(0.75F) * kRadToDeg));
+    CHECK(intrinsics.Valid());
+    CHECK_FALSE(CameraIntrinsics{}.Valid());
+  }
+
+  TEST_CASE("CameraIntrinsics: Scaling keeps the field of view") {
+    const CameraIntrinsics intrinsics{.width = 1280, .height = 720, .fx = 900.0F, .fy = 905.0F, .cx = 650.0F,
+                                      .cy = 350.0F, .k1 = -0.1F};
+    const CameraIntrinsics scaled = intrinsics.ScaledTo(640, 360);
+    CHECK_EQ(scaled.fx, doctest::Approx(450.0F));
+    CHECK_EQ(scaled.fy, doctest::Approx(452.5F));
+    CHECK_EQ(scaled.cx, doctest::Approx(325.0F));
+    CHECK_EQ(scaled.cy, doctest::Approx(175.0F));
+    CHECK_EQ(scaled.k1, doctest::Approx(-0.1F));
+    CHECK_EQ(scaled.HorizontalFovDeg(), doctest::Approx(intrinsics.HorizontalFovDeg()));
+  }
+
+  TEST_CASE("CameraModel: Table lookups match the exact angles") {
+    const CameraIntrinsics intrinsics{.width = 640, .height = 480, .fx = 500.0F, .fy = 520.0F, .cx = 330.0F,
+                                      .cy = 236.0F};
+    const CameraModel model(intrinsics);
+    for (const Point2D pixel : {Point2D{.x = 0.0F, .y = 0.0F}, Point2D{.x = 123.4F, .y = 456.7F},
+                                Point2D{.x = 639.9F, .y = 240.5F}, Point2D{.x = -50.0F, .y = 700.0F}}) {
+      const GimbalPose angles = model.Angles(pixel);
+      CHECK_EQ(angles.pan, doctest::Approx(std::atan((pixel.x - 330.0F) / 500.0F) * kRadToDeg).epsilon(1e-4));
+      CHECK_EQ(angles.tilt, doctest::Approx(std::atan((pixel.y - 236.0F) / 520.0F) * kRadToDeg).epsilon(1e-4));
+    }
+  }
+
+  TEST_CASE("CameraModel: Projection and undistortion invert each other") {
+    CameraIntrinsics intrinsics = CameraIntrinsics::FromFov(640, 480, 70.0F);
+    intrinsics.k1 = -0.15F;
+    intrinsics.k2 = 0.02F;
+    const CameraModel model(intrinsics);
+
+    const GimbalPose offset{.pan = 25.0F, .tilt = -15.0F};
+    const Point2D distorted = model.Project(offset);
+    // Barrel distortion pulls the corner towards the center
+    CHECK_LT(distorted.x - intrinsics.cx, intrinsics.fx * std::tan(25.0F / kRadToDeg));
+
+    const GimbalPose angles = model.Angles(distorted);
+    CHECK_EQ(angles.pan, doctest::Approx(offset.pan).epsilon(1e-3));
+    CHECK_EQ(angles.tilt, doctest::Approx(offset.tilt).epsilon(1e-3));
+  }
+
+  TEST_CASE("FovCalibrator: Recovers the focal lengths from a sweep") {
+    CameraIntrinsics truth = CameraIntrinsics::FromFov(640, 480, 62.0F);
+    truth.fy *= 1.02F;
+    const GimbalPose face{.pan = 3.0F, .tilt = -2.0F};
+
+    // Start from a badly wrong field of view
+    FovCalibrator calibrator(CameraIntrinsics::FromFov(640, 480, 45.0F), {});
+    for (const GimbalPose& pose : calibrator.Plan()) {
+      calibrator.AddObservation(pose, Observe(truth, face, pose));
+    }
+    const auto calibrated = calibrator.Solve();
+    REQUIRE(calibrated.has_value());
+    CHECK_EQ(calibrated->fx, doctest::Approx(truth.fx).epsilon(1e-3));
+    CHECK_EQ(calibrated->fy, doctest::Approx(truth.fy).epsilon(1e-3));
+    CHECK_EQ(calibrated->HorizontalFovDeg(), doctest::Approx(62.0F).epsilon(1e-3));
+  }
+
+  TEST_CASE("FovCalibrator: Waits for the gimbal to settle at each pose") {
+    const CameraIntrinsics truth = CameraIntrinsics::FromFov(640, 480, 60.0F);
+    client::FovCalibrationConfig config;
+    config.steps = 2;
+    config.settle = milliseconds(300);
+    FovCalibrator calibrator(truth, {.pan = 5.0F, .tilt = 0.0F}, config);
+    REQUIRE_EQ(calibrator.Plan().size(), 9U);
+
+    const Point2D feature{.x = 300.0F, .y = 200.0F};
+    CHECK_EQ(calibrator.Next(feature, kStart), (GimbalPose{.pan = 5.0F, .tilt = 0.0F}));
+    CHECK_EQ(calibrator.Next(feature, kStart + milliseconds(200)), (GimbalPose{.pan = 5.0F, .tilt = 0.0F}));
+    // Settled, but the feature was not found
+    CHECK_EQ(calibrator.Next(std::nullopt, kStart + milliseconds(300)), (GimbalPose{.pan = 5.0F, .tilt = 0.0F}));
+    CHECK_EQ(calibrator.Observations(), 0U);
+    CHECK_EQ(calibrator.Next(feature, kStart + milliseconds(333)), (GimbalPose{.pan = -5.0F, .tilt = 0.0F}));
+    CHECK_EQ(calibrator.Observations(), 1U);
+
+    auto time = kStart + milliseconds(333);
+    std::optional<GimbalPose> pose = calibrator.Plan()[1];
+    while (pose) {
+      time += milliseconds(300);
+      pose = calibrator.Next(feature, time);
+    }
+    CHECK(calibrator.Done());
+    CHECK_EQ(calibrator.Observations(), 9U);
+    CHECK_FALSE(calibrator.Next(feature, time + milliseconds(300)).has_value());
+  }
+
+  TEST_CASE("FovCalibrator: Rejects sweeps that cannot determine the focal length") {
+    const CameraIntrinsics intrinsics = CameraIntrinsics::FromFov(640, 480, 60.0F);
+
+    FovCalibrator too_few(intrinsics, {});
+    too_few.AddObservation({}, {.x = 320.0F, .y = 240.0F});
+    too_few.AddObservation({.pan = 5.0F, .tilt = 0.0F}, {.x = 270.0F, .y = 240.0F});
+    CHECK_EQ(too_few.Solve().error(), FovCalibrationError::kTooFewObservations);
+
+    // The feature moved with the camera, e.g. a mark on the lens
+    FovCalibrator static_feature(intrinsics, {});
+    for (const GimbalPose& pose : static_feature.Plan()) {
+      static_feature.AddObservation(pose, {.x = 320.0F, .y = 240.0F});
+    }
+    CHECK_EQ(static_feature.Solve().error(), FovCalibrationError::kNoDisplacement);
+
+    // Displacements far larger than any real lens produces for the sweep
+    FovCalibrator wide(intrinsics, {});
+    for (const GimbalPose& pose : wide.Plan()) {
+      wide.AddObservation(pose, Observe(CameraIntrinsics::FromFov(640, 480, 8.0F), {}, pose));
+    }
+    CHECK_EQ(wide.Solve().error(), FovCalibrationError::kImplausible);
+  }
+}
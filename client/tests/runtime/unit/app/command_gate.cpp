@@ -0,0 +1,71 @@
+#include <doctest/doctest.h>
+
+#include <client/app/command_gate.hpp>
+
+#include <chrono>
+
+namespace {
+
+using client::CommandGate;
+using client::GimbalPose;
+using std::chrono::milliseconds;
+
+const CommandGate::Clock::time_point kStart = CommandGate::Clock::time_point(std::chrono::seconds(10));
+
+}  // namespace
+
+TEST_SUITE("client::CommandGate") {
+  TEST_CASE("CommandGate: Suppresses targets that barely moved") {
+    CommandGate gate({.min_change_deg = 0.5F, .keyframe_interval = milliseconds(0)});
+
+    CHECK(gate.ShouldSend({.pan = 10.0F, .tilt = 5.0F}, kStart));
+    CHECK_FALSE(gate.ShouldSend({.pan = 10.3F, .tilt = 4.8F}, kStart + milliseconds(33)));
+    // Compared with the last target sent, not the last one seen, so slow drift still gets through
+    CHECK(gate.ShouldSend({.pan = 10.6F, .tilt = 4.8F}, kStart + milliseconds(66)));
+    CHECK(gate.ShouldSend({.pan = 10.6F, .tilt = 5.5F}, kStart + milliseconds(99)));
+
+    CHECK_EQ(gate.Suppressed(), 1U);
+    CHECK_EQ(gate.LastSent(), (GimbalPose{.pan = 10.6F, .tilt = 5.5F}));
+  }
+
+  TEST_CASE("CommandGate: Sends a keyframe when the interval has passed") {
+    CommandGate gate({.min_change_deg = 0.5F, .keyframe_interval = milliseconds(500)});
+
+    CHECK(gate.ShouldSend({}, kStart));
+    CHECK_FALSE(gate.ShouldSend({}, kStart + milliseconds(499)));
+    CHECK(gate.ShouldSend({}, kStart + milliseconds(500)));
+    CHECK_FALSE(gate.ShouldSend({.pan = 0.1F, .tilt = 0.0F}, kStart + milliseconds(600)));
+  }
+
+  TEST_CASE("CommandGate: Compares moving targets with the device's extrapolation") {
+    CommandGate gate(
+        {.min_change_deg = 0.5F, .keyframe_interval = milliseconds(0), .velocity_horizon = milliseconds(200)});
+    const GimbalPose velocity{.pan = 30.0F, .tilt = 0.0F};
+
+    CHECK(gate.ShouldSend({.pan = 0.0F, .tilt = 0.0F}, velocity, kStart));
+    // 3 degrees on, but where the device has extrapolated to
+    CHECK_FALSE(gate.ShouldSend({.pan = 3.0F, .tilt = 0.0F}, velocity, kStart + milliseconds(100)));
+    CHECK_FALSE(gate.ShouldSend({.pan = 5.8F, .tilt = 0.2F}, velocity, kStart + milliseconds(200)));
+    // The device holds still past the horizon
+    CHECK(gate.ShouldSend({.pan = 9.0F, .tilt = 0.0F}, velocity, kStart + milliseconds(300)));
+    // A target that stopped diverges from the extrapolation
+    CHECK_FALSE(gate.ShouldSend({.pan = 9.3F, .tilt = 0.0F}, {}, kStart + milliseconds(310)));
+    CHECK(gate.ShouldSend({.pan = 9.3F, .tilt = 0.0F}, {}, kStart + milliseconds(333)));
+    CHECK_EQ(gate.Suppressed(), 3U);
+
+    // Without a horizon velocities are ignored
+    CommandGate position_only({.min_change_deg = 0.5F, .keyframe_interval = milliseconds(0)});
+    CHECK(position_only.ShouldSend({}, velocity, kStart));
+    CHECK(position_only.ShouldSend({.pan = 3.0F, .tilt = 0.0F}, velocity, kStart + milliseconds(100)));
+  }
+
+  TEST_CASE("CommandGate: Reset passes the next target") {
+    CommandGate gate;
+    CHECK(gate.ShouldSend({}, kStart));
+    CHECK_FALSE(gate.ShouldSend({}, kStart + milliseconds(33)));
+
+    gate.Reset();
+    CHECK_FALSE(gate.LastSent().has_value());
+    CHECK(gate.ShouldSend({}, kStart + milliseconds(66)));
+  }
+}
@@ -211,6 +211,18 @@ TEST_SUITE("client::BoundingBox") {
   }
 }
 
+TEST_SUITE("client::NormalizedOffset") {
+  TEST_CASE("NormalizedOffset: Center and edges") {
+    CHECK_EQ(client::NormalizedOffset({320.0F, 240.0F}, 640, 480), (client::Point2D{0.0F, 0.0F}));
+    CHECK_EQ(client::NormalizedOffset({640.0F, 0.0F}, 640, 480), (client::Point2D{1.0F, -1.0F}));
+    CHECK_EQ(client::NormalizedOffset({160.0F, 360.0F}, 640, 480), (client::Point2D{-0.5F, 0.5F}));
+  }
+
+  TEST_CASE("NormalizedOffset: Empty frame is centered") {
+    CHECK_EQ(client::NormalizedOffset({10.0F, 10.0F}, 0, 480), (client::Point2D{}));
+  }
+}
+
 TEST_SUITE("client::FaceData") {
   TEST_CASE("FaceData: Default construction") {
     client::FaceData face;
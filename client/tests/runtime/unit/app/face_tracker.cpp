@@ -74,6 +74,21 @@ TEST_SUITE("client::FaceTracker") {
     CHECK_EQ(result.error(), client::FaceTrackerError::kNotInitialized);
   }
 
+  TEST_CASE("FaceTracker: Detect into a result clears its faces but keeps their storage") {
+    client::FaceTracker tracker;
+    client::Frame frame(100, 100, CV_8UC3);
+    client::FaceDetectionResult result;
+    result.faces.resize(8);
+    const auto capacity = result.faces.capacity();
+
+    const auto detected = tracker.Detect(frame, result);
+
+    CHECK_FALSE(detected.has_value());
+    CHECK_EQ(detected.error(), client::FaceTrackerError::kNotInitialized);
+    CHECK(result.faces.empty());
+    CHECK_EQ(result.faces.capacity(), capacity);
+  }
+
   TEST_CASE("FaceTracker: Config getter returns current config") {
     client::FaceTracker tracker;
     client::FaceTrackerConfig config;
@@ -5,6 +5,9 @@
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
 
+#include <chrono>
+#include <utility>
+
 TEST_SUITE("client::Frame") {
   TEST_CASE("Frame: Default construction creates empty frame") {
     client::Frame frame;
@@ -205,4 +208,24 @@ TEST_SUITE("client::Frame") {
     CHECK(empty.Data().empty());
     CHECK_EQ(empty.TotalPixels(), 0);
   }
+
+  TEST_CASE("Frame: Timing propagates through copies") {
+    cv::Mat mat(10, 10, CV_8UC3);
+    client::Frame frame(mat);
+    const client::FrameTiming timing{
+        .presentation_time_us = 1234,
+        .arrival_time = std::chrono::steady_clock::now(),
+        .sequence = 42,
+    };
+    frame.SetTiming(timing);
+
+    const client::Frame copy(frame);
+    CHECK(copy.Timing() == timing);
+
+    const client::Frame clone = frame.Clone();
+    CHECK(clone.Timing() == timing);
+
+    client::Frame moved(std::move(frame));
+    CHECK(moved.Timing() == timing);
+  }
 }
@@ -0,0 +1,190 @@
+#include <doctest/doctest.h>
+
+#include <client/app/gimbal_controller.hpp>
+
+#include <chrono>
+#include <optional>
+
+namespace {
+
+using client::GimbalController;
+using client::GimbalControllerConfig;
+using client::GimbalPose;
+using std::chrono::milliseconds;
+
+const GimbalController::Clock::time_point kStart = GimbalController::Clock::time_point(std::chrono::seconds(10));
+
+/// Controller that takes its latest target as the camera pose, with only a proportional term.
+[[nodiscard]] GimbalControllerConfig Proportional(float kp) {
+  GimbalControllerConfig config;
+  config.pan.kp = kp;
+  config.tilt.kp = kp;
+  config.pan.kff = 0.0F;
+  config.tilt.kff = 0.0F;
+  config.actuation_delay = milliseconds(0);
+  config.gimbal_slew_deg_per_s = 0.0F;
+  config.smoothing.reset();
+  return config;
+}
+
+}  // namespace
+
+TEST_SUITE("client::GimbalController") {
+  TEST_CASE("GimbalController: Converts pixels to angles through the field of view") {
+    GimbalControllerConfig config;
+    config.horizontal_fov_deg = 90.0F;
+    const GimbalController controller(config);
+
+    const GimbalPose center = controller.AngularOffset({.x = 320.0F, .y = 240.0F}, 640, 480);
+    CHECK_EQ(center.pan, doctest::Approx(0.0F));
+    CHECK_EQ(center.tilt, doctest::Approx(0.0F));
+
+    const GimbalPose corner = controller.AngularOffset({.x = 640.0F, .y = 560.0F}, 640, 480);
+    CHECK_EQ(corner.pan, doctest::Approx(45.0F));
+    CHECK_EQ(corner.tilt, doctest::Approx(45.0F));
+
+    CHECK_EQ(controller.AngularOffset({.x = 10.0F, .y = 10.0F}, 0, 0), (GimbalPose{}));
+  }
+
+  TEST_CASE("GimbalController: Uses calibrated intrinsics scaled to the frame") {
+    GimbalControllerConfig config;
+    config.intrinsics = client::CameraIntrinsics{.width = 1280, .height = 960, .fx = 1000.0F, .fy = 1000.0F,
+                                                 .cx = 600.0F, .cy = 480.0F};
+    GimbalController controller(config);
+
+    // At half resolution the principal point is (300, 240) and the focal length 500
+    const GimbalPose principal = controller.AngularOffset({.x = 300.0F, .y = 240.0F}, 640, 480);
+    CHECK_EQ(principal.pan, doctest::Approx(0.0F));
+    CHECK_EQ(controller.AngularOffset({.x = 800.0F, .y = 240.0F}, 640, 480).pan, doctest::Approx(45.0F));
+    CHECK_EQ(controller.IntrinsicsFor(640, 480).fx, doctest::Approx(500.0F));
+
+    controller.SetIntrinsics(std::nullopt);
+    CHECK_EQ(controller.AngularOffset({.x = 320.0F, .y = 240.0F}, 640, 480).pan, doctest::Approx(0.0F));
+  }
+
+  TEST_CASE("GimbalController: Integrates the relative error into the absolute target") {
+    GimbalController controller(Proportional(0.5F));
+
+    // The face sits at (20, -8); each frame sees it relative to where the last target pointed the camera
+    const GimbalPose face{.pan = 20.0F, .tilt = -8.0F};
+    GimbalPose target;
+    for (int i = 0; i < 3; ++i) {
+      target = controller.Update({.pan = face.pan - target.pan, .tilt = face.tilt - target.tilt},
+                                 kStart + milliseconds(33 * i));
+    }
+    CHECK_EQ(target.pan, doctest::Approx(17.5F));
+    CHECK_EQ(target.tilt, doctest::Approx(-7.0F));
+    CHECK_EQ(controller.Target(), target);
+  }
+
+  TEST_CASE("GimbalController: Does not count an error twice before the gimbal has moved") {
+    GimbalControllerConfig config = Proportional(1.0F);
+    config.actuation_delay = milliseconds(60);
+    GimbalController controller(config);
+
+    CHECK_EQ(controller.Update({.pan = 10.0F, .tilt = 0.0F}, kStart).pan, doctest::Approx(10.0F));
+    // The next frame was exposed before the first target reached the gimbal and shows the same offset
+    CHECK_EQ(controller.Update({.pan = 10.0F, .tilt = 0.0F}, kStart + milliseconds(33)).pan, doctest::Approx(10.0F));
+    // Once the gimbal has followed, the face is centered
+    CHECK_EQ(controller.Update({.pan = 0.0F, .tilt = 0.0F}, kStart + milliseconds(66)).pan, doctest::Approx(10.0F));
+  }
+
+  TEST_CASE("GimbalController: Accounts for the gimbal still slewing") {
+    GimbalControllerConfig config = Proportional(1.0F);
+    config.actuation_delay = milliseconds(60);
+    config.gimbal_slew_deg_per_s = 100.0F;
+    config.max_slew_deg_per_s = 1000.0F;
+    GimbalController controller(config);
+
+    (void)controller.Update({.pan = 30.0F, .tilt = 0.0F}, kStart);
+    // 40 ms after the target took effect the gimbal has turned 4 degrees, so the face appears 26 degrees off
+    const GimbalPose target = controller.Update({.pan = 26.0F, .tilt = 0.0F}, kStart + milliseconds(100));
+    CHECK_EQ(target.pan, doctest::Approx(30.0F));
+  }
+
+  TEST_CASE("GimbalController: Ignores errors within the deadband") {
+    GimbalControllerConfig config = Proportional(1.0F);
+    config.deadband_deg = 1.0F;
+    GimbalController controller(config);
+
+    CHECK_EQ(controller.Update({.pan = 0.8F, .tilt = -0.9F}, kStart), (GimbalPose{}));
+    CHECK_EQ(controller.Update({.pan = 1.5F, .tilt = 0.0F}, kStart + milliseconds(33)).pan, doctest::Approx(1.5F));
+  }
+
+  TEST_CASE("GimbalController: Limits how fast the target moves") {
+    GimbalControllerConfig config = Proportional(1.0F);
+    config.max_slew_deg_per_s = 60.0F;
+    config.nominal_period = milliseconds(100);
+    GimbalController controller(config);
+
+    const GimbalPose first = controller.Update({.pan = 40.0F, .tilt = -40.0F}, kStart);
+    CHECK_EQ(first.pan, doctest::Approx(6.0F));
+    CHECK_EQ(first.tilt, doctest::Approx(-6.0F));
+    const GimbalPose second = controller.Update({.pan = 34.0F, .tilt = 0.0F}, kStart + milliseconds(50));
+    CHECK_EQ(second.pan, doctest::Approx(9.0F));
+  }
+
+  TEST_CASE("GimbalController: Stays within the servo range without winding up") {
+    GimbalControllerConfig config = Proportional(1.0F);
+    config.pan.ki = 10.0F;
+    config.pan.integral_limit_deg = 20.0F;
+    GimbalController controller(config);
+
+    for (int i = 0; i < 10; ++i) {
+      CHECK_LE(controller.Update({.pan = 50.0F, .tilt = 0.0F}, kStart + milliseconds(33 * i)).pan, 90.0F);
+    }
+    CHECK_EQ(controller.Target().pan, doctest::Approx(90.0F));
+
+    // A frozen integral lets the target come back as soon as the face does
+    const GimbalPose back = controller.Update({.pan = -10.0F, .tilt = 0.0F}, kStart + milliseconds(330));
+    CHECK_LT(back.pan, 90.0F);
+  }
+
+  TEST_CASE("GimbalController: Feed-forward tracks a moving face ahead of the measurement") {
+    GimbalControllerConfig config = Proportional(0.7F);
+    config.pan.kff = 1.0F;
+    config.velocity_smoothing = 1.0F;
+    config.deadband_deg = 0.0F;
+    config.lead_time = milliseconds(60);
+    GimbalController controller(config);
+
+    // Face moving right at 30 deg/s, measured every 33 ms
+    GimbalPose target;
+    for (int i = 0; i < 30; ++i) {
+      const float face = 0.99F * static_cast<float>(i);
+      target = controller.Update({.pan = face - target.pan, .tilt = 0.0F}, kStart + milliseconds(33 * i));
+    }
+    CHECK_EQ(controller.Velocity().pan, doctest::Approx(30.0F));
+    CHECK_EQ(target.pan, doctest::Approx(0.99F * 29.0F + 30.0F * 0.06F).epsilon(0.01));
+  }
+
+  TEST_CASE("GimbalController: Jumps and gaps restart the velocity estimate") {
+    GimbalControllerConfig config = Proportional(1.0F);
+    config.pan.kff = 1.0F;
+    config.velocity_smoothing = 1.0F;
+    GimbalController controller(config);
+
+    (void)controller.Update({.pan = 0.0F, .tilt = 0.0F}, kStart);
+    (void)controller.Update({.pan = 1.0F, .tilt = 0.0F}, kStart + milliseconds(50));
+    CHECK_EQ(controller.Velocity().pan, doctest::Approx(20.0F));
+
+    // 20 degrees in 50 ms is faster than a face moves
+    (void)controller.Update({.pan = 20.0F, .tilt = 0.0F}, kStart + milliseconds(100));
+    CHECK_EQ(controller.Velocity().pan, doctest::Approx(0.0F));
+
+    (void)controller.Update({.pan = 1.0F, .tilt = 0.0F}, kStart + milliseconds(150));
+    CHECK_NE(controller.Velocity().pan, doctest::Approx(0.0F));
+    (void)controller.Update({.pan = 1.0F, .tilt = 0.0F}, kStart + std::chrono::seconds(2));
+    CHECK_EQ(controller.Velocity().pan, doctest::Approx(0.0F));
+  }
+
+  TEST_CASE("GimbalController: Reset restarts from the given target") {
+    GimbalController controller(Proportional(1.0F));
+    (void)controller.Update({.pan = 15.0F, .tilt = 5.0F}, kStart);
+
+    controller.Reset({.pan = -10.0F, .tilt = 2.0F});
+    CHECK_EQ(controller.Target(), (GimbalPose{.pan = -10.0F, .tilt = 2.0F}));
+    CHECK_EQ(controller.Velocity(), (GimbalPose{}));
+    CHECK_EQ(controller.Update({.pan = 4.0F, .tilt = 0.0F}, kStart + milliseconds(33)).pan, doctest::Approx(-6.0F));
+  }
+}
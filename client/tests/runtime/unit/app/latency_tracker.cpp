@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+
+#include <client/app/latency_tracker.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+namespace {
+
+using Clock = client::LatencyTracker::Clock;
+using std::chrono::milliseconds;
+
+}  // namespace
+
+TEST_SUITE("client::LatencyTracker") {
+  TEST_CASE("LatencyStageToString: returns stage names") {
+    CHECK_EQ(client::LatencyStageToString(client::LatencyStage::kCaptureToDetect), "capture->detect");
+    CHECK_EQ(client::LatencyStageToString(client::LatencyStage::kDetectToSend), "detect->send");
+    CHECK_EQ(client::LatencyStageToString(client::LatencyStage::kSendToAck), "send->ack");
+    CHECK_EQ(client::LatencyStageToString(client::LatencyStage::kCaptureToAck), "capture->ack");
+  }
+
+  TEST_CASE("LatencyTracker: matched ack records every stage") {
+    client::LatencyTracker tracker;
+    const auto capture = Clock::now();
+    const auto detect = capture + milliseconds(20);
+    const auto send = detect + milliseconds(2);
+    const auto ack = send + milliseconds(30);
+
+    tracker.RecordDetection(capture, detect);
+    tracker.RecordSent(7, capture, detect, send);
+    CHECK(tracker.RecordAck(7, ack));
+
+    const auto snapshot = tracker.Snapshot();
+    CHECK_EQ(snapshot.Stage(client::LatencyStage::kCaptureToDetect).count, 1U);
+    CHECK_EQ(snapshot.Stage(client::LatencyStage::kCaptureToDetect).p50_ms, doctest::Approx(20.0).epsilon(0.04));
+    CHECK_EQ(snapshot.Stage(client::LatencyStage::kDetectToSend).p50_ms, doctest::Approx(2.0).epsilon(0.04));
+    CHECK_EQ(snapshot.Stage(client::LatencyStage::kSendToAck).p99_ms, doctest::Approx(30.0).epsilon(0.04));
+    CHECK_EQ(snapshot.Stage(client::LatencyStage::kCaptureToAck).p95_ms, doctest::Approx(52.0).epsilon(0.04));
+    CHECK_EQ(snapshot.unmatched_acks, 0U);
+  }
+
+  TEST_CASE("LatencyTracker: duplicate and unknown acks are unmatched") {
+    client::LatencyTracker tracker;
+    const auto now = Clock::now();
+
+    tracker.RecordSent(3, now, now, now);
+    CHECK(tracker.RecordAck(3, now + milliseconds(5)));
+    CHECK_FALSE(tracker.RecordAck(3, now + milliseconds(6)));
+    CHECK_FALSE(tracker.RecordAck(99, now));
+    CHECK_FALSE(tracker.RecordAck(0, now));
+
+    const auto snapshot = tracker.Snapshot();
+    CHECK_EQ(snapshot.Stage(client::LatencyStage::kSendToAck).count, 1U);
+    CHECK_EQ(snapshot.unmatched_acks, 3U);
+  }
+
+  TEST_CASE("LatencyTracker: reused slot counts as evicted") {
+    client::LatencyTracker tracker;
+    const auto now = Clock::now();
+
+    tracker.RecordSent(1, now, now, now);
+    tracker.RecordSent(1 + client::LatencyTracker::kMaxInFlight, now, now, now);
+
+    CHECK_FALSE(tracker.RecordAck(1, now));
+    CHECK(tracker.RecordAck(1 + client::LatencyTracker::kMaxInFlight, now));
+    CHECK_EQ(tracker.Snapshot().evicted, 1U);
+
+    tracker.Reset();
+    CHECK_EQ(tracker.Snapshot().evicted, 0U);
+    CHECK_EQ(tracker.Snapshot().Stage(client::LatencyStage::kSendToAck).count, 0U);
+  }
+
+}  // TEST_SUITE
@@ -0,0 +1,71 @@
+#include <doctest/doctest.h>
+
+#include <client/app/metrics_server.hpp>
+#include <client/core/metrics.hpp>
+
+#include <string>
+
+TEST_SUITE("client::MetricsServer") {
+  TEST_CASE("MetricsServerErrorToString: returns error names") {
+    CHECK_EQ(client::MetricsServerErrorToString(client::MetricsServerError::kNotConfigured),
+             "Metrics endpoint not configured");
+    CHECK_EQ(client::MetricsServerErrorToString(client::MetricsServerError::kAlreadyRunning),
+             "Metrics endpoint already running");
+    CHECK_EQ(client::MetricsServerErrorToString(client::MetricsServerError::kListenFailed),
+             "Failed to listen for metrics scrapes");
+  }
+
+  TEST_CASE("MetricsServerConfig: disabled by default") {
+    client::MetricsServerConfig config;
+    CHECK_FALSE(config.Enabled());
+
+    config.port = 9464;
+    CHECK(config.Enabled());
+
+    config.port = 0;
+    config.socket_path = "/tmp/client-metrics.sock";
+    CHECK(config.Enabled());
+  }
+
+  TEST_CASE("MetricsServer: Start without configuration fails") {
+    client::metrics::Registry registry;
+    client::MetricsServer server(registry);
+
+    const auto result = server.Start({});
+    REQUIRE_FALSE(result.has_value());
+    CHECK_EQ(result.error(), client::MetricsServerError::kNotConfigured);
+    CHECK_FALSE(server.Running());
+    CHECK_EQ(server.Port(), 0);
+  }
+
+  TEST_CASE("MetricsServer: GET /metrics returns exposition") {
+    client::metrics::Registry registry;
+    client::metrics::Counter frames;
+    frames.Increment(3);
+    REQUIRE(registry.Register("client_frames_processed_total", "Frames", frames).has_value());
+
+    const std::string response = client::MetricsServer::BuildResponse("GET /metrics HTTP/1.1", registry);
+    const std::string body = registry.Expose();
+
+    CHECK(response.starts_with("HTTP/1.0 200 OK\r\n"));
+    CHECK_NE(response.find("Content-Type: text/plain; version=0.0.4"), std::string::npos);
+    CHECK_NE(response.find("Content-Length: " + std::to_string(body.size()) + "\r\n"), std::string::npos);
+    CHECK(response.ends_with("\r\n\r\n" + body));
+    CHECK_NE(response.find("client_frames_processed_total 3\n"), std::string::npos);
+  }
+
+  TEST_CASE("MetricsServer: query string is ignored") {
+    client::metrics::Registry registry;
+    const std::string response = client::MetricsServer::BuildResponse("GET /metrics?name=x HTTP/1.1", registry);
+    CHECK(response.starts_with("HTTP/1.0 200 OK\r\n"));
+  }
+
+  TEST_CASE("MetricsServer: rejects other requests") {
+    client::metrics::Registry registry;
+    CHECK(client::MetricsServer::BuildResponse("GET /other HTTP/1.1", registry).starts_with("HTTP/1.0 404"));
+    CHECK(client::MetricsServer::BuildResponse("POST /metrics HTTP/1.1", registry).starts_with("HTTP/1.0 405"));
+    CHECK(client::MetricsServer::BuildResponse("", registry).starts_with("HTTP/1.0 400"));
+    CHECK(client::MetricsServer::BuildResponse("garbage", registry).starts_with("HTTP/1.0 400"));
+  }
+
+}  // TEST_SUITE
@@ -0,0 +1,64 @@
+#include <doctest/doctest.h>
+
+#include <client/app/one_euro_filter.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using client::OneEuroConfig;
+using client::OneEuroFilter;
+
+constexpr float kDt = 1.0F / 30.0F;
+
+}  // namespace
+
+TEST_SUITE("client::OneEuroFilter") {
+  TEST_CASE("OneEuroFilter: Passes the first sample through") {
+    OneEuroFilter filter;
+    CHECK_EQ(filter.Value(), doctest::Approx(0.0F));
+    CHECK_EQ(filter.Filter(12.5F, kDt), doctest::Approx(12.5F));
+    CHECK_EQ(filter.Value(), doctest::Approx(12.5F));
+    CHECK_EQ(filter.Derivative(), doctest::Approx(0.0F));
+  }
+
+  TEST_CASE("OneEuroFilter: Smooths jitter on a still signal") {
+    OneEuroFilter filter({.min_cutoff_hz = 1.0F, .beta = 0.05F, .derivative_cutoff_hz = 1.0F});
+    float largest = 0.0F;
+    for (int i = 0; i < 90; ++i) {
+      const float jitter = (i % 2 == 0) ? 0.5F : -0.5F;
+      const float filtered = filter.Filter(jitter, kDt);
+      if (i > 30) {
+        largest = std::max(largest, std::abs(filtered));
+      }
+    }
+    // A 1 Hz cutoff passes about a tenth of a 15 Hz alternation
+    CHECK_LT(largest, 0.1F);
+  }
+
+  TEST_CASE("OneEuroFilter: Cutoff rises with speed to reduce lag") {
+    // Ramp at 30 units/s: a fixed 1 Hz low-pass would trail by 30 / (2 pi) ~ 4.8 units
+    OneEuroFilter adaptive({.min_cutoff_hz = 1.0F, .beta = 0.3F, .derivative_cutoff_hz = 1.0F});
+    OneEuroFilter fixed({.min_cutoff_hz = 1.0F, .beta = 0.0F, .derivative_cutoff_hz = 1.0F});
+    float ramp = 0.0F;
+    for (int i = 0; i < 120; ++i) {
+      ramp = 30.0F * kDt * static_cast<float>(i);
+      (void)adaptive.Filter(ramp, kDt);
+      (void)fixed.Filter(ramp, kDt);
+    }
+    CHECK_GE(adaptive.Derivative(), 30.0F);
+    CHECK_GT(ramp - fixed.Value(), 4.0F);
+    CHECK_LT(ramp - adaptive.Value(), 1.0F);
+  }
+
+  TEST_CASE("OneEuroFilter: Reset forgets the history") {
+    OneEuroFilter filter;
+    (void)filter.Filter(0.0F, kDt);
+    (void)filter.Filter(10.0F, kDt);
+    filter.Reset();
+    CHECK_EQ(filter.Filter(-4.0F, kDt), doctest::Approx(-4.0F));
+    // A repeated timestamp keeps the last value instead of dividing by zero
+    CHECK_EQ(filter.Filter(6.0F, 0.0F), doctest::Approx(-4.0F));
+  }
+}
@@ -0,0 +1,143 @@
+#include <doctest/doctest.h>
+
+#include <client/app/frame.hpp>
+#include <client/app/synthetic_camera.hpp>
+
+#include <opencv2/core.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+namespace {
+
+using client::FaceTrajectory;
+using client::GimbalPose;
+using client::SyntheticCamera;
+using client::TrajectoryConfig;
+using client::TrajectoryKind;
+using std::chrono::milliseconds;
+
+constexpr float kDegToRad = std::numbers::pi_v<float> / 180.0F;
+
+}  // namespace
+
+TEST_SUITE("client::FaceTrajectory") {
+  TEST_CASE("TrajectoryKindToString: returns kind names") {
+    CHECK_EQ(client::TrajectoryKindToString(TrajectoryKind::kStatic), "static");
+    CHECK_EQ(client::TrajectoryKindToString(TrajectoryKind::kStep), "step");
+    CHECK_EQ(client::TrajectoryKindToString(TrajectoryKind::kRamp), "ramp");
+    CHECK_EQ(client::TrajectoryKindToString(TrajectoryKind::kSine), "sine");
+    CHECK_EQ(client::TrajectoryKindToString(TrajectoryKind::kFigureEight), "figure-eight");
+  }
+
+  TEST_CASE("FaceTrajectory: Step jumps by the amplitude at the step time") {
+    TrajectoryConfig config;
+    config.kind = TrajectoryKind::kStep;
+    config.start = {.pan = 5.0F, .tilt = 0.0F};
+    config.amplitude = {.pan = 10.0F, .tilt = -4.0F};
+    config.step_time = milliseconds(500);
+    const FaceTrajectory trajectory(config);
+
+    CHECK_EQ(trajectory.At(milliseconds(499)), config.start);
+    CHECK_EQ(trajectory.At(milliseconds(500)), (GimbalPose{.pan = 15.0F, .tilt = -4.0F}));
+  }
+
+  TEST_CASE("FaceTrajectory: Ramp moves at the configured velocity") {
+    TrajectoryConfig config;
+    config.kind = TrajectoryKind::kRamp;
+    config.velocity = {.pan = 10.0F, .tilt = -2.0F};
+    const FaceTrajectory trajectory(config);
+
+    const GimbalPose pose = trajectory.At(milliseconds(1500));
+    CHECK_EQ(pose.pan, doctest::Approx(15.0F));
+    CHECK_EQ(pose.tilt, doctest::Approx(-3.0F));
+  }
+
+  TEST_CASE("FaceTrajectory: Sine and figure eight peak at the amplitude") {
+    TrajectoryConfig config;
+    config.kind = TrajectoryKind::kSine;
+    config.amplitude = {.pan = 20.0F, .tilt = 10.0F};
+    config.period = milliseconds(4000);
+    const GimbalPose sine = FaceTrajectory(config).At(milliseconds(1000));
+    CHECK_EQ(sine.pan, doctest::Approx(20.0F));
+    CHECK_EQ(sine.tilt, doctest::Approx(10.0F));
+
+    config.kind = TrajectoryKind::kFigureEight;
+    const FaceTrajectory eight(config);
+    CHECK_EQ(eight.At(milliseconds(1000)).pan, doctest::Approx(20.0F));
+    CHECK_EQ(eight.At(milliseconds(1000)).tilt, doctest::Approx(0.0F).epsilon(1e-4));
+    CHECK_EQ(eight.At(milliseconds(500)).tilt, doctest::Approx(10.0F));
+  }
+}
+
+TEST_SUITE("client::SyntheticCamera") {
+  TEST_CASE("SyntheticCamera: Focal length follows the field of view") {
+    const SyntheticCamera camera({.width = 640, .height = 480, .horizontal_fov_deg = 90.0F});
+    CHECK_EQ(camera.FocalLength(), doctest::Approx(320.0F));
+  }
+
+  TEST_CASE("SyntheticCamera: A face the gimbal points at is centered") {
+    const SyntheticCamera camera;
+    const auto box = camera.Project({.pan = 12.0F, .tilt = -6.0F}, {.pan = 12.0F, .tilt = -6.0F});
+    REQUIRE(box.has_value());
+    CHECK_EQ(box->Center().x, doctest::Approx(320.0F));
+    CHECK_EQ(box->Center().y, doctest::Approx(240.0F));
+  }
+
+  TEST_CASE("SyntheticCamera: Offsets project through the pinhole") {
+    const SyntheticCamera camera;
+    const auto box = camera.Project({.pan = 10.0F, .tilt = 5.0F}, {});
+    REQUIRE(box.has_value());
+
+    // Right of and below the center, at f * tan(angle) of the face edges
+    const float f = camera.FocalLength();
+    CHECK_EQ(box->x, doctest::Approx(320.0F + f * std::tan(4.0F * kDegToRad)));
+    CHECK_EQ(box->x + box->width, doctest::Approx(320.0F + f * std::tan(16.0F * kDegToRad)));
+    CHECK_EQ(box->y, doctest::Approx(240.0F + f * std::tan(-2.5F * kDegToRad)));
+    CHECK_GT(box->Center().x, 320.0F);
+    CHECK_GT(box->Center().y, 240.0F);
+  }
+
+  TEST_CASE("SyntheticCamera: Faces outside the view are not projected") {
+    const SyntheticCamera camera;
+    CHECK_FALSE(camera.Project({.pan = 60.0F, .tilt = 0.0F}, {}).has_value());
+    CHECK_FALSE(camera.Project({.pan = 0.0F, .tilt = 0.0F}, {.pan = 0.0F, .tilt = 89.0F}).has_value());
+  }
+
+  TEST_CASE("SyntheticCamera: A face at the edge is clipped to the frame") {
+    const SyntheticCamera camera;
+    const auto box = camera.Project({.pan = 30.0F, .tilt = 0.0F}, {});
+    REQUIRE(box.has_value());
+    CHECK_EQ(box->x + box->width, doctest::Approx(640.0F));
+    CHECK_LT(box->x, 640.0F);
+  }
+
+  TEST_CASE("SyntheticCamera: Render draws the face inside its box") {
+    const SyntheticCamera camera;
+    const client::Frame frame = camera.Render({.pan = 10.0F, .tilt = 0.0F}, {}, {});
+    const auto box = camera.Project({.pan = 10.0F, .tilt = 0.0F}, {});
+    REQUIRE(box.has_value());
+
+    const auto center = box->Center();
+    const auto& mat = frame.Mat();
+    CHECK_NE(mat.at<cv::Vec3b>(static_cast<int>(center.y), static_cast<int>(center.x)), mat.at<cv::Vec3b>(5, 5));
+    CHECK_EQ(mat.at<cv::Vec3b>(static_cast<int>(center.y), 5), mat.at<cv::Vec3b>(5, 5));
+  }
+
+  TEST_CASE("SyntheticCamera: Capture delivers a timed frame to the callback") {
+    SyntheticCamera camera;
+    client::Frame captured;
+    camera.SetFrameCallback([&captured](const client::Frame& frame) { captured = frame; });
+
+    client::FrameTiming timing;
+    timing.presentation_time_us = 33'333;
+    timing.sequence = 2;
+    camera.Capture({.pan = 5.0F, .tilt = 0.0F}, {}, timing);
+
+    CHECK_EQ(captured.Width(), 640);
+    CHECK_EQ(captured.Height(), 480);
+    CHECK_EQ(captured.Channels(), 3);
+    CHECK_EQ(captured.Timing(), timing);
+  }
+}
@@ -0,0 +1,122 @@
+#include <doctest/doctest.h>
+
+#include <client/app/virtual_gimbal.hpp>
+#include <client/comm/link_session.hpp>
+#include <client/comm/loopback_transport.hpp>
+#include <client/comm/protocol.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace {
+
+using client::GimbalPose;
+using client::VirtualGimbal;
+using client::VirtualGimbalConfig;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+[[nodiscard]] VirtualGimbalConfig SlowGimbal() {
+  VirtualGimbalConfig config;
+  config.slew_deg_per_s = 100.0F;
+  return config;
+}
+
+}  // namespace
+
+TEST_SUITE("client::VirtualGimbal") {
+  TEST_CASE("VirtualGimbal: Command takes effect at the next PWM period") {
+    VirtualGimbal gimbal;
+    gimbal.Command({.pan = 30.0F, .tilt = -10.0F}, milliseconds(5));
+
+    CHECK_EQ(gimbal.Commanded(), (GimbalPose{.pan = 30.0F, .tilt = -10.0F}));
+    CHECK_EQ(gimbal.Pose(milliseconds(20)), (GimbalPose{}));
+    CHECK(gimbal.Moving(milliseconds(20)));
+    CHECK_GT(gimbal.Pose(milliseconds(25)).pan, 0.0F);
+    CHECK_LT(gimbal.Pose(milliseconds(25)).tilt, 0.0F);
+  }
+
+  TEST_CASE("VirtualGimbal: Each axis moves at the slew rate") {
+    VirtualGimbal gimbal(SlowGimbal());
+    gimbal.Command({.pan = 50.0F, .tilt = -5.0F}, microseconds(0));  // Latched at 20 ms
+
+    const GimbalPose pose = gimbal.Pose(milliseconds(120));
+    CHECK_EQ(pose.pan, doctest::Approx(10.0F));
+    CHECK_EQ(pose.tilt, doctest::Approx(-5.0F));
+    CHECK_EQ(gimbal.Pose(milliseconds(520)).pan, doctest::Approx(50.0F));
+    CHECK_FALSE(gimbal.Moving(milliseconds(520)));
+  }
+
+  TEST_CASE("VirtualGimbal: Retargets from the current pose") {
+    VirtualGimbal gimbal(SlowGimbal());
+    gimbal.Command({.pan = 90.0F, .tilt = 0.0F}, microseconds(0));
+    gimbal.Command({.pan = -90.0F, .tilt = 0.0F}, milliseconds(200));  // Latched at 220 ms, +20 degrees
+
+    CHECK_EQ(gimbal.Pose(milliseconds(220)).pan, doctest::Approx(20.0F));
+    CHECK_EQ(gimbal.Pose(milliseconds(320)).pan, doctest::Approx(10.0F));
+  }
+
+  TEST_CASE("VirtualGimbal: Within one period only the last command is latched") {
+    VirtualGimbal gimbal(SlowGimbal());
+    gimbal.Command({.pan = 90.0F, .tilt = 0.0F}, milliseconds(1));
+    gimbal.Command({.pan = -45.0F, .tilt = 0.0F}, milliseconds(10));
+
+    CHECK_EQ(gimbal.Commanded().pan, doctest::Approx(-45.0F));
+    CHECK_EQ(gimbal.Pose(milliseconds(120)).pan, doctest::Approx(-10.0F));
+  }
+
+  TEST_CASE("VirtualGimbal: Clamps commands to the servo range") {
+    VirtualGimbal gimbal;
+    gimbal.Command({.pan = 120.0F, .tilt = -60.0F}, microseconds(0));
+
+    CHECK_EQ(gimbal.Commanded(), (GimbalPose{.pan = 90.0F, .tilt = -45.0F}));
+    CHECK_EQ(gimbal.Pose(std::chrono::seconds(2)), (GimbalPose{.pan = 90.0F, .tilt = -45.0F}));
+  }
+
+  TEST_CASE("VirtualGimbal: Reset places the gimbal at rest") {
+    VirtualGimbal gimbal;
+    gimbal.Command({.pan = 40.0F, .tilt = 0.0F}, microseconds(0));
+    gimbal.Reset({.pan = 10.0F, .tilt = 5.0F});
+
+    CHECK_EQ(gimbal.Pose(microseconds(0)), (GimbalPose{.pan = 10.0F, .tilt = 5.0F}));
+    CHECK_FALSE(gimbal.Moving(std::chrono::seconds(1)));
+  }
+}
+
+TEST_SUITE("client::VirtualGimbalDevice") {
+  TEST_CASE("VirtualGimbalDevice: Negotiates compact control and applies MOVEs") {
+    auto [host, device_end] = client::comm::LoopbackTransport::CreatePair();
+    VirtualGimbal gimbal;
+    client::VirtualGimbalDevice device(*device_end, gimbal);
+
+    client::comm::LinkSession session;
+    session.Attach(host.get());
+    std::optional<client::comm::StatusMessage> response;
+    session.SetDataReceivedCallback([&response](std::span<const uint8_t> payload) {
+      const auto status = client::comm::Protocol::DeserializeStatus(payload);
+      REQUIRE(status.has_value());
+      response = *status;
+    });
+
+    REQUIRE(device_end->Open().has_value());
+    REQUIRE(host->Open().has_value());
+    session.Start();
+    host->Pump();
+    device_end->Pump();
+    REQUIRE(session.CompactControlActive());
+
+    device.SetTime(milliseconds(100));
+    REQUIRE(session.SendMove({.pan_angle = 20.0F, .tilt_angle = -8.0F, .command_id = 7}).has_value());
+    host->Pump();
+    device_end->Pump();
+
+    CHECK_EQ(device.Moves(), 1U);
+    CHECK_EQ(gimbal.Commanded(), (GimbalPose{.pan = 20.0F, .tilt = -8.0F}));
+    REQUIRE(response.has_value());
+    CHECK_EQ(response->command_id, 7U);
+    CHECK_EQ(response->target_pan, doctest::Approx(20.0F));
+    CHECK(response->is_moving);
+  }
+}
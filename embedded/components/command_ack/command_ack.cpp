@@ -0,0 +1,89 @@
+/**
+ * @file command_ack.cpp
+ * @brief Windowed MOVE acknowledgements and duplicate command detection
+ */
+
+#include "command_ack.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace embedded {
+
+bool AckWindow::Record(uint8_t sequence, uint32_t now_ms) noexcept {
+  if (!any_) {
+    newest_ = sequence;
+    received_ = 0;
+    any_ = true;
+  } else {
+    const auto distance = static_cast<int8_t>(static_cast<uint8_t>(sequence - newest_));
+    if (distance > 0) {
+      // Slide the window forward; the previous newest becomes bit (distance - 1)
+      const auto shift = static_cast<uint32_t>(distance);
+      received_ = shift >= 32 ? 0 : received_ << shift;
+      if (shift <= 32) {
+        received_ |= 1U << (shift - 1);
+      }
+      newest_ = sequence;
+    } else if (distance < 0) {
+      // Reordered or late MOVE: mark it if it still falls inside the window
+      const auto bit = static_cast<uint32_t>(-distance - 1);
+      if (bit < 32) {
+        received_ |= 1U << bit;
+      }
+    }
+  }
+
+  if (pending_ == 0) {
+    first_pending_ms_ = now_ms;
+  }
+  ++pending_;
+  return pending_ >= kFlushCount;
+}
+
+bool AckWindow::FlushDue(uint32_t now_ms) const noexcept {
+  return pending_ != 0 && now_ms - first_pending_ms_ >= kFlushIntervalMs;
+}
+
+void AckWindow::Take(WindowAck& ack) noexcept {
+  ack.status.sequence = newest_;
+  ack.received = received_;
+  pending_ = 0;
+}
+
+void AckWindow::Reset() noexcept {
+  received_ = 0;
+  pending_ = 0;
+  first_pending_ms_ = 0;
+  newest_ = 0;
+  any_ = false;
+}
+
+bool RecentCommands::Contains(uint32_t command_id) const noexcept {
+  if (command_id == 0) {
+    return false;
+  }
+
+  for (const uint32_t id : ids_) {
+    if (id == command_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void RecentCommands::Insert(uint32_t command_id) noexcept {
+  if (command_id == 0) {
+    return;
+  }
+
+  ids_[next_] = command_id;
+  next_ = (next_ + 1) % ids_.size();
+}
+
+void RecentCommands::Reset() noexcept {
+  ids_.fill(0);
+  next_ = 0;
+}
+
+}  // namespace embedded
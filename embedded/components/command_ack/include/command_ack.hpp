@@ -0,0 +1,110 @@
+/**
+ * @file command_ack.hpp
+ * @brief Windowed MOVE acknowledgements and duplicate command detection
+ *
+ * With the kWindowAckFeature negotiated, a successful MOVE is not answered by its own status
+ * frame. AckWindow remembers which MOVE sequences arrived and says when to send one WindowAck
+ * for all of them: after kFlushCount MOVEs, or kFlushIntervalMs after the first unacknowledged
+ * one. Uplink throughput is then bounded by the link rate rather than by a response per command.
+ *
+ * Commands that are not idempotent (CALIBRATE, SET_CONFIG) are retransmitted by the client until
+ * their response arrives, with the same command ID. RecentCommands lets the firmware recognise
+ * such a repeat and answer it again without executing the command twice.
+ */
+
+#pragma once
+
+#include <compact_control.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace embedded {
+
+/**
+ * @brief Tracks received MOVE sequences between windowed acknowledgements.
+ * @note Not thread-safe; callers serialize access.
+ */
+class AckWindow {
+public:
+  /// MOVEs after which an acknowledgement is sent.
+  static constexpr uint32_t kFlushCount = 8;
+
+  /// Time after the first unacknowledged MOVE at which an acknowledgement is sent.
+  static constexpr uint32_t kFlushIntervalMs = 50;
+
+  /**
+   * @brief Records a received MOVE.
+   * @param sequence Sequence (low 8 bits of the command ID) of the MOVE
+   * @param now_ms Current time in milliseconds
+   * @return True if kFlushCount MOVEs are now waiting to be acknowledged
+   */
+  bool Record(uint8_t sequence, uint32_t now_ms) noexcept;
+
+  /**
+   * @brief Checks whether waiting MOVEs have been unacknowledged for kFlushIntervalMs.
+   * @param now_ms Current time in milliseconds
+   * @return True if an acknowledgement is due
+   */
+  [[nodiscard]] bool FlushDue(uint32_t now_ms) const noexcept;
+
+  /**
+   * @brief Checks whether any MOVE is waiting to be acknowledged.
+   * @return True if Record() was called since the last Take()
+   */
+  [[nodiscard]] bool Pending() const noexcept { return pending_ != 0; }
+
+  /**
+   * @brief Fills in the window of an acknowledgement and marks all MOVEs acknowledged.
+   * @param ack Receives status.sequence and received; the rest of the status is left to the caller
+   * @note The window keeps its history, so the next acknowledgement restates these MOVEs too.
+   */
+  void Take(WindowAck& ack) noexcept;
+
+  /**
+   * @brief Forgets all MOVEs (e.g. on a new connection).
+   */
+  void Reset() noexcept;
+
+private:
+  uint32_t received_ = 0;
+  uint32_t pending_ = 0;
+  uint32_t first_pending_ms_ = 0;
+  uint8_t newest_ = 0;
+  bool any_ = false;
+};
+
+/**
+ * @brief Remembers the IDs of recently executed commands to detect retransmissions.
+ * @note Not thread-safe; callers serialize access.
+ */
+class RecentCommands {
+public:
+  /// Command IDs remembered.
+  static constexpr size_t kCapacity = 8;
+
+  /**
+   * @brief Checks whether a command was executed recently.
+   * @param command_id Command ID (0 is never treated as a repeat)
+   * @return True if @p command_id was inserted and not yet displaced
+   */
+  [[nodiscard]] bool Contains(uint32_t command_id) const noexcept;
+
+  /**
+   * @brief Remembers an executed command, displacing the oldest ID once kCapacity are held.
+   * @param command_id Command ID (0 is ignored)
+   */
+  void Insert(uint32_t command_id) noexcept;
+
+  /**
+   * @brief Forgets all IDs (e.g. on a new connection).
+   */
+  void Reset() noexcept;
+
+private:
+  std::array<uint32_t, kCapacity> ids_{};
+  size_t next_ = 0;
+};
+
+}  // namespace embedded
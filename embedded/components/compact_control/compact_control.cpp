@@ -0,0 +1,149 @@
+/**
+ * @file compact_control.cpp
+ * @brief Protocol v2 fixed-point control messages
+ */
+
+#include "compact_control.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace embedded {
+
+namespace {
+
+constexpr uint8_t kMoveHasVelocity = 0x01;
+constexpr uint8_t kStatusMoving = 0x01;
+constexpr uint8_t kStatusCalibrated = 0x02;
+constexpr uint8_t kStatusRejected = 0x04;
+
+/**
+ * @brief Converts degrees to saturated, rounded centi-degrees (NaN maps to 0).
+ */
+int16_t ToCentiDegrees(float degrees) {
+  const float scaled = degrees * 100.0F;
+  if (scaled != scaled) {
+    return 0;
+  }
+  if (scaled >= 32767.0F) {
+    return INT16_MAX;
+  }
+  if (scaled <= -32768.0F) {
+    return INT16_MIN;
+  }
+  return static_cast<int16_t>(scaled < 0.0F ? scaled - 0.5F : scaled + 0.5F);
+}
+
+float FromCentiDegrees(int16_t centi_degrees) { return static_cast<float>(centi_degrees) / 100.0F; }
+
+void PutDegrees(float degrees, uint8_t* out) {
+  const auto bits = static_cast<uint16_t>(ToCentiDegrees(degrees));
+  out[0] = static_cast<uint8_t>(bits);
+  out[1] = static_cast<uint8_t>(bits >> 8);
+}
+
+float GetDegrees(const uint8_t* data) {
+  return FromCentiDegrees(static_cast<int16_t>(static_cast<uint16_t>(data[0] | (data[1] << 8))));
+}
+
+}  // namespace
+
+size_t EncodeCompactMove(const CompactMove& move, std::span<uint8_t> out) noexcept {
+  const size_t size = move.has_velocity ? kCompactMoveWithVelocitySize : kCompactMoveSize;
+  if (out.size() < size) {
+    return 0;
+  }
+
+  out[0] = move.sequence;
+  out[1] = move.has_velocity ? kMoveHasVelocity : 0;
+  PutDegrees(move.pan, &out[2]);
+  PutDegrees(move.tilt, &out[4]);
+  if (move.has_velocity) {
+    PutDegrees(move.pan_velocity, &out[6]);
+    PutDegrees(move.tilt_velocity, &out[8]);
+  }
+  return size;
+}
+
+bool DecodeCompactMove(std::span<const uint8_t> data, CompactMove& move) noexcept {
+  if (data.size() < kCompactMoveSize) {
+    return false;
+  }
+
+  const bool has_velocity = (data[1] & kMoveHasVelocity) != 0;
+  if (data.size() != (has_velocity ? kCompactMoveWithVelocitySize : kCompactMoveSize)) {
+    return false;
+  }
+
+  move = CompactMove{};
+  move.sequence = data[0];
+  move.has_velocity = has_velocity;
+  move.pan = GetDegrees(&data[2]);
+  move.tilt = GetDegrees(&data[4]);
+  if (has_velocity) {
+    move.pan_velocity = GetDegrees(&data[6]);
+    move.tilt_velocity = GetDegrees(&data[8]);
+  }
+  return true;
+}
+
+size_t EncodeCompactStatus(const CompactStatus& status, std::span<uint8_t> out) noexcept {
+  if (out.size() < kCompactStatusSize) {
+    return 0;
+  }
+
+  out[0] = status.sequence;
+  out[1] = static_cast<uint8_t>((status.moving ? kStatusMoving : 0) | (status.calibrated ? kStatusCalibrated : 0) |
+                                (status.rejected ? kStatusRejected : 0));
+  PutDegrees(status.pan, &out[2]);
+  PutDegrees(status.tilt, &out[4]);
+  PutDegrees(status.target_pan, &out[6]);
+  PutDegrees(status.target_tilt, &out[8]);
+  return kCompactStatusSize;
+}
+
+bool DecodeCompactStatus(std::span<const uint8_t> data, CompactStatus& status) noexcept {
+  if (data.size() != kCompactStatusSize) {
+    return false;
+  }
+
+  status.sequence = data[0];
+  status.moving = (data[1] & kStatusMoving) != 0;
+  status.calibrated = (data[1] & kStatusCalibrated) != 0;
+  status.rejected = (data[1] & kStatusRejected) != 0;
+  status.pan = GetDegrees(&data[2]);
+  status.tilt = GetDegrees(&data[4]);
+  status.target_pan = GetDegrees(&data[6]);
+  status.target_tilt = GetDegrees(&data[8]);
+  return true;
+}
+
+size_t EncodeWindowAck(const WindowAck& ack, std::span<uint8_t> out) noexcept {
+  if (out.size() < kWindowAckSize) {
+    return 0;
+  }
+
+  if (EncodeCompactStatus(ack.status, out) != kCompactStatusSize) {
+    return 0;
+  }
+  for (size_t i = 0; i < 4; ++i) {
+    out[kCompactStatusSize + i] = static_cast<uint8_t>(ack.received >> (8 * i));
+  }
+  return kWindowAckSize;
+}
+
+bool DecodeWindowAck(std::span<const uint8_t> data, WindowAck& ack) noexcept {
+  if (data.size() != kWindowAckSize || !DecodeCompactStatus(data.first(kCompactStatusSize), ack.status)) {
+    return false;
+  }
+
+  ack.received = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    ack.received |= static_cast<uint32_t>(data[kCompactStatusSize + i]) << (8 * i);
+  }
+  return true;
+}
+
+}  // namespace embedded
@@ -0,0 +1,135 @@
+/**
+ * @file compact_control.hpp
+ * @brief Protocol v2 fixed-point control messages
+ *
+ * Once the client's handshake requests kCompactControlFeature, MOVE commands and their
+ * acknowledgements travel in FrameType::kCompact frames with fixed little-endian layouts:
+ *
+ *   CompactMove:   seq u8 | flags u8 | pan i16 | tilt i16 [| pan_velocity i16 | tilt_velocity i16]
+ *   CompactStatus: seq u8 | flags u8 | pan i16 | tilt i16 | target_pan i16 | target_tilt i16
+ *
+ * Angles are centi-degrees and velocities centi-degrees per second. A MOVE frame shrinks from
+ * roughly 30 bytes of protobuf to 13, and its acknowledgement from roughly 50 to 17.
+ *
+ * If the handshake also requests kWindowAckFeature, MOVEs are no longer acknowledged one by one;
+ * a FrameType::kWindowAck frame covers several of them (see AckWindow in command_ack.hpp):
+ *
+ *   WindowAck:     CompactStatus | received u32
+ *
+ * where the status sequence is the newest MOVE received and bit i of received is set if the MOVE
+ * with sequence (sequence - 1 - i) was received as well. The client implements the same layouts
+ * in client/comm/compact_codec.hpp.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace embedded {
+
+/// Protocol version reported in the handshake response when compact control is supported.
+inline constexpr uint32_t kCompactProtocolVersion = 2;
+
+/// Handshake feature name that enables compact control.
+inline constexpr const char* kCompactControlFeature = "compact_v2";
+
+/// Size of a CompactMove without velocity.
+inline constexpr size_t kCompactMoveSize = 6;
+
+/// Size of a CompactMove carrying velocity.
+inline constexpr size_t kCompactMoveWithVelocitySize = 10;
+
+/// Size of a CompactStatus.
+inline constexpr size_t kCompactStatusSize = 10;
+
+/// Handshake feature name that replaces per-MOVE acknowledgements with WindowAck frames.
+inline constexpr const char* kWindowAckFeature = "ack_window";
+
+/// Size of a WindowAck.
+inline constexpr size_t kWindowAckSize = kCompactStatusSize + 4;
+
+/**
+ * @brief Compact MOVE command.
+ */
+struct CompactMove {
+  float pan = 0.0F;            ///< Pan angle in degrees.
+  float tilt = 0.0F;           ///< Tilt angle in degrees.
+  float pan_velocity = 0.0F;   ///< Pan velocity in degrees per second (valid if has_velocity).
+  float tilt_velocity = 0.0F;  ///< Tilt velocity in degrees per second (valid if has_velocity).
+  bool has_velocity = false;   ///< Whether the velocity fields were sent.
+  uint8_t sequence = 0;        ///< Low 8 bits of the client's command ID.
+};
+
+/**
+ * @brief Compact acknowledgement of a CompactMove.
+ */
+struct CompactStatus {
+  float pan = 0.0F;          ///< Current pan position in degrees.
+  float tilt = 0.0F;         ///< Current tilt position in degrees.
+  float target_pan = 0.0F;   ///< Target pan position in degrees.
+  float target_tilt = 0.0F;  ///< Target tilt position in degrees.
+  uint8_t sequence = 0;      ///< Sequence of the command being acknowledged.
+  bool moving = false;       ///< Whether the servos are moving toward the target.
+  bool calibrated = false;   ///< Whether the servos are calibrated.
+  bool rejected = false;     ///< Whether the command was refused.
+};
+
+/**
+ * @brief Windowed acknowledgement of several compact MOVEs.
+ */
+struct WindowAck {
+  CompactStatus status;   ///< Device state; status.sequence is the newest MOVE received.
+  uint32_t received = 0;  ///< Bit i set if the MOVE with sequence (status.sequence - 1 - i) was received.
+};
+
+/**
+ * @brief Encodes a compact MOVE command.
+ * @param move Command to encode
+ * @param out Output buffer
+ * @return Number of bytes written, or 0 if out is too small
+ */
+[[nodiscard]] size_t EncodeCompactMove(const CompactMove& move, std::span<uint8_t> out) noexcept;
+
+/**
+ * @brief Decodes a compact MOVE command.
+ * @param data Encoded bytes
+ * @param move Receives the decoded command
+ * @return True if data is a well-formed CompactMove
+ */
+[[nodiscard]] bool DecodeCompactMove(std::span<const uint8_t> data, CompactMove& move) noexcept;
+
+/**
+ * @brief Encodes a compact status.
+ * @param status Status to encode
+ * @param out Output buffer
+ * @return Number of bytes written, or 0 if out is too small
+ */
+[[nodiscard]] size_t EncodeCompactStatus(const CompactStatus& status, std::span<uint8_t> out) noexcept;
+
+/**
+ * @brief Decodes a compact status.
+ * @param data Encoded bytes
+ * @param status Receives the decoded status
+ * @return True if data is a well-formed CompactStatus
+ */
+[[nodiscard]] bool DecodeCompactStatus(std::span<const uint8_t> data, CompactStatus& status) noexcept;
+
+/**
+ * @brief Encodes a windowed acknowledgement.
+ * @param ack Acknowledgement to encode
+ * @param out Output buffer
+ * @return Number of bytes written, or 0 if out is too small
+ */
+[[nodiscard]] size_t EncodeWindowAck(const WindowAck& ack, std::span<uint8_t> out) noexcept;
+
+/**
+ * @brief Decodes a windowed acknowledgement.
+ * @param data Encoded bytes
+ * @param ack Receives the decoded acknowledgement
+ * @return True if data is a well-formed WindowAck
+ */
+[[nodiscard]] bool DecodeWindowAck(std::span<const uint8_t> data, WindowAck& ack) noexcept;
+
+}  // namespace embedded
@@ -0,0 +1,91 @@
+/**
+ * @file loop_timing.hpp
+ * @brief Period and jitter statistics of a periodic control loop
+ *
+ * The servo loop is woken by a hardware timer; how closely its updates keep to the nominal period
+ * decides how smoothly the horns move. These statistics are reported in the status response.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace embedded {
+
+/**
+ * @brief Timing of a periodic loop since it started.
+ */
+struct LoopTimingStats {
+  uint32_t rate_hz = 0;        ///< Nominal update rate.
+  uint32_t updates = 0;        ///< Updates since the loop started.
+  uint32_t jitter_us = 0;      ///< Smoothed deviation of the period from nominal (RFC 3550 estimator).
+  uint32_t max_jitter_us = 0;  ///< Largest deviation of a period from nominal.
+  uint32_t overruns = 0;       ///< Periods that ran past half a period late, i.e. missed a tick.
+  uint32_t max_busy_us = 0;    ///< Longest time an update took.
+};
+
+/**
+ * @brief Measures the period of a loop against its nominal rate.
+ * @note Not thread-safe; owned by the loop it measures.
+ */
+class LoopTiming final {
+public:
+  /**
+   * @brief Constructs timing for a loop.
+   * @param rate_hz Nominal update rate (at least 1)
+   */
+  explicit constexpr LoopTiming(uint32_t rate_hz) noexcept : period_us_(1000000 / std::max(rate_hz, 1U)) {
+    stats_.rate_hz = std::max(rate_hz, 1U);
+  }
+
+  /**
+   * @brief Records the start of an update.
+   * @param now_us Monotonic time in microseconds
+   * @return Microseconds since the previous update, or the nominal period for the first one
+   */
+  constexpr uint32_t Tick(int64_t now_us) noexcept {
+    const bool first = stats_.updates == 0;
+    const uint32_t period = first ? period_us_ : static_cast<uint32_t>(std::max<int64_t>(now_us - last_us_, 0));
+    last_us_ = now_us;
+    ++stats_.updates;
+    if (first) {
+      return period;
+    }
+
+    const uint32_t deviation = period > period_us_ ? period - period_us_ : period_us_ - period;
+    jitter_q4_ = jitter_q4_ + deviation - ((jitter_q4_ + 8) >> 4);
+    stats_.jitter_us = jitter_q4_ >> 4;
+    stats_.max_jitter_us = std::max(stats_.max_jitter_us, deviation);
+    if (period > period_us_ + period_us_ / 2) {
+      ++stats_.overruns;
+    }
+    return period;
+  }
+
+  /**
+   * @brief Records how long an update took.
+   * @param busy_us Microseconds from Tick() to the end of the update
+   */
+  constexpr void Busy(uint32_t busy_us) noexcept { stats_.max_busy_us = std::max(stats_.max_busy_us, busy_us); }
+
+  /**
+   * @brief Gets the nominal period.
+   * @return Microseconds
+   */
+  [[nodiscard]] constexpr uint32_t PeriodUs() const noexcept { return period_us_; }
+
+  /**
+   * @brief Gets the statistics so far.
+   * @return Statistics
+   */
+  [[nodiscard]] constexpr const LoopTimingStats& Stats() const noexcept { return stats_; }
+
+private:
+  uint32_t period_us_ = 0;  ///< Nominal period in microseconds.
+  int64_t last_us_ = 0;     ///< Start of the previous update.
+  uint32_t jitter_q4_ = 0;  ///< Jitter in 1/16 microseconds.
+  LoopTimingStats stats_;
+};
+
+}  // namespace embedded
@@ -0,0 +1,128 @@
+/**
+ * @file mailbox.hpp
+ * @brief Lock-free single-writer mailbox for handing small values between tasks
+ *
+ * The servo loop runs from a timer at a few hundred hertz and must never wait on the task that
+ * receives commands, nor the other way round. The mailbox is a seqlock that keeps two copies of the
+ * value (a "latch"): while one copy is being written, readers take the other, so a reader never
+ * waits for a writer, even one it preempted halfway through a store.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace embedded {
+
+/**
+ * @brief Latest value of type T, written by one task and read by any.
+ * @details Each store bumps the sequence to odd, rewrites the first copy, bumps it to even and
+ * rewrites the second; readers take the copy the sequence points away from the writer and check
+ * that the sequence did not move meanwhile. A read is only retried when a store ran during it, so
+ * a preempted writer never blocks a reader. The copies are held as relaxed atomic words, so a read
+ * that races a store is discarded rather than undefined behaviour.
+ * @tparam T Trivially copyable value type
+ * @note Stores must come from one task at a time; loads are safe from any task.
+ */
+template <typename T>
+class Mailbox final {
+  static_assert(std::is_trivially_copyable_v<T>, "Mailbox values are copied word by word");
+
+public:
+  Mailbox() noexcept : Mailbox(T{}) {}
+
+  /**
+   * @brief Constructs the mailbox holding an initial value (version 0).
+   * @param value Initial value
+   */
+  explicit Mailbox(const T& value) noexcept {
+    Store(value);
+    sequence_.store(0, std::memory_order_relaxed);
+  }
+
+  Mailbox(const Mailbox&) = delete;
+  Mailbox(Mailbox&&) = delete;
+  ~Mailbox() = default;
+
+  Mailbox& operator=(const Mailbox&) = delete;
+  Mailbox& operator=(Mailbox&&) = delete;
+
+  /**
+   * @brief Publishes a value, replacing the previous one. Never blocks.
+   * @param value Value to publish
+   */
+  void Store(const T& value) noexcept {
+    Words words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+
+    const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_release);  // Readers move to the second copy
+    std::atomic_thread_fence(std::memory_order_release);
+    Write(copies_[0], words);
+    sequence_.store(sequence + 2, std::memory_order_release);  // Readers move back to the first
+    std::atomic_thread_fence(std::memory_order_release);
+    Write(copies_[1], words);
+  }
+
+  /**
+   * @brief Reads the value unless a store runs during the read.
+   * @param value Set to the value on success, unchanged otherwise
+   * @param version Set to the number of stores the value reflects on success
+   * @return True if @p value was read whole
+   */
+  [[nodiscard]] bool TryLoad(T& value, uint32_t& version) const noexcept {
+    const uint32_t before = sequence_.load(std::memory_order_acquire);
+    Words words{};
+    const auto& copy = copies_[before & 1U];
+    for (size_t i = 0; i < kWords; ++i) {
+      words[i] = copy[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) != before) {
+      return false;
+    }
+    std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+    // Halfway through a store the second copy still holds the previous value
+    version = before / 2;
+    return true;
+  }
+
+  /**
+   * @brief Reads the value, retrying while stores run during the read.
+   * @return Latest value
+   */
+  [[nodiscard]] T Load() const noexcept {
+    T value{};
+    uint32_t version = 0;
+    while (!TryLoad(value, version)) {
+    }
+    return value;
+  }
+
+  /**
+   * @brief Gets the number of completed stores, to tell whether a value is new.
+   * @return Stores since construction
+   */
+  [[nodiscard]] uint32_t Version() const noexcept { return sequence_.load(std::memory_order_acquire) / 2; }
+
+private:
+  static constexpr size_t kWords = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+  using Words = std::array<uint32_t, kWords>;
+  using Copy = std::array<std::atomic<uint32_t>, kWords>;
+
+  static void Write(Copy& copy, const Words& words) noexcept {
+    for (size_t i = 0; i < kWords; ++i) {
+      copy[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<uint32_t> sequence_{0};  ///< Twice the stores so far, plus one halfway through a store.
+  std::array<Copy, 2> copies_;         ///< Value, written first to copy 0, then to copy 1.
+};
+
+}  // namespace embedded
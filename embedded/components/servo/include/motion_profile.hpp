@@ -0,0 +1,143 @@
+/**
+ * @file motion_profile.hpp
+ * @brief Online trapezoidal and S-curve motion profiles for one servo axis
+ *
+ * The profile moves a position towards a target without exceeding the axis velocity,
+ * acceleration and jerk limits, and lands on the target without overshoot. It plans one step
+ * at a time from the current position, velocity and acceleration, so a new target may arrive
+ * at any point of a move: the axis bends smoothly towards it instead of stopping first.
+ */
+
+#pragma once
+
+#include <array>
+
+namespace embedded {
+
+/**
+ * @brief Kinematic limits of one axis.
+ * @details A jerk limit of 0 lets the acceleration change instantly, giving a trapezoidal velocity
+ * profile; any other value ramps the acceleration, giving an S-curve.
+ */
+struct MotionLimits {
+  float max_velocity = 300.0F;       ///< Velocity limit in degrees per second.
+  float max_acceleration = 1500.0F;  ///< Acceleration limit in degrees per second squared.
+  float max_jerk = 15000.0F;         ///< Jerk limit in degrees per second cubed (0 = unlimited).
+};
+
+/**
+ * @brief Kinematic state of one axis.
+ */
+struct MotionState {
+  float position = 0.0F;      ///< Position in degrees.
+  float velocity = 0.0F;      ///< Velocity in degrees per second.
+  float acceleration = 0.0F;  ///< Acceleration in degrees per second squared.
+};
+
+/**
+ * @brief Online time-optimal-style trajectory generator for one axis.
+ * @details Every Step() accelerates towards the target as hard as the limits allow, then coasts,
+ * then brakes, each phase lasting for as long as the shortest stop from the resulting state still
+ * ends short of the target. Phase changes inside a step are found by bisection, so the axis lands
+ * on the target at rest whatever the step length, and steps need not be uniform.
+ * @note Not thread-safe.
+ */
+class MotionProfile final {
+public:
+  /**
+   * @brief Constructs a profile at rest at 0 degrees.
+   * @param limits Axis limits
+   */
+  explicit MotionProfile(const MotionLimits& limits = {}) noexcept : limits_(limits) {}
+
+  /**
+   * @brief Sets a new target; the next Step() replans from the current state.
+   * @param target Target position in degrees
+   */
+  void SetTarget(float target) noexcept;
+
+  /**
+   * @brief Places the axis at rest at a position, abandoning any move.
+   * @param position Position in degrees
+   */
+  void Reset(float position) noexcept;
+
+  /**
+   * @brief Advances the axis.
+   * @param dt Seconds since the previous step (ignored unless positive)
+   * @return State after the step
+   */
+  const MotionState& Step(float dt) noexcept;
+
+  /**
+   * @brief Replaces the limits; the move in progress continues under the new ones.
+   * @param limits Axis limits
+   */
+  void SetLimits(const MotionLimits& limits) noexcept { limits_ = limits; }
+
+  /**
+   * @brief Gets where the axis would come to rest if it braked as hard as possible now.
+   * @return Position in degrees
+   */
+  [[nodiscard]] float StoppingPosition() const noexcept;
+
+  /**
+   * @brief Gets how far the axis would travel braking as hard as possible from a velocity at zero acceleration.
+   * @param velocity Velocity in degrees per second
+   * @return Signed distance in degrees
+   */
+  [[nodiscard]] float StoppingDistance(float velocity) const noexcept;
+
+  /**
+   * @brief Checks whether the axis is at rest on its target.
+   * @return True once the move has finished
+   */
+  [[nodiscard]] bool Done() const noexcept { return !moving_; }
+
+  /**
+   * @brief Gets the current kinematic state.
+   * @return State
+   */
+  [[nodiscard]] const MotionState& State() const noexcept { return state_; }
+
+  /**
+   * @brief Gets the target position.
+   * @return Target in degrees
+   */
+  [[nodiscard]] float Target() const noexcept { return target_; }
+
+  /**
+   * @brief Gets the axis limits.
+   * @return Limits
+   */
+  [[nodiscard]] const MotionLimits& Limits() const noexcept { return limits_; }
+
+private:
+  /// Ramp of the acceleration towards a goal at the jerk limit, then a hold at the goal.
+  struct Segment {
+    float acceleration = 0.0F;  ///< Goal acceleration.
+    float duration = 0.0F;      ///< Length of ramp and hold together in seconds.
+  };
+
+  /// Shortest stop: ramp to the peak deceleration and hold it, then ramp back to zero.
+  using Brake = std::array<Segment, 2>;
+
+  [[nodiscard]] Brake PlanBrake(const MotionState& state) const noexcept;
+  [[nodiscard]] float StoppingPosition(const MotionState& state) const noexcept;
+  [[nodiscard]] float SettledVelocity(const MotionState& state) const noexcept;
+  [[nodiscard]] bool Accelerate(MotionState& state, float direction, float dt) const noexcept;
+  void Ramp(MotionState& state, float acceleration, float dt) const noexcept;
+
+  /// Applies @p move for the whole step, or for as long as it keeps returning true; returns the time used.
+  template <typename Move>
+  float Advance(float dt, const Move& move) noexcept;
+
+  void Finish() noexcept;
+
+  MotionLimits limits_;
+  MotionState state_;
+  float target_ = 0.0F;
+  bool moving_ = false;
+};
+
+}  // namespace embedded
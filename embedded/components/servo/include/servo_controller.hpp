@@ -8,6 +8,10 @@
 #include <driver/mcpwm_prelude.h>
 #include <esp_err.h>
 
+#include <mailbox.hpp>
+#include <motion_profile.hpp>
+#include <target_predictor.hpp>
+
 #include <atomic>
 #include <cstdint>
 
@@ -17,12 +21,12 @@ namespace embedded {
  * @brief Servo controller state.
  */
 struct ServoState {
-  float pan = 0.0F;           ///< Current pan position in degrees (-90 to 90).
-  float tilt = 0.0F;          ///< Current tilt position in degrees (-45 to 45).
-  float target_pan = 0.0F;    ///< Target pan position in degrees.
-  float target_tilt = 0.0F;   ///< Target tilt position in degrees.
-  bool is_moving = false;     ///< Whether servos are currently moving.
-  bool is_calibrated = true;  ///< Whether servos are calibrated.
+  float pan = 0.0F;            ///< Current pan position in degrees (-90 to 90).
+  float tilt = 0.0F;           ///< Current tilt position in degrees (-45 to 45).
+  float target_pan = 0.0F;     ///< Target pan position in degrees.
+  float target_tilt = 0.0F;    ///< Target tilt position in degrees.
+  bool is_moving = false;      ///< Whether servos are currently moving.
+  bool is_calibrated = false;  ///< Whether the calibration sequence has completed since power-up.
 };
 
 /**
@@ -35,20 +39,28 @@ struct ServoConfig {
   float pan_max = 90.0F;                  ///< Maximum pan angle in degrees.
   float tilt_min = -45.0F;                ///< Minimum tilt angle in degrees.
   float tilt_max = 45.0F;                 ///< Maximum tilt angle in degrees.
-  float speed = 1.0F;                     ///< Movement speed (0.0 to 1.0).
-  float smoothing = 0.5F;                 ///< Smoothing factor (0.0 to 1.0).
+  float speed = 1.0F;                     ///< Fraction of the velocity and acceleration limits (0.0 to 1.0).
+  float smoothing = 0.5F;                 ///< Profile shape: 0 for trapezoidal, above 0 for jerk-limited S-curve.
   float dead_zone = 1.0F;                 ///< Dead zone in degrees (minimum movement threshold).
   bool invert_pan = false;                ///< Invert pan direction.
   bool invert_tilt = false;               ///< Invert tilt direction.
   uint32_t servo_min_pulse_us = 500;      ///< Minimum pulse width in microseconds.
   uint32_t servo_max_pulse_us = 2500;     ///< Maximum pulse width in microseconds.
   uint32_t servo_center_pulse_us = 1500;  ///< Center pulse width in microseconds.
+  MotionLimits pan_limits;                ///< Pan velocity, acceleration and jerk limits.
+  MotionLimits tilt_limits;               ///< Tilt velocity, acceleration and jerk limits.
 };
 
 /**
  * @brief Servo controller for pan/tilt mechanism.
  * @details This class manages servo movement, calibration, and position tracking
  * using ESP32's MCPWM hardware for precise PWM control.
+ *
+ * The servos are driven by Update(), called from one periodic task (the servo loop). The command
+ * methods may be called from another task: they post requests through lock-free mailboxes that the
+ * next Update() applies, and State() reads the snapshot the last Update() published, so neither
+ * side ever waits on the other.
+ * @note Command methods must be called from one task at a time.
  */
 class ServoController final {
 public:
@@ -61,27 +73,42 @@ public:
   ServoController& operator=(ServoController&&) = delete;
 
   /**
-   * @brief Initializes the servo controller.
+   * @brief Initializes the servo controller (before the servo loop starts).
    * @param config Servo configuration.
    * @return ESP_OK on success, error code otherwise.
    */
   esp_err_t Initialize(const ServoConfig& config) noexcept;
 
   /**
-   * @brief Updates servo positions (should be called periodically).
-   * @details This performs smooth interpolation between current and target positions.
-   * @param delta_time_ms Time elapsed since last update in milliseconds.
+   * @brief Updates servo positions (servo loop only, called periodically).
+   * @details Applies the requests posted since the previous update, advances each axis along its
+   * motion profile towards the target and publishes the new state.
+   * @param delta_time_us Time elapsed since last update in microseconds.
    */
-  void Update(uint32_t delta_time_ms) noexcept;
+  void Update(uint32_t delta_time_us) noexcept;
 
   /**
    * @brief Moves servos to a target position.
+   * @details A new target during a move replans from the current position and velocity.
    * @param pan Target pan angle in degrees.
    * @param tilt Target tilt angle in degrees.
-   * @param smooth Whether to use smooth interpolation.
+   * @param smooth Whether to follow the motion profile (false jumps to the target).
    */
   void MoveTo(float pan, float tilt, bool smooth = true) noexcept;
 
+  /**
+   * @brief Moves servos towards a moving target.
+   * @details Between calls, Update() extrapolates the target along its velocity for up to the
+   * horizon, then holds it still, so a target can be followed smoothly from a few commands a
+   * second. Without a velocity or horizon this is a profiled MoveTo().
+   * @param pan Target pan angle in degrees.
+   * @param tilt Target tilt angle in degrees.
+   * @param pan_velocity Target pan velocity in degrees per second.
+   * @param tilt_velocity Target tilt velocity in degrees per second.
+   * @param valid_for_ms How long the velocities may be extrapolated, in milliseconds.
+   */
+  void Track(float pan, float tilt, float pan_velocity, float tilt_velocity, uint32_t valid_for_ms) noexcept;
+
   /**
    * @brief Moves servos to home position (0, 0).
    */
@@ -93,15 +120,16 @@ public:
   void Stop() noexcept;
 
   /**
-   * @brief Starts calibration process.
+   * @brief Runs the calibration process.
    * @details This would normally involve moving servos through their full range
    * to determine limits and center position. For now, it just logs the process.
+   * The servo loop runs the sequence; the caller blocks until it completes.
    */
   void Calibrate() noexcept;
 
   /**
    * @brief Gets the current servo state.
-   * @return Current state.
+   * @return State published by the last update (targets requested since apply at the next).
    */
   [[nodiscard]] ServoState State() const noexcept;
 
@@ -115,15 +143,86 @@ public:
    * @brief Checks if servos are currently moving.
    * @return True if moving.
    */
-  [[nodiscard]] bool IsMoving() const noexcept { return state_.is_moving; }
+  [[nodiscard]] bool IsMoving() const noexcept { return State().is_moving; }
 
   /**
    * @brief Checks if servos are calibrated.
    * @return True if calibrated.
    */
-  [[nodiscard]] bool IsCalibrated() const noexcept { return state_.is_calibrated; }
+  [[nodiscard]] bool IsCalibrated() const noexcept { return State().is_calibrated; }
 
 private:
+  /**
+   * @brief Motion command posted to the servo loop; a newer one replaces one not yet applied.
+   */
+  struct Request {
+    /// What the request asks for.
+    enum class Kind : uint8_t {
+      kNone,   ///< Nothing posted yet.
+      kMove,   ///< Profiled move (MoveTo with smooth).
+      kJump,   ///< Immediate move (MoveTo without smooth).
+      kTrack,  ///< Moving target (Track).
+      kStop,   ///< Stop where the servos are.
+    };
+
+    Kind kind = Kind::kNone;     ///< Requested motion.
+    float pan = 0.0F;            ///< Target pan angle in degrees, as commanded.
+    float tilt = 0.0F;           ///< Target tilt angle in degrees, as commanded.
+    float pan_velocity = 0.0F;   ///< Target pan velocity in degrees per second (kTrack).
+    float tilt_velocity = 0.0F;  ///< Target tilt velocity in degrees per second (kTrack).
+    uint32_t valid_for_ms = 0;   ///< Extrapolation horizon in milliseconds (kTrack).
+  };
+
+  /**
+   * @brief Applies a posted motion request (servo loop).
+   * @param request Request to apply.
+   */
+  void ApplyRequest(const Request& request) noexcept;
+
+  /**
+   * @brief Moves to a target, as MoveTo() requested (servo loop).
+   * @param pan Target pan angle in degrees.
+   * @param tilt Target tilt angle in degrees.
+   * @param smooth Whether to follow the motion profile.
+   */
+  void ApplyMove(float pan, float tilt, bool smooth) noexcept;
+
+  /**
+   * @brief Follows a moving target, as Track() requested (servo loop).
+   * @param request Tracking request.
+   */
+  void ApplyTrack(const Request& request) noexcept;
+
+  /**
+   * @brief Stops where the servos are (servo loop).
+   */
+  void ApplyStop() noexcept;
+
+  /**
+   * @brief Applies a posted configuration (servo loop).
+   * @param config New configuration.
+   */
+  void ApplyConfig(const ServoConfig& config) noexcept;
+
+  /**
+   * @brief Moves to the next calibration pose once the current one has been held (servo loop).
+   * @param delta_time_us Time elapsed since last update in microseconds.
+   */
+  void AdvanceCalibration(uint32_t delta_time_us) noexcept;
+
+  /**
+   * @brief Moves the servos to a pose of the calibration sequence (servo loop).
+   * @param pose Index of the pose.
+   * @return False once past the last pose.
+   */
+  [[nodiscard]] bool ApplyCalibrationPose(uint32_t pose) noexcept;
+
+  /**
+   * @brief Advances both axes along their motion profiles (servo loop).
+   * @param dt Seconds since the previous update.
+   */
+  void AdvanceMotion(float dt) noexcept;
+
   /**
    * @brief Clamps an angle to the specified range.
    * @param angle Angle to clamp.
@@ -136,15 +235,26 @@ private:
   }
 
   /**
-   * @brief Applies smoothing to servo movement.
-   * @param current Current position.
-   * @param target Target position.
-   * @param factor Smoothing factor (0.0 to 1.0).
-   * @return Smoothed position.
+   * @brief Applies the configured limits, scaled by speed and shaped by smoothing, to both profiles.
    */
-  [[nodiscard]] static constexpr float SmoothMove(float current, float target, float factor) noexcept {
-    return current + (target - current) * factor;
-  }
+  void ApplyMotionLimits() noexcept;
+
+  /**
+   * @brief Logs the motion limits in effect.
+   */
+  void LogMotionLimits() const noexcept;
+
+  /**
+   * @brief Checks whether either target is still being extrapolated.
+   * @return True while tracking.
+   */
+  [[nodiscard]] bool IsTracking() const noexcept { return pan_track_.Extrapolating() || tilt_track_.Extrapolating(); }
+
+  /**
+   * @brief Advances the extrapolated targets and aims the profiles at them.
+   * @param dt Seconds since the previous update.
+   */
+  void AdvanceTracks(float dt) noexcept;
 
   /**
    * @brief Logs servo movement.
@@ -190,10 +300,19 @@ private:
    */
   void ApplyServoPositions() noexcept;
 
+  // Servo loop state (Initialize() and the servo loop only)
   ServoConfig config_;
   ServoState state_;
-  bool initialized_ = false;
+  MotionProfile pan_profile_;
+  MotionProfile tilt_profile_;
+  TargetPredictor pan_track_;
+  TargetPredictor tilt_track_;
   uint64_t last_move_time_ = 0;
+  uint32_t applied_request_ = 0;      ///< Version of the last request applied.
+  uint32_t applied_config_ = 0;       ///< Version of the last configuration applied.
+  bool calibration_running_ = false;  ///< Whether the loop is running the calibration sequence.
+  uint32_t calibration_pose_ = 0;     ///< Index of the pose being held.
+  uint32_t calibration_held_us_ = 0;  ///< How long the pose has been held.
   mcpwm_timer_handle_t pan_timer_ = nullptr;
   mcpwm_timer_handle_t tilt_timer_ = nullptr;
   mcpwm_oper_handle_t pan_operator_ = nullptr;
@@ -202,6 +321,13 @@ private:
   mcpwm_cmpr_handle_t tilt_comparator_ = nullptr;
   mcpwm_gen_handle_t pan_generator_ = nullptr;
   mcpwm_gen_handle_t tilt_generator_ = nullptr;
+
+  // Shared between the command methods and the servo loop
+  std::atomic<bool> initialized_{false};
+  std::atomic<bool> calibration_requested_{false};  ///< Set by Calibrate(), cleared once the sequence completes.
+  Mailbox<Request> requests_;                       ///< Latest motion request.
+  Mailbox<ServoConfig> configs_;                    ///< Latest configuration from UpdateConfig().
+  Mailbox<ServoState> published_;                   ///< State as of the last update.
 };
 
 }  // namespace embedded
@@ -0,0 +1,98 @@
+/**
+ * @file target_predictor.hpp
+ * @brief Extrapolation of a moving servo target between sparse commands
+ *
+ * A MOVE may carry the velocity of its target and a horizon for which that velocity holds. Between
+ * commands the predictor moves the target along the velocity at the servo update rate, so the
+ * client can send commands at a fraction of its frame rate and a late or lost one does not stall
+ * the axis. Past the horizon the target holds still, so a client that goes quiet never sends the
+ * axis on to a limit.
+ */
+
+#pragma once
+
+#include <motion_profile.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace embedded {
+
+/**
+ * @brief Target of one axis, extrapolated from the last command.
+ * @note Not thread-safe.
+ */
+class TargetPredictor final {
+public:
+  /**
+   * @brief Starts extrapolating from a new command.
+   * @param position Commanded target in degrees
+   * @param velocity Target velocity in degrees per second
+   * @param horizon Seconds for which the velocity holds (0 = position only)
+   */
+  constexpr void Set(float position, float velocity, float horizon) noexcept {
+    position_ = position;
+    horizon_ = horizon > 0.0F ? horizon : 0.0F;
+    velocity_ = horizon_ > 0.0F ? velocity : 0.0F;
+    age_ = 0.0F;
+  }
+
+  /**
+   * @brief Holds the target still at a position.
+   * @param position Target in degrees
+   */
+  constexpr void Hold(float position) noexcept { Set(position, 0.0F, 0.0F); }
+
+  /**
+   * @brief Advances the time since the last command.
+   * @param dt Seconds since the previous call (ignored unless positive)
+   */
+  constexpr void Advance(float dt) noexcept {
+    if (dt > 0.0F) {
+      age_ = std::min(age_ + dt, horizon_);
+    }
+  }
+
+  /**
+   * @brief Gets the extrapolated target.
+   * @return Target in degrees
+   */
+  [[nodiscard]] constexpr float Target() const noexcept { return position_ + velocity_ * age_; }
+
+  /**
+   * @brief Gets where a profile should head to follow the target.
+   * @details Following a moving target, a profile that plans to stop on it trails it by its
+   * stopping distance. Aiming the same distance ahead along the velocity (but never past the
+   * horizon) cancels that lag on a steady track, and still lands on the target once it holds.
+   * @param profile Profile of the axis
+   * @return Position in degrees
+   */
+  [[nodiscard]] float Aim(const MotionProfile& profile) const noexcept {
+    if (!Extrapolating()) {
+      return Target();
+    }
+    const float speed = std::min(std::abs(velocity_), profile.Limits().max_velocity);
+    const float lead = speed > 0.0F ? std::abs(profile.StoppingDistance(speed)) / std::abs(velocity_) : 0.0F;
+    return position_ + velocity_ * std::min(age_ + lead, horizon_);
+  }
+
+  /**
+   * @brief Checks whether the target is still moving.
+   * @return True until the horizon of a command with a velocity runs out
+   */
+  [[nodiscard]] constexpr bool Extrapolating() const noexcept { return velocity_ != 0.0F && age_ < horizon_; }
+
+  /**
+   * @brief Gets the target velocity.
+   * @return Degrees per second, 0 once the target holds
+   */
+  [[nodiscard]] constexpr float Velocity() const noexcept { return Extrapolating() ? velocity_ : 0.0F; }
+
+private:
+  float position_ = 0.0F;  ///< Commanded target in degrees.
+  float velocity_ = 0.0F;  ///< Target velocity in degrees per second.
+  float horizon_ = 0.0F;   ///< Seconds for which the velocity holds.
+  float age_ = 0.0F;       ///< Seconds since the command, at most horizon_.
+};
+
+}  // namespace embedded
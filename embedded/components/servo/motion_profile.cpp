@@ -0,0 +1,195 @@
+/**
+ * @file motion_profile.cpp
+ * @brief Online trapezoidal and S-curve motion profiles for one servo axis
+ */
+
+#include "include/motion_profile.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace embedded {
+
+namespace {
+
+constexpr float kSettleTolerance = 0.01F;  ///< Stops ending this close to the target commit to braking (degrees).
+constexpr int kSwitchIterations = 16;      ///< Bisection steps locating a phase change within a step.
+constexpr float kCruiseFraction = 0.999F;  ///< Fraction of the velocity limit that counts as cruising.
+
+/// Advances a state under constant jerk.
+void Integrate(MotionState& state, float jerk, float t) noexcept {
+  state.position += t * (state.velocity + t * (state.acceleration * 0.5F + t * jerk * (1.0F / 6.0F)));
+  state.velocity += t * (state.acceleration + t * jerk * 0.5F);
+  state.acceleration += t * jerk;
+}
+
+}  // namespace
+
+void MotionProfile::SetTarget(float target) noexcept {
+  target_ = target;
+  moving_ = true;
+}
+
+void MotionProfile::Reset(float position) noexcept {
+  state_ = {.position = position};
+  target_ = position;
+  moving_ = false;
+}
+
+template <typename Move>
+float MotionProfile::Advance(float dt, const Move& move) noexcept {
+  MotionState next = state_;
+  if (move(next, dt)) {
+    state_ = next;
+    return dt;
+  }
+
+  // The move holds at the start of the step and fails at its end: find where it stops holding
+  float lo = 0.0F;
+  float hi = dt;
+  for (int i = 0; i < kSwitchIterations; ++i) {
+    const float mid = 0.5F * (lo + hi);
+    next = state_;
+    if (move(next, mid)) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  next = state_;
+  if (lo > 0.0F && move(next, lo)) {
+    state_ = next;
+    return lo;
+  }
+  return 0.0F;
+}
+
+const MotionState& MotionProfile::Step(float dt) noexcept {
+  if (!moving_ || !(dt > 0.0F)) {
+    return state_;
+  }
+
+  const float stop = StoppingPosition(state_);
+  if (std::abs(target_ - stop) > kSettleTolerance) {
+    const float direction = target_ > stop ? 1.0F : -1.0F;
+    const auto short_of_target = [this, direction](const MotionState& state) {
+      return direction * (target_ - StoppingPosition(state)) >= 0.0F;
+    };
+
+    // Accelerate for as much of the step as the limits allow (nothing to gain once at the velocity limit)
+    if (direction * SettledVelocity(state_) < limits_.max_velocity * kCruiseFraction) {
+      dt -= Advance(dt, [this, direction, &short_of_target](MotionState& state, float t) {
+        return Accelerate(state, direction, t) && short_of_target(state);
+      });
+    }
+
+    // Then coast (or shed speed if the limits were lowered mid-move) until braking has to start
+    if (dt > 0.0F) {
+      const float coast =
+          direction * state_.velocity > limits_.max_velocity ? -direction * limits_.max_acceleration : 0.0F;
+      dt -= Advance(dt, [this, coast, &short_of_target](MotionState& state, float t) {
+        Ramp(state, coast, t);
+        return short_of_target(state);
+      });
+    }
+  }
+  if (!(dt > 0.0F)) {
+    return state_;
+  }
+
+  // Brake along the shortest stop, which ends at rest on (or just short of) the target
+  for (const Segment& segment : PlanBrake(state_)) {
+    const float t = std::min(dt, segment.duration);
+    Ramp(state_, segment.acceleration, t);
+    dt -= t;
+  }
+  if (dt > 0.0F) {
+    state_.velocity = 0.0F;
+    state_.acceleration = 0.0F;
+    if (std::abs(target_ - state_.position) <= kSettleTolerance) {
+      Finish();
+    }
+  }
+  return state_;
+}
+
+float MotionProfile::StoppingPosition() const noexcept {
+  return StoppingPosition(state_);
+}
+
+float MotionProfile::StoppingDistance(float velocity) const noexcept {
+  return StoppingPosition(MotionState{.velocity = velocity});
+}
+
+MotionProfile::Brake MotionProfile::PlanBrake(const MotionState& state) const noexcept {
+  const float jerk = limits_.max_jerk;
+  const float max_acceleration = limits_.max_acceleration;
+  const float a = state.acceleration;
+  const float settled = SettledVelocity(state);
+  if (settled == 0.0F) {
+    return {{{.acceleration = 0.0F, .duration = jerk > 0.0F ? std::abs(a) / jerk : 0.0F}, {}}};
+  }
+
+  // Mirror so that the axis moves in the positive direction and brakes with negative acceleration
+  const float sign = settled > 0.0F ? 1.0F : -1.0F;
+  const float v = sign * state.velocity;
+  const float mirrored = sign * a;
+  if (!(jerk > 0.0F)) {
+    return {{{.acceleration = -sign * max_acceleration, .duration = v / max_acceleration}, {}}};
+  }
+
+  // Triangular deceleration if it stops in time, otherwise hold the limit in between
+  float peak = std::sqrt(jerk * v + 0.5F * mirrored * mirrored);
+  float hold = 0.0F;
+  if (peak > max_acceleration) {
+    hold = (v + mirrored * mirrored / (2.0F * jerk) - max_acceleration * max_acceleration / jerk) / max_acceleration;
+    peak = max_acceleration;
+  }
+  return {{{.acceleration = -sign * peak, .duration = std::max(0.0F, (mirrored + peak) / jerk) + hold},
+           {.acceleration = 0.0F, .duration = peak / jerk}}};
+}
+
+float MotionProfile::StoppingPosition(const MotionState& state) const noexcept {
+  MotionState stop = state;
+  for (const Segment& segment : PlanBrake(state)) {
+    Ramp(stop, segment.acceleration, segment.duration);
+  }
+  return stop.position;
+}
+
+bool MotionProfile::Accelerate(MotionState& state, float direction, float dt) const noexcept {
+  Ramp(state, direction * limits_.max_acceleration, dt);
+  // Ramping the acceleration down from here must not carry the axis past the velocity limit
+  return direction * SettledVelocity(state) <= limits_.max_velocity;
+}
+
+float MotionProfile::SettledVelocity(const MotionState& state) const noexcept {
+  const float jerk = limits_.max_jerk;
+  const float a = state.acceleration;
+  return jerk > 0.0F ? state.velocity + a * std::abs(a) / (2.0F * jerk) : state.velocity;
+}
+
+void MotionProfile::Ramp(MotionState& state, float acceleration, float dt) const noexcept {
+  if (!(dt > 0.0F)) {
+    return;
+  }
+  const float jerk = limits_.max_jerk;
+  if (jerk > 0.0F) {
+    const float change = acceleration - state.acceleration;
+    const float ramp = std::min(dt, std::abs(change) / jerk);
+    Integrate(state, std::copysign(jerk, change), ramp);
+    if (ramp >= dt) {
+      return;
+    }
+    dt -= ramp;
+  }
+  state.acceleration = acceleration;
+  Integrate(state, 0.0F, dt);
+}
+
+void MotionProfile::Finish() noexcept {
+  state_ = {.position = target_};
+  moving_ = false;
+}
+
+}  // namespace embedded
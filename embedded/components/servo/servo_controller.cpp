@@ -12,24 +12,37 @@
 #include <freertos/task.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 
 namespace embedded {
 
 namespace {
 constexpr const char* kTag = "servo";
-constexpr float kMinMovement = 0.1F;           // Minimum movement threshold in degrees
-constexpr uint32_t kServoPwmFrequency = 50;    // 50Hz for standard servos
-constexpr uint32_t kServoPwmPeriodUs = 20000;  // 20ms period (1/50Hz)
+constexpr float kMinMovement = 0.1F;              // Minimum movement threshold in degrees
+constexpr uint32_t kServoPwmFrequency = 50;       // 50Hz for standard servos
+constexpr uint32_t kServoPwmPeriodUs = 20000;     // 20ms period (1/50Hz)
+constexpr uint32_t kMaxTrackHorizonMs = 1000;     // Longest a MOVE velocity is extrapolated
+constexpr uint32_t kCalibrationHoldUs = 500000;   // How long each calibration pose is held
+constexpr uint32_t kCalibrationPollMs = 10;       // How often Calibrate() checks for completion
+constexpr uint32_t kCalibrationTimeoutMs = 5000;  // How long Calibrate() waits for the servo loop
+
+/// One position of the calibration sequence.
+struct CalibrationPose {
+  float pan = 0.0F;
+  float tilt = 0.0F;
+  const char* step = nullptr;  ///< Logged when the pose starts a new step.
+};
 }  // namespace
 
 esp_err_t ServoController::Initialize(const ServoConfig& config) noexcept {
-  if (initialized_) {
+  if (initialized_.load(std::memory_order_acquire)) {
     ESP_LOGW(kTag, "Servo controller already initialized");
     return ESP_OK;
   }
 
   config_ = config;
+  ApplyMotionLimits();
 
   // Create MCPWM timer for pan servo
   ESP_LOGI(kTag, "Initializing pan servo on GPIO %d", config_.pan_gpio);
@@ -189,8 +202,13 @@ esp_err_t ServoController::Initialize(const ServoConfig& config) noexcept {
   state_.target_pan = 0.0F;
   state_.target_tilt = 0.0F;
   state_.is_moving = false;
-  state_.is_calibrated = true;
-  initialized_ = true;
+  state_.is_calibrated = false;  // Until the calibration sequence has run (see AdvanceCalibration())
+  pan_profile_.Reset(0.0F);
+  tilt_profile_.Reset(0.0F);
+  pan_track_.Hold(0.0F);
+  tilt_track_.Hold(0.0F);
+  published_.Store(state_);
+  initialized_.store(true, std::memory_order_release);
   last_move_time_ = esp_timer_get_time() / 1000ULL;
 
   // Move servos to home position (center)
@@ -204,6 +222,7 @@ esp_err_t ServoController::Initialize(const ServoConfig& config) noexcept {
            static_cast<double>(config_.tilt_max));
   ESP_LOGI(kTag, "  Speed: %.2f, Smoothing: %.2f, Dead zone: %.2f deg", static_cast<double>(config_.speed),
            static_cast<double>(config_.smoothing), static_cast<double>(config_.dead_zone));
+  LogMotionLimits();
   ESP_LOGI(kTag, "  Pulse range: [%lu, %lu] us, Center: %lu us", static_cast<unsigned long>(config_.servo_min_pulse_us),
            static_cast<unsigned long>(config_.servo_max_pulse_us),
            static_cast<unsigned long>(config_.servo_center_pulse_us));
@@ -211,52 +230,134 @@ esp_err_t ServoController::Initialize(const ServoConfig& config) noexcept {
   return ESP_OK;
 }
 
-void ServoController::Update(uint32_t delta_time_ms) noexcept {
-  if (!initialized_ || !state_.is_moving) {
+void ServoController::Update(uint32_t delta_time_us) noexcept {
+  if (!initialized_.load(std::memory_order_acquire)) {
     return;
   }
 
-  // Calculate smoothing factor based on speed and delta time
-  const float time_factor = static_cast<float>(delta_time_ms) / 20.0F;  // Normalized to 20ms updates
-  const float smooth_factor = config_.smoothing * config_.speed * time_factor;
+  // Requests posted since the previous update. TryLoad() rather than Load(): the command task may
+  // be preempted by this loop halfway through a post, which is then picked up next update.
+  ServoConfig config;
+  uint32_t version = 0;
+  if (configs_.Version() != applied_config_ && configs_.TryLoad(config, version)) {
+    applied_config_ = version;
+    ApplyConfig(config);
+  }
+  Request request;
+  if (!calibration_running_ && requests_.Version() != applied_request_ && requests_.TryLoad(request, version)) {
+    applied_request_ = version;
+    ApplyRequest(request);
+  }
 
-  // Apply smoothing to pan
-  const float new_pan = SmoothMove(state_.pan, state_.target_pan, smooth_factor);
-  const float new_tilt = SmoothMove(state_.tilt, state_.target_tilt, smooth_factor);
+  if (calibration_running_) {
+    AdvanceCalibration(delta_time_us);
+  } else if (calibration_requested_.load(std::memory_order_acquire)) {
+    ESP_LOGI(kTag, "Starting calibration sequence...");
+    calibration_running_ = true;
+    calibration_pose_ = 0;
+    calibration_held_us_ = 0;
+    state_.is_moving = true;
+    (void)ApplyCalibrationPose(0);
+  } else if (state_.is_moving) {
+    AdvanceMotion(static_cast<float>(delta_time_us) / 1e6F);
+  }
 
-  // Check if we've reached the target (within dead zone)
-  const float pan_diff = std::abs(new_pan - state_.target_pan);
-  const float tilt_diff = std::abs(new_tilt - state_.target_tilt);
+  published_.Store(state_);
+}
 
-  if (pan_diff < kMinMovement && tilt_diff < kMinMovement) {
-    // Reached target
-    state_.pan = state_.target_pan;
-    state_.tilt = state_.target_tilt;
-    state_.is_moving = false;
-    ApplyServoPositions();
-    ESP_LOGI(kTag, "Servos reached target position: pan=%.2f deg, tilt=%.2f deg", static_cast<double>(state_.pan),
-             static_cast<double>(state_.tilt));
-  } else {
-    // Still moving
-    const bool position_changed =
-        std::abs(new_pan - state_.pan) > kMinMovement || std::abs(new_tilt - state_.tilt) > kMinMovement;
+void ServoController::MoveTo(float pan, float tilt, bool smooth) noexcept {
+  if (!initialized_.load(std::memory_order_acquire)) {
+    ESP_LOGW(kTag, "Cannot move servos: not initialized");
+    return;
+  }
 
-    state_.pan = new_pan;
-    state_.tilt = new_tilt;
+  ESP_LOGI(kTag, "Servos %s: pan=%.2f deg, tilt=%.2f deg", smooth ? "moving to target" : "moving immediately to",
+           static_cast<double>(pan), static_cast<double>(tilt));
+  requests_.Store({.kind = smooth ? Request::Kind::kMove : Request::Kind::kJump, .pan = pan, .tilt = tilt});
+}
 
-    if (position_changed) {
-      ApplyServoPositions();
-      LogServoMove(state_.pan, state_.tilt);
-    }
+void ServoController::Track(float pan, float tilt, float pan_velocity, float tilt_velocity,
+                            uint32_t valid_for_ms) noexcept {
+  if ((pan_velocity == 0.0F && tilt_velocity == 0.0F) || valid_for_ms == 0) {
+    MoveTo(pan, tilt, true);
+    return;
+  }
+  if (!initialized_.load(std::memory_order_acquire)) {
+    ESP_LOGW(kTag, "Cannot move servos: not initialized");
+    return;
   }
+
+  // Tracking commands arrive several times a second, so unlike MoveTo() this does not log at info level
+  ESP_LOGD(kTag, "Servos tracking: pan=%.2f deg at %.2f deg/s, tilt=%.2f deg at %.2f deg/s for %lu ms",
+           static_cast<double>(pan), static_cast<double>(pan_velocity), static_cast<double>(tilt),
+           static_cast<double>(tilt_velocity), static_cast<unsigned long>(valid_for_ms));
+  requests_.Store({.kind = Request::Kind::kTrack,
+                   .pan = pan,
+                   .tilt = tilt,
+                   .pan_velocity = pan_velocity,
+                   .tilt_velocity = tilt_velocity,
+                   .valid_for_ms = valid_for_ms});
 }
 
-void ServoController::MoveTo(float pan, float tilt, bool smooth) noexcept {
-  if (!initialized_) {
-    ESP_LOGW(kTag, "Cannot move servos: not initialized");
+void ServoController::Home() noexcept {
+  ESP_LOGI(kTag, "Moving servos to home position");
+  MoveTo(0.0F, 0.0F, true);
+}
+
+void ServoController::Stop() noexcept {
+  if (!initialized_.load(std::memory_order_acquire)) {
     return;
   }
 
+  ESP_LOGI(kTag, "Stopping servo movement");
+  requests_.Store({.kind = Request::Kind::kStop});
+}
+
+void ServoController::Calibrate() noexcept {
+  if (!initialized_.load(std::memory_order_acquire)) {
+    ESP_LOGW(kTag, "Cannot calibrate: not initialized");
+    return;
+  }
+
+  calibration_requested_.store(true, std::memory_order_release);
+  const TickType_t start = xTaskGetTickCount();
+  while (calibration_requested_.load(std::memory_order_acquire)) {
+    if (xTaskGetTickCount() - start > pdMS_TO_TICKS(kCalibrationTimeoutMs)) {
+      ESP_LOGW(kTag, "Calibration still running after %lu ms, not waiting for it",
+               static_cast<unsigned long>(kCalibrationTimeoutMs));
+      return;
+    }
+    vTaskDelay(pdMS_TO_TICKS(kCalibrationPollMs));
+  }
+}
+
+ServoState ServoController::State() const noexcept {
+  return published_.Load();
+}
+
+void ServoController::UpdateConfig(const ServoConfig& config) noexcept {
+  configs_.Store(config);
+}
+
+void ServoController::ApplyRequest(const Request& request) noexcept {
+  switch (request.kind) {
+    case Request::Kind::kMove:
+    case Request::Kind::kJump:
+      ApplyMove(request.pan, request.tilt, request.kind == Request::Kind::kMove);
+      break;
+    case Request::Kind::kTrack:
+      ApplyTrack(request);
+      break;
+    case Request::Kind::kStop:
+      ApplyStop();
+      break;
+    case Request::Kind::kNone:
+      break;
+  }
+  last_move_time_ = esp_timer_get_time() / 1000ULL;
+}
+
+void ServoController::ApplyMove(float pan, float tilt, bool smooth) noexcept {
   // Apply inversion
   if (config_.invert_pan) {
     pan = -pan;
@@ -269,15 +370,18 @@ void ServoController::MoveTo(float pan, float tilt, bool smooth) noexcept {
   pan = ClampAngle(pan, config_.pan_min, config_.pan_max);
   tilt = ClampAngle(tilt, config_.tilt_min, config_.tilt_max);
 
-  // Check dead zone
-  const float pan_diff = std::abs(pan - state_.pan);
-  const float tilt_diff = std::abs(tilt - state_.tilt);
+  // Check dead zone (against the target, so a retarget during a move is never dropped). A move that
+  // ends tracking always applies, since the profiles may be aiming ahead of the target.
+  const float pan_diff = std::abs(pan - state_.target_pan);
+  const float tilt_diff = std::abs(tilt - state_.target_tilt);
 
-  if (pan_diff < config_.dead_zone && tilt_diff < config_.dead_zone) {
+  if (!IsTracking() && pan_diff < config_.dead_zone && tilt_diff < config_.dead_zone) {
     ESP_LOGD(kTag, "Movement within dead zone, ignoring");
     return;
   }
 
+  pan_track_.Hold(pan);
+  tilt_track_.Hold(tilt);
   state_.target_pan = pan;
   state_.target_tilt = tilt;
 
@@ -286,99 +390,174 @@ void ServoController::MoveTo(float pan, float tilt, bool smooth) noexcept {
     state_.pan = pan;
     state_.tilt = tilt;
     state_.is_moving = false;
+    pan_profile_.Reset(pan);
+    tilt_profile_.Reset(tilt);
     ApplyServoPositions();
     LogServoMove(state_.pan, state_.tilt);
-    ESP_LOGI(kTag, "Servos moved immediately to: pan=%.2f deg, tilt=%.2f deg", static_cast<double>(state_.pan),
-             static_cast<double>(state_.tilt));
   } else {
-    // Smooth movement
+    // Profiled movement, replanned from the current velocity if already moving
+    pan_profile_.SetTarget(pan);
+    tilt_profile_.SetTarget(tilt);
     state_.is_moving = true;
-    ESP_LOGI(kTag, "Servos moving to target: pan=%.2f deg, tilt=%.2f deg", static_cast<double>(pan),
-             static_cast<double>(tilt));
   }
-
-  last_move_time_ = esp_timer_get_time() / 1000ULL;
 }
 
-void ServoController::Home() noexcept {
-  ESP_LOGI(kTag, "Moving servos to home position");
-  MoveTo(0.0F, 0.0F, true);
-}
+void ServoController::ApplyTrack(const Request& request) noexcept {
+  float pan = request.pan;
+  float tilt = request.tilt;
+  float pan_velocity = request.pan_velocity;
+  float tilt_velocity = request.tilt_velocity;
 
-void ServoController::Stop() noexcept {
-  if (!initialized_) {
-    return;
+  // Apply inversion (the velocity turns with the axis)
+  if (config_.invert_pan) {
+    pan = -pan;
+    pan_velocity = -pan_velocity;
+  }
+  if (config_.invert_tilt) {
+    tilt = -tilt;
+    tilt_velocity = -tilt_velocity;
   }
 
-  ESP_LOGI(kTag, "Stopping servo movement");
+  // Extrapolated targets are clamped as they move, so a target outside the range may still head into it
+  const float horizon = static_cast<float>(std::min(request.valid_for_ms, kMaxTrackHorizonMs)) / 1000.0F;
+  pan_track_.Set(pan, pan_velocity, horizon);
+  tilt_track_.Set(tilt, tilt_velocity, horizon);
+  AdvanceTracks(0.0F);
+  state_.is_moving = true;
+}
+
+void ServoController::ApplyStop() noexcept {
   state_.target_pan = state_.pan;
   state_.target_tilt = state_.tilt;
   state_.is_moving = false;
+  pan_profile_.Reset(state_.pan);
+  tilt_profile_.Reset(state_.tilt);
+  pan_track_.Hold(state_.pan);
+  tilt_track_.Hold(state_.tilt);
 }
 
-void ServoController::Calibrate() noexcept {
-  if (!initialized_) {
-    ESP_LOGW(kTag, "Cannot calibrate: not initialized");
+void ServoController::ApplyConfig(const ServoConfig& config) noexcept {
+  config_ = config;
+  ApplyMotionLimits();
+  ESP_LOGI(kTag, "Servo configuration updated");
+  ESP_LOGI(kTag, "  Speed: %.2f, Smoothing: %.2f, Dead zone: %.2f deg", static_cast<double>(config_.speed),
+           static_cast<double>(config_.smoothing), static_cast<double>(config_.dead_zone));
+  LogMotionLimits();
+}
+
+void ServoController::AdvanceCalibration(uint32_t delta_time_us) noexcept {
+  // Each pose is held for kCalibrationHoldUs before moving to the next
+  calibration_held_us_ += delta_time_us;
+  if (calibration_held_us_ < kCalibrationHoldUs) {
     return;
   }
+  calibration_held_us_ = 0;
+  if (ApplyCalibrationPose(++calibration_pose_)) {
+    return;
+  }
+
+  // Update state
+  state_.target_pan = 0.0F;
+  state_.target_tilt = 0.0F;
+  state_.is_moving = false;
+  state_.is_calibrated = true;
+  pan_profile_.Reset(0.0F);
+  tilt_profile_.Reset(0.0F);
+  pan_track_.Hold(0.0F);
+  tilt_track_.Hold(0.0F);
+  calibration_running_ = false;
+  calibration_requested_.store(false, std::memory_order_release);
 
-  ESP_LOGI(kTag, "Starting calibration sequence...");
+  ESP_LOGI(kTag, "Calibration complete!");
+}
 
+bool ServoController::ApplyCalibrationPose(uint32_t pose) noexcept {
   // Move through key positions to test servo range
-  ESP_LOGI(kTag, "[Calibration] Step 1: Moving to center position");
-  state_.pan = 0.0F;
-  state_.tilt = 0.0F;
-  ApplyServoPositions();
-  LogServoMove(state_.pan, state_.tilt);
-  vTaskDelay(pdMS_TO_TICKS(500));
-
-  ESP_LOGI(kTag, "[Calibration] Step 2: Testing pan range");
-  state_.pan = config_.pan_max;
-  ApplyServoPositions();
-  LogServoMove(state_.pan, state_.tilt);
-  vTaskDelay(pdMS_TO_TICKS(500));
+  const std::array<CalibrationPose, 6> poses = {{
+      {.pan = 0.0F, .tilt = 0.0F, .step = "Step 1: Moving to center position"},
+      {.pan = config_.pan_max, .tilt = 0.0F, .step = "Step 2: Testing pan range"},
+      {.pan = config_.pan_min, .tilt = 0.0F, .step = nullptr},
+      {.pan = 0.0F, .tilt = config_.tilt_max, .step = "Step 3: Testing tilt range"},
+      {.pan = 0.0F, .tilt = config_.tilt_min, .step = nullptr},
+      {.pan = 0.0F, .tilt = 0.0F, .step = "Step 4: Returning to center"},
+  }};
+  if (pose >= poses.size()) {
+    return false;
+  }
 
-  state_.pan = config_.pan_min;
+  if (poses[pose].step != nullptr) {
+    ESP_LOGI(kTag, "[Calibration] %s", poses[pose].step);
+  }
+  state_.pan = poses[pose].pan;
+  state_.tilt = poses[pose].tilt;
   ApplyServoPositions();
   LogServoMove(state_.pan, state_.tilt);
-  vTaskDelay(pdMS_TO_TICKS(500));
+  return true;
+}
 
-  ESP_LOGI(kTag, "[Calibration] Step 3: Testing tilt range");
-  state_.pan = 0.0F;
-  state_.tilt = config_.tilt_max;
-  ApplyServoPositions();
-  LogServoMove(state_.pan, state_.tilt);
-  vTaskDelay(pdMS_TO_TICKS(500));
+void ServoController::AdvanceMotion(float dt) noexcept {
+  if (IsTracking()) {
+    AdvanceTracks(dt);
+  }
+  const float new_pan = pan_profile_.Step(dt).position;
+  const float new_tilt = tilt_profile_.Step(dt).position;
 
-  state_.tilt = config_.tilt_min;
-  ApplyServoPositions();
-  LogServoMove(state_.pan, state_.tilt);
-  vTaskDelay(pdMS_TO_TICKS(500));
+  if (pan_profile_.Done() && tilt_profile_.Done() && !IsTracking()) {
+    // Reached target
+    state_.pan = new_pan;
+    state_.tilt = new_tilt;
+    state_.is_moving = false;
+    ApplyServoPositions();
+    ESP_LOGI(kTag, "Servos reached target position: pan=%.2f deg, tilt=%.2f deg", static_cast<double>(state_.pan),
+             static_cast<double>(state_.tilt));
+  } else {
+    // Still moving; logged at debug level only, at the loop rate this would flood the console
+    const bool position_changed =
+        std::abs(new_pan - state_.pan) > kMinMovement || std::abs(new_tilt - state_.tilt) > kMinMovement;
 
-  ESP_LOGI(kTag, "[Calibration] Step 4: Returning to center");
-  state_.pan = 0.0F;
-  state_.tilt = 0.0F;
-  ApplyServoPositions();
-  LogServoMove(state_.pan, state_.tilt);
+    state_.pan = new_pan;
+    state_.tilt = new_tilt;
+    ApplyServoPositions();
 
-  // Update state
-  state_.target_pan = 0.0F;
-  state_.target_tilt = 0.0F;
-  state_.is_moving = false;
-  state_.is_calibrated = true;
+    if (position_changed) {
+      ESP_LOGD(kTag, "Servos moving: pan=%.2f deg, tilt=%.2f deg", static_cast<double>(state_.pan),
+               static_cast<double>(state_.tilt));
+    }
+  }
+}
 
-  ESP_LOGI(kTag, "Calibration complete!");
+void ServoController::ApplyMotionLimits() noexcept {
+  const float speed = config_.speed > 0.0F ? std::min(config_.speed, 1.0F) : 1.0F;
+  const auto scaled = [this, speed](MotionLimits limits) {
+    limits.max_velocity *= speed;
+    limits.max_acceleration *= speed;
+    if (config_.smoothing <= 0.0F) {
+      limits.max_jerk = 0.0F;
+    }
+    return limits;
+  };
+  pan_profile_.SetLimits(scaled(config_.pan_limits));
+  tilt_profile_.SetLimits(scaled(config_.tilt_limits));
 }
 
-ServoState ServoController::State() const noexcept {
-  return state_;
+void ServoController::LogMotionLimits() const noexcept {
+  const MotionLimits& pan = pan_profile_.Limits();
+  const MotionLimits& tilt = tilt_profile_.Limits();
+  ESP_LOGI(kTag, "  Pan limits: %.0f deg/s, %.0f deg/s^2, %.0f deg/s^3 (%s)", static_cast<double>(pan.max_velocity),
+           static_cast<double>(pan.max_acceleration), static_cast<double>(pan.max_jerk),
+           pan.max_jerk > 0.0F ? "S-curve" : "trapezoidal");
+  ESP_LOGI(kTag, "  Tilt limits: %.0f deg/s, %.0f deg/s^2, %.0f deg/s^3 (%s)", static_cast<double>(tilt.max_velocity),
+           static_cast<double>(tilt.max_acceleration), static_cast<double>(tilt.max_jerk),
+           tilt.max_jerk > 0.0F ? "S-curve" : "trapezoidal");
 }
 
-void ServoController::UpdateConfig(const ServoConfig& config) noexcept {
-  config_ = config;
-  ESP_LOGI(kTag, "Servo configuration updated");
-  ESP_LOGI(kTag, "  Speed: %.2f, Smoothing: %.2f, Dead zone: %.2f deg", static_cast<double>(config_.speed),
-           static_cast<double>(config_.smoothing), static_cast<double>(config_.dead_zone));
+void ServoController::AdvanceTracks(float dt) noexcept {
+  pan_track_.Advance(dt);
+  tilt_track_.Advance(dt);
+  state_.target_pan = ClampAngle(pan_track_.Target(), config_.pan_min, config_.pan_max);
+  state_.target_tilt = ClampAngle(tilt_track_.Target(), config_.tilt_min, config_.tilt_max);
+  pan_profile_.SetTarget(ClampAngle(pan_track_.Aim(pan_profile_), config_.pan_min, config_.pan_max));
+  tilt_profile_.SetTarget(ClampAngle(tilt_track_.Aim(tilt_profile_), config_.tilt_min, config_.tilt_max));
 }
 
 void ServoController::LogServoMove(float pan, float tilt) const noexcept {
@@ -391,7 +570,7 @@ esp_err_t ServoController::SetServoPulse(mcpwm_cmpr_handle_t comparator, uint32_
 }
 
 void ServoController::ApplyServoPositions() noexcept {
-  if (!initialized_) {
+  if (!initialized_.load(std::memory_order_relaxed)) {
     return;
   }
 
@@ -0,0 +1,157 @@
+/**
+ * @file packet_ring.hpp
+ * @brief Lock-free single-producer, single-consumer ring of byte packets
+ *
+ * Bluedroid raises SPP data events on its own task, which also runs the rest of the Bluetooth
+ * stack; anything slow in the callback stalls the link. The callback only copies each data event
+ * into this ring and a command task decodes it. Packets keep their boundaries and order, and a
+ * packet that does not fit is dropped whole and counted, never waited for: the frame delimiters
+ * let the decoder resynchronise after the gap.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace embedded {
+
+/**
+ * @brief Counters of a PacketRing since it was created.
+ */
+struct PacketRingStats {
+  uint32_t pushed = 0;          ///< Packets accepted.
+  uint32_t rejected = 0;        ///< Packets dropped because the ring was full or they were too large.
+  uint32_t rejected_bytes = 0;  ///< Bytes in the dropped packets.
+  uint32_t high_water = 0;      ///< Most bytes held at once, headers included.
+};
+
+/**
+ * @brief Ring of byte packets, pushed by one task and popped by another.
+ * @details Each packet is stored as a 16-bit length followed by its bytes. The producer publishes
+ * a packet by advancing the head after copying it, the consumer frees it by advancing the tail
+ * after copying it out, so neither side ever waits for the other.
+ * @tparam Capacity Storage in bytes, a power of two
+ * @tparam MaxPacketSize Largest packet accepted
+ * @note Push() must be called from one task only, Pop() from one (other) task only.
+ */
+template <size_t Capacity, size_t MaxPacketSize>
+class PacketRing final {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+  static_assert(Capacity <= UINT32_MAX / 2, "Indices must not wrap within the ring");
+
+public:
+  /// Bytes stored ahead of each packet.
+  static constexpr size_t kHeaderSize = sizeof(uint16_t);
+
+  static_assert(MaxPacketSize > 0 && MaxPacketSize <= UINT16_MAX, "Packet sizes are stored in 16 bits");
+  static_assert(kHeaderSize + MaxPacketSize <= Capacity, "The largest packet must fit in an empty ring");
+
+  PacketRing() noexcept = default;
+  PacketRing(const PacketRing&) = delete;
+  PacketRing(PacketRing&&) = delete;
+  ~PacketRing() = default;
+
+  PacketRing& operator=(const PacketRing&) = delete;
+  PacketRing& operator=(PacketRing&&) = delete;
+
+  /**
+   * @brief Copies a packet in if it fits whole (producer only). Never blocks.
+   * @param packet Bytes to copy; may be empty
+   * @return True if the packet was queued, false if it was dropped and counted
+   */
+  [[nodiscard]] bool Push(std::span<const uint8_t> packet) noexcept {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    const uint32_t used = head - tail_.load(std::memory_order_acquire);
+    const size_t needed = kHeaderSize + packet.size();
+    if (packet.size() > MaxPacketSize || needed > Capacity - used) {
+      rejected_.fetch_add(1, std::memory_order_relaxed);
+      rejected_bytes_.fetch_add(static_cast<uint32_t>(packet.size()), std::memory_order_relaxed);
+      return false;
+    }
+
+    const auto size = static_cast<uint16_t>(packet.size());
+    const std::array<uint8_t, kHeaderSize> header = {static_cast<uint8_t>(size & 0xFFU),
+                                                     static_cast<uint8_t>(size >> 8U)};
+    CopyIn(head, header);
+    CopyIn(head + kHeaderSize, packet);
+    head_.store(head + static_cast<uint32_t>(needed), std::memory_order_release);
+
+    pushed_.fetch_add(1, std::memory_order_relaxed);
+    const auto held = static_cast<uint32_t>(used + needed);
+    if (held > high_water_.load(std::memory_order_relaxed)) {
+      high_water_.store(held, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Copies the oldest packet out (consumer only). Never blocks.
+   * @param out Destination, large enough for any packet
+   * @return Size of the packet copied into @p out, or std::nullopt if the ring is empty
+   */
+  [[nodiscard]] std::optional<size_t> Pop(std::span<uint8_t, MaxPacketSize> out) noexcept {
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_.load(std::memory_order_acquire) == tail) {
+      return std::nullopt;
+    }
+
+    std::array<uint8_t, kHeaderSize> header{};
+    CopyOut(tail, header);
+    const size_t size = static_cast<size_t>(header[0]) | (static_cast<size_t>(header[1]) << 8U);
+    CopyOut(tail + kHeaderSize, out.first(size));
+    tail_.store(tail + static_cast<uint32_t>(kHeaderSize + size), std::memory_order_release);
+    return size;
+  }
+
+  /**
+   * @brief Checks whether any packet is waiting (consumer only).
+   * @return True if Pop() would return a packet
+   */
+  [[nodiscard]] bool Empty() const noexcept {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the counters so far; safe from any task.
+   * @return Statistics
+   */
+  [[nodiscard]] PacketRingStats Stats() const noexcept {
+    return {.pushed = pushed_.load(std::memory_order_relaxed),
+            .rejected = rejected_.load(std::memory_order_relaxed),
+            .rejected_bytes = rejected_bytes_.load(std::memory_order_relaxed),
+            .high_water = high_water_.load(std::memory_order_relaxed)};
+  }
+
+private:
+  static constexpr uint32_t kMask = Capacity - 1;
+
+  void CopyIn(uint32_t index, std::span<const uint8_t> bytes) noexcept {
+    const size_t offset = index & kMask;
+    const size_t first = std::min(bytes.size(), Capacity - offset);
+    std::copy_n(bytes.begin(), first, storage_.begin() + static_cast<std::ptrdiff_t>(offset));
+    std::copy(bytes.begin() + static_cast<std::ptrdiff_t>(first), bytes.end(), storage_.begin());
+  }
+
+  void CopyOut(uint32_t index, std::span<uint8_t> bytes) const noexcept {
+    const size_t offset = index & kMask;
+    const size_t first = std::min(bytes.size(), Capacity - offset);
+    std::copy_n(storage_.begin() + static_cast<std::ptrdiff_t>(offset), first, bytes.begin());
+    std::copy_n(storage_.begin(), bytes.size() - first, bytes.begin() + static_cast<std::ptrdiff_t>(first));
+  }
+
+  std::array<uint8_t, Capacity> storage_{};  ///< Packets, each a length header then its bytes.
+  std::atomic<uint32_t> head_{0};            ///< Bytes pushed so far (producer).
+  std::atomic<uint32_t> tail_{0};            ///< Bytes popped so far (consumer).
+  std::atomic<uint32_t> pushed_{0};          ///< Packets accepted.
+  std::atomic<uint32_t> rejected_{0};        ///< Packets dropped.
+  std::atomic<uint32_t> rejected_bytes_{0};  ///< Bytes in dropped packets.
+  std::atomic<uint32_t> high_water_{0};      ///< Most bytes held at once (written by the producer).
+};
+
+}  // namespace embedded
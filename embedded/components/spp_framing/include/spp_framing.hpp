@@ -0,0 +1,215 @@
+/**
+ * @file spp_framing.hpp
+ * @brief Framing for the Bluetooth SPP byte stream
+ *
+ * RFCOMM does not preserve write boundaries, so every protobuf message travels in a frame:
+ *
+ *   0x00 | COBS(varint length | type | payload | CRC16 LE) | 0x00
+ *
+ * COBS removes every 0x00 from the body, so a 0x00 always marks a frame boundary and the
+ * receiver resynchronises after corruption. The CRC is CRC-16/CCITT-FALSE over the length,
+ * type and payload. The client implements the same format in client/comm/framing.hpp.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace embedded {
+
+/**
+ * @brief Framing result codes.
+ */
+enum class FramingError : uint8_t {
+  kOk = 0,           ///< Operation succeeded.
+  kPayloadTooLarge,  ///< Payload exceeds kMaxFramePayloadSize.
+  kBufferTooSmall,   ///< Output buffer is too small for the encoded frame.
+  kFrameTooLong,     ///< Received more bytes than any valid frame can hold before a delimiter.
+  kMalformedCobs,    ///< COBS block runs past the end of the frame.
+  kMalformedHeader,  ///< Length varint or type tag is missing or invalid.
+  kLengthMismatch,   ///< Declared payload length does not match the frame size.
+  kCrcMismatch,      ///< CRC16 check failed.
+};
+
+/**
+ * @brief Converts FramingError to a human-readable string.
+ * @param error The error to convert
+ * @return A null-terminated string describing the error
+ */
+[[nodiscard]] constexpr const char* FramingErrorToString(FramingError error) noexcept {
+  switch (error) {
+    case FramingError::kOk:
+      return "OK";
+    case FramingError::kPayloadTooLarge:
+      return "Payload too large";
+    case FramingError::kBufferTooSmall:
+      return "Buffer too small";
+    case FramingError::kFrameTooLong:
+      return "Frame too long";
+    case FramingError::kMalformedCobs:
+      return "Malformed COBS encoding";
+    case FramingError::kMalformedHeader:
+      return "Malformed frame header";
+    case FramingError::kLengthMismatch:
+      return "Frame length mismatch";
+    case FramingError::kCrcMismatch:
+      return "CRC mismatch";
+    default:
+      return "Unknown error";
+  }
+}
+
+/**
+ * @brief Type tag carried in every frame.
+ */
+enum class FrameType : uint8_t {
+  kCommand = 0x01,    ///< Client to device: app_Command.
+  kResponse = 0x02,   ///< Device to client: app_Response.
+  kHandshake = 0x03,  ///< Client to device: app_Handshake; device to client: app_HandshakeResponse.
+  kCompact = 0x04,    ///< Protocol v2 fixed-point control (see compact_control.hpp).
+  kWindowAck = 0x05,  ///< Device to client: windowed MOVE acknowledgement (see compact_control.hpp).
+};
+
+/// Sync byte that opens and closes every frame.
+inline constexpr uint8_t kFrameDelimiter = 0x00;
+
+/// Largest payload a frame may carry.
+inline constexpr size_t kMaxFramePayloadSize = 512;
+
+/**
+ * @brief Computes the worst-case encoded frame size, including both delimiters.
+ * @param payload_size Payload size in bytes
+ * @return Encoded frame size upper bound
+ */
+[[nodiscard]] constexpr size_t MaxEncodedFrameSize(size_t payload_size) noexcept {
+  const size_t body = 3 + 1 + payload_size + 2;  // varint length, type, payload, CRC16
+  return 1 + body + (body / 254) + 1 + 1;        // sync, COBS overhead, delimiter
+}
+
+/**
+ * @brief Computes CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF).
+ * @param data Bytes to checksum
+ * @return CRC value
+ */
+[[nodiscard]] uint16_t Crc16(std::span<const uint8_t> data) noexcept;
+
+/**
+ * @brief A decoded frame.
+ * @note The payload points into the decoder's buffer and is only valid inside the Feed() callback.
+ */
+struct Frame {
+  FrameType type = FrameType::kCommand;  ///< Frame type tag.
+  std::span<const uint8_t> payload;      ///< Frame payload.
+};
+
+/**
+ * @brief Encodes a payload as a frame.
+ * @param type Frame type tag
+ * @param payload Payload bytes
+ * @param out Output buffer (MaxEncodedFrameSize(payload.size()) bytes always suffice)
+ * @param written Set to the number of bytes written on success
+ * @return FramingError::kOk on success, error code on failure
+ */
+[[nodiscard]] FramingError EncodeFrame(FrameType type, std::span<const uint8_t> payload, std::span<uint8_t> out,
+                                       size_t& written) noexcept;
+
+/**
+ * @brief Decodes one frame in place.
+ * @param encoded COBS bytes between two delimiters (overwritten with the decoded body)
+ * @param frame Set to the decoded frame on success; its payload points into @p encoded
+ * @return FramingError::kOk on success, error code on failure
+ */
+[[nodiscard]] FramingError DecodeFrame(std::span<uint8_t> encoded, Frame& frame) noexcept;
+
+/**
+ * @brief Reassembles frames from SPP data events without allocating.
+ * @details Bytes are buffered until a delimiter arrives, so a frame split across
+ * ESP_SPP_DATA_IND_EVT events, or several frames in one event, are both handled.
+ */
+class FrameDecoder final {
+public:
+  /// Longest run of non-delimiter bytes that can still be a valid frame.
+  static constexpr size_t kMaxEncodedBodySize = MaxEncodedFrameSize(kMaxFramePayloadSize) - 2;
+
+  /**
+   * @brief Feeds received bytes and invokes a callback for each complete frame.
+   * @param data Received bytes (any chunking)
+   * @param on_frame Callback invoked as `on_frame(const Frame&)`
+   * @return Number of frames delivered
+   */
+  template <typename OnFrame>
+  size_t Feed(std::span<const uint8_t> data, OnFrame&& on_frame) noexcept(noexcept(on_frame(Frame{}))) {
+    size_t delivered = 0;
+    for (const uint8_t byte : data) {
+      if (byte != kFrameDelimiter) {
+        if (length_ < buffer_.size()) {
+          buffer_[length_++] = byte;
+        } else {
+          overflowed_ = true;
+        }
+        continue;
+      }
+
+      if (overflowed_) {
+        RecordError(FramingError::kFrameTooLong);
+      } else if (length_ > 0) {
+        Frame frame;
+        const FramingError error = DecodeFrame(std::span<uint8_t>(buffer_.data(), length_), frame);
+        if (error == FramingError::kOk) {
+          ++frames_decoded_;
+          ++delivered;
+          on_frame(frame);
+        } else {
+          RecordError(error);
+        }
+      }
+      length_ = 0;
+      overflowed_ = false;
+    }
+    return delivered;
+  }
+
+  /**
+   * @brief Discards any partially received frame (e.g. after a new connection).
+   */
+  void Reset() noexcept {
+    length_ = 0;
+    overflowed_ = false;
+  }
+
+  /**
+   * @brief Gets the number of frames decoded successfully.
+   * @return Frame count
+   */
+  [[nodiscard]] uint32_t FramesDecoded() const noexcept { return frames_decoded_; }
+
+  /**
+   * @brief Gets the number of frames dropped as corrupt.
+   * @return Dropped frame count
+   */
+  [[nodiscard]] uint32_t FramesDropped() const noexcept { return frames_dropped_; }
+
+  /**
+   * @brief Gets the reason the most recent frame was dropped.
+   * @return Last error, or FramingError::kOk if none was dropped
+   */
+  [[nodiscard]] FramingError LastError() const noexcept { return last_error_; }
+
+private:
+  void RecordError(FramingError error) noexcept {
+    ++frames_dropped_;
+    last_error_ = error;
+  }
+
+  std::array<uint8_t, kMaxEncodedBodySize> buffer_{};
+  size_t length_ = 0;
+  bool overflowed_ = false;
+  uint32_t frames_decoded_ = 0;
+  uint32_t frames_dropped_ = 0;
+  FramingError last_error_ = FramingError::kOk;
+};
+
+}  // namespace embedded
@@ -0,0 +1,181 @@
+/**
+ * @file spp_framing.cpp
+ * @brief Framing for the Bluetooth SPP byte stream
+ */
+
+#include "spp_framing.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace embedded {
+
+namespace {
+
+constexpr size_t kMaxVarintSize = 3;  ///< 21 bits, far above kMaxFramePayloadSize.
+constexpr size_t kCrcSize = 2;
+
+constexpr std::array<uint16_t, 256> kCrcTable = []() {
+  std::array<uint16_t, 256> table{};
+  for (size_t i = 0; i < table.size(); ++i) {
+    auto crc = static_cast<uint16_t>(i << 8);
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = static_cast<uint16_t>((crc & 0x8000) != 0 ? (crc << 1) ^ 0x1021 : crc << 1);
+    }
+    table[i] = crc;
+  }
+  return table;
+}();
+
+constexpr bool IsKnownFrameType(uint8_t tag) noexcept {
+  return tag >= static_cast<uint8_t>(FrameType::kCommand) && tag <= static_cast<uint8_t>(FrameType::kWindowAck);
+}
+
+/**
+ * @brief COBS-encodes input into out.
+ * @return Number of bytes written
+ */
+size_t CobsEncode(std::span<const uint8_t> input, std::span<uint8_t> out) noexcept {
+  size_t code_index = 0;
+  size_t write_index = 1;
+  uint8_t code = 1;
+
+  for (const uint8_t byte : input) {
+    if (byte != 0) {
+      out[write_index++] = byte;
+      ++code;
+    }
+    if (byte == 0 || code == 0xFF) {
+      out[code_index] = code;
+      code_index = write_index++;
+      code = 1;
+    }
+  }
+
+  out[code_index] = code;
+  return write_index;
+}
+
+/**
+ * @brief COBS-decodes data in place.
+ * @return True on success; decoded_size is set to the decoded length
+ */
+bool CobsDecodeInPlace(std::span<uint8_t> data, size_t& decoded_size) noexcept {
+  size_t read_index = 0;
+  size_t write_index = 0;
+
+  while (read_index < data.size()) {
+    const uint8_t code = data[read_index++];
+    if (code == 0 || read_index + code - 1 > data.size()) {
+      return false;
+    }
+
+    for (uint8_t i = 1; i < code; ++i) {
+      data[write_index++] = data[read_index++];
+    }
+    if (code != 0xFF && read_index < data.size()) {
+      data[write_index++] = 0;
+    }
+  }
+
+  decoded_size = write_index;
+  return true;
+}
+
+}  // namespace
+
+uint16_t Crc16(std::span<const uint8_t> data) noexcept {
+  uint16_t crc = 0xFFFF;
+  for (const uint8_t byte : data) {
+    crc = static_cast<uint16_t>((crc << 8) ^ kCrcTable[((crc >> 8) ^ byte) & 0xFF]);
+  }
+  return crc;
+}
+
+FramingError EncodeFrame(FrameType type, std::span<const uint8_t> payload, std::span<uint8_t> out,
+                         size_t& written) noexcept {
+  if (payload.size() > kMaxFramePayloadSize) {
+    return FramingError::kPayloadTooLarge;
+  }
+  if (out.size() < MaxEncodedFrameSize(payload.size())) {
+    return FramingError::kBufferTooSmall;
+  }
+
+  // Unencoded body: varint length | type | payload | CRC16 (little-endian)
+  std::array<uint8_t, kMaxVarintSize + 1 + kMaxFramePayloadSize + kCrcSize> body;
+  size_t body_size = 0;
+
+  auto length = static_cast<uint32_t>(payload.size());
+  do {
+    auto byte = static_cast<uint8_t>(length & 0x7F);
+    length >>= 7;
+    if (length != 0) {
+      byte |= 0x80;
+    }
+    body[body_size++] = byte;
+  } while (length != 0);
+
+  body[body_size++] = static_cast<uint8_t>(type);
+  if (!payload.empty()) {
+    std::memcpy(&body[body_size], payload.data(), payload.size());
+    body_size += payload.size();
+  }
+
+  const uint16_t crc = Crc16(std::span<const uint8_t>(body.data(), body_size));
+  body[body_size++] = static_cast<uint8_t>(crc & 0xFF);
+  body[body_size++] = static_cast<uint8_t>(crc >> 8);
+
+  out[0] = kFrameDelimiter;
+  const size_t encoded = CobsEncode(std::span<const uint8_t>(body.data(), body_size), out.subspan(1));
+  out[1 + encoded] = kFrameDelimiter;
+  written = encoded + 2;
+  return FramingError::kOk;
+}
+
+FramingError DecodeFrame(std::span<uint8_t> encoded, Frame& frame) noexcept {
+  size_t decoded_size = 0;
+  if (!CobsDecodeInPlace(encoded, decoded_size)) {
+    return FramingError::kMalformedCobs;
+  }
+  const auto body = encoded.first(decoded_size);
+
+  uint32_t length = 0;
+  size_t index = 0;
+  for (int shift = 0;; shift += 7) {
+    if (index >= body.size() || index >= kMaxVarintSize) {
+      return FramingError::kMalformedHeader;
+    }
+    const uint8_t byte = body[index++];
+    length |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      break;
+    }
+  }
+
+  if (length > kMaxFramePayloadSize) {
+    return FramingError::kPayloadTooLarge;
+  }
+  if (index >= body.size() || !IsKnownFrameType(body[index])) {
+    return FramingError::kMalformedHeader;
+  }
+  const auto type = static_cast<FrameType>(body[index++]);
+
+  if (body.size() != index + length + kCrcSize) {
+    return FramingError::kLengthMismatch;
+  }
+
+  const size_t crc_offset = index + length;
+  const auto expected_crc = static_cast<uint16_t>(body[crc_offset] | (body[crc_offset + 1] << 8));
+  if (Crc16(body.first(crc_offset)) != expected_crc) {
+    return FramingError::kCrcMismatch;
+  }
+
+  frame.type = type;
+  frame.payload = body.subspan(index, length);
+  return FramingError::kOk;
+}
+
+}  // namespace embedded
@@ -0,0 +1,140 @@
+/**
+ * @file datagram_channel.cpp
+ * @brief Sequencing for the UDP control link
+ */
+
+#include "datagram_channel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace embedded {
+
+void EncodeDatagramHeader(const DatagramHeader& header, std::span<uint8_t> out) noexcept {
+  out[0] = static_cast<uint8_t>(header.kind);
+  out[1] = header.session;
+  for (size_t i = 0; i < 4; ++i) {
+    out[2 + i] = static_cast<uint8_t>(header.sequence >> (8 * i));
+    out[6 + i] = static_cast<uint8_t>(header.timestamp_us >> (8 * i));
+  }
+}
+
+bool DecodeDatagramHeader(std::span<const uint8_t> datagram, DatagramHeader& header) noexcept {
+  if (datagram.size() < kDatagramHeaderSize || datagram[0] < static_cast<uint8_t>(DatagramKind::kLatest) ||
+      datagram[0] > static_cast<uint8_t>(DatagramKind::kAck)) {
+    return false;
+  }
+
+  header.kind = static_cast<DatagramKind>(datagram[0]);
+  header.session = datagram[1];
+  header.sequence = 0;
+  header.timestamp_us = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    header.sequence |= static_cast<uint32_t>(datagram[2 + i]) << (8 * i);
+    header.timestamp_us |= static_cast<uint32_t>(datagram[6 + i]) << (8 * i);
+  }
+  return true;
+}
+
+void DatagramChannel::Reset(uint8_t session) noexcept {
+  session_ = session;
+  next_latest_ = 0;
+  next_reliable_ = 0;
+  head_ = 0;
+  queued_ = 0;
+  in_flight_ = 0;
+  peer_acked_ = false;
+  timeout_us_ = kInitialTimeoutUs;
+  deadline_us_ = 0;
+  stats_ = {};
+  ResetReceiver(0);
+  peer_known_ = false;
+}
+
+void DatagramChannel::ResetReceiver(uint8_t peer_session) noexcept {
+  peer_known_ = true;
+  peer_session_ = peer_session;
+  latest_synced_ = false;
+  newest_latest_ = 0;
+  reliable_synced_ = false;
+  expected_reliable_ = 0;
+  has_transit_ = false;
+  last_transit_us_ = 0;
+  jitter_q4_ = 0;
+  stats_.jitter_us = 0;
+}
+
+bool DatagramChannel::Acknowledge(uint32_t next_expected, uint32_t now_us) noexcept {
+  // An acknowledgement beyond what was sent cannot belong to this session
+  if (static_cast<int32_t>(next_expected - next_reliable_) > 0) {
+    return false;
+  }
+
+  size_t acknowledged = 0;
+  while (in_flight_ != 0 && static_cast<int32_t>(next_expected - slots_[head_].sequence) > 0) {
+    head_ = (head_ + 1) % kMaxQueued;
+    --queued_;
+    --in_flight_;
+    ++acknowledged;
+  }
+  if (acknowledged == 0) {
+    return false;
+  }
+
+  peer_acked_ = true;
+  timeout_us_ = kInitialTimeoutUs;
+  deadline_us_ = now_us + timeout_us_;
+  return true;
+}
+
+bool DatagramChannel::AcceptLatest(const DatagramHeader& header, uint32_t now_us) noexcept {
+  // RFC 3550 A.8: the clocks need not agree, only the change in transit time matters
+  const auto transit = static_cast<int32_t>(now_us - header.timestamp_us);
+  if (has_transit_) {
+    const int32_t delta = transit - last_transit_us_;
+    const auto magnitude = static_cast<uint32_t>(delta < 0 ? -static_cast<int64_t>(delta) : delta);
+    jitter_q4_ = jitter_q4_ + magnitude - ((jitter_q4_ + 8) >> 4);
+    stats_.jitter_us = jitter_q4_ >> 4;
+  }
+  has_transit_ = true;
+  last_transit_us_ = transit;
+
+  const auto distance = static_cast<int32_t>(header.sequence - newest_latest_);
+  if (latest_synced_ && distance == 0) {
+    ++stats_.duplicates;
+    return false;
+  }
+  if (latest_synced_ && distance < 0) {
+    ++stats_.late;
+    return false;
+  }
+
+  stats_.lost += latest_synced_ ? static_cast<uint32_t>(distance) - 1 : 0;
+  latest_synced_ = true;
+  newest_latest_ = header.sequence;
+  ++stats_.received;
+  return true;
+}
+
+bool DatagramChannel::AcceptReliable(const DatagramHeader& header) noexcept {
+  if (!reliable_synced_) {
+    reliable_synced_ = true;
+    expected_reliable_ = header.sequence;
+  }
+
+  const auto distance = static_cast<int32_t>(header.sequence - expected_reliable_);
+  if (distance < 0) {
+    ++stats_.duplicates;
+  }
+  // Datagrams past a gap are dropped; go-back-N resends them after the missing one
+  if (distance != 0) {
+    return false;
+  }
+
+  ++expected_reliable_;
+  ++stats_.reliable_received;
+  return true;
+}
+
+}  // namespace embedded
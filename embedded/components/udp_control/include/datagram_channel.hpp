@@ -0,0 +1,316 @@
+/**
+ * @file datagram_channel.hpp
+ * @brief Sequencing for the UDP control link
+ *
+ * Over WiFi every frame (see spp_framing.hpp) travels in its own datagram behind a header:
+ *
+ *   kind | session | sequence u32 LE | timestamp_us u32 LE | frame
+ *
+ * Compact control (MOVE, compact status, window ack) is kLatest: never retransmitted, and the
+ * receiver drops anything older than the newest it delivered, since a stale target is worse than
+ * a missing one. Everything else is kReliable: go-back-N with cumulative kAck datagrams and an
+ * exponentially backed-off retransmission timer, delivered in order. A datagram from a new
+ * session resets the receive side, so either end can restart without stale sequence numbers
+ * stalling the other. The client implements the same format in client/comm/datagram_channel.hpp.
+ */
+
+#pragma once
+
+#include <spp_framing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace embedded {
+
+/**
+ * @brief Delivery class of a control datagram.
+ */
+enum class DatagramKind : uint8_t {
+  kLatest = 0x01,    ///< Unreliable; the receiver drops anything older than the newest it delivered.
+  kReliable = 0x02,  ///< Retransmitted until acknowledged and delivered in order.
+  kAck = 0x03,       ///< Cumulative acknowledgement of kReliable datagrams.
+};
+
+/// Bytes in front of the frame: kind, session, sequence (LE) and sender timestamp (LE).
+inline constexpr size_t kDatagramHeaderSize = 10;
+
+/// Largest frame the firmware sends; responses are encoded into 256-byte buffers.
+inline constexpr size_t kMaxDatagramFrameSize = MaxEncodedFrameSize(256);
+
+/// Largest datagram received: the header plus the largest frame the client may send.
+inline constexpr size_t kMaxDatagramSize = kDatagramHeaderSize + MaxEncodedFrameSize(kMaxFramePayloadSize);
+
+/**
+ * @brief Header of a control datagram.
+ */
+struct DatagramHeader {
+  DatagramKind kind = DatagramKind::kLatest;  ///< Delivery class.
+  uint8_t session = 0;                        ///< Sender's session; for kAck, the session being acknowledged.
+  uint32_t sequence = 0;                      ///< Per-kind sequence; for kAck, the next reliable sequence expected.
+  uint32_t timestamp_us = 0;                  ///< Sender clock in microseconds (wraps), for jitter estimation.
+};
+
+/**
+ * @brief Writes a datagram header.
+ * @param header Header to encode
+ * @param out Destination (at least kDatagramHeaderSize bytes)
+ */
+void EncodeDatagramHeader(const DatagramHeader& header, std::span<uint8_t> out) noexcept;
+
+/**
+ * @brief Reads a datagram header.
+ * @param datagram Received datagram
+ * @param header Set to the header on success
+ * @return False if the datagram is too short or of unknown kind
+ */
+[[nodiscard]] bool DecodeDatagramHeader(std::span<const uint8_t> datagram, DatagramHeader& header) noexcept;
+
+/**
+ * @brief Chooses the delivery class for a frame.
+ * @param type Frame type
+ * @return kLatest for compact control, otherwise kReliable
+ */
+[[nodiscard]] constexpr DatagramKind DatagramKindFor(FrameType type) noexcept {
+  return type == FrameType::kCompact || type == FrameType::kWindowAck ? DatagramKind::kLatest
+                                                                      : DatagramKind::kReliable;
+}
+
+/**
+ * @brief Receive-side statistics of a DatagramChannel.
+ */
+struct DatagramStats {
+  uint32_t received = 0;           ///< kLatest datagrams delivered.
+  uint32_t lost = 0;               ///< kLatest sequences skipped over (never delivered).
+  uint32_t late = 0;               ///< kLatest datagrams dropped because a newer one was delivered first.
+  uint32_t duplicates = 0;         ///< Datagrams received again (either kind).
+  uint32_t reliable_received = 0;  ///< kReliable datagrams delivered.
+  uint32_t retransmissions = 0;    ///< kReliable datagrams sent again.
+  uint32_t jitter_us = 0;          ///< Interarrival jitter of kLatest datagrams (RFC 3550 estimator).
+};
+
+/**
+ * @brief Sequencing state of one end of the UDP control link, without allocating.
+ * @details Sending and receiving take a callback invoked as `send(std::span<const uint8_t>)` that
+ * hands a datagram to the socket; receiving may send acknowledgements and queued datagrams.
+ * @note Not thread-safe; callers serialize access.
+ */
+class DatagramChannel {
+public:
+  /// kReliable datagrams in flight once the session is established.
+  static constexpr size_t kMaxInFlight = 4;
+
+  /// kReliable datagrams that may wait for the window, including those in flight.
+  static constexpr size_t kMaxQueued = 8;
+
+  /// Retransmission timeout after progress; a LAN round trip is a few milliseconds.
+  static constexpr uint32_t kInitialTimeoutUs = 50'000;
+
+  /// Upper bound for the backed-off timeout.
+  static constexpr uint32_t kMaxTimeoutUs = 1'000'000;
+
+  /**
+   * @brief Constructs a channel.
+   * @param session Session byte for datagrams this end sends (see Reset())
+   */
+  explicit DatagramChannel(uint8_t session = 1) noexcept : session_(session) {}
+
+  /**
+   * @brief Sends a frame as a kLatest datagram.
+   * @param frame One encoded frame (at most kMaxDatagramFrameSize bytes)
+   * @param now_us Current time in microseconds
+   * @param send Callback invoked as `send(std::span<const uint8_t>)`
+   * @return False if @p frame is too large
+   */
+  template <typename Send>
+  bool SendLatest(std::span<const uint8_t> frame, uint32_t now_us, Send&& send) {
+    if (frame.size() > kMaxDatagramFrameSize) {
+      return false;
+    }
+
+    std::array<uint8_t, kDatagramHeaderSize + kMaxDatagramFrameSize> datagram;
+    EncodeDatagramHeader({DatagramKind::kLatest, session_, next_latest_++, now_us}, datagram);
+    std::ranges::copy(frame, datagram.begin() + kDatagramHeaderSize);
+    send(std::span<const uint8_t>(datagram.data(), kDatagramHeaderSize + frame.size()));
+    return true;
+  }
+
+  /**
+   * @brief Queues a frame as a kReliable datagram and sends it once the window allows.
+   * @param frame One encoded frame (at most kMaxDatagramFrameSize bytes)
+   * @param now_us Current time in microseconds
+   * @param send Callback invoked as `send(std::span<const uint8_t>)`
+   * @return False if @p frame is too large or kMaxQueued datagrams are queued
+   */
+  template <typename Send>
+  bool SendReliable(std::span<const uint8_t> frame, uint32_t now_us, Send&& send) {
+    if (frame.size() > kMaxDatagramFrameSize || queued_ == kMaxQueued) {
+      return false;
+    }
+
+    Slot& slot = slots_[(head_ + queued_) % kMaxQueued];
+    slot.sequence = next_reliable_++;
+    slot.size = kDatagramHeaderSize + frame.size();
+    EncodeDatagramHeader({DatagramKind::kReliable, session_, slot.sequence, now_us}, slot.data);
+    std::ranges::copy(frame, slot.data.begin() + kDatagramHeaderSize);
+    ++queued_;
+
+    Transmit(now_us, send);
+    return true;
+  }
+
+  /**
+   * @brief Processes a received datagram.
+   * @param datagram Received datagram
+   * @param now_us Current time in microseconds
+   * @param deliver Callback invoked as `deliver(std::span<const uint8_t> frame)` if the datagram is delivered
+   * @param send Callback invoked as `send(std::span<const uint8_t>)` for acknowledgements and queued datagrams
+   * @return False if the header is malformed; dropped datagrams are not errors
+   */
+  template <typename Deliver, typename Send>
+  bool Receive(std::span<const uint8_t> datagram, uint32_t now_us, Deliver&& deliver, Send&& send) {
+    DatagramHeader header;
+    if (!DecodeDatagramHeader(datagram, header)) {
+      return false;
+    }
+
+    if (header.kind == DatagramKind::kAck) {
+      // An acknowledgement addressed to an earlier session of this end is stale
+      if (header.session == session_ && Acknowledge(header.sequence, now_us)) {
+        Transmit(now_us, send);
+      }
+      return true;
+    }
+
+    if (!peer_known_ || header.session != peer_session_) {
+      ResetReceiver(header.session);
+    }
+
+    const auto frame = datagram.subspan(kDatagramHeaderSize);
+    if (header.kind == DatagramKind::kLatest) {
+      if (AcceptLatest(header, now_us)) {
+        deliver(frame);
+      }
+      return true;
+    }
+
+    if (AcceptReliable(header)) {
+      deliver(frame);
+    }
+
+    std::array<uint8_t, kDatagramHeaderSize> ack;
+    EncodeDatagramHeader({DatagramKind::kAck, header.session, expected_reliable_, now_us}, ack);
+    send(std::span<const uint8_t>(ack));
+    return true;
+  }
+
+  /**
+   * @brief Retransmits the kReliable window if its acknowledgement is overdue.
+   * @param now_us Current time in microseconds
+   * @param send Callback invoked as `send(std::span<const uint8_t>)`
+   * @return Number of datagrams retransmitted
+   */
+  template <typename Send>
+  size_t PollRetransmits(uint32_t now_us, Send&& send) {
+    if (in_flight_ == 0 || static_cast<int32_t>(now_us - deadline_us_) < 0) {
+      return 0;
+    }
+
+    for (size_t i = 0; i < in_flight_; ++i) {
+      const Slot& slot = slots_[(head_ + i) % kMaxQueued];
+      send(std::span<const uint8_t>(slot.data.data(), slot.size));
+    }
+    stats_.retransmissions += static_cast<uint32_t>(in_flight_);  // At most kMaxInFlight
+    timeout_us_ = std::min(timeout_us_ * 2, kMaxTimeoutUs);
+    deadline_us_ = now_us + timeout_us_;
+    return in_flight_;
+  }
+
+  /**
+   * @brief Starts a new session: forgets all sequence state and queued datagrams.
+   * @param session Session byte for datagrams this end sends; pick a new one on every reset
+   */
+  void Reset(uint8_t session) noexcept;
+
+  /**
+   * @brief Gets the session byte of datagrams this end sends.
+   * @return Session byte
+   */
+  [[nodiscard]] uint8_t Session() const noexcept { return session_; }
+
+  /**
+   * @brief Gets the session byte of the peer's datagrams.
+   * @return Peer session byte, or 0 before the peer sent anything
+   */
+  [[nodiscard]] uint8_t PeerSession() const noexcept { return peer_known_ ? peer_session_ : 0; }
+
+  /**
+   * @brief Gets the number of kReliable datagrams not yet acknowledged (sent or waiting).
+   * @return Queued datagram count
+   */
+  [[nodiscard]] size_t ReliablePending() const noexcept { return queued_; }
+
+  /**
+   * @brief Gets the receive statistics.
+   * @return Statistics since the last Reset()
+   */
+  [[nodiscard]] const DatagramStats& Stats() const noexcept { return stats_; }
+
+private:
+  struct Slot {
+    uint32_t sequence = 0;
+    size_t size = 0;
+    std::array<uint8_t, kDatagramHeaderSize + kMaxDatagramFrameSize> data{};
+  };
+
+  [[nodiscard]] size_t Window() const noexcept { return peer_acked_ ? kMaxInFlight : 1; }
+
+  template <typename Send>
+  void Transmit(uint32_t now_us, Send&& send) {
+    // The first datagram of a session travels alone, so the peer adopts the stream at its start
+    const size_t window = std::min(Window(), queued_);
+    if (in_flight_ == 0 && window != 0) {
+      deadline_us_ = now_us + timeout_us_;
+    }
+
+    for (; in_flight_ < window; ++in_flight_) {
+      const Slot& slot = slots_[(head_ + in_flight_) % kMaxQueued];
+      send(std::span<const uint8_t>(slot.data.data(), slot.size));
+    }
+  }
+
+  [[nodiscard]] bool Acknowledge(uint32_t next_expected, uint32_t now_us) noexcept;
+  [[nodiscard]] bool AcceptLatest(const DatagramHeader& header, uint32_t now_us) noexcept;
+  [[nodiscard]] bool AcceptReliable(const DatagramHeader& header) noexcept;
+  void ResetReceiver(uint8_t peer_session) noexcept;
+
+  uint8_t session_;
+  uint32_t next_latest_ = 0;
+  uint32_t next_reliable_ = 0;
+
+  std::array<Slot, kMaxQueued> slots_{};
+  size_t head_ = 0;
+  size_t queued_ = 0;
+  size_t in_flight_ = 0;
+  bool peer_acked_ = false;
+  uint32_t timeout_us_ = kInitialTimeoutUs;
+  uint32_t deadline_us_ = 0;
+
+  bool peer_known_ = false;
+  uint8_t peer_session_ = 0;
+  bool latest_synced_ = false;
+  uint32_t newest_latest_ = 0;
+  bool reliable_synced_ = false;
+  uint32_t expected_reliable_ = 0;
+
+  bool has_transit_ = false;
+  int32_t last_transit_us_ = 0;
+  uint32_t jitter_q4_ = 0;  ///< Jitter in 1/16 microseconds.
+
+  DatagramStats stats_;
+};
+
+}  // namespace embedded
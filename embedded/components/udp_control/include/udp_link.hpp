@@ -0,0 +1,178 @@
+/**
+ * @file udp_link.hpp
+ * @brief UDP control link to the client over WiFi
+ *
+ * The client speaks the same frames over UDP as over Bluetooth SPP, one frame per datagram,
+ * sequenced by a DatagramChannel. The link serves one client at a time: the address of the
+ * latest datagram is the peer, and a datagram from a new address or session starts over.
+ */
+
+#pragma once
+
+#include <datagram_channel.hpp>
+#include <spp_framing.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+
+#include "udp_socket.hpp"
+
+namespace embedded {
+
+/**
+ * @brief UDP link result codes.
+ */
+enum class UdpLinkError : uint8_t {
+  kOk = 0,         ///< Operation succeeded.
+  kSocketFailed,   ///< Could not create the socket.
+  kBindFailed,     ///< Could not bind the port.
+  kNotOpen,        ///< Link is not open.
+  kNoPeer,         ///< No client has sent anything yet.
+  kFrameTooLarge,  ///< Frame exceeds kMaxDatagramFrameSize.
+  kQueueFull,      ///< Too many reliable frames awaiting acknowledgement.
+  kReceiveFailed,  ///< Waiting for or reading a datagram failed.
+};
+
+/**
+ * @brief Converts UdpLinkError to a human-readable string.
+ * @param error The error to convert
+ * @return A null-terminated string describing the error
+ */
+[[nodiscard]] constexpr const char* UdpLinkErrorToString(UdpLinkError error) noexcept {
+  switch (error) {
+    case UdpLinkError::kOk:
+      return "OK";
+    case UdpLinkError::kSocketFailed:
+      return "Socket creation failed";
+    case UdpLinkError::kBindFailed:
+      return "Bind failed";
+    case UdpLinkError::kNotOpen:
+      return "Link not open";
+    case UdpLinkError::kNoPeer:
+      return "No client";
+    case UdpLinkError::kFrameTooLarge:
+      return "Frame too large";
+    case UdpLinkError::kQueueFull:
+      return "Reliable queue full";
+    case UdpLinkError::kReceiveFailed:
+      return "Receive failed";
+    default:
+      return "Unknown error";
+  }
+}
+
+/**
+ * @brief UDP control link serving one client.
+ * @details One task calls Poll() in a loop; it receives datagrams, invokes the callbacks and
+ * retransmits overdue reliable frames. Send() may be called from any task.
+ */
+class UdpLink {
+public:
+/**
+ * @brief Callback type for a received frame (delimiters included, as FrameDecoder::Feed() takes it).
+ */
+#if __cpp_lib_move_only_function >= 202110L
+  using FrameCallback = std::move_only_function<void(std::span<const uint8_t> frame)>;
+#else
+  using FrameCallback = std::function<void(std::span<const uint8_t> frame)>;
+#endif
+
+/**
+ * @brief Callback type for a new client (new address or restarted session).
+ */
+#if __cpp_lib_move_only_function >= 202110L
+  using PeerCallback = std::move_only_function<void()>;
+#else
+  using PeerCallback = std::function<void()>;
+#endif
+
+  /// Longest Poll() wait that still retransmits on time.
+  static constexpr uint32_t kPollIntervalMs = 10;
+
+  UdpLink() = default;
+  UdpLink(const UdpLink&) = delete;
+  UdpLink(UdpLink&&) = delete;
+  ~UdpLink() { Close(); }
+
+  UdpLink& operator=(const UdpLink&) = delete;
+  UdpLink& operator=(UdpLink&&) = delete;
+
+  /**
+   * @brief Binds the control port on all interfaces.
+   * @param port UDP port, or 0 for any free port (see Port())
+   * @return UdpLinkError::kOk on success, error code on failure
+   */
+  [[nodiscard]] UdpLinkError Open(uint16_t port);
+
+  /**
+   * @brief Closes the socket and forgets the client.
+   */
+  void Close();
+
+  /**
+   * @brief Waits for datagrams and processes them, then retransmits overdue reliable frames.
+   * @param timeout_ms Longest wait (at most kPollIntervalMs to retransmit on time)
+   * @return UdpLinkError::kOk on success or timeout, error code on failure
+   */
+  UdpLinkError Poll(uint32_t timeout_ms);
+
+  /**
+   * @brief Sends a frame to the client: compact control latest-wins, everything else reliably.
+   * @param type Type of the frame (chooses the DatagramKind)
+   * @param frame One encoded frame
+   * @return UdpLinkError::kOk on success, error code on failure
+   */
+  UdpLinkError Send(FrameType type, std::span<const uint8_t> frame);
+
+  /**
+   * @brief Checks whether a client has sent anything since Open().
+   * @return True if Send() has somewhere to send to
+   */
+  [[nodiscard]] bool Connected() const;
+
+  /**
+   * @brief Gets the bound port.
+   * @return Local port, or 0 if not open
+   */
+  [[nodiscard]] uint16_t Port() const noexcept { return port_; }
+
+  /**
+   * @brief Gets the channel statistics for the current client.
+   * @return Snapshot of the statistics
+   */
+  [[nodiscard]] DatagramStats Stats() const;
+
+  /**
+   * @brief Sets the received frame callback (invoked from Poll()).
+   * @param callback Callback to invoke with each delivered frame
+   */
+  void SetFrameCallback(FrameCallback callback) noexcept { frame_callback_ = std::move(callback); }
+
+  /**
+   * @brief Sets the new client callback (invoked from Poll(), before the client's first frame).
+   * @param callback Callback to invoke when a client connects or restarts
+   */
+  void SetPeerCallback(PeerCallback callback) noexcept { peer_callback_ = std::move(callback); }
+
+private:
+  [[nodiscard]] bool Process(std::span<const uint8_t> datagram, const sockaddr_in& from, uint32_t now_us,
+                             std::array<uint8_t, kMaxDatagramSize>& frame, size_t& frame_size);
+  void SendDatagram(std::span<const uint8_t> datagram);
+
+  int socket_ = -1;
+  uint16_t port_ = 0;
+
+  mutable std::mutex mutex_;  ///< Guards everything below.
+  DatagramChannel channel_;
+  sockaddr_in peer_{};
+  bool has_peer_ = false;
+
+  FrameCallback frame_callback_;
+  PeerCallback peer_callback_;
+};
+
+}  // namespace embedded
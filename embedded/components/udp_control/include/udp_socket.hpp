@@ -0,0 +1,19 @@
+/**
+ * @file udp_socket.hpp
+ * @brief BSD socket headers for the UDP control link
+ *
+ * lwIP provides the BSD socket API on the ESP32; the host tests use the system's.
+ */
+
+#pragma once
+
+#ifdef ESP_PLATFORM
+#include <lwip/inet.h>
+#include <lwip/sockets.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
@@ -0,0 +1,206 @@
+/**
+ * @file udp_link.cpp
+ * @brief UDP control link to the client over WiFi
+ */
+
+#include "udp_link.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+
+#ifdef ESP_PLATFORM
+#include <esp_random.h>
+#include <esp_timer.h>
+#else
+#include <chrono>
+#include <random>
+#endif
+
+namespace embedded {
+
+namespace {
+
+[[nodiscard]] uint32_t NowUs() noexcept {
+#ifdef ESP_PLATFORM
+  return static_cast<uint32_t>(esp_timer_get_time());
+#else
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
+
+/// Picks a session byte other than 0 and @p previous, so a rebooted device never reuses its last one.
+[[nodiscard]] uint8_t NextSession(uint8_t previous) noexcept {
+#ifdef ESP_PLATFORM
+  const uint32_t random = esp_random();
+#else
+  static std::minstd_rand generator(std::random_device{}());
+  const auto random = static_cast<uint32_t>(generator());
+#endif
+  const auto session = static_cast<uint8_t>(random % 255 + 1);
+  return session != previous ? session : static_cast<uint8_t>(session % 255 + 1);
+}
+
+[[nodiscard]] bool SameAddress(const sockaddr_in& lhs, const sockaddr_in& rhs) noexcept {
+  return lhs.sin_addr.s_addr == rhs.sin_addr.s_addr && lhs.sin_port == rhs.sin_port;
+}
+
+}  // namespace
+
+UdpLinkError UdpLink::Open(uint16_t port) {
+  Close();
+
+  const int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (fd < 0) {
+    return UdpLinkError::kSocketFailed;
+  }
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(port);
+  socklen_t length = sizeof(address);
+  if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+      getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+    close(fd);
+    return UdpLinkError::kBindFailed;
+  }
+
+  std::scoped_lock lock(mutex_);
+  socket_ = fd;
+  port_ = ntohs(address.sin_port);
+  has_peer_ = false;
+  return UdpLinkError::kOk;
+}
+
+void UdpLink::Close() {
+  std::scoped_lock lock(mutex_);
+  if (socket_ >= 0) {
+    close(socket_);
+  }
+  socket_ = -1;
+  port_ = 0;
+  has_peer_ = false;
+}
+
+UdpLinkError UdpLink::Poll(uint32_t timeout_ms) {
+  if (socket_ < 0) {
+    return UdpLinkError::kNotOpen;
+  }
+
+  fd_set readable;
+  FD_ZERO(&readable);
+  FD_SET(socket_, &readable);
+  timeval timeout{};
+  timeout.tv_sec = static_cast<decltype(timeout.tv_sec)>(timeout_ms / 1000);
+  timeout.tv_usec = static_cast<decltype(timeout.tv_usec)>((timeout_ms % 1000) * 1000);
+  const int ready = select(socket_ + 1, &readable, nullptr, nullptr, &timeout);
+  if (ready < 0) {
+    return UdpLinkError::kReceiveFailed;
+  }
+
+  // Drain everything that arrived; the callbacks run without the lock, since they send responses
+  std::array<uint8_t, kMaxDatagramSize> datagram;
+  std::array<uint8_t, kMaxDatagramSize> frame;
+  while (ready > 0) {
+    sockaddr_in from{};
+    socklen_t from_length = sizeof(from);
+    const auto received = recvfrom(socket_, datagram.data(), datagram.size(), MSG_DONTWAIT,
+                                   reinterpret_cast<sockaddr*>(&from), &from_length);
+    if (received <= 0) {
+      break;
+    }
+
+    size_t frame_size = 0;
+    const bool new_peer = Process(std::span<const uint8_t>(datagram.data(), static_cast<size_t>(received)), from,
+                                  NowUs(), frame, frame_size);
+    if (new_peer && peer_callback_) {
+      peer_callback_();
+    }
+    if (frame_size != 0 && frame_callback_) {
+      frame_callback_(std::span<const uint8_t>(frame.data(), frame_size));
+    }
+  }
+
+  std::scoped_lock lock(mutex_);
+  channel_.PollRetransmits(NowUs(), [this](std::span<const uint8_t> out) { SendDatagram(out); });
+  return UdpLinkError::kOk;
+}
+
+bool UdpLink::Process(std::span<const uint8_t> datagram, const sockaddr_in& from, uint32_t now_us,
+                      std::array<uint8_t, kMaxDatagramSize>& frame, size_t& frame_size) {
+  DatagramHeader header;
+  if (!DecodeDatagramHeader(datagram, header)) {
+    return false;
+  }
+
+  std::scoped_lock lock(mutex_);
+  bool new_peer = false;
+  if (!has_peer_ || !SameAddress(from, peer_)) {
+    // Acknowledgements carry this end's session, so only data can introduce a client
+    if (header.kind == DatagramKind::kAck) {
+      return false;
+    }
+    new_peer = true;
+  } else if (header.kind != DatagramKind::kAck && header.session != channel_.PeerSession()) {
+    new_peer = true;
+  }
+
+  if (new_peer) {
+    // A new session byte tells the client to drop anything queued for its predecessor
+    peer_ = from;
+    has_peer_ = true;
+    channel_.Reset(NextSession(channel_.Session()));
+  }
+
+  channel_.Receive(
+      datagram, now_us,
+      [&](std::span<const uint8_t> delivered) {
+        std::ranges::copy(delivered, frame.begin());
+        frame_size = delivered.size();
+      },
+      [this](std::span<const uint8_t> out) { SendDatagram(out); });
+  return new_peer;
+}
+
+UdpLinkError UdpLink::Send(FrameType type, std::span<const uint8_t> frame) {
+  std::scoped_lock lock(mutex_);
+  if (socket_ < 0) {
+    return UdpLinkError::kNotOpen;
+  }
+  if (!has_peer_) {
+    return UdpLinkError::kNoPeer;
+  }
+  if (frame.size() > kMaxDatagramFrameSize) {
+    return UdpLinkError::kFrameTooLarge;
+  }
+
+  const auto send = [this](std::span<const uint8_t> out) { SendDatagram(out); };
+  if (DatagramKindFor(type) == DatagramKind::kLatest) {
+    channel_.SendLatest(frame, NowUs(), send);
+    return UdpLinkError::kOk;
+  }
+  return channel_.SendReliable(frame, NowUs(), send) ? UdpLinkError::kOk : UdpLinkError::kQueueFull;
+}
+
+bool UdpLink::Connected() const {
+  std::scoped_lock lock(mutex_);
+  return socket_ >= 0 && has_peer_;
+}
+
+DatagramStats UdpLink::Stats() const {
+  std::scoped_lock lock(mutex_);
+  return channel_.Stats();
+}
+
+void UdpLink::SendDatagram(std::span<const uint8_t> datagram) {
+  // A failed send is a lost datagram: kLatest does not care and kReliable is retransmitted
+  sendto(socket_, datagram.data(), datagram.size(), 0, reinterpret_cast<const sockaddr*>(&peer_), sizeof(peer_));
+}
+
+}  // namespace embedded
@@ -3,32 +3,51 @@
  *
  * Main application entry point for the servo controller.
  * Receives commands from the desktop/mobile client over Bluetooth SPP
- * and controls servos to track the user's face.
+ * (or UDP over WiFi, see CONFIG_FACE_TRACKER_WIFI) and controls servos
+ * to track the user's face.
  *
  * Uses nanopb (lightweight protobuf) for message serialization.
  */
 
 #include <bluetooth_spp.hpp>
+#include <command_ack.hpp>
+#include <compact_control.hpp>
+#include <loop_timing.hpp>
+#include <mailbox.hpp>
+#include <packet_ring.hpp>
 #include <servo_controller.hpp>
+#include <spp_framing.hpp>
+#include <udp_link.hpp>
+
+#include <sdkconfig.h>
 
 #include <freertos/FreeRTOS.h>
-#include <freertos/queue.h>
 #include <freertos/task.h>
 
+#include <esp_app_desc.h>
 #include <esp_log.h>
 #include <esp_system.h>
 #include <esp_timer.h>
 #include <nvs_flash.h>
 
+#if CONFIG_FACE_TRACKER_WIFI
+#include <esp_check.h>
+#include <esp_event.h>
+#include <esp_netif.h>
+#include <esp_wifi.h>
+#endif
+
 // Nanopb protobuf headers
 #include <messages.pb.h>
 #include <pb.h>
 #include <pb_decode.h>
 #include <pb_encode.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cstring>
+#include <mutex>
 #include <span>
 
 namespace {
@@ -39,31 +58,154 @@ constexpr const char* kDeviceName = "ESP32-FaceTracker";
 // Global servo controller
 embedded::ServoController g_servo_controller;
 
-// Command queue for inter-task communication
-QueueHandle_t g_command_queue = nullptr;
-constexpr size_t kCommandQueueSize = 10;
+// Timing of the servo loop (written by the servo task, read for status reports)
+embedded::Mailbox<embedded::LoopTimingStats> g_servo_loop_stats;
+
+// Task priorities, all far below Bluedroid's (19 and up). The SPP callback only copies bytes into
+// g_bt_ingress, so none of these tasks holds up the Bluetooth stack.
+
+// Above the link tasks: an update that waits behind frame handling is jitter the horns show
+constexpr UBaseType_t kServoTaskPriority = 7;
+
+// Below only the servo loop, whose updates are brief: a command waiting to be handled is latency the tracker sees
+constexpr UBaseType_t kCommandTaskPriority = 6;
+constexpr UBaseType_t kUdpTaskPriority = 6;
+
+// Core of the command task, away from Bluedroid (pinned to core 0 by default)
+#if CONFIG_FREERTOS_UNICORE
+constexpr BaseType_t kCommandTaskCore = 0;
+#else
+constexpr BaseType_t kCommandTaskCore = CONFIG_FACE_TRACKER_COMMAND_TASK_CORE;
+#endif
+
+// How long a compact MOVE velocity is extrapolated: the frame has no horizon field, and this
+// covers one lost command at the 10 Hz the client may drop to
+constexpr uint32_t kCompactMoveHorizonMs = 200;
+
+// SPP data events waiting for the command task, copied in by the Bluetooth callback. An empty
+// packet marks a new connection, so the session resets in order with the bytes around it.
+constexpr size_t kBluetoothIngressSize = 4096;
+constexpr size_t kMaxIngressPacketSize = 1024;  // Above the 990-byte default RFCOMM MTU
+embedded::PacketRing<kBluetoothIngressSize, kMaxIngressPacketSize> g_bt_ingress;
+
+// Decodes and executes what arrives over Bluetooth; created before Bluetooth starts
+TaskHandle_t g_command_task = nullptr;
+
+// Reassembles framed commands from the SPP byte stream (command task only)
+embedded::FrameDecoder g_frame_decoder;
+
+// Serialises frame handling between the command and UDP tasks; the state below marked
+// "frame handling" is only touched with it held
+std::mutex g_frame_mutex;
+
+// Whether the client negotiated protocol v2 compact control (frame handling)
+bool g_compact_enabled = false;
 
-// Buffer for received commands
-struct CommandBuffer {
-  std::array<uint8_t, 512> data;
-  size_t length = 0;
-};
+// Whether successful MOVEs are acknowledged in windows rather than one by one (read by the servo task)
+std::atomic<bool> g_window_ack_enabled{false};
+
+// MOVEs awaiting a windowed acknowledgement (command, UDP and servo tasks, guarded by g_ack_mutex)
+embedded::AckWindow g_ack_window;
+std::mutex g_ack_mutex;
+
+// Recently executed non-idempotent commands, to recognise retransmissions (frame handling)
+embedded::RecentCommands g_recent_commands;
+
+// Whether responses go over UDP: the client is served on whichever link it spoke on last
+std::atomic<bool> g_udp_active{false};
+
+#if CONFIG_FACE_TRACKER_WIFI
+// UDP control link and its frame decoder (UDP task only); one frame per datagram
+embedded::UdpLink g_udp_link;
+embedded::FrameDecoder g_udp_frame_decoder;
+#endif
 
 // Forward declarations
 void ProcessCommand(const app_Command& cmd);
+bool ClientConnected();
+bool SendFrame(embedded::FrameType type, std::span<const uint8_t> payload);
+bool SendResponse(const app_Response& response);
 void SendStatusResponse(uint32_t command_id);
 void SendErrorResponse(uint32_t command_id, app_StatusCode status, const char* message);
 void SendPingResponse(uint32_t command_id, uint64_t client_timestamp);
+void ProcessHandshake(const app_Handshake& handshake);
+embedded::CompactStatus CurrentCompactStatus();
+void ProcessCompactMove(std::span<const uint8_t> payload);
+void AcknowledgeMove(uint8_t sequence);
+void FlushWindowAck();
+void SendWindowAckLocked();
+void ResetClientSession();
+void HandleFrame(const embedded::Frame& frame);
 void OnBluetoothStateChanged(embedded::BluetoothState state);
 void OnBluetoothDataReceived(std::span<const uint8_t> data);
+void HandleBluetoothData(std::span<const uint8_t> data);
+void OnServoTimer(void* arg);
+void CommandTask(void* param);
 void ServoTask(void* param);
+#if CONFIG_FACE_TRACKER_WIFI
+esp_err_t StartWifi();
+void UdpTask(void* param);
+#endif
+
+/**
+ * @brief Checks whether a client can be answered on either link.
+ */
+bool ClientConnected() {
+#if CONFIG_FACE_TRACKER_WIFI
+  if (g_udp_link.Connected()) {
+    return true;
+  }
+#endif
+  return embedded::BluetoothSpp::Instance().Connected();
+}
+
+/**
+ * @brief Sends a payload to the client as one frame.
+ * @return True if the frame was sent
+ */
+bool SendFrame(embedded::FrameType type, std::span<const uint8_t> payload) {
+  std::array<uint8_t, embedded::MaxEncodedFrameSize(256)> frame;
+  size_t frame_size = 0;
+  const auto error = embedded::EncodeFrame(type, payload, frame, frame_size);
+  if (error != embedded::FramingError::kOk) {
+    ESP_LOGE(kTag, "Failed to frame response: %s", embedded::FramingErrorToString(error));
+    return false;
+  }
+
+#if CONFIG_FACE_TRACKER_WIFI
+  if (g_udp_active.load(std::memory_order_relaxed)) {
+    const auto udp_error = g_udp_link.Send(type, std::span<const uint8_t>(frame.data(), frame_size));
+    if (udp_error != embedded::UdpLinkError::kOk) {
+      ESP_LOGW(kTag, "Failed to send over UDP: %s", embedded::UdpLinkErrorToString(udp_error));
+      return false;
+    }
+    return true;
+  }
+#endif
+
+  return embedded::BluetoothSpp::Instance().Send(std::span<const uint8_t>(frame.data(), frame_size)) > 0;
+}
+
+/**
+ * @brief Encodes a response and sends it to the client as one frame.
+ * @return True if the response was sent
+ */
+bool SendResponse(const app_Response& response) {
+  std::array<uint8_t, 256> buffer;
+  pb_ostream_t stream = pb_ostream_from_buffer(buffer.data(), buffer.size());
+  if (!pb_encode(&stream, app_Response_fields, &response)) {
+    ESP_LOGE(kTag, "Failed to encode response: %s", PB_GET_ERROR(&stream));
+    return false;
+  }
+
+  return SendFrame(embedded::FrameType::kResponse, std::span<const uint8_t>(buffer.data(), stream.bytes_written));
+}
 
 /**
  * @brief Sends a status response to the client.
  */
 void SendStatusResponse(uint32_t command_id) {
-  auto& bt = embedded::BluetoothSpp::Instance();
-  if (!bt.Connected()) {
+  if (!ClientConnected()) {
     return;
   }
 
@@ -84,19 +226,26 @@ void SendStatusResponse(uint32_t command_id) {
   status.target_position.tilt = state.target_tilt;
   status.is_calibrated = state.is_calibrated;
   status.is_moving = state.is_moving;
+  const auto loop = g_servo_loop_stats.Load();
+  status.has_servo_loop = true;
+  status.servo_loop.rate_hz = loop.rate_hz;
+  status.servo_loop.updates = loop.updates;
+  status.servo_loop.jitter_us = loop.jitter_us;
+  status.servo_loop.max_jitter_us = loop.max_jitter_us;
+  status.servo_loop.overruns = loop.overruns;
+  status.servo_loop.max_busy_us = loop.max_busy_us;
   status.uptime_ms = static_cast<uint64_t>(esp_timer_get_time() / 1000);
   status.free_heap = static_cast<uint32_t>(esp_get_free_heap_size());
-  status.wifi_rssi = 0;  // Not using WiFi
-
-  // Encode response
-  std::array<uint8_t, 256> buffer;
-  pb_ostream_t stream = pb_ostream_from_buffer(buffer.data(), buffer.size());
+  status.wifi_rssi = 0;
+#if CONFIG_FACE_TRACKER_WIFI
+  wifi_ap_record_t access_point;
+  if (esp_wifi_sta_get_ap_info(&access_point) == ESP_OK) {
+    status.wifi_rssi = access_point.rssi;
+  }
+#endif
 
-  if (pb_encode(&stream, app_Response_fields, &response)) {
-    bt.Send(std::span<const uint8_t>(buffer.data(), stream.bytes_written));
-    ESP_LOGD(kTag, "Status response sent: %zu bytes", stream.bytes_written);
-  } else {
-    ESP_LOGE(kTag, "Failed to encode status response");
+  if (SendResponse(response)) {
+    ESP_LOGD(kTag, "Status response sent");
   }
 }
 
@@ -104,8 +253,7 @@ void SendStatusResponse(uint32_t command_id) {
  * @brief Sends an error response to the client.
  */
 void SendErrorResponse(uint32_t command_id, app_StatusCode status, const char* message) {
-  auto& bt = embedded::BluetoothSpp::Instance();
-  if (!bt.Connected()) {
+  if (!ClientConnected()) {
     return;
   }
 
@@ -120,15 +268,8 @@ void SendErrorResponse(uint32_t command_id, app_StatusCode status, const char* m
   strncpy(error.message, message, sizeof(error.message) - 1);
   error.message[sizeof(error.message) - 1] = '\0';
 
-  // Encode response
-  std::array<uint8_t, 256> buffer;
-  pb_ostream_t stream = pb_ostream_from_buffer(buffer.data(), buffer.size());
-
-  if (pb_encode(&stream, app_Response_fields, &response)) {
-    bt.Send(std::span<const uint8_t>(buffer.data(), stream.bytes_written));
-    ESP_LOGD(kTag, "Error response sent: %zu bytes", stream.bytes_written);
-  } else {
-    ESP_LOGE(kTag, "Failed to encode error response");
+  if (SendResponse(response)) {
+    ESP_LOGD(kTag, "Error response sent");
   }
 }
 
@@ -136,8 +277,7 @@ void SendErrorResponse(uint32_t command_id, app_StatusCode status, const char* m
  * @brief Sends a ping response to the client.
  */
 void SendPingResponse(uint32_t command_id, uint64_t /*client_timestamp*/) {
-  auto& bt = embedded::BluetoothSpp::Instance();
-  if (!bt.Connected()) {
+  if (!ClientConnected()) {
     return;
   }
 
@@ -146,16 +286,146 @@ void SendPingResponse(uint32_t command_id, uint64_t /*client_timestamp*/) {
   response.timestamp_ms = static_cast<uint64_t>(esp_timer_get_time() / 1000);
   response.status = app_StatusCode_STATUS_CODE_OK;
 
-  // Encode response
-  std::array<uint8_t, 64> buffer;
+  if (SendResponse(response)) {
+    ESP_LOGD(kTag, "Ping response sent");
+  }
+}
+
+/**
+ * @brief Answers a client handshake, enabling compact control if the client asks for it.
+ */
+void ProcessHandshake(const app_Handshake& handshake) {
+  bool wants_compact = false;
+  bool wants_window_ack = false;
+  for (pb_size_t i = 0; i < handshake.features_count; ++i) {
+    wants_compact = wants_compact || std::strcmp(handshake.features[i], embedded::kCompactControlFeature) == 0;
+    wants_window_ack = wants_window_ack || std::strcmp(handshake.features[i], embedded::kWindowAckFeature) == 0;
+  }
+  g_compact_enabled = wants_compact && handshake.protocol_version >= embedded::kCompactProtocolVersion;
+
+  // WindowAck carries a CompactStatus, so it is only offered on top of compact control
+  const bool window_ack = g_compact_enabled && wants_window_ack;
+  {
+    std::scoped_lock lock(g_ack_mutex);
+    g_ack_window.Reset();
+  }
+  g_window_ack_enabled.store(window_ack, std::memory_order_relaxed);
+
+  ESP_LOGI(kTag, "Handshake from '%s': protocol v%lu, compact control %s, windowed acks %s", handshake.client_id,
+           static_cast<unsigned long>(handshake.protocol_version), g_compact_enabled ? "enabled" : "disabled",
+           window_ack ? "enabled" : "disabled");
+
+  app_HandshakeResponse response = app_HandshakeResponse_init_zero;
+  response.protocol_version = g_compact_enabled ? embedded::kCompactProtocolVersion : 1;
+  std::strncpy(response.device_id, kDeviceName, sizeof(response.device_id) - 1);
+  std::strncpy(response.firmware_version, esp_app_get_description()->version, sizeof(response.firmware_version) - 1);
+  if (g_compact_enabled) {
+    std::strncpy(response.supported_features[response.supported_features_count++], embedded::kCompactControlFeature,
+                 sizeof(response.supported_features[0]) - 1);
+  }
+  if (window_ack) {
+    std::strncpy(response.supported_features[response.supported_features_count++], embedded::kWindowAckFeature,
+                 sizeof(response.supported_features[0]) - 1);
+  }
+  response.accepted = true;
+
+  std::array<uint8_t, app_HandshakeResponse_size> buffer;
   pb_ostream_t stream = pb_ostream_from_buffer(buffer.data(), buffer.size());
+  if (!pb_encode(&stream, app_HandshakeResponse_fields, &response)) {
+    ESP_LOGE(kTag, "Failed to encode handshake response: %s", PB_GET_ERROR(&stream));
+    return;
+  }
 
-  if (pb_encode(&stream, app_Response_fields, &response)) {
-    bt.Send(std::span<const uint8_t>(buffer.data(), stream.bytes_written));
-    ESP_LOGD(kTag, "Ping response sent");
-  } else {
-    ESP_LOGE(kTag, "Failed to encode ping response");
+  SendFrame(embedded::FrameType::kHandshake, std::span<const uint8_t>(buffer.data(), stream.bytes_written));
+}
+
+/**
+ * @brief Snapshots the servo state as a compact status (sequence and rejected left unset).
+ */
+embedded::CompactStatus CurrentCompactStatus() {
+  const auto state = g_servo_controller.State();
+  embedded::CompactStatus status;
+  status.pan = state.pan;
+  status.tilt = state.tilt;
+  status.target_pan = state.target_pan;
+  status.target_tilt = state.target_tilt;
+  status.moving = state.is_moving;
+  status.calibrated = state.is_calibrated;
+  return status;
+}
+
+/**
+ * @brief Processes a protocol v2 compact MOVE.
+ * @details A rejected MOVE is answered at once with a compact status. An accepted one is either
+ * answered the same way or, with windowed acks negotiated, left to the next WindowAck.
+ */
+void ProcessCompactMove(std::span<const uint8_t> payload) {
+  embedded::CompactMove move;
+  if (!g_compact_enabled || !embedded::DecodeCompactMove(payload, move)) {
+    ESP_LOGW(kTag, "Ignoring compact frame (%zu bytes, compact control %s)", payload.size(),
+             g_compact_enabled ? "enabled" : "not negotiated");
+    return;
+  }
+
+  // MOVEs arrive at frame rate, so unlike ProcessCommand() this path does not log at info level
+  const bool accepted = g_servo_controller.IsCalibrated();
+  if (accepted && move.has_velocity) {
+    g_servo_controller.Track(move.pan, move.tilt, move.pan_velocity, move.tilt_velocity, kCompactMoveHorizonMs);
+  } else if (accepted) {
+    g_servo_controller.MoveTo(move.pan, move.tilt, true);
+  }
+
+  if (accepted && g_window_ack_enabled.load(std::memory_order_relaxed)) {
+    AcknowledgeMove(move.sequence);
+    return;
   }
+
+  auto status = CurrentCompactStatus();
+  status.sequence = move.sequence;
+  status.rejected = !accepted;
+
+  std::array<uint8_t, embedded::kCompactStatusSize> buffer;
+  const size_t size = embedded::EncodeCompactStatus(status, buffer);
+  SendFrame(embedded::FrameType::kCompact, std::span<const uint8_t>(buffer.data(), size));
+}
+
+/**
+ * @brief Records an accepted MOVE, sending a WindowAck once AckWindow::kFlushCount are waiting.
+ */
+void AcknowledgeMove(uint8_t sequence) {
+  const auto now_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+  std::scoped_lock lock(g_ack_mutex);
+  if (g_ack_window.Record(sequence, now_ms)) {
+    SendWindowAckLocked();
+  }
+}
+
+/**
+ * @brief Sends a WindowAck if MOVEs have waited AckWindow::kFlushIntervalMs (servo task).
+ */
+void FlushWindowAck() {
+  if (!g_window_ack_enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  const auto now_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+  std::scoped_lock lock(g_ack_mutex);
+  if (g_ack_window.FlushDue(now_ms)) {
+    SendWindowAckLocked();
+  }
+}
+
+/**
+ * @brief Acknowledges every waiting MOVE in one WindowAck (g_ack_mutex held).
+ */
+void SendWindowAckLocked() {
+  embedded::WindowAck ack;
+  ack.status = CurrentCompactStatus();
+  g_ack_window.Take(ack);
+
+  std::array<uint8_t, embedded::kWindowAckSize> buffer;
+  const size_t size = embedded::EncodeWindowAck(ack, buffer);
+  SendFrame(embedded::FrameType::kWindowAck, std::span<const uint8_t>(buffer.data(), size));
 }
 
 /**
@@ -164,12 +434,30 @@ void SendPingResponse(uint32_t command_id, uint64_t /*client_timestamp*/) {
 void ProcessCommand(const app_Command& cmd) {
   ESP_LOGI(kTag, "Processing command: type=%d, id=%lu", cmd.type, static_cast<unsigned long>(cmd.id));
 
+  // The client retransmits these until answered; a repeat is answered again but not executed twice
+  const bool idempotent =
+      cmd.type != app_CommandType_COMMAND_TYPE_CALIBRATE && cmd.type != app_CommandType_COMMAND_TYPE_SET_CONFIG;
+  if (!idempotent && g_recent_commands.Contains(cmd.id)) {
+    ESP_LOGI(kTag, "Repeated command id=%lu, answering without executing it again", static_cast<unsigned long>(cmd.id));
+    SendStatusResponse(cmd.id);
+    return;
+  }
+
   switch (cmd.type) {
     case app_CommandType_COMMAND_TYPE_MOVE: {
       if (cmd.which_payload == app_Command_move_tag && cmd.payload.move.has_target_position) {
-        const auto& target = cmd.payload.move.target_position;
-        ESP_LOGI(kTag, "Move command: pan=%.2f, tilt=%.2f", static_cast<double>(target.pan),
-                 static_cast<double>(target.tilt));
+        const auto& move = cmd.payload.move;
+        const auto& target = move.target_position;
+        const bool tracking = move.has_target_velocity && move.valid_for_ms > 0;
+        if (tracking) {
+          ESP_LOGI(kTag, "Move command: pan=%.2f, tilt=%.2f, velocity=(%.2f, %.2f) deg/s for %lu ms",
+                   static_cast<double>(target.pan), static_cast<double>(target.tilt),
+                   static_cast<double>(move.target_velocity.pan), static_cast<double>(move.target_velocity.tilt),
+                   static_cast<unsigned long>(move.valid_for_ms));
+        } else {
+          ESP_LOGI(kTag, "Move command: pan=%.2f, tilt=%.2f", static_cast<double>(target.pan),
+                   static_cast<double>(target.tilt));
+        }
 
         // Check if calibrated
         if (!g_servo_controller.IsCalibrated()) {
@@ -178,12 +466,21 @@ void ProcessCommand(const app_Command& cmd) {
           break;
         }
 
-        // Move servos
-        const bool use_smooth = !cmd.payload.move.use_face_tracking;  // Use smooth for direct commands
-        g_servo_controller.MoveTo(target.pan, target.tilt, use_smooth);
+        // Move servos, extrapolating the target between commands if it carries a velocity
+        const bool use_smooth = !move.use_face_tracking;  // Use smooth for direct commands
+        if (tracking && use_smooth) {
+          g_servo_controller.Track(target.pan, target.tilt, move.target_velocity.pan, move.target_velocity.tilt,
+                                   move.valid_for_ms);
+        } else {
+          g_servo_controller.MoveTo(target.pan, target.tilt, use_smooth);
+        }
 
-        // Send success response
-        SendStatusResponse(cmd.id);
+        // Send success response, or leave it to the next WindowAck
+        if (g_window_ack_enabled.load(std::memory_order_relaxed)) {
+          AcknowledgeMove(static_cast<uint8_t>(cmd.id));
+        } else {
+          SendStatusResponse(cmd.id);
+        }
       } else {
         ESP_LOGW(kTag, "Move command missing target position");
         SendErrorResponse(cmd.id, app_StatusCode_STATUS_CODE_INVALID_COMMAND, "Missing target position");
@@ -211,6 +508,7 @@ void ProcessCommand(const app_Command& cmd) {
 
       // Perform calibration
       g_servo_controller.Calibrate();
+      g_recent_commands.Insert(cmd.id);
 
       SendStatusResponse(cmd.id);
       break;
@@ -249,6 +547,7 @@ void ProcessCommand(const app_Command& cmd) {
         servo_config.invert_tilt = config.invert_tilt;
 
         g_servo_controller.UpdateConfig(servo_config);
+        g_recent_commands.Insert(cmd.id);
         SendStatusResponse(cmd.id);
       } else {
         SendErrorResponse(cmd.id, app_StatusCode_STATUS_CODE_INVALID_COMMAND, "Missing configuration");
@@ -269,12 +568,65 @@ void ProcessCommand(const app_Command& cmd) {
   }
 }
 
+/**
+ * @brief Forgets what the previous client negotiated (frame handling).
+ */
+void ResetClientSession() {
+  g_compact_enabled = false;
+  g_window_ack_enabled.store(false, std::memory_order_relaxed);
+  g_recent_commands.Reset();
+}
+
+/**
+ * @brief Dispatches one received frame, whichever link it arrived on (frame handling).
+ */
+void HandleFrame(const embedded::Frame& frame) {
+  switch (frame.type) {
+    case embedded::FrameType::kCommand: {
+      app_Command cmd = app_Command_init_zero;
+      pb_istream_t stream = pb_istream_from_buffer(frame.payload.data(), frame.payload.size());
+
+      if (pb_decode(&stream, app_Command_fields, &cmd)) {
+        ProcessCommand(cmd);
+      } else {
+        ESP_LOGW(kTag, "Failed to decode command: %s", PB_GET_ERROR(&stream));
+      }
+      break;
+    }
+
+    case embedded::FrameType::kHandshake: {
+      app_Handshake handshake = app_Handshake_init_zero;
+      pb_istream_t stream = pb_istream_from_buffer(frame.payload.data(), frame.payload.size());
+
+      if (pb_decode(&stream, app_Handshake_fields, &handshake)) {
+        ProcessHandshake(handshake);
+      } else {
+        ESP_LOGW(kTag, "Failed to decode handshake: %s", PB_GET_ERROR(&stream));
+      }
+      break;
+    }
+
+    case embedded::FrameType::kCompact:
+      ProcessCompactMove(frame.payload);
+      break;
+
+    default:
+      ESP_LOGW(kTag, "Ignoring frame with unexpected type %d", static_cast<int>(frame.type));
+      break;
+  }
+}
+
 /**
  * @brief Callback for Bluetooth state changes.
  */
 void OnBluetoothStateChanged(embedded::BluetoothState state) {
   switch (state) {
     case embedded::BluetoothState::kConnected:
+      // The command task resets the session when it reaches this marker
+      if (!g_bt_ingress.Push({})) {
+        ESP_LOGW(kTag, "Bluetooth ingress full, session not reset");
+      }
+      xTaskNotifyGive(g_command_task);
       ESP_LOGI(kTag, "Client connected!");
       break;
     case embedded::BluetoothState::kInitialized:
@@ -289,42 +641,200 @@ void OnBluetoothStateChanged(embedded::BluetoothState state) {
 }
 
 /**
- * @brief Callback for received Bluetooth data.
+ * @brief Callback for received Bluetooth data (Bluedroid task).
+ * @details Runs on the task that drives the whole Bluetooth stack, so it only copies the bytes for
+ * the command task and never waits: when the ingress is full the data is dropped and counted.
  */
 void OnBluetoothDataReceived(std::span<const uint8_t> data) {
+  while (!data.empty()) {
+    const auto packet = data.first(std::min(data.size(), kMaxIngressPacketSize));
+    (void)g_bt_ingress.Push(packet);
+    data = data.subspan(packet.size());
+  }
+  xTaskNotifyGive(g_command_task);
+}
+
+/**
+ * @brief Handles bytes received over Bluetooth (command task).
+ */
+void HandleBluetoothData(std::span<const uint8_t> data) {
   ESP_LOGD(kTag, "Received %zu bytes", data.size());
 
-  // Decode command
-  app_Command cmd = app_Command_init_zero;
-  pb_istream_t stream = pb_istream_from_buffer(data.data(), data.size());
+  // SPP is a byte stream: a data event may hold part of a frame or several frames
+  const uint32_t dropped_before = g_frame_decoder.FramesDropped();
+  g_frame_decoder.Feed(data, [](const embedded::Frame& frame) {
+    std::scoped_lock lock(g_frame_mutex);
+    g_udp_active.store(false, std::memory_order_relaxed);
+    HandleFrame(frame);
+  });
+
+  if (g_frame_decoder.FramesDropped() != dropped_before) {
+    ESP_LOGW(kTag, "Dropped %lu corrupt frame(s): %s",
+             static_cast<unsigned long>(g_frame_decoder.FramesDropped() - dropped_before),
+             embedded::FramingErrorToString(g_frame_decoder.LastError()));
+  }
+}
 
-  if (pb_decode(&stream, app_Command_fields, &cmd)) {
-    ProcessCommand(cmd);
-  } else {
-    ESP_LOGW(kTag, "Failed to decode command: %s", PB_GET_ERROR(&stream));
+/**
+ * @brief Command task: decodes and executes what the Bluetooth callback queued.
+ * @details Commands may take a while (CALIBRATE waits seconds for the servo loop); here that only
+ * delays later commands, which queue up in g_bt_ingress, instead of stalling the Bluetooth stack.
+ */
+void CommandTask(void* /*param*/) {
+  // Static rather than on the task stack, which nanopb needs for decoding
+  static std::array<uint8_t, kMaxIngressPacketSize> packet;
+  uint32_t rejected_reported = 0;
+
+  ESP_LOGI(kTag, "Command task started on core %d", static_cast<int>(kCommandTaskCore));
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    while (const auto size = g_bt_ingress.Pop(packet)) {
+      if (*size == 0) {
+        // A new connection: bytes left over from the previous client belong to no frame
+        g_frame_decoder.Reset();
+        std::scoped_lock lock(g_frame_mutex);
+        g_udp_active.store(false, std::memory_order_relaxed);
+        ResetClientSession();
+        continue;
+      }
+      HandleBluetoothData(std::span<const uint8_t>(packet.data(), *size));
+    }
+
+    const auto stats = g_bt_ingress.Stats();
+    if (stats.rejected != rejected_reported) {
+      ESP_LOGW(kTag, "Bluetooth ingress full: dropped %lu data event(s), %lu bytes so far",
+               static_cast<unsigned long>(stats.rejected), static_cast<unsigned long>(stats.rejected_bytes));
+      rejected_reported = stats.rejected;
+    }
   }
 }
 
 /**
- * @brief Servo control task.
+ * @brief Wakes the servo task (esp_timer task, once per servo loop period).
  */
-void ServoTask(void* /*param*/) {
-  ESP_LOGI(kTag, "Servo task started");
+void OnServoTimer(void* arg) {
+  xTaskNotifyGive(static_cast<TaskHandle_t>(arg));
+}
 
-  uint64_t last_update_time = esp_timer_get_time() / 1000ULL;
+/**
+ * @brief Servo control task: updates the servos each time the servo timer fires.
+ * @details The timer keeps the period at CONFIG_FACE_TRACKER_SERVO_RATE_HZ whatever an update
+ * costs, where vTaskDelay() would add the update to the period and round it to the tick.
+ */
+void ServoTask(void* /*param*/) {
+  embedded::LoopTiming timing(CONFIG_FACE_TRACKER_SERVO_RATE_HZ);
+
+  esp_timer_create_args_t timer_args = {};
+  timer_args.callback = OnServoTimer;
+  timer_args.arg = xTaskGetCurrentTaskHandle();
+  timer_args.dispatch_method = ESP_TIMER_TASK;
+  timer_args.name = "servo_loop";
+  timer_args.skip_unhandled_events = true;  // A late update catches up by its longer step, not in a burst
+
+  esp_timer_handle_t timer = nullptr;
+  esp_err_t ret = esp_timer_create(&timer_args, &timer);
+  if (ret == ESP_OK) {
+    ret = esp_timer_start_periodic(timer, timing.PeriodUs());
+  }
+  if (ret != ESP_OK) {
+    ESP_LOGE(kTag, "Failed to start servo timer: %s", esp_err_to_name(ret));
+    vTaskDelete(nullptr);
+    return;
+  }
+  ESP_LOGI(kTag, "Servo task started at %d Hz", CONFIG_FACE_TRACKER_SERVO_RATE_HZ);
 
   while (true) {
-    const uint64_t current_time = esp_timer_get_time() / 1000ULL;
-    const uint32_t delta_time = static_cast<uint32_t>(current_time - last_update_time);
-    last_update_time = current_time;
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    const int64_t start = esp_timer_get_time();
 
     // Update servo controller
-    g_servo_controller.Update(delta_time);
+    g_servo_controller.Update(timing.Tick(start));
 
-    vTaskDelay(pdMS_TO_TICKS(20));  // 50Hz update rate
+    // Acknowledge MOVEs that arrived too slowly to fill a window
+    FlushWindowAck();
+
+    timing.Busy(static_cast<uint32_t>(esp_timer_get_time() - start));
+    g_servo_loop_stats.Store(timing.Stats());
   }
 }
 
+#if CONFIG_FACE_TRACKER_WIFI
+/**
+ * @brief Keeps the station associated, reconnecting whenever the access point drops it.
+ */
+void OnWifiEvent(void* /*arg*/, esp_event_base_t base, int32_t id, void* data) {
+  if (base == WIFI_EVENT && (id == WIFI_EVENT_STA_START || id == WIFI_EVENT_STA_DISCONNECTED)) {
+    esp_wifi_connect();
+  } else if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP) {
+    const auto* event = static_cast<const ip_event_got_ip_t*>(data);
+    ESP_LOGI(kTag, "WiFi connected, control on " IPSTR ":%d", IP2STR(&event->ip_info.ip), CONFIG_FACE_TRACKER_UDP_PORT);
+  }
+}
+
+/**
+ * @brief Joins the configured network as a station.
+ */
+esp_err_t StartWifi() {
+  ESP_RETURN_ON_ERROR(esp_netif_init(), kTag, "netif init failed");
+  ESP_RETURN_ON_ERROR(esp_event_loop_create_default(), kTag, "event loop failed");
+  esp_netif_create_default_wifi_sta();
+
+  const wifi_init_config_t init_config = WIFI_INIT_CONFIG_DEFAULT();
+  ESP_RETURN_ON_ERROR(esp_wifi_init(&init_config), kTag, "WiFi init failed");
+  ESP_RETURN_ON_ERROR(esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, OnWifiEvent, nullptr), kTag,
+                      "WiFi handler failed");
+  ESP_RETURN_ON_ERROR(esp_event_handler_register(IP_EVENT, IP_EVENT_STA_GOT_IP, OnWifiEvent, nullptr), kTag,
+                      "IP handler failed");
+
+  wifi_config_t wifi_config = {};
+  std::strncpy(reinterpret_cast<char*>(wifi_config.sta.ssid), CONFIG_FACE_TRACKER_WIFI_SSID,
+               sizeof(wifi_config.sta.ssid) - 1);
+  std::strncpy(reinterpret_cast<char*>(wifi_config.sta.password), CONFIG_FACE_TRACKER_WIFI_PASSWORD,
+               sizeof(wifi_config.sta.password) - 1);
+  ESP_RETURN_ON_ERROR(esp_wifi_set_mode(WIFI_MODE_STA), kTag, "WiFi mode failed");
+  ESP_RETURN_ON_ERROR(esp_wifi_set_config(WIFI_IF_STA, &wifi_config), kTag, "WiFi config failed");
+  ESP_RETURN_ON_ERROR(esp_wifi_start(), kTag, "WiFi start failed");
+
+  // Modem sleep holds incoming datagrams until the next DTIM beacon, adding up to ~100 ms per MOVE
+  return esp_wifi_set_ps(WIFI_PS_NONE);
+}
+
+/**
+ * @brief UDP control task: receives datagrams and retransmits reliable frames.
+ */
+void UdpTask(void* /*param*/) {
+  g_udp_link.SetPeerCallback([] {
+    g_udp_frame_decoder.Reset();
+    std::scoped_lock lock(g_frame_mutex);
+    ResetClientSession();
+    ESP_LOGI(kTag, "UDP client connected!");
+  });
+  g_udp_link.SetFrameCallback([](std::span<const uint8_t> datagram_frame) {
+    g_udp_frame_decoder.Feed(datagram_frame, [](const embedded::Frame& frame) {
+      std::scoped_lock lock(g_frame_mutex);
+      g_udp_active.store(true, std::memory_order_relaxed);
+      HandleFrame(frame);
+    });
+  });
+
+  const auto error = g_udp_link.Open(CONFIG_FACE_TRACKER_UDP_PORT);
+  if (error != embedded::UdpLinkError::kOk) {
+    ESP_LOGE(kTag, "Failed to open UDP port %d: %s", CONFIG_FACE_TRACKER_UDP_PORT,
+             embedded::UdpLinkErrorToString(error));
+    vTaskDelete(nullptr);
+    return;
+  }
+
+  ESP_LOGI(kTag, "UDP task started");
+  while (true) {
+    if (g_udp_link.Poll(embedded::UdpLink::kPollIntervalMs) != embedded::UdpLinkError::kOk) {
+      vTaskDelay(pdMS_TO_TICKS(embedded::UdpLink::kPollIntervalMs));
+    }
+  }
+}
+#endif
+
 }  // namespace
 
 extern "C" void app_main() {
@@ -359,10 +869,10 @@ extern "C" void app_main() {
     return;
   }
 
-  // Create command queue
-  g_command_queue = xQueueCreate(kCommandQueueSize, sizeof(CommandBuffer));
-  if (!g_command_queue) {
-    ESP_LOGE(kTag, "Failed to create command queue");
+  // Create the command task before Bluetooth can deliver anything to it
+  if (xTaskCreatePinnedToCore(CommandTask, "command_task", 4096, nullptr, kCommandTaskPriority, &g_command_task,
+                              kCommandTaskCore) != pdPASS) {
+    ESP_LOGE(kTag, "Failed to create command task");
     return;
   }
 
@@ -377,8 +887,17 @@ extern "C" void app_main() {
     return;
   }
 
+#if CONFIG_FACE_TRACKER_WIFI
+  ret = StartWifi();
+  if (ret == ESP_OK) {
+    xTaskCreate(UdpTask, "udp_task", 4096, nullptr, kUdpTaskPriority, nullptr);
+  } else {
+    ESP_LOGE(kTag, "Failed to start WiFi, continuing on Bluetooth only: %s", esp_err_to_name(ret));
+  }
+#endif
+
   // Create servo control task
-  xTaskCreate(ServoTask, "servo_task", 4096, nullptr, 5, nullptr);
+  xTaskCreate(ServoTask, "servo_task", 4096, nullptr, kServoTaskPriority, nullptr);
 
   ESP_LOGI(kTag, "Initialization complete");
   ESP_LOGI(kTag, "Device name: %s", kDeviceName);
@@ -390,6 +909,25 @@ extern "C" void app_main() {
     ESP_LOGI(kTag, "Status: BT=%s, Heap=%lu bytes, Servo=[%.1f, %.1f] %s", bt.Connected() ? "connected" : "waiting",
              esp_get_free_heap_size(), static_cast<double>(state.pan), static_cast<double>(state.tilt),
              state.is_moving ? "moving" : "idle");
+    const auto loop = g_servo_loop_stats.Load();
+    ESP_LOGI(kTag, "Servo loop: %lu Hz, updates=%lu, jitter=%lu us (max %lu us), overruns=%lu, max busy=%lu us",
+             static_cast<unsigned long>(loop.rate_hz), static_cast<unsigned long>(loop.updates),
+             static_cast<unsigned long>(loop.jitter_us), static_cast<unsigned long>(loop.max_jitter_us),
+             static_cast<unsigned long>(loop.overruns), static_cast<unsigned long>(loop.max_busy_us));
+    const auto ingress = g_bt_ingress.Stats();
+    ESP_LOGI(kTag, "BT ingress: events=%lu, dropped=%lu (%lu bytes), high water=%lu/%u bytes",
+             static_cast<unsigned long>(ingress.pushed), static_cast<unsigned long>(ingress.rejected),
+             static_cast<unsigned long>(ingress.rejected_bytes), static_cast<unsigned long>(ingress.high_water),
+             static_cast<unsigned>(kBluetoothIngressSize));
+#if CONFIG_FACE_TRACKER_WIFI
+    if (g_udp_link.Connected()) {
+      const auto stats = g_udp_link.Stats();
+      ESP_LOGI(kTag, "UDP: received=%lu, lost=%lu, late=%lu, jitter=%lu us, retransmissions=%lu",
+               static_cast<unsigned long>(stats.received), static_cast<unsigned long>(stats.lost),
+               static_cast<unsigned long>(stats.late), static_cast<unsigned long>(stats.jitter_us),
+               static_cast<unsigned long>(stats.retransmissions));
+    }
+#endif
 
     vTaskDelay(pdMS_TO_TICKS(10000));  // Print status every 10 seconds
   }
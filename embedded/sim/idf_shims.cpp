@@ -0,0 +1,369 @@
+/**
+ * @file idf_shims.cpp
+ * @brief Host implementations of the ESP-IDF and FreeRTOS services the firmware uses
+ */
+
+#include <esp_app_desc.h>
+#include <esp_err.h>
+#include <esp_log.h>
+#include <esp_system.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <nvs_flash.h>
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef FIRMWARE_SIM_VERSION
+#define FIRMWARE_SIM_VERSION "sim"
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// "Power-on" time: the simulator's clock starts with the process.
+const Clock::time_point g_boot_time = Clock::now();
+
+std::atomic<esp_log_level_t> g_log_level{ESP_LOG_INFO};
+std::mutex g_log_mutex;
+
+/// Free heap reported to the client; roughly what the firmware leaves free on an ESP32.
+constexpr uint32_t kSimulatedFreeHeap = 180 * 1024;
+
+[[nodiscard]] char LevelLetter(esp_log_level_t level) noexcept {
+  switch (level) {
+    case ESP_LOG_ERROR:
+      return 'E';
+    case ESP_LOG_WARN:
+      return 'W';
+    case ESP_LOG_INFO:
+      return 'I';
+    case ESP_LOG_DEBUG:
+      return 'D';
+    case ESP_LOG_VERBOSE:
+      return 'V';
+    default:
+      return '?';
+  }
+}
+
+}  // namespace
+
+struct SimTask {
+  std::mutex mutex;
+  std::condition_variable notified;
+  uint32_t notifications = 0;
+};
+
+struct SimTimer {
+  esp_timer_create_args_t args;
+  std::mutex mutex;
+  std::condition_variable stop_requested;
+  std::thread thread;
+  bool running = false;
+  bool stopping = false;
+};
+
+namespace {
+
+/// Task of the calling thread; threads not started by xTaskCreate() (app_main) get one on first use.
+thread_local SimTask* t_current_task = nullptr;
+
+/**
+ * @brief Runs a periodic timer's callbacks until it is stopped.
+ * @details Deadlines are absolute, so the period does not drift with the callback's run time.
+ */
+void RunPeriodicTimer(SimTimer* timer, std::chrono::microseconds period) {
+  std::unique_lock lock(timer->mutex);
+  auto deadline = Clock::now() + period;
+  while (!timer->stop_requested.wait_until(lock, deadline, [timer] { return timer->stopping; })) {
+    lock.unlock();
+    timer->args.callback(timer->args.arg);
+    lock.lock();
+
+    deadline += period;
+    if (timer->args.skip_unhandled_events && deadline < Clock::now()) {
+      const auto missed = (Clock::now() - deadline) / period + 1;
+      deadline += missed * period;
+    }
+  }
+}
+
+}  // namespace
+
+struct SimQueue {
+  std::mutex mutex;
+  std::condition_variable not_empty;
+  std::condition_variable not_full;
+  std::deque<std::vector<uint8_t>> items;
+  size_t length = 0;
+  size_t item_size = 0;
+};
+
+const char* esp_err_to_name(esp_err_t code) {
+  switch (code) {
+    case ESP_OK:
+      return "ESP_OK";
+    case ESP_FAIL:
+      return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+      return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+      return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+      return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_NOT_FOUND:
+      return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_TIMEOUT:
+      return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_NVS_NO_FREE_PAGES:
+      return "ESP_ERR_NVS_NO_FREE_PAGES";
+    case ESP_ERR_NVS_NEW_VERSION_FOUND:
+      return "ESP_ERR_NVS_NEW_VERSION_FOUND";
+    default:
+      return "UNKNOWN ERROR";
+  }
+}
+
+void esp_log_level_set(const char* /*tag*/, esp_log_level_t level) {
+  g_log_level.store(level, std::memory_order_relaxed);
+}
+
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...) {
+  if (level == ESP_LOG_NONE || level > g_log_level.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  // Same layout as the ESP-IDF console, so device and simulator logs read alike
+  std::scoped_lock lock(g_log_mutex);
+  std::fprintf(stderr, "%c (%lld) %s: ", LevelLetter(level), static_cast<long long>(esp_timer_get_time() / 1000),
+               tag);
+  va_list args;
+  va_start(args, format);
+  std::vfprintf(stderr, format, args);
+  va_end(args);
+  std::fputc('\n', stderr);
+}
+
+int64_t esp_timer_get_time() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - g_boot_time).count();
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle) {
+  if (args == nullptr || args->callback == nullptr || handle == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  auto* timer = new SimTimer;
+  timer->args = *args;
+  *handle = timer;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us) {
+  if (period_us == 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  std::scoped_lock lock(timer->mutex);
+  if (timer->running) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  timer->running = true;
+  timer->stopping = false;
+  timer->thread = std::thread([timer, period_us] {
+    std::string thread_name = timer->args.name != nullptr ? timer->args.name : "esp_timer";
+    thread_name.resize(std::min<size_t>(thread_name.size(), 15));
+    pthread_setname_np(pthread_self(), thread_name.c_str());
+    RunPeriodicTimer(timer, std::chrono::microseconds(period_us));
+  });
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+  {
+    std::scoped_lock lock(timer->mutex);
+    if (!timer->running) {
+      return ESP_ERR_INVALID_STATE;
+    }
+    timer->stopping = true;
+    timer->stop_requested.notify_one();
+  }
+  timer->thread.join();
+  std::scoped_lock lock(timer->mutex);
+  timer->running = false;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+  {
+    std::scoped_lock lock(timer->mutex);
+    if (timer->running) {
+      return ESP_ERR_INVALID_STATE;
+    }
+  }
+  delete timer;
+  return ESP_OK;
+}
+
+uint32_t esp_get_free_heap_size() {
+  return kSimulatedFreeHeap;
+}
+
+void esp_restart() {
+  std::fflush(nullptr);
+  std::_Exit(EXIT_SUCCESS);
+}
+
+const esp_app_desc_t* esp_app_get_description() {
+  static const esp_app_desc_t description = [] {
+    esp_app_desc_t desc{};
+    std::strncpy(desc.version, FIRMWARE_SIM_VERSION, sizeof(desc.version) - 1);
+    std::strncpy(desc.project_name, "embedded", sizeof(desc.project_name) - 1);
+    return desc;
+  }();
+  return &description;
+}
+
+esp_err_t nvs_flash_init() {
+  return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase() {
+  return ESP_OK;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t /*stack_depth*/, void* param,
+                       UBaseType_t /*priority*/, TaskHandle_t* handle) {
+  // Linux limits thread names to 15 characters
+  std::string thread_name = name != nullptr ? name : "task";
+  thread_name.resize(std::min<size_t>(thread_name.size(), 15));
+
+  // Tasks run for the life of the firmware, so their notification state is never freed
+  auto* task = new SimTask;
+  std::thread thread([function, param, thread_name, task] {
+    pthread_setname_np(pthread_self(), thread_name.c_str());
+    t_current_task = task;
+    function(param);
+  });
+  thread.detach();
+
+  if (handle != nullptr) {
+    *handle = task;
+  }
+  return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stack_depth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t /*core_id*/) {
+  return xTaskCreate(function, name, stack_depth, param, priority, handle);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  if (task != nullptr) {
+    ESP_LOGE("sim", "vTaskDelete() of another task is not supported");
+    return;
+  }
+  pthread_exit(nullptr);
+}
+
+void vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount() {
+  return static_cast<TickType_t>(esp_timer_get_time() / 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  if (t_current_task == nullptr) {
+    t_current_task = new SimTask;
+  }
+  return t_current_task;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  std::scoped_lock lock(task->mutex);
+  ++task->notifications;
+  task->notified.notify_one();
+  return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait) {
+  SimTask* task = xTaskGetCurrentTaskHandle();
+  std::unique_lock lock(task->mutex);
+  const auto notified = [task] { return task->notifications != 0; };
+  if (ticks_to_wait == portMAX_DELAY) {
+    task->notified.wait(lock, notified);
+  } else if (!task->notified.wait_for(lock, std::chrono::milliseconds(ticks_to_wait), notified)) {
+    return 0;
+  }
+
+  const uint32_t count = task->notifications;
+  task->notifications = clear_on_exit != pdFALSE ? 0 : count - 1;
+  return count;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+  if (length == 0 || item_size == 0) {
+    return nullptr;
+  }
+  auto* queue = new SimQueue;
+  queue->length = length;
+  queue->item_size = item_size;
+  return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+  delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait) {
+  std::unique_lock lock(queue->mutex);
+  const auto has_space = [queue] { return queue->items.size() < queue->length; };
+  if (ticks_to_wait == portMAX_DELAY) {
+    queue->not_full.wait(lock, has_space);
+  } else if (!queue->not_full.wait_for(lock, std::chrono::milliseconds(ticks_to_wait), has_space)) {
+    return errQUEUE_FULL;
+  }
+
+  const auto* bytes = static_cast<const uint8_t*>(item);
+  queue->items.emplace_back(bytes, bytes + queue->item_size);
+  queue->not_empty.notify_one();
+  return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* buffer, TickType_t ticks_to_wait) {
+  std::unique_lock lock(queue->mutex);
+  const auto has_item = [queue] { return !queue->items.empty(); };
+  if (ticks_to_wait == portMAX_DELAY) {
+    queue->not_empty.wait(lock, has_item);
+  } else if (!queue->not_empty.wait_for(lock, std::chrono::milliseconds(ticks_to_wait), has_item)) {
+    return pdFAIL;
+  }
+
+  std::memcpy(buffer, queue->items.front().data(), queue->item_size);
+  queue->items.pop_front();
+  queue->not_full.notify_one();
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  std::scoped_lock lock(queue->mutex);
+  return static_cast<UBaseType_t>(queue->items.size());
+}
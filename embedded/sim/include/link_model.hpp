@@ -0,0 +1,102 @@
+/**
+ * @file link_model.hpp
+ * @brief Bandwidth and latency model of one direction of the simulated SPP link
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace embedded::sim {
+
+/**
+ * @brief Characteristics of one direction of the simulated link.
+ * @details The defaults are an ideal link. Bluetooth Classic SPP to an ESP32 typically
+ * shows 10-30 ms one-way latency (sniff intervals, RFCOMM credits) and well under
+ * 100 KiB/s of useful throughput for small writes.
+ */
+struct LinkConfig {
+  uint32_t latency_us = 0;        ///< Fixed one-way latency in microseconds.
+  uint32_t jitter_us = 0;         ///< Extra latency drawn uniformly from [0, jitter_us] per packet.
+  uint32_t bytes_per_second = 0;  ///< Throughput limit; 0 means unlimited.
+  size_t mtu = 990;               ///< Largest packet delivered at once (the ESP32's default RFCOMM MTU).
+  uint32_t seed = 1;              ///< Seed of the jitter generator, for reproducible runs.
+};
+
+/**
+ * @brief A packet in flight.
+ */
+struct LinkPacket {
+  int64_t deliver_at_us = 0;  ///< Time the packet reaches the far end.
+  std::vector<uint8_t> data;  ///< Packet bytes.
+};
+
+/**
+ * @brief Delay line of one link direction: serializes packets at the configured rate and
+ * delivers them after the configured latency, in order.
+ * @details Like RFCOMM the link is reliable and ordered, so jitter never reorders packets:
+ * a packet is never delivered before the one sent ahead of it.
+ * @note Not thread-safe; the owner serializes access.
+ */
+class LinkModel final {
+public:
+  /**
+   * @brief Constructs an empty link.
+   * @param config Link characteristics
+   */
+  explicit LinkModel(const LinkConfig& config = {});
+
+  /**
+   * @brief Puts bytes on the link, split into packets of at most LinkConfig::mtu bytes.
+   * @param data Bytes sent
+   * @param now_us Send time in microseconds
+   * @return Delivery time of the last packet
+   */
+  int64_t Push(std::span<const uint8_t> data, int64_t now_us);
+
+  /**
+   * @brief Takes the oldest packet if it is due.
+   * @param now_us Current time in microseconds
+   * @return Packet, or std::nullopt if none is due
+   */
+  [[nodiscard]] std::optional<LinkPacket> PopDue(int64_t now_us);
+
+  /**
+   * @brief Gets the delivery time of the oldest packet in flight.
+   * @return Delivery time, or std::nullopt if the link is idle
+   */
+  [[nodiscard]] std::optional<int64_t> NextDelivery() const noexcept;
+
+  /**
+   * @brief Drops everything in flight (e.g. when the connection closes).
+   */
+  void Clear() noexcept;
+
+  /**
+   * @brief Gets the number of bytes in flight.
+   * @return Queued bytes
+   */
+  [[nodiscard]] size_t BytesInFlight() const noexcept { return bytes_in_flight_; }
+
+  /**
+   * @brief Gets the link characteristics.
+   * @return Configuration
+   */
+  [[nodiscard]] const LinkConfig& Config() const noexcept { return config_; }
+
+private:
+  LinkConfig config_;
+  std::deque<LinkPacket> in_flight_;
+  size_t bytes_in_flight_ = 0;
+  int64_t transmitter_free_at_us_ = 0;
+  int64_t last_delivery_us_ = 0;
+  std::minstd_rand jitter_;
+};
+
+}  // namespace embedded::sim
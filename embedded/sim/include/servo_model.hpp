@@ -0,0 +1,93 @@
+/**
+ * @file servo_model.hpp
+ * @brief Dynamics of a simulated hobby servo driven by MCPWM pulses
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+namespace embedded::sim {
+
+/**
+ * @brief Characteristics of a simulated servo.
+ * @details The defaults match the ServoConfig pulse range and a typical SG90-class servo
+ * (about 0.1 s per 60 degrees).
+ */
+struct ServoModelConfig {
+  float slew_deg_per_s = 600.0F;    ///< Fastest the horn turns.
+  uint32_t pwm_period_us = 20000;   ///< PWM period; a new pulse width takes effect at the next period.
+  uint32_t min_pulse_us = 500;      ///< Pulse width at -90 degrees.
+  uint32_t center_pulse_us = 1500;  ///< Pulse width at 0 degrees.
+  uint32_t max_pulse_us = 2500;     ///< Pulse width at +90 degrees.
+};
+
+/**
+ * @brief Simulated servo: follows the commanded pulse width at a limited slew rate.
+ * @details The MCPWM comparators update on timer-empty, so a new compare value only reaches the
+ * servo at the start of the next PWM period; from there the horn turns towards the commanded
+ * angle at ServoModelConfig::slew_deg_per_s. Positions are computed analytically from the
+ * command history, so no thread has to step the model.
+ * @note Thread-safe: the servo task commands while telemetry reads.
+ */
+class ServoModel final {
+public:
+  /**
+   * @brief Constructs a servo resting at 0 degrees.
+   * @param config Servo characteristics
+   */
+  explicit ServoModel(const ServoModelConfig& config = {}) noexcept : config_(config) {}
+
+  /**
+   * @brief Applies a new pulse width, as mcpwm_comparator_set_compare_value() does.
+   * @param pulse_us Pulse width in microseconds
+   * @param now_us Time the compare value is written
+   */
+  void SetPulse(uint32_t pulse_us, int64_t now_us) noexcept;
+
+  /**
+   * @brief Gets the horn angle.
+   * @param now_us Current time in microseconds (not before the last SetPulse())
+   * @return Angle in degrees
+   */
+  [[nodiscard]] float Position(int64_t now_us) const noexcept;
+
+  /**
+   * @brief Gets the angle of the most recent pulse width.
+   * @return Commanded angle in degrees
+   */
+  [[nodiscard]] float Commanded() const noexcept;
+
+  /**
+   * @brief Converts a pulse width to the angle it commands.
+   * @param pulse_us Pulse width in microseconds
+   * @return Angle in degrees
+   */
+  [[nodiscard]] float PulseToAngle(uint32_t pulse_us) const noexcept;
+
+  /**
+   * @brief Reconfigures the servo.
+   * @param config New characteristics
+   */
+  void SetConfig(const ServoModelConfig& config) noexcept;
+
+private:
+  /// Motion from a known position towards a target, starting at a PWM period boundary.
+  struct Segment {
+    int64_t start_us = 0;
+    float from = 0.0F;
+    float target = 0.0F;
+
+    [[nodiscard]] float At(int64_t now_us, float slew_deg_per_s) const noexcept;
+  };
+
+  [[nodiscard]] float PositionLocked(int64_t now_us) const noexcept;
+
+  mutable std::mutex mutex_;
+  ServoModelConfig config_;
+  Segment previous_;  ///< Motion until current_ takes effect.
+  Segment current_;   ///< Motion from the latest pulse width on.
+};
+
+}  // namespace embedded::sim
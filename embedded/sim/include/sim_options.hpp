@@ -0,0 +1,88 @@
+/**
+ * @file sim_options.hpp
+ * @brief Configuration shared by the simulator's ESP-IDF shims
+ */
+
+#pragma once
+
+#include "link_model.hpp"
+#include "servo_model.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace embedded::sim {
+
+/**
+ * @brief How the simulated SPP server is exposed to the client.
+ */
+enum class SppEndpointKind : uint8_t {
+  kTcp,  ///< TCP listening socket; a client connection is an SPP connection (client URI `tcp://host:port`).
+  kPty,  ///< Pseudo-terminal; always connected (client URI `serial:///dev/pts/N`).
+};
+
+/**
+ * @brief Gets a human-readable name of an endpoint kind.
+ * @param kind Endpoint kind
+ * @return Name of the endpoint kind
+ */
+[[nodiscard]] constexpr const char* SppEndpointKindToString(SppEndpointKind kind) noexcept {
+  switch (kind) {
+    case SppEndpointKind::kTcp:
+      return "tcp";
+    case SppEndpointKind::kPty:
+      return "pty";
+    default:
+      return "unknown";
+  }
+}
+
+/// Default TCP port of the simulated SPP server (the firmware's UDP control port).
+inline constexpr uint16_t kDefaultTcpPort = 3333;
+
+/// Number of simulated servos: comparator 0 drives pan, comparator 1 tilt.
+inline constexpr size_t kServoCount = 2;
+
+/**
+ * @brief How long the firmware's SPP callback held the simulated Bluetooth stack.
+ */
+struct SppCallbackStats {
+  uint32_t data_events = 0;  ///< DATA_IND events raised.
+  int64_t max_data_us = 0;   ///< Longest DATA_IND callback in microseconds.
+};
+
+/**
+ * @brief Simulator configuration, set from the command line before app_main() runs.
+ */
+struct SimOptions {
+  SppEndpointKind endpoint = SppEndpointKind::kTcp;  ///< Server endpoint kind.
+  std::string bind_address = "127.0.0.1";            ///< Address the TCP server listens on.
+  uint16_t port = kDefaultTcpPort;                   ///< TCP port; 0 picks a free one.
+  LinkConfig to_device;                              ///< Client to firmware direction.
+  LinkConfig to_client;                              ///< Firmware to client direction.
+  ServoModelConfig servo;                            ///< Characteristics of both servos.
+  uint32_t telemetry_ms = 0;                         ///< Servo telemetry period on stdout; 0 disables it.
+};
+
+/**
+ * @brief Gets the simulator configuration.
+ * @return Mutable options (only modified before app_main() starts)
+ */
+[[nodiscard]] SimOptions& Options() noexcept;
+
+/**
+ * @brief Gets a simulated servo.
+ * @param index Servo index (0 pan, 1 tilt), less than kServoCount
+ * @return Servo model
+ */
+[[nodiscard]] ServoModel& Servo(size_t index) noexcept;
+
+/**
+ * @brief Gets how long the firmware's SPP callback has taken; on the ESP32 this is time the whole
+ * Bluetooth stack waits.
+ * @return Callback statistics since start
+ */
+[[nodiscard]] SppCallbackStats SppStats() noexcept;
+
+}  // namespace embedded::sim
@@ -0,0 +1,69 @@
+/**
+ * @file link_model.cpp
+ * @brief Bandwidth and latency model of one direction of the simulated SPP link
+ */
+
+#include "link_model.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace embedded::sim {
+
+LinkModel::LinkModel(const LinkConfig& config) : config_(config), jitter_(config.seed) {
+  config_.mtu = std::max<size_t>(config_.mtu, 1);
+}
+
+int64_t LinkModel::Push(std::span<const uint8_t> data, int64_t now_us) {
+  while (!data.empty()) {
+    const auto packet = data.first(std::min(data.size(), config_.mtu));
+    data = data.subspan(packet.size());
+
+    // The transmitter sends one packet at a time at the configured rate
+    int64_t sent_at = std::max(now_us, transmitter_free_at_us_);
+    if (config_.bytes_per_second > 0) {
+      sent_at += static_cast<int64_t>(packet.size() * 1'000'000ULL / config_.bytes_per_second);
+    }
+    transmitter_free_at_us_ = sent_at;
+
+    int64_t deliver_at = sent_at + config_.latency_us;
+    if (config_.jitter_us > 0) {
+      deliver_at += static_cast<int64_t>(jitter_() % (config_.jitter_us + 1ULL));
+    }
+    deliver_at = std::max(deliver_at, last_delivery_us_);
+    last_delivery_us_ = deliver_at;
+
+    in_flight_.push_back({deliver_at, std::vector<uint8_t>(packet.begin(), packet.end())});
+    bytes_in_flight_ += packet.size();
+  }
+  return last_delivery_us_;
+}
+
+std::optional<LinkPacket> LinkModel::PopDue(int64_t now_us) {
+  if (in_flight_.empty() || in_flight_.front().deliver_at_us > now_us) {
+    return std::nullopt;
+  }
+
+  LinkPacket packet = std::move(in_flight_.front());
+  in_flight_.pop_front();
+  bytes_in_flight_ -= packet.data.size();
+  return packet;
+}
+
+std::optional<int64_t> LinkModel::NextDelivery() const noexcept {
+  if (in_flight_.empty()) {
+    return std::nullopt;
+  }
+  return in_flight_.front().deliver_at_us;
+}
+
+void LinkModel::Clear() noexcept {
+  in_flight_.clear();
+  bytes_in_flight_ = 0;
+}
+
+}  // namespace embedded::sim
@@ -0,0 +1,146 @@
+/**
+ * @file mcpwm_shim.cpp
+ * @brief Host MCPWM driver: comparator writes drive the simulated servos
+ */
+
+#include "sim_options.hpp"
+
+#include <driver/mcpwm_prelude.h>
+#include <esp_err.h>
+#include <esp_timer.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+struct SimMcpwmTimer {
+  uint32_t period_ticks = 0;
+  bool enabled = false;
+};
+
+struct SimMcpwmOperator {
+  SimMcpwmTimer* timer = nullptr;
+};
+
+struct SimMcpwmComparator {
+  size_t servo = 0;
+};
+
+struct SimMcpwmGenerator {
+  int gpio = -1;
+};
+
+namespace {
+
+/// One MCPWM group: three timers, operators, and per-operator comparators and generators.
+constexpr size_t kTimersPerGroup = 3;
+
+std::array<SimMcpwmTimer, kTimersPerGroup> g_timers;
+std::array<SimMcpwmOperator, kTimersPerGroup> g_operators;
+std::array<SimMcpwmComparator, embedded::sim::kServoCount> g_comparators;
+std::array<SimMcpwmGenerator, kTimersPerGroup> g_generators;
+std::atomic<size_t> g_timer_count{0};
+std::atomic<size_t> g_operator_count{0};
+std::atomic<size_t> g_comparator_count{0};
+std::atomic<size_t> g_generator_count{0};
+
+/// Hands out the next free slot of @p pool, or nullptr once it is exhausted.
+template <typename T, size_t N>
+[[nodiscard]] T* Allocate(std::array<T, N>& pool, std::atomic<size_t>& count) noexcept {
+  const size_t index = count.fetch_add(1, std::memory_order_relaxed);
+  return index < N ? &pool[index] : nullptr;
+}
+
+}  // namespace
+
+esp_err_t mcpwm_new_timer(const mcpwm_timer_config_t* config, mcpwm_timer_handle_t* ret_timer) {
+  if (config == nullptr || ret_timer == nullptr || config->period_ticks == 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  *ret_timer = Allocate(g_timers, g_timer_count);
+  if (*ret_timer == nullptr) {
+    return ESP_ERR_NOT_FOUND;
+  }
+  (*ret_timer)->period_ticks = config->period_ticks;
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_timer_enable(mcpwm_timer_handle_t timer) {
+  if (timer == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (timer->enabled) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  timer->enabled = true;
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_timer_start_stop(mcpwm_timer_handle_t timer, mcpwm_timer_start_stop_cmd_t /*command*/) {
+  if (timer == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  return timer->enabled ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t mcpwm_new_operator(const mcpwm_operator_config_t* config, mcpwm_oper_handle_t* ret_oper) {
+  if (config == nullptr || ret_oper == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  *ret_oper = Allocate(g_operators, g_operator_count);
+  return *ret_oper != nullptr ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t mcpwm_operator_connect_timer(mcpwm_oper_handle_t oper, mcpwm_timer_handle_t timer) {
+  if (oper == nullptr || timer == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  oper->timer = timer;
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_new_comparator(mcpwm_oper_handle_t oper, const mcpwm_comparator_config_t* config,
+                               mcpwm_cmpr_handle_t* ret_cmpr) {
+  if (oper == nullptr || config == nullptr || ret_cmpr == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  *ret_cmpr = Allocate(g_comparators, g_comparator_count);
+  if (*ret_cmpr == nullptr) {
+    return ESP_ERR_NOT_FOUND;
+  }
+  (*ret_cmpr)->servo = static_cast<size_t>(*ret_cmpr - g_comparators.data());
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_comparator_set_compare_value(mcpwm_cmpr_handle_t comparator, uint32_t compare_ticks) {
+  if (comparator == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  // The timers tick at 1 MHz, so a compare value is the pulse width in microseconds
+  embedded::sim::Servo(comparator->servo).SetPulse(compare_ticks, esp_timer_get_time());
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_new_generator(mcpwm_oper_handle_t oper, const mcpwm_generator_config_t* config,
+                              mcpwm_gen_handle_t* ret_gen) {
+  if (oper == nullptr || config == nullptr || ret_gen == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  *ret_gen = Allocate(g_generators, g_generator_count);
+  if (*ret_gen == nullptr) {
+    return ESP_ERR_NOT_FOUND;
+  }
+  (*ret_gen)->gpio = config->gen_gpio_num;
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_generator_set_action_on_timer_event(mcpwm_gen_handle_t generator,
+                                                    mcpwm_gen_timer_event_action_t /*event_action*/) {
+  return generator != nullptr ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t mcpwm_generator_set_action_on_compare_event(mcpwm_gen_handle_t generator,
+                                                      mcpwm_gen_compare_event_action_t event_action) {
+  return generator != nullptr && event_action.comparator != nullptr ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
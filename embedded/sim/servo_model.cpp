@@ -0,0 +1,78 @@
+/**
+ * @file servo_model.cpp
+ * @brief Dynamics of a simulated hobby servo driven by MCPWM pulses
+ */
+
+#include "servo_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+namespace embedded::sim {
+
+float ServoModel::Segment::At(int64_t now_us, float slew_deg_per_s) const noexcept {
+  if (now_us <= start_us) {
+    return from;
+  }
+
+  const float travel = slew_deg_per_s * static_cast<float>(now_us - start_us) / 1'000'000.0F;
+  const float remaining = target - from;
+  if (std::abs(remaining) <= travel) {
+    return target;
+  }
+  return from + std::copysign(travel, remaining);
+}
+
+void ServoModel::SetPulse(uint32_t pulse_us, int64_t now_us) noexcept {
+  std::scoped_lock lock(mutex_);
+  const float target = PulseToAngle(pulse_us);
+
+  // A compare value written before the period boundary only replaces the pending one
+  if (now_us < current_.start_us) {
+    current_.target = target;
+    return;
+  }
+
+  const int64_t period = std::max<int64_t>(config_.pwm_period_us, 1);
+  const int64_t boundary = (now_us / period + 1) * period;
+  previous_ = current_;
+  current_.start_us = boundary;
+  current_.from = previous_.At(boundary, config_.slew_deg_per_s);
+  current_.target = target;
+}
+
+float ServoModel::Position(int64_t now_us) const noexcept {
+  std::scoped_lock lock(mutex_);
+  return PositionLocked(now_us);
+}
+
+float ServoModel::Commanded() const noexcept {
+  std::scoped_lock lock(mutex_);
+  return current_.target;
+}
+
+float ServoModel::PulseToAngle(uint32_t pulse_us) const noexcept {
+  // Inverse of ServoController::AngleToPulseWidth()
+  const auto pulse = static_cast<float>(pulse_us);
+  const auto center = static_cast<float>(config_.center_pulse_us);
+  if (pulse < center) {
+    return (pulse - center) / (center - static_cast<float>(config_.min_pulse_us)) * 90.0F;
+  }
+  return (pulse - center) / (static_cast<float>(config_.max_pulse_us) - center) * 90.0F;
+}
+
+void ServoModel::SetConfig(const ServoModelConfig& config) noexcept {
+  std::scoped_lock lock(mutex_);
+  config_ = config;
+}
+
+float ServoModel::PositionLocked(int64_t now_us) const noexcept {
+  if (now_us < current_.start_us) {
+    return previous_.At(now_us, config_.slew_deg_per_s);
+  }
+  return current_.At(now_us, config_.slew_deg_per_s);
+}
+
+}  // namespace embedded::sim
@@ -0,0 +1,80 @@
+/**
+ * @file mcpwm_prelude.h
+ * @brief Host shim of the ESP-IDF MCPWM driver
+ *
+ * Comparators are the servo outputs: the n-th comparator created drives the n-th simulated
+ * servo (ServoController creates pan first, then tilt), and writing a compare value sets
+ * that servo's pulse width. Everything else only validates its arguments.
+ */
+
+#pragma once
+
+#include <esp_err.h>
+
+#include <cstdint>
+
+using mcpwm_timer_handle_t = struct SimMcpwmTimer*;
+using mcpwm_oper_handle_t = struct SimMcpwmOperator*;
+using mcpwm_cmpr_handle_t = struct SimMcpwmComparator*;
+using mcpwm_gen_handle_t = struct SimMcpwmGenerator*;
+
+typedef enum { MCPWM_TIMER_CLK_SRC_DEFAULT } mcpwm_timer_clock_source_t;
+typedef enum { MCPWM_TIMER_COUNT_MODE_PAUSE, MCPWM_TIMER_COUNT_MODE_UP } mcpwm_timer_count_mode_t;
+typedef enum { MCPWM_TIMER_DIRECTION_UP, MCPWM_TIMER_DIRECTION_DOWN } mcpwm_timer_direction_t;
+typedef enum { MCPWM_TIMER_EVENT_EMPTY, MCPWM_TIMER_EVENT_FULL } mcpwm_timer_event_t;
+typedef enum { MCPWM_GEN_ACTION_KEEP, MCPWM_GEN_ACTION_LOW, MCPWM_GEN_ACTION_HIGH } mcpwm_generator_action_t;
+typedef enum { MCPWM_TIMER_START_NO_STOP, MCPWM_TIMER_STOP_EMPTY } mcpwm_timer_start_stop_cmd_t;
+
+typedef struct {
+  int group_id;
+  mcpwm_timer_clock_source_t clk_src;
+  uint32_t resolution_hz;
+  mcpwm_timer_count_mode_t count_mode;
+  uint32_t period_ticks;
+} mcpwm_timer_config_t;
+
+typedef struct {
+  int group_id;
+} mcpwm_operator_config_t;
+
+typedef struct {
+  struct {
+    uint32_t update_cmp_on_tez : 1;
+  } flags;
+} mcpwm_comparator_config_t;
+
+typedef struct {
+  int gen_gpio_num;
+} mcpwm_generator_config_t;
+
+typedef struct {
+  mcpwm_timer_direction_t direction;
+  mcpwm_timer_event_t event;
+  mcpwm_generator_action_t action;
+} mcpwm_gen_timer_event_action_t;
+
+typedef struct {
+  mcpwm_timer_direction_t direction;
+  mcpwm_cmpr_handle_t comparator;
+  mcpwm_generator_action_t action;
+} mcpwm_gen_compare_event_action_t;
+
+#define MCPWM_GEN_TIMER_EVENT_ACTION(dir, ev, act) \
+  mcpwm_gen_timer_event_action_t { .direction = dir, .event = ev, .action = act }
+#define MCPWM_GEN_COMPARE_EVENT_ACTION(dir, cmp, act) \
+  mcpwm_gen_compare_event_action_t { .direction = dir, .comparator = cmp, .action = act }
+
+esp_err_t mcpwm_new_timer(const mcpwm_timer_config_t* config, mcpwm_timer_handle_t* ret_timer);
+esp_err_t mcpwm_timer_enable(mcpwm_timer_handle_t timer);
+esp_err_t mcpwm_timer_start_stop(mcpwm_timer_handle_t timer, mcpwm_timer_start_stop_cmd_t command);
+esp_err_t mcpwm_new_operator(const mcpwm_operator_config_t* config, mcpwm_oper_handle_t* ret_oper);
+esp_err_t mcpwm_operator_connect_timer(mcpwm_oper_handle_t oper, mcpwm_timer_handle_t timer);
+esp_err_t mcpwm_new_comparator(mcpwm_oper_handle_t oper, const mcpwm_comparator_config_t* config,
+                               mcpwm_cmpr_handle_t* ret_cmpr);
+esp_err_t mcpwm_comparator_set_compare_value(mcpwm_cmpr_handle_t comparator, uint32_t compare_ticks);
+esp_err_t mcpwm_new_generator(mcpwm_oper_handle_t oper, const mcpwm_generator_config_t* config,
+                              mcpwm_gen_handle_t* ret_gen);
+esp_err_t mcpwm_generator_set_action_on_timer_event(mcpwm_gen_handle_t generator,
+                                                    mcpwm_gen_timer_event_action_t event_action);
+esp_err_t mcpwm_generator_set_action_on_compare_event(mcpwm_gen_handle_t generator,
+                                                      mcpwm_gen_compare_event_action_t event_action);
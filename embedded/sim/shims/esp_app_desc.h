@@ -0,0 +1,20 @@
+/**
+ * @file esp_app_desc.h
+ * @brief Host shim of the ESP-IDF application description
+ */
+
+#pragma once
+
+/**
+ * @brief Application description (the fields the firmware reads).
+ */
+typedef struct {
+  char version[32];       ///< Application version.
+  char project_name[32];  ///< Project name.
+} esp_app_desc_t;
+
+/**
+ * @brief Gets the application description.
+ * @return Description of the simulated firmware
+ */
+const esp_app_desc_t* esp_app_get_description();
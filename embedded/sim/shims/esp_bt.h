@@ -0,0 +1,28 @@
+/**
+ * @file esp_bt.h
+ * @brief Host shim of the ESP-IDF Bluetooth controller API (no radio: every call succeeds)
+ */
+
+#pragma once
+
+#include <esp_err.h>
+
+typedef enum {
+  ESP_BT_MODE_IDLE,
+  ESP_BT_MODE_BLE,
+  ESP_BT_MODE_CLASSIC_BT,
+  ESP_BT_MODE_BTDM,
+} esp_bt_mode_t;
+
+typedef struct {
+  esp_bt_mode_t mode;
+} esp_bt_controller_config_t;
+
+#define BT_CONTROLLER_INIT_CONFIG_DEFAULT() \
+  esp_bt_controller_config_t { .mode = ESP_BT_MODE_CLASSIC_BT }
+
+esp_err_t esp_bt_controller_mem_release(esp_bt_mode_t mode);
+esp_err_t esp_bt_controller_init(esp_bt_controller_config_t* config);
+esp_err_t esp_bt_controller_deinit();
+esp_err_t esp_bt_controller_enable(esp_bt_mode_t mode);
+esp_err_t esp_bt_controller_disable();
@@ -0,0 +1,15 @@
+/**
+ * @file esp_bt_device.h
+ * @brief Host shim of the Bluetooth device settings
+ */
+
+#pragma once
+
+#include <esp_err.h>
+
+/**
+ * @brief Sets the device name; the simulator only logs it.
+ * @param name Device name
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG if @p name is null
+ */
+esp_err_t esp_bt_dev_set_device_name(const char* name);
@@ -0,0 +1,13 @@
+/**
+ * @file esp_bt_main.h
+ * @brief Host shim of the Bluedroid host stack lifecycle (every call succeeds)
+ */
+
+#pragma once
+
+#include <esp_err.h>
+
+esp_err_t esp_bluedroid_init();
+esp_err_t esp_bluedroid_deinit();
+esp_err_t esp_bluedroid_enable();
+esp_err_t esp_bluedroid_disable();
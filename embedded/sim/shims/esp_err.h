@@ -0,0 +1,37 @@
+/**
+ * @file esp_err.h
+ * @brief Host shim of the ESP-IDF error codes used by the firmware
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+using esp_err_t = int;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_TIMEOUT 0x107
+
+/**
+ * @brief Gets the name of an error code.
+ * @param code Error code
+ * @return Static name string
+ */
+const char* esp_err_to_name(esp_err_t code);
+
+#define ESP_ERROR_CHECK(x)                                                                        \
+  do {                                                                                            \
+    const esp_err_t err_rc_ = (x);                                                                \
+    if (err_rc_ != ESP_OK) {                                                                      \
+      std::fprintf(stderr, "ESP_ERROR_CHECK failed: %s at %s:%d\n", esp_err_to_name(err_rc_),   \
+                   __FILE__, __LINE__);                                                           \
+      std::abort();                                                                               \
+    }                                                                                             \
+  } while (0)
@@ -0,0 +1,75 @@
+/**
+ * @file esp_gap_bt_api.h
+ * @brief Host shim of the Bluetooth Classic GAP API
+ *
+ * The simulated link needs no pairing, so the simulator never raises GAP events; the
+ * types exist for the firmware's GAP handler to compile.
+ */
+
+#pragma once
+
+#include <esp_err.h>
+
+#include <cstdint>
+
+using esp_bd_addr_t = uint8_t[6];
+using esp_bt_pin_code_t = uint8_t[16];
+
+typedef enum {
+  ESP_BT_STATUS_SUCCESS = 0,
+  ESP_BT_STATUS_FAIL,
+} esp_bt_status_t;
+
+typedef enum {
+  ESP_BT_NON_CONNECTABLE,
+  ESP_BT_CONNECTABLE,
+} esp_bt_connection_mode_t;
+
+typedef enum {
+  ESP_BT_NON_DISCOVERABLE,
+  ESP_BT_LIMITED_DISCOVERABLE,
+  ESP_BT_GENERAL_DISCOVERABLE,
+} esp_bt_discovery_mode_t;
+
+typedef enum {
+  ESP_BT_GAP_AUTH_CMPL_EVT = 4,
+  ESP_BT_GAP_PIN_REQ_EVT,
+  ESP_BT_GAP_CFM_REQ_EVT,
+  ESP_BT_GAP_KEY_NOTIF_EVT,
+  ESP_BT_GAP_KEY_REQ_EVT,
+  ESP_BT_GAP_MODE_CHG_EVT = 13,
+} esp_bt_gap_cb_event_t;
+
+typedef union {
+  struct {
+    esp_bd_addr_t bda;
+    esp_bt_status_t stat;
+    uint8_t device_name[249];
+  } auth_cmpl;
+  struct {
+    esp_bd_addr_t bda;
+    bool min_16_digit;
+  } pin_req;
+  struct {
+    esp_bd_addr_t bda;
+    uint32_t num_val;
+  } cfm_req;
+  struct {
+    esp_bd_addr_t bda;
+    uint32_t passkey;
+  } key_notif;
+  struct {
+    esp_bd_addr_t bda;
+  } key_req;
+  struct {
+    esp_bd_addr_t bda;
+    int mode;
+  } mode_chg;
+} esp_bt_gap_cb_param_t;
+
+using esp_bt_gap_cb_t = void (*)(esp_bt_gap_cb_event_t event, esp_bt_gap_cb_param_t* param);
+
+esp_err_t esp_bt_gap_register_callback(esp_bt_gap_cb_t callback);
+esp_err_t esp_bt_gap_set_scan_mode(esp_bt_connection_mode_t c_mode, esp_bt_discovery_mode_t d_mode);
+esp_err_t esp_bt_gap_pin_reply(esp_bd_addr_t bd_addr, bool accept, uint8_t pin_code_len, esp_bt_pin_code_t pin_code);
+esp_err_t esp_bt_gap_ssp_confirm_reply(esp_bd_addr_t bd_addr, bool accept);
@@ -0,0 +1,41 @@
+/**
+ * @file esp_log.h
+ * @brief Host shim of the ESP-IDF logging macros: writes to stderr, filtered by level
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Log verbosity, as in ESP-IDF.
+ */
+typedef enum {
+  ESP_LOG_NONE,
+  ESP_LOG_ERROR,
+  ESP_LOG_WARN,
+  ESP_LOG_INFO,
+  ESP_LOG_DEBUG,
+  ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+/**
+ * @brief Sets the most verbose level printed (the tag is ignored: one level for all).
+ * @param tag Log tag ("*" for all)
+ * @param level Level
+ */
+void esp_log_level_set(const char* tag, esp_log_level_t level);
+
+/**
+ * @brief Prints one log line if @p level is enabled.
+ * @param level Message level
+ * @param tag Log tag
+ * @param format printf format
+ */
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...);
+
+#define ESP_LOGE(tag, format, ...) esp_log_write(ESP_LOG_ERROR, tag, format __VA_OPT__(, ) __VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) esp_log_write(ESP_LOG_WARN, tag, format __VA_OPT__(, ) __VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) esp_log_write(ESP_LOG_INFO, tag, format __VA_OPT__(, ) __VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) esp_log_write(ESP_LOG_DEBUG, tag, format __VA_OPT__(, ) __VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) esp_log_write(ESP_LOG_VERBOSE, tag, format __VA_OPT__(, ) __VA_ARGS__)
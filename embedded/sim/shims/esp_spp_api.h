@@ -0,0 +1,148 @@
+/**
+ * @file esp_spp_api.h
+ * @brief Host shim of the Bluetooth SPP API, backed by the simulator's SPP stack
+ *
+ * The server side of the "RFCOMM channel" is a TCP socket or a pty (see sim_options.hpp), and
+ * bytes cross it through the simulated link. Callbacks run on the stack's own thread, as they
+ * run on the BTC task on the ESP32.
+ */
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_gap_bt_api.h>
+
+#include <cstdint>
+
+typedef enum {
+  ESP_SPP_SUCCESS = 0,
+  ESP_SPP_FAILURE,
+  ESP_SPP_BUSY,
+  ESP_SPP_NO_DATA,
+  ESP_SPP_NO_RESOURCE,
+  ESP_SPP_NEED_INIT,
+  ESP_SPP_NEED_DEINIT,
+  ESP_SPP_NO_CONNECTION,
+  ESP_SPP_NO_SERVER,
+} esp_spp_status_t;
+
+typedef enum {
+  ESP_SPP_ROLE_MASTER = 0,
+  ESP_SPP_ROLE_SLAVE = 1,
+} esp_spp_role_t;
+
+typedef enum {
+  ESP_SPP_MODE_CB = 0,
+  ESP_SPP_MODE_VFS = 1,
+} esp_spp_mode_t;
+
+using esp_spp_sec_t = uint16_t;
+#define ESP_SPP_SEC_NONE 0x0000
+
+typedef struct {
+  esp_spp_mode_t mode;
+  bool enable_l2cap_ertm;
+  uint16_t tx_buffer_size;
+} esp_spp_cfg_t;
+
+typedef enum {
+  ESP_SPP_INIT_EVT = 0,
+  ESP_SPP_UNINIT_EVT = 1,
+  ESP_SPP_DISCOVERY_COMP_EVT = 8,
+  ESP_SPP_OPEN_EVT = 26,
+  ESP_SPP_CLOSE_EVT = 27,
+  ESP_SPP_START_EVT = 28,
+  ESP_SPP_CL_INIT_EVT = 29,
+  ESP_SPP_DATA_IND_EVT = 30,
+  ESP_SPP_CONG_EVT = 31,
+  ESP_SPP_WRITE_EVT = 33,
+  ESP_SPP_SRV_OPEN_EVT = 34,
+  ESP_SPP_SRV_STOP_EVT = 35,
+} esp_spp_cb_event_t;
+
+typedef union {
+  struct {
+    esp_spp_status_t status;
+  } init;
+  struct {
+    esp_spp_status_t status;
+  } uninit;
+  struct {
+    esp_spp_status_t status;
+    uint32_t handle;
+    uint8_t sec_id;
+    uint8_t scn;
+    bool use_co;
+  } start;
+  struct {
+    esp_spp_status_t status;
+    uint32_t handle;
+    uint32_t new_listen_handle;
+    esp_bd_addr_t rem_bda;
+  } srv_open;
+  struct {
+    esp_spp_status_t status;
+    uint32_t port_status;
+    uint32_t handle;
+    bool async;
+  } close;
+  struct {
+    esp_spp_status_t status;
+    uint32_t handle;
+    uint16_t len;
+    uint8_t* data;
+  } data_ind;
+  struct {
+    esp_spp_status_t status;
+    uint32_t handle;
+    int len;
+    bool cong;
+  } write;
+  struct {
+    esp_spp_status_t status;
+    uint32_t handle;
+    bool cong;
+  } cong;
+} esp_spp_cb_param_t;
+
+using esp_spp_cb_t = void (*)(esp_spp_cb_event_t event, esp_spp_cb_param_t* param);
+
+/**
+ * @brief Registers the callback that receives every SPP event.
+ * @param callback Event callback
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG if @p callback is null
+ */
+esp_err_t esp_spp_register_callback(esp_spp_cb_t callback);
+
+/**
+ * @brief Starts the SPP stack thread; ESP_SPP_INIT_EVT follows.
+ * @param config SPP configuration (only callback mode is supported)
+ * @return ESP_OK, or an error if the stack is already running or the mode is unsupported
+ */
+esp_err_t esp_spp_enhanced_init(const esp_spp_cfg_t* config);
+
+/**
+ * @brief Stops the SPP stack, closing any connection.
+ * @return ESP_OK
+ */
+esp_err_t esp_spp_deinit();
+
+/**
+ * @brief Opens the simulated server endpoint; ESP_SPP_START_EVT follows, then ESP_SPP_SRV_OPEN_EVT
+ * for each client.
+ * @param sec_mask Security mask (ignored)
+ * @param role Role (ignored)
+ * @param local_scn Server channel (ignored: the endpoint comes from the simulator options)
+ * @param name Server name
+ * @return ESP_OK, or ESP_ERR_INVALID_STATE unless called from an SPP event callback of a running stack
+ */
+esp_err_t esp_spp_start_srv(esp_spp_sec_t sec_mask, esp_spp_role_t role, uint8_t local_scn, const char* name);
+
+/**
+ * @brief Queues bytes to the client on the simulated link; ESP_SPP_WRITE_EVT follows once sent.
+ * @param handle Connection handle from ESP_SPP_SRV_OPEN_EVT
+ * @param len Number of bytes
+ * @param data Bytes to send (copied)
+ * @return ESP_OK, or ESP_FAIL if @p handle is not the open connection
+ */
+esp_err_t esp_spp_write(uint32_t handle, int len, uint8_t* data);
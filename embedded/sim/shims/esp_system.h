@@ -0,0 +1,21 @@
+/**
+ * @file esp_system.h
+ * @brief Host shim of the ESP-IDF system functions used by the firmware
+ */
+
+#pragma once
+
+#include <esp_err.h>
+
+#include <cstdint>
+
+/**
+ * @brief Gets the free heap size (a fixed figure typical of the firmware on an ESP32).
+ * @return Free heap in bytes
+ */
+uint32_t esp_get_free_heap_size();
+
+/**
+ * @brief Restarts the chip: exits the simulator.
+ */
+[[noreturn]] void esp_restart();
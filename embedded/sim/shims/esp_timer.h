@@ -0,0 +1,71 @@
+/**
+ * @file esp_timer.h
+ * @brief Host shim of the ESP-IDF high-resolution timer
+ *
+ * Periodic timers run their callback on a thread of their own, at absolute deadlines on the host
+ * clock, as the esp_timer task does with ESP_TIMER_TASK dispatch.
+ */
+
+#pragma once
+
+#include <esp_err.h>
+
+#include <cstdint>
+
+using esp_timer_handle_t = struct SimTimer*;
+using esp_timer_cb_t = void (*)(void* arg);
+
+/**
+ * @brief How the callback is dispatched (always from the timer's thread on the host).
+ */
+enum esp_timer_dispatch_t {
+  ESP_TIMER_TASK,
+  ESP_TIMER_ISR,
+};
+
+/**
+ * @brief Timer configuration.
+ */
+struct esp_timer_create_args_t {
+  esp_timer_cb_t callback = nullptr;                      ///< Called on expiry.
+  void* arg = nullptr;                                    ///< Passed to the callback.
+  esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK;  ///< Ignored.
+  const char* name = nullptr;                             ///< Timer name (becomes the thread name).
+  bool skip_unhandled_events = false;                     ///< Skip expiries missed while the host was busy.
+};
+
+/**
+ * @brief Gets the time since the simulator started.
+ * @return Microseconds since boot
+ */
+int64_t esp_timer_get_time();
+
+/**
+ * @brief Creates a stopped timer.
+ * @param args Configuration
+ * @param handle Set to the new timer
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG without a callback
+ */
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle);
+
+/**
+ * @brief Starts calling the callback every period.
+ * @param timer Stopped timer
+ * @param period_us Period in microseconds
+ * @return ESP_OK, or ESP_ERR_INVALID_STATE if the timer is running
+ */
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us);
+
+/**
+ * @brief Stops a timer, waiting for a callback in progress.
+ * @param timer Running timer
+ * @return ESP_OK, or ESP_ERR_INVALID_STATE if the timer is not running
+ */
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+
+/**
+ * @brief Deletes a stopped timer.
+ * @param timer Timer to delete
+ * @return ESP_OK, or ESP_ERR_INVALID_STATE if the timer is running
+ */
+esp_err_t esp_timer_delete(esp_timer_handle_t timer);
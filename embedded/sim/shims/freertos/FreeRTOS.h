@@ -0,0 +1,20 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Host shim of the FreeRTOS base types (1 tick = 1 ms, as CONFIG_FREERTOS_HZ=1000)
+ */
+
+#pragma once
+
+#include <cstdint>
+
+using TickType_t = uint32_t;
+using BaseType_t = int;
+using UBaseType_t = unsigned int;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define portMAX_DELAY UINT32_MAX
+#define portTICK_PERIOD_MS 1U
+#define pdMS_TO_TICKS(ms) static_cast<TickType_t>(ms)
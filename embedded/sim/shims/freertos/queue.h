@@ -0,0 +1,52 @@
+/**
+ * @file queue.h
+ * @brief Host shim of FreeRTOS queues: fixed-size items copied in and out under a mutex
+ */
+
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+
+using QueueHandle_t = struct SimQueue*;
+
+/**
+ * @brief Creates a queue.
+ * @param length Maximum number of items
+ * @param item_size Size of one item in bytes
+ * @return Queue handle, or nullptr on failure
+ */
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+
+/**
+ * @brief Deletes a queue.
+ * @param queue Queue to delete
+ */
+void vQueueDelete(QueueHandle_t queue);
+
+/**
+ * @brief Copies an item to the back of a queue, waiting for space.
+ * @param queue Queue
+ * @param item Item to copy (item_size bytes)
+ * @param ticks_to_wait Longest wait in ticks (milliseconds)
+ * @return pdPASS, or errQUEUE_FULL if no space freed up in time
+ */
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait);
+
+/**
+ * @brief Copies the item at the front of a queue out, waiting for one.
+ * @param queue Queue
+ * @param buffer Destination (item_size bytes)
+ * @param ticks_to_wait Longest wait in ticks (milliseconds)
+ * @return pdPASS, or pdFAIL if nothing arrived in time
+ */
+BaseType_t xQueueReceive(QueueHandle_t queue, void* buffer, TickType_t ticks_to_wait);
+
+/**
+ * @brief Gets the number of items in a queue.
+ * @param queue Queue
+ * @return Item count
+ */
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+#define errQUEUE_FULL 0
+#define xQueueSendToBack xQueueSend
@@ -0,0 +1,80 @@
+/**
+ * @file task.h
+ * @brief Host shim of FreeRTOS tasks: each task is a detached std::thread
+ *
+ * Priorities, core affinities and stack depths are accepted but not modelled; the host scheduler decides. Each task
+ * has its own notification count, as the firmware uses direct-to-task notifications as a semaphore.
+ */
+
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+
+using TaskFunction_t = void (*)(void*);
+using TaskHandle_t = struct SimTask*;
+
+/**
+ * @brief Starts a task on its own thread.
+ * @param function Task function
+ * @param name Task name (becomes the thread name)
+ * @param stack_depth Ignored
+ * @param param Argument passed to @p function
+ * @param priority Ignored
+ * @param handle Set to the task's handle if not null
+ * @return pdPASS
+ */
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack_depth, void* param,
+                       UBaseType_t priority, TaskHandle_t* handle);
+
+/**
+ * @brief Starts a task on its own thread; the host scheduler ignores the core.
+ * @param function Task function
+ * @param name Task name (becomes the thread name)
+ * @param stack_depth Ignored
+ * @param param Argument passed to @p function
+ * @param priority Ignored
+ * @param handle Set to the task's handle if not null
+ * @param core_id Ignored
+ * @return pdPASS
+ */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stack_depth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core_id);
+
+/**
+ * @brief Deletes a task; only deleting the calling task (nullptr) is supported, which ends its thread.
+ * @param task Task to delete
+ */
+void vTaskDelete(TaskHandle_t task);
+
+/**
+ * @brief Blocks the calling task.
+ * @param ticks Delay in ticks (milliseconds)
+ */
+void vTaskDelay(TickType_t ticks);
+
+/**
+ * @brief Gets the time since the simulator started.
+ * @return Ticks (milliseconds) since boot
+ */
+TickType_t xTaskGetTickCount();
+
+/**
+ * @brief Gets the calling task (a thread not started by xTaskCreate() gets a handle on first use).
+ * @return Handle of the calling task
+ */
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+/**
+ * @brief Increments a task's notification count, waking it if it waits in ulTaskNotifyTake().
+ * @param task Task to notify
+ * @return pdPASS
+ */
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+
+/**
+ * @brief Waits for the calling task's notification count to be non-zero, then takes it.
+ * @param clear_on_exit pdTRUE to clear the count, pdFALSE to decrement it
+ * @param ticks_to_wait Longest wait in ticks (milliseconds), or portMAX_DELAY
+ * @return The count before it was cleared or decremented, 0 on timeout
+ */
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait);
@@ -0,0 +1,23 @@
+/**
+ * @file nvs_flash.h
+ * @brief Host shim of the ESP-IDF NVS flash initialization (the simulator has no flash)
+ */
+
+#pragma once
+
+#include <esp_err.h>
+
+#define ESP_ERR_NVS_NO_FREE_PAGES 0x110d
+#define ESP_ERR_NVS_NEW_VERSION_FOUND 0x1110
+
+/**
+ * @brief Initializes NVS; always succeeds.
+ * @return ESP_OK
+ */
+esp_err_t nvs_flash_init();
+
+/**
+ * @brief Erases NVS; always succeeds.
+ * @return ESP_OK
+ */
+esp_err_t nvs_flash_erase();
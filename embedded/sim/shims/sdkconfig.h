@@ -0,0 +1,13 @@
+/**
+ * @file sdkconfig.h
+ * @brief Host shim of the generated project configuration
+ *
+ * The simulator serves the client over the simulated SPP link only, so
+ * CONFIG_FACE_TRACKER_WIFI is left undefined as in the default menuconfig.
+ * Other options take their menuconfig defaults.
+ */
+
+#pragma once
+
+#define CONFIG_FACE_TRACKER_SERVO_RATE_HZ 200
+#define CONFIG_FACE_TRACKER_COMMAND_TASK_CORE 1
@@ -0,0 +1,199 @@
+/**
+ * Host-side ESP32 firmware simulator
+ *
+ * Runs the real firmware (main.cpp, BluetoothSpp, ServoController, framing and the nanopb codec)
+ * against host shims of ESP-IDF and FreeRTOS. The SPP server is a TCP socket or a pty, so the
+ * client connects with `tcp://127.0.0.1:3333` or `serial:///dev/pts/N` and no hardware.
+ */
+
+#include "sim_options.hpp"
+
+#include <esp_log.h>
+#include <esp_timer.h>
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+extern "C" void app_main();
+
+namespace {
+
+using embedded::sim::SimOptions;
+
+void PrintUsage(const char* program) {
+  std::printf(
+      "Usage: %s [options]\n"
+      "\n"
+      "Endpoint:\n"
+      "  --port N             Serve SPP on TCP port N (default %u, 0 picks a free port)\n"
+      "  --bind ADDRESS       Listen on ADDRESS (default 127.0.0.1)\n"
+      "  --pty                Serve SPP on a pseudo-terminal instead of TCP\n"
+      "\n"
+      "Link (both directions):\n"
+      "  --latency-ms N       One-way latency (default 0)\n"
+      "  --jitter-ms N        Extra latency drawn from [0, N] per packet (default 0)\n"
+      "  --bandwidth N        Throughput limit in bytes per second (default 0, unlimited)\n"
+      "  --mtu N              Largest packet delivered at once (default 990)\n"
+      "  --seed N             Jitter seed (default 1)\n"
+      "\n"
+      "Servos:\n"
+      "  --slew N             Servo slew rate in degrees per second (default 600)\n"
+      "  --telemetry-ms N     Print servo and SPP telemetry every N ms on stdout (default 0, off)\n"
+      "\n"
+      "  --log-level LEVEL    none, error, warn, info, debug or verbose (default info)\n"
+      "  --help               Show this help\n",
+      program, embedded::sim::kDefaultTcpPort);
+}
+
+template <typename T>
+[[nodiscard]] std::optional<T> ParseNumber(std::string_view text) {
+  T value{};
+  const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (error != std::errc() || end != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+[[nodiscard]] std::optional<esp_log_level_t> ParseLogLevel(std::string_view text) {
+  constexpr std::string_view kNames[] = {"none", "error", "warn", "info", "debug", "verbose"};
+  for (size_t level = 0; level < std::size(kNames); ++level) {
+    if (text == kNames[level]) {
+      return static_cast<esp_log_level_t>(level);
+    }
+  }
+  return std::nullopt;
+}
+
+/**
+ * @brief Parses the command line into @p options.
+ * @return False on an invalid option (reported on stderr)
+ */
+[[nodiscard]] bool ParseArguments(int argc, char** argv, SimOptions& options, esp_log_level_t& log_level) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view option = argv[i];
+    if (option == "--pty") {
+      options.endpoint = embedded::sim::SppEndpointKind::kPty;
+      continue;
+    }
+
+    if (i + 1 >= argc) {
+      std::fprintf(stderr, "Unknown option or missing value: %s\n", argv[i]);
+      return false;
+    }
+    const std::string_view value = argv[++i];
+
+    bool valid = true;
+    const auto set_u32 = [&value, &valid](uint32_t& target, uint32_t scale) {
+      const auto number = ParseNumber<uint32_t>(value);
+      valid = number.has_value();
+      target = number.value_or(0) * scale;
+    };
+
+    if (option == "--port") {
+      const auto port = ParseNumber<uint16_t>(value);
+      valid = port.has_value();
+      options.port = port.value_or(0);
+    } else if (option == "--bind") {
+      options.bind_address = value;
+    } else if (option == "--latency-ms") {
+      set_u32(options.to_device.latency_us, 1000);
+      options.to_client.latency_us = options.to_device.latency_us;
+    } else if (option == "--jitter-ms") {
+      set_u32(options.to_device.jitter_us, 1000);
+      options.to_client.jitter_us = options.to_device.jitter_us;
+    } else if (option == "--bandwidth") {
+      set_u32(options.to_device.bytes_per_second, 1);
+      options.to_client.bytes_per_second = options.to_device.bytes_per_second;
+    } else if (option == "--mtu") {
+      const auto mtu = ParseNumber<size_t>(value);
+      valid = mtu.has_value() && *mtu > 0 && *mtu <= UINT16_MAX;
+      options.to_device.mtu = mtu.value_or(1);
+      options.to_client.mtu = options.to_device.mtu;
+    } else if (option == "--seed") {
+      set_u32(options.to_device.seed, 1);
+      options.to_client.seed = options.to_device.seed + 1;
+    } else if (option == "--slew") {
+      const auto slew = ParseNumber<uint32_t>(value);
+      valid = slew.has_value() && *slew > 0;
+      options.servo.slew_deg_per_s = static_cast<float>(slew.value_or(1));
+    } else if (option == "--telemetry-ms") {
+      set_u32(options.telemetry_ms, 1);
+    } else if (option == "--log-level") {
+      const auto level = ParseLogLevel(value);
+      valid = level.has_value();
+      log_level = level.value_or(ESP_LOG_INFO);
+    } else {
+      std::fprintf(stderr, "Unknown option: %s\n", argv[i - 1]);
+      return false;
+    }
+
+    if (!valid) {
+      std::fprintf(stderr, "Invalid value for %s: %s\n", argv[i - 1], argv[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Prints where the simulated servo horns are, for plots and tests.
+ * @details Two lines per period: time, physical pan/tilt, and the angles last commanded by PWM;
+ * then how many SPP data events the firmware took and the longest its callback held the stack.
+ */
+void TelemetryLoop(uint32_t period_ms) {
+  auto next = std::chrono::steady_clock::now();
+  while (true) {
+    next += std::chrono::milliseconds(period_ms);
+    std::this_thread::sleep_until(next);
+
+    const int64_t now = esp_timer_get_time();
+    const auto& pan = embedded::sim::Servo(0);
+    const auto& tilt = embedded::sim::Servo(1);
+    std::printf("servo t_ms=%lld pan=%.2f tilt=%.2f pan_cmd=%.2f tilt_cmd=%.2f\n", static_cast<long long>(now / 1000),
+                static_cast<double>(pan.Position(now)), static_cast<double>(tilt.Position(now)),
+                static_cast<double>(pan.Commanded()), static_cast<double>(tilt.Commanded()));
+    const auto spp = embedded::sim::SppStats();
+    std::printf("spp t_ms=%lld data_events=%lu max_callback_us=%lld\n", static_cast<long long>(now / 1000),
+                static_cast<unsigned long>(spp.data_events), static_cast<long long>(spp.max_data_us));
+    std::fflush(stdout);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  for (int i = 1; i < argc; ++i) {
+    if (std::string_view(argv[i]) == "--help") {
+      PrintUsage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+  }
+
+  auto& options = embedded::sim::Options();
+  esp_log_level_t log_level = ESP_LOG_INFO;
+  if (!ParseArguments(argc, argv, options, log_level)) {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  esp_log_level_set("*", log_level);
+  for (size_t i = 0; i < embedded::sim::kServoCount; ++i) {
+    embedded::sim::Servo(i).SetConfig(options.servo);
+  }
+
+  if (options.telemetry_ms > 0) {
+    std::thread(TelemetryLoop, options.telemetry_ms).detach();
+  }
+
+  // The ESP32 runs app_main() on the main task; this firmware only returns from it if initialization failed
+  app_main();
+  return EXIT_FAILURE;
+}
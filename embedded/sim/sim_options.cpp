@@ -0,0 +1,23 @@
+/**
+ * @file sim_options.cpp
+ * @brief Configuration shared by the simulator's ESP-IDF shims
+ */
+
+#include "sim_options.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace embedded::sim {
+
+SimOptions& Options() noexcept {
+  static SimOptions options;
+  return options;
+}
+
+ServoModel& Servo(size_t index) noexcept {
+  static std::array<ServoModel, kServoCount> servos;
+  return servos[index < kServoCount ? index : kServoCount - 1];
+}
+
+}  // namespace embedded::sim
@@ -0,0 +1,647 @@
+/**
+ * @file spp_stack.cpp
+ * @brief Host Bluetooth stack: the SPP server is a TCP socket or pty behind the simulated link
+ *
+ * Stands in for the controller, Bluedroid and the SPP profile under the firmware's BluetoothSpp
+ * component. One thread plays the BTC task: it accepts the client, moves bytes through the
+ * LinkModel of each direction and raises the SPP events the firmware handles on the ESP32.
+ */
+
+#include "link_model.hpp"
+#include "sim_options.hpp"
+
+#include <esp_bt.h>
+#include <esp_bt_device.h>
+#include <esp_bt_main.h>
+#include <esp_err.h>
+#include <esp_gap_bt_api.h>
+#include <esp_log.h>
+#include <esp_spp_api.h>
+#include <esp_timer.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using embedded::sim::LinkModel;
+using embedded::sim::SppEndpointKind;
+
+constexpr const char* kTag = "sim_spp";
+
+/// Longest the stack thread sleeps without a deadline, so stopping never waits long.
+constexpr int kIdlePollMs = 100;
+
+/// First connection handle, as Bluedroid numbers them.
+constexpr uint32_t kFirstHandle = 0x81;
+
+/**
+ * @brief An SPP event waiting to be raised on the stack thread.
+ */
+struct PendingEvent {
+  esp_spp_cb_event_t event = ESP_SPP_INIT_EVT;
+  esp_spp_cb_param_t param{};
+  std::vector<uint8_t> data;  ///< Owned bytes behind param.data_ind.data.
+};
+
+/**
+ * @brief The simulated Bluetooth stack (one SPP server, one client at a time).
+ */
+class SppStack final {
+public:
+  static SppStack& Instance() {
+    // Never destroyed: the firmware's BluetoothSpp singleton may deinitialize it during exit
+    static auto* const stack = new SppStack;
+    return *stack;
+  }
+
+  SppStack(const SppStack&) = delete;
+  SppStack& operator=(const SppStack&) = delete;
+
+  [[nodiscard]] embedded::sim::SppCallbackStats CallbackStats() const {
+    return {.data_events = data_events_.load(std::memory_order_relaxed),
+            .max_data_us = max_data_us_.load(std::memory_order_relaxed)};
+  }
+
+  void SetCallback(esp_spp_cb_t callback) {
+    std::scoped_lock lock(mutex_);
+    callback_ = callback;
+  }
+
+  esp_err_t Init() {
+    std::scoped_lock lock(mutex_);
+    if (running_) {
+      return ESP_ERR_INVALID_STATE;
+    }
+    if (pipe(wake_pipe_.data()) != 0) {
+      ESP_LOGE(kTag, "Failed to create wake pipe: %s", std::strerror(errno));
+      return ESP_FAIL;
+    }
+    fcntl(wake_pipe_[0], F_SETFL, O_NONBLOCK);
+    fcntl(wake_pipe_[1], F_SETFL, O_NONBLOCK);
+
+    const auto& options = embedded::sim::Options();
+    to_device_ = LinkModel(options.to_device);
+    to_client_ = LinkModel(options.to_client);
+    stopping_ = false;
+    running_ = true;
+
+    PendingEvent init;
+    init.event = ESP_SPP_INIT_EVT;
+    init.param.init.status = ESP_SPP_SUCCESS;
+    events_.push_back(std::move(init));
+    thread_ = std::thread([this] { Run(); });
+    return ESP_OK;
+  }
+
+  esp_err_t Deinit() {
+    {
+      std::scoped_lock lock(mutex_);
+      if (!running_) {
+        return ESP_OK;
+      }
+      stopping_ = true;
+      running_ = false;
+    }
+    Wake();
+    if (thread_.get_id() == std::this_thread::get_id()) {
+      thread_.detach();
+    } else {
+      thread_.join();
+    }
+
+    CloseConnection(false);
+    CloseFd(listen_fd_);
+    CloseFd(pty_master_fd_);
+    CloseFd(pty_slave_fd_);
+    CloseFd(wake_pipe_[0]);
+    CloseFd(wake_pipe_[1]);
+    return ESP_OK;
+  }
+
+  /// Opens the endpoint (stack thread, from the ESP_SPP_INIT_EVT handler).
+  esp_err_t StartServer(const char* name) {
+    {
+      std::scoped_lock lock(mutex_);
+      if (!running_ || std::this_thread::get_id() != thread_.get_id()) {
+        return ESP_ERR_INVALID_STATE;
+      }
+    }
+
+    const auto& options = embedded::sim::Options();
+    const bool started = options.endpoint == SppEndpointKind::kPty ? OpenPty() : OpenTcp();
+
+    PendingEvent start;
+    start.event = ESP_SPP_START_EVT;
+    start.param.start.status = started ? ESP_SPP_SUCCESS : ESP_SPP_FAILURE;
+    Post(std::move(start));
+    if (started) {
+      ESP_LOGI(kTag, "SPP server '%s' on %s", name != nullptr ? name : "", endpoint_uri_.c_str());
+
+      // Machine-readable, so scripts and tests can find an ephemeral port or pty
+      std::printf("SPP endpoint: %s\n", endpoint_uri_.c_str());
+      std::fflush(stdout);
+
+      if (options.endpoint == SppEndpointKind::kPty) {
+        OpenConnection(pty_master_fd_);  // A pty has no connect event: the line is always up
+      }
+    }
+    return ESP_OK;
+  }
+
+  esp_err_t Write(uint32_t handle, std::span<const uint8_t> data) {
+    {
+      std::scoped_lock lock(mutex_);
+      if (handle == 0 || handle != handle_) {
+        return ESP_FAIL;
+      }
+      to_client_.Push(data, esp_timer_get_time());
+    }
+    Wake();
+    return ESP_OK;
+  }
+
+private:
+  SppStack() = default;
+  ~SppStack() = default;
+
+  void Run() {
+    pthread_setname_np(pthread_self(), "btc");
+    while (true) {
+      RaisePendingEvents();
+      DeliverDue();
+
+      {
+        std::scoped_lock lock(mutex_);
+        if (stopping_) {
+          return;
+        }
+      }
+
+      std::array<pollfd, 3> fds{};
+      nfds_t count = 0;
+      fds[count++] = {wake_pipe_[0], POLLIN, 0};
+      if (listen_fd_ >= 0) {
+        fds[count++] = {listen_fd_, POLLIN, 0};
+      }
+      if (connection_fd_ >= 0) {
+        fds[count++] = {connection_fd_, POLLIN, 0};
+      }
+
+      if (poll(fds.data(), count, PollTimeoutMs()) <= 0) {
+        continue;
+      }
+      for (nfds_t i = 0; i < count; ++i) {
+        if (fds[i].revents == 0) {
+          continue;
+        }
+        if (fds[i].fd == wake_pipe_[0]) {
+          DrainWakePipe();
+        } else if (fds[i].fd == listen_fd_) {
+          Accept();
+        } else if (fds[i].fd == connection_fd_) {
+          Receive();
+        }
+      }
+    }
+  }
+
+  /// Milliseconds until the next packet is due on either direction (rounded up).
+  [[nodiscard]] int PollTimeoutMs() {
+    std::scoped_lock lock(mutex_);
+    if (!events_.empty()) {
+      return 0;
+    }
+
+    std::optional<int64_t> next = to_device_.NextDelivery();
+    if (const auto uplink = to_client_.NextDelivery()) {
+      next = next ? std::min(*next, *uplink) : *uplink;
+    }
+    if (!next) {
+      return kIdlePollMs;
+    }
+    const int64_t wait_us = std::max<int64_t>(*next - esp_timer_get_time(), 0);
+    return static_cast<int>(std::min<int64_t>((wait_us + 999) / 1000, kIdlePollMs));
+  }
+
+  void Accept() {
+    const int fd = accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) {
+      return;
+    }
+    if (connection_fd_ >= 0) {
+      ESP_LOGW(kTag, "Rejecting a second client: the SPP server serves one at a time");
+      close(fd);
+      return;
+    }
+
+    // Frames are small and latency-bound; the link model decides when they leave
+    const int no_delay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+    OpenConnection(fd);
+  }
+
+  void OpenConnection(int fd) {
+    uint32_t handle = 0;
+    {
+      std::scoped_lock lock(mutex_);
+      connection_fd_ = fd;
+      handle_ = next_handle_++;
+      handle = handle_;
+      to_device_.Clear();
+      to_client_.Clear();
+    }
+
+    PendingEvent open;
+    open.event = ESP_SPP_SRV_OPEN_EVT;
+    open.param.srv_open.status = ESP_SPP_SUCCESS;
+    open.param.srv_open.handle = handle;
+    Post(std::move(open));
+  }
+
+  void CloseConnection(bool raise_event) {
+    uint32_t handle = 0;
+    {
+      std::scoped_lock lock(mutex_);
+      if (connection_fd_ < 0) {
+        return;
+      }
+      if (connection_fd_ != pty_master_fd_) {
+        close(connection_fd_);
+      }
+      connection_fd_ = -1;
+      handle = handle_;
+      handle_ = 0;
+      to_device_.Clear();
+      to_client_.Clear();
+    }
+
+    if (raise_event) {
+      PendingEvent closed;
+      closed.event = ESP_SPP_CLOSE_EVT;
+      closed.param.close.status = ESP_SPP_SUCCESS;
+      closed.param.close.handle = handle;
+      Post(std::move(closed));
+    }
+  }
+
+  void Receive() {
+    std::array<uint8_t, 4096> buffer;
+    const ssize_t received = read(connection_fd_, buffer.data(), buffer.size());
+    if (received < 0 && (errno == EAGAIN || errno == EINTR)) {
+      return;
+    }
+    if (received <= 0) {
+      ESP_LOGI(kTag, "Client disconnected");
+      CloseConnection(true);
+      return;
+    }
+
+    std::scoped_lock lock(mutex_);
+    to_device_.Push(std::span<const uint8_t>(buffer.data(), static_cast<size_t>(received)), esp_timer_get_time());
+  }
+
+  /// Hands due packets to the firmware (DATA_IND) and to the client socket.
+  void DeliverDue() {
+    const int64_t now = esp_timer_get_time();
+    while (true) {
+      std::optional<embedded::sim::LinkPacket> packet;
+      uint32_t handle = 0;
+      {
+        std::scoped_lock lock(mutex_);
+        packet = to_device_.PopDue(now);
+        handle = handle_;
+      }
+      if (!packet) {
+        break;
+      }
+
+      PendingEvent data;
+      data.event = ESP_SPP_DATA_IND_EVT;
+      data.param.data_ind.status = ESP_SPP_SUCCESS;
+      data.param.data_ind.handle = handle;
+      data.data = std::move(packet->data);
+      Raise(data);
+    }
+
+    while (true) {
+      std::optional<embedded::sim::LinkPacket> packet;
+      int fd = -1;
+      uint32_t handle = 0;
+      {
+        std::scoped_lock lock(mutex_);
+        packet = to_client_.PopDue(now);
+        fd = connection_fd_;
+        handle = handle_;
+      }
+      if (!packet || fd < 0) {
+        break;
+      }
+
+      const bool sent = WriteAll(fd, packet->data);
+      PendingEvent written;
+      written.event = ESP_SPP_WRITE_EVT;
+      written.param.write.status = sent ? ESP_SPP_SUCCESS : ESP_SPP_FAILURE;
+      written.param.write.handle = handle;
+      written.param.write.len = static_cast<int>(packet->data.size());
+      Raise(written);
+      if (!sent) {
+        ESP_LOGI(kTag, "Client disconnected");
+        CloseConnection(true);
+        break;
+      }
+    }
+  }
+
+  void Post(PendingEvent event) {
+    std::scoped_lock lock(mutex_);
+    events_.push_back(std::move(event));
+  }
+
+  void RaisePendingEvents() {
+    while (true) {
+      PendingEvent event;
+      {
+        std::scoped_lock lock(mutex_);
+        if (events_.empty()) {
+          return;
+        }
+        event = std::move(events_.front());
+        events_.pop_front();
+      }
+      Raise(event);
+    }
+  }
+
+  /// Runs the firmware's callback on this thread, without holding the stack lock.
+  void Raise(PendingEvent& event) {
+    esp_spp_cb_t callback = nullptr;
+    {
+      std::scoped_lock lock(mutex_);
+      callback = callback_;
+    }
+    if (event.event == ESP_SPP_DATA_IND_EVT) {
+      event.param.data_ind.len = static_cast<uint16_t>(event.data.size());
+      event.param.data_ind.data = event.data.data();
+    }
+    if (callback == nullptr) {
+      return;
+    }
+
+    const int64_t start = esp_timer_get_time();
+    callback(event.event, &event.param);
+    if (event.event == ESP_SPP_DATA_IND_EVT) {
+      const int64_t elapsed = esp_timer_get_time() - start;
+      data_events_.fetch_add(1, std::memory_order_relaxed);
+      if (elapsed > max_data_us_.load(std::memory_order_relaxed)) {
+        max_data_us_.store(elapsed, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  [[nodiscard]] bool OpenTcp() {
+    const auto& options = embedded::sim::Options();
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+      ESP_LOGE(kTag, "Failed to create socket: %s", std::strerror(errno));
+      return false;
+    }
+    const int reuse = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(options.port);
+    if (inet_pton(AF_INET, options.bind_address.c_str(), &address.sin_addr) != 1) {
+      ESP_LOGE(kTag, "Invalid bind address '%s'", options.bind_address.c_str());
+      CloseFd(listen_fd_);
+      return false;
+    }
+    if (bind(listen_fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd_, 1) != 0) {
+      ESP_LOGE(kTag, "Failed to listen on %s:%u: %s", options.bind_address.c_str(), options.port,
+               std::strerror(errno));
+      CloseFd(listen_fd_);
+      return false;
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    endpoint_uri_ = "tcp://" + options.bind_address + ":" + std::to_string(ntohs(address.sin_port));
+    return true;
+  }
+
+  [[nodiscard]] bool OpenPty() {
+    pty_master_fd_ = posix_openpt(O_RDWR | O_NOCTTY);
+    if (pty_master_fd_ < 0 || grantpt(pty_master_fd_) != 0 || unlockpt(pty_master_fd_) != 0) {
+      ESP_LOGE(kTag, "Failed to create pty: %s", std::strerror(errno));
+      CloseFd(pty_master_fd_);
+      return false;
+    }
+    const char* slave_path = ptsname(pty_master_fd_);
+
+    // Held open so the master never sees a hangup between clients; raw so bytes pass untouched
+    pty_slave_fd_ = open(slave_path, O_RDWR | O_NOCTTY);
+    termios settings{};
+    if (pty_slave_fd_ < 0 || tcgetattr(pty_slave_fd_, &settings) != 0) {
+      ESP_LOGE(kTag, "Failed to open %s: %s", slave_path, std::strerror(errno));
+      CloseFd(pty_slave_fd_);
+      CloseFd(pty_master_fd_);
+      return false;
+    }
+    cfmakeraw(&settings);
+    tcsetattr(pty_slave_fd_, TCSANOW, &settings);
+
+    endpoint_uri_ = std::string("serial://") + slave_path;
+    return true;
+  }
+
+  [[nodiscard]] static bool WriteAll(int fd, std::span<const uint8_t> data) {
+    while (!data.empty()) {
+      const ssize_t written = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+      if (written < 0 && errno == ENOTSOCK) {
+        // pty master
+        const ssize_t pty_written = write(fd, data.data(), data.size());
+        if (pty_written <= 0) {
+          return false;
+        }
+        data = data.subspan(static_cast<size_t>(pty_written));
+        continue;
+      }
+      if (written < 0 && errno == EINTR) {
+        continue;
+      }
+      if (written <= 0) {
+        return false;
+      }
+      data = data.subspan(static_cast<size_t>(written));
+    }
+    return true;
+  }
+
+  void Wake() {
+    const uint8_t byte = 1;
+    [[maybe_unused]] const ssize_t written = write(wake_pipe_[1], &byte, 1);
+  }
+
+  void DrainWakePipe() {
+    std::array<uint8_t, 64> buffer;
+    while (read(wake_pipe_[0], buffer.data(), buffer.size()) > 0) {
+    }
+  }
+
+  static void CloseFd(int& fd) {
+    if (fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+
+  std::mutex mutex_;
+  esp_spp_cb_t callback_ = nullptr;
+  std::deque<PendingEvent> events_;
+  LinkModel to_device_;
+  LinkModel to_client_;
+  uint32_t handle_ = 0;
+  uint32_t next_handle_ = kFirstHandle;
+  bool running_ = false;
+  bool stopping_ = false;
+  std::thread thread_;
+
+  // Stack thread only, apart from the handles read under mutex_
+  int listen_fd_ = -1;
+  int connection_fd_ = -1;
+  int pty_master_fd_ = -1;
+  int pty_slave_fd_ = -1;
+  std::array<int, 2> wake_pipe_ = {-1, -1};
+  std::string endpoint_uri_;
+
+  // Written by the stack thread, read by telemetry
+  std::atomic<uint32_t> data_events_{0};
+  std::atomic<int64_t> max_data_us_{0};
+};
+
+}  // namespace
+
+namespace embedded::sim {
+
+SppCallbackStats SppStats() noexcept {
+  return SppStack::Instance().CallbackStats();
+}
+
+}  // namespace embedded::sim
+
+esp_err_t esp_bt_controller_mem_release(esp_bt_mode_t /*mode*/) {
+  return ESP_OK;
+}
+
+esp_err_t esp_bt_controller_init(esp_bt_controller_config_t* config) {
+  return config != nullptr ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_bt_controller_deinit() {
+  return ESP_OK;
+}
+
+esp_err_t esp_bt_controller_enable(esp_bt_mode_t /*mode*/) {
+  return ESP_OK;
+}
+
+esp_err_t esp_bt_controller_disable() {
+  return ESP_OK;
+}
+
+esp_err_t esp_bluedroid_init() {
+  return ESP_OK;
+}
+
+esp_err_t esp_bluedroid_deinit() {
+  return ESP_OK;
+}
+
+esp_err_t esp_bluedroid_enable() {
+  return ESP_OK;
+}
+
+esp_err_t esp_bluedroid_disable() {
+  return ESP_OK;
+}
+
+esp_err_t esp_bt_dev_set_device_name(const char* name) {
+  if (name == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  ESP_LOGI(kTag, "Device name: %s", name);
+  return ESP_OK;
+}
+
+esp_err_t esp_bt_gap_register_callback(esp_bt_gap_cb_t callback) {
+  return callback != nullptr ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_bt_gap_set_scan_mode(esp_bt_connection_mode_t /*c_mode*/, esp_bt_discovery_mode_t /*d_mode*/) {
+  return ESP_OK;
+}
+
+esp_err_t esp_bt_gap_pin_reply(esp_bd_addr_t /*bd_addr*/, bool /*accept*/, uint8_t /*pin_code_len*/,
+                               esp_bt_pin_code_t /*pin_code*/) {
+  return ESP_OK;
+}
+
+esp_err_t esp_bt_gap_ssp_confirm_reply(esp_bd_addr_t /*bd_addr*/, bool /*accept*/) {
+  return ESP_OK;
+}
+
+esp_err_t esp_spp_register_callback(esp_spp_cb_t callback) {
+  if (callback == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  SppStack::Instance().SetCallback(callback);
+  return ESP_OK;
+}
+
+esp_err_t esp_spp_enhanced_init(const esp_spp_cfg_t* config) {
+  if (config == nullptr || config->mode != ESP_SPP_MODE_CB) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  return SppStack::Instance().Init();
+}
+
+esp_err_t esp_spp_deinit() {
+  return SppStack::Instance().Deinit();
+}
+
+esp_err_t esp_spp_start_srv(esp_spp_sec_t /*sec_mask*/, esp_spp_role_t /*role*/, uint8_t /*local_scn*/,
+                            const char* name) {
+  return SppStack::Instance().StartServer(name);
+}
+
+esp_err_t esp_spp_write(uint32_t handle, int len, uint8_t* data) {
+  if (len < 0 || (len > 0 && data == nullptr)) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  return SppStack::Instance().Write(handle, std::span<const uint8_t>(data, static_cast<size_t>(len)));
+}
@@ -0,0 +1,371 @@
+#include <doctest/doctest.h>
+
+#include <messages.pb.h>
+#include <pb_decode.h>
+#include <pb_encode.h>
+#include <spp_framing.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern char** environ;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// One-way latency the simulator is started with.
+constexpr int kLatencyMs = 20;
+
+/// Servo loop rate the simulator is built with (CONFIG_FACE_TRACKER_SERVO_RATE_HZ in sim/shims/sdkconfig.h).
+constexpr uint32_t kServoRateHz = 200;
+
+/// Servo angles from one telemetry line.
+struct ServoSample {
+  float pan = 0.0F;
+  float tilt = 0.0F;
+};
+
+/// SPP callback timing from one telemetry line.
+struct SppSample {
+  unsigned long data_events = 0;
+  long long max_callback_us = 0;
+};
+
+/// Runs the firmware simulator and collects its endpoint, servo and SPP telemetry from stdout.
+class SimProcess {
+public:
+  SimProcess() {
+    std::array<int, 2> pipe_fds{};
+    if (pipe(pipe_fds.data()) != 0) {
+      return;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipe_fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, pipe_fds[0]);
+    posix_spawn_file_actions_addclose(&actions, pipe_fds[1]);
+
+    const std::string latency = std::to_string(kLatencyMs);
+    std::vector<std::string> args = {FIRMWARE_SIM_PATH, "--port",      "0",     "--latency-ms", latency,
+                                     "--telemetry-ms",  "50",          "--slew", "300",          "--log-level",
+                                     "warn"};
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+      argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    const int result = posix_spawn(&pid_, FIRMWARE_SIM_PATH, &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(pipe_fds[1]);
+    if (result != 0) {
+      close(pipe_fds[0]);
+      pid_ = -1;
+      return;
+    }
+
+    output_ = fdopen(pipe_fds[0], "r");
+    reader_ = std::thread([this] { ReadOutput(); });
+  }
+
+  SimProcess(const SimProcess&) = delete;
+  SimProcess& operator=(const SimProcess&) = delete;
+
+  ~SimProcess() {
+    if (pid_ > 0) {
+      kill(pid_, SIGTERM);
+      waitpid(pid_, nullptr, 0);
+    }
+    if (reader_.joinable()) {
+      reader_.join();  // The pipe reaches EOF once the simulator is gone
+    }
+    if (output_ != nullptr) {
+      std::fclose(output_);
+    }
+  }
+
+  /// Waits for the "SPP endpoint: tcp://host:port" line and returns the port.
+  [[nodiscard]] std::optional<uint16_t> WaitForPort(std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex_);
+    changed_.wait_for(lock, timeout, [this] { return port_.has_value() || eof_; });
+    return port_;
+  }
+
+  /// Waits until telemetry shows both servos within @p tolerance degrees of the given angles.
+  [[nodiscard]] bool WaitForServos(float pan, float tilt, float tolerance, std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex_);
+    return changed_.wait_for(lock, timeout, [&] {
+      return latest_.has_value() && std::abs(latest_->pan - pan) <= tolerance &&
+             std::abs(latest_->tilt - tilt) <= tolerance;
+    });
+  }
+
+  /// Waits until telemetry has counted at least @p data_events SPP data events and returns the latest sample.
+  [[nodiscard]] std::optional<SppSample> WaitForSppEvents(unsigned long data_events,
+                                                          std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex_);
+    changed_.wait_for(lock, timeout, [&] { return spp_.has_value() && spp_->data_events >= data_events; });
+    return spp_;
+  }
+
+private:
+  void ReadOutput() {
+    std::array<char, 256> line{};
+    while (std::fgets(line.data(), static_cast<int>(line.size()), output_) != nullptr) {
+      std::scoped_lock lock(mutex_);
+      unsigned int port = 0;
+      long long t_ms = 0;
+      ServoSample sample;
+      SppSample spp;
+      if (std::sscanf(line.data(), "SPP endpoint: tcp://%*[^:]:%u", &port) == 1) {
+        port_ = static_cast<uint16_t>(port);
+      } else if (std::sscanf(line.data(), "servo t_ms=%lld pan=%f tilt=%f", &t_ms, &sample.pan, &sample.tilt) == 3) {
+        latest_ = sample;
+      } else if (std::sscanf(line.data(), "spp t_ms=%lld data_events=%lu max_callback_us=%lld", &t_ms,
+                             &spp.data_events, &spp.max_callback_us) == 3) {
+        spp_ = spp;
+      }
+      changed_.notify_all();
+    }
+    std::scoped_lock lock(mutex_);
+    eof_ = true;
+    changed_.notify_all();
+  }
+
+  pid_t pid_ = -1;
+  FILE* output_ = nullptr;
+  std::thread reader_;
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  std::optional<uint16_t> port_;
+  std::optional<ServoSample> latest_;
+  std::optional<SppSample> spp_;
+  bool eof_ = false;
+};
+
+/// Client end of the simulated SPP link: framed nanopb Commands out, Responses in.
+class SppClient {
+public:
+  explicit SppClient(uint16_t port) {
+    socket_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in device{};
+    device.sin_family = AF_INET;
+    device.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    device.sin_port = htons(port);
+    connected_ = socket_ >= 0 && connect(socket_, reinterpret_cast<const sockaddr*>(&device), sizeof(device)) == 0;
+    const int enable = 1;
+    setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+  }
+
+  SppClient(const SppClient&) = delete;
+  SppClient& operator=(const SppClient&) = delete;
+
+  ~SppClient() {
+    if (socket_ >= 0) {
+      close(socket_);
+    }
+  }
+
+  [[nodiscard]] bool Connected() const { return connected_; }
+
+  [[nodiscard]] bool Send(const app_Command& command) {
+    std::array<uint8_t, embedded::kMaxFramePayloadSize> payload{};
+    pb_ostream_t stream = pb_ostream_from_buffer(payload.data(), payload.size());
+    if (!pb_encode(&stream, app_Command_fields, &command)) {
+      return false;
+    }
+
+    std::array<uint8_t, embedded::MaxEncodedFrameSize(embedded::kMaxFramePayloadSize)> frame{};
+    size_t written = 0;
+    if (embedded::EncodeFrame(embedded::FrameType::kCommand,
+                              std::span<const uint8_t>(payload.data(), stream.bytes_written), frame,
+                              written) != embedded::FramingError::kOk) {
+      return false;
+    }
+    return send(socket_, frame.data(), written, MSG_NOSIGNAL) == static_cast<ssize_t>(written);
+  }
+
+  /// Sends a burst of commands without waiting for any response.
+  [[nodiscard]] bool SendAll(std::span<const app_Command> commands) {
+    return std::ranges::all_of(commands, [this](const app_Command& command) { return Send(command); });
+  }
+
+  /// Receives the next Response frame, skipping any other frame types.
+  [[nodiscard]] std::optional<app_Response> Receive(std::chrono::milliseconds timeout) {
+    const auto deadline = Clock::now() + timeout;
+    while (responses_.empty()) {
+      const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+      pollfd fd{socket_, POLLIN, 0};
+      if (remaining.count() <= 0 || poll(&fd, 1, static_cast<int>(remaining.count())) <= 0) {
+        return std::nullopt;
+      }
+
+      std::array<uint8_t, 1024> buffer{};
+      const ssize_t received = recv(socket_, buffer.data(), buffer.size(), 0);
+      if (received <= 0) {
+        return std::nullopt;
+      }
+      decoder_.Feed(std::span<const uint8_t>(buffer.data(), static_cast<size_t>(received)),
+                    [this](const embedded::Frame& frame) {
+                      if (frame.type != embedded::FrameType::kResponse) {
+                        return;
+                      }
+                      app_Response response = app_Response_init_zero;
+                      pb_istream_t stream = pb_istream_from_buffer(frame.payload.data(), frame.payload.size());
+                      if (pb_decode(&stream, app_Response_fields, &response)) {
+                        responses_.push_back(response);
+                      }
+                    });
+    }
+
+    const app_Response response = responses_.front();
+    responses_.erase(responses_.begin());
+    return response;
+  }
+
+  /// Receives Responses until the one for @p command_id, discarding the others.
+  [[nodiscard]] std::optional<app_Response> ReceiveFor(uint32_t command_id, std::chrono::milliseconds timeout) {
+    const auto deadline = Clock::now() + timeout;
+    while (true) {
+      const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+      auto response = Receive(remaining);
+      if (!response || response->command_id == command_id) {
+        return response;
+      }
+    }
+  }
+
+private:
+  int socket_ = -1;
+  bool connected_ = false;
+  embedded::FrameDecoder decoder_;
+  std::vector<app_Response> responses_;
+};
+
+[[nodiscard]] app_Command MakeCommand(uint32_t id, app_CommandType type) {
+  app_Command command = app_Command_init_zero;
+  command.id = id;
+  command.type = type;
+  return command;
+}
+
+}  // namespace
+
+TEST_SUITE("embedded::FirmwareSim") {
+  TEST_CASE("Firmware simulator: Answers over the modelled link and moves the simulated servos") {
+    SimProcess sim;
+    const auto port = sim.WaitForPort(std::chrono::seconds(5));
+    REQUIRE(port.has_value());
+
+    SppClient client(*port);
+    REQUIRE(client.Connected());
+
+    // A PING crosses the link twice
+    const auto sent_at = Clock::now();
+    REQUIRE(client.Send(MakeCommand(1, app_CommandType_COMMAND_TYPE_PING)));
+    const auto pong = client.Receive(std::chrono::seconds(2));
+    const auto round_trip = Clock::now() - sent_at;
+    REQUIRE(pong.has_value());
+    CHECK_EQ(pong->command_id, 1U);
+    CHECK_EQ(pong->status, app_StatusCode_STATUS_CODE_OK);
+    CHECK_GE(round_trip, std::chrono::milliseconds(2 * kLatencyMs));
+
+    // Fresh from power-up the servos are not calibrated, and a MOVE is refused until they are
+    REQUIRE(client.Send(MakeCommand(2, app_CommandType_COMMAND_TYPE_GET_STATUS)));
+    const auto fresh = client.Receive(std::chrono::seconds(2));
+    REQUIRE(fresh.has_value());
+    REQUIRE_EQ(fresh->which_payload, app_Response_device_status_tag);
+    CHECK_FALSE(fresh->payload.device_status.is_calibrated);
+    REQUIRE(client.Send(MakeCommand(3, app_CommandType_COMMAND_TYPE_CALIBRATE)));
+    const auto calibrated = client.ReceiveFor(3, std::chrono::seconds(10));
+    REQUIRE(calibrated.has_value());
+    CHECK_EQ(calibrated->status, app_StatusCode_STATUS_CODE_OK);
+
+    app_Command move = MakeCommand(4, app_CommandType_COMMAND_TYPE_MOVE);
+    move.which_payload = app_Command_move_tag;
+    move.payload.move.has_target_position = true;
+    move.payload.move.target_position.pan = 30.0F;
+    move.payload.move.target_position.tilt = -15.0F;
+    REQUIRE(client.Send(move));
+    const auto accepted = client.Receive(std::chrono::seconds(2));
+    REQUIRE(accepted.has_value());
+    CHECK_EQ(accepted->command_id, 4U);
+    CHECK_EQ(accepted->status, app_StatusCode_STATUS_CODE_OK);
+
+    // The servo task eases towards the target and the simulated horns follow
+    CHECK(sim.WaitForServos(30.0F, -15.0F, 1.0F, std::chrono::seconds(5)));
+
+    // The status carries the servo loop's timing
+    REQUIRE(client.Send(MakeCommand(5, app_CommandType_COMMAND_TYPE_GET_STATUS)));
+    const auto status = client.Receive(std::chrono::seconds(2));
+    REQUIRE(status.has_value());
+    REQUIRE_EQ(status->which_payload, app_Response_device_status_tag);
+    const auto& device = status->payload.device_status;
+    CHECK_EQ(device.target_position.pan, doctest::Approx(30.0F));
+    CHECK(device.is_calibrated);
+    CHECK_FALSE(device.is_moving);
+    REQUIRE(device.has_servo_loop);
+    CHECK_EQ(device.servo_loop.rate_hz, kServoRateHz);
+    CHECK_GT(device.servo_loop.updates, 0U);
+    MESSAGE("Servo loop at " << device.servo_loop.rate_hz << " Hz: jitter " << device.servo_loop.jitter_us
+                             << " us (max " << device.servo_loop.max_jitter_us << " us), "
+                             << device.servo_loop.overruns << " overruns in " << device.servo_loop.updates
+                             << " updates, longest update " << device.servo_loop.max_busy_us << " us");
+  }
+  TEST_CASE("Firmware simulator: The SPP callback returns promptly while a command flood waits behind CALIBRATE") {
+    SimProcess sim;
+    const auto port = sim.WaitForPort(std::chrono::seconds(5));
+    REQUIRE(port.has_value());
+
+    SppClient client(*port);
+    REQUIRE(client.Connected());
+
+    // CALIBRATE keeps the command task busy for seconds while PINGs pile up behind it
+    REQUIRE(client.Send(MakeCommand(1, app_CommandType_COMMAND_TYPE_CALIBRATE)));
+    std::vector<app_Command> flood;
+    for (uint32_t id = 100; id < 2100; ++id) {
+      flood.push_back(MakeCommand(id, app_CommandType_COMMAND_TYPE_PING));
+    }
+    REQUIRE(client.SendAll(flood));
+
+    const auto calibrated = client.ReceiveFor(1, std::chrono::seconds(10));
+    REQUIRE(calibrated.has_value());
+    CHECK_EQ(calibrated->status, app_StatusCode_STATUS_CODE_OK);
+
+    // The flood reached the firmware in many data events, none of which waited for the calibration
+    const auto spp = sim.WaitForSppEvents(10, std::chrono::seconds(2));
+    REQUIRE(spp.has_value());
+    MESSAGE(spp->data_events << " SPP data events, longest callback " << spp->max_callback_us << " us");
+    CHECK_GE(spp->data_events, 10U);
+    CHECK_LT(spp->max_callback_us, 50000);
+
+    // Whatever the full ingress dropped, the command task resynchronises and still answers
+    REQUIRE(client.Send(MakeCommand(3000, app_CommandType_COMMAND_TYPE_PING)));
+    const auto pong = client.ReceiveFor(3000, std::chrono::seconds(5));
+    REQUIRE(pong.has_value());
+    CHECK_EQ(pong->status, app_StatusCode_STATUS_CODE_OK);
+  }
+}
@@ -0,0 +1,94 @@
+#include <doctest/doctest.h>
+
+#include <motion_profile.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+using embedded::MotionLimits;
+using embedded::MotionProfile;
+using Clock = std::chrono::steady_clock;
+
+constexpr int kMoves = 20000;
+constexpr float kDt = 0.02F;  ///< Servo task period.
+
+/// Per-step cost of one profile configuration.
+struct StepCost {
+  double mean_ns = 0.0;
+  double p99_ns = 0.0;  ///< Covers the steps that locate a phase change by bisection.
+  uint64_t steps = 0;
+};
+
+/// Runs kMoves moves between alternating targets, retargeting every third move early on.
+/// Each update is timed on its own, so the figures include one clock read.
+[[nodiscard]] StepCost MeasureSteps(const MotionLimits& limits, float& sink) {
+  MotionProfile profile(limits);
+  std::vector<int64_t> step_ns;
+  for (int move = 0; move < kMoves; ++move) {
+    profile.SetTarget((move % 2 == 0 ? 1.0F : -1.0F) * static_cast<float>(10 + move % 70));
+    int step = 0;
+    while (!profile.Done()) {
+      if (move % 3 == 0 && step == 5) {
+        profile.SetTarget(-profile.Target() * 0.5F);
+      }
+      const auto start = Clock::now();
+      sink += profile.Step(kDt).position;
+      step_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+      ++step;
+    }
+  }
+  StepCost cost;
+  cost.steps = step_ns.size();
+  cost.mean_ns = static_cast<double>(std::accumulate(step_ns.begin(), step_ns.end(), int64_t{0})) /
+                 static_cast<double>(cost.steps);
+  const auto p99 = step_ns.begin() + static_cast<std::ptrdiff_t>(step_ns.size() * 99 / 100);
+  std::nth_element(step_ns.begin(), p99, step_ns.end());
+  cost.p99_ns = static_cast<double>(*p99);
+  return cost;
+}
+
+}  // namespace
+
+TEST_SUITE("embedded::MotionProfile benchmark") {
+  TEST_CASE("MotionProfile: Per-update cost") {
+    float sink = 0.0F;
+
+    // The exponential smoothing ServoController::Update ran before the profiles, for reference
+    float position = 0.0F;
+    uint64_t smoothing_steps = 0;
+    Clock::duration smoothing_total{};
+    for (int move = 0; move < kMoves; ++move) {
+      const float target = (move % 2 == 0 ? 1.0F : -1.0F) * static_cast<float>(10 + move % 70);
+      while (std::abs(position - target) >= 0.1F) {
+        const auto start = Clock::now();
+        position += (target - position) * 0.5F;
+        sink += position;
+        smoothing_total += Clock::now() - start;
+        ++smoothing_steps;
+      }
+    }
+    const double smoothing_ns =
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(smoothing_total).count()) /
+        static_cast<double>(smoothing_steps);
+
+    const StepCost scurve = MeasureSteps({}, sink);
+    const StepCost trapezoid = MeasureSteps({.max_velocity = 300.0F, .max_acceleration = 1500.0F, .max_jerk = 0.0F},
+                                            sink);
+
+    MESSAGE("Exponential smoothing " << smoothing_ns << " ns/update");
+    MESSAGE("S-curve " << scurve.mean_ns << " ns/update (p99 " << scurve.p99_ns << " ns, " << scurve.steps
+                       << " updates)");
+    MESSAGE("Trapezoid " << trapezoid.mean_ns << " ns/update (p99 " << trapezoid.p99_ns << " ns, " << trapezoid.steps
+                         << " updates)");
+    CHECK_NE(sink, 0.0F);
+    CHECK_GT(scurve.steps, 0U);
+    CHECK_GT(trapezoid.steps, 0U);
+  }
+}
@@ -0,0 +1,211 @@
+#include <doctest/doctest.h>
+
+#include <datagram_channel.hpp>
+#include <spp_framing.hpp>
+#include <udp_link.hpp>
+#include <udp_socket.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t kLatestTag = 'L';
+constexpr uint8_t kReliableTag = 'R';
+
+/// Every kDropEvery-th datagram the client sends is dropped, acknowledgements and retransmissions included.
+constexpr uint32_t kDropEvery = 10;
+
+[[nodiscard]] uint32_t NowUs() {
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+[[nodiscard]] std::array<uint8_t, 5> Message(uint8_t tag, uint32_t value) {
+  return {tag, static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value >> 16),
+          static_cast<uint8_t>(value >> 24)};
+}
+
+[[nodiscard]] uint32_t ValueOf(std::span<const uint8_t> message) {
+  return static_cast<uint32_t>(message[1]) | (static_cast<uint32_t>(message[2]) << 8) |
+         (static_cast<uint32_t>(message[3]) << 16) | (static_cast<uint32_t>(message[4]) << 24);
+}
+
+/// Sends on a connected socket, dropping every kDropEvery-th datagram.
+struct LossySender {
+  int socket = -1;
+  uint32_t* sent = nullptr;
+
+  void operator()(std::span<const uint8_t> datagram) const {
+    if (++*sent % kDropEvery != 0) {
+      send(socket, datagram.data(), datagram.size(), 0);
+    }
+  }
+};
+
+/// Client end over a real loopback socket, with a lossy send path.
+class TestClient {
+public:
+  TestClient(uint16_t port, uint8_t session) : channel_(session) {
+    socket_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sockaddr_in device{};
+    device.sin_family = AF_INET;
+    device.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    device.sin_port = htons(port);
+    connected_ = socket_ >= 0 && connect(socket_, reinterpret_cast<const sockaddr*>(&device), sizeof(device)) == 0;
+  }
+
+  TestClient(const TestClient&) = delete;
+  TestClient& operator=(const TestClient&) = delete;
+
+  ~TestClient() {
+    if (socket_ >= 0) {
+      close(socket_);
+    }
+  }
+
+  [[nodiscard]] bool Connected() const { return connected_; }
+
+  void SendLatest(uint32_t value) { channel_.SendLatest(Message(kLatestTag, value), NowUs(), Sender()); }
+
+  bool SendReliable(uint32_t value) { return channel_.SendReliable(Message(kReliableTag, value), NowUs(), Sender()); }
+
+  /// Receives whatever the device sent and retransmits overdue reliable datagrams.
+  void Pump() {
+    std::array<uint8_t, embedded::kMaxDatagramSize> datagram;
+    while (true) {
+      const auto received = recv(socket_, datagram.data(), datagram.size(), MSG_DONTWAIT);
+      if (received <= 0) {
+        break;
+      }
+      const auto deliver = [this](std::span<const uint8_t> message) { echoes.push_back(ValueOf(message)); };
+      channel_.Receive(std::span<const uint8_t>(datagram.data(), static_cast<size_t>(received)), NowUs(), deliver,
+                       Sender());
+    }
+    channel_.PollRetransmits(NowUs(), Sender());
+  }
+
+  [[nodiscard]] const embedded::DatagramChannel& Channel() const { return channel_; }
+
+  std::vector<uint32_t> echoes;
+
+private:
+  [[nodiscard]] LossySender Sender() noexcept { return {socket_, &sent_}; }
+
+  int socket_ = -1;
+  bool connected_ = false;
+  uint32_t sent_ = 0;
+  embedded::DatagramChannel channel_;
+};
+
+/// Device side: records what it receives and echoes every reliable message back reliably.
+struct Device {
+  embedded::UdpLink link;
+  std::vector<uint32_t> latest;
+  std::vector<uint32_t> reliable;
+  size_t peers = 0;
+
+  Device() {
+    link.SetPeerCallback([this] {
+      ++peers;
+      latest.clear();
+      reliable.clear();
+    });
+    link.SetFrameCallback([this](std::span<const uint8_t> message) {
+      if (message[0] == kLatestTag) {
+        latest.push_back(ValueOf(message));
+        return;
+      }
+      reliable.push_back(ValueOf(message));
+      CHECK_EQ(link.Send(embedded::FrameType::kResponse, message), embedded::UdpLinkError::kOk);
+    });
+  }
+};
+
+}  // namespace
+
+TEST_SUITE("embedded::UdpLink") {
+  TEST_CASE("UdpLink over loopback: MOVEs stay in order and configuration arrives exactly once despite loss") {
+    Device device;
+    REQUIRE_EQ(device.link.Open(0), embedded::UdpLinkError::kOk);
+    REQUIRE_NE(device.link.Port(), 0);
+    CHECK_EQ(device.link.Send(embedded::FrameType::kResponse, Message(kReliableTag, 0)),
+             embedded::UdpLinkError::kNoPeer);
+
+    TestClient client(device.link.Port(), 0x31);
+    REQUIRE(client.Connected());
+
+    // 500 MOVEs about a millisecond apart, with a configuration change every 25; a change that
+    // does not fit the reliable queue while a loss is being recovered is offered again later
+    constexpr uint32_t kMoves = 500;
+    constexpr uint32_t kConfigs = kMoves / 25;
+    uint32_t next_config = 0;
+    for (uint32_t i = 0; i < kMoves || next_config < kConfigs; ++i) {
+      if (i < kMoves) {
+        client.SendLatest(i);
+      }
+      if (next_config * 25 <= i && client.SendReliable(next_config)) {
+        ++next_config;
+      }
+      device.link.Poll(1);
+      client.Pump();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((client.echoes.size() < kConfigs || client.Channel().ReliablePending() != 0) &&
+           std::chrono::steady_clock::now() < deadline) {
+      device.link.Poll(embedded::UdpLink::kPollIntervalMs);
+      client.Pump();
+    }
+
+    CHECK(device.link.Connected());
+    CHECK_EQ(device.peers, 1U);
+
+    // Latest-wins: strictly increasing, about one in kDropEvery lost
+    CHECK(std::ranges::adjacent_find(device.latest, std::ranges::greater_equal{}) == device.latest.end());
+    CHECK_GT(device.latest.size(), kMoves * 8 / 10);
+    CHECK_LT(device.latest.size(), kMoves);
+    CHECK_EQ(device.link.Stats().received, device.latest.size());
+
+    // Reliable: exactly once and in order, both ways
+    std::vector<uint32_t> expected(kConfigs);
+    for (uint32_t i = 0; i < kConfigs; ++i) {
+      expected[i] = i;
+    }
+    CHECK_EQ(device.reliable, expected);
+    CHECK_EQ(client.echoes, expected);
+    CHECK_GT(client.Channel().Stats().retransmissions, 0U);
+  }
+
+  TEST_CASE("UdpLink over loopback: A restarted client is a new peer") {
+    Device device;
+    REQUIRE_EQ(device.link.Open(0), embedded::UdpLinkError::kOk);
+
+    size_t expected_peers = 0;
+    for (const uint8_t session : std::array<uint8_t, 2>{0x41, 0x42}) {
+      TestClient client(device.link.Port(), session);
+      REQUIRE(client.Connected());
+      client.SendLatest(100);
+      client.SendLatest(101);
+      ++expected_peers;
+      for (int i = 0; i < 10 && (device.peers < expected_peers || device.latest.size() < 2); ++i) {
+        device.link.Poll(embedded::UdpLink::kPollIntervalMs);
+      }
+      // Sequence numbers start over, so without the new session these would be dropped as late
+      CHECK((device.latest == std::vector<uint32_t>{100, 101}));
+    }
+    CHECK_EQ(device.peers, 2U);
+
+    device.link.Close();
+    CHECK_FALSE(device.link.Connected());
+    CHECK_EQ(device.link.Poll(0), embedded::UdpLinkError::kNotOpen);
+  }
+}
@@ -0,0 +1,85 @@
+#include <doctest/doctest.h>
+
+#include <command_ack.hpp>
+
+#include <cstdint>
+
+TEST_SUITE("embedded::CommandAck") {
+  TEST_CASE("AckWindow: Flushes after kFlushCount MOVEs") {
+    embedded::AckWindow window;
+    for (uint32_t i = 1; i < embedded::AckWindow::kFlushCount; ++i) {
+      CHECK_FALSE(window.Record(static_cast<uint8_t>(i), 0));
+    }
+    CHECK(window.Record(static_cast<uint8_t>(embedded::AckWindow::kFlushCount), 0));
+
+    embedded::WindowAck ack;
+    window.Take(ack);
+    CHECK_EQ(ack.status.sequence, embedded::AckWindow::kFlushCount);
+    CHECK_EQ(ack.received, 0x7FU);
+    CHECK_FALSE(window.Pending());
+  }
+
+  TEST_CASE("AckWindow: Flushes a partial window after kFlushIntervalMs") {
+    embedded::AckWindow window;
+    CHECK_FALSE(window.FlushDue(1000));
+
+    window.Record(1, 1000);
+    window.Record(2, 1030);
+    CHECK_FALSE(window.FlushDue(1000 + embedded::AckWindow::kFlushIntervalMs - 1));
+    CHECK(window.FlushDue(1000 + embedded::AckWindow::kFlushIntervalMs));
+  }
+
+  TEST_CASE("AckWindow: Leaves gaps for missing MOVEs and keeps history across acks") {
+    embedded::AckWindow window;
+    window.Record(10, 0);
+    window.Record(12, 0);  // 11 was coalesced or lost
+
+    embedded::WindowAck ack;
+    window.Take(ack);
+    CHECK_EQ(ack.status.sequence, 12);
+    CHECK_EQ(ack.received, 0x2U);
+
+    // 11 arrives late; the next ack still restates 10 and 12
+    window.Record(11, 0);
+    window.Record(13, 0);
+    window.Take(ack);
+    CHECK_EQ(ack.status.sequence, 13);
+    CHECK_EQ(ack.received, 0x7U);
+  }
+
+  TEST_CASE("AckWindow: Slides across the 8-bit sequence wrap") {
+    embedded::AckWindow window;
+    window.Record(254, 0);
+    window.Record(255, 0);
+    window.Record(1, 0);
+
+    embedded::WindowAck ack;
+    window.Take(ack);
+    CHECK_EQ(ack.status.sequence, 1);
+    CHECK_EQ(ack.received, 0x6U);
+
+    // A jump wider than the window forgets everything before it
+    window.Record(100, 0);
+    window.Take(ack);
+    CHECK_EQ(ack.status.sequence, 100);
+    CHECK_EQ(ack.received, 0U);
+  }
+
+  TEST_CASE("RecentCommands: Recognises repeats until displaced") {
+    embedded::RecentCommands recent;
+    CHECK_FALSE(recent.Contains(42));
+    recent.Insert(42);
+    CHECK(recent.Contains(42));
+
+    recent.Insert(0);
+    CHECK_FALSE(recent.Contains(0));
+
+    for (uint32_t id = 100; id < 100 + embedded::RecentCommands::kCapacity; ++id) {
+      recent.Insert(id);
+    }
+    CHECK_FALSE(recent.Contains(42));
+
+    recent.Reset();
+    CHECK_FALSE(recent.Contains(100));
+  }
+}
@@ -0,0 +1,113 @@
+#include <doctest/doctest.h>
+
+#include <compact_control.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace {
+
+// Golden vectors shared with client/tests/comm/unit/compact_codec.cpp
+constexpr std::array<uint8_t, 6> kGoldenMove = {0x2A, 0x00, 0xD2, 0x04, 0x0C, 0xFE};
+constexpr std::array<uint8_t, 10> kGoldenStatus = {0x07, 0x03, 0x64, 0x00, 0x9C, 0xFF, 0x28, 0x23, 0x6C, 0xEE};
+constexpr std::array<uint8_t, 14> kGoldenWindowAck = {0x07, 0x03, 0x64, 0x00, 0x9C, 0xFF, 0x28,
+                                                      0x23, 0x6C, 0xEE, 0x05, 0x00, 0x00, 0x80};
+
+}  // namespace
+
+TEST_SUITE("embedded::CompactControl") {
+  TEST_CASE("DecodeCompactMove: Decodes the client golden vector") {
+    embedded::CompactMove move;
+    REQUIRE(embedded::DecodeCompactMove(kGoldenMove, move));
+    CHECK_EQ(move.sequence, 0x2A);
+    CHECK_FALSE(move.has_velocity);
+    CHECK_EQ(move.pan, doctest::Approx(12.34F));
+    CHECK_EQ(move.tilt, doctest::Approx(-5.0F));
+
+    std::array<uint8_t, embedded::kCompactMoveWithVelocitySize> out{};
+    REQUIRE_EQ(embedded::EncodeCompactMove(move, out), kGoldenMove.size());
+    CHECK(std::ranges::equal(std::span(out).first(kGoldenMove.size()), kGoldenMove));
+  }
+
+  TEST_CASE("DecodeCompactMove: Round-trips velocity and rejects inconsistent sizes") {
+    embedded::CompactMove move;
+    move.pan = -30.25F;
+    move.tilt = 10.5F;
+    move.pan_velocity = 120.0F;
+    move.tilt_velocity = -45.5F;
+    move.has_velocity = true;
+    move.sequence = 255;
+
+    std::array<uint8_t, embedded::kCompactMoveWithVelocitySize> out{};
+    REQUIRE_EQ(embedded::EncodeCompactMove(move, out), embedded::kCompactMoveWithVelocitySize);
+
+    embedded::CompactMove decoded;
+    REQUIRE(embedded::DecodeCompactMove(out, decoded));
+    CHECK_EQ(decoded.pan, move.pan);
+    CHECK_EQ(decoded.tilt_velocity, move.tilt_velocity);
+    CHECK(decoded.has_velocity);
+
+    CHECK_FALSE(embedded::DecodeCompactMove(std::span<const uint8_t>(out).first(embedded::kCompactMoveSize), decoded));
+    CHECK_FALSE(embedded::DecodeCompactMove(std::span<const uint8_t>(out).first(5), decoded));
+
+    std::array<uint8_t, 4> small{};
+    CHECK_EQ(embedded::EncodeCompactMove(move, small), 0U);
+  }
+
+  TEST_CASE("EncodeCompactStatus: Matches the client golden vector") {
+    embedded::CompactStatus status;
+    status.pan = 1.0F;
+    status.tilt = -1.0F;
+    status.target_pan = 90.0F;
+    status.target_tilt = -45.0F;
+    status.sequence = 7;
+    status.moving = true;
+    status.calibrated = true;
+
+    std::array<uint8_t, embedded::kCompactStatusSize> out{};
+    REQUIRE_EQ(embedded::EncodeCompactStatus(status, out), embedded::kCompactStatusSize);
+    CHECK(std::ranges::equal(out, kGoldenStatus));
+
+    embedded::CompactStatus decoded;
+    REQUIRE(embedded::DecodeCompactStatus(kGoldenStatus, decoded));
+    CHECK_EQ(decoded.target_tilt, -45.0F);
+    CHECK(decoded.moving);
+    CHECK_FALSE(decoded.rejected);
+  }
+
+  TEST_CASE("EncodeCompactStatus: Saturates out-of-range angles") {
+    embedded::CompactStatus status;
+    status.pan = 1000.0F;
+    status.tilt = -1000.0F;
+
+    std::array<uint8_t, embedded::kCompactStatusSize> out{};
+    REQUIRE_EQ(embedded::EncodeCompactStatus(status, out), embedded::kCompactStatusSize);
+
+    embedded::CompactStatus decoded;
+    REQUIRE(embedded::DecodeCompactStatus(out, decoded));
+    CHECK_EQ(decoded.pan, doctest::Approx(327.67F));
+    CHECK_EQ(decoded.tilt, doctest::Approx(-327.68F));
+  }
+
+  TEST_CASE("EncodeWindowAck: Matches the client golden vector") {
+    embedded::WindowAck ack;
+    REQUIRE(embedded::DecodeCompactStatus(kGoldenStatus, ack.status));
+    ack.received = 0x80000005;
+
+    std::array<uint8_t, embedded::kWindowAckSize> out{};
+    REQUIRE_EQ(embedded::EncodeWindowAck(ack, out), embedded::kWindowAckSize);
+    CHECK(std::ranges::equal(out, kGoldenWindowAck));
+
+    embedded::WindowAck decoded;
+    REQUIRE(embedded::DecodeWindowAck(kGoldenWindowAck, decoded));
+    CHECK_EQ(decoded.status.sequence, 7);
+    CHECK_EQ(decoded.received, 0x80000005U);
+    CHECK_FALSE(embedded::DecodeWindowAck(kGoldenStatus, decoded));
+
+    std::array<uint8_t, embedded::kCompactStatusSize> small{};
+    CHECK_EQ(embedded::EncodeWindowAck(ack, small), 0U);
+  }
+}
@@ -0,0 +1,143 @@
+#include <doctest/doctest.h>
+
+#include <datagram_channel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Golden vector shared with client/tests/comm/unit/datagram_channel.cpp
+constexpr std::array<uint8_t, 10> kGoldenHeader = {0x02, 0xA5, 0x04, 0x03, 0x02, 0x01, 0xFE, 0xFF, 0xFF, 0xFF};
+
+using Datagram = std::vector<uint8_t>;
+
+struct Endpoint {
+  embedded::DatagramChannel channel;
+  std::vector<Datagram> sent;
+  std::vector<Datagram> delivered;
+
+  explicit Endpoint(uint8_t session) : channel(session) {}
+
+  auto Sender() {
+    return [this](std::span<const uint8_t> datagram) { sent.emplace_back(datagram.begin(), datagram.end()); };
+  }
+
+  bool Receive(const Datagram& datagram, uint32_t now_us) {
+    const auto deliver = [this](std::span<const uint8_t> frame) { delivered.emplace_back(frame.begin(), frame.end()); };
+    return channel.Receive(datagram, now_us, deliver, Sender());
+  }
+
+  void DeliverTo(Endpoint& peer, uint32_t now_us) {
+    auto in_transit = std::move(sent);
+    sent.clear();
+    for (const auto& datagram : in_transit) {
+      peer.Receive(datagram, now_us);
+    }
+  }
+};
+
+}  // namespace
+
+TEST_SUITE("embedded::DatagramChannel") {
+  TEST_CASE("DatagramHeader: Matches the client golden vector") {
+    embedded::DatagramHeader header;
+    REQUIRE(embedded::DecodeDatagramHeader(kGoldenHeader, header));
+    CHECK_EQ(header.kind, embedded::DatagramKind::kReliable);
+    CHECK_EQ(header.session, 0xA5);
+    CHECK_EQ(header.sequence, 0x01020304U);
+    CHECK_EQ(header.timestamp_us, 0xFFFFFFFEU);
+
+    std::array<uint8_t, embedded::kDatagramHeaderSize> out{};
+    embedded::EncodeDatagramHeader(header, out);
+    CHECK(std::ranges::equal(out, kGoldenHeader));
+
+    CHECK_FALSE(embedded::DecodeDatagramHeader(std::span(kGoldenHeader).first(9), header));
+    out[0] = 0x04;
+    CHECK_FALSE(embedded::DecodeDatagramHeader(out, header));
+  }
+
+  TEST_CASE("DatagramKindFor: Compact control is latest-wins") {
+    CHECK_EQ(embedded::DatagramKindFor(embedded::FrameType::kCompact), embedded::DatagramKind::kLatest);
+    CHECK_EQ(embedded::DatagramKindFor(embedded::FrameType::kWindowAck), embedded::DatagramKind::kLatest);
+    CHECK_EQ(embedded::DatagramKindFor(embedded::FrameType::kResponse), embedded::DatagramKind::kReliable);
+    CHECK_EQ(embedded::DatagramKindFor(embedded::FrameType::kHandshake), embedded::DatagramKind::kReliable);
+  }
+
+  TEST_CASE("DatagramChannel: Latest-wins drops late and duplicate datagrams") {
+    Endpoint sender(1);
+    Endpoint receiver(2);
+    for (uint8_t i = 0; i < 4; ++i) {
+      CHECK(sender.channel.SendLatest(std::array<uint8_t, 1>{i}, 0, sender.Sender()));
+    }
+
+    for (const size_t index : {0U, 2U, 1U, 2U, 3U}) {
+      CHECK(receiver.Receive(sender.sent[index], 0));
+    }
+    CHECK((receiver.delivered == std::vector<Datagram>{{0}, {2}, {3}}));
+
+    const auto& stats = receiver.channel.Stats();
+    CHECK_EQ(stats.received, 3U);
+    CHECK_EQ(stats.lost, 1U);
+    CHECK_EQ(stats.late, 1U);
+    CHECK_EQ(stats.duplicates, 1U);
+  }
+
+  TEST_CASE("DatagramChannel: Reliable datagrams survive loss and arrive in order") {
+    Endpoint sender(1);
+    Endpoint receiver(2);
+    for (uint8_t i = 0; i < 3; ++i) {
+      CHECK(sender.channel.SendReliable(std::array<uint8_t, 1>{i}, 0, sender.Sender()));
+    }
+    CHECK_EQ(sender.sent.size(), 1U);
+    sender.DeliverTo(receiver, 0);
+    receiver.DeliverTo(sender, 0);
+
+    // The acknowledgement opened the window; lose the first of the two now in flight
+    REQUIRE_EQ(sender.sent.size(), 2U);
+    receiver.Receive(sender.sent[1], 0);
+    sender.sent.clear();
+    receiver.sent.clear();
+
+    CHECK_EQ(sender.channel.PollRetransmits(embedded::DatagramChannel::kInitialTimeoutUs - 1, sender.Sender()), 0U);
+    CHECK_EQ(sender.channel.PollRetransmits(embedded::DatagramChannel::kInitialTimeoutUs, sender.Sender()), 2U);
+    sender.DeliverTo(receiver, 0);
+    receiver.DeliverTo(sender, 0);
+
+    CHECK((receiver.delivered == std::vector<Datagram>{{0}, {1}, {2}}));
+    CHECK_EQ(sender.channel.ReliablePending(), 0U);
+    CHECK_EQ(sender.channel.Stats().retransmissions, 2U);
+  }
+
+  TEST_CASE("DatagramChannel: Bounds the reliable queue without allocating") {
+    Endpoint sender(1);
+    for (size_t i = 0; i < embedded::DatagramChannel::kMaxQueued; ++i) {
+      CHECK(sender.channel.SendReliable(std::array<uint8_t, 1>{1}, 0, sender.Sender()));
+    }
+    CHECK_FALSE(sender.channel.SendReliable(std::array<uint8_t, 1>{1}, 0, sender.Sender()));
+
+    const std::vector<uint8_t> oversized(embedded::kMaxDatagramFrameSize + 1);
+    CHECK_FALSE(sender.channel.SendLatest(oversized, 0, sender.Sender()));
+  }
+
+  TEST_CASE("DatagramChannel: A restarted peer starts a fresh stream") {
+    Endpoint sender(1);
+    Endpoint receiver(2);
+    for (uint8_t i = 0; i < 3; ++i) {
+      CHECK(sender.channel.SendLatest(std::array<uint8_t, 1>{i}, 0, sender.Sender()));
+    }
+    sender.DeliverTo(receiver, 0);
+    CHECK_EQ(receiver.channel.PeerSession(), 1);
+
+    sender.channel.Reset(9);
+    CHECK(sender.channel.SendLatest(std::array<uint8_t, 1>{7}, 0, sender.Sender()));
+    sender.DeliverTo(receiver, 0);
+    CHECK_EQ(receiver.delivered.size(), 4U);
+    CHECK_EQ(receiver.channel.PeerSession(), 9);
+    CHECK_EQ(receiver.channel.Stats().late, 0U);
+  }
+}
@@ -0,0 +1,164 @@
+#include <doctest/doctest.h>
+
+#include <motion_profile.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using embedded::MotionLimits;
+using embedded::MotionProfile;
+using embedded::MotionState;
+
+constexpr float kDt = 0.02F;  ///< Servo task period.
+
+/// Extremes seen while stepping a profile.
+struct Extremes {
+  float velocity = 0.0F;
+  float acceleration = 0.0F;
+  float jerk = 0.0F;
+  float velocity_step = 0.0F;  ///< Largest velocity change between steps.
+  float time = 0.0F;           ///< Time until the profile finished.
+};
+
+/// Steps @p profile until it finishes (or @p timeout seconds pass), recording the extremes.
+Extremes RunToRest(MotionProfile& profile, float dt = kDt, float timeout = 5.0F) {
+  Extremes extremes;
+  MotionState previous = profile.State();
+  while (!profile.Done() && extremes.time < timeout) {
+    const MotionState& state = profile.Step(dt);
+    extremes.velocity = std::max(extremes.velocity, std::abs(state.velocity));
+    extremes.acceleration = std::max(extremes.acceleration, std::abs(state.acceleration));
+    extremes.jerk = std::max(extremes.jerk, std::abs(state.acceleration - previous.acceleration) / dt);
+    extremes.velocity_step = std::max(extremes.velocity_step, std::abs(state.velocity - previous.velocity));
+    extremes.time += dt;
+    previous = state;
+  }
+  return extremes;
+}
+
+}  // namespace
+
+TEST_SUITE("embedded::MotionProfile") {
+  TEST_CASE("Trapezoid: Cruises at the velocity limit and lands on the target") {
+    MotionProfile profile({.max_velocity = 100.0F, .max_acceleration = 500.0F, .max_jerk = 0.0F});
+    profile.SetTarget(60.0F);
+
+    float furthest = 0.0F;
+    float time = 0.0F;
+    while (!profile.Done() && time < 5.0F) {
+      furthest = std::max(furthest, profile.Step(kDt).position);
+      time += kDt;
+      CHECK_LE(std::abs(profile.State().velocity), doctest::Approx(100.0F));
+      CHECK_LE(std::abs(profile.State().acceleration), doctest::Approx(500.0F));
+    }
+
+    REQUIRE(profile.Done());
+    CHECK_EQ(profile.State().position, 60.0F);
+    CHECK_EQ(profile.State().velocity, 0.0F);
+    CHECK_LE(furthest, 60.0F);
+    // 0.2 s each way at 500 deg/s^2 covers 20 degrees; the other 40 take 0.4 s at 100 deg/s
+    CHECK_EQ(time, doctest::Approx(0.8F).epsilon(0.05));
+  }
+
+  TEST_CASE("S-curve: Respects velocity, acceleration and jerk limits without overshoot") {
+    const MotionLimits limits{.max_velocity = 300.0F, .max_acceleration = 1500.0F, .max_jerk = 15000.0F};
+    for (const float dt : {0.001F, 0.02F, 0.033F}) {
+      INFO("dt = " << dt);
+      MotionProfile profile(limits);
+      profile.Reset(10.0F);
+      profile.SetTarget(-80.0F);
+
+      const Extremes extremes = RunToRest(profile, dt);
+      REQUIRE(profile.Done());
+      CHECK_EQ(profile.State().position, -80.0F);
+      CHECK_LE(extremes.velocity, doctest::Approx(limits.max_velocity));
+      CHECK_LE(extremes.acceleration, doctest::Approx(limits.max_acceleration));
+      CHECK_LE(extremes.jerk, doctest::Approx(limits.max_jerk));
+      CHECK_LT(extremes.time, 0.7F);
+    }
+  }
+
+  TEST_CASE("S-curve: Short moves never reach the limits") {
+    MotionProfile profile;
+    profile.SetTarget(2.0F);
+
+    const Extremes extremes = RunToRest(profile);
+    REQUIRE(profile.Done());
+    CHECK_EQ(profile.State().position, 2.0F);
+    CHECK_LT(extremes.acceleration, profile.Limits().max_acceleration);
+    CHECK_LT(extremes.velocity, profile.Limits().max_velocity);
+  }
+
+  TEST_CASE("Replanning: A new target mid-move bends the motion without a velocity jump") {
+    const MotionLimits limits{.max_velocity = 300.0F, .max_acceleration = 1500.0F, .max_jerk = 15000.0F};
+    MotionProfile profile(limits);
+    profile.SetTarget(60.0F);
+    for (int i = 0; i < 5; ++i) {
+      (void)profile.Step(kDt);
+    }
+    REQUIRE_GT(profile.State().velocity, 50.0F);
+
+    // Behind the axis: it has to brake, reverse and come back
+    profile.SetTarget(-20.0F);
+    const Extremes extremes = RunToRest(profile);
+    REQUIRE(profile.Done());
+    CHECK_EQ(profile.State().position, -20.0F);
+    CHECK_LE(extremes.jerk, doctest::Approx(limits.max_jerk));
+    CHECK_LE(extremes.velocity_step, doctest::Approx(limits.max_acceleration * kDt));
+  }
+
+  TEST_CASE("Replanning: Lands on targets that keep changing at irregular intervals") {
+    MotionProfile profile({.max_velocity = 200.0F, .max_acceleration = 1000.0F, .max_jerk = 8000.0F});
+    const float targets[] = {30.0F, 35.0F, -10.0F, -12.5F, 40.0F};
+    const float steps[] = {0.004F, 0.017F, 0.009F, 0.031F, 0.012F};
+    int step = 0;
+    for (const float target : targets) {
+      profile.SetTarget(target);
+      for (int i = 0; i < 7; ++i) {
+        (void)profile.Step(steps[step++ % 5]);
+      }
+    }
+
+    const float stop = profile.StoppingPosition();
+    (void)RunToRest(profile, 0.013F);
+    REQUIRE(profile.Done());
+    CHECK_EQ(profile.State().position, 40.0F);
+    CHECK_LE(stop, 40.0F);
+  }
+
+  TEST_CASE("Limits: Lowering the velocity limit mid-move slows the axis down") {
+    MotionProfile profile({.max_velocity = 300.0F, .max_acceleration = 1500.0F, .max_jerk = 15000.0F});
+    profile.SetTarget(90.0F);
+    for (int i = 0; i < 15; ++i) {
+      (void)profile.Step(kDt);
+    }
+    REQUIRE_GT(profile.State().velocity, 100.0F);
+
+    profile.SetLimits({.max_velocity = 50.0F, .max_acceleration = 1500.0F, .max_jerk = 15000.0F});
+    for (int i = 0; i < 25 && !profile.Done(); ++i) {
+      (void)profile.Step(kDt);
+    }
+    CHECK_LE(profile.State().velocity, doctest::Approx(50.0F));
+    (void)RunToRest(profile);
+    CHECK_EQ(profile.State().position, 90.0F);
+  }
+
+  TEST_CASE("Reset: Abandons the move and ignores non-positive steps") {
+    MotionProfile profile;
+    profile.SetTarget(45.0F);
+    (void)profile.Step(kDt);
+    CHECK_FALSE(profile.Done());
+
+    profile.Reset(12.0F);
+    CHECK(profile.Done());
+    CHECK_EQ(profile.Target(), 12.0F);
+    CHECK_EQ(profile.Step(kDt).position, 12.0F);
+
+    profile.SetTarget(20.0F);
+    CHECK_EQ(profile.Step(0.0F).position, 12.0F);
+    CHECK_EQ(profile.Step(-kDt).position, 12.0F);
+    CHECK_GT(profile.Step(kDt).position, 12.0F);
+  }
+}
@@ -0,0 +1,165 @@
+#include <doctest/doctest.h>
+
+#include <packet_ring.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// A packet whose bytes all derive from its sequence number, so a mixed-up packet shows.
+[[nodiscard]] std::vector<uint8_t> MakePacket(uint32_t sequence, size_t size) {
+  std::vector<uint8_t> packet(size);
+  for (size_t i = 0; i < size; ++i) {
+    packet[i] = static_cast<uint8_t>(sequence * 31U + i);
+  }
+  return packet;
+}
+
+[[nodiscard]] bool Matches(std::span<const uint8_t> packet, uint32_t sequence) {
+  for (size_t i = 0; i < packet.size(); ++i) {
+    if (packet[i] != static_cast<uint8_t>(sequence * 31U + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST_SUITE("embedded::PacketRing") {
+  TEST_CASE("Keeps packet boundaries and order across the wrap") {
+    embedded::PacketRing<64, 16> ring;
+    std::array<uint8_t, 16> out{};
+    CHECK_FALSE(ring.Pop(out).has_value());
+
+    // 13 packets of 2 + 0..12 bytes run past the end of the storage
+    for (uint32_t sequence = 0; sequence < 13; ++sequence) {
+      const auto packet = MakePacket(sequence, sequence);
+      REQUIRE(ring.Push(packet));
+      if (sequence % 2 == 1) {
+        continue;  // Hold every other packet, so two sit in the ring at once
+      }
+      for (uint32_t expected = sequence == 0 ? 0 : sequence - 1; expected <= sequence; ++expected) {
+        const auto size = ring.Pop(out);
+        REQUIRE(size.has_value());
+        CHECK_EQ(*size, expected);
+        CHECK(Matches(std::span<const uint8_t>(out.data(), *size), expected));
+      }
+    }
+    CHECK(ring.Empty());
+    CHECK_EQ(ring.Stats().pushed, 13U);
+    CHECK_EQ(ring.Stats().rejected, 0U);
+  }
+
+  TEST_CASE("Drops a packet whole when it does not fit and counts it") {
+    embedded::PacketRing<32, 16> ring;
+    std::array<uint8_t, 16> out{};
+
+    REQUIRE(ring.Push(MakePacket(1, 16)));  // 18 of 32 bytes
+    CHECK_FALSE(ring.Push(MakePacket(2, 13)));
+    REQUIRE(ring.Push(MakePacket(3, 12)));  // Exactly full
+    CHECK_FALSE(ring.Push({}));
+    CHECK_FALSE(ring.Push(MakePacket(4, 17)));  // Larger than any packet
+
+    const auto stats = ring.Stats();
+    CHECK_EQ(stats.pushed, 2U);
+    CHECK_EQ(stats.rejected, 3U);
+    CHECK_EQ(stats.rejected_bytes, 30U);
+    CHECK_EQ(stats.high_water, 32U);
+
+    // What was queued comes out intact; the gap is where the dropped packets were
+    auto size = ring.Pop(out);
+    REQUIRE(size.has_value());
+    CHECK_EQ(*size, 16U);
+    CHECK(Matches(std::span<const uint8_t>(out.data(), *size), 1));
+    size = ring.Pop(out);
+    REQUIRE(size.has_value());
+    CHECK_EQ(*size, 12U);
+    CHECK(Matches(std::span<const uint8_t>(out.data(), *size), 3));
+
+    // An empty packet is a packet too
+    REQUIRE(ring.Push({}));
+    size = ring.Pop(out);
+    REQUIRE(size.has_value());
+    CHECK_EQ(*size, 0U);
+  }
+
+  TEST_CASE("Push returns in bounded time while a stalled consumer is flooded") {
+    // Sized as the firmware's Bluetooth ingress: a 4 KiB ring of data events up to one RFCOMM MTU
+    embedded::PacketRing<4096, 1024> ring;
+    constexpr uint32_t kPackets = 100000;
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> corrupt{0};
+    std::atomic<uint32_t> reordered{0};
+    std::atomic<uint32_t> received{0};
+
+    // The consumer stalls now and then, as the command task does while it calibrates
+    std::thread consumer([&] {
+      std::array<uint8_t, 1024> out{};
+      uint32_t last = 0;
+      bool first = true;
+      while (true) {
+        const bool finished = done.load(std::memory_order_acquire);
+        const auto size = ring.Pop(out);
+        if (!size) {
+          if (finished) {
+            break;
+          }
+          std::this_thread::yield();
+          continue;
+        }
+        const uint32_t sequence = static_cast<uint32_t>(out[0]) | (static_cast<uint32_t>(out[1]) << 8U) |
+                                  (static_cast<uint32_t>(out[2]) << 16U);
+        if (!Matches(std::span<const uint8_t>(out.data() + 3, *size - 3), sequence)) {
+          corrupt.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (!first && sequence <= last) {
+          reordered.fetch_add(1, std::memory_order_relaxed);
+        }
+        first = false;
+        last = sequence;
+        if (received.fetch_add(1, std::memory_order_relaxed) % 1000 == 999) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+      }
+    });
+
+    Clock::duration longest{};
+    for (uint32_t sequence = 0; sequence < kPackets; ++sequence) {
+      // 3-byte sequence number, then a body derived from it
+      std::vector<uint8_t> packet = {static_cast<uint8_t>(sequence), static_cast<uint8_t>(sequence >> 8U),
+                                     static_cast<uint8_t>(sequence >> 16U)};
+      const auto body = MakePacket(sequence, sequence % 200);
+      packet.insert(packet.end(), body.begin(), body.end());
+
+      const auto start = Clock::now();
+      (void)ring.Push(packet);
+      longest = std::max(longest, Clock::now() - start);
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    const auto stats = ring.Stats();
+    const auto longest_us = std::chrono::duration_cast<std::chrono::microseconds>(longest).count();
+    MESSAGE(stats.pushed << " packets queued, " << stats.rejected << " dropped, longest push " << longest_us
+                         << " us, high water " << stats.high_water << " bytes");
+    CHECK_EQ(stats.pushed + stats.rejected, kPackets);
+    CHECK_GT(stats.rejected, 0U);  // The flood did outrun the consumer
+    CHECK_EQ(received.load(), stats.pushed);
+    CHECK_EQ(corrupt.load(), 0U);
+    CHECK_EQ(reordered.load(), 0U);
+    CHECK_LE(stats.high_water, 4096U);
+    // A push that waited for the consumer would take one of its 20 ms stalls; a copy takes microseconds
+    CHECK_LT(longest_us, 10000);
+  }
+}
@@ -0,0 +1,134 @@
+#include <doctest/doctest.h>
+
+#include <loop_timing.hpp>
+#include <mailbox.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using embedded::LoopTiming;
+using embedded::Mailbox;
+
+/// Every field holds the same counter, so a torn read shows up as a mismatch.
+struct Sample {
+  uint32_t a = 0;
+  float b = 0.0F;
+  uint64_t c = 0;
+  uint8_t d = 0;
+};
+
+[[nodiscard]] Sample MakeSample(uint32_t counter) {
+  return {.a = counter, .b = static_cast<float>(counter), .c = counter, .d = static_cast<uint8_t>(counter)};
+}
+
+[[nodiscard]] bool Consistent(const Sample& sample) {
+  return static_cast<float>(sample.a) == sample.b && sample.a == sample.c && static_cast<uint8_t>(sample.a) == sample.d;
+}
+
+}  // namespace
+
+TEST_SUITE("embedded::Mailbox") {
+  TEST_CASE("Holds the latest value and counts stores") {
+    Mailbox<Sample> mailbox(MakeSample(7));
+    CHECK_EQ(mailbox.Version(), 0U);
+    CHECK_EQ(mailbox.Load().a, 7U);
+
+    mailbox.Store(MakeSample(8));
+    mailbox.Store(MakeSample(9));
+    CHECK_EQ(mailbox.Version(), 2U);
+
+    Sample sample;
+    uint32_t version = 0;
+    REQUIRE(mailbox.TryLoad(sample, version));
+    CHECK_EQ(version, 2U);
+    CHECK_EQ(sample.a, 9U);
+    CHECK(Consistent(sample));
+  }
+
+  TEST_CASE("Readers never see a torn value while a writer stores concurrently") {
+    Mailbox<Sample> mailbox;
+    constexpr uint32_t kStores = 200000;
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> torn{0};
+    std::atomic<uint32_t> backwards{0};
+    std::atomic<uint64_t> reads{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+      readers.emplace_back([&] {
+        uint32_t last = 0;
+        while (!done.load(std::memory_order_acquire)) {
+          const Sample sample = mailbox.Load();
+          if (!Consistent(sample)) {
+            torn.fetch_add(1, std::memory_order_relaxed);
+          }
+          if (sample.a < last) {
+            backwards.fetch_add(1, std::memory_order_relaxed);
+          }
+          last = sample.a;
+          reads.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    }
+
+    for (uint32_t counter = 1; counter <= kStores; ++counter) {
+      mailbox.Store(MakeSample(counter));
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+      reader.join();
+    }
+
+    MESSAGE(reads.load() << " concurrent reads of " << kStores << " stores");
+    CHECK_GT(reads.load(), 0U);
+    CHECK_EQ(torn.load(), 0U);
+    CHECK_EQ(backwards.load(), 0U);
+    CHECK_EQ(mailbox.Version(), kStores);
+    CHECK_EQ(mailbox.Load().a, kStores);
+  }
+}
+
+TEST_SUITE("embedded::LoopTiming") {
+  TEST_CASE("Reports the period, jitter and missed ticks") {
+    LoopTiming timing(250);
+    CHECK_EQ(timing.PeriodUs(), 4000U);
+    CHECK_EQ(timing.Stats().rate_hz, 250U);
+
+    // The first update has no previous one and runs a nominal period
+    CHECK_EQ(timing.Tick(1000000), 4000U);
+    CHECK_EQ(timing.Tick(1004000), 4000U);
+    CHECK_EQ(timing.Stats().jitter_us, 0U);
+
+    CHECK_EQ(timing.Tick(1008300), 4300U);
+    CHECK_EQ(timing.Tick(1011900), 3600U);
+    CHECK_EQ(timing.Stats().max_jitter_us, 400U);
+    CHECK_GT(timing.Stats().jitter_us, 0U);
+    CHECK_EQ(timing.Stats().overruns, 0U);
+
+    // Two periods in one: a tick was missed
+    CHECK_EQ(timing.Tick(1019900), 8000U);
+    CHECK_EQ(timing.Stats().overruns, 1U);
+    CHECK_EQ(timing.Stats().max_jitter_us, 4000U);
+    CHECK_EQ(timing.Stats().updates, 5U);
+
+    timing.Busy(120);
+    timing.Busy(80);
+    CHECK_EQ(timing.Stats().max_busy_us, 120U);
+  }
+
+  TEST_CASE("The jitter estimate converges on a steady deviation") {
+    LoopTiming timing(200);
+    int64_t now = 0;
+    for (int i = 0; i < 200; ++i) {
+      // Alternately 100 us early and late
+      now += i % 2 == 0 ? 4900 : 5100;
+      (void)timing.Tick(now);
+    }
+    CHECK_EQ(timing.Stats().jitter_us, doctest::Approx(100.0).epsilon(0.05));
+    CHECK_EQ(timing.Stats().max_jitter_us, 100U);
+  }
+}
@@ -0,0 +1,183 @@
+#include <doctest/doctest.h>
+
+#include <link_model.hpp>
+#include <servo_model.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+using embedded::sim::LinkConfig;
+using embedded::sim::LinkModel;
+using embedded::sim::ServoModel;
+using embedded::sim::ServoModelConfig;
+
+[[nodiscard]] std::vector<uint8_t> Bytes(size_t count, uint8_t first = 0) {
+  std::vector<uint8_t> bytes(count);
+  std::iota(bytes.begin(), bytes.end(), first);
+  return bytes;
+}
+
+/// Drains every packet due by @p now_us and concatenates them.
+[[nodiscard]] std::vector<uint8_t> DrainDue(LinkModel& link, int64_t now_us) {
+  std::vector<uint8_t> received;
+  while (auto packet = link.PopDue(now_us)) {
+    received.insert(received.end(), packet->data.begin(), packet->data.end());
+  }
+  return received;
+}
+
+}  // namespace
+
+TEST_SUITE("embedded::sim::LinkModel") {
+  TEST_CASE("Ideal link: Delivers immediately") {
+    LinkModel link;
+    const auto data = Bytes(16);
+
+    CHECK_EQ(link.Push(data, 1000), 1000);
+    CHECK_EQ(DrainDue(link, 1000), data);
+    CHECK_FALSE(link.NextDelivery().has_value());
+  }
+
+  TEST_CASE("Latency: Holds packets until they arrive") {
+    LinkConfig config;
+    config.latency_us = 20'000;
+    LinkModel link(config);
+    const auto data = Bytes(8);
+
+    link.Push(data, 0);
+    CHECK_EQ(link.BytesInFlight(), data.size());
+    CHECK(DrainDue(link, 19'999).empty());
+    REQUIRE(link.NextDelivery().has_value());
+    CHECK_EQ(*link.NextDelivery(), 20'000);
+    CHECK_EQ(DrainDue(link, 20'000), data);
+    CHECK_EQ(link.BytesInFlight(), 0U);
+  }
+
+  TEST_CASE("Bandwidth: Serializes back-to-back writes") {
+    LinkConfig config;
+    config.bytes_per_second = 10'000;  // 100 us per byte
+    LinkModel link(config);
+
+    CHECK_EQ(link.Push(Bytes(10), 0), 1'000);
+    CHECK_EQ(link.Push(Bytes(10), 0), 2'000);     // Queued behind the first write
+    CHECK_EQ(link.Push(Bytes(10), 5'000), 6'000);  // Transmitter idle again
+  }
+
+  TEST_CASE("MTU: Splits writes into packets") {
+    LinkConfig config;
+    config.mtu = 4;
+    LinkModel link(config);
+    const auto data = Bytes(10);
+
+    link.Push(data, 0);
+    std::vector<size_t> sizes;
+    while (auto packet = link.PopDue(0)) {
+      sizes.push_back(packet->data.size());
+    }
+    const std::vector<size_t> expected = {4, 4, 2};
+    CHECK_EQ(sizes, expected);
+  }
+
+  TEST_CASE("Jitter: Never reorders bytes") {
+    LinkConfig config;
+    config.latency_us = 1'000;
+    config.jitter_us = 5'000;
+    config.mtu = 3;
+    LinkModel link(config);
+
+    std::vector<uint8_t> sent;
+    int64_t previous_delivery = 0;
+    for (uint8_t i = 0; i < 50; ++i) {
+      const auto data = Bytes(5, static_cast<uint8_t>(i * 5));
+      sent.insert(sent.end(), data.begin(), data.end());
+      const int64_t delivery = link.Push(data, i * 100);
+      CHECK_GE(delivery, previous_delivery);
+      CHECK_LE(delivery - i * 100, 1'000 + 5'000 + 5'000);
+      previous_delivery = delivery;
+    }
+    CHECK_EQ(DrainDue(link, previous_delivery), sent);
+  }
+
+  TEST_CASE("Jitter: Same seed replays the same delays") {
+    LinkConfig config;
+    config.jitter_us = 10'000;
+    config.seed = 42;
+    LinkModel first(config);
+    LinkModel second(config);
+
+    for (int64_t t = 0; t < 100'000; t += 10'000) {
+      CHECK_EQ(first.Push(Bytes(1), t), second.Push(Bytes(1), t));
+    }
+  }
+
+  TEST_CASE("Clear: Drops packets in flight") {
+    LinkConfig config;
+    config.latency_us = 1'000;
+    LinkModel link(config);
+
+    link.Push(Bytes(32), 0);
+    link.Clear();
+    CHECK_EQ(link.BytesInFlight(), 0U);
+    CHECK(DrainDue(link, 10'000).empty());
+  }
+}
+
+TEST_SUITE("embedded::sim::ServoModel") {
+  TEST_CASE("PulseToAngle: Maps the ServoConfig pulse range") {
+    const ServoModel servo;
+    CHECK_EQ(servo.PulseToAngle(500), doctest::Approx(-90.0F));
+    CHECK_EQ(servo.PulseToAngle(1500), doctest::Approx(0.0F));
+    CHECK_EQ(servo.PulseToAngle(2500), doctest::Approx(90.0F));
+    CHECK_EQ(servo.PulseToAngle(2000), doctest::Approx(45.0F));
+  }
+
+  TEST_CASE("SetPulse: Takes effect at the next PWM period") {
+    ServoModel servo;
+    servo.SetPulse(2500, 5'000);
+
+    CHECK_EQ(servo.Commanded(), doctest::Approx(90.0F));
+    CHECK_EQ(servo.Position(19'999), doctest::Approx(0.0F));
+    CHECK_EQ(servo.Position(20'000), doctest::Approx(0.0F));
+    CHECK_GT(servo.Position(30'000), 0.0F);
+  }
+
+  TEST_CASE("SetPulse: Moves at the slew rate") {
+    ServoModelConfig config;
+    config.slew_deg_per_s = 100.0F;
+    ServoModel servo(config);
+    servo.SetPulse(2500, 0);  // Latched at 20 ms
+
+    CHECK_EQ(servo.Position(120'000), doctest::Approx(10.0F));
+    CHECK_EQ(servo.Position(520'000), doctest::Approx(50.0F));
+    CHECK_EQ(servo.Position(920'000), doctest::Approx(90.0F));
+    CHECK_EQ(servo.Position(2'000'000), doctest::Approx(90.0F));
+  }
+
+  TEST_CASE("SetPulse: Retargets from the current position") {
+    ServoModelConfig config;
+    config.slew_deg_per_s = 100.0F;
+    ServoModel servo(config);
+    servo.SetPulse(2500, 0);
+    servo.SetPulse(500, 200'000);  // Latched at 220 ms, +20 degrees, heading back to -90
+
+    CHECK_EQ(servo.Position(210'000), doctest::Approx(19.0F));
+    CHECK_EQ(servo.Position(220'000), doctest::Approx(20.0F));
+    CHECK_EQ(servo.Position(320'000), doctest::Approx(10.0F));
+    CHECK_EQ(servo.Position(2'000'000), doctest::Approx(-90.0F));
+  }
+
+  TEST_CASE("SetPulse: Within one period only the last write is latched") {
+    ServoModelConfig config;
+    config.slew_deg_per_s = 100.0F;
+    ServoModel servo(config);
+    servo.SetPulse(2500, 1'000);
+    servo.SetPulse(1000, 10'000);  // Replaces the pending +90 before it takes effect
+
+    CHECK_EQ(servo.Commanded(), doctest::Approx(-45.0F));
+    CHECK_EQ(servo.Position(120'000), doctest::Approx(-10.0F));
+  }
+}
@@ -0,0 +1,135 @@
+#include <doctest/doctest.h>
+
+#include <spp_framing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+struct ReceivedFrame {
+  embedded::FrameType type;
+  std::vector<uint8_t> payload;
+};
+
+[[nodiscard]] std::vector<uint8_t> Encode(embedded::FrameType type, std::span<const uint8_t> payload) {
+  std::vector<uint8_t> out(embedded::MaxEncodedFrameSize(payload.size()));
+  size_t written = 0;
+  CHECK_EQ(embedded::EncodeFrame(type, payload, out, written), embedded::FramingError::kOk);
+  out.resize(written);
+  return out;
+}
+
+[[nodiscard]] std::vector<ReceivedFrame> FeedAll(embedded::FrameDecoder& decoder, std::span<const uint8_t> data) {
+  std::vector<ReceivedFrame> frames;
+  decoder.Feed(data, [&frames](const embedded::Frame& frame) {
+    frames.push_back({frame.type, std::vector<uint8_t>(frame.payload.begin(), frame.payload.end())});
+  });
+  return frames;
+}
+
+}  // namespace
+
+TEST_SUITE("embedded::SppFraming") {
+  TEST_CASE("Crc16: Matches CRC-16/CCITT-FALSE check value") {
+    constexpr std::string_view kCheck = "123456789";
+    CHECK_EQ(embedded::Crc16(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(kCheck.data()), kCheck.size())),
+             0x29B1);
+  }
+
+  TEST_CASE("EncodeFrame: Produces the shared wire format") {
+    // Same vector is checked by the client's framing tests
+    constexpr std::array<uint8_t, 6> kPayload = {0x08, 0x2A, 0x10, 0x00, 0x18, 0x01};
+    constexpr std::array<uint8_t, 13> kExpected = {0x00, 0x06, 0x06, 0x01, 0x08, 0x2A, 0x10,
+                                                   0x05, 0x18, 0x01, 0x90, 0xCB, 0x00};
+
+    CHECK(std::ranges::equal(Encode(embedded::FrameType::kCommand, kPayload), kExpected));
+  }
+
+  TEST_CASE("EncodeFrame: Rejects oversized payloads and small buffers") {
+    std::vector<uint8_t> payload(embedded::kMaxFramePayloadSize + 1);
+    std::vector<uint8_t> out(embedded::MaxEncodedFrameSize(payload.size()));
+    size_t written = 0;
+    CHECK_EQ(embedded::EncodeFrame(embedded::FrameType::kResponse, payload, out, written),
+             embedded::FramingError::kPayloadTooLarge);
+
+    std::array<uint8_t, 4> small{};
+    CHECK_EQ(embedded::EncodeFrame(embedded::FrameType::kResponse, std::span(payload).first(8), small, written),
+             embedded::FramingError::kBufferTooSmall);
+  }
+
+  TEST_CASE("FrameDecoder: Reassembles randomly fragmented and concatenated streams") {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> payload_size(0, embedded::kMaxFramePayloadSize);
+    std::uniform_int_distribution<size_t> chunk_size(1, 600);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    for (int round = 0; round < 20; ++round) {
+      std::vector<std::vector<uint8_t>> payloads;
+      std::vector<uint8_t> stream;
+      for (int i = 0; i < 25; ++i) {
+        std::vector<uint8_t> payload(payload_size(rng));
+        for (auto& b : payload) {
+          b = byte(rng) < 64 ? 0 : static_cast<uint8_t>(byte(rng));
+        }
+        const auto encoded = Encode(embedded::FrameType::kCommand, payload);
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+        payloads.push_back(std::move(payload));
+      }
+
+      embedded::FrameDecoder decoder;
+      std::vector<ReceivedFrame> received;
+      for (size_t offset = 0; offset < stream.size();) {
+        const size_t n = std::min(chunk_size(rng), stream.size() - offset);
+        const auto frames = FeedAll(decoder, std::span(stream).subspan(offset, n));
+        received.insert(received.end(), frames.begin(), frames.end());
+        offset += n;
+      }
+
+      REQUIRE_EQ(received.size(), payloads.size());
+      for (size_t i = 0; i < payloads.size(); ++i) {
+        CHECK_EQ(received[i].type, embedded::FrameType::kCommand);
+        CHECK_EQ(received[i].payload, payloads[i]);
+      }
+      CHECK_EQ(decoder.FramesDropped(), 0);
+    }
+  }
+
+  TEST_CASE("FrameDecoder: Resynchronises after corruption and garbage") {
+    const std::vector<uint8_t> first = {1, 2, 3};
+    const std::vector<uint8_t> second = {4, 0, 5};
+    auto corrupted = Encode(embedded::FrameType::kCommand, first);
+    corrupted[3] ^= 0x40;
+
+    std::vector<uint8_t> stream = {0x13, 0x37, 0x42};
+    stream.insert(stream.end(), corrupted.begin(), corrupted.end());
+    const auto good = Encode(embedded::FrameType::kCommand, second);
+    stream.insert(stream.end(), good.begin(), good.end());
+
+    embedded::FrameDecoder decoder;
+    const auto frames = FeedAll(decoder, stream);
+    REQUIRE_EQ(frames.size(), 1);
+    CHECK_EQ(frames[0].payload, second);
+    CHECK_EQ(decoder.FramesDropped(), 2);
+  }
+
+  TEST_CASE("FrameDecoder: Detects CRC errors and overlong runs") {
+    auto encoded = Encode(embedded::FrameType::kResponse, std::vector<uint8_t>{9, 8, 7, 6});
+    encoded[encoded.size() - 3] ^= 0x01;
+
+    embedded::FrameDecoder decoder;
+    CHECK(FeedAll(decoder, encoded).empty());
+    CHECK_EQ(decoder.LastError(), embedded::FramingError::kCrcMismatch);
+
+    std::vector<uint8_t> overlong(embedded::FrameDecoder::kMaxEncodedBodySize + 1, 0x11);
+    overlong.push_back(embedded::kFrameDelimiter);
+    CHECK(FeedAll(decoder, overlong).empty());
+    CHECK_EQ(decoder.LastError(), embedded::FramingError::kFrameTooLong);
+  }
+}
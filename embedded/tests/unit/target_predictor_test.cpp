@@ -0,0 +1,116 @@
+#include <doctest/doctest.h>
+
+#include <motion_profile.hpp>
+#include <target_predictor.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using embedded::MotionLimits;
+using embedded::MotionProfile;
+using embedded::TargetPredictor;
+
+constexpr float kDt = 0.02F;              ///< Servo task period.
+constexpr int kStepsPerCommand = 5;       ///< Commands at 10 Hz.
+constexpr float kFaceVelocity = 40.0F;    ///< Degrees per second.
+constexpr float kCommandHorizon = 0.25F;  ///< Seconds a command's velocity holds.
+
+/// Tracking quality once the axis has caught up with a face moving at kFaceVelocity.
+struct TrackingError {
+  float max_error = 0.0F;     ///< Largest distance between axis and face.
+  float min_velocity = 1e9F;  ///< Slowest the axis moved.
+};
+
+/// Follows a face moving at kFaceVelocity from 10 Hz commands, with or without sending the velocity
+/// along, the way ServoController::Update() advances the target before stepping the profile.
+TrackingError Follow(bool send_velocity) {
+  MotionProfile profile;
+  TargetPredictor predictor;
+  TrackingError error;
+  for (int step = 0; step < 150; ++step) {
+    const float time = static_cast<float>(step) * kDt;
+    if (step % kStepsPerCommand == 0) {
+      predictor.Set(kFaceVelocity * time, send_velocity ? kFaceVelocity : 0.0F, kCommandHorizon);
+    }
+    predictor.Advance(kDt);
+    profile.SetTarget(predictor.Aim(profile));
+    (void)profile.Step(kDt);
+
+    if (time >= 1.0F) {
+      error.max_error = std::max(error.max_error, std::abs(profile.State().position - kFaceVelocity * (time + kDt)));
+      error.min_velocity = std::min(error.min_velocity, profile.State().velocity);
+    }
+  }
+  return error;
+}
+
+}  // namespace
+
+TEST_SUITE("embedded::TargetPredictor") {
+  TEST_CASE("Extrapolates along the velocity until the horizon, then holds") {
+    TargetPredictor predictor;
+    predictor.Set(10.0F, -20.0F, 0.1F);
+    CHECK(predictor.Extrapolating());
+    CHECK_EQ(predictor.Target(), 10.0F);
+
+    predictor.Advance(0.05F);
+    CHECK_EQ(predictor.Target(), doctest::Approx(9.0F));
+    CHECK_EQ(predictor.Velocity(), -20.0F);
+
+    predictor.Advance(0.2F);
+    CHECK_FALSE(predictor.Extrapolating());
+    CHECK_EQ(predictor.Target(), doctest::Approx(8.0F));
+    CHECK_EQ(predictor.Velocity(), 0.0F);
+
+    predictor.Set(5.0F, 30.0F, 0.0F);
+    predictor.Advance(0.05F);
+    CHECK_FALSE(predictor.Extrapolating());
+    CHECK_EQ(predictor.Target(), 5.0F);
+  }
+
+  TEST_CASE("Aim: Leads a moving target by the stopping distance, but not past the horizon") {
+    const MotionProfile profile({.max_velocity = 100.0F, .max_acceleration = 500.0F, .max_jerk = 0.0F});
+    TargetPredictor predictor;
+    predictor.Set(0.0F, 50.0F, 1.0F);
+    // Braking from 50 deg/s at 500 deg/s^2 covers 2.5 degrees
+    CHECK_EQ(profile.StoppingDistance(50.0F), doctest::Approx(2.5F));
+    CHECK_EQ(predictor.Aim(profile), doctest::Approx(2.5F));
+
+    predictor.Advance(0.99F);
+    CHECK_EQ(predictor.Aim(profile), doctest::Approx(50.0F));
+
+    predictor.Hold(7.0F);
+    CHECK_EQ(predictor.Aim(profile), 7.0F);
+  }
+
+  TEST_CASE("Tracking: Sparse commands with a velocity follow a moving face without lag") {
+    const TrackingError with_velocity = Follow(true);
+    const TrackingError position_only = Follow(false);
+    MESSAGE("10 Hz commands: max error " << with_velocity.max_error << " deg with velocity, "
+                                         << position_only.max_error << " deg without");
+
+    CHECK_LT(with_velocity.max_error, 0.5F);
+    CHECK_GT(with_velocity.min_velocity, 0.8F * kFaceVelocity);
+    CHECK_GT(position_only.max_error, 2.0F * with_velocity.max_error);
+  }
+
+  TEST_CASE("Tracking: Lands on the extrapolated target without overshoot once commands stop") {
+    MotionProfile profile({.max_velocity = 200.0F, .max_acceleration = 1000.0F, .max_jerk = 10000.0F});
+    TargetPredictor predictor;
+    predictor.Set(0.0F, 60.0F, 0.3F);
+
+    float furthest = 0.0F;
+    for (int step = 0; step < 100 && !(profile.Done() && !predictor.Extrapolating()); ++step) {
+      predictor.Advance(kDt);
+      profile.SetTarget(predictor.Aim(profile));
+      furthest = std::max(furthest, profile.Step(kDt).position);
+    }
+
+    CHECK(profile.Done());
+    CHECK_EQ(predictor.Target(), doctest::Approx(18.0F));
+    CHECK_EQ(profile.State().position, doctest::Approx(18.0F));
+    CHECK_LE(furthest, doctest::Approx(18.0F));
+  }
+}